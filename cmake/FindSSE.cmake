@@ -15,3 +15,17 @@ check_cxx_source_compiles("
     int main() { return 0; }"
     SSE_FOUND
 )
+
+# Autodetect if AVX2 can be used; only the AVX2 blitter is compiled with it,
+# and that one is only used when the CPU and OS support it.
+if(SSE_FOUND)
+    if(CMAKE_CXX_COMPILER_ID STREQUAL "GNU" OR CMAKE_CXX_COMPILER_ID STREQUAL "Clang" OR CMAKE_CXX_COMPILER_ID STREQUAL "AppleClang")
+        set(CMAKE_REQUIRED_FLAGS "-mavx2")
+    endif()
+
+    check_cxx_source_compiles("
+        #include <immintrin.h>
+        int main() { __m256i a = _mm256_setzero_si256(); a = _mm256_packus_epi16(a, a); return _mm256_extract_epi32(a, 0); }"
+        AVX2_FOUND
+    )
+endif()
@@ -66,6 +66,8 @@ function(set_options)
     endif()
     option(OPTION_USE_NSIS "Use NSIS to create windows installer; enable only for stable releases" OFF)
     option(OPTION_TOOLS_ONLY "Build only tools target" OFF)
+    option(OPTION_INTERLEAVED_MAP "Store the base and extended data of each map tile together, instead of in two separate arrays" OFF)
+    option(OPTION_BLOCKED_MAP "Store the map tiles in blocks of 8x8 tiles, instead of row by row (experimental)" OFF)
     option(OPTION_DOCS_ONLY "Build only docs target" OFF)
 
     if (OPTION_DOCS_ONLY)
@@ -86,6 +88,8 @@ function(show_options)
     message(STATUS "Option Use assert - ${OPTION_USE_ASSERTS}")
     message(STATUS "Option Use threads - ${OPTION_USE_THREADS}")
     message(STATUS "Option Use NSIS - ${OPTION_USE_NSIS}")
+    message(STATUS "Option Interleaved map - ${OPTION_INTERLEAVED_MAP}")
+    message(STATUS "Option Blocked map - ${OPTION_BLOCKED_MAP}")
 
     if(OPTION_SURVEY_KEY)
         message(STATUS "Option Survey Key - USED")
@@ -113,6 +117,14 @@ function(add_definitions_based_on_options)
         add_definitions(-DNDEBUG)
     endif()
 
+    if(OPTION_INTERLEAVED_MAP)
+        add_definitions(-DWITH_INTERLEAVED_MAP)
+    endif()
+
+    if(OPTION_BLOCKED_MAP)
+        add_definitions(-DWITH_BLOCKED_MAP)
+    endif()
+
     if(OPTION_SURVEY_KEY)
         add_definitions(-DSURVEY_KEY="${OPTION_SURVEY_KEY}")
     endif()
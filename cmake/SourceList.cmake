@@ -49,6 +49,20 @@ function(add_test_files)
     endif()
 endfunction()
 
+# Add a benchmark file to be compiled.
+#
+# add_bench_files([file1 ...] CONDITION condition [condition ...])
+#
+# CONDITION is a complete statement that can be evaluated with if().
+# If it evaluates true, the source files will be added; otherwise not.
+# For example: ADD_IF SDL_FOUND AND Allegro_FOUND
+#
+function(add_bench_files)
+    if(NOT OPTION_NO_SPLIT_LIB)
+        _add_files_tgt(openttd_bench ${ARGV})
+    endif()
+endfunction()
+
 # This function works around an 'issue' with CMake, where
 # set_source_files_properties() only works in the scope of the file. We want
 # to set properties for the source file on a more global level. To solve this,
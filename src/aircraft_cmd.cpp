@@ -406,8 +406,6 @@ CommandCost CmdBuildAircraft(TileIndex tile, DoCommandFlag flags, const Engine *
 			u->SetNext(w);
 			w->UpdatePosition();
 		}
-
-		InvalidateVehicleTickCaches();
 	}
 
 	return CommandCost();
@@ -1930,16 +1928,14 @@ static bool AirportMove(Aircraft *v, const AirportFTAClass *apc)
 
 	/* there are more choices to choose from, choose the one that
 	 * matches our heading */
-	do {
-		if (v->state == current->heading || current->heading == TO_ALL) {
-			if (AirportSetBlocks(v, current, apc)) {
-				v->pos = current->next_position;
-				UpdateAircraftCache(v);
-			} // move to next position
-			return false;
-		}
-		current = current->next;
-	} while (current != nullptr);
+	current = apc->GetTransition(v->pos, v->state);
+	if (current != nullptr) {
+		if (AirportSetBlocks(v, current, apc)) {
+			v->pos = current->next_position;
+			UpdateAircraftCache(v);
+		} // move to next position
+		return false;
+	}
 
 	DEBUG(misc, 0, "[Ap] cannot move further on Airport! (pos %d state %d) for vehicle %d", v->pos, v->state, v->index);
 	NOT_REACHED();
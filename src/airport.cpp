@@ -127,18 +127,24 @@ AirportFTAClass::AirportFTAClass(
 {
 	/* Build the state machine itself */
 	this->layout = AirportBuildAutomata(this->nofelements, apFA);
+
+	/* Look up the choice for each aircraft state in advance, so moving does not have to search the list of choices. */
+	this->transitions.resize(this->nofelements * (MAX_HEADINGS + 1), nullptr);
+	for (uint i = 0; i < this->nofelements; i++) {
+		for (uint state = 0; state <= MAX_HEADINGS; state++) {
+			for (const AirportFTA *current = &this->layout[i]; current != nullptr; current = current->next) {
+				if (current->heading == state || current->heading == TO_ALL) {
+					this->transitions[i * (MAX_HEADINGS + 1) + state] = current;
+					break;
+				}
+			}
+		}
+	}
 }
 
 AirportFTAClass::~AirportFTAClass()
 {
-	for (uint i = 0; i < nofelements; i++) {
-		AirportFTA *current = layout[i].next;
-		while (current != nullptr) {
-			AirportFTA *next = current->next;
-			free(current);
-			current = next;
-		}
-	}
+	/* The extra movement choices are stored in the same allocation, after the positions. */
 	free(layout);
 }
 
@@ -170,7 +176,12 @@ static uint16 AirportGetNofElements(const AirportFTAbuildup *apFA)
  */
 static AirportFTA *AirportBuildAutomata(uint nofelements, const AirportFTAbuildup *apFA)
 {
-	AirportFTA *FAutomata = MallocT<AirportFTA>(nofelements);
+	uint nofentries = 0;
+	while (apFA[nofentries].position != MAX_ELEMENTS) nofentries++;
+
+	/* The first choice of each position is at the index of the position, the extra choices follow after all positions. */
+	AirportFTA *FAutomata = MallocT<AirportFTA>(nofentries);
+	AirportFTA *extra = FAutomata + nofelements;
 	uint16 internalcounter = 0;
 
 	for (uint i = 0; i < nofelements; i++) {
@@ -182,7 +193,8 @@ static AirportFTA *AirportBuildAutomata(uint nofelements, const AirportFTAbuildu
 
 		/* outgoing nodes from the same position, create linked list */
 		while (current->position == apFA[internalcounter + 1].position) {
-			AirportFTA *newNode = MallocT<AirportFTA>(1);
+			AirportFTA *newNode = extra++;
+			assert(newNode < FAutomata + nofentries);
 
 			newNode->position      = apFA[internalcounter + 1].position;
 			newNode->heading       = apFA[internalcounter + 1].heading;
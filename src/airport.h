@@ -13,6 +13,8 @@
 #include "direction_type.h"
 #include "tile_type.h"
 
+#include <vector>
+
 /** Some airport-related constants */
 static const uint MAX_TERMINALS =   8;                       ///< maximum number of terminals per airport
 static const uint MAX_HELIPADS  =   3;                       ///< maximum number of helipads per airport
@@ -173,8 +175,21 @@ public:
 		return &moving_data[position];
 	}
 
+	/**
+	 * Get the movement choice an aircraft takes from a position, when there is more than one choice.
+	 * @param position Element number of the current position.
+	 * @param state Current state of the aircraft.
+	 * @return The first choice heading for \a state or for #TO_ALL, or \c nullptr if there is none.
+	 */
+	const struct AirportFTA *GetTransition(byte position, byte state) const
+	{
+		assert(position < nofelements && state <= MAX_HEADINGS);
+		return this->transitions[position * (MAX_HEADINGS + 1) + state];
+	}
+
 	const AirportMovingData *moving_data; ///< Movement data.
 	struct AirportFTA *layout;            ///< state machine for airport
+	std::vector<const struct AirportFTA *> transitions; ///< Movement choice per position and aircraft state, see #GetTransition.
 	const byte *terminals;                ///< %Array with the number of terminal groups, followed by the number of terminals in each group.
 	const byte num_helipads;              ///< Number of helipads on this airport. When 0 helicopters will go to normal terminals.
 	Flags flags;                          ///< Flags for this airport type.
@@ -15,6 +15,8 @@
 #include "viewport_func.h"
 #include "framerate_type.h"
 #include "date_func.h"
+#include "town_map.h"
+#include "industry_map.h"
 #include "3rdparty/cpp-btree/btree_map.h"
 
 #include INCLUDE_FOR_PREFETCH_NTA
@@ -67,6 +69,82 @@ static void UpdateAnimatedTileSpeed(TileIndex tile, AnimatedTileInfo &info)
 	}
 }
 
+static void UpdateAnimatedTileSimpleAnimation(TileIndex tile, AnimatedTileInfo &info)
+{
+	extern void GetAnimatedTileSimpleAnimation_Town(TileIndex tile, AnimatedTileInfo &info);
+	extern void GetAnimatedTileSimpleAnimation_Industry(TileIndex tile, AnimatedTileInfo &info);
+	extern void GetAnimatedTileSimpleAnimation_Object(TileIndex tile, AnimatedTileInfo &info);
+
+	info.simple = ATSA_NONE;
+	info.simple_frames = 0;
+	info.simple_id = 0;
+
+	switch (GetTileType(tile)) {
+		case MP_HOUSE:
+			GetAnimatedTileSimpleAnimation_Town(tile, info);
+			break;
+
+		case MP_INDUSTRY:
+			GetAnimatedTileSimpleAnimation_Industry(tile, info);
+			break;
+
+		case MP_OBJECT:
+			GetAnimatedTileSimpleAnimation_Object(tile, info);
+			break;
+
+		default:
+			break;
+	}
+}
+
+/**
+ * Check whether the simple animation of a tile still applies to it.
+ * The graphics of industry tiles can change without the tile being re-added to the animated tile table.
+ * @param tile The tile.
+ * @param info Animated tile info of the tile.
+ * @return True iff the tile can be animated by AnimateSimpleTile.
+ */
+static inline bool IsSimpleAnimationValid(TileIndex tile, const AnimatedTileInfo &info)
+{
+	switch (GetTileType(tile)) {
+		case MP_HOUSE:
+			return GetHouseType(tile) == info.simple_id;
+
+		case MP_INDUSTRY:
+			return GetIndustryGfx(tile) == info.simple_id;
+
+		case MP_OBJECT:
+			return true;
+
+		default:
+			return false;
+	}
+}
+
+/**
+ * Advance a tile with a simple animation by one frame.
+ * This is equivalent to AnimationBase::AnimateTile for a spec without animation callbacks, once the animation speed check has passed.
+ * @param tile The tile.
+ * @param info Animated tile info of the tile.
+ */
+static void AnimateSimpleTile(TileIndex tile, const AnimatedTileInfo &info)
+{
+	const uint8 prev = GetAnimationFrame(tile);
+	uint8 frame = prev;
+	if (frame < info.simple_frames) {
+		frame++;
+	} else if (frame == info.simple_frames && info.simple == ATSA_LOOPING) {
+		frame = 0;
+	} else {
+		DeleteAnimatedTile(tile);
+	}
+
+	if (frame != prev) {
+		SetAnimationFrame(tile, frame);
+		MarkTileDirtyByTile(tile, VMDF_NOT_MAP_MODE);
+	}
+}
+
 /**
  * Add the given tile to the animated tile table (if it does not exist
  * on that table yet). Also increases the size of the table if necessary.
@@ -77,6 +155,7 @@ void AddAnimatedTile(TileIndex tile, bool mark_dirty)
 	if (mark_dirty) MarkTileDirtyByTile(tile, VMDF_NOT_MAP_MODE);
 	AnimatedTileInfo &info = _animated_tiles[tile];
 	UpdateAnimatedTileSpeed(tile, info);
+	UpdateAnimatedTileSimpleAnimation(tile, info);
 	info.pending_deletion = false;
 }
 
@@ -100,6 +179,7 @@ void AnimateAnimatedTiles()
 	extern void AnimateTile_Object(TileIndex tile);
 
 	PerformanceAccumulator framerate(PFE_GL_LANDSCAPE);
+	PerformanceAccumulator framerate_animation(PFE_GL_LS_ANIMATION);
 
 	const uint32 ticks = (uint) _scaled_tick_counter;
 	const uint8 max_speed = (ticks == 0) ? 32 : FindFirstBit(ticks);
@@ -119,6 +199,11 @@ void AnimateAnimatedTiles()
 
 		if (iter->second.speed <= max_speed) {
 			const TileIndex curr = iter->first;
+			if (iter->second.simple != ATSA_NONE && IsSimpleAnimationValid(curr, iter->second)) {
+				AnimateSimpleTile(curr, iter->second);
+				iter = next;
+				continue;
+			}
 			switch (GetTileType(curr)) {
 				case MP_HOUSE:
 					AnimateTile_Town(curr);
@@ -153,10 +238,21 @@ void UpdateAllAnimatedTileSpeeds()
 			continue;
 		}
 		UpdateAnimatedTileSpeed(iter->first, iter->second);
+		UpdateAnimatedTileSimpleAnimation(iter->first, iter->second);
 		++iter;
 	}
 }
 
+/**
+ * Update the simple animations of all animated tiles, keeping their speeds.
+ */
+void UpdateAllAnimatedTileSimpleAnimations()
+{
+	for (auto &it : _animated_tiles) {
+		if (!it.second.pending_deletion) UpdateAnimatedTileSimpleAnimation(it.first, it.second);
+	}
+}
+
 /**
  * Initialize all animated tile variables to some known begin point
  */
@@ -13,9 +13,19 @@
 #include "tile_type.h"
 #include "3rdparty/cpp-btree/btree_map.h"
 
+/** Kinds of animation which can be advanced without going through the tile type and NewGRF callbacks. */
+enum AnimatedTileSimpleAnimation : uint8 {
+	ATSA_NONE,     ///< Animation has to be done by the tile type.
+	ATSA_ONCE,     ///< Frames advance to the last frame, then the animation stops.
+	ATSA_LOOPING,  ///< Frames advance to the last frame, then restart at frame 0.
+};
+
 struct AnimatedTileInfo {
 	uint8 speed = 0;
 	bool pending_deletion = false;
+	AnimatedTileSimpleAnimation simple = ATSA_NONE; ///< Kind of simple animation, if any.
+	uint8 simple_frames = 0;                         ///< Last frame of the simple animation.
+	uint16 simple_id = 0;                            ///< House type or industry tile graphics the simple animation belongs to.
 };
 
 extern btree::btree_map<TileIndex, AnimatedTileInfo> _animated_tiles;
@@ -13,6 +13,7 @@
 #include "autoreplace_base.h"
 #include "core/bitmath_func.hpp"
 #include "core/pool_func.hpp"
+#include "3rdparty/cpp-btree/btree_map.h"
 
 #include "safeguards.h"
 
@@ -20,6 +21,21 @@
 EngineRenewPool _enginerenew_pool("EngineRenew");
 INSTANTIATE_POOL_METHODS(EngineRenew)
 
+/**
+ * Cache of the renew list entries found by EngineReplacement, keyed by the first entry of the renew list, the engine and the group.
+ * Only the entry which is found is cached, the replacement itself is read from the entry.
+ */
+static btree::btree_map<uint64, const EngineRenew *> _engine_replacement_cache;
+
+/**
+ * Forget all cached replacement lookups.
+ * This must be called whenever a renew list entry is added or removed, or the parent or replace protection of a group changes.
+ */
+void InvalidateEngineReplacementCache()
+{
+	_engine_replacement_cache.clear();
+}
+
 /**
  * Retrieves the EngineRenew that specifies the replacement of the given
  * engine type from the given renewlist
@@ -64,10 +80,20 @@ void RemoveAllEngineReplacement(EngineRenewList *erl)
  */
 EngineID EngineReplacement(EngineRenewList erl, EngineID engine, GroupID group, bool *replace_when_old)
 {
-	const EngineRenew *er = GetEngineReplacement(erl, engine, group);
-	if (er == nullptr && (group == DEFAULT_GROUP || (Group::IsValidID(group) && !HasBit(Group::Get(group)->flags, GroupFlags::GF_REPLACE_PROTECTION)))) {
-		/* We didn't find anything useful in the vehicle's own group so we will try ALL_GROUP */
-		er = GetEngineReplacement(erl, engine, ALL_GROUP);
+	const EngineRenew *er = nullptr;
+	if (erl != nullptr) {
+		const uint64 key = ((uint64)erl->index << 32) | ((uint64)engine << 16) | group;
+		auto it = _engine_replacement_cache.find(key);
+		if (it != _engine_replacement_cache.end()) {
+			er = it->second;
+		} else {
+			er = GetEngineReplacement(erl, engine, group);
+			if (er == nullptr && (group == DEFAULT_GROUP || (Group::IsValidID(group) && !HasBit(Group::Get(group)->flags, GroupFlags::GF_REPLACE_PROTECTION)))) {
+				/* We didn't find anything useful in the vehicle's own group so we will try ALL_GROUP */
+				er = GetEngineReplacement(erl, engine, ALL_GROUP);
+			}
+			_engine_replacement_cache[key] = er;
+		}
 	}
 	if (replace_when_old != nullptr) {
 		if (er == nullptr) {
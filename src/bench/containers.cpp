@@ -0,0 +1,227 @@
+/*
+ * This file is part of OpenTTD.
+ * OpenTTD is free software; you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 2.
+ * OpenTTD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with OpenTTD. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file containers.cpp Microbenchmarks of the core containers. */
+
+#include "../stdafx.h"
+
+#include "../3rdparty/catch2/catch.hpp"
+
+#include "../core/ring_buffer.hpp"
+#include "../core/kdtree.hpp"
+#include "../misc/binaryheap.hpp"
+#include "../misc/hashtable.hpp"
+#include "../3rdparty/cpp-btree/btree_map.h"
+
+#include <map>
+#include <random>
+#include <vector>
+
+/** Number of elements in each container. */
+static const uint BENCH_ELEMENTS = 10000;
+
+/**
+ * Get a fixed sequence of values, such that every run measures the same work.
+ * @param count Number of values.
+ * @param limit Values are below this limit.
+ * @return The values.
+ */
+static std::vector<uint32> GetBenchValues(uint count, uint32 limit)
+{
+	std::mt19937 rng(12345);
+	std::uniform_int_distribution<uint32> dist(0, limit - 1);
+	std::vector<uint32> values(count);
+	for (uint32 &v : values) v = dist(rng);
+	return values;
+}
+
+TEST_CASE("ring_buffer")
+{
+	BENCHMARK("push_back and pop_front")
+	{
+		ring_buffer<uint32> ring;
+		for (uint i = 0; i < BENCH_ELEMENTS; i++) ring.push_back(i);
+		uint32 sum = 0;
+		while (!ring.empty()) {
+			sum += ring.front();
+			ring.pop_front();
+		}
+		return sum;
+	};
+
+	ring_buffer<uint32> ring;
+	for (uint i = 0; i < BENCH_ELEMENTS; i++) ring.push_back(i);
+	BENCHMARK("iterate")
+	{
+		uint32 sum = 0;
+		for (uint32 v : ring) sum += v;
+		return sum;
+	};
+}
+
+/**
+ * Benchmark a map with tile index like keys, such as the animated tiles.
+ * @tparam Tmap Type of the map.
+ * @param name Name of the map in the benchmark names.
+ */
+template <typename Tmap>
+static void BenchTileMap(const char *name)
+{
+	const std::vector<uint32> tiles = GetBenchValues(BENCH_ELEMENTS, 1 << 22);
+
+	BENCHMARK(std::string(name) + " insert")
+	{
+		Tmap map;
+		for (uint32 tile : tiles) map[tile] = (uint8)tile;
+		return map.size();
+	};
+
+	Tmap map;
+	for (uint32 tile : tiles) map[tile] = (uint8)tile;
+
+	BENCHMARK(std::string(name) + " lookup")
+	{
+		uint found = 0;
+		for (uint32 tile : tiles) found += (map.find(tile) != map.end());
+		return found;
+	};
+
+	BENCHMARK(std::string(name) + " iterate")
+	{
+		uint32 sum = 0;
+		for (const auto &it : map) sum += it.second;
+		return sum;
+	};
+}
+
+TEST_CASE("tile maps")
+{
+	BenchTileMap<btree::btree_map<uint32, uint8>>("btree_map");
+	BenchTileMap<std::map<uint32, uint8>>("std::map");
+}
+
+static const uint32 KDTREE_MAP_SIZE = 4096;
+static std::vector<uint32> _kdtree_xy; ///< Packed coordinates of the Kdtree elements, indexed by element.
+
+static uint32 Kdtree_BenchXYFunc(uint32 element, int dim)
+{
+	return dim == 0 ? _kdtree_xy[element] % KDTREE_MAP_SIZE : _kdtree_xy[element] / KDTREE_MAP_SIZE;
+}
+
+TEST_CASE("Kdtree")
+{
+	typedef Kdtree<uint32, decltype(&Kdtree_BenchXYFunc), uint32, int> BenchKdtree;
+
+	_kdtree_xy = GetBenchValues(BENCH_ELEMENTS, KDTREE_MAP_SIZE * KDTREE_MAP_SIZE);
+	std::vector<uint32> elements(BENCH_ELEMENTS);
+	for (uint i = 0; i < BENCH_ELEMENTS; i++) elements[i] = i;
+	const std::vector<uint32> queries = GetBenchValues(1000, KDTREE_MAP_SIZE);
+
+	BENCHMARK("build")
+	{
+		BenchKdtree tree(&Kdtree_BenchXYFunc);
+		tree.Build(elements.begin(), elements.end());
+		return tree.Count();
+	};
+
+	BENCHMARK("insert")
+	{
+		BenchKdtree tree(&Kdtree_BenchXYFunc);
+		for (uint32 e : elements) tree.Insert(e);
+		return tree.Count();
+	};
+
+	BenchKdtree tree(&Kdtree_BenchXYFunc);
+	tree.Build(elements.begin(), elements.end());
+
+	BENCHMARK("find nearest")
+	{
+		uint32 sum = 0;
+		for (size_t i = 0; i + 1 < queries.size(); i += 2) sum += tree.FindNearest(queries[i], queries[i + 1]);
+		return sum;
+	};
+
+	BENCHMARK("find contained")
+	{
+		uint count = 0;
+		for (size_t i = 0; i + 1 < queries.size(); i += 2) {
+			uint32 x = std::min(queries[i], KDTREE_MAP_SIZE - 65);
+			uint32 y = std::min(queries[i + 1], KDTREE_MAP_SIZE - 65);
+			tree.FindContained(x, y, x + 64, y + 64, [&](uint32) { count++; });
+		}
+		return count;
+	};
+}
+
+/** Item of the binary heap benchmark. */
+struct BenchHeapItem {
+	uint32 value;
+
+	bool operator<(const BenchHeapItem &other) const { return this->value < other.value; }
+};
+
+TEST_CASE("CBinaryHeapT")
+{
+	const std::vector<uint32> values = GetBenchValues(BENCH_ELEMENTS, UINT32_MAX);
+	std::vector<BenchHeapItem> items(values.size());
+	for (size_t i = 0; i < values.size(); i++) items[i].value = values[i];
+
+	BENCHMARK("include and shift")
+	{
+		CBinaryHeapT<BenchHeapItem> heap(BENCH_ELEMENTS);
+		for (BenchHeapItem &item : items) heap.Include(&item);
+		uint32 last = 0;
+		while (!heap.IsEmpty()) last = heap.Shift()->value;
+		return last;
+	};
+}
+
+/** Item of the hash table benchmark. */
+struct BenchHashItem {
+	/** Key of the item. */
+	struct Key {
+		uint32 value;
+
+		int CalcHash() const { return this->value; }
+		bool operator==(const Key &other) const { return this->value == other.value; }
+	};
+
+	Key key;
+	BenchHashItem *hash_next = nullptr;
+
+	const Key &GetKey() const { return this->key; }
+	BenchHashItem *GetHashNext() { return this->hash_next; }
+	void SetHashNext(BenchHashItem *next) { this->hash_next = next; }
+};
+
+TEST_CASE("CHashTableT")
+{
+	typedef CHashTableT<BenchHashItem, 12> BenchHashTable;
+
+	std::vector<BenchHashItem> items(BENCH_ELEMENTS);
+	for (uint i = 0; i < BENCH_ELEMENTS; i++) items[i].key.value = i * 7919;
+
+	BENCHMARK_ADVANCED("push and pop")(Catch::Benchmark::Chronometer meter)
+	{
+		std::unique_ptr<BenchHashTable> table = std::make_unique<BenchHashTable>();
+		meter.measure([&] {
+			for (BenchHashItem &item : items) table->Push(item);
+			for (BenchHashItem &item : items) table->Pop(item);
+			return table->Count();
+		});
+	};
+
+	std::unique_ptr<BenchHashTable> table = std::make_unique<BenchHashTable>();
+	for (BenchHashItem &item : items) table->Push(item);
+
+	BENCHMARK("find")
+	{
+		uint found = 0;
+		for (uint i = 0; i < BENCH_ELEMENTS; i++) found += (table->Find({ i * 7919 }) != nullptr);
+		return found;
+	};
+}
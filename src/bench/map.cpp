@@ -0,0 +1,63 @@
+/*
+ * This file is part of OpenTTD.
+ * OpenTTD is free software; you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 2.
+ * OpenTTD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with OpenTTD. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file map.cpp Microbenchmarks of access to the map array, to compare the map storage layouts (OPTION_INTERLEAVED_MAP, OPTION_BLOCKED_MAP). */
+
+#include "../stdafx.h"
+
+#include "../3rdparty/catch2/catch.hpp"
+
+#include "../map_func.h"
+#include "../core/bitmath_func.hpp"
+
+#include <random>
+#include <vector>
+
+/** Log2 of the size along each side of the map used by the benchmarks. */
+static const uint BENCH_MAP_LOG = 11;
+
+TEST_CASE("Map access")
+{
+	AllocateMap(1 << BENCH_MAP_LOG, 1 << BENCH_MAP_LOG);
+	const uint size = MapSize();
+
+	std::mt19937 rng(12345);
+	for (uint t = 0; t < size; t++) {
+		_m[t].m5 = (byte)rng();
+		_me[t].m8 = (uint16)rng();
+	}
+
+	std::vector<TileIndex> tiles(1 << 16);
+	std::uniform_int_distribution<TileIndex> dist(0, size - 1);
+	for (TileIndex &t : tiles) t = dist(rng);
+
+	BENCHMARK("Tile loop, base and extended data") {
+		uint32 sum = 0;
+		for (uint t = 0; t < size; t++) sum += _m[t].m5 + GB(_me[t].m8, 0, 6);
+		return sum;
+	};
+
+	BENCHMARK("Tile loop along the Y axis, base data") {
+		uint32 sum = 0;
+		for (uint x = 0; x < MapSizeX(); x++) {
+			for (uint y = 0; y < MapSizeY(); y++) sum += _m[TileXY(x, y)].m5;
+		}
+		return sum;
+	};
+
+	BENCHMARK("Random tiles, base data") {
+		uint32 sum = 0;
+		for (TileIndex t : tiles) sum += _m[t].m5;
+		return sum;
+	};
+
+	BENCHMARK("Random tiles, base and extended data") {
+		uint32 sum = 0;
+		for (TileIndex t : tiles) sum += _m[t].m5 + GB(_me[t].m8, 0, 6);
+		return sum;
+	};
+}
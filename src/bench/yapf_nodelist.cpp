@@ -0,0 +1,165 @@
+/*
+ * This file is part of OpenTTD.
+ * OpenTTD is free software; you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 2.
+ * OpenTTD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with OpenTTD. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file yapf_nodelist.cpp Microbenchmarks of the YAPF node list, with an A-star search on a synthetic grid. */
+
+#include "../stdafx.h"
+
+#include "../3rdparty/catch2/catch.hpp"
+
+#include "../string_func.h"
+#include "../pathfinder/yapf/nodelist.hpp"
+
+#include <random>
+#include <vector>
+
+/** Node of the grid search, with the same layout of links and costs as the YAPF nodes. */
+struct BenchGridNode {
+	/** Key of a node: the index of its cell. */
+	struct Key {
+		uint32 cell;
+
+		int CalcHash() const { return this->cell; }
+		bool operator==(const Key &other) const { return this->cell == other.cell; }
+	};
+
+	typedef BenchGridNode Node;
+
+	Key m_key;
+	Node *m_hash_next = nullptr;
+	Node *m_parent = nullptr;
+	int m_cost = 0;
+	int m_estimate = 0;
+
+	const Key &GetKey() const { return this->m_key; }
+	Node *GetHashNext() { return this->m_hash_next; }
+	void SetHashNext(Node *next) { this->m_hash_next = next; }
+	int GetCost() const { return this->m_cost; }
+	int GetCostEstimate() const { return this->m_estimate; }
+	bool operator<(const Node &other) const { return this->m_estimate < other.m_estimate; }
+};
+
+typedef CNodeList_HashTableT<BenchGridNode, 8, 10> BenchNodeList;
+
+/** Square grid with a cost to enter each cell, 0 for impassable cells. */
+struct BenchGrid {
+	uint size;
+	std::vector<uint8> costs;
+
+	/**
+	 * Create a grid.
+	 * @param size Width and height of the grid.
+	 * @param open_percentage Percentage of the cells which are passable, such as rail or road tiles.
+	 * @param max_cost Highest cost to enter a cell, costs are uniformly distributed from 1.
+	 */
+	BenchGrid(uint size, uint open_percentage, uint max_cost) : size(size), costs(size * size)
+	{
+		std::mt19937 rng(54321);
+		std::uniform_int_distribution<uint> open(0, 99);
+		std::uniform_int_distribution<uint> cost(1, max_cost);
+		for (uint8 &c : this->costs) c = open(rng) < open_percentage ? cost(rng) : 0;
+
+		/* Keep the borders between the corners passable, such that there is always a path. */
+		for (uint i = 0; i < size; i++) {
+			this->costs[i] = std::max<uint8>(this->costs[i], 1);
+			this->costs[i * size + size - 1] = std::max<uint8>(this->costs[i * size + size - 1], 1);
+		}
+	}
+
+	int Estimate(uint32 cell, uint32 dest) const
+	{
+		return Delta(cell % this->size, dest % this->size) + Delta(cell / this->size, dest / this->size);
+	}
+
+	/**
+	 * Search a path from one corner of the grid to the opposite one, in the same way as CYapfBaseT::FindPath.
+	 * @return Cost of the path.
+	 */
+	int FindPath() const
+	{
+		BenchNodeList nodes;
+		const uint32 dest = this->size * this->size - 1;
+
+		BenchGridNode &start = *nodes.CreateNewNode();
+		start.m_key.cell = 0;
+		start.m_estimate = this->Estimate(0, dest);
+		nodes.InsertOpenNode(start);
+
+		BenchGridNode *best = nullptr;
+		for (;;) {
+			BenchGridNode *n = nodes.GetBestOpenNode();
+			if (n == nullptr) break;
+			if (best != nullptr && best->GetCost() < n->GetCostEstimate()) break;
+
+			nodes.DequeueBestOpenNode();
+			this->FollowNode(nodes, *n, dest, best);
+			nodes.PopAlreadyDequeuedOpenNode(n->GetKey());
+			nodes.InsertClosedNode(*n);
+		}
+		return best != nullptr ? best->GetCost() : -1;
+	}
+
+private:
+	void FollowNode(BenchNodeList &nodes, BenchGridNode &parent, uint32 dest, BenchGridNode *&best) const
+	{
+		const uint32 cell = parent.m_key.cell;
+		const uint x = cell % this->size;
+		const uint y = cell / this->size;
+		const uint32 neighbours[] = {
+			x > 0 ? cell - 1 : UINT32_MAX,
+			x + 1 < this->size ? cell + 1 : UINT32_MAX,
+			y > 0 ? cell - this->size : UINT32_MAX,
+			y + 1 < this->size ? cell + this->size : UINT32_MAX,
+		};
+
+		for (uint32 next : neighbours) {
+			if (next == UINT32_MAX || this->costs[next] == 0) continue;
+
+			BenchGridNode &n = *nodes.CreateNewNode();
+			n.m_key.cell = next;
+			n.m_parent = &parent;
+			n.m_cost = parent.m_cost + this->costs[next];
+			n.m_estimate = n.m_cost + this->Estimate(next, dest);
+
+			if (next == dest) {
+				if (best == nullptr || n < *best) best = &n;
+				nodes.FoundBestNode(n);
+				continue;
+			}
+
+			BenchGridNode *open = nodes.FindOpenNode(n.GetKey());
+			if (open != nullptr) {
+				if (n.GetCostEstimate() < open->GetCostEstimate()) {
+					nodes.PopOpenNode(n.GetKey());
+					*open = n;
+					nodes.InsertOpenNode(*open);
+				}
+				continue;
+			}
+			if (nodes.FindClosedNode(n.GetKey()) != nullptr) continue;
+
+			nodes.InsertOpenNode(n);
+		}
+	}
+};
+
+TEST_CASE("YAPF node list")
+{
+	/* Sparse network with few alternatives, like rail. */
+	const BenchGrid rail(256, 45, 2);
+	BENCHMARK("A-star on rail-like grid")
+	{
+		return rail.FindPath();
+	};
+
+	/* Dense network with many equivalent alternatives, like a town road grid. */
+	const BenchGrid road(128, 90, 4);
+	BENCHMARK("A-star on road-like grid")
+	{
+		return road.FindPath();
+	};
+}
@@ -10,6 +10,7 @@
 #include "../stdafx.h"
 #include "../video/video_driver.hpp"
 #include "../zoom_func.h"
+#include "../worker_thread.h"
 #include "32bpp_anim.hpp"
 #include "common.hpp"
 
@@ -640,27 +641,28 @@ void Blitter_32bppAnim::PaletteAnimate(const Palette &palette)
 	 *  Especially when going between toyland and non-toyland. */
 	assert(this->palette.first_dirty == PALETTE_ANIM_START || this->palette.first_dirty == 0);
 
-	const uint16 *anim = this->anim_buf;
-	Colour *dst = (Colour *)_screen.dst_ptr;
-
-	/* Let's walk the anim buffer and try to find the pixels */
+	/* Let's walk the anim buffer and try to find the pixels, in bands of rows which are independent of each other. */
 	const int width = this->anim_buf_width;
 	const int pitch_offset = _screen.pitch - width;
 	const int anim_pitch_offset = this->anim_buf_pitch - width;
-	for (int y = this->anim_buf_height; y != 0 ; y--) {
-		for (int x = width; x != 0 ; x--) {
-			uint16 value = *anim;
-			uint8 colour = GB(value, 0, 8);
-			if (colour >= PALETTE_ANIM_START) {
-				/* Update this pixel */
-				*dst = this->AdjustBrightness(LookupColourInPalette(colour), GB(value, 8, 8));
+	_general_worker_pool.ParallelFor(this->anim_buf_height, PALETTE_ANIMATE_ROW_BATCH, [&](int y_first, int y_last) {
+		const uint16 *anim = this->anim_buf + y_first * this->anim_buf_pitch;
+		Colour *dst = (Colour *)_screen.dst_ptr + y_first * _screen.pitch;
+		for (int y = y_last - y_first; y != 0 ; y--) {
+			for (int x = width; x != 0 ; x--) {
+				uint16 value = *anim;
+				uint8 colour = GB(value, 0, 8);
+				if (colour >= PALETTE_ANIM_START) {
+					/* Update this pixel */
+					*dst = this->AdjustBrightness(LookupColourInPalette(colour), GB(value, 8, 8));
+				}
+				dst++;
+				anim++;
 			}
-			dst++;
-			anim++;
+			dst += pitch_offset;
+			anim += anim_pitch_offset;
 		}
-		dst += pitch_offset;
-		anim += anim_pitch_offset;
-	}
+	});
 
 	/* Make sure the backend redraws the whole screen */
 	VideoDriver::GetInstance()->MakeDirty(0, 0, _screen.width, _screen.height);
@@ -22,6 +22,8 @@ protected:
 	int anim_buf_height; ///< The height of the animation buffer.
 	Palette palette;     ///< The current palette.
 
+	static const int PALETTE_ANIMATE_ROW_BATCH = 64; ///< Number of screen rows per worker job when palette animating.
+
 public:
 	Blitter_32bppAnim() :
 		anim_buf(nullptr),
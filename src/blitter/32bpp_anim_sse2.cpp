@@ -13,36 +13,35 @@
 #include "../video/video_driver.hpp"
 #include "32bpp_anim_sse2.hpp"
 #include "32bpp_sse_func.hpp"
+#include "../worker_thread.h"
+
+#include <atomic>
 
 #include "../safeguards.h"
 
 /** Instantiation of the partially SSSE2 32bpp with animation blitter factory. */
 static FBlitter_32bppSSE2_Anim iFBlitter_32bppSSE2_Anim;
 
+/**
+ * Palette animate a band of screen rows.
+ * @param y_first First row to animate.
+ * @param y_last Row after the last row to animate.
+ * @return Whether any pixel was changed.
+ */
 GNU_TARGET("sse2")
-void Blitter_32bppSSE2_Anim::PaletteAnimate(const Palette &palette)
+bool Blitter_32bppSSE2_Anim::PaletteAnimateRows(int y_first, int y_last)
 {
-	assert(!_screen_disable_anim);
-
-	this->palette = palette;
-	/* If first_dirty is 0, it is for 8bpp indication to send the new
-	 *  palette. However, only the animation colours might possibly change.
-	 *  Especially when going between toyland and non-toyland. */
-	assert(this->palette.first_dirty == PALETTE_ANIM_START || this->palette.first_dirty == 0);
-
-	const uint16 *anim = this->anim_buf;
-	Colour *dst = (Colour *)_screen.dst_ptr;
-
-	bool screen_dirty = false;
-
-	/* Let's walk the anim buffer and try to find the pixels */
 	const int width = this->anim_buf_width;
 	const int screen_pitch = _screen.pitch;
 	const int anim_pitch = this->anim_buf_pitch;
+	const uint16 *anim = this->anim_buf + y_first * anim_pitch;
+	Colour *dst = (Colour *)_screen.dst_ptr + y_first * screen_pitch;
+	bool screen_dirty = false;
+
 	__m128i anim_cmp = _mm_set1_epi16(PALETTE_ANIM_START - 1);
 	__m128i brightness_cmp = _mm_set1_epi16(Blitter_32bppBase::DEFAULT_BRIGHTNESS);
 	__m128i colour_mask = _mm_set1_epi16(0xFF);
-	for (int y = this->anim_buf_height; y != 0 ; y--) {
+	for (int y = y_last - y_first; y != 0 ; y--) {
 		Colour *next_dst_ln = dst + screen_pitch;
 		const uint16 *next_anim_ln = anim + anim_pitch;
 		int x = width;
@@ -90,6 +89,25 @@ void Blitter_32bppSSE2_Anim::PaletteAnimate(const Palette &palette)
 		anim = next_anim_ln;
 	}
 
+	return screen_dirty;
+}
+
+void Blitter_32bppSSE2_Anim::PaletteAnimate(const Palette &palette)
+{
+	assert(!_screen_disable_anim);
+
+	this->palette = palette;
+	/* If first_dirty is 0, it is for 8bpp indication to send the new
+	 *  palette. However, only the animation colours might possibly change.
+	 *  Especially when going between toyland and non-toyland. */
+	assert(this->palette.first_dirty == PALETTE_ANIM_START || this->palette.first_dirty == 0);
+
+	/* Let's walk the anim buffer and try to find the pixels, in bands of rows which are independent of each other. */
+	std::atomic<bool> screen_dirty = false;
+	_general_worker_pool.ParallelFor(this->anim_buf_height, PALETTE_ANIMATE_ROW_BATCH, [&](int y_first, int y_last) {
+		if (this->PaletteAnimateRows(y_first, y_last)) screen_dirty = true;
+	});
+
 	if (screen_dirty) {
 		/* Make sure the backend redraws the whole screen */
 		VideoDriver::GetInstance()->MakeDirty(0, 0, _screen.width, _screen.height);
@@ -29,6 +29,9 @@
 
 /** A partially 32 bpp blitter with palette animation. */
 class Blitter_32bppSSE2_Anim : public Blitter_32bppAnim {
+private:
+	bool PaletteAnimateRows(int y_first, int y_last);
+
 public:
 	void PaletteAnimate(const Palette &palette) override;
 	const char *GetName() override { return "32bpp-sse2-anim"; }
@@ -109,6 +109,56 @@ static inline __m128i DarkenTwoPixels(__m128i src, __m128i dst, const __m128i &d
 	return _mm_packus_epi16(dstAB, dstAB);
 }
 
+#if (SSE_VERSION >= 5)
+/**
+ * Alpha blend 8 pixels, the same way as AlphaBlendTwoPixels().
+ * Unpacking and packing both work per 128 bit lane, so the pixel order is preserved.
+ */
+GNU_TARGET(SSE_TARGET)
+static inline __m256i AlphaBlendEightPixels(__m256i src, __m256i dst, const __m256i &distribution_mask, const __m256i &alpha_mask)
+{
+	const __m256i zero = _mm256_setzero_si256();
+	const __m256i clear_hi = _mm256_set1_epi16(0x00FF);
+	__m256i packed[2];
+	for (int half = 0; half < 2; half++) {
+		__m256i srcAB = half == 0 ? _mm256_unpacklo_epi8(src, zero) : _mm256_unpackhi_epi8(src, zero);
+		__m256i dstAB = half == 0 ? _mm256_unpacklo_epi8(dst, zero) : _mm256_unpackhi_epi8(dst, zero);
+
+		__m256i alphaMaskAB = _mm256_cmpgt_epi16(srcAB, zero);
+		__m256i alphaAB = _mm256_sub_epi16(srcAB, alphaMaskAB);
+		alphaAB = _mm256_shuffle_epi8(alphaAB, distribution_mask);
+
+		srcAB = _mm256_sub_epi16(srcAB, dstAB);
+		srcAB = _mm256_mullo_epi16(srcAB, alphaAB);
+		srcAB = _mm256_srli_epi16(srcAB, 8);
+		srcAB = _mm256_add_epi16(srcAB, dstAB);
+
+		alphaMaskAB = _mm256_and_si256(alphaMaskAB, alpha_mask);
+		srcAB = _mm256_or_si256(srcAB, alphaMaskAB);
+		packed[half] = _mm256_and_si256(srcAB, clear_hi); // Keep the low bytes, so packing does not saturate.
+	}
+	return _mm256_packus_epi16(packed[0], packed[1]);
+}
+
+/** Darken 8 pixels, the same way as DarkenTwoPixels(). */
+GNU_TARGET(SSE_TARGET)
+static inline __m256i DarkenEightPixels(__m256i src, __m256i dst, const __m256i &distribution_mask, const __m256i &tr_nom_base)
+{
+	const __m256i zero = _mm256_setzero_si256();
+	__m256i darkened[2];
+	for (int half = 0; half < 2; half++) {
+		__m256i srcAB = half == 0 ? _mm256_unpacklo_epi8(src, zero) : _mm256_unpackhi_epi8(src, zero);
+		__m256i dstAB = half == 0 ? _mm256_unpacklo_epi8(dst, zero) : _mm256_unpackhi_epi8(dst, zero);
+		__m256i alphaAB = _mm256_shuffle_epi8(srcAB, distribution_mask);
+		alphaAB = _mm256_srli_epi16(alphaAB, 2);
+		__m256i nom = _mm256_sub_epi16(tr_nom_base, alphaAB);
+		dstAB = _mm256_mullo_epi16(dstAB, nom);
+		darkened[half] = _mm256_srli_epi16(dstAB, 8);
+	}
+	return _mm256_packus_epi16(darkened[0], darkened[1]);
+}
+#endif
+
 IGNORE_UNINITIALIZED_WARNING_START
 GNU_TARGET(SSE_TARGET)
 static Colour ReallyAdjustBrightness(Colour colour, uint8 brightness)
@@ -212,6 +262,8 @@ inline void Blitter_32bppSSE2::Draw(const Blitter::BlitterParams *bp, ZoomLevel
 inline void Blitter_32bppSSSE3::Draw(const Blitter::BlitterParams *bp, ZoomLevel zoom)
 #elif (SSE_VERSION == 4)
 inline void Blitter_32bppSSE4::Draw(const Blitter::BlitterParams *bp, ZoomLevel zoom)
+#elif (SSE_VERSION == 5)
+inline void Blitter_32bppAVX2::Draw(const Blitter::BlitterParams *bp, ZoomLevel zoom)
 #endif
 {
 	const byte * const remap = bp->remap;
@@ -254,6 +306,11 @@ inline void Blitter_32bppSSE4::Draw(const Blitter::BlitterParams *bp, ZoomLevel
 	#define DARKEN_PARAM_2      tr_nom_base
 #endif
 	const __m128i tr_nom_base = TRANSPARENT_NOM_BASE;
+#if (SSE_VERSION >= 5)
+	const __m256i a_cm_256        = _mm256_broadcastsi128_si256(a_cm);
+	const __m256i alpha_and_256   = _mm256_broadcastsi128_si256(alpha_and);
+	const __m256i tr_nom_base_256 = _mm256_broadcastsi128_si256(tr_nom_base);
+#endif
 
 	for (int y = bp->height; y != 0; y--) {
 		Colour *dst = dst_line;
@@ -284,12 +341,24 @@ inline void Blitter_32bppSSE4::Draw(const Blitter::BlitterParams *bp, ZoomLevel
 					break;
 				}
 
-				for (uint x = (uint) effective_width / 2; x > 0; x--) {
-					__m128i srcABCD = _mm_loadl_epi64((const __m128i*) src);
-					__m128i dstABCD = _mm_loadl_epi64((__m128i*) dst);
-					_mm_storel_epi64((__m128i*) dst, AlphaBlendTwoPixels(srcABCD, dstABCD, ALPHA_BLEND_PARAM_1, ALPHA_BLEND_PARAM_2, ALPHA_BLEND_PARAM_3));
-					src += 2;
-					dst += 2;
+				{
+					uint x = (uint) effective_width / 2;
+#if (SSE_VERSION >= 5)
+					for (; x >= 4; x -= 4) {
+						__m256i srcABCD = _mm256_loadu_si256((const __m256i*) src);
+						__m256i dstABCD = _mm256_loadu_si256((__m256i*) dst);
+						_mm256_storeu_si256((__m256i*) dst, AlphaBlendEightPixels(srcABCD, dstABCD, a_cm_256, alpha_and_256));
+						src += 8;
+						dst += 8;
+					}
+#endif
+					for (; x > 0; x--) {
+						__m128i srcABCD = _mm_loadl_epi64((const __m128i*) src);
+						__m128i dstABCD = _mm_loadl_epi64((__m128i*) dst);
+						_mm_storel_epi64((__m128i*) dst, AlphaBlendTwoPixels(srcABCD, dstABCD, ALPHA_BLEND_PARAM_1, ALPHA_BLEND_PARAM_2, ALPHA_BLEND_PARAM_3));
+						src += 2;
+						dst += 2;
+					}
 				}
 
 				if ((bt_last == BT_NONE && effective_width & 1) || bt_last == BT_ODD) {
@@ -383,12 +452,24 @@ bmcr_alpha_blend_single:
 
 			case BM_TRANSPARENT:
 				/* Make the current colour a bit more black, so it looks like this image is transparent. */
-				for (uint x = (uint) bp->width / 2; x > 0; x--) {
-					__m128i srcABCD = _mm_loadl_epi64((const __m128i*) src);
-					__m128i dstABCD = _mm_loadl_epi64((__m128i*) dst);
-					_mm_storel_epi64((__m128i *) dst, DarkenTwoPixels(srcABCD, dstABCD, DARKEN_PARAM_1, DARKEN_PARAM_2));
-					src += 2;
-					dst += 2;
+				{
+					uint x = (uint) bp->width / 2;
+#if (SSE_VERSION >= 5)
+					for (; x >= 4; x -= 4) {
+						__m256i srcABCD = _mm256_loadu_si256((const __m256i*) src);
+						__m256i dstABCD = _mm256_loadu_si256((__m256i*) dst);
+						_mm256_storeu_si256((__m256i *) dst, DarkenEightPixels(srcABCD, dstABCD, a_cm_256, tr_nom_base_256));
+						src += 8;
+						dst += 8;
+					}
+#endif
+					for (; x > 0; x--) {
+						__m128i srcABCD = _mm_loadl_epi64((const __m128i*) src);
+						__m128i dstABCD = _mm_loadl_epi64((__m128i*) dst);
+						_mm_storel_epi64((__m128i *) dst, DarkenTwoPixels(srcABCD, dstABCD, DARKEN_PARAM_1, DARKEN_PARAM_2));
+						src += 2;
+						dst += 2;
+					}
 				}
 
 				if ((bt_last == BT_NONE && bp->width & 1) || bt_last == BT_ODD) {
@@ -503,6 +584,8 @@ void Blitter_32bppSSE2::Draw(Blitter::BlitterParams *bp, BlitterMode mode, ZoomL
 void Blitter_32bppSSSE3::Draw(Blitter::BlitterParams *bp, BlitterMode mode, ZoomLevel zoom)
 #elif (SSE_VERSION == 4)
 void Blitter_32bppSSE4::Draw(Blitter::BlitterParams *bp, BlitterMode mode, ZoomLevel zoom)
+#elif (SSE_VERSION == 5)
+void Blitter_32bppAVX2::Draw(Blitter::BlitterParams *bp, BlitterMode mode, ZoomLevel zoom)
 #endif
 {
 	switch (mode) {
@@ -111,37 +111,6 @@ bool CargoDelivery::operator()(CargoPacket *cp)
 	return this->Postprocess(cp, remove);
 }
 
-/**
- * Loads some cargo onto a vehicle.
- * @param cp Packet to be loaded.
- * @return True if the packet was completely loaded, false if part of it was.
- */
-bool CargoLoad::operator()(CargoPacket *cp)
-{
-	CargoPacket *cp_new = this->Preprocess(cp);
-	if (cp_new == nullptr) return false;
-	cp_new->UpdateLoadingTile(this->current_tile);
-	this->source->RemoveFromCache(cp_new, cp_new->Count());
-	this->destination->Append(cp_new, VehicleCargoList::MTA_KEEP);
-	return cp_new == cp;
-}
-
-/**
- * Reserves some cargo for loading.
- * @param cp Packet to be reserved.
- * @return True if the packet was completely reserved, false if part of it was.
- */
-bool CargoReservation::operator()(CargoPacket *cp)
-{
-	CargoPacket *cp_new = this->Preprocess(cp);
-	if (cp_new == nullptr) return false;
-	cp_new->UpdateLoadingTile(this->current_tile);
-	this->source->reserved_count += cp_new->Count();
-	this->source->RemoveFromCache(cp_new, cp_new->Count());
-	this->destination->Append(cp_new, VehicleCargoList::MTA_LOAD);
-	return cp_new == cp;
-}
-
 /**
  * Returns some reserved cargo.
  * @param cp Packet to be returned.
@@ -200,6 +169,8 @@ bool StationCargoReroute::operator()(CargoPacket *cp)
 	if (cp_new == nullptr) cp_new = cp;
 	StationID next = this->ge->GetVia(cp_new->GetFirstStation(), this->avoid, this->avoid2);
 	assert(next != this->avoid && next != this->avoid2);
+	this->source->InvalidateSummary();
+	this->destination->InvalidateSummary();
 	if (this->source != this->destination) {
 		this->source->RemoveFromCache(cp_new, cp_new->Count());
 		this->destination->AddToCache(cp_new);
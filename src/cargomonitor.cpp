@@ -11,11 +11,60 @@
 #include "cargomonitor.h"
 #include "station_base.h"
 
+#include <bitset>
+
 #include "safeguards.h"
 
 CargoMonitorMap _cargo_pickups;    ///< Map of monitored pick-ups   to the amount since last query/activation.
 CargoMonitorMap _cargo_deliveries; ///< Map of monitored deliveries to the amount since last query/activation.
 
+/**
+ * Company and cargo type combinations which may have a monitor in a monitoring map.
+ * This is a superset of the monitored combinations: bits are set when monitors are added, and only reset when the map is rebuilt.
+ * Deliveries without any monitor for their company and cargo type can then skip the map lookups.
+ */
+struct CargoMonitorPresence {
+	std::bitset<1 << (CCB_COMPANY_LENGTH + CCB_CARGO_TYPE_LENGTH)> present; ///< Bit per company and cargo type.
+	bool valid = false; ///< Whether #present is up to date, the map was changed directly otherwise.
+
+	/**
+	 * Get the bit of the company and cargo type of a monitor.
+	 * @param num Cargo monitor.
+	 * @return Index in #present.
+	 */
+	static inline uint GetIndex(CargoMonitorID num)
+	{
+		static_assert(CCB_COMPANY_START == CCB_CARGO_TYPE_START + CCB_CARGO_TYPE_LENGTH);
+		return GB(num, CCB_CARGO_TYPE_START, CCB_CARGO_TYPE_LENGTH + CCB_COMPANY_LENGTH);
+	}
+
+	/**
+	 * Make sure the presence bits cover all monitors of a monitoring map.
+	 * @param monitor_map Monitoring map of these bits.
+	 */
+	void Update(const CargoMonitorMap &monitor_map)
+	{
+		if (this->valid) return;
+		this->present.reset();
+		for (const auto &it : monitor_map) this->present.set(GetIndex(it.first));
+		this->valid = true;
+	}
+
+	/**
+	 * Check whether a company and cargo type combination may have a monitor.
+	 * @param company Company performing the transport.
+	 * @param ctype Cargo type being transported.
+	 * @return false if there is certainly no monitor.
+	 */
+	inline bool MayBePresent(CompanyID company, CargoID ctype) const
+	{
+		return this->present.test(GetIndex(EncodeCargoTownMonitor(company, ctype, 0)));
+	}
+};
+
+static CargoMonitorPresence _cargo_pickup_presence;   ///< Company and cargo types which may be in #_cargo_pickups.
+static CargoMonitorPresence _cargo_delivery_presence; ///< Company and cargo types which may be in #_cargo_deliveries.
+
 /**
  * Helper method for #ClearCargoPickupMonitoring and #ClearCargoDeliveryMonitoring.
  * Clears all monitors that belong to the specified company or all if #INVALID_OWNER
@@ -23,8 +72,11 @@ CargoMonitorMap _cargo_deliveries; ///< Map of monitored deliveries to the amoun
  * @param cargo_monitor_map reference to the cargo monitor map to operate on.
  * @param company company to clear cargo monitors for or #INVALID_OWNER if all cargo monitors should be cleared.
  */
-static void ClearCargoMonitoring(CargoMonitorMap &cargo_monitor_map, CompanyID company = INVALID_OWNER)
+static void ClearCargoMonitoring(CargoMonitorMap &cargo_monitor_map, CargoMonitorPresence &presence, CompanyID company = INVALID_OWNER)
 {
+	/* The map may also be filled directly after clearing, such as when loading. */
+	presence.valid = false;
+
 	if (company == INVALID_OWNER) {
 		cargo_monitor_map.clear();
 		return;
@@ -46,7 +98,7 @@ static void ClearCargoMonitoring(CargoMonitorMap &cargo_monitor_map, CompanyID c
  */
 void ClearCargoPickupMonitoring(CompanyID company)
 {
-	ClearCargoMonitoring(_cargo_pickups, company);
+	ClearCargoMonitoring(_cargo_pickups, _cargo_pickup_presence, company);
 }
 
 /**
@@ -56,23 +108,25 @@ void ClearCargoPickupMonitoring(CompanyID company)
  */
 void ClearCargoDeliveryMonitoring(CompanyID company)
 {
-	ClearCargoMonitoring(_cargo_deliveries, company);
+	ClearCargoMonitoring(_cargo_deliveries, _cargo_delivery_presence, company);
 }
 
 /**
  * Get and reset the amount associated with a cargo monitor.
  * @param[in,out] monitor_map Monitoring map to search (and reset for the queried entry).
+ * @param[in,out] presence Presence bits of \a monitor_map.
  * @param monitor Cargo monitor to query/reset.
  * @param keep_monitoring After returning from this call, continue monitoring.
  * @return Amount collected since last query/activation for the monitored combination.
  */
-static int32 GetAmount(CargoMonitorMap &monitor_map, CargoMonitorID monitor, bool keep_monitoring)
+static int32 GetAmount(CargoMonitorMap &monitor_map, CargoMonitorPresence &presence, CargoMonitorID monitor, bool keep_monitoring)
 {
 	CargoMonitorMap::iterator iter = monitor_map.find(monitor);
 	if (iter == monitor_map.end()) {
 		if (keep_monitoring) {
 			std::pair<CargoMonitorID, uint32> p(monitor, 0);
 			monitor_map.insert(p);
+			presence.present.set(CargoMonitorPresence::GetIndex(monitor));
 		}
 		return 0;
 	} else {
@@ -91,7 +145,7 @@ static int32 GetAmount(CargoMonitorMap &monitor_map, CargoMonitorID monitor, boo
  */
 int32 GetDeliveryAmount(CargoMonitorID monitor, bool keep_monitoring)
 {
-	return GetAmount(_cargo_deliveries, monitor, keep_monitoring);
+	return GetAmount(_cargo_deliveries, _cargo_delivery_presence, monitor, keep_monitoring);
 }
 
 /**
@@ -103,7 +157,7 @@ int32 GetDeliveryAmount(CargoMonitorID monitor, bool keep_monitoring)
  */
 int32 GetPickupAmount(CargoMonitorID monitor, bool keep_monitoring)
 {
-	return GetAmount(_cargo_pickups, monitor, keep_monitoring);
+	return GetAmount(_cargo_pickups, _cargo_pickup_presence, monitor, keep_monitoring);
 }
 
 /**
@@ -120,7 +174,8 @@ void AddCargoDelivery(CargoID cargo_type, CompanyID company, uint32 amount, Sour
 {
 	if (amount == 0) return;
 
-	if (src != INVALID_SOURCE) {
+	_cargo_pickup_presence.Update(_cargo_pickups);
+	if (src != INVALID_SOURCE && _cargo_pickup_presence.MayBePresent(company, cargo_type)) {
 		/* Handle pickup update. */
 		switch (src_type) {
 			case SourceType::Industry: {
@@ -141,6 +196,8 @@ void AddCargoDelivery(CargoID cargo_type, CompanyID company, uint32 amount, Sour
 
 	/* Handle delivery.
 	 * Note that delivery in the right area is sufficient to prevent trouble with neighbouring industries or houses. */
+	_cargo_delivery_presence.Update(_cargo_deliveries);
+	if (!_cargo_delivery_presence.MayBePresent(company, cargo_type)) return;
 
 	/* Town delivery. */
 	CargoMonitorID num = EncodeCargoTownMonitor(company, cargo_type, st->town->index);
@@ -148,11 +205,13 @@ void AddCargoDelivery(CargoID cargo_type, CompanyID company, uint32 amount, Sour
 	if (iter != _cargo_deliveries.end()) iter->second += amount;
 
 	/* Industry delivery. */
+	if (dest == INVALID_INDUSTRY) return;
 	for (const auto &i : st->industries_near) {
 		if (i.industry->index != dest) continue;
 		CargoMonitorID num = EncodeCargoIndustryMonitor(company, cargo_type, i.industry->index);
 		CargoMonitorMap::iterator iter = _cargo_deliveries.find(num);
 		if (iter != _cargo_deliveries.end()) iter->second += amount;
+		break;
 	}
 }
 
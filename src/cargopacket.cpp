@@ -20,6 +20,7 @@
 #include "strings_func.h"
 #include "3rdparty/cpp-btree/btree_map.h"
 
+#include <unordered_map>
 #include <vector>
 
 #include "safeguards.h"
@@ -28,6 +29,8 @@
 CargoPacketPool _cargopacket_pool("CargoPacket");
 INSTANTIATE_POOL_METHODS(CargoPacket)
 
+StationCargoCompactionStats _station_cargo_compaction_stats;
+
 btree::btree_map<uint64, Money> _cargo_packet_deferred_payments;
 
 void ClearCargoPacketDeferredPayments() {
@@ -94,7 +97,55 @@ void DumpCargoPacketDeferredPaymentStats(char *buffer, const char *last)
 		}
 	}
 	buffer += seprintf(buffer, last, "Deferred payment count: %u\n", (uint) _cargo_packet_deferred_payments.size());
-	buffer += seprintf(buffer, last, "Total cargo packets: %u\n", (uint)CargoPacket::GetNumItems());
+	const size_t live = CargoPacket::GetNumItems();
+	const size_t slots = CargoPacket::GetPoolSize();
+	const size_t cached = _cargopacket_pool.GetAllocCacheCount();
+	buffer += seprintf(buffer, last, "Total cargo packets: " PRINTF_SIZE " (" PRINTF_SIZE " KiB, " PRINTF_SIZE " bytes each)\n", live, (live * sizeof(CargoPacket)) / 1024, sizeof(CargoPacket));
+	buffer += seprintf(buffer, last, "Cargo packet pool: slots in use range: " PRINTF_SIZE ", free slots in range: " PRINTF_SIZE " (%u%% fragmentation), allocated slots: " PRINTF_SIZE " (" PRINTF_SIZE " KiB)\n",
+			slots, slots - live, slots > 0 ? (uint)(((slots - live) * 100) / slots) : 0, _cargopacket_pool.size, (_cargopacket_pool.size * sizeof(CargoPacket *)) / 1024);
+	buffer += seprintf(buffer, last, "Cargo packet pool: freed packets kept for reuse: " PRINTF_SIZE " (" PRINTF_SIZE " KiB)\n", cached, (cached * sizeof(CargoPacket)) / 1024);
+
+	size_t station_packets = 0;
+	size_t station_next_hops = 0;
+	for (const Station *st : Station::Iterate()) {
+		for (const GoodsEntry &ge : st->goods) {
+			if (ge.data == nullptr) continue;
+			station_packets += ge.data->cargo.Packets()->size();
+			station_next_hops += ge.data->cargo.Packets()->MapSize();
+		}
+	}
+	buffer += seprintf(buffer, last, "Station cargo packets: " PRINTF_SIZE ", next hop lists: " PRINTF_SIZE "\n", station_packets, station_next_hops);
+
+	const StationCargoCompactionStats &stats = _station_cargo_compaction_stats;
+	buffer += seprintf(buffer, last, "Station cargo compaction: lists: " OTTD_PRINTF64U ", packets before: " OTTD_PRINTF64U ", packets merged: " OTTD_PRINTF64U "\n",
+			stats.lists, stats.packets_before, stats.packets_merged);
+}
+
+/**
+ * Renumber all cargo packets so that they use the lowest pool indexes, without any holes.
+ * The cargo lists refer to packets by pointer, so only the deferred payments, which are keyed by packet index, need to be updated.
+ * Packet indexes do not affect the game state, so this can be done by one instance of a network game independently of the others.
+ */
+/* static */ void CargoPacket::CompactPoolIndices()
+{
+	const size_t old_size = CargoPacket::GetPoolSize();
+	size_t moved_count = 0;
+	std::vector<std::pair<uint64, Money>> to_move;
+	_cargopacket_pool.CompactIndices([&](CargoPacket *cp, size_t old_index) {
+		moved_count++;
+		if (cp->flags & CPF_HAS_DEFERRED_PAYMENT) {
+			to_move.clear();
+			IterateCargoPacketDeferredPayments((CargoPacketID)old_index, true, [&](Money &payment, CompanyID cid, VehicleType type) {
+				to_move.push_back({ CargoPacketDeferredPaymentKey(cp->index, cid, type), payment });
+			});
+			for (auto &m : to_move) {
+				_cargo_packet_deferred_payments[m.first] = m.second;
+			}
+		}
+	});
+	_cargopacket_pool.ShrinkPool();
+	DEBUG(misc, 2, "Compacted cargo packet pool: " PRINTF_SIZE " packets, " PRINTF_SIZE " moved, used index range " PRINTF_SIZE " -> " PRINTF_SIZE,
+			CargoPacket::GetNumItems(), moved_count, old_size, CargoPacket::GetPoolSize());
 }
 
 /**
@@ -441,6 +492,61 @@ void VehicleCargoList::Append(CargoPacket *cp, MoveToAction action)
 	NOT_REACHED();
 }
 
+/**
+ * Appends a range of cargo packets, as if each was appended with Append(), but updating the cached counts in a single pass.
+ * @warning After appending the packets may not exist anymore!
+ * @param packets Cargo packets to add, in order.
+ * @param action Either MTA_KEEP if you want to add the packets directly or MTA_LOAD
+ * if you want to reserve them first.
+ * @pre action == MTA_LOAD || (action == MTA_KEEP && this->designation_counts[MTA_LOAD] == 0)
+ */
+void VehicleCargoList::AppendBulk(const std::vector<CargoPacket *> &packets, MoveToAction action)
+{
+	dbg_assert(action == MTA_LOAD ||
+			(action == MTA_KEEP && this->action_counts[MTA_LOAD] == 0));
+	this->AssertCountConsistency();
+
+	bool empty = this->count == 0;
+	uint action_count = this->action_counts[action];
+	uint count = 0;
+	uint64 periods = 0;
+	Money feeder_share = 0;
+	for (const CargoPacket *cp : packets) {
+		count += cp->count;
+		periods += static_cast<uint64_t>(cp->periods_in_transit) * cp->count;
+		feeder_share += cp->feeder_share;
+	}
+	this->count += count;
+	this->cargo_periods_in_transit += periods;
+	this->feeder_share += feeder_share;
+	this->action_counts[action] += count;
+
+	for (CargoPacket *cp : packets) {
+		/* This is the merge search of Append(), with the action count as it would be after appending this packet */
+		action_count += cp->count;
+		if (empty) {
+			this->packets.push_back(cp);
+			empty = false;
+			continue;
+		}
+
+		uint sum = cp->count;
+		bool done = false;
+		for (ReverseIterator it(this->packets.rbegin()); it != this->packets.rend(); it++) {
+			CargoPacket *icp = *it;
+			if (VehicleCargoList::TryMerge(icp, cp)) {
+				done = true;
+				break;
+			}
+			sum += icp->count;
+			if (sum >= action_count) break;
+		}
+		if (!done) this->packets.push_back(cp);
+	}
+
+	this->AssertCountConsistency();
+}
+
 /**
  * Shifts cargo from the front of the packet list and applies some action to it.
  * @tparam Taction Action class or function to be used. It should define
@@ -886,6 +992,58 @@ uint VehicleCargoList::RerouteFromSource(uint max_move, VehicleCargoList *dest,
  *
  */
 
+/**
+ * Update the cached values to reflect the removal of this packet or part of it.
+ * @param cp Packet to be removed from cache.
+ * @param count Amount of cargo from the given packet to be removed.
+ */
+void StationCargoList::RemoveFromCache(const CargoPacket *cp, uint count)
+{
+	this->InvalidateSummary();
+	this->Parent::RemoveFromCache(cp, count);
+}
+
+/**
+ * Update the cache to reflect adding of this packet.
+ * @param cp New packet to be inserted.
+ */
+void StationCargoList::AddToCache(const CargoPacket *cp)
+{
+	this->InvalidateSummary();
+	this->Parent::AddToCache(cp);
+}
+
+/** Invalidates the cached data and rebuilds it. */
+void StationCargoList::InvalidateCache()
+{
+	this->InvalidateSummary();
+	this->Parent::InvalidateCache();
+}
+
+/**
+ * Get the available cargo, summed per first station and next hop.
+ * This is what the station view shows; it is only rebuilt from the packets when they were changed since the last call.
+ * @return Summary of the available cargo, sorted by next hop and then by first station.
+ */
+const std::vector<StationCargoSummaryEntry> &StationCargoList::GetSummary() const
+{
+	if (this->summary_valid) return this->summary;
+
+	this->summary.clear();
+	btree::btree_map<StationID, uint> per_first_station;
+	for (const auto &it : static_cast<const StationCargoPacketMap::Map &>(this->packets)) {
+		per_first_station.clear();
+		for (const CargoPacket *cp : it.second) {
+			per_first_station[cp->first_station] += cp->count;
+		}
+		for (const auto &entry : per_first_station) {
+			this->summary.push_back({ entry.first, it.first, entry.second });
+		}
+	}
+	this->summary_valid = true;
+	return this->summary;
+}
+
 /**
  * Appends the given cargo packet to the range of packets with the same next station
  * @warning After appending this packet may not exist anymore!
@@ -1088,6 +1246,68 @@ uint StationCargoList::Truncate(uint max_move, StationCargoAmountMap *cargo_per_
 	return moved;
 }
 
+/**
+ * Moves cargo from the front of the packet lists for the given next hops, and then from the list for "any station", to a vehicle.
+ * Whole packets are taken from the lists in one go and at most one packet is split, the cached counts are updated in a single pass.
+ * @tparam Taction MTA_KEEP to load the cargo, MTA_LOAD to reserve it.
+ * @param max_move Maximum amount of cargo to move.
+ * @param dest VehicleCargoList to move the cargo to.
+ * @param next_station Next station(s) the loading vehicle will visit.
+ * @param current_tile Current tile the cargo handling is happening on.
+ * @return Amount of cargo actually moved.
+ */
+template <VehicleCargoList::MoveToAction Taction>
+uint StationCargoList::MoveToVehicle(uint max_move, VehicleCargoList *dest, StationIDStack next_station, TileIndex current_tile)
+{
+	/* Only used on the main thread, keep the allocation around */
+	static std::vector<CargoPacket *> moved_packets;
+	moved_packets.clear();
+
+	uint moved = 0;
+	uint64 moved_periods = 0;
+	auto take_packets = [&](StationID next) -> bool {
+		StationCargoPacketMap::MapIterator map_it = this->packets.StationCargoPacketMap::Map::find(next);
+		if (map_it == this->packets.StationCargoPacketMap::Map::end()) return true;
+
+		StationCargoPacketMap::List &list = map_it->second;
+		size_t taken = 0;
+		bool split_failed = false;
+		while (taken < list.size() && moved < max_move) {
+			CargoPacket *cp = list[taken];
+			if (cp->count > max_move - moved) {
+				cp = cp->Split(max_move - moved);
+				if (cp == nullptr) {
+					split_failed = true;
+					break;
+				}
+			} else {
+				taken++;
+			}
+			cp->UpdateLoadingTile(current_tile);
+			moved += cp->count;
+			moved_periods += static_cast<uint64_t>(cp->periods_in_transit) * cp->count;
+			moved_packets.push_back(cp);
+		}
+
+		list.erase(list.begin(), list.begin() + taken);
+		if (list.empty()) this->packets.StationCargoPacketMap::Map::erase(map_it);
+		return !split_failed;
+	};
+
+	bool ok = true;
+	while (ok && !next_station.IsEmpty() && moved < max_move) {
+		ok = take_packets(next_station.Pop());
+	}
+	if (ok && moved < max_move) take_packets(INVALID_STATION);
+
+	this->InvalidateSummary();
+	this->count -= moved;
+	this->cargo_periods_in_transit -= moved_periods;
+	if (Taction == VehicleCargoList::MTA_LOAD) this->reserved_count += moved;
+	dest->AppendBulk(moved_packets, Taction);
+	return moved;
+}
+
 /**
  * Reserves cargo for loading onto the vehicle.
  * @param max_move Maximum amount of cargo to reserve.
@@ -1098,7 +1318,7 @@ uint StationCargoList::Truncate(uint max_move, StationCargoAmountMap *cargo_per_
  */
 uint StationCargoList::Reserve(uint max_move, VehicleCargoList *dest, StationIDStack next_station, TileIndex current_tile)
 {
-	return this->ShiftCargo(CargoReservation(this, dest, max_move, current_tile), next_station, true);
+	return this->MoveToVehicle<VehicleCargoList::MTA_LOAD>(max_move, dest, next_station, current_tile);
 }
 
 /**
@@ -1121,7 +1341,7 @@ uint StationCargoList::Load(uint max_move, VehicleCargoList *dest, StationIDStac
 		dest->Reassign<VehicleCargoList::MTA_LOAD, VehicleCargoList::MTA_KEEP>(move);
 		return move;
 	} else {
-		return this->ShiftCargo(CargoLoad(this, dest, max_move, current_tile), next_station, true);
+		return this->MoveToVehicle<VehicleCargoList::MTA_KEEP>(max_move, dest, next_station, current_tile);
 	}
 }
 
@@ -1151,6 +1371,115 @@ uint StationCargoList::RerouteFromSource(uint max_move, StationCargoList *dest,
 	return this->ShiftCargoFromSource(StationCargoReroute(this, dest, max_move, avoid, avoid2, ge), source, avoid, false);
 }
 
+/**
+ * Routes all packets with station "avoid" as next hop and one of a set of source stations to a different place.
+ * This is done in a single pass over the packets, instead of one pass per source station.
+ * @param dest List to append the cargo to.
+ * @param sources Source stations, sorted.
+ * @param avoid Station to exclude from routing and current next hop of packets to reroute.
+ * @param avoid2 Additional station to exclude from routing.
+ * @param ge GoodsEntry to get the routing info from.
+ * @return Amount of cargo actually moved.
+ */
+uint StationCargoList::RerouteFromSources(StationCargoList *dest, const std::vector<StationID> &sources, StationID avoid, StationID avoid2, const GoodsEntry *ge)
+{
+	StationCargoPacketMap::MapIterator map_it = this->packets.StationCargoPacketMap::Map::find(avoid);
+	if (map_it == this->packets.StationCargoPacketMap::Map::end()) return 0;
+
+	StationCargoReroute action(this, dest, UINT_MAX, avoid, avoid2, ge);
+	StationCargoPacketMap::List &list = map_it->second;
+	size_t out = 0;
+	for (size_t i = 0; i < list.size(); i++) {
+		CargoPacket *cp = list[i];
+		if (std::binary_search(sources.begin(), sources.end(), cp->GetFirstStation())) {
+			/* The packet is never split, as the amount to move is unlimited.
+			 * The packet is inserted into the list of another next hop, which doesn't invalidate this list. */
+			action(cp);
+		} else {
+			list[out++] = cp;
+		}
+	}
+
+	list.erase(list.begin() + out, list.end());
+	if (list.empty()) this->packets.StationCargoPacketMap::Map::erase(map_it);
+	return UINT_MAX - action.MaxMove();
+}
+
+/**
+ * Merge compatible packets with the same next hop, to reduce the number of packets in the list.
+ * Packets are merged into the first compatible packet before them, as StationCargoList::Append does.
+ * @param periods_tolerance Maximum difference in cargo aging periods in transit of packets to be merged,
+ *                          a merged packet gets the average of the periods in transit, weighted by count.
+ * @return Number of packets which were merged into another packet.
+ */
+uint StationCargoList::Compact(uint16 periods_tolerance)
+{
+	/** Packets which are compatible except possibly for their periods in transit. */
+	struct PacketKey {
+		TileIndex source_xy;
+		StationID first_station;
+		SourceType source_type;
+		SourceID source_id;
+		uint16 periods_in_transit;
+
+		bool operator==(const PacketKey &other) const
+		{
+			return this->source_xy == other.source_xy && this->first_station == other.first_station &&
+					this->source_type == other.source_type && this->source_id == other.source_id && this->periods_in_transit == other.periods_in_transit;
+		}
+	};
+	struct PacketKeyHash {
+		size_t operator()(const PacketKey &key) const
+		{
+			return std::hash<uint64>()(((uint64)key.source_xy << 32) | ((uint64)key.first_station << 16) | key.periods_in_transit) ^
+					std::hash<uint32>()(((uint32)key.source_type << 16) | key.source_id);
+		}
+	};
+	/* Only used on the main thread, keep the allocation around */
+	static std::unordered_map<PacketKey, CargoPacket *, PacketKeyHash> merge_targets;
+
+	uint merged = 0;
+	for (auto &it : static_cast<StationCargoPacketMap::Map &>(this->packets)) {
+		StationCargoPacketMap::List &list = it.second;
+		if (list.size() < 2) continue;
+
+		_station_cargo_compaction_stats.lists++;
+		_station_cargo_compaction_stats.packets_before += list.size();
+
+		merge_targets.clear();
+		size_t out = 0;
+		for (size_t i = 0; i < list.size(); i++) {
+			CargoPacket *cp = list[i];
+			PacketKey key { cp->source_xy, cp->first_station, cp->source_type, cp->source_id, periods_tolerance == 0 ? cp->periods_in_transit : (uint16)0 };
+			auto target = merge_targets.find(key);
+			if (target != merge_targets.end()) {
+				CargoPacket *icp = target->second;
+				if (icp->count + cp->count <= CargoPacket::MAX_COUNT && Delta(icp->periods_in_transit, cp->periods_in_transit) <= periods_tolerance) {
+					if (icp->periods_in_transit != cp->periods_in_transit) {
+						/* Remove both packets from the cache and re-add the merged one, so that the periods in transit cache stays exact */
+						this->RemoveFromCache(icp, icp->count);
+						this->RemoveFromCache(cp, cp->count);
+						uint total = icp->count + cp->count;
+						icp->periods_in_transit = (uint16)(((uint64)icp->periods_in_transit * icp->count + (uint64)cp->periods_in_transit * cp->count + total / 2) / total);
+						icp->Merge(cp);
+						this->AddToCache(icp);
+					} else {
+						icp->Merge(cp);
+					}
+					merged++;
+					continue;
+				}
+			}
+			merge_targets[key] = cp;
+			list[out++] = cp;
+		}
+		list.erase(list.begin() + out, list.end());
+	}
+
+	_station_cargo_compaction_stats.packets_merged += merged;
+	return merged;
+}
+
 /*
  * We have to instantiate everything we want to be usable.
  */
@@ -43,6 +43,14 @@ namespace upstream_sl {
 	class SlStationGoods;
 }
 
+/** Statistics of the periodic compaction of station cargo lists. */
+struct StationCargoCompactionStats {
+	uint64 lists = 0;          ///< Number of station cargo lists compacted.
+	uint64 packets_before = 0; ///< Number of packets in those lists before compaction.
+	uint64 packets_merged = 0; ///< Number of packets which were merged into another packet.
+};
+extern StationCargoCompactionStats _station_cargo_compaction_stats;
+
 void ClearCargoPacketDeferredPayments();
 void ChangeOwnershipOfCargoPacketDeferredPayments(Owner old_owner, Owner new_owner);
 
@@ -288,6 +296,7 @@ public:
 	static void AfterLoad();
 	static void PostVehiclesAfterLoad();
 	static bool ValidateDeferredCargoPayments();
+	static void CompactPoolIndices();
 };
 
 /**
@@ -517,6 +526,7 @@ public:
 	}
 
 	void Append(CargoPacket *cp, MoveToAction action = MTA_KEEP);
+	void AppendBulk(const std::vector<CargoPacket *> &packets, MoveToAction action);
 
 	void AgeCargo();
 
@@ -568,6 +578,13 @@ public:
 typedef MultiMap<StationID, CargoPacket *, CargoPacketList> StationCargoPacketMap;
 typedef btree::btree_map<StationID, uint> StationCargoAmountMap;
 
+/** Amount of the cargo available at a station with the same first station and next hop. */
+struct StationCargoSummaryEntry {
+	StationID first_station; ///< Station the cargo was first loaded at.
+	StationID next;          ///< Next hop of the cargo.
+	uint count;              ///< Amount of cargo.
+};
+
 /**
  * CargoList that is used for stations.
  */
@@ -578,6 +595,18 @@ protected:
 
 	uint reserved_count; ///< Amount of cargo being reserved for loading.
 
+	mutable std::vector<StationCargoSummaryEntry> summary; ///< Cache of the available cargo per first station and next hop, see GetSummary.
+	mutable bool summary_valid = false;                    ///< Whether #summary is up to date.
+
+	void AddToCache(const CargoPacket *cp);
+	void RemoveFromCache(const CargoPacket *cp, uint count);
+
+	/** Mark the summary of the available cargo as out of date, because packets were added, removed or moved. */
+	inline void InvalidateSummary()
+	{
+		this->summary_valid = false;
+	}
+
 public:
 	/** The super class ought to know what it's doing. */
 	friend class CargoList<StationCargoList, StationCargoPacketMap>;
@@ -585,16 +614,18 @@ public:
 	friend SaveLoadTable GetGoodsDesc();
 	friend upstream_sl::SlStationGoods;
 
-	friend class CargoLoad;
 	friend class CargoTransfer;
 	template<class Tsource>
 	friend class CargoRemoval;
-	friend class CargoReservation;
 	friend class CargoReturn;
 	friend class StationCargoReroute;
 
 	static void InvalidateAllFrom(SourceType src_type, SourceID src);
 
+	void InvalidateCache();
+
+	const std::vector<StationCargoSummaryEntry> &GetSummary() const;
+
 	template<class Taction>
 	bool ShiftCargo(Taction &action, StationID next);
 
@@ -607,6 +638,9 @@ public:
 	template<class Taction>
 	uint ShiftCargoFromSource(Taction action, StationID source, StationIDStack next, bool include_invalid);
 
+	template<VehicleCargoList::MoveToAction Taction>
+	uint MoveToVehicle(uint max_move, VehicleCargoList *dest, StationIDStack next_station, TileIndex current_tile);
+
 	void Append(CargoPacket *cp, StationID next);
 
 	/**
@@ -672,6 +706,9 @@ public:
 	uint Truncate(uint max_move = UINT_MAX, StationCargoAmountMap *cargo_per_source = nullptr);
 	uint Reroute(uint max_move, StationCargoList *dest, StationID avoid, StationID avoid2, const GoodsEntry *ge);
 	uint RerouteFromSource(uint max_move, StationCargoList *dest, StationID source, StationID avoid, StationID avoid2, const GoodsEntry *ge);
+	uint RerouteFromSources(StationCargoList *dest, const std::vector<StationID> &sources, StationID avoid, StationID avoid2, const GoodsEntry *ge);
+
+	uint Compact(uint16 periods_tolerance);
 
 	void AfterLoadIncreaseReservationCount(uint count)
 	{
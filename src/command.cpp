@@ -13,6 +13,7 @@
 #include "gui.h"
 #include "command_func.h"
 #include "command_aux.h"
+#include "command_journal.h"
 #include "network/network_type.h"
 #include "network/network.h"
 #include "genworld.h"
@@ -313,6 +314,7 @@ CommandProc CmdChangePlanColour;
 CommandProc CmdRenamePlan;
 
 CommandProc CmdDesyncCheck;
+CommandProc CmdPostponeLinkGraphJoin;
 
 #define DEF_CMD(proc, flags, type) Command(proc, #proc, (CommandFlags)flags, type)
 
@@ -576,6 +578,7 @@ static const Command _command_proc_table[] = {
 	DEF_CMD(CmdRenamePlan,                           CMD_NO_TEST, CMDT_OTHER_MANAGEMENT      ), // CMD_RENAME_PLAN
 
 	DEF_CMD(CmdDesyncCheck,                           CMD_SERVER, CMDT_SERVER_SETTING        ), // CMD_DESYNC_CHECK
+	DEF_CMD(CmdPostponeLinkGraphJoin,    CMD_SERVER | CMD_NO_EST, CMDT_SERVER_SETTING        ), // CMD_POSTPONE_LINK_GRAPH_JOIN
 };
 static_assert(lengthof(_command_proc_table) == CMD_END);
 
@@ -1192,6 +1195,7 @@ CommandCost DoCommandPInternal(TileIndex tile, uint32 p1, uint32 p2, uint64 p3,
 			 * causes of desyncs due to bad command test implementations. */
 			DEBUG(desync, 1, "cmdf: date{%08x; %02x; %02x}; company: %02x; tile: %06x (%u x %u); p1: %08x; p2: %08x; p3: " OTTD_PRINTFHEX64PAD "; cmd: %08x; \"%s\"%s (%s)",
 					_date, _date_fract, _tick_skip_counter, (int)_current_company, tile, TileX(tile), TileY(tile), p1, p2, p3, cmd & ~CMD_NETWORK_COMMAND, text, aux_data != nullptr ? ", aux data present" : "", GetCommandName(cmd));
+			if (_command_journal_active) AppendCommandJournalEntry(tile, p1, p2, p3, cmd & ~CMD_NETWORK_COMMAND, text, aux_data, CJF_FAILED);
 		}
 		cur_company.Restore();
 		return_dcpi(res);
@@ -1213,6 +1217,7 @@ CommandCost DoCommandPInternal(TileIndex tile, uint32 p1, uint32 p2, uint64 p3,
 	}
 	DEBUG(desync, 1, "cmd: date{%08x; %02x; %02x}; company: %02x; tile: %06x (%u x %u); p1: %08x; p2: %08x; p3: " OTTD_PRINTFHEX64PAD "; cmd: %08x; \"%s\"%s(%s)",
 			_date, _date_fract, _tick_skip_counter, (int)_current_company, tile, TileX(tile), TileY(tile), p1, p2, p3, cmd & ~CMD_NETWORK_COMMAND, text, aux_data != nullptr ? ", aux data present" : "", GetCommandName(cmd));
+	if (_command_journal_active) AppendCommandJournalEntry(tile, p1, p2, p3, cmd & ~CMD_NETWORK_COMMAND, text, aux_data, CJF_NONE);
 
 	/* Actually try and execute the command. If no cost-type is given
 	 * use the construction one */
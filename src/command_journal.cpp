@@ -0,0 +1,450 @@
+/*
+ * This file is part of OpenTTD.
+ * OpenTTD is free software; you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 2.
+ * OpenTTD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with OpenTTD. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file command_journal.cpp Binary journal of the executed commands, written to disk by a separate thread. */
+
+#include "stdafx.h"
+#include "command_journal.h"
+#include "command_aux.h"
+#include "command_func.h"
+#include "console_func.h"
+#include "company_func.h"
+#include "core/backup_type.hpp"
+#include "core/mem_func.hpp"
+#include "core/random_func.hpp"
+#include "date_func.h"
+#include "debug.h"
+#include "fileio_func.h"
+#include "gfx_func.h"
+#include "map_func.h"
+#include "network/network_type.h"
+#include "openttd.h"
+#include "thread.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+#include "safeguards.h"
+
+bool _command_journal_active = false;        ///< Whether executed commands are added to the command journal.
+bool _command_journal_replay_active = false; ///< Whether a command journal is being replayed.
+
+extern uint32 _frame_counter;
+extern ClientID _cmd_client_id;
+
+/** A record of the journal, as it is queued for the writer thread. */
+struct CommandJournalSlot {
+	alignas(8) byte data[COMMAND_JOURNAL_RECORD_SIZE];
+};
+
+/**
+ * The command journal being written.
+ * Records are added by the main thread and written by the journal thread; the ring between them is single producer, single consumer and lock free.
+ * The mutex and condition variable are only used to wake up the journal thread.
+ */
+struct CommandJournal {
+	static const size_t RING_SIZE = 4096; ///< Number of records in the ring, must be a power of 2.
+	static_assert((RING_SIZE & (RING_SIZE - 1)) == 0);
+
+	std::array<CommandJournalSlot, RING_SIZE> ring; ///< Records waiting to be written.
+	std::atomic<size_t> head{0};                    ///< Number of records added to the ring, only written by the main thread.
+	std::atomic<size_t> tail{0};                    ///< Number of records written to disk, only written by the journal thread.
+	std::atomic<bool> stop{false};                  ///< Whether the journal thread should write the remaining records and exit.
+
+	std::mutex lock;                                ///< Lock for #wakeup.
+	std::condition_variable wakeup;                 ///< Signalled when the journal thread has work to do.
+	std::thread thread;                             ///< The journal thread.
+
+	FILE *file = nullptr;                           ///< File to write to, only used by the journal thread after it started.
+
+	/**
+	 * Add a record to the ring, waiting for the journal thread if the ring is full.
+	 * @param data Record of #COMMAND_JOURNAL_RECORD_SIZE bytes.
+	 */
+	void Push(const void *data)
+	{
+		const size_t head = this->head.load(std::memory_order_relaxed);
+		while (head - this->tail.load(std::memory_order_acquire) >= RING_SIZE) {
+			this->wakeup.notify_one();
+			std::this_thread::yield();
+		}
+		memcpy(this->ring[head & (RING_SIZE - 1)].data, data, COMMAND_JOURNAL_RECORD_SIZE);
+		this->head.store(head + 1, std::memory_order_release);
+
+		/* Otherwise the journal thread picks the records up when its wait times out. */
+		if (head + 1 - this->tail.load(std::memory_order_relaxed) >= RING_SIZE / 4) this->wakeup.notify_one();
+	}
+
+	/** Main loop of the journal thread. */
+	void Run()
+	{
+		bool write_error = false;
+		while (true) {
+			const size_t tail = this->tail.load(std::memory_order_relaxed);
+			const size_t head = this->head.load(std::memory_order_acquire);
+			if (head == tail) {
+				if (this->stop.load()) break;
+				if (!write_error) fflush(this->file);
+
+				std::unique_lock<std::mutex> lk(this->lock);
+				this->wakeup.wait_for(lk, std::chrono::milliseconds(100), [&]() {
+					return this->stop.load() || this->head.load(std::memory_order_acquire) != tail;
+				});
+				continue;
+			}
+
+			/* Write the records up to the end of the ring, the rest is handled in the next iteration. */
+			const size_t start = tail & (RING_SIZE - 1);
+			const size_t count = std::min(head - tail, RING_SIZE - start);
+			if (!write_error && fwrite(this->ring[start].data, COMMAND_JOURNAL_RECORD_SIZE, count, this->file) != count) {
+				DEBUG(misc, 0, "Writing the command journal failed, further commands are not written");
+				write_error = true;
+			}
+			this->tail.store(tail + count, std::memory_order_release);
+		}
+		fclose(this->file);
+		this->file = nullptr;
+	}
+
+	/** Thread entry point. */
+	static void RunThread(CommandJournal *journal)
+	{
+		journal->Run();
+	}
+};
+
+static std::unique_ptr<CommandJournal> _command_journal;
+
+/**
+ * Start writing executed commands to a command journal file.
+ * @param filename File to write the journal to, relative to the save directory.
+ * @return Whether the journal could be started.
+ */
+bool StartCommandJournal(const std::string &filename)
+{
+	StopCommandJournal();
+
+	FILE *f = FioFOpenFile(filename, "wb", SAVE_DIR);
+	if (f == nullptr) return false;
+
+	CommandJournalHeader header{};
+	memcpy(header.magic, "OTCJ", sizeof(header.magic));
+	header.version = COMMAND_JOURNAL_VERSION;
+	header.record_size = COMMAND_JOURNAL_RECORD_SIZE;
+	header.byte_order = 0x01020304;
+	header.map_size_x = MapSizeX();
+	header.map_size_y = MapSizeY();
+	if (fwrite(&header, sizeof(header), 1, f) != 1) {
+		fclose(f);
+		return false;
+	}
+
+	std::unique_ptr<CommandJournal> journal(new CommandJournal());
+	journal->file = f;
+	if (!StartNewThread(&journal->thread, "ottd:cmdjournal", &CommandJournal::RunThread, journal.get())) {
+		fclose(f);
+		return false;
+	}
+
+	_command_journal = std::move(journal);
+	_command_journal_active = true;
+	return true;
+}
+
+/**
+ * Stop the command journal, if any, after writing all queued records to disk.
+ */
+void StopCommandJournal()
+{
+	_command_journal_active = false;
+	if (_command_journal == nullptr) return;
+
+	_command_journal->stop.store(true);
+	_command_journal->wakeup.notify_one();
+	if (_command_journal->thread.joinable()) _command_journal->thread.join();
+	_command_journal.reset();
+}
+
+/**
+ * Add a command to the command journal.
+ * @param tile Tile parameter of the command.
+ * @param p1 First parameter of the command.
+ * @param p2 Second parameter of the command.
+ * @param p3 Third parameter of the command.
+ * @param cmd The command ID and error message.
+ * @param text Text of the command, may be nullptr.
+ * @param aux_data Auxiliary data of the command, may be nullptr.
+ * @param flags Flags of the command.
+ */
+void AppendCommandJournalEntry(TileIndex tile, uint32 p1, uint32 p2, uint64 p3, uint32 cmd, const char *text, const CommandAuxiliaryBase *aux_data, CommandJournalFlags flags)
+{
+	if (_command_journal == nullptr) return;
+
+	const size_t text_length = text != nullptr ? strnlen(text, MAX_CMD_TEXT_LENGTH) : 0;
+	std::vector<byte> aux_buffer;
+	if (aux_data != nullptr) {
+		CommandSerialisationBuffer serialiser(aux_buffer, UINT32_MAX);
+		aux_data->Serialise(serialiser);
+	}
+
+	CommandJournalCommandRecord record{};
+	record.type = CJRT_COMMAND;
+	record.flags = flags;
+	record.company = _current_company;
+	record.tick_skip_counter = _tick_skip_counter;
+	record.date = _date;
+	record.date_fract = _date_fract;
+	record.text_length = (uint16)text_length;
+	record.aux_length = (uint32)aux_buffer.size();
+	record.tile = tile;
+	record.p1 = p1;
+	record.p2 = p2;
+	record.cmd = cmd;
+	record.p3 = p3;
+	record.random_state[0] = _random.state[0];
+	record.random_state[1] = _random.state[1];
+	record.frame_counter = _frame_counter;
+	record.client_id = _cmd_client_id;
+	_command_journal->Push(&record);
+
+	/* Text and auxiliary data follow as one byte stream, split over payload records. */
+	CommandJournalPayloadRecord payload{};
+	payload.type = CJRT_PAYLOAD;
+	size_t fill = 0;
+	auto add_payload = [&](const byte *data, size_t length) {
+		while (length > 0) {
+			const size_t chunk = std::min(length, sizeof(payload.data) - fill);
+			memcpy(payload.data + fill, data, chunk);
+			fill += chunk;
+			data += chunk;
+			length -= chunk;
+			if (fill == sizeof(payload.data)) {
+				_command_journal->Push(&payload);
+				MemSetT(payload.data, 0, sizeof(payload.data));
+				fill = 0;
+			}
+		}
+	};
+	add_payload(reinterpret_cast<const byte *>(text), text_length);
+	add_payload(aux_buffer.data(), aux_buffer.size());
+	if (fill > 0) _command_journal->Push(&payload);
+}
+
+/**
+ * A command journal being replayed.
+ * The commands are executed at the date, date fraction and tick skip counter at which they were recorded, and the wall time of each tick is measured.
+ */
+struct CommandJournalReplay {
+	FILE *file = nullptr;                   ///< Journal being replayed.
+	FILE *timings = nullptr;                ///< File with the timing of each tick, may be nullptr.
+	bool quit_when_done = false;            ///< Whether to quit the game when the replay is done.
+
+	bool have_next = false;                 ///< Whether #next holds the next command to execute.
+	CommandJournalCommandRecord next{};     ///< Next command to execute.
+	std::string next_text;                  ///< Text of #next.
+	std::vector<byte> next_aux;             ///< Serialised auxiliary data of #next.
+
+	uint64 commands = 0;                    ///< Number of replayed commands.
+	uint64 random_mismatches = 0;           ///< Number of commands at which the random state differed from the recorded state.
+	std::vector<uint32> tick_times_us;      ///< Wall time of each unpaused tick.
+
+	~CommandJournalReplay()
+	{
+		if (this->file != nullptr) fclose(this->file);
+		if (this->timings != nullptr) fclose(this->timings);
+	}
+
+	/**
+	 * Read the next command and its payload from the journal.
+	 * @return Whether a command was read, false at the end of the journal or when it is corrupt.
+	 */
+	bool ReadNext()
+	{
+		this->have_next = false;
+		if (fread(&this->next, sizeof(this->next), 1, this->file) != 1) return false;
+		if (this->next.type != CJRT_COMMAND) {
+			DEBUG(misc, 0, "Command journal replay: unexpected record type %u, stopping", this->next.type);
+			return false;
+		}
+
+		const size_t payload_length = (size_t)this->next.text_length + this->next.aux_length;
+		std::vector<byte> payload;
+		payload.reserve(payload_length);
+		CommandJournalPayloadRecord record;
+		while (payload.size() < payload_length) {
+			if (fread(&record, sizeof(record), 1, this->file) != 1 || record.type != CJRT_PAYLOAD) {
+				DEBUG(misc, 0, "Command journal replay: truncated payload, stopping");
+				return false;
+			}
+			const size_t chunk = std::min(payload_length - payload.size(), sizeof(record.data));
+			payload.insert(payload.end(), record.data, record.data + chunk);
+		}
+
+		this->next_text.assign(reinterpret_cast<const char *>(payload.data()), this->next.text_length);
+		this->next_aux.assign(payload.begin() + this->next.text_length, payload.end());
+		this->have_next = true;
+		return true;
+	}
+
+	/** @return Whether #next was recorded at or before the current tick. */
+	bool IsNextDue() const
+	{
+		if (this->next.date != _date) return this->next.date < _date;
+		if (this->next.date_fract != _date_fract) return this->next.date_fract < _date_fract;
+		return this->next.tick_skip_counter <= _tick_skip_counter;
+	}
+
+	/**
+	 * Execute all commands which are due in the current tick.
+	 * @return Number of executed commands.
+	 */
+	uint ExecuteDueCommands()
+	{
+		uint executed = 0;
+		while (this->have_next && this->IsNextDue()) {
+			const CommandJournalCommandRecord &rec = this->next;
+			if (rec.date != _date || rec.date_fract != _date_fract || rec.tick_skip_counter != _tick_skip_counter) {
+				DEBUG(misc, 0, "Command journal replay: command 0x%X recorded at %d/%u/%u executed late at %d/%u/%u",
+						rec.cmd, rec.date, rec.date_fract, rec.tick_skip_counter, _date, _date_fract, _tick_skip_counter);
+			}
+			if (rec.random_state[0] != _random.state[0] || rec.random_state[1] != _random.state[1]) {
+				if (this->random_mismatches == 0) {
+					DEBUG(desync, 0, "Command journal replay: random state differs at command 0x%X at %d/%u/%u, the replay no longer matches the recording",
+							rec.cmd, _date, _date_fract, _tick_skip_counter);
+				}
+				this->random_mismatches++;
+			}
+
+			CommandAuxiliarySerialised aux;
+			aux.serialised_data = this->next_aux;
+
+			Backup<CompanyID> cur_company(_current_company, (CompanyID)rec.company, FILE_LINE);
+			const ClientID old_client_id = _cmd_client_id;
+			_cmd_client_id = (ClientID)rec.client_id;
+			DoCommandPEx(rec.tile, rec.p1, rec.p2, rec.p3, rec.cmd | CMD_NETWORK_COMMAND, nullptr,
+					this->next_text.empty() ? nullptr : this->next_text.c_str(), rec.aux_length > 0 ? &aux : nullptr, false);
+			_cmd_client_id = old_client_id;
+			cur_company.Restore();
+
+			this->commands++;
+			executed++;
+			this->ReadNext();
+		}
+		return executed;
+	}
+
+	/** Print the summary of the tick timings to the console. */
+	void PrintSummary() const
+	{
+		IConsolePrintF(CC_DEFAULT, "Command journal replay done: " OTTD_PRINTF64U " commands, " OTTD_PRINTF64U " random state mismatches", this->commands, this->random_mismatches);
+		if (this->tick_times_us.empty()) return;
+
+		std::vector<uint32> sorted = this->tick_times_us;
+		std::sort(sorted.begin(), sorted.end());
+		uint64 total = 0;
+		for (uint32 t : sorted) total += t;
+		auto percentile = [&](uint p) { return sorted[std::min<size_t>(sorted.size() - 1, sorted.size() * p / 100)]; };
+		IConsolePrintF(CC_DEFAULT, "  %u ticks, total: " OTTD_PRINTF64U " ms, mean: " OTTD_PRINTF64U " us, p50: %u us, p95: %u us, p99: %u us, max: %u us",
+				(uint)sorted.size(), total / 1000, total / sorted.size(), percentile(50), percentile(95), percentile(99), sorted.back());
+	}
+};
+
+static std::unique_ptr<CommandJournalReplay> _command_journal_replay;
+
+/**
+ * Start replaying a command journal on the currently loaded game.
+ * The game should be the one the journal was started on, loaded from a save made at that moment.
+ * The timing of each tick is written to a CSV file next to the journal, with ".ticks.csv" appended to its name.
+ * @param filename Journal to replay, relative to the save directory.
+ * @param quit_when_done Whether to quit the game when all commands are replayed.
+ * @param[out] error Reason why the replay could not be started.
+ * @return Whether the replay was started.
+ */
+bool StartCommandJournalReplay(const std::string &filename, bool quit_when_done, std::string &error)
+{
+	StopCommandJournalReplay();
+
+	std::unique_ptr<CommandJournalReplay> replay(new CommandJournalReplay());
+	replay->file = FioFOpenFile(filename, "rb", SAVE_DIR);
+	if (replay->file == nullptr) {
+		error = "could not open the file";
+		return false;
+	}
+
+	CommandJournalHeader header;
+	if (fread(&header, sizeof(header), 1, replay->file) != 1 || memcmp(header.magic, "OTCJ", sizeof(header.magic)) != 0) {
+		error = "not a command journal";
+		return false;
+	}
+	if (header.byte_order != 0x01020304) {
+		error = "journal was written with a different byte order";
+		return false;
+	}
+	if (header.version != COMMAND_JOURNAL_VERSION || header.record_size != COMMAND_JOURNAL_RECORD_SIZE) {
+		error = "unsupported journal version";
+		return false;
+	}
+	if (header.map_size_x != MapSizeX() || header.map_size_y != MapSizeY()) {
+		error = "journal was recorded on a map of a different size";
+		return false;
+	}
+
+	replay->timings = FioFOpenFile(filename + ".ticks.csv", "w", SAVE_DIR);
+	if (replay->timings != nullptr) fputs("date,date_fract,tick_skip_counter,commands,tick_us\n", replay->timings);
+	replay->quit_when_done = quit_when_done;
+	replay->ReadNext();
+
+	_command_journal_replay = std::move(replay);
+	_command_journal_replay_active = true;
+	ChangeGameSpeed(true);
+	return true;
+}
+
+/**
+ * Stop replaying the command journal, if any, and print the timing summary.
+ */
+void StopCommandJournalReplay()
+{
+	_command_journal_replay_active = false;
+	if (_command_journal_replay == nullptr) return;
+
+	_command_journal_replay->PrintSummary();
+	if (_command_journal_replay->quit_when_done) _exit_game = true;
+	_command_journal_replay.reset();
+	ChangeGameSpeed(false);
+}
+
+/**
+ * Run a single game tick while replaying a command journal.
+ * The commands due in this tick are executed before #StateGameLoop, like network commands are.
+ */
+void CommandJournalReplayStateGameLoop()
+{
+	CommandJournalReplay &replay = *_command_journal_replay;
+
+	const int32 date = _date;
+	const uint16 date_fract = _date_fract;
+	const uint8 tick_skip_counter = _tick_skip_counter;
+	const bool paused = _pause_mode != PM_UNPAUSED;
+
+	const auto start = std::chrono::steady_clock::now();
+	const uint commands = replay.ExecuteDueCommands();
+	StateGameLoop();
+	const uint32 time_us = (uint32)std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+
+	if (!paused) {
+		replay.tick_times_us.push_back(time_us);
+		if (replay.timings != nullptr) fprintf(replay.timings, "%d,%u,%u,%u,%u\n", date, date_fract, tick_skip_counter, commands, time_us);
+	}
+
+	if (!replay.have_next) StopCommandJournalReplay();
+}
@@ -0,0 +1,91 @@
+/*
+ * This file is part of OpenTTD.
+ * OpenTTD is free software; you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 2.
+ * OpenTTD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with OpenTTD. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file command_journal.h Binary journal of the executed commands. */
+
+#ifndef COMMAND_JOURNAL_H
+#define COMMAND_JOURNAL_H
+
+#include "command_type.h"
+#include "tile_type.h"
+
+/**
+ * File format of the command journal.
+ * The file starts with a #CommandJournalHeader, followed by records of #COMMAND_JOURNAL_RECORD_SIZE bytes.
+ * Each #CommandJournalCommandRecord is followed by as many #CommandJournalPayloadRecord as needed for its text and then its serialised auxiliary data.
+ * All values are stored in the byte order of the machine which wrote the journal, see #CommandJournalHeader::byte_order.
+ */
+static const uint16 COMMAND_JOURNAL_VERSION = 1;
+static const uint16 COMMAND_JOURNAL_RECORD_SIZE = 64;
+
+/** Types of the records in the command journal. */
+enum CommandJournalRecordType : uint8 {
+	CJRT_COMMAND = 1, ///< An executed command, #CommandJournalCommandRecord
+	CJRT_PAYLOAD = 2, ///< Text or auxiliary data of the preceding command, #CommandJournalPayloadRecord
+};
+
+/** Flags of executed commands in the command journal. */
+enum CommandJournalFlags : uint8 {
+	CJF_NONE   = 0x00, ///< No flag is set
+	CJF_FAILED = 0x01, ///< The test run of the command failed, so it was not executed
+};
+DECLARE_ENUM_AS_BIT_SET(CommandJournalFlags)
+
+/** Start of the command journal file. */
+struct CommandJournalHeader {
+	char magic[4];      ///< "OTCJ"
+	uint16 version;     ///< #COMMAND_JOURNAL_VERSION
+	uint16 record_size; ///< #COMMAND_JOURNAL_RECORD_SIZE
+	uint32 byte_order;  ///< 0x01020304 in the byte order of the records
+	uint32 map_size_x;  ///< Width of the map when the journal was started
+	uint32 map_size_y;  ///< Height of the map when the journal was started
+	uint32 reserved;    ///< Reserved, always 0
+};
+static_assert(sizeof(CommandJournalHeader) == 24);
+
+/** Record of a single executed command, with the game state needed to replay and check it. */
+struct CommandJournalCommandRecord {
+	CommandJournalRecordType type; ///< Always #CJRT_COMMAND
+	CommandJournalFlags flags;     ///< Flags of the command
+	uint8 company;                 ///< Company the command was executed for
+	uint8 tick_skip_counter;       ///< Tick skip counter at execution
+	int32 date;                    ///< Date at execution
+	uint16 date_fract;             ///< Date fraction at execution
+	uint16 text_length;            ///< Length of the command text in the following payload records
+	uint32 aux_length;             ///< Length of the serialised auxiliary data in the following payload records, after the text
+	uint32 tile;                   ///< Tile parameter
+	uint32 p1;                     ///< First parameter
+	uint32 p2;                     ///< Second parameter
+	uint32 cmd;                    ///< Command ID and error message
+	uint64 p3;                     ///< Third parameter
+	uint32 random_state[2];        ///< Game random state before execution, to check the replay
+	uint32 frame_counter;          ///< Network frame counter at execution
+	uint32 client_id;              ///< Client that sent the command
+	uint32 reserved[2];            ///< Reserved, always 0
+};
+static_assert(sizeof(CommandJournalCommandRecord) == COMMAND_JOURNAL_RECORD_SIZE);
+
+/** Record with a piece of the text or auxiliary data of a command. */
+struct CommandJournalPayloadRecord {
+	CommandJournalRecordType type;                 ///< Always #CJRT_PAYLOAD
+	uint8 data[COMMAND_JOURNAL_RECORD_SIZE - 1];   ///< Payload bytes, the last record of a command is padded with zeroes
+};
+static_assert(sizeof(CommandJournalPayloadRecord) == COMMAND_JOURNAL_RECORD_SIZE);
+
+extern bool _command_journal_active;
+
+bool StartCommandJournal(const std::string &filename);
+void StopCommandJournal();
+void AppendCommandJournalEntry(TileIndex tile, uint32 p1, uint32 p2, uint64 p3, uint32 cmd, const char *text, const CommandAuxiliaryBase *aux_data, CommandJournalFlags flags);
+
+extern bool _command_journal_replay_active;
+
+bool StartCommandJournalReplay(const std::string &filename, bool quit_when_done, std::string &error);
+void StopCommandJournalReplay();
+void CommandJournalReplayStateGameLoop();
+
+#endif /* COMMAND_JOURNAL_H */
@@ -540,6 +540,7 @@ enum Commands {
 	CMD_RENAME_PLAN,
 
 	CMD_DESYNC_CHECK,                 ///< Force desync checks to be run
+	CMD_POSTPONE_LINK_GRAPH_JOIN,     ///< Postpone the join of late link graph jobs
 
 	CMD_END,                          ///< Must ALWAYS be on the end of this list!! (period)
 };
@@ -42,6 +42,7 @@
 #include "timer/timer.h"
 #include "timer/timer_game_tick.h"
 #include "tilehighlight_func.h"
+#include "framerate_type.h"
 
 #include "table/strings.h"
 
@@ -781,6 +782,9 @@ void OnTick_Companies(bool main_tick)
 {
 	if (_game_mode == GM_EDITOR) return;
 
+	PerformanceAccumulator framerate(PFE_GL_LANDSCAPE);
+	PerformanceAccumulator framerate_companies(PFE_GL_LS_COMPANIES);
+
 	if (main_tick) {
 		Company *c = Company::GetIfValid(_cur_company_tick_index);
 		if (c != nullptr) {
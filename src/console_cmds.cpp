@@ -22,10 +22,12 @@
 #include "network/network_server.h"
 #include "command_func.h"
 #include "command_log.h"
+#include "command_journal.h"
 #include "settings_func.h"
 #include "fios.h"
 #include "fileio_func.h"
 #include "fontcache.h"
+#include "gfx_layout.h"
 #include "screenshot.h"
 #include "genworld.h"
 #include "strings_func.h"
@@ -38,11 +40,13 @@
 #include "ai/ai_config.hpp"
 #include "newgrf.h"
 #include "newgrf_profiling.h"
+#include "newgrf_storage.h"
 #include "console_func.h"
 #include "engine_base.h"
 #include "road.h"
 #include "rail.h"
 #include "game/game.hpp"
+#include "script/script_profiling.hpp"
 #include "table/strings.h"
 #include "aircraft.h"
 #include "airport.h"
@@ -54,6 +58,7 @@
 #include "industry.h"
 #include "string_func_extra.h"
 #include "linkgraph/linkgraphjob.h"
+#include "linkgraph/linkgraphschedule.h"
 #include "base_media_base.h"
 #include "debug_settings.h"
 #include "walltime_func.h"
@@ -63,7 +68,13 @@
 #include "tile_cmd.h"
 #include "object_base.h"
 #include "newgrf_newsignals.h"
+#include "pathfinder/pathfinder_stats.h"
+#include "pathfinder/yapf/nodelist.hpp"
+#include "spritecache.h"
 #include <time.h>
+#if defined(__linux__)
+#include <unistd.h>
+#endif
 
 #include "3rdparty/cpp-btree/btree_set.h"
 
@@ -1079,11 +1090,12 @@ DEF_CONSOLE_CMD(ConOfferCompanySale)
 DEF_CONSOLE_CMD(ConNetworkClients)
 {
 	if (argc == 0) {
-		IConsoleHelp("Get a list of connected clients including their ID, name, company-id, and IP. Usage: 'clients'");
+		IConsoleHelp("Get a list of connected clients including their ID, name, company-id, and IP. Usage: 'clients [timings]'");
+		IConsoleHelp("  'timings' also shows the durations of the phases of joining of each client, on the server only.");
 		return true;
 	}
 
-	NetworkPrintClients();
+	NetworkPrintClients(argc > 1 && strcmp(argv[1], "timings") == 0);
 
 	return true;
 }
@@ -1206,6 +1218,10 @@ extern bool CloseConsoleLogIfActive();
 extern const std::vector<GRFFile *> &GetAllGRFFiles();
 extern void ConPrintFramerate(); // framerate_gui.cpp
 extern void ShowFramerateWindow();
+extern void StartPerformanceTrace(size_t max_events);
+extern void StopPerformanceTrace();
+extern void PrintPerformanceTraceStatus();
+extern bool DumpPerformanceTrace(const char *filename);
 
 DEF_CONSOLE_CMD(ConScript)
 {
@@ -2362,7 +2378,13 @@ DEF_CONSOLE_CMD(ConListSettingsDefaults)
 DEF_CONSOLE_CMD(ConGamelogPrint)
 {
 	if (argc == 0) {
-		IConsoleHelp("Print logged fundamental changes to the game since the start. Usage: 'gamelog'.");
+		IConsoleHelp("Print logged fundamental changes to the game since the start. Usage: 'gamelog [compact]'.");
+		IConsoleHelp("  'compact' collapses redundant setting and NewGRF parameter changes in the log instead of printing it.");
+		return true;
+	}
+
+	if (argc == 2 && strcmp(argv[1], "compact") == 0) {
+		IConsolePrintF(CC_DEFAULT, "Gamelog compacted: removed %u logged changes.", GamelogCompact());
 		return true;
 	}
 
@@ -2586,6 +2608,51 @@ DEF_CONSOLE_CMD(ConDumpCommandLog)
 	return true;
 }
 
+DEF_CONSOLE_CMD(ConCommandJournal)
+{
+	if (argc == 0) {
+		IConsoleHelp("Write all executed commands to a binary command journal, for replaying them.");
+		IConsoleHelp("Usage: 'command_journal start <filename>' or 'command_journal stop'");
+		IConsoleHelp("The file is written to the save directory.");
+		IConsoleHelp("Usage: 'command_journal replay <filename> [quit]'");
+		IConsoleHelp("Replay a journal on the game it was started on, at full speed, and report the wall time of the ticks.");
+		IConsoleHelp("The time of each tick is written to <filename>.ticks.csv, 'quit' exits the game when the replay is done.");
+		return true;
+	}
+
+	if (argc == 3 && strcmp(argv[1], "start") == 0) {
+		if (!StartCommandJournal(argv[2])) {
+			IConsolePrintF(CC_ERROR, "Could not start the command journal: %s", argv[2]);
+			return true;
+		}
+		IConsolePrintF(CC_DEFAULT, "Writing executed commands to: %s", argv[2]);
+		return true;
+	}
+
+	if ((argc == 3 || argc == 4) && strcmp(argv[1], "replay") == 0) {
+		if (_networking) {
+			IConsolePrint(CC_ERROR, "Command journals can only be replayed in single player.");
+			return true;
+		}
+		const bool quit = argc == 4 && strcmp(argv[3], "quit") == 0;
+		std::string error;
+		if (!StartCommandJournalReplay(argv[2], quit, error)) {
+			IConsolePrintF(CC_ERROR, "Could not replay the command journal %s: %s", argv[2], error.c_str());
+			return true;
+		}
+		IConsolePrintF(CC_DEFAULT, "Replaying the command journal: %s", argv[2]);
+		return true;
+	}
+
+	if (argc == 2 && strcmp(argv[1], "stop") == 0) {
+		StopCommandJournal();
+		IConsolePrint(CC_DEFAULT, "Command journal stopped.");
+		return true;
+	}
+
+	return false;
+}
+
 DEF_CONSOLE_CMD(ConDumpSpecialEventsLog)
 {
 	if (argc == 0) {
@@ -2742,12 +2809,23 @@ DEF_CONSOLE_CMD(ConDumpLinkgraphJobs)
 		ConvertDateToYMD(lgj->StartDateTicks() / DAY_TICKS, &start_ymd);
 		YearMonthDay join_ymd;
 		ConvertDateToYMD(lgj->JoinDateTicks() / DAY_TICKS, &join_ymd);
-		IConsolePrintF(CC_DEFAULT, "  Job: %5u, nodes: %u, cost: " OTTD_PRINTF64U ", start: (%u, %4i-%02i-%02i, %i), end: (%u, %4i-%02i-%02i, %i), duration: %u",
-				lgj->index, lgj->Graph().Size(), lgj->Graph().CalculateCostEstimate(),
+		uint edges = 0;
+		for (const auto &it : lgj->Graph().GetEdges()) {
+			if (it.first.first != it.first.second) edges++;
+		}
+		IConsolePrintF(CC_DEFAULT, "  Job: %5u, nodes: %u, edges: %u (%u KiB), cost: " OTTD_PRINTF64U ", start: (%u, %4i-%02i-%02i, %i), end: (%u, %4i-%02i-%02i, %i), duration: %u",
+				lgj->index, lgj->Graph().Size(), edges, (uint)((edges * sizeof(LinkGraphJob::Edge)) / 1024), lgj->Graph().CalculateCostEstimate(),
 				lgj->StartDateTicks(), start_ymd.year, start_ymd.month + 1, start_ymd.day, lgj->StartDateTicks() % DAY_TICKS,
 				lgj->JoinDateTicks(), join_ymd.year, join_ymd.month + 1, join_ymd.day, lgj->JoinDateTicks() % DAY_TICKS,
 				lgj->JoinDateTicks() - lgj->StartDateTicks());
+		if (lgj->IsJobCompleted()) {
+			IConsolePrintF(CC_DEFAULT, "    Cargo: %u, estimated runtime: " OTTD_PRINTF64U " us, actual runtime: " OTTD_PRINTF64U " us",
+					lgj->Cargo(), lgj->EstimatedRuntime(), lgj->Runtime());
+		} else {
+			IConsolePrintF(CC_DEFAULT, "    Cargo: %u, estimated runtime: " OTTD_PRINTF64U " us, running", lgj->Cargo(), lgj->EstimatedRuntime());
+		}
 	 }
+	PrintLinkGraphRuntimeModel();
 	return true;
 }
 
@@ -3147,6 +3225,33 @@ DEF_CONSOLE_CMD(ConSpriteCacheStats)
 	return true;
 }
 
+DEF_CONSOLE_CMD(ConLineCacheStats)
+{
+	if (argc == 0) {
+		IConsoleHelp("Dump text line cache stats.");
+		return true;
+	}
+
+	char buffer[1024];
+	Layouter::DumpLineCacheStats(buffer, lastof(buffer));
+	PrintLineByLine(buffer);
+	return true;
+}
+
+DEF_CONSOLE_CMD(ConPersistentStorageStats)
+{
+	if (argc == 0) {
+		IConsoleHelp("Dump NewGRF persistent storage backup stats. Usage: 'dump_persistent_storage_stats [reset]'");
+		return true;
+	}
+
+	char buffer[1024];
+	DumpPersistentStorageStats(buffer, lastof(buffer));
+	PrintLineByLine(buffer);
+	if (argc > 1 && strcmp(argv[1], "reset") == 0) ResetPersistentStorageStats();
+	return true;
+}
+
 DEF_CONSOLE_CMD(ConCheckCaches)
 {
 	if (argc == 0) {
@@ -3306,14 +3411,21 @@ DEF_CONSOLE_CMD(ConGfxDebug)
 		IConsoleHelp("  1: GDF_SHOW_WINDOW_DIRTY");
 		IConsoleHelp("  2: GDF_SHOW_WIDGET_DIRTY");
 		IConsoleHelp("  4: GDF_SHOW_RECT_DIRTY");
+		IConsoleHelp("Without flags, the current flags and the dirty rectangle statistics since the flags were last set are shown.");
 		return true;
 	}
 
 	extern uint32 _gfx_debug_flags;
+	extern void DumpDirtyBlockStats(char *buffer, const char *last);
+	extern void ResetDirtyBlockStats();
 	if (argc == 1) {
 		IConsolePrintF(CC_DEFAULT, "Gfx debug flags: %X", _gfx_debug_flags);
+		char buffer[256];
+		DumpDirtyBlockStats(buffer, lastof(buffer));
+		IConsolePrint(CC_DEFAULT, buffer);
 	} else {
 		_gfx_debug_flags = std::strtoul(argv[1], nullptr, 16);
+		ResetDirtyBlockStats();
 	}
 
 	return true;
@@ -3331,6 +3443,129 @@ DEF_CONSOLE_CMD(ConCSleep)
 	return true;
 }
 
+DEF_CONSOLE_CMD(ConPathfinderStats)
+{
+	if (argc == 0) {
+		IConsoleHelp("Show pathfinder search statistics. Usage: 'pf_stats [reset]', 'pf_stats top [<count>] [time]' or 'pf_stats slow_log <microseconds>'");
+		IConsoleHelp("  'top' lists the vehicles with the highest cumulative pathfinding cost since the last reset, by expanded nodes or by wall time");
+		IConsoleHelp("  'slow_log' logs each search which takes at least the given time, 0 to disable");
+		return true;
+	}
+
+	if (argc == 1) {
+		PrintPathfinderStats();
+		return true;
+	}
+
+	if (strcmp(argv[1], "reset") == 0 && argc == 2) {
+		ResetPathfinderStats();
+		return true;
+	}
+
+	if (strcmp(argv[1], "top") == 0 && argc <= 4) {
+		uint32 count = 10;
+		bool by_time = false;
+		for (byte i = 2; i < argc; i++) {
+			if (strcmp(argv[i], "time") == 0) {
+				by_time = true;
+			} else if (!GetArgumentInteger(&count, argv[i])) {
+				IConsoleError("Invalid vehicle count");
+				return true;
+			}
+		}
+		PrintPathfinderTopVehicles(count, by_time);
+		return true;
+	}
+
+	if (strcmp(argv[1], "slow_log") == 0 && argc <= 3) {
+		if (argc == 3) {
+			uint32 threshold;
+			if (!GetArgumentInteger(&threshold, argv[2])) {
+				IConsoleError("Invalid time");
+				return true;
+			}
+			SetPathfinderSlowSearchThreshold(threshold);
+		}
+		IConsolePrintF(CC_DEFAULT, "Slow search log threshold: " OTTD_PRINTF64U " us", GetPathfinderSlowSearchThreshold());
+		return true;
+	}
+
+	return false;
+}
+
+DEF_CONSOLE_CMD(ConYapfNodeStats)
+{
+	if (argc == 0) {
+		IConsoleHelp("Debug: Show YAPF node list storage statistics of the game thread. Usage: 'yapf_node_stats [reset]'");
+		return true;
+	}
+
+	YapfNodeListStats &stats = _yapf_node_list_stats;
+	if (argc == 2 && strcmp(argv[1], "reset") == 0) {
+		size_t pooled_bytes = stats.pooled_bytes;
+		stats = {};
+		stats.pooled_bytes = pooled_bytes;
+		return true;
+	}
+
+	IConsolePrintF(CC_DEFAULT, "Searches: " OTTD_PRINTF64U ", re-used storage: " OTTD_PRINTF64U, stats.searches, stats.reuses);
+	IConsolePrintF(CC_DEFAULT, "Nodes: " OTTD_PRINTF64U " total, %u peak, %u last, " OTTD_PRINTF64U " average",
+			stats.total_nodes, stats.peak_nodes, stats.last_nodes, stats.searches > 0 ? stats.total_nodes / stats.searches : 0);
+	IConsolePrintF(CC_DEFAULT, "Pooled node memory: " PRINTF_SIZE " bytes", stats.pooled_bytes);
+	return true;
+}
+
+DEF_CONSOLE_CMD(ConMemoryStats)
+{
+	if (argc == 0) {
+		IConsoleHelp("Show the memory used by the pools, the map and the caches. Usage: 'memstats'");
+		return true;
+	}
+
+	std::vector<PoolMemoryStats> pools;
+	for (const PoolBase *pool : *PoolBase::GetPools()) {
+		pools.push_back(pool->GetMemoryStats());
+	}
+	std::sort(pools.begin(), pools.end(), [](const PoolMemoryStats &a, const PoolMemoryStats &b) {
+		if (a.bytes != b.bytes) return a.bytes > b.bytes;
+		return strcmp(a.name, b.name) < 0;
+	});
+
+	size_t total = 0;
+	IConsolePrint(CC_DEFAULT, "Pools:");
+	for (const PoolMemoryStats &stats : pools) {
+		if (stats.capacity == 0) continue;
+		IConsolePrintF(CC_DEFAULT, "  %-24s " PRINTF_SIZE " KiB, " PRINTF_SIZE " items, " PRINTF_SIZE " allocated", stats.name, stats.bytes / 1024, stats.items, stats.capacity);
+		total += stats.bytes;
+	}
+
+	const size_t map_bytes = (size_t)MapSize() * (sizeof(Tile) + sizeof(TileExtended));
+	IConsolePrintF(CC_DEFAULT, "Map:                       " PRINTF_SIZE " KiB", map_bytes / 1024);
+	total += map_bytes;
+
+	const size_t sprite_bytes = GetSpriteCacheUsage();
+	IConsolePrintF(CC_DEFAULT, "Sprite cache:              " PRINTF_SIZE " KiB", sprite_bytes / 1024);
+	total += sprite_bytes;
+
+	IConsolePrintF(CC_DEFAULT, "YAPF pooled nodes:         " PRINTF_SIZE " KiB", _yapf_node_list_stats.pooled_bytes / 1024);
+	total += _yapf_node_list_stats.pooled_bytes;
+
+	IConsolePrintF(CC_DEFAULT, "Total of the above:        " PRINTF_SIZE " KiB", total / 1024);
+
+#if defined(__linux__)
+	FILE *f = fopen("/proc/self/statm", "r");
+	if (f != nullptr) {
+		unsigned long size, resident;
+		if (fscanf(f, "%lu %lu", &size, &resident) == 2) {
+			const size_t page_size = sysconf(_SC_PAGESIZE);
+			IConsolePrintF(CC_DEFAULT, "Process resident set size: " PRINTF_SIZE " KiB", (size_t)resident * page_size / 1024);
+		}
+		fclose(f);
+	}
+#endif
+	return true;
+}
+
 DEF_CONSOLE_CMD(ConRecalculateRoadCachedOneWayStates)
 {
 	if (argc == 0) {
@@ -3470,6 +3705,42 @@ DEF_CONSOLE_CMD(ConDeleteCompany)
 	return true;
 }
 
+DEF_CONSOLE_CMD(ConScriptProfile)
+{
+	if (argc == 0) {
+		IConsoleHelp("Sample the call stacks of the running AIs and game script. Sub-commands can be abbreviated.");
+		IConsoleHelp("Usage: script_profile start");
+		IConsoleHelp("  Begin sampling. The call stack of each script is recorded every time it suspends, usually because its opcode budget ran out.");
+		IConsoleHelp("Usage: script_profile stop [<count>]");
+		IConsoleHelp("  End sampling, print the <count> functions the scripts were most often suspended in (default 10) and write the samples as folded stacks for flame graph tools.");
+		return true;
+	}
+
+	if (argc >= 2 && StrStartsWithIgnoreCase(argv[1], "sta")) {
+		_script_sample_profiler.Start();
+		IConsolePrint(CC_DEBUG, "Started sampling scripts.");
+		return true;
+	}
+
+	if (argc >= 2 && StrStartsWithIgnoreCase(argv[1], "sto")) {
+		if (!_script_sample_profiler.active) {
+			IConsolePrint(CC_WARNING, "Sampling is not active.");
+			return true;
+		}
+		_script_sample_profiler.Stop();
+		_script_sample_profiler.PrintSummary(argc >= 3 ? std::max(atoi(argv[2]), 1) : 10);
+		std::string filename = _script_sample_profiler.GetOutputFilename();
+		if (_script_sample_profiler.WriteFoldedStacks(filename)) {
+			IConsolePrintF(CC_DEBUG, "Wrote sampled script profile to: %s", filename.c_str());
+		} else {
+			IConsolePrintF(CC_ERROR, "Failed to open '%s' for writing.", filename.c_str());
+		}
+		return true;
+	}
+
+	return false;
+}
+
 DEF_CONSOLE_CMD(ConNewGRFProfile)
 {
 	if (argc == 0) {
@@ -3486,6 +3757,10 @@ DEF_CONSOLE_CMD(ConNewGRFProfile)
 		IConsoleHelp("  End profiling and write the collected data to CSV files.");
 		IConsoleHelp("Usage: newgrf_profile abort");
 		IConsoleHelp("  End profiling and discard all collected data.");
+		IConsoleHelp("Usage: newgrf_profile sample [<interval>]");
+		IConsoleHelp("  Begin low overhead sampling of all GRFs, timing one in every <interval> top-level sprite requests and callbacks. The default interval is 64.");
+		IConsoleHelp("Usage: newgrf_profile sample stop [<count>]");
+		IConsoleHelp("  End sampling, print the <count> most expensive callbacks (default 10) and write the samples as folded stacks for flame graph tools.");
 		return true;
 	}
 
@@ -3544,6 +3819,29 @@ DEF_CONSOLE_CMD(ConNewGRFProfile)
 		return true;
 	}
 
+	/* "sample" sub-command */
+	if (StrStartsWithIgnoreCase(argv[1], "sam")) {
+		if (argc >= 3 && StrStartsWithIgnoreCase(argv[2], "sto")) {
+			if (_newgrf_sample_profiler.interval == 0) {
+				IConsolePrintF(CC_WARNING, "Sampling is not active.");
+				return true;
+			}
+			_newgrf_sample_profiler.Stop();
+			_newgrf_sample_profiler.PrintSummary(argc >= 4 ? std::max(atoi(argv[3]), 1) : 10);
+			std::string filename = _newgrf_sample_profiler.GetOutputFilename();
+			if (_newgrf_sample_profiler.WriteFoldedStacks(filename)) {
+				IConsolePrintF(CC_DEBUG, "Wrote sampled NewGRF profile to: %s", filename.c_str());
+			} else {
+				IConsolePrintF(CC_ERROR, "Failed to open '%s' for writing.", filename.c_str());
+			}
+			return true;
+		}
+		uint interval = argc >= 3 ? std::max(atoi(argv[2]), 1) : 64;
+		_newgrf_sample_profiler.Start(interval);
+		IConsolePrintF(CC_DEBUG, "Started sampling NewGRF resolves, interval: %u", interval);
+		return true;
+	}
+
 	/* "start" sub-command */
 	if (StrStartsWithIgnoreCase(argv[1], "sta")) {
 		std::string grfids;
@@ -3726,6 +4024,52 @@ DEF_CONSOLE_CMD(ConFramerate)
 	return true;
 }
 
+DEF_CONSOLE_CMD(ConFramerateTrace)
+{
+	if (argc < 2) {
+		IConsoleHelp("Record a trace of game loop and background thread timings. Usage: 'fps_trace start [<max events>]', 'fps_trace stop', 'fps_trace status' or 'fps_trace dump <filename>'");
+		IConsoleHelp("  The trace is kept in a ring buffer of the most recent events (default: 524288), and is written in the Chrome trace event format, which can be opened in Perfetto");
+		return true;
+	}
+
+	if (strcmp(argv[1], "start") == 0) {
+		size_t max_events = 1 << 19;
+		if (argc > 2) {
+			uint32 value;
+			if (!GetArgumentInteger(&value, argv[2]) || value == 0) {
+				IConsoleError("Invalid number of events");
+				return true;
+			}
+			max_events = value;
+		}
+		StartPerformanceTrace(max_events);
+		PrintPerformanceTraceStatus();
+		return true;
+	}
+
+	if (strcmp(argv[1], "stop") == 0) {
+		StopPerformanceTrace();
+		PrintPerformanceTraceStatus();
+		return true;
+	}
+
+	if (strcmp(argv[1], "status") == 0) {
+		PrintPerformanceTraceStatus();
+		return true;
+	}
+
+	if (strcmp(argv[1], "dump") == 0 && argc == 3) {
+		if (DumpPerformanceTrace(argv[2])) {
+			IConsolePrintF(CC_DEFAULT, "Trace written to: %s", argv[2]);
+		} else {
+			IConsolePrintF(CC_ERROR, "Failed to write trace to: %s", argv[2]);
+		}
+		return true;
+	}
+
+	return false;
+}
+
 DEF_CONSOLE_CMD(ConFramerateWindow)
 {
 	if (argc == 0) {
@@ -3953,11 +4297,13 @@ void IConsoleStdLibRegister()
 #endif
 	IConsole::CmdRegister("fps",                     ConFramerate);
 	IConsole::CmdRegister("fps_wnd",                 ConFramerateWindow);
+	IConsole::CmdRegister("fps_trace",               ConFramerateTrace);
 
 	IConsole::CmdRegister("find_non_realistic_braking_signal", ConFindNonRealisticBrakingSignal);
 
 	IConsole::CmdRegister("getfulldate",             ConGetFullDate,      nullptr, true);
 	IConsole::CmdRegister("dump_command_log",        ConDumpCommandLog,   nullptr, true);
+	IConsole::CmdRegister("command_journal",         ConCommandJournal,   nullptr, true);
 	IConsole::CmdRegister("dump_special_events_log", ConDumpSpecialEventsLog, nullptr, true);
 	IConsole::CmdRegister("dump_desync_msgs",        ConDumpDesyncMsgLog, nullptr, true);
 	IConsole::CmdRegister("dump_inflation",          ConDumpInflation,    nullptr, true);
@@ -3978,6 +4324,8 @@ void IConsoleStdLibRegister()
 	IConsole::CmdRegister("dump_grf_cargo_tables",   ConDumpGrfCargoTables, nullptr, true);
 	IConsole::CmdRegister("dump_signal_styles",      ConDumpSignalStyles, nullptr, true);
 	IConsole::CmdRegister("dump_sprite_cache_stats", ConSpriteCacheStats, nullptr, true);
+	IConsole::CmdRegister("dump_line_cache_stats",   ConLineCacheStats,   nullptr, true);
+	IConsole::CmdRegister("dump_persistent_storage_stats", ConPersistentStorageStats, nullptr, true);
 	IConsole::CmdRegister("check_caches",            ConCheckCaches,      nullptr, true);
 	IConsole::CmdRegister("show_town_window",        ConShowTownWindow,   nullptr, true);
 	IConsole::CmdRegister("show_station_window",     ConShowStationWindow, nullptr, true);
@@ -3988,12 +4336,16 @@ void IConsoleStdLibRegister()
 	IConsole::CmdRegister("gfx_debug",               ConGfxDebug,         nullptr, true);
 	IConsole::CmdRegister("csleep",                  ConCSleep,           nullptr, true);
 	IConsole::CmdRegister("recalculate_road_cached_one_way_states", ConRecalculateRoadCachedOneWayStates, ConHookNoNetwork, true);
+	IConsole::CmdRegister("yapf_node_stats",         ConYapfNodeStats,    nullptr, true);
+	IConsole::CmdRegister("memstats",                ConMemoryStats);
+	IConsole::CmdRegister("pf_stats",                ConPathfinderStats);
 	IConsole::CmdRegister("misc_debug",              ConMiscDebug,        nullptr, true);
 	IConsole::CmdRegister("set_newgrf_optimiser_flags", ConSetNewGRFOptimiserFlags, nullptr, true);
 
 	/* NewGRF development stuff */
 	IConsole::CmdRegister("reload_newgrfs",          ConNewGRFReload,     ConHookNewGRFDeveloperTool);
 	IConsole::CmdRegister("newgrf_profile",          ConNewGRFProfile,    ConHookNewGRFDeveloperTool);
+	IConsole::CmdRegister("script_profile",          ConScriptProfile,    ConHookServerOrNoNetwork);
 	IConsole::CmdRegister("dump_info",               ConDumpInfo);
 	IConsole::CmdRegister("do_disaster",             ConDoDisaster,       ConHookNewGRFDeveloperTool, true);
 	IConsole::CmdRegister("bankrupt_company",        ConBankruptCompany,  ConHookNewGRFDeveloperTool, true);
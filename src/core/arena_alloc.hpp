@@ -24,13 +24,20 @@ class UniformArenaAllocator {
 	void *current_block = nullptr;
 	void *last_freed = nullptr;
 	size_t next_position = 0;
+	size_t current_block_index = 0;
 
 	void NewBlock()
 	{
-		current_block = malloc(SIZE * N_PER_CHUNK);
-		assert(current_block != nullptr);
+		if (current_block != nullptr) current_block_index++;
+		if (current_block_index < used_blocks.size()) {
+			/* Re-use a block retained by ClearArena */
+			current_block = used_blocks[current_block_index];
+		} else {
+			current_block = malloc(SIZE * N_PER_CHUNK);
+			assert(current_block != nullptr);
+			used_blocks.push_back(current_block);
+		}
 		next_position = 0;
-		used_blocks.push_back(current_block);
 	}
 
 public:
@@ -48,6 +55,7 @@ public:
 		current_block = nullptr;
 		last_freed = nullptr;
 		next_position = 0;
+		current_block_index = 0;
 		for (void *block : used_blocks) {
 			free(block);
 		}
@@ -59,6 +67,24 @@ public:
 		EmptyArena();
 	}
 
+	/**
+	 * Forget all allocations, but keep the allocated blocks for re-use by subsequent allocations.
+	 * As with EmptyArena, all previously allocated pointers become invalid.
+	 */
+	void ClearArena()
+	{
+		current_block = nullptr;
+		last_freed = nullptr;
+		next_position = 0;
+		current_block_index = 0;
+	}
+
+	/** Get the total number of bytes allocated by the arena, including blocks retained by ClearArena. */
+	size_t GetReservedBytes() const
+	{
+		return used_blocks.size() * SIZE * N_PER_CHUNK;
+	}
+
 	void *Allocate() {
 		if (last_freed) {
 			void *ptr = last_freed;
@@ -11,6 +11,7 @@
 #define KDTREE_HPP
 
 #include "../stdafx.h"
+#include "bitmath_func.hpp"
 #include <vector>
 #include <limits>
 
@@ -122,29 +123,88 @@ class Kdtree {
 		return true;
 	}
 
-	/** Insert one element in the tree somewhere below node_idx */
-	void InsertRecursive(const T &element, size_t node_idx, int level)
+	/**
+	 * Insert one element in the tree as a new leaf.
+	 * When the new leaf ends up too deep, the smallest unbalanced sub-tree on its path is rebuilt,
+	 * like in a scapegoat tree, so the depth of the tree stays logarithmic without full rebuilds.
+	 */
+	void InsertBalanced(const T &element)
 	{
-		/* Dimension index of current level */
-		int dim = level % 2;
-		/* Node reference */
-		node &n = this->nodes[node_idx];
+		std::vector<size_t> path;
+		size_t node_idx = this->root;
+		size_t newidx;
+		for (int level = 0;; level++) {
+			path.push_back(node_idx);
 
-		/* Coordinate of element splitting at this node */
-		CoordT nc = this->xyfunc(n.element, dim);
-		/* Coordinate of the new element */
-		CoordT ec = this->xyfunc(element, dim);
-		/* Which side to insert on */
-		size_t &next = (ec < nc) ? n.left : n.right;
-
-		if (next == INVALID_NODE) {
-			/* New leaf */
-			size_t newidx = this->AddNode(element);
-			/* Vector may have been reallocated at this point, n and next are invalid */
-			node &nn = this->nodes[node_idx];
-			if (ec < nc) nn.left = newidx; else nn.right = newidx;
+			/* Dimension index of current level */
+			int dim = level % 2;
+			/* Node reference */
+			node &n = this->nodes[node_idx];
+
+			/* Coordinate of element splitting at this node */
+			CoordT nc = this->xyfunc(n.element, dim);
+			/* Coordinate of the new element */
+			CoordT ec = this->xyfunc(element, dim);
+			/* Which side to insert on */
+			size_t next = (ec < nc) ? n.left : n.right;
+
+			if (next == INVALID_NODE) {
+				/* New leaf */
+				newidx = this->AddNode(element);
+				/* Vector may have been reallocated at this point, n is invalid */
+				node &nn = this->nodes[node_idx];
+				if (ec < nc) nn.left = newidx; else nn.right = newidx;
+				break;
+			}
+			node_idx = next;
+		}
+
+		/* The new leaf is at depth path.size(), allow about twice the depth of a fully balanced tree. */
+		if (path.size() <= 2 * (size_t)(FindLastBit(this->Count()) + 1)) return;
+
+		/* Find the lowest ancestor where one side holds more than 2/3 of the sub-tree. */
+		size_t child = newidx;
+		size_t child_size = 1;
+		for (size_t i = path.size(); i-- > 0;) {
+			const node &n = this->nodes[path[i]];
+			size_t sibling = (n.left == child) ? n.right : n.left;
+			size_t size = child_size + 1 + this->CountSubtree(sibling);
+			if (3 * child_size > 2 * size) {
+				this->RebuildSubtree(path[i], (int)i, i > 0 ? path[i - 1] : INVALID_NODE);
+				return;
+			}
+			child = path[i];
+			child_size = size;
+		}
+	}
+
+	/** Count the number of elements in a sub-tree */
+	size_t CountSubtree(size_t node_idx) const
+	{
+		if (node_idx == INVALID_NODE) return 0;
+		const node &n = this->nodes[node_idx];
+		return 1 + this->CountSubtree(n.left) + this->CountSubtree(n.right);
+	}
+
+	/**
+	 * Rebuild a sub-tree to be fully balanced.
+	 * @param node_idx Root of the sub-tree.
+	 * @param level    Depth of the root of the sub-tree.
+	 * @param parent   Parent of the root of the sub-tree, INVALID_NODE if it is the root of the tree.
+	 */
+	void RebuildSubtree(size_t node_idx, int level, size_t parent)
+	{
+		T element = this->nodes[node_idx].element;
+		std::vector<T> elements = this->FreeSubtree(node_idx);
+		elements.push_back(element);
+		this->free_list.push_back(node_idx);
+
+		size_t new_root = this->BuildSubtree(elements.begin(), elements.end(), level);
+		if (parent == INVALID_NODE) {
+			this->root = new_root;
 		} else {
-			this->InsertRecursive(element, next, level + 1);
+			node &p = this->nodes[parent];
+			if (p.left == node_idx) p.left = new_root; else p.right = new_root;
 		}
 	}
 
@@ -394,7 +454,7 @@ public:
 
 	/**
 	 * Insert a single element in the tree.
-	 * Repeatedly inserting single elements may cause the tree to become unbalanced.
+	 * Sub-trees which become too unbalanced by repeated insertions are rebuilt, see #InsertBalanced.
 	 * Undefined behaviour if the element already exists in the tree.
 	 */
 	void Insert(const T &element)
@@ -403,8 +463,7 @@ public:
 			this->root = this->AddNode(element);
 		} else {
 			if (!this->IsUnbalanced() || !this->Rebuild(&element, nullptr)) {
-				this->InsertRecursive(element, this->root, 0);
-				this->IncrementUnbalanced();
+				this->InsertBalanced(element);
 			}
 			CheckInvariant();
 		}
@@ -230,6 +230,74 @@ DEFINE_POOL_METHOD(void)::CleanPool()
 	}
 }
 
+/**
+ * Release the memory of the free slots above the highest used index, and of the cached allocations.
+ * The pool is kept aligned to its growth step, item indexes are not changed.
+ * This must not be called while any other thread may access the pool.
+ */
+DEFINE_POOL_METHOD(void)::ShrinkPool()
+{
+	while (this->first_unused > 0 && this->data[this->first_unused - 1] == nullptr) this->first_unused--;
+	this->first_free = std::min(this->first_free, this->first_unused);
+
+	if (Tcache) {
+		while (this->alloc_cache != nullptr) {
+			AllocCache *ac = this->alloc_cache;
+			this->alloc_cache = ac->next;
+			free(ac);
+		}
+	}
+
+	if (this->first_unused == 0) {
+		free(this->data);
+		free(this->free_bitmap);
+		this->data = nullptr;
+		this->free_bitmap = nullptr;
+		this->size = 0;
+		return;
+	}
+
+	size_t new_size = std::min(Tmax_size, Align(this->first_unused, std::max<uint>(64, Tgrowth_step)));
+	if (new_size >= this->size) return;
+
+	this->data = ReallocT(this->data, new_size);
+	this->free_bitmap = ReallocT(this->free_bitmap, CeilDivT<size_t>(new_size, 64));
+	if (new_size % 64 != 0) {
+		this->free_bitmap[new_size / 64] |= (~((uint64) 0)) << (new_size % 64);
+	}
+
+	this->size = new_size;
+}
+
+/**
+ * Move items from the highest used indexes into the lowest free indexes, so that the used indexes are contiguous from 0.
+ * This is only valid if nothing refers to the items by index, other than what is updated by \a moved.
+ * @param moved Functor called as moved(item, old_index) after an item has been given a new index.
+ */
+DEFINE_POOL_METHOD(template <typename F> void)::CompactIndices(F moved)
+{
+	size_t low = 0;
+	size_t high = this->first_unused;
+	while (true) {
+		while (low < high && this->data[low] != nullptr) low++;
+		while (high > low && this->data[high - 1] == nullptr) high--;
+		if (low >= high) break;
+
+		size_t from = high - 1;
+		Titem *item = this->data[from];
+		this->data[low] = item;
+		this->data[from] = nullptr;
+		SetBit(this->free_bitmap[low / 64], low % 64);
+		ClrBit(this->free_bitmap[from / 64], from % 64);
+		item->index = (Tindex)(uint)low;
+		moved(item, from);
+		high = from;
+		low++;
+	}
+	this->first_unused = this->items;
+	this->first_free = this->items;
+}
+
 #undef DEFINE_POOL_METHOD
 
 /**
@@ -241,6 +309,7 @@ DEFINE_POOL_METHOD(void)::CleanPool()
 	template void * name ## Pool::GetNew(size_t size); \
 	template void * name ## Pool::GetNew(size_t size, size_t index); \
 	template void name ## Pool::FreeItem(size_t index); \
-	template void name ## Pool::CleanPool();
+	template void name ## Pool::CleanPool(); \
+	template void name ## Pool::ShrinkPool();
 
 #endif /* POOL_FUNC_HPP */
@@ -10,6 +10,8 @@
 #ifndef POOL_TYPE_HPP
 #define POOL_TYPE_HPP
 
+#include "bitmath_func.hpp"
+#include "math_func.hpp"
 #include "enum_type.hpp"
 #include <vector>
 
@@ -26,6 +28,14 @@ DECLARE_ENUM_AS_BIT_SET(PoolType)
 
 typedef std::vector<struct PoolBase *> PoolVector; ///< Vector of pointers to PoolBase
 
+/** Memory usage of a pool. */
+struct PoolMemoryStats {
+	const char *name; ///< Name of the pool.
+	size_t items;     ///< Number of used indexes.
+	size_t capacity;  ///< Number of allocated indexes.
+	size_t bytes;     ///< Memory used by the index arrays and the items, excluding memory owned by the items themselves.
+};
+
 /** Base class for base of all pools. */
 struct PoolBase {
 	const PoolType type; ///< Type of this pool.
@@ -58,6 +68,12 @@ struct PoolBase {
 	 */
 	virtual void CleanPool() = 0;
 
+	/**
+	 * Virtual method that gets the memory usage of the pool.
+	 * @return The memory usage.
+	 */
+	virtual PoolMemoryStats GetMemoryStats() const = 0;
+
 private:
 	/**
 	 * Dummy private copy constructor to prevent compilers from
@@ -100,6 +116,15 @@ struct Pool : PoolBase {
 
 	Pool(const char *name);
 	void CleanPool() override;
+	void ShrinkPool();
+
+	PoolMemoryStats GetMemoryStats() const override
+	{
+		size_t cached = 0;
+		for (const AllocCache *ac = this->alloc_cache; ac != nullptr; ac = ac->next) cached++;
+		const size_t bitmap_bytes = CeilDivT<size_t>(this->size, 64) * sizeof(uint64);
+		return { this->name, this->items, this->size, this->size * sizeof(Titem *) + bitmap_bytes + (this->items + cached) * sizeof(Titem) };
+	}
 
 	/**
 	 * Returns Titem with given index
@@ -123,6 +148,22 @@ struct Pool : PoolBase {
 		return index < this->first_unused && this->Get(index) != nullptr;
 	}
 
+	/**
+	 * Get the first used index at or after the given one.
+	 * Free slots are skipped a whole bitmap word at a time, such that iterating a sparse pool does not touch the item pointers of free slots.
+	 * @param index Index to start at.
+	 * @return First index at or after \a index which is in use, or a value of at least this->first_unused if there is none.
+	 */
+	inline size_t GetNextUsedIndex(size_t index) const
+	{
+		while (index < this->first_unused) {
+			uint64 used = this->free_bitmap[index / 64] >> (index % 64);
+			if (used != 0) return index + FindFirstBit(used);
+			index = (index | 63) + 1;
+		}
+		return index;
+	}
+
 	/**
 	 * Tests whether we can allocate 'n' items
 	 * @param n number of items we want to allocate
@@ -137,6 +178,21 @@ struct Pool : PoolBase {
 		return ret;
 	}
 
+	/**
+	 * Get the number of freed items whose memory is kept for reuse.
+	 * This walks the cache, so should only be used for reporting.
+	 * @return Number of cached items.
+	 */
+	size_t GetAllocCacheCount() const
+	{
+		size_t count = 0;
+		for (const AllocCache *ac = this->alloc_cache; ac != nullptr; ac = ac->next) count++;
+		return count;
+	}
+
+	template <typename F>
+	void CompactIndices(F moved);
+
 	/**
 	 * Iterator to iterate all valid T of a pool
 	 * @tparam T Type of the class/struct that is going to be iterated
@@ -163,7 +219,8 @@ struct Pool : PoolBase {
 		size_t index;
 		void ValidateIndex()
 		{
-			while (this->index < T::GetPoolSize() && !(T::IsValidID(this->index))) this->index++;
+			this->index = T::GetNextUsedPoolIndex(this->index);
+			while (this->index < T::GetPoolSize() && !(T::IsValidID(this->index))) this->index = T::GetNextUsedPoolIndex(this->index + 1);
 			if (this->index >= T::GetPoolSize()) this->index = T::Pool::MAX_SIZE;
 		}
 	};
@@ -208,7 +265,8 @@ struct Pool : PoolBase {
 		F filter;
 		void ValidateIndex()
 		{
-			while (this->index < T::GetPoolSize() && !(T::IsValidID(this->index) && this->filter(this->index))) this->index++;
+			this->index = T::GetNextUsedPoolIndex(this->index);
+			while (this->index < T::GetPoolSize() && !(T::IsValidID(this->index) && this->filter(this->index))) this->index = T::GetNextUsedPoolIndex(this->index + 1);
 			if (this->index >= T::GetPoolSize()) this->index = T::Pool::MAX_SIZE;
 		}
 	};
@@ -350,6 +408,16 @@ struct Pool : PoolBase {
 			return index < Tpool->first_unused ? Tpool->Get(index) : nullptr;
 		}
 
+		/**
+		 * Get the first used index at or after the given one, see Pool::GetNextUsedIndex.
+		 * @param index Index to start at.
+		 * @return First used index, or a value of at least GetPoolSize() if there is none.
+		 */
+		static inline size_t GetNextUsedPoolIndex(size_t index)
+		{
+			return Tpool->GetNextUsedIndex(index);
+		}
+
 		/**
 		 * Returns first unused index. Useful when iterating over
 		 * all pool items.
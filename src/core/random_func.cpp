@@ -58,6 +58,57 @@ void Randomizer::SetSeed(uint32 seed)
 	this->state[1] = seed;
 }
 
+/**
+ * Mix the bits of a 64 bit value, this is the finaliser of SplitMix64.
+ * @param x The value to mix.
+ * @return The mixed value.
+ */
+static inline uint64 KeyedRandomMix(uint64 x)
+{
+	x ^= x >> 30;
+	x *= 0xBF58476D1CE4E5B9ULL;
+	x ^= x >> 27;
+	x *= 0x94D049BB133111EBULL;
+	x ^= x >> 31;
+	return x;
+}
+
+/**
+ * Create the random stream of an object in a subsystem for a tick.
+ * @param seed The seed of the game, which must be the same for all clients.
+ * @param tick The tick, which must be the same for all clients.
+ * @param stream The subsystem of the stream.
+ * @param object The object within the subsystem, e.g. its pool index.
+ */
+KeyedRandomizer::KeyedRandomizer(uint64 seed, uint64 tick, KeyedRandomStream stream, uint32 object) : counter(0)
+{
+	uint64 key = KeyedRandomMix(seed);
+	key = KeyedRandomMix(key ^ tick);
+	key = KeyedRandomMix(key ^ ((uint64)stream << 32 | object));
+	this->key = key;
+}
+
+/**
+ * Generate the next pseudo random number of this stream.
+ * @return the random number
+ */
+uint32 KeyedRandomizer::Next()
+{
+	this->counter++;
+	return (uint32)(KeyedRandomMix(this->key + this->counter * 0x9E3779B97F4A7C15ULL) >> 32);
+}
+
+/**
+ * Generate the next pseudo random number of this stream scaled to \a limit, excluding \a limit
+ * itself.
+ * @param limit Limit of the range to be generated from.
+ * @return Random number in [0,\a limit)
+ */
+uint32 KeyedRandomizer::Next(uint32 limit)
+{
+	return ((uint64)this->Next() * (uint64)limit) >> 32;
+}
+
 /**
  * (Re)set the state of the random number generators.
  * @param seed the new state
@@ -31,6 +31,32 @@ struct Randomizer {
 extern Randomizer _random; ///< Random used in the game state calculations
 extern Randomizer _interactive_random; ///< Random used everywhere else, where it does not (directly) influence the game state
 
+/** Subsystems with their own keyed random streams, see #KeyedRandomizer. */
+enum KeyedRandomStream : uint32 {
+	KRS_VEHICLE,         ///< Vehicle ticks
+	KRS_STATION_RATING,  ///< Station rating updates
+	KRS_TOWN,            ///< Town growth
+	KRS_INDUSTRY,        ///< Industry production
+};
+
+/**
+ * Counter based pseudo random number generator, keyed by a game seed, a tick, a subsystem and an object.
+ * Unlike #Randomizer the numbers do not depend on how many numbers have been drawn elsewhere,
+ * so objects using their own stream give the same results regardless of the order they are processed in.
+ * Each stream is only valid within the scope of one tick and one object, and must not be stored.
+ */
+struct KeyedRandomizer {
+private:
+	uint64 key;     ///< Key of this stream
+	uint32 counter; ///< Number of numbers drawn from this stream
+
+public:
+	KeyedRandomizer(uint64 seed, uint64 tick, KeyedRandomStream stream, uint32 object);
+
+	uint32 Next();
+	uint32 Next(uint32 limit);
+};
+
 /** Stores the state of all random number generators */
 struct SavedRandomSeeds {
 	Randomizer random;
@@ -117,7 +117,16 @@ uint64 ottd_rdtsc() {return 0;}
 #if defined(_MSC_VER) && (defined(_M_IX86) || defined(_M_X64))
 void ottd_cpuid(int info[4], int type)
 {
-	__cpuid(info, type);
+	__cpuidex(info, type, 0);
+}
+
+/**
+ * Get the extended control register 0 of the CPU.
+ * @return The state components the OS saves and restores on a context switch.
+ */
+static uint64 ottd_xgetbv()
+{
+	return _xgetbv(0);
 }
 #elif defined(__x86_64__) || defined(__i386)
 void ottd_cpuid(int info[4], int type)
@@ -137,16 +146,28 @@ void ottd_cpuid(int info[4], int type)
 			/* It is safe to write "=r" for (info[1]) as in case that PIC is enabled for i386,
 			 * the compiler will not choose EBX as target register (but something else).
 			 */
-			: "a" (type)
+			: "a" (type), "c" (0)
 	);
 #else
 	__asm__ __volatile__ (
 			"cpuid           \n\t"
 			: "=a" (info[0]), "=b" (info[1]), "=c" (info[2]), "=d" (info[3])
-			: "a" (type)
+			: "a" (type), "c" (0)
 	);
 #endif /* i386 PIC */
 }
+
+/**
+ * Get the extended control register 0 of the CPU.
+ * @return The state components the OS saves and restores on a context switch.
+ */
+static uint64 ottd_xgetbv()
+{
+	uint32 lo, hi;
+	/* Emitted as bytes, as older assemblers do not know the mnemonic. */
+	__asm__ __volatile__ (".byte 0x0f, 0x01, 0xd0" : "=a" (lo), "=d" (hi) : "c" (0));
+	return lo | ((uint64)hi << 32);
+}
 #elif defined(__e2k__) /* MCST Elbrus 2000*/
 void ottd_cpuid(int info[4], int type)
 {
@@ -170,6 +191,11 @@ void ottd_cpuid(int info[4], int)
 {
 	info[0] = info[1] = info[2] = info[3] = 0;
 }
+#define NO_XGETBV
+#endif
+
+#if defined(__e2k__)
+#define NO_XGETBV
 #endif
 
 bool HasCPUIDFlag(uint type, uint index, uint bit)
@@ -182,3 +208,17 @@ bool HasCPUIDFlag(uint type, uint index, uint bit)
 	ottd_cpuid(cpu_info, type);
 	return HasBit(cpu_info[index], bit);
 }
+
+bool HasCPUAVX2Support()
+{
+#if defined(NO_XGETBV)
+	return false;
+#else
+	/* The CPU must support AVX and XSAVE, and the OS must have enabled XSAVE... */
+	if (!HasCPUIDFlag(1, 2, 27) || !HasCPUIDFlag(1, 2, 28)) return false;
+	/* ... and save both the SSE and AVX registers on a context switch. */
+	if ((ottd_xgetbv() & 0x6) != 0x6) return false;
+
+	return HasCPUIDFlag(7, 1, 5);
+#endif
+}
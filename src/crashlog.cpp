@@ -1207,11 +1207,16 @@ void CrashLog::MakeCrashSavegameAndScreenshot()
 sym_info_bfd::sym_info_bfd(bfd_vma addr_) : addr(addr_), abfd(nullptr), syms(nullptr), sym_count(0),
 		file_name(nullptr), function_name(nullptr), function_addr(0), line(0), found(false) {}
 
-sym_info_bfd::~sym_info_bfd()
-{
-	free(syms);
-	if (abfd != nullptr) bfd_close(abfd);
-}
+/**
+ * Object file of the most recent lookup, with its symbol table.
+ * Most frames of a stack trace are in the same object file, so it is kept open instead of reading the symbol table again for every frame.
+ */
+static struct {
+	std::string obj_file_name;
+	bfd *abfd = nullptr;
+	asymbol **syms = nullptr;
+	long sym_count = 0;
+} _bfd_lookup_cache;
 
 static void find_address_in_section(bfd *abfd, asection *section, void *data)
 {
@@ -1255,18 +1260,28 @@ static void find_address_in_section(bfd *abfd, asection *section, void *data)
 
 void lookup_addr_bfd(const char *obj_file_name, sym_info_bfd &info)
 {
-	info.abfd = bfd_openr(obj_file_name, nullptr);
-
-	if (info.abfd == nullptr) return;
-
-	if (!bfd_check_format(info.abfd, bfd_object) || (bfd_get_file_flags(info.abfd) & HAS_SYMS) == 0) return;
-
-	unsigned int size;
-	info.sym_count = bfd_read_minisymbols(info.abfd, false, (void**) &(info.syms), &size);
-	if (info.sym_count <= 0) {
-		info.sym_count = bfd_read_minisymbols(info.abfd, true, (void**) &(info.syms), &size);
+	auto &cache = _bfd_lookup_cache;
+	if (cache.obj_file_name != obj_file_name) {
+		free(cache.syms);
+		if (cache.abfd != nullptr) bfd_close(cache.abfd);
+		cache.syms = nullptr;
+		cache.sym_count = 0;
+		cache.obj_file_name = obj_file_name;
+
+		cache.abfd = bfd_openr(obj_file_name, nullptr);
+		if (cache.abfd != nullptr && bfd_check_format(cache.abfd, bfd_object) && (bfd_get_file_flags(cache.abfd) & HAS_SYMS) != 0) {
+			unsigned int size;
+			cache.sym_count = bfd_read_minisymbols(cache.abfd, false, (void**) &(cache.syms), &size);
+			if (cache.sym_count <= 0) {
+				cache.sym_count = bfd_read_minisymbols(cache.abfd, true, (void**) &(cache.syms), &size);
+			}
+		}
 	}
-	if (info.sym_count <= 0) return;
+
+	info.abfd = cache.abfd;
+	info.syms = cache.syms;
+	info.sym_count = cache.sym_count;
+	if (info.abfd == nullptr || info.sym_count <= 0) return;
 
 	bfd_map_over_sections(info.abfd, find_address_in_section, &info);
 }
@@ -33,6 +33,7 @@
 struct sym_info_bfd;
 void lookup_addr_bfd(const char *obj_file_name, sym_info_bfd &info);
 
+/** Result of looking up an address with lookup_addr_bfd(). The object file and its symbols are owned by the lookup cache. */
 struct sym_info_bfd {
 	bfd_vma addr;
 	bfd *abfd;
@@ -45,7 +46,6 @@ struct sym_info_bfd {
 	bool found;
 
 	sym_info_bfd(bfd_vma addr_);
-	~sym_info_bfd();
 };
 
 #endif
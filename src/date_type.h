@@ -39,6 +39,7 @@ static const int SECONDS_PER_DAY   = 2;   ///< approximate seconds per day, not
 static const int STATION_RATING_TICKS     = 185; ///< cycle duration for updating station rating
 static const int STATION_ACCEPTANCE_TICKS = 250; ///< cycle duration for updating station acceptance
 static const int STATION_LINKGRAPH_TICKS  = 504; ///< cycle duration for cleaning dead links
+static const int STATION_CARGO_COMPACT_TICKS = 740; ///< cycle duration for merging compatible cargo packets at stations
 static const int CARGO_AGING_TICKS        = 185; ///< cycle duration for aging cargo
 static const int INDUSTRY_PRODUCE_TICKS   = 256; ///< cycle duration for industry production
 static const int TOWN_GROWTH_TICKS        = 70;  ///< cycle duration for towns trying to grow. (this originates from the size of the town array in TTD
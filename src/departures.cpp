@@ -39,6 +39,10 @@
 #include <vector>
 #include <algorithm>
 
+/** Primary vehicles with at least one order to go to a station or waypoint, by station or waypoint, shared by all departure boards. */
+static btree::btree_map<StationID, std::vector<const Vehicle *>> _departure_calling_vehicles;
+static bool _departure_calling_vehicles_valid = false; ///< Whether #_departure_calling_vehicles is up to date.
+
 /* A cache of used departure time for scheduled dispatch in departure time calculation */
 typedef btree::btree_map<const DispatchSchedule *, btree::btree_set<DateTicksScaled>> schdispatch_cache_t;
 
@@ -106,9 +110,7 @@ static bool VehicleSetNextDepartureTime(DateTicks *previous_departure, uint *wai
 		if (order->IsScheduledDispatchOrder(true) && !(arrived_at_timing_point && is_current_implicit_order(order))) {
 			const DispatchSchedule &ds = v->orders->GetDispatchScheduleByIndex(order->GetDispatchScheduleIndex());
 
-			DateTicksScaled actual_departure    = -1;
 			const DateTicksScaled begin_time    = ds.GetScheduledDispatchStartTick();
-			const uint32 dispatch_duration      = ds.GetScheduledDispatchDuration();
 			const int32 max_delay               = ds.GetScheduledDispatchDelay();
 
 			/* Earliest possible departure according to schedue */
@@ -123,23 +125,10 @@ static bool VehicleSetNextDepartureTime(DateTicks *previous_departure, uint *wai
 
 			btree::btree_set<DateTicksScaled> &slot_cache = dept_schedule_last[&ds];
 
-			/* Find next available slots */
-			for (auto current_offset : ds.GetScheduledDispatch()) {
-				if (current_offset >= dispatch_duration) continue;
-				DateTicksScaled current_departure = begin_time + current_offset;
-				while (current_departure <= earliest_departure) {
-					current_departure += dispatch_duration;
-				}
-
-				/* Make sure the slots has not already been used previously in this departure board calculation */
-				while (slot_cache.count(current_departure) > 0) {
-					current_departure += dispatch_duration;
-				}
-
-				if (actual_departure == -1 || actual_departure > current_departure) {
-					actual_departure = current_departure;
-				}
-			}
+			/* Find next available slot, which has not already been used previously in this departure board calculation */
+			DateTicksScaled actual_departure = ds.FindScheduledDispatchSlot(earliest_departure + 1, [&](DateTicksScaled slot) {
+				return slot_cache.count(slot) == 0;
+			});
 
 			*waiting_time = actual_departure - date_only_scaled - *previous_departure - order->GetTravelTime();
 			*previous_departure = actual_departure - date_only_scaled;
@@ -864,6 +853,43 @@ DepartureList* MakeDepartureList(StationID station, const std::vector<const Vehi
 	return result;
 }
 
+/**
+ * Get the vehicles which have an order to go to a station or waypoint.
+ * The vehicles of all stations are found in a single pass over all vehicles, which is
+ * shared by all departure boards until #InvalidateDepartureCallingVehicles is called.
+ * @param station The station or waypoint.
+ * @return The primary vehicles with a goto station, goto waypoint or implicit order for \a station, in pool order.
+ */
+const std::vector<const Vehicle *> &GetDepartureCallingVehicles(StationID station)
+{
+	if (!_departure_calling_vehicles_valid) {
+		_departure_calling_vehicles.clear();
+		for (const Vehicle *v : Vehicle::Iterate()) {
+			if (v->type >= 4 || !v->IsPrimaryVehicle()) continue;
+			for (const Order *order : v->Orders()) {
+				if (!order->IsType(OT_GOTO_STATION) && !order->IsType(OT_GOTO_WAYPOINT) && !order->IsType(OT_IMPLICIT)) continue;
+				std::vector<const Vehicle *> &vehicles = _departure_calling_vehicles[order->GetDestination()];
+				if (vehicles.empty() || vehicles.back() != v) vehicles.push_back(v);
+			}
+		}
+		_departure_calling_vehicles_valid = true;
+	}
+
+	static const std::vector<const Vehicle *> empty;
+	auto iter = _departure_calling_vehicles.find(station);
+	return iter != _departure_calling_vehicles.end() ? iter->second : empty;
+}
+
+/**
+ * Mark the vehicles returned by #GetDepartureCallingVehicles as out of date.
+ * This must be called whenever vehicles or orders may have changed, and when the last user of the vehicles goes away.
+ */
+void InvalidateDepartureCallingVehicles()
+{
+	_departure_calling_vehicles_valid = false;
+	_departure_calling_vehicles.clear();
+}
+
 DateTicksScaled GetDeparturesMaxTicksAhead()
 {
 	if (_settings_time.time_in_minutes) {
@@ -104,6 +104,7 @@ protected:
 	bool show_freight;         ///< Show freight vehicles
 	bool cargo_buttons_disabled;///< Show pax/freight buttons disabled
 	mutable bool scroll_refresh; ///< Whether the window should be refreshed when paused due to scrolling
+	mutable std::vector<Rect> scroll_areas; ///< Areas of the departures list with scrolling or alternating text, as drawn last.
 	uint min_width;            ///< The minimum width of this window.
 	Scrollbar *vscroll;
 	std::vector<const Vehicle *> vehicles; /// current set of vehicles
@@ -164,34 +165,28 @@ protected:
 		CompanyMask companies = 0;
 		int unitnumber_max[4] = { -1, -1, -1, -1 };
 
-		for (const Vehicle *v : Vehicle::Iterate()) {
-			if (v->type < 4 && this->show_types[v->type] && v->IsPrimaryVehicle()) {
-				for(const Order *order : v->Orders()) {
-					if ((order->IsType(OT_GOTO_STATION) || order->IsType(OT_GOTO_WAYPOINT) || order->IsType(OT_IMPLICIT))
-							&& order->GetDestination() == this->station) {
-						this->vehicles.push_back(v);
-
-						if (_settings_client.gui.departure_show_vehicle) {
-							if (v->name.empty() && !(v->group_id != DEFAULT_GROUP && _settings_client.gui.vehicle_names != 0)) {
-								if (v->unitnumber > unitnumber_max[v->type]) unitnumber_max[v->type] = v->unitnumber;
-							} else {
-								SetDParam(0, v->index | (_settings_client.gui.departure_show_group ? VEHICLE_NAME_NO_GROUP : 0));
-								int width = (GetStringBoundingBox(STR_DEPARTURES_VEH)).width + 4;
-								if (width > this->veh_width) this->veh_width = width;
-							}
-						}
+		for (const Vehicle *v : GetDepartureCallingVehicles(this->station)) {
+			if (!this->show_types[v->type]) continue;
 
-						if (v->group_id != INVALID_GROUP && v->group_id != DEFAULT_GROUP && _settings_client.gui.departure_show_group) {
-							groups.insert(v->group_id);
-						}
+			this->vehicles.push_back(v);
 
-						if (_settings_client.gui.departure_show_company) {
-							SetBit(companies, v->owner);
-						}
-						break;
-					}
+			if (_settings_client.gui.departure_show_vehicle) {
+				if (v->name.empty() && !(v->group_id != DEFAULT_GROUP && _settings_client.gui.vehicle_names != 0)) {
+					if (v->unitnumber > unitnumber_max[v->type]) unitnumber_max[v->type] = v->unitnumber;
+				} else {
+					SetDParam(0, v->index | (_settings_client.gui.departure_show_group ? VEHICLE_NAME_NO_GROUP : 0));
+					int width = (GetStringBoundingBox(STR_DEPARTURES_VEH)).width + 4;
+					if (width > this->veh_width) this->veh_width = width;
 				}
 			}
+
+			if (v->group_id != INVALID_GROUP && v->group_id != DEFAULT_GROUP && _settings_client.gui.departure_show_group) {
+				groups.insert(v->group_id);
+			}
+
+			if (_settings_client.gui.departure_show_company) {
+				SetBit(companies, v->owner);
+			}
 		}
 
 		for (uint i = 0; i < 4; i++) {
@@ -289,6 +284,8 @@ public:
 
 	virtual ~DeparturesWindow()
 	{
+		/* Nothing keeps the shared vehicles up to date while no departure board is open. */
+		InvalidateDepartureCallingVehicles();
 		this->DeleteDeparturesList(this->departures);
 		this->DeleteDeparturesList(this->arrivals);
 	}
@@ -522,7 +519,8 @@ public:
 		if (_pause_mode != PM_UNPAUSED && this->calc_tick_countdown <= 0) {
 			this->OnGameTick();
 		} else if (this->scroll_refresh) {
-			this->SetWidgetDirty(WID_DB_LIST);
+			/* Only the scrolling text changes while paused. */
+			for (const Rect &r : this->scroll_areas) this->SetWidgetAreaDirty(WID_DB_LIST, r);
 		}
 	}
 
@@ -555,6 +553,8 @@ public:
 	 */
 	void OnInvalidateData(int data = 0, bool gui_scope = true) override
 	{
+		/* Data 0 means that vehicles or orders may have changed. */
+		if (data == 0) InvalidateDepartureCallingVehicles();
 		this->vehicles_invalid = true;
 		this->departures_invalid = true;
 		if (data > 0) {
@@ -660,6 +660,7 @@ template<bool Twaypoint>
 void DeparturesWindow<Twaypoint>::DrawDeparturesListItems(const Rect &r) const
 {
 	this->scroll_refresh = false;
+	this->scroll_areas.clear();
 
 	const int left = r.left + WidgetDimensions::scaled.matrix.left;
 	const int right = r.right - WidgetDimensions::scaled.matrix.right;
@@ -916,6 +917,7 @@ void DeparturesWindow<Twaypoint>::DrawDeparturesListItems(const Rect &r) const
 						DrawString(dest_left, dest_right, y + 1, STR_DEPARTURES_TERMINUS_VIA);
 					}
 					this->scroll_refresh = true;
+					this->scroll_areas.push_back({ dest_left, y + 1, dest_right, y + FONT_HEIGHT_NORMAL });
 				}
 			}
 		}
@@ -1041,6 +1043,8 @@ void DeparturesWindow<Twaypoint>::DrawDeparturesListItems(const Rect &r) const
 				: DrawString(                       text_left, text_right - calling_at_width - 2, bottom_y, buffer);
 		} else {
 			this->scroll_refresh = true;
+			const int scroll_left = ltr ? text_left + calling_at_width + 2 : text_left;
+			this->scroll_areas.push_back({ scroll_left, bottom_y, scroll_left + text_right - (text_left + calling_at_width + 2) - 1, bottom_y + small_font_size + 2 });
 
 			DrawPixelInfo tmp_dpi;
 			if (ltr
@@ -111,50 +111,130 @@ static PriceMultipliers _price_base_multiplier;
 
 extern int GetAmountOwnedBy(const Company *c, Owner owner);
 
+/** Totals over the stations and vehicles of a company, for its rating and value. */
+struct CompanyAssetTotals {
+	uint station_facilities = 0;          ///< Number of facilities of all stations.
+	uint serviced_station_facilities = 0; ///< Number of facilities of the stations which are actually serviced.
+	Money vehicle_value = 0;              ///< Value of the vehicles, as counted for the company value.
+	uint profitable_vehicles = 0;         ///< Number of primary vehicles with a profit last year.
+	Money min_profit = 0;                 ///< Lowest profit last year of the primary vehicles older than two years.
+	bool has_min_profit = false;          ///< Whether #min_profit is set.
+};
+
+/** Asset totals of every company, indexed by company. */
+using CompanyAssetTotalsArray = std::array<CompanyAssetTotals, MAX_COMPANIES>;
+
+/**
+ * Collect the asset totals of all companies, in one pass over the stations and vehicles.
+ * @param[out] totals The totals of each company.
+ */
+static void GetCompanyAssetTotals(CompanyAssetTotalsArray &totals)
+{
+	totals = {};
+
+	for (const Station *st : Station::Iterate()) {
+		if (st->owner >= MAX_COMPANIES) continue;
+
+		CompanyAssetTotals &t = totals[st->owner];
+		const uint facilities = CountBits((byte)st->facilities);
+		t.station_facilities += facilities;
+		/* Only count stations that are actually serviced for the rating */
+		if (st->time_since_load <= 20 || st->time_since_unload <= 20) t.serviced_station_facilities += facilities;
+	}
+
+	for (const Vehicle *v : Vehicle::Iterate()) {
+		if (v->owner >= MAX_COMPANIES) continue;
+		if (HasBit(v->subtype, GVSF_VIRTUAL)) continue;
+
+		CompanyAssetTotals &t = totals[v->owner];
+		if (v->type == VEH_TRAIN ||
+				v->type == VEH_ROAD ||
+				(v->type == VEH_AIRCRAFT && Aircraft::From(v)->IsNormalAircraft()) ||
+				v->type == VEH_SHIP) {
+			t.vehicle_value += v->value * 3 >> 1;
+		}
+
+		if (IsCompanyBuildableVehicleType(v->type) && v->IsPrimaryVehicle()) {
+			if (v->profit_last_year > 0) t.profitable_vehicles++; // For the vehicle score only count profitable vehicles
+			if (v->age > 730) {
+				/* Find the vehicle with the lowest amount of profit */
+				if (!t.has_min_profit || t.min_profit > v->profit_last_year) {
+					t.min_profit = v->profit_last_year;
+					t.has_min_profit = true;
+				}
+			}
+		}
+	}
+}
+
+/**
+ * Calculate the value of the stations and vehicles of a company.
+ * @param totals The asset totals of the company.
+ * @return The value of the assets, excluding shares.
+ */
+static Money CalculateCompanyValueExcludingShares(const CompanyAssetTotals &totals)
+{
+	Money value = totals.station_facilities * _price[PR_STATION_VALUE] * 25;
+	value += totals.vehicle_value;
+	return value;
+}
+
 /**
  * Calculate the value of the assets of a company.
  *
  * @param c The company to calculate the value of.
+ * @param totals The asset totals of all companies.
  * @return The value of the assets of the company.
  */
-static Money CalculateCompanyAssetValue(const Company *c)
+static Money CalculateCompanyAssetValue(const Company *c, const CompanyAssetTotalsArray &totals)
 {
 	Money owned_shares_value = 0;
 
 	for (const Company *co : Company::Iterate()) {
 		int shares_owned = GetAmountOwnedBy(co, c->index);
 
-		if (shares_owned > 0) owned_shares_value += (CalculateCompanyValueExcludingShares(co) / 4) * shares_owned;
+		if (shares_owned > 0) owned_shares_value += (CalculateCompanyValueExcludingShares(totals[co->index]) / 4) * shares_owned;
 	}
 
-	return owned_shares_value + CalculateCompanyValueExcludingShares(c);
+	return owned_shares_value + CalculateCompanyValueExcludingShares(totals[c->index]);
 }
 
-Money CalculateCompanyValueExcludingShares(const Company *c, bool including_loan)
+/**
+ * Calculate the value of the assets of a company.
+ *
+ * @param c The company to calculate the value of.
+ * @return The value of the assets of the company.
+ */
+static Money CalculateCompanyAssetValue(const Company *c)
 {
-	Owner owner = c->index;
-
-	uint num = 0;
-
-	for (const Station *st : Station::Iterate()) {
-		if (st->owner == owner) num += CountBits((byte)st->facilities);
-	}
+	CompanyAssetTotalsArray totals;
+	GetCompanyAssetTotals(totals);
+	return CalculateCompanyAssetValue(c, totals);
+}
 
-	Money value = num * _price[PR_STATION_VALUE] * 25;
+Money CalculateCompanyValueExcludingShares(const Company *c, bool including_loan)
+{
+	CompanyAssetTotalsArray totals;
+	GetCompanyAssetTotals(totals);
+	return CalculateCompanyValueExcludingShares(totals[c->index]);
+}
 
-	for (const Vehicle *v : Vehicle::Iterate()) {
-		if (v->owner != owner) continue;
-		if (HasBit(v->subtype, GVSF_VIRTUAL)) continue;
+/**
+ * Calculate the value of the company from precollected asset totals.
+ * @param c the company to get the value of.
+ * @param including_loan include the loan in the company value.
+ * @param totals The asset totals of all companies.
+ * @return the value of the company.
+ */
+static Money CalculateCompanyValue(const Company *c, bool including_loan, const CompanyAssetTotalsArray &totals)
+{
+	Money value = CalculateCompanyAssetValue(c, totals);
 
-		if (v->type == VEH_TRAIN ||
-				v->type == VEH_ROAD ||
-				(v->type == VEH_AIRCRAFT && Aircraft::From(v)->IsNormalAircraft()) ||
-				v->type == VEH_SHIP) {
-			value += v->value * 3 >> 1;
-		}
-	}
+	/* Add real money value */
+	if (including_loan) value -= c->current_loan;
+	value += c->money;
 
-	return value;
+	return std::max<Money>(value, 1);
 }
 
 /**
@@ -168,13 +248,9 @@ Money CalculateCompanyValueExcludingShares(const Company *c, bool including_loan
  */
 Money CalculateCompanyValue(const Company *c, bool including_loan)
 {
-	Money value = CalculateCompanyAssetValue(c);
-
-	/* Add real money value */
-	if (including_loan) value -= c->current_loan;
-	value += c->money;
-
-	return std::max<Money>(value, 1);
+	CompanyAssetTotalsArray totals;
+	GetCompanyAssetTotals(totals);
+	return CalculateCompanyValue(c, including_loan, totals);
 }
 
 /**
@@ -211,14 +287,13 @@ Money CalculateHostileTakeoverValue(const Company *c)
 }
 
 /**
- * if update is set to true, the economy is updated with this score
- *  (also the house is updated, should only be true in the on-tick event)
- * @param update the economy with calculated score
+ * Calculate the rating of a company from precollected asset totals, see #UpdateCompanyRatingAndValue.
  * @param c company been evaluated
+ * @param update the economy with calculated score
+ * @param totals The asset totals of all companies.
  * @return actual score of this company
- *
  */
-int UpdateCompanyRatingAndValue(Company *c, bool update)
+static int UpdateCompanyRatingAndValue(Company *c, bool update, const CompanyAssetTotalsArray &totals)
 {
 	Owner owner = c->index;
 	int score = 0;
@@ -227,27 +302,10 @@ int UpdateCompanyRatingAndValue(Company *c, bool update)
 
 	/* Count vehicles */
 	{
-		Money min_profit = 0;
-		bool min_profit_first = true;
-		uint num = 0;
-
-		for (const Vehicle *v : Vehicle::Iterate()) {
-			if (v->owner != owner) continue;
-			if (IsCompanyBuildableVehicleType(v->type) && v->IsPrimaryVehicle() && !HasBit(v->subtype, GVSF_VIRTUAL)) {
-				if (v->profit_last_year > 0) num++; // For the vehicle score only count profitable vehicles
-				if (v->age > 730) {
-					/* Find the vehicle with the lowest amount of profit */
-					if (min_profit_first || min_profit > v->profit_last_year) {
-						min_profit = v->profit_last_year;
-						min_profit_first = false;
-					}
-				}
-			}
-		}
-
+		Money min_profit = totals[owner].min_profit;
 		min_profit >>= 8; // remove the fract part
 
-		_score_part[owner][SCORE_VEHICLES] = num;
+		_score_part[owner][SCORE_VEHICLES] = totals[owner].profitable_vehicles;
 		/* Don't allow negative min_profit to show */
 		if (min_profit > 0) {
 			_score_part[owner][SCORE_MIN_PROFIT] = min_profit;
@@ -256,12 +314,7 @@ int UpdateCompanyRatingAndValue(Company *c, bool update)
 
 	/* Count stations */
 	{
-		uint num = 0;
-		for (const Station *st : Station::Iterate()) {
-			/* Only count stations that are actually serviced */
-			if (st->owner == owner && (st->time_since_load <= 20 || st->time_since_unload <= 20)) num += CountBits((byte)st->facilities);
-		}
-		_score_part[owner][SCORE_STATIONS] = num;
+		_score_part[owner][SCORE_STATIONS] = totals[owner].serviced_station_facilities;
 	}
 
 	/* Generate statistics depending on recent income statistics */
@@ -339,13 +392,41 @@ int UpdateCompanyRatingAndValue(Company *c, bool update)
 	if (update) {
 		c->old_economy[0].performance_history = score;
 		UpdateCompanyHQ(c->location_of_HQ, score);
-		c->old_economy[0].company_value = CalculateCompanyValue(c);
+		c->old_economy[0].company_value = CalculateCompanyValue(c, true, totals);
 	}
 
 	SetWindowDirty(WC_PERFORMANCE_DETAIL, 0);
 	return score;
 }
 
+/**
+ * if update is set to true, the economy is updated with this score
+ *  (also the house is updated, should only be true in the on-tick event)
+ * @param update the economy with calculated score
+ * @param c company been evaluated
+ * @return actual score of this company
+ *
+ */
+int UpdateCompanyRatingAndValue(Company *c, bool update)
+{
+	CompanyAssetTotalsArray totals;
+	GetCompanyAssetTotals(totals);
+	return UpdateCompanyRatingAndValue(c, update, totals);
+}
+
+/**
+ * Recalculate the score parts of all companies, without updating their economy.
+ * The station and vehicle totals are collected once for all companies.
+ */
+void RecalculateCompanyRatings()
+{
+	CompanyAssetTotalsArray totals;
+	GetCompanyAssetTotals(totals);
+	for (Company *c : Company::Iterate()) {
+		UpdateCompanyRatingAndValue(c, false, totals);
+	}
+}
+
 /**
  * Change the ownership of all the items of a company.
  * @param old_owner The company that gets removed.
@@ -646,6 +727,7 @@ void ChangeOwnershipOfCompanyItems(Owner old_owner, Owner new_owner)
 	IntialiseOrderDestinationRefcountMap();
 
 	YapfNotifyTrackLayoutChange(INVALID_TILE, INVALID_TRACK);
+	YapfNotifyRoadLayoutChange();
 
 	NotifyRoadLayoutChanged();
 
@@ -801,6 +883,10 @@ static void CompaniesGenStatistics()
 	/* Only run the economic statics and update company stats every 3rd month (1st of quarter). */
 	if (!HasBit(1 << 0 | 1 << 3 | 1 << 6 | 1 << 9, _cur_date_ymd.month)) return;
 
+	/* The stations and vehicles do not change while the companies are rated, so collect their totals once. */
+	CompanyAssetTotalsArray totals;
+	GetCompanyAssetTotals(totals);
+
 	for (Company *c : Company::Iterate()) {
 		/* Drop the oldest history off the end */
 		std::copy_backward(c->old_economy, c->old_economy + MAX_HISTORY_QUARTERS - 1, c->old_economy + MAX_HISTORY_QUARTERS);
@@ -809,7 +895,7 @@ static void CompaniesGenStatistics()
 
 		if (c->num_valid_stat_ent != MAX_HISTORY_QUARTERS) c->num_valid_stat_ent++;
 
-		UpdateCompanyRatingAndValue(c, true);
+		UpdateCompanyRatingAndValue(c, true, totals);
 		if (c->block_preview != 0) c->block_preview--;
 	}
 
@@ -1156,20 +1242,16 @@ static SmallIndustryList _cargo_delivery_destinations;
 
 template <class F>
 void ForAcceptingIndustries(const Station *st, CargoID cargo_type, IndustryID source, CompanyID company, F&& f) {
-	for (const auto &i : st->industries_near) {
+	for (const IndustryAcceptorEntry &i : st->GetIndustryAcceptors(cargo_type)) {
 		Industry *ind = i.industry;
 		if (ind->index == source) continue;
 
-		int cargo_index = ind->GetCargoAcceptedIndex(cargo_type);
-		/* Check if matching cargo has been found */
-		if (cargo_index < 0) continue;
-
 		/* Check if industry temporarily refuses acceptance */
 		if (IndustryTemporarilyRefusesCargo(ind, cargo_type)) continue;
 
 		if (ind->exclusive_supplier != INVALID_OWNER && ind->exclusive_supplier != st->owner) continue;
 
-		if (!f(ind, cargo_index)) break;
+		if (!f(ind, i.cargo_index)) break;
 	}
 }
 
@@ -1533,7 +1615,7 @@ static OrderUnloadFlags GetUnloadType(const Vehicle *v)
 void PrepareUnload(Vehicle *front_v)
 {
 	Station *curr_station = Station::Get(front_v->last_station_visited);
-	curr_station->loading_vehicles.push_back(front_v);
+	curr_station->AddLoadingVehicle(front_v);
 
 	/* At this moment loading cannot be finished */
 	ClrBit(front_v->vehicle_flags, VF_LOADING_FINISHED);
@@ -17,7 +17,6 @@
 #include "effectvehicle_func.h"
 #include "effectvehicle_base.h"
 #include "core/checksum_func.hpp"
-#include "core/container_func.hpp"
 
 #include <algorithm>
 
@@ -695,19 +694,19 @@ TransparencyOption EffectVehicle::GetTransparencyOption() const
 	return _effect_transparency_options[this->subtype];
 }
 
-extern std::vector<VehicleID> _remove_from_tick_effect_veh_cache;
+extern btree::btree_set<VehicleID> _remove_from_tick_effect_veh_cache;
 extern btree::btree_set<VehicleID> _tick_effect_veh_cache;
 extern bool _tick_caches_valid;
 
 void EffectVehicle::AddEffectVehicleToTickCache()
 {
 	if (!_tick_caches_valid) return;
-	if (container_unordered_remove(_remove_from_tick_effect_veh_cache, this->index) > 0) return;
+	if (_remove_from_tick_effect_veh_cache.erase(this->index) > 0) return;
 	_tick_effect_veh_cache.insert(this->index);
 }
 
 void EffectVehicle::RemoveEffectVehicleFromTickCache()
 {
 	if (!_tick_caches_valid) return;
-	_remove_from_tick_effect_veh_cache.push_back(this->index);
+	_remove_from_tick_effect_veh_cache.insert(this->index);
 }
@@ -345,6 +345,11 @@ static void DrawRailCatenaryRailway(const TileInfo *ti)
 
 	AdjustTileh(ti->tile, &tileh[TS_HOME]);
 
+	/* Finding the height of a bridge above walks to its end, so only do it once for all pylons and the wires. */
+	bool low_bridge_above = false;
+	if (IsBridgeAbove(ti->tile)) low_bridge_above = GetBridgeHeight(GetNorthernBridgeEnd(ti->tile)) <= GetTileMaxZ(ti->tile) + 1;
+	const bool pylons_allowed = !IsRailStationTile(ti->tile) || CanStationTileHavePylons(ti->tile);
+
 	SpriteID pylon_normal = 0;
 	SpriteID pylon_halftile = 0;
 	SpriteID pylon_normal_secondary = 0;
@@ -481,20 +486,17 @@ static void DrawRailCatenaryRailway(const TileInfo *ti)
 		 * Remove those (simply by ANDing with allowed, since these markers are never allowed) */
 		if ((PPPallowed[i] & PPPpreferred[i]) != 0) PPPallowed[i] &= PPPpreferred[i];
 
-		if (IsBridgeAbove(ti->tile)) {
+		if (low_bridge_above) {
 			Track bridgetrack = GetBridgeAxis(ti->tile) == AXIS_X ? TRACK_X : TRACK_Y;
-			int height = GetBridgeHeight(GetNorthernBridgeEnd(ti->tile));
 
-			if ((height <= GetTileMaxZ(ti->tile) + 1) &&
-					(i == PCPpositions[bridgetrack][0] || i == PCPpositions[bridgetrack][1])) {
+			if (i == PCPpositions[bridgetrack][0] || i == PCPpositions[bridgetrack][1]) {
 				SetBit(OverridePCP, i);
 			}
 		}
 
-		if (PPPallowed[i] != 0 && HasBit(PCPstatus, i) && !HasBit(OverridePCP, i) &&
-				(!IsRailStationTile(ti->tile) || CanStationTileHavePylons(ti->tile))) {
+		if (PPPallowed[i] != 0 && HasBit(PCPstatus, i) && !HasBit(OverridePCP, i) && pylons_allowed) {
 			for (Direction k = DIR_BEGIN; k < DIR_END; k++) {
-				byte temp = PPPorder[i][GetTLG(ti->tile)][k];
+				byte temp = PPPorder[i][tlg][k];
 
 				if (HasBit(PPPallowed[i], temp)) {
 					uint x  = ti->x + x_pcp_offsets[i] + x_ppp_offsets[temp];
@@ -520,11 +522,7 @@ static void DrawRailCatenaryRailway(const TileInfo *ti)
 	if (IsTunnelTile(ti->tile)) return;
 
 	/* Don't draw a wire under a low bridge */
-	if (IsBridgeAbove(ti->tile) && !IsTransparencySet(TO_BRIDGES)) {
-		int height = GetBridgeHeight(GetNorthernBridgeEnd(ti->tile));
-
-		if (height <= GetTileMaxZ(ti->tile) + 1) return;
-	}
+	if (low_bridge_above && !IsTransparencySet(TO_BRIDGES)) return;
 
 	/* Don't draw a wire if the station tile does not want any */
 	if (IsRailStationTile(ti->tile) && !CanStationTileHaveWires(ti->tile)) return;
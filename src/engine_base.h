@@ -92,6 +92,9 @@ struct Engine : EnginePool::PoolItem<&_engine_pool> {
 
 	std::unique_ptr<EngineRefitCapacityValue, FreeDeleter> refit_capacity_values;
 
+	uint64 cb36_const_properties = 0;                    ///< Properties in #cb36_properties_used for which the callback result does not depend on the vehicle.
+	btree::btree_map<uint8, uint16> cb36_const_results; ///< Callback results of the properties in #cb36_const_properties, for vehicles (not purchase).
+
 	Engine() {}
 	Engine(VehicleType type, EngineID base);
 	bool IsEnabled() const;
@@ -14,6 +14,7 @@
 #include "fios.h"
 #include "string_func.h"
 #include "tar_type.h"
+#include "worker_thread.h"
 #include "3rdparty/cpp-btree/btree_set.h"
 #ifdef _WIN32
 #include <windows.h>
@@ -71,6 +72,20 @@ TarFileList _tar_filelist[NUM_SUBDIRS];
 typedef std::map<std::string, std::string> TarLinkList;
 static TarLinkList _tar_linklist[NUM_SUBDIRS]; ///< List of directory links
 
+/** Contents of a tar file, as read from its headers. */
+struct TarIndex {
+	uint64 size = 0;                                              ///< Size of the tar file when it was read.
+	int64 mtime = 0;                                              ///< Modification time of the tar file when it was read.
+	bool opened = false;                                          ///< Whether the file could be opened.
+	bool valid = false;                                           ///< Whether the whole file could be read as a tar file.
+	std::string first_dir;                                        ///< The first directory in the tar.
+	std::vector<std::pair<std::string, TarFileListEntry>> files;  ///< The regular files, in the order of the tar.
+	TarLinkList links;                                            ///< The links.
+};
+
+/** Contents of the tar files read before, by file name, so rescans only read new and changed tar files. */
+static std::map<std::string, TarIndex> _tar_index_cache;
+
 extern bool FiosIsValidFile(const char *path, const struct dirent *ent, struct stat *sb);
 
 /**
@@ -432,47 +447,6 @@ static void SimplifyFileName(char *name)
 #endif
 }
 
-/**
- * Perform the scanning of a particular subdirectory.
- * @param sd The subdirectory to scan.
- * @return The number of found tar files.
- */
-uint TarScanner::DoScan(Subdirectory sd)
-{
-	_tar_filelist[sd].clear();
-	_tar_list[sd].clear();
-	uint num = this->Scan(".tar", sd, false);
-	if (sd == BASESET_DIR || sd == NEWGRF_DIR) num += this->Scan(".tar", OLD_DATA_DIR, false);
-	return num;
-}
-
-/* static */ uint TarScanner::DoScan(TarScanner::Mode mode)
-{
-	DEBUG(misc, 2, "Scanning for tars");
-	TarScanner fs;
-	uint num = 0;
-	if (mode & TarScanner::BASESET) {
-		num += fs.DoScan(BASESET_DIR);
-	}
-	if (mode & TarScanner::NEWGRF) {
-		num += fs.DoScan(NEWGRF_DIR);
-	}
-	if (mode & TarScanner::AI) {
-		num += fs.DoScan(AI_DIR);
-		num += fs.DoScan(AI_LIBRARY_DIR);
-	}
-	if (mode & TarScanner::GAME) {
-		num += fs.DoScan(GAME_DIR);
-		num += fs.DoScan(GAME_LIBRARY_DIR);
-	}
-	if (mode & TarScanner::SCENARIO) {
-		num += fs.DoScan(SCENARIO_DIR);
-		num += fs.DoScan(HEIGHTMAP_DIR);
-	}
-	DEBUG(misc, 2, "Scan complete, found %d files", num);
-	return num;
-}
-
 /**
  * Add a single file to the scanned files of a tar, circumventing the scanning code.
  * @param sd       The sub directory the file is in.
@@ -485,11 +459,14 @@ bool TarScanner::AddFile(Subdirectory sd, const std::string &filename)
 	return this->AddFile(filename, 0);
 }
 
-bool TarScanner::AddFile(const std::string &filename, size_t basepath_length, const std::string &tar_filename)
+/**
+ * Read the headers of a tar file.
+ * This only reads the file, so it can be done for several tar files at once.
+ * @param filename Name of the tar file.
+ * @param[out] index The contents of the tar file.
+ */
+static void ReadTarIndex(const std::string &filename, TarIndex &index)
 {
-	/* No tar within tar. */
-	assert(tar_filename.empty());
-
 	/* The TAR-header, repeated for every file */
 	struct TarHeader {
 		char name[100];      ///< Name of the file
@@ -512,27 +489,21 @@ bool TarScanner::AddFile(const std::string &filename, size_t basepath_length, co
 		char unused[12];
 	};
 
-	/* Check if we already seen this file */
-	TarList::iterator it = _tar_list[this->subdir].find(filename);
-	if (it != _tar_list[this->subdir].end()) return false;
-
 	FILE *f = fopen(filename.c_str(), "rb");
 	/* Although the file has been found there can be
 	 * a number of reasons we cannot open the file.
 	 * Most common case is when we simply have not
 	 * been given read access. */
-	if (f == nullptr) return false;
+	if (f == nullptr) return;
 
-	_tar_list[this->subdir][filename] = std::string{};
-
-	TarLinkList links; ///< Temporary list to collect links
+	index.opened = true;
 
 	TarHeader th;
 	char buf[sizeof(th.name) + 1], *end;
 	char name[sizeof(th.prefix) + 1 + sizeof(th.name) + 1];
 	char link[sizeof(th.linkname) + 1];
 	char dest[sizeof(th.prefix) + 1 + sizeof(th.name) + 1 + 1 + sizeof(th.linkname) + 1];
-	size_t num = 0, pos = 0;
+	size_t pos = 0;
 
 	/* Make a char of 512 empty bytes */
 	char empty[512];
@@ -550,7 +521,7 @@ bool TarScanner::AddFile(const std::string &filename, size_t basepath_length, co
 
 			DEBUG(misc, 0, "The file '%s' isn't a valid tar-file", filename.c_str());
 			fclose(f);
-			return false;
+			return;
 		}
 
 		name[0] = '\0';
@@ -583,7 +554,7 @@ bool TarScanner::AddFile(const std::string &filename, size_t basepath_length, co
 				SimplifyFileName(name);
 
 				DEBUG(misc, 6, "Found file in tar: %s (" PRINTF_SIZE " bytes, " PRINTF_SIZE " offset)", name, skip, pos);
-				if (_tar_filelist[this->subdir].insert(TarFileList::value_type(name, entry)).second) num++;
+				index.files.emplace_back(name, std::move(entry));
 
 				break;
 			}
@@ -645,7 +616,7 @@ bool TarScanner::AddFile(const std::string &filename, size_t basepath_length, co
 					if (destpos >= lastof(dest)) {
 						DEBUG(misc, 0, "The length of a link in tar-file '%s' is too large (malformed?)", filename.c_str());
 						fclose(f);
-						return false;
+						return;
 					}
 
 					pos = next;
@@ -653,7 +624,7 @@ bool TarScanner::AddFile(const std::string &filename, size_t basepath_length, co
 
 				/* Store links in temporary list */
 				DEBUG(misc, 6, "Found link in tar: %s -> %s", name, dest);
-				links.insert(TarLinkList::value_type(name, dest));
+				index.links.insert(TarLinkList::value_type(name, dest));
 
 				break;
 			}
@@ -664,7 +635,7 @@ bool TarScanner::AddFile(const std::string &filename, size_t basepath_length, co
 
 				/* Store the first directory name we detect */
 				DEBUG(misc, 6, "Found dir in tar: %s", name);
-				if (_tar_list[this->subdir][filename].empty()) _tar_list[this->subdir][filename] = name;
+				if (index.first_dir.empty()) index.first_dir = name;
 				break;
 
 			default:
@@ -677,13 +648,40 @@ bool TarScanner::AddFile(const std::string &filename, size_t basepath_length, co
 		if (fseek(f, skip, SEEK_CUR) < 0) {
 			DEBUG(misc, 0, "The file '%s' can't be read as a valid tar-file", filename.c_str());
 			fclose(f);
-			return false;
+			return;
 		}
 		pos += skip;
 	}
 
-	DEBUG(misc, 4, "Found tar '%s' with " PRINTF_SIZE " new files", filename.c_str(), num);
 	fclose(f);
+	index.valid = true;
+}
+
+/**
+ * Add the contents of a tar file to the file lists of a subdirectory.
+ * @param subdir The subdirectory the tar file was found for.
+ * @param filename Name of the tar file.
+ * @param index The contents of the tar file.
+ * @return Whether the tar file was added.
+ */
+static bool AddTarIndex(Subdirectory subdir, const std::string &filename, const TarIndex &index)
+{
+	/* Check if we already seen this file */
+	if (_tar_list[subdir].find(filename) != _tar_list[subdir].end()) return false;
+
+	/* Although the file has been found there can be
+	 * a number of reasons we cannot open the file. */
+	if (!index.opened) return false;
+
+	_tar_list[subdir][filename] = index.first_dir;
+
+	size_t num = 0;
+	for (const auto &it : index.files) {
+		if (_tar_filelist[subdir].insert(it).second) num++;
+	}
+	if (!index.valid) return false;
+
+	DEBUG(misc, 4, "Found tar '%s' with " PRINTF_SIZE " new files", filename.c_str(), num);
 
 	/* Resolve file links and store directory links.
 	 * We restrict usage of links to two cases:
@@ -694,13 +692,131 @@ bool TarScanner::AddFile(const std::string &filename, size_t basepath_length, co
 	 *      The destination path must NOT contain any links.
 	 *      The source path may contain one directory link.
 	 */
-	for (auto &it : links) {
-		TarAddLink(it.first, it.second, this->subdir);
+	for (auto &it : index.links) {
+		TarAddLink(it.first, it.second, subdir);
 	}
 
 	return true;
 }
 
+/**
+ * Get the contents of a tar file, from the tar index cache if the file did not change since it was last read.
+ * @param filename Name of the tar file.
+ * @param[out] index The contents of the tar file.
+ * @return Whether the contents were found in the cache; otherwise the file still has to be read.
+ */
+static bool GetCachedTarIndex(const std::string &filename, TarIndex &index)
+{
+#ifdef _WIN32
+	struct _stat64 sb;
+	if (_wstat64(OTTD2FS(filename).c_str(), &sb) != 0) return false;
+#else
+	struct stat sb;
+	if (stat(OTTD2FS(filename).c_str(), &sb) != 0) return false;
+#endif
+	index.size = sb.st_size;
+	index.mtime = sb.st_mtime;
+
+	auto it = _tar_index_cache.find(filename);
+	if (it == _tar_index_cache.end() || it->second.size != index.size || it->second.mtime != index.mtime) return false;
+	index = it->second;
+	return true;
+}
+
+/**
+ * Store the contents of a tar file in the tar index cache.
+ * @param filename Name of the tar file.
+ * @param index The contents of the tar file, as read by #ReadTarIndex after #GetCachedTarIndex.
+ */
+static void StoreCachedTarIndex(const std::string &filename, const TarIndex &index)
+{
+	if (index.mtime == 0 || !index.opened) return;
+	_tar_index_cache[filename] = index;
+}
+
+bool TarScanner::AddFile(const std::string &filename, size_t, const std::string &tar_filename)
+{
+	/* No tar within tar. */
+	assert(tar_filename.empty());
+
+	if (this->pending != nullptr) {
+		/* Only collect the tars, they are read and added by DoScan. */
+		this->pending->push_back({ this->subdir, filename });
+		return true;
+	}
+
+	/* Check if we already seen this file */
+	if (_tar_list[this->subdir].find(filename) != _tar_list[this->subdir].end()) return false;
+
+	TarIndex index;
+	if (!GetCachedTarIndex(filename, index)) {
+		ReadTarIndex(filename, index);
+		StoreCachedTarIndex(filename, index);
+	}
+	return AddTarIndex(this->subdir, filename, index);
+}
+
+/**
+ * Clear the tar lists of a particular subdirectory and collect its tars in #pending.
+ * @param sd The subdirectory to scan.
+ */
+void TarScanner::DoScan(Subdirectory sd)
+{
+	_tar_filelist[sd].clear();
+	_tar_list[sd].clear();
+	this->Scan(".tar", sd, false);
+	if (sd == BASESET_DIR || sd == NEWGRF_DIR) this->Scan(".tar", OLD_DATA_DIR, false);
+}
+
+/* static */ uint TarScanner::DoScan(TarScanner::Mode mode)
+{
+	DEBUG(misc, 2, "Scanning for tars");
+
+	/* First collect the tars of all subdirectories, then read the ones which are not cached
+	 * in parallel, and finally add them in the order in which they were found. */
+	std::vector<PendingTar> pending;
+	TarScanner fs;
+	fs.pending = &pending;
+	if (mode & TarScanner::BASESET) {
+		fs.DoScan(BASESET_DIR);
+	}
+	if (mode & TarScanner::NEWGRF) {
+		fs.DoScan(NEWGRF_DIR);
+	}
+	if (mode & TarScanner::AI) {
+		fs.DoScan(AI_DIR);
+		fs.DoScan(AI_LIBRARY_DIR);
+	}
+	if (mode & TarScanner::GAME) {
+		fs.DoScan(GAME_DIR);
+		fs.DoScan(GAME_LIBRARY_DIR);
+	}
+	if (mode & TarScanner::SCENARIO) {
+		fs.DoScan(SCENARIO_DIR);
+		fs.DoScan(HEIGHTMAP_DIR);
+	}
+
+	std::vector<TarIndex> indexes(pending.size());
+	std::vector<size_t> to_read;
+	btree::btree_set<std::pair<Subdirectory, std::string>> seen;
+	for (size_t i = 0; i < pending.size(); i++) {
+		/* The same tar can be found again in OLD_DATA_DIR, only the first one is added. */
+		if (_tar_list[pending[i].subdir].count(pending[i].filename) != 0 || !seen.insert({ pending[i].subdir, pending[i].filename }).second) continue;
+		if (!GetCachedTarIndex(pending[i].filename, indexes[i])) to_read.push_back(i);
+	}
+	_general_worker_pool.ParallelFor((int)to_read.size(), 1, [&](int first, int last) {
+		for (int i = first; i < last; i++) ReadTarIndex(pending[to_read[i]].filename, indexes[to_read[i]]);
+	});
+	for (size_t i : to_read) StoreCachedTarIndex(pending[i].filename, indexes[i]);
+
+	uint num = 0;
+	for (size_t i = 0; i < pending.size(); i++) {
+		if (AddTarIndex(pending[i].subdir, pending[i].filename, indexes[i])) num++;
+	}
+	DEBUG(misc, 2, "Scan complete, found %d files, read %u", num, (uint)to_read.size());
+	return num;
+}
+
 /**
  * Extract the tar with the given filename in the directory
  * where the tar resides.
@@ -1059,6 +1175,8 @@ void DeterminePaths(const char *exe, bool only_local_path)
 	_private_file = config_dir + "private.cfg";
 	extern std::string _secrets_file;
 	_secrets_file = config_dir + "secrets.cfg";
+	extern std::string _newgrf_scan_cache_file;
+	_newgrf_scan_cache_file = config_dir + "newgrf_scan_cache.dat";
 
 #ifdef USE_XDG
 	if (config_dir == config_home) {
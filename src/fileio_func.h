@@ -61,7 +61,14 @@ public:
 
 /** Helper for scanning for files with tar as extension */
 class TarScanner : FileScanner {
-	uint DoScan(Subdirectory sd);
+	/** A tar file found by the scan, which still has to be added. */
+	struct PendingTar {
+		Subdirectory subdir;  ///< The sub directory the tar was found for.
+		std::string filename; ///< Name of the tar.
+	};
+	std::vector<PendingTar> *pending = nullptr; ///< When set, the found tars are collected here instead of being added.
+
+	void DoScan(Subdirectory sd);
 public:
 	/** The mode of tar scanning. */
 	enum Mode {
@@ -35,6 +35,8 @@
 #include "table/sprites.h"
 #include "table/strings.h"
 
+#include <deque>
+
 #include "safeguards.h"
 
 LoadCheckData _load_check_data;    ///< Data loaded from save during SL_LOAD_CHECK.
@@ -69,6 +71,37 @@ void LoadCheckData::Clear()
 	this->version_name.clear();
 }
 
+/**
+ * Exchange the read data with that of another instance.
+ * @param other Data to exchange with.
+ */
+void LoadCheckData::Swap(LoadCheckData &other)
+{
+	std::swap(this->checkable, other.checkable);
+	std::swap(this->error, other.error);
+	std::swap(this->error_msg, other.error_msg);
+
+	std::swap(this->map_size_x, other.map_size_x);
+	std::swap(this->map_size_y, other.map_size_y);
+	std::swap(this->current_date, other.current_date);
+	std::swap(this->settings, other.settings);
+
+	std::swap(this->companies, other.companies);
+
+	std::swap(this->grfconfig, other.grfconfig);
+	std::swap(this->want_grf_compatibility, other.want_grf_compatibility);
+	std::swap(this->grf_compatibility, other.grf_compatibility);
+
+	std::swap(this->gamelog_actions, other.gamelog_actions);
+
+	std::swap(this->want_debug_data, other.want_debug_data);
+	std::swap(this->debug_log_data, other.debug_log_data);
+	std::swap(this->debug_config_data, other.debug_config_data);
+
+	std::swap(this->sl_is_ext_version, other.sl_is_ext_version);
+	std::swap(this->version_name, other.version_name);
+}
+
 /** Load game/scenario with optional content download */
 static const NWidgetPart _nested_load_dialog_widgets[] = {
 	NWidget(NWID_HORIZONTAL),
@@ -291,6 +324,64 @@ private:
 	QueryString filter_editbox; ///< Filter editbox;
 	std::vector<FiosItem *> display_list; ///< Filtered display list
 
+	/** Previously read data of a savegame. */
+	struct LoadCheckCacheEntry {
+		uint64 mtime;                        ///< Modification time of the file when it was read.
+		std::unique_ptr<LoadCheckData> data; ///< Data read from the file.
+	};
+	static const uint LOAD_CHECK_CACHE_SIZE = 32; ///< Maximum number of entries in #load_check_cache.
+	btree::btree_map<std::string, LoadCheckCacheEntry> load_check_cache; ///< Read data of previously selected savegames, by file name.
+	std::deque<std::string> load_check_cache_order; ///< File names in #load_check_cache, oldest first.
+
+	/**
+	 * Move the contents of #_load_check_data into the cache, if they belong to the selected savegame.
+	 * Afterwards #_load_check_data is cleared.
+	 */
+	void StoreLoadCheckData()
+	{
+		if (this->selected == nullptr || GetDetailedFileType(this->selected->type) != DFT_GAME_FILE || !_load_check_data.checkable) {
+			_load_check_data.Clear();
+			return;
+		}
+
+		auto it = this->load_check_cache.find(this->selected->name);
+		if (it == this->load_check_cache.end()) {
+			if (this->load_check_cache_order.size() >= LOAD_CHECK_CACHE_SIZE) {
+				this->load_check_cache.erase(this->load_check_cache_order.front());
+				this->load_check_cache_order.pop_front();
+			}
+			it = this->load_check_cache.insert({ this->selected->name, LoadCheckCacheEntry{ 0, std::make_unique<LoadCheckData>() } }).first;
+			this->load_check_cache_order.push_back(this->selected->name);
+		}
+		it->second.mtime = this->selected->mtime;
+		it->second.data->Clear();
+		it->second.data->Swap(_load_check_data);
+	}
+
+	/**
+	 * Fill #_load_check_data for a savegame, from the cache if the file did not change since it was read.
+	 * @param file Savegame to read.
+	 */
+	void ReadLoadCheckData(const FiosItem *file)
+	{
+		_load_check_data.Clear();
+
+		auto it = this->load_check_cache.find(file->name);
+		if (it != this->load_check_cache.end() && it->second.mtime == file->mtime) {
+			_load_check_data.Swap(*it->second.data);
+			return;
+		}
+
+		SaveOrLoad(file->name, SLO_CHECK, DFT_GAME_FILE, NO_DIRECTORY, false);
+	}
+
+	/** Forget all cached savegame data. */
+	void ClearLoadCheckCache()
+	{
+		this->load_check_cache.clear();
+		this->load_check_cache_order.clear();
+	}
+
 	static void SaveGameConfirmationCallback(Window *, bool confirmed)
 	{
 		/* File name has already been written to _file_to_saveload */
@@ -687,12 +778,12 @@ public:
 
 				if (click_count == 1) {
 					if (this->selected != file) {
+						this->StoreLoadCheckData();
 						this->selected = file;
-						_load_check_data.Clear();
 
 						if (GetDetailedFileType(file->type) == DFT_GAME_FILE) {
 							/* Other detailed file types cannot be checked before. */
-							SaveOrLoad(file->name, SLO_CHECK, DFT_GAME_FILE, NO_DIRECTORY, false);
+							this->ReadLoadCheckData(file);
 						}
 
 						this->InvalidateData(SLIWD_SELECTION_CHANGES);
@@ -873,6 +964,8 @@ public:
 				/* Rescan files */
 				this->selected = nullptr;
 				_load_check_data.Clear();
+				/* The available NewGRFs may have changed, so the cached compatibility is no longer known. */
+				this->ClearLoadCheckCache();
 				if (!gui_scope) break;
 
 				_fios_path_changed = true;
@@ -23,6 +23,7 @@
 #include "ai/ai_instance.hpp"
 #include "game/game.hpp"
 #include "game/game_instance.hpp"
+#include "thread.h"
 
 #include "widgets/framerate_widget.h"
 
@@ -31,6 +32,7 @@
 #if defined(__MINGW32__)
 #include "3rdparty/mingw-std-threads/mingw.mutex.h"
 #endif
+#include <algorithm>
 #include <vector>
 
 #include "safeguards.h"
@@ -147,6 +149,23 @@ namespace {
 			return sumtime * 1000 / count / TIMESTAMP_PRECISION;
 		}
 
+		/** Get the longest cycle processing time over a number of data points, to show periodic spikes which the averages hide */
+		double GetPeakDurationMilliseconds(int count)
+		{
+			count = std::min(count, this->num_valid);
+
+			int first_point = this->prev_index - count;
+			if (first_point < 0) first_point += NUM_FRAMERATE_POINTS;
+
+			TimingMeasurement peak = 0;
+			for (int i = first_point; i < first_point + count; i++) {
+				auto d = this->durations[i % NUM_FRAMERATE_POINTS];
+				if (d != INVALID_DURATION && d > peak) peak = d;
+			}
+
+			return (double)peak * 1000 / TIMESTAMP_PRECISION;
+		}
+
 		/** Get current rate of a performance element, based on approximately the past one second of data */
 		double GetRate()
 		{
@@ -196,6 +215,13 @@ namespace {
 		PerformanceData(1),                     // PFE_ACC_GL_SHIPS
 		PerformanceData(1),                     // PFE_ACC_GL_AIRCRAFT
 		PerformanceData(1),                     // PFE_GL_LANDSCAPE
+		PerformanceData(1),                     // PFE_GL_LS_TILELOOP
+		PerformanceData(1),                     // PFE_GL_LS_ANIMATION
+		PerformanceData(1),                     // PFE_GL_LS_TOWNS
+		PerformanceData(1),                     // PFE_GL_LS_TREES
+		PerformanceData(1),                     // PFE_GL_LS_STATIONS
+		PerformanceData(1),                     // PFE_GL_LS_INDUSTRIES
+		PerformanceData(1),                     // PFE_GL_LS_COMPANIES
 		PerformanceData(1),                     // PFE_GL_LINKGRAPH
 		PerformanceData(1000.0 / 30),           // PFE_DRAWING
 		PerformanceData(1),                     // PFE_ACC_DRAWWORLD
@@ -235,6 +261,94 @@ static TimingMeasurement GetPerformanceTimer()
 }
 
 
+/** Names of the performance elements used by the console commands, AI slots are named separately */
+static const char *MEASUREMENT_NAMES[PFE_AI0] = {
+	"Game loop",
+	"  GL station ticks",
+	"  GL train ticks",
+	"  GL road vehicle ticks",
+	"  GL ship ticks",
+	"  GL aircraft ticks",
+	"  GL landscape ticks",
+	"    GL tile loop",
+	"    GL tile animation",
+	"    GL town ticks",
+	"    GL tree ticks",
+	"    GL station periodic ticks",
+	"    GL industry ticks",
+	"    GL company ticks",
+	"  GL link graph delays",
+	"Drawing",
+	"  Viewport drawing",
+	"Video output",
+	"Sound mixing",
+	"AI/GS scripts total",
+	"Game script",
+};
+
+/** Performance trace recording, see #StartPerformanceTrace */
+namespace {
+	/** One completed scope in the performance trace */
+	struct PerformanceTraceEvent {
+		TimingMeasurement start_time; ///< Start of the scope
+		TimingMeasurement duration;   ///< Duration of the scope
+		const char *name;             ///< Name of the scope, this must be a static string
+		uint32 thread;                ///< Trace thread ID of the thread which recorded the scope
+	};
+
+	std::atomic<bool> _trace_active;                       ///< Whether trace events are currently being recorded
+	std::mutex _trace_lock;                                ///< Lock for all of the below
+	std::vector<PerformanceTraceEvent> _trace_events;      ///< Ring buffer of trace events
+	size_t _trace_next = 0;                                ///< Next index to write to in _trace_events
+	bool _trace_wrapped = false;                           ///< Whether _trace_events has been filled at least once
+	uint64 _trace_dropped = 0;                             ///< Number of events which have been overwritten
+	std::vector<std::string> _trace_thread_names;          ///< Names of the threads which have recorded trace events, by trace thread ID
+	thread_local uint32 _trace_thread_id = UINT32_MAX;     ///< Trace thread ID of the current thread
+}
+
+/** Benchmark recording, see #StartPerformanceBenchmark */
+namespace {
+	bool _benchmark_active = false;                                  ///< Whether benchmark samples are currently being recorded
+	std::vector<TimingMeasurement> _benchmark_samples[PFE_MAX];      ///< Every duration recorded for each element since the benchmark started
+}
+
+/** Add a duration of an element to the benchmark samples, if a benchmark is running. */
+static inline void RecordPerformanceBenchmarkSample(PerformanceElement elem, TimingMeasurement duration)
+{
+	if (_benchmark_active && IsMainThread()) _benchmark_samples[elem].push_back(duration);
+}
+
+/** Add a completed scope to the trace ring buffer. */
+static void RecordPerformanceTraceEvent(const char *name, TimingMeasurement start_time, TimingMeasurement end_time)
+{
+	std::lock_guard<std::mutex> lk(_trace_lock);
+	if (_trace_events.empty()) return;
+
+	if (_trace_thread_id == UINT32_MAX) {
+		char buffer[32];
+		if (GetCurrentThreadName(buffer, lastof(buffer)) <= 0) seprintf(buffer, lastof(buffer), "thread %u", (uint)_trace_thread_names.size());
+		_trace_thread_id = (uint32)_trace_thread_names.size();
+		_trace_thread_names.emplace_back(buffer);
+	}
+
+	if (_trace_wrapped) _trace_dropped++;
+	_trace_events[_trace_next] = { start_time, end_time - start_time, name, _trace_thread_id };
+	_trace_next++;
+	if (_trace_next == _trace_events.size()) {
+		_trace_next = 0;
+		_trace_wrapped = true;
+	}
+}
+
+/** Get the name of a performance element as shown in a trace. */
+static const char *GetPerformanceElementTraceName(PerformanceElement elem)
+{
+	if (elem >= PFE_AI0) return "AI script";
+	const char *name = MEASUREMENT_NAMES[elem];
+	while (*name == ' ') name++;
+	return name;
+}
+
 /**
  * Begin a cycle of a measured element.
  * @param elem The element to be measured
@@ -261,6 +375,7 @@ PerformanceMeasurer::~PerformanceMeasurer()
 	}
 	if (this->elem == PFE_SOUND) {
 		TimingMeasurement end = GetPerformanceTimer();
+		if (_trace_active.load(std::memory_order_relaxed)) RecordPerformanceTraceEvent(GetPerformanceElementTraceName(this->elem), this->start_time, end);
 		std::lock_guard lk(_sound_perf_lock);
 		if (_sound_perf_measurements.size() >= NUM_FRAMERATE_POINTS * 2) return;
 		_sound_perf_measurements.push_back(this->start_time);
@@ -268,7 +383,10 @@ PerformanceMeasurer::~PerformanceMeasurer()
 		_sound_perf_pending.store(true, std::memory_order_release);
 		return;
 	}
-	_pf_data[this->elem].Add(this->start_time, GetPerformanceTimer());
+	TimingMeasurement end = GetPerformanceTimer();
+	if (_trace_active.load(std::memory_order_relaxed)) RecordPerformanceTraceEvent(GetPerformanceElementTraceName(this->elem), this->start_time, end);
+	RecordPerformanceBenchmarkSample(this->elem, end - this->start_time);
+	_pf_data[this->elem].Add(this->start_time, end);
 }
 
 /** Set the rate of expected cycles per second of a performance element. */
@@ -310,7 +428,9 @@ PerformanceAccumulator::PerformanceAccumulator(PerformanceElement elem)
 /** Finish and add one block of the accumulating value. */
 PerformanceAccumulator::~PerformanceAccumulator()
 {
-	_pf_data[this->elem].AddAccumulate(GetPerformanceTimer() - this->start_time);
+	TimingMeasurement end = GetPerformanceTimer();
+	if (_trace_active.load(std::memory_order_relaxed)) RecordPerformanceTraceEvent(GetPerformanceElementTraceName(this->elem), this->start_time, end);
+	_pf_data[this->elem].AddAccumulate(end - this->start_time);
 }
 
 /**
@@ -320,10 +440,149 @@ PerformanceAccumulator::~PerformanceAccumulator()
  */
 void PerformanceAccumulator::Reset(PerformanceElement elem)
 {
+	RecordPerformanceBenchmarkSample(elem, _pf_data[elem].acc_duration);
 	_pf_data[elem].BeginAccumulate(GetPerformanceTimer());
 }
 
 
+/**
+ * Start recording every measurement taken on the main thread, for #WritePerformanceBenchmark.
+ * Any previously recorded samples are discarded.
+ * Unlike the framerate window, which keeps only the most recent #NUM_FRAMERATE_POINTS measurements, the benchmark keeps all of them.
+ */
+void StartPerformanceBenchmark()
+{
+	for (std::vector<TimingMeasurement> &samples : _benchmark_samples) samples.clear();
+	_benchmark_active = true;
+}
+
+/**
+ * Stop recording benchmark samples and write the statistics of each element which recorded any to a file as JSON.
+ * All durations are in microseconds.
+ * @param filename File to write to.
+ * @param ticks Number of game ticks which were run, included in the output for reference.
+ * @return Whether the file was successfully written.
+ */
+bool WritePerformanceBenchmark(const char *filename, uint ticks)
+{
+	_benchmark_active = false;
+
+	FILE *f = fopen(filename, "w");
+	if (f == nullptr) return false;
+
+	fprintf(f, "{\"ticks\":%u,\"elements\":[", ticks);
+	bool first = true;
+	for (PerformanceElement e = PFE_FIRST; e < PFE_MAX; e++) {
+		std::vector<TimingMeasurement> &samples = _benchmark_samples[e];
+		if (samples.empty()) continue;
+
+		std::sort(samples.begin(), samples.end());
+		TimingMeasurement total = 0;
+		for (TimingMeasurement d : samples) total += d;
+		auto percentile = [&](uint p) { return samples[(samples.size() - 1) * p / 100]; };
+
+		char name[64];
+		if (e < PFE_AI0) {
+			strecpy(name, GetPerformanceElementTraceName(e), lastof(name));
+		} else {
+			seprintf(name, lastof(name), "AI %u", (uint)(e - PFE_AI0 + 1));
+		}
+		fprintf(f, "%s\n{\"name\":\"%s\",\"samples\":" PRINTF_SIZE ",\"mean\":%.1f,\"p50\":" OTTD_PRINTF64U ",\"p99\":" OTTD_PRINTF64U ",\"max\":" OTTD_PRINTF64U "}",
+				first ? "" : ",", name, samples.size(), (double)total / samples.size(), percentile(50), percentile(99), samples.back());
+		first = false;
+	}
+	fputs("\n]}\n", f);
+
+	bool ok = (ferror(f) == 0);
+	fclose(f);
+	return ok;
+}
+
+
+/**
+ * Start recording trace events for all performance measurements and #PerformanceTraceScope scopes.
+ * Any previously recorded events are discarded.
+ * @param max_events Size of the ring buffer, once full the oldest events are overwritten.
+ */
+void StartPerformanceTrace(size_t max_events)
+{
+	std::lock_guard<std::mutex> lk(_trace_lock);
+	_trace_events.clear();
+	_trace_events.shrink_to_fit();
+	_trace_events.resize(std::max<size_t>(max_events, 1));
+	_trace_next = 0;
+	_trace_wrapped = false;
+	_trace_dropped = 0;
+	_trace_active.store(true, std::memory_order_relaxed);
+}
+
+/** Stop recording trace events, the recorded events are kept until the next trace is started. */
+void StopPerformanceTrace()
+{
+	_trace_active.store(false, std::memory_order_relaxed);
+}
+
+/** Print the state of the trace recording to the console. */
+void PrintPerformanceTraceStatus()
+{
+	std::lock_guard<std::mutex> lk(_trace_lock);
+	IConsolePrintF(CC_DEFAULT, "Trace recording: %s, buffer: " PRINTF_SIZE " events of " PRINTF_SIZE ", overwritten: " OTTD_PRINTF64U,
+			_trace_active.load(std::memory_order_relaxed) ? "active" : "stopped",
+			_trace_wrapped ? _trace_events.size() : _trace_next, _trace_events.size(), _trace_dropped);
+}
+
+/**
+ * Write the recorded trace events to a file in the Chrome trace event JSON format, which can be loaded by Perfetto or chrome://tracing.
+ * Recording continues while the events are written.
+ * @param filename File to write to.
+ * @return Whether the file was successfully written.
+ */
+bool DumpPerformanceTrace(const char *filename)
+{
+	std::vector<PerformanceTraceEvent> events;
+	std::vector<std::string> thread_names;
+	{
+		std::lock_guard<std::mutex> lk(_trace_lock);
+		if (_trace_wrapped) events.insert(events.end(), _trace_events.begin() + _trace_next, _trace_events.end());
+		events.insert(events.end(), _trace_events.begin(), _trace_events.begin() + _trace_next);
+		thread_names = _trace_thread_names;
+	}
+
+	FILE *f = fopen(filename, "w");
+	if (f == nullptr) return false;
+
+	fputs("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n", f);
+	for (size_t i = 0; i < thread_names.size(); i++) {
+		fprintf(f, "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":\"%s\"}},\n", (uint)i, thread_names[i].c_str());
+	}
+	bool first = true;
+	for (const PerformanceTraceEvent &ev : events) {
+		fprintf(f, "%s{\"name\":\"%s\",\"ph\":\"X\",\"ts\":" OTTD_PRINTF64U ",\"dur\":" OTTD_PRINTF64U ",\"pid\":1,\"tid\":%u}", first ? "" : ",\n", ev.name, ev.start_time, ev.duration, ev.thread);
+		first = false;
+	}
+	fputs("\n]}\n", f);
+
+	bool ok = (ferror(f) == 0);
+	fclose(f);
+	return ok;
+}
+
+/**
+ * Begin a named trace scope.
+ * @param name Name of the scope, this must be a static string.
+ */
+PerformanceTraceScope::PerformanceTraceScope(const char *name) : name(name), start_time(0)
+{
+	if (_trace_active.load(std::memory_order_relaxed)) this->start_time = GetPerformanceTimer();
+}
+
+/** Finish a named trace scope and record it, if tracing was active when the scope began. */
+PerformanceTraceScope::~PerformanceTraceScope()
+{
+	if (this->start_time != 0 && _trace_active.load(std::memory_order_relaxed)) RecordPerformanceTraceEvent(this->name, this->start_time, GetPerformanceTimer());
+}
+
+
 void ShowFrametimeGraphWindow(PerformanceElement elem);
 
 
@@ -335,6 +594,13 @@ static const PerformanceElement DISPLAY_ORDER_PFE[PFE_MAX] = {
 	PFE_GL_SHIPS,
 	PFE_GL_AIRCRAFT,
 	PFE_GL_LANDSCAPE,
+	PFE_GL_LS_TILELOOP,
+	PFE_GL_LS_ANIMATION,
+	PFE_GL_LS_TOWNS,
+	PFE_GL_LS_TREES,
+	PFE_GL_LS_STATIONS,
+	PFE_GL_LS_INDUSTRIES,
+	PFE_GL_LS_COMPANIES,
 	PFE_ALLSCRIPTS,
 	PFE_GAMESCRIPT,
 	PFE_AI0,
@@ -387,6 +653,7 @@ static const NWidgetPart _framerate_window_widgets[] = {
 					NWidget(WWT_EMPTY, COLOUR_GREY, WID_FRW_TIMES_NAMES), SetScrollbar(WID_FRW_SCROLLBAR),
 					NWidget(WWT_EMPTY, COLOUR_GREY, WID_FRW_TIMES_CURRENT), SetScrollbar(WID_FRW_SCROLLBAR),
 					NWidget(WWT_EMPTY, COLOUR_GREY, WID_FRW_TIMES_AVERAGE), SetScrollbar(WID_FRW_SCROLLBAR),
+					NWidget(WWT_EMPTY, COLOUR_GREY, WID_FRW_TIMES_PEAK), SetScrollbar(WID_FRW_SCROLLBAR),
 					NWidget(NWID_SELECTION, INVALID_COLOUR, WID_FRW_SEL_MEMORY),
 						NWidget(WWT_EMPTY, COLOUR_GREY, WID_FRW_ALLOCSIZE), SetScrollbar(WID_FRW_SCROLLBAR),
 					EndContainer(),
@@ -440,6 +707,7 @@ struct FramerateWindow : Window {
 	CachedDecimal speed_gameloop;           ///< cached game loop speed factor
 	CachedDecimal times_shortterm[PFE_MAX]; ///< cached short term average times
 	CachedDecimal times_longterm[PFE_MAX];  ///< cached long term average times
+	CachedDecimal times_peak[PFE_MAX];      ///< cached long term peak times
 
 	static constexpr int MIN_ELEMENTS = 5;      ///< smallest number of elements to display
 
@@ -489,6 +757,7 @@ struct FramerateWindow : Window {
 		for (PerformanceElement e = PFE_FIRST; e < PFE_MAX; e++) {
 			this->times_shortterm[e].SetTime(_pf_data[e].GetAverageDurationMilliseconds(8), MILLISECONDS_PER_TICK);
 			this->times_longterm[e].SetTime(_pf_data[e].GetAverageDurationMilliseconds(NUM_FRAMERATE_POINTS), MILLISECONDS_PER_TICK);
+			this->times_peak[e].SetTime(_pf_data[e].GetPeakDurationMilliseconds(NUM_FRAMERATE_POINTS), MILLISECONDS_PER_TICK);
 			if (_pf_data[e].num_valid > 0) {
 				new_active++;
 				if (e == PFE_GAMESCRIPT || e >= PFE_AI0) have_script = true;
@@ -581,6 +850,7 @@ struct FramerateWindow : Window {
 
 			case WID_FRW_TIMES_CURRENT:
 			case WID_FRW_TIMES_AVERAGE:
+			case WID_FRW_TIMES_PEAK:
 			case WID_FRW_ALLOCSIZE: {
 				*size = GetStringBoundingBox(STR_FRAMERATE_CURRENT + (widget - WID_FRW_TIMES_CURRENT));
 				SetDParam(0, 999999);
@@ -685,6 +955,10 @@ struct FramerateWindow : Window {
 				/* Render averages of all recorded values */
 				DrawElementTimesColumn(r, STR_FRAMERATE_AVERAGE, this->times_longterm);
 				break;
+			case WID_FRW_TIMES_PEAK:
+				/* Render the longest of all recorded values */
+				DrawElementTimesColumn(r, STR_FRAMERATE_PEAK, this->times_peak);
+				break;
 			case WID_FRW_ALLOCSIZE:
 				DrawElementAllocationsColumn(r);
 				break;
@@ -696,7 +970,8 @@ struct FramerateWindow : Window {
 		switch (widget) {
 			case WID_FRW_TIMES_NAMES:
 			case WID_FRW_TIMES_CURRENT:
-			case WID_FRW_TIMES_AVERAGE: {
+			case WID_FRW_TIMES_AVERAGE:
+			case WID_FRW_TIMES_PEAK: {
 				/* Open time graph windows when clicking detail measurement lines */
 				const Scrollbar *sb = this->GetScrollbar(WID_FRW_SCROLLBAR);
 				int line = sb->GetScrolledRowFromWidget(pt.y, this, widget, WidgetDimensions::scaled.vsep_normal + FONT_HEIGHT_NORMAL);
@@ -1041,22 +1316,6 @@ void ConPrintFramerate()
 
 	IConsolePrintF(TC_SILVER, "Based on num. data points: %d %d %d", count1, count2, count3);
 
-	static const char *MEASUREMENT_NAMES[PFE_MAX] = {
-		"Game loop",
-		"  GL station ticks",
-		"  GL train ticks",
-		"  GL road vehicle ticks",
-		"  GL ship ticks",
-		"  GL aircraft ticks",
-		"  GL landscape ticks",
-		"  GL link graph delays",
-		"Drawing",
-		"  Viewport drawing",
-		"Video output",
-		"Sound mixing",
-		"AI/GS scripts total",
-		"Game script",
-	};
 	char ai_name_buf[128];
 
 	static const PerformanceElement rate_elements[] = { PFE_GAMELOOP, PFE_DRAWING, PFE_VIDEO };
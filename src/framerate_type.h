@@ -29,6 +29,11 @@
  * Either class is used by instantiating an object of it at the beginning of the block to be measured, so it auto-destructs at the end of the block.
  * For PerformanceAccumulator, make sure to also call PerformanceAccumulator::Reset once at the beginning of a new frame. Usually the StateGameLoop function is appropriate for this.
  *
+ * @par Tracing
+ * When a performance trace is being recorded (console command \c fps_trace), every PerformanceMeasurer and PerformanceAccumulator block
+ * is also recorded as a timestamped event, as is every PerformanceTraceScope block. The latter can be used for work outside of the game loop,
+ * such as worker or background threads.
+ *
  * @see framerate_gui.cpp for implementation
  */
 
@@ -53,6 +58,13 @@ enum PerformanceElement {
 	PFE_GL_SHIPS,      ///< Time spent processing ships
 	PFE_GL_AIRCRAFT,   ///< Time spent processing aircraft
 	PFE_GL_LANDSCAPE,  ///< Time spent processing other world features
+	PFE_GL_LS_TILELOOP,   ///< Time spent in the main and auxiliary tile loops
+	PFE_GL_LS_ANIMATION,  ///< Time spent animating tiles
+	PFE_GL_LS_TOWNS,      ///< Time spent processing town ticks
+	PFE_GL_LS_TREES,      ///< Time spent processing tree ticks
+	PFE_GL_LS_STATIONS,   ///< Time spent processing station ticks
+	PFE_GL_LS_INDUSTRIES, ///< Time spent processing industry ticks
+	PFE_GL_LS_COMPANIES,  ///< Time spent processing company ticks
 	PFE_GL_LINKGRAPH,  ///< Time spent waiting for link graph background jobs
 	PFE_DRAWING,       ///< Speed of drawing world and GUI.
 	PFE_DRAWWORLD,     ///< Time spent drawing world viewports in GUI
@@ -120,7 +132,28 @@ public:
 	static void Reset(PerformanceElement elem);
 };
 
+/**
+ * RAII class for recording a named scope in the performance trace.
+ * This does not contribute to any measurement shown in the framerate window, and may be used from any thread.
+ * Nothing is recorded unless tracing is active, see #StartPerformanceTrace.
+ */
+class PerformanceTraceScope {
+	const char *name;
+	TimingMeasurement start_time;
+public:
+	PerformanceTraceScope(const char *name);
+	~PerformanceTraceScope();
+};
+
 void ShowFramerateWindow();
 void ProcessPendingPerformanceMeasurements();
 
+void StartPerformanceTrace(size_t max_events);
+void StopPerformanceTrace();
+void PrintPerformanceTraceStatus();
+bool DumpPerformanceTrace(const char *filename);
+
+void StartPerformanceBenchmark();
+bool WritePerformanceBenchmark(const char *filename, uint ticks);
+
 #endif /* FRAMERATE_TYPE_H */
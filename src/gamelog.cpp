@@ -17,6 +17,7 @@
 #include "date_func.h"
 #include "rev.h"
 #include "3rdparty/cpp-btree/btree_map.h"
+#include "3rdparty/cpp-btree/btree_set.h"
 
 #include <stdarg.h>
 
@@ -94,6 +95,96 @@ void GamelogReset()
 	_current_action  = nullptr;
 }
 
+/**
+ * Compacts the active gamelog by collapsing redundant records, to keep the gamelog of long running games small.
+ *  - Consecutive setting actions are merged into one, with one change from the first old value to the last new value per setting;
+ *    settings which ended up at their old value are dropped.
+ *  - Within consecutive NewGRF actions, repeated parameter changes of the same NewGRF are dropped, unless the NewGRF was added,
+ *    removed or replaced in between.
+ * Revisions, modes, conversions, emergency saves, NewGRF bugs and added, removed, replaced or moved NewGRFs are always kept,
+ * so #GamelogInfo and the other checks of the gamelog give the same results as before.
+ * @return The number of logged changes which were removed.
+ */
+uint GamelogCompact()
+{
+	assert(_gamelog_action_type == GLAT_NONE);
+
+	auto is_setting_action = [](const LoggedAction &la) -> bool {
+		if (la.at != GLAT_SETTING) return false;
+		for (const LoggedChange &lc : la.changes) {
+			if (lc.ct != GLCT_SETTING) return false;
+		}
+		return true;
+	};
+
+	uint removed = 0;
+	std::vector<LoggedAction> compacted;
+	compacted.reserve(_gamelog_actions.size());
+	btree::btree_set<uint32> grf_params; ///< NewGRFs with a parameter change in the current run of NewGRF actions.
+
+	for (LoggedAction &la : _gamelog_actions) {
+		if (la.at != GLAT_GRF) grf_params.clear();
+
+		if (is_setting_action(la) && !compacted.empty() && is_setting_action(compacted.back())) {
+			LoggedAction &prev = compacted.back();
+			for (LoggedChange &lc : la.changes) {
+				auto it = std::find_if(prev.changes.begin(), prev.changes.end(), [&](const LoggedChange &plc) {
+					return strcmp(plc.setting.name, lc.setting.name) == 0;
+				});
+				if (it != prev.changes.end()) {
+					it->setting.newval = lc.setting.newval;
+					free(lc.setting.name);
+					removed++;
+				} else {
+					prev.changes.push_back(lc);
+				}
+			}
+			prev.tick = la.tick;
+			continue;
+		}
+
+		if (la.at == GLAT_GRF) {
+			la.changes.erase(std::remove_if(la.changes.begin(), la.changes.end(), [&](const LoggedChange &lc) {
+				switch (lc.ct) {
+					case GLCT_GRFPARAM:
+						if (!grf_params.insert(lc.grfparam.grfid).second) {
+							removed++;
+							return true;
+						}
+						break;
+
+					case GLCT_GRFADD:    grf_params.erase(lc.grfadd.grfid); break;
+					case GLCT_GRFREM:    grf_params.erase(lc.grfrem.grfid); break;
+					case GLCT_GRFCOMPAT: grf_params.erase(lc.grfcompat.grfid); break;
+
+					default: break;
+				}
+				return false;
+			}), la.changes.end());
+			if (la.changes.empty()) continue;
+		}
+
+		compacted.push_back(std::move(la));
+	}
+
+	/* Drop the settings which were changed back to their old value. */
+	for (LoggedAction &la : compacted) {
+		if (!is_setting_action(la)) continue;
+		la.changes.erase(std::remove_if(la.changes.begin(), la.changes.end(), [&](LoggedChange &lc) {
+			if (lc.setting.oldval != lc.setting.newval) return false;
+			free(lc.setting.name);
+			removed++;
+			return true;
+		}), la.changes.end());
+	}
+	compacted.erase(std::remove_if(compacted.begin(), compacted.end(), [](const LoggedAction &la) { return la.changes.empty(); }), compacted.end());
+
+	_gamelog_actions = std::move(compacted);
+	_current_action = nullptr;
+
+	return removed;
+}
+
 /**
  * Prints GRF ID, checksum and filename if found
  * @param buf The location in the buffer to draw
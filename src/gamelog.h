@@ -34,6 +34,7 @@ void GamelogStopAnyAction();
 
 void GamelogFree(std::vector<LoggedAction> &gamelog_actions);
 void GamelogReset();
+uint GamelogCompact();
 
 /**
  * Callback for printing text.
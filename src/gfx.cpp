@@ -35,6 +35,7 @@
 #include "table/control_codes.h"
 
 #include <atomic>
+#include <tuple>
 
 #include "safeguards.h"
 
@@ -133,6 +134,13 @@ enum GfxDebugFlags {
 };
 uint32 _gfx_debug_flags;
 
+/** Statistics of the screen dirty rectangles, see CoalesceDirtyBlocks. */
+static struct {
+	uint64 batches = 0;     ///< Number of sets of dirty rectangles which were redrawn.
+	uint64 rects_in = 0;    ///< Number of rectangles before coalescing.
+	uint64 rects_drawn = 0; ///< Number of rectangles redrawn after coalescing.
+} _dirty_block_stats;
+
 /**
  * Applies a certain FillRectMode-operation to a rectangle [left, right] x [top, bottom] on the screen.
  *
@@ -1699,6 +1707,75 @@ static void DrawOverlappedWindowWithClipping(Window *w, int left, int top, int r
 	DrawOverlappedWindow(w, std::max(0, left), std::max(0, top), std::min(_screen.width, right), std::min(_screen.height, bottom), flags);
 }
 
+/**
+ * Merge the rectangles in _dirty_blocks which share a complete edge.
+ * AddDirtyBlocks keeps the rectangles free of overlap, but splits them at the edges of the existing ones,
+ * so many moving vehicles leave rows and columns of small adjacent rectangles. As no two rectangles overlap,
+ * the merged rectangles cover exactly the same area, and no pixel is drawn more than once.
+ */
+static void CoalesceDirtyBlocks()
+{
+	_dirty_block_stats.batches++;
+	_dirty_block_stats.rects_in += _dirty_blocks.size();
+
+	bool horizontal = true;
+	for (uint pass = 0, fails = 0; _dirty_blocks.size() > 1 && fails < 2 && pass < 8; pass++, horizontal = !horizontal) {
+		if (horizontal) {
+			std::sort(_dirty_blocks.begin(), _dirty_blocks.end(), [](const Rect &a, const Rect &b) {
+				return std::tie(a.top, a.bottom, a.left) < std::tie(b.top, b.bottom, b.left);
+			});
+		} else {
+			std::sort(_dirty_blocks.begin(), _dirty_blocks.end(), [](const Rect &a, const Rect &b) {
+				return std::tie(a.left, a.right, a.top) < std::tie(b.left, b.right, b.top);
+			});
+		}
+
+		size_t out = 0;
+		for (size_t i = 1; i < _dirty_blocks.size(); i++) {
+			Rect &prev = _dirty_blocks[out];
+			const Rect &cur = _dirty_blocks[i];
+			if (horizontal && prev.top == cur.top && prev.bottom == cur.bottom && prev.right == cur.left) {
+				prev.right = cur.right;
+			} else if (!horizontal && prev.left == cur.left && prev.right == cur.right && prev.bottom == cur.top) {
+				prev.bottom = cur.bottom;
+			} else {
+				_dirty_blocks[++out] = cur;
+			}
+		}
+		out++;
+
+		if (out == _dirty_blocks.size()) {
+			fails++;
+		} else {
+			fails = 0;
+			_dirty_blocks.resize(out);
+		}
+	}
+
+	_dirty_block_stats.rects_drawn += _dirty_blocks.size();
+}
+
+/**
+ * Write the dirty rectangle statistics to a buffer.
+ * @param buffer Buffer to write to.
+ * @param last Last valid character of the buffer.
+ */
+void DumpDirtyBlockStats(char *buffer, const char *last)
+{
+	const uint64 batches = std::max<uint64>(1, _dirty_block_stats.batches);
+	seprintf(buffer, last, "Dirty rects: batches: " OTTD_PRINTF64U ", rects: " OTTD_PRINTF64U " (%.1f avg), after coalescing: " OTTD_PRINTF64U " (%.1f avg)",
+			_dirty_block_stats.batches, _dirty_block_stats.rects_in, (double)_dirty_block_stats.rects_in / batches,
+			_dirty_block_stats.rects_drawn, (double)_dirty_block_stats.rects_drawn / batches);
+}
+
+/**
+ * Reset the dirty rectangle statistics.
+ */
+void ResetDirtyBlockStats()
+{
+	_dirty_block_stats = {};
+}
+
 /**
  * Repaints the rectangle blocks which are marked as 'dirty'.
  *
@@ -1878,6 +1955,7 @@ void DrawDirtyBlocks()
 
 		dpi_backup.Restore();
 
+		CoalesceDirtyBlocks();
 		for (const Rect &r : _dirty_blocks) {
 			RedrawScreenRect(r.left, r.top, r.right, r.bottom);
 		}
@@ -1895,6 +1973,7 @@ void DrawDirtyBlocks()
 			SetDirtyBlocks(r.left, r.top, r.right, r.bottom);
 		}
 		_pending_dirty_blocks.clear();
+		CoalesceDirtyBlocks();
 		for (const Rect &r : _dirty_blocks) {
 			RedrawScreenRect(r.left, r.top, r.right, r.bottom);
 		}
@@ -2054,7 +2133,13 @@ void SetPendingDirtyBlocks(int left, int top, int right, int bottom)
  */
 void MarkWholeScreenDirty()
 {
+	extern void InvalidateSmallMapTileColours();
+
 	_whole_screen_dirty = true;
+	InvalidateSmallMapTileColours();
+
+	/* Settings such as the digit group separator change the texts of viewport signs without updating them. */
+	_viewport_sign_text_generation++;
 }
 
 /**
@@ -35,6 +35,12 @@
 /** Cache of ParagraphLayout lines. */
 Layouter::LineCache *Layouter::linecache;
 
+/** Previous generation of the cache of ParagraphLayout lines. */
+Layouter::LineCache *Layouter::linecache_old;
+
+/** Hit and miss counts of the cache of ParagraphLayout lines. */
+Layouter::LineCacheStats Layouter::linecache_stats;
+
 /** Cache of Font instances. */
 Layouter::FontColourMap Layouter::fonts[FS_END];
 
@@ -345,6 +351,8 @@ void Layouter::ResetFontCache(FontSize size)
 /**
  * Get reference to cache item.
  * If the item does not exist yet, it is default constructed.
+ * Items found in the previous generation of the cache are moved to the current one, so lines which are drawn
+ * regularly survive ReduceLineCache.
  * @param str Source string of the line (including colour and font size codes).
  * @param state State of the font at the beginning of the line.
  * @return Reference to cache item.
@@ -354,14 +362,24 @@ Layouter::LineCacheItem &Layouter::GetCachedParagraphLayout(std::string_view str
 	if (linecache == nullptr) {
 		/* Create linecache on first access to avoid trouble with initialisation order of static variables. */
 		linecache = new LineCache();
+		linecache_old = new LineCache();
 	}
 
 	if (auto match = linecache->find(LineCacheQuery{state, str});
 		match != linecache->end()) {
+		linecache_stats.hits++;
 		return match->second;
 	}
 
+	if (auto match = linecache_old->find(LineCacheQuery{state, str});
+		match != linecache_old->end()) {
+		/* Moving the node keeps the item, and so the layout it owns, at the same address. */
+		linecache_stats.old_hits++;
+		return linecache->insert(linecache_old->extract(match)).position->second;
+	}
+
 	/* Create missing entry */
+	linecache_stats.misses++;
 	LineCacheKey key;
 	key.state_before = state;
 	key.str.assign(str);
@@ -373,16 +391,38 @@ Layouter::LineCacheItem &Layouter::GetCachedParagraphLayout(std::string_view str
  */
 void Layouter::ResetLineCache()
 {
-	if (linecache != nullptr) linecache->clear();
+	if (linecache != nullptr) {
+		linecache->clear();
+		linecache_old->clear();
+	}
+	linecache_stats = {};
 }
 
 /**
  * Reduce the size of linecache if necessary to prevent infinite growth.
+ * When the current generation is full, the previous generation, which only contains the lines which
+ * have not been used since, is discarded and the current generation becomes the previous one.
  */
 void Layouter::ReduceLineCache()
 {
-	if (linecache != nullptr) {
-		/* TODO LRU cache would be fancy, but not exactly necessary */
-		if (linecache->size() > 4096) ResetLineCache();
+	if (linecache != nullptr && linecache->size() > 4096) {
+		linecache_old->clear();
+		std::swap(linecache, linecache_old);
+		linecache_stats.reductions++;
 	}
 }
+
+/**
+ * Write the statistics of the line cache to a buffer.
+ * @param buffer Buffer to write to.
+ * @param last Last valid character of the buffer.
+ */
+void Layouter::DumpLineCacheStats(char *buffer, const char *last)
+{
+	const uint64 lookups = linecache_stats.hits + linecache_stats.old_hits + linecache_stats.misses;
+	buffer += seprintf(buffer, last, "Line cache: entries: %u, previous generation: %u, reductions: " OTTD_PRINTF64U "\n",
+			linecache != nullptr ? (uint)linecache->size() : 0, linecache_old != nullptr ? (uint)linecache_old->size() : 0, linecache_stats.reductions);
+	buffer += seprintf(buffer, last, "  Lookups: " OTTD_PRINTF64U ", hits: " OTTD_PRINTF64U ", previous generation hits: " OTTD_PRINTF64U ", misses: " OTTD_PRINTF64U ", hit rate: %.1f%%\n",
+			lookups, linecache_stats.hits, linecache_stats.old_hits, linecache_stats.misses,
+			lookups > 0 ? (100.0 * (linecache_stats.hits + linecache_stats.old_hits)) / lookups : 0.0);
+}
@@ -170,6 +170,16 @@ public:
 private:
 	typedef std::map<LineCacheKey, LineCacheItem, LineCacheCompare> LineCache;
 	static LineCache *linecache;
+	static LineCache *linecache_old;
+
+	/** Statistics of the linecache since it was last reset. */
+	struct LineCacheStats {
+		uint64 hits = 0;     ///< Lookups found in the current generation.
+		uint64 old_hits = 0; ///< Lookups found in the previous generation, and moved to the current one.
+		uint64 misses = 0;   ///< Lookups which required shaping the line.
+		uint64 reductions = 0; ///< Number of times the previous generation was discarded.
+	};
+	static LineCacheStats linecache_stats;
 
 	static LineCacheItem &GetCachedParagraphLayout(std::string_view str, const FontState &state);
 
@@ -186,6 +196,7 @@ public:
 	static void ResetFontCache(FontSize size);
 	static void ResetLineCache();
 	static void ReduceLineCache();
+	static void DumpLineCacheStats(char *buffer, const char *last);
 };
 
 #endif /* GFX_LAYOUT_H */
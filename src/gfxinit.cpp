@@ -17,6 +17,7 @@
 #include "blitter/factory.hpp"
 #include "video/video_driver.hpp"
 #include "window_func.h"
+#include "viewport_func.h"
 #include "zoom_func.h"
 #include "clear_map.h"
 #include "clear_func.h"
@@ -343,6 +344,9 @@ static bool SwitchNewGRFBlitter()
 	} replacement_blitters[] = {
 		{ "8bpp-optimized",  2,  8,  8,  8,  8 },
 		{ "40bpp-anim",      2,  8, 32,  8, 32 },
+#if defined(WITH_SSE) && defined(WITH_AVX2)
+		{ "32bpp-avx2",      0, 32, 32,  8, 32 },
+#endif
 #ifdef WITH_SSE
 		{ "32bpp-sse4",      0, 32, 32,  8, 32 },
 		{ "32bpp-ssse3",     0, 32, 32,  8, 32 },
@@ -532,6 +536,7 @@ void GfxLoadSprites()
 
 	UpdateRouteStepSpriteSize();
 	UpdateCursorSize();
+	ClearTileSpriteCache();
 
 	DEBUG(sprite, 2, "Completed loading sprite set %d", _settings_game.game_creation.landscape);
 }
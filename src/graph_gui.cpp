@@ -862,6 +862,7 @@ struct ExcludingCargoBaseGraphWindow : BaseGraphWindow {
 
 struct DeliveredCargoGraphWindow : ExcludingCargoBaseGraphWindow {
 	bool graph_by_cargo_mode = false;
+	CompanyMask cargo_mode_excluded_companies = 0; ///< Companies excluded from the totals per cargo, #excluded_data holds the excluded cargoes in cargo mode.
 
 	DeliveredCargoGraphWindow(WindowDesc *desc, WindowNumber window_number) :
 			ExcludingCargoBaseGraphWindow(desc, WID_CV_GRAPH, STR_JUST_COMMA)
@@ -960,12 +961,13 @@ struct DeliveredCargoGraphWindow : ExcludingCargoBaseGraphWindow {
 			mo += 12;
 		}
 
-		if (!initialize && this->excluded_data == excluded_companies && this->num_on_x_axis == nums &&
+		if (!initialize && this->cargo_mode_excluded_companies == excluded_companies && this->num_on_x_axis == nums &&
 				this->year == yr && this->month == mo) {
 			/* There's no reason to get new stats */
 			return;
 		}
 
+		this->cargo_mode_excluded_companies = excluded_companies;
 		this->excluded_data = UINT64_MAX;
 		this->num_on_x_axis = nums;
 		this->year = yr;
@@ -1518,9 +1520,7 @@ struct PerformanceRatingDetailWindow : Window {
 	{
 		/* Update all company stats with the current data
 		 * (this is because _score_info is not saved to a savegame) */
-		for (Company *c : Company::Iterate()) {
-			UpdateCompanyRatingAndValue(c, false);
-		}
+		RecalculateCompanyRatings();
 
 		this->timeout = DAY_TICKS * 5;
 	}
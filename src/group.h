@@ -64,6 +64,24 @@ struct GroupStatistics {
 	static void UpdateAutoreplace(CompanyID company);
 };
 
+/** Statistics on the vehicles in a group and all of its sub-groups. */
+struct GroupHierarchyStatistics {
+	Money profit_last_year_min_age = 0;     ///< Sum of profits for vehicles considered for profit statistics.
+	uint num_vehicle = 0;                   ///< Number of vehicles.
+	uint num_vehicle_min_age = 0;           ///< Number of vehicles considered for profit statistics.
+
+	void Clear()
+	{
+		*this = {};
+	}
+
+	void ClearProfits()
+	{
+		this->num_vehicle_min_age = 0;
+		this->profit_last_year_min_age = 0;
+	}
+};
+
 enum GroupFlags : uint8 {
 	GF_REPLACE_PROTECTION,    ///< If set to true, the global autoreplace has no effect on the group
 	GF_REPLACE_WAGON_REMOVAL, ///< If set, autoreplace will perform wagon removal on vehicles in this group.
@@ -79,6 +97,7 @@ struct Group : GroupPool::PoolItem<&_group_pool> {
 	uint8 flags;                ///< Group flags
 	Livery livery;              ///< Custom colour scheme for vehicles in this group
 	GroupStatistics statistics; ///< NOSAVE: Statistics and caches on the vehicles in the group.
+	GroupHierarchyStatistics hierarchy_statistics; ///< NOSAVE: Statistics on the vehicles in the group and its sub-groups, kept up to date by #GroupStatistics.
 
 	bool folded;                ///< NOSAVE: Is this group folded in the group view?
 
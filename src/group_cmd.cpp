@@ -60,6 +60,36 @@ void GroupStatistics::Clear()
 	this->num_engines = CallocT<uint16>(Engine::GetPoolSize());
 }
 
+/**
+ * Add a change of the vehicle statistics of a group to the hierarchy statistics of the group and all of its ancestors.
+ * @param id_g Group which changed, groups which are not real groups (ALL_GROUP, DEFAULT_GROUP) are ignored.
+ * @param num_vehicle Change of the number of vehicles.
+ * @param num_vehicle_min_age Change of the number of vehicles considered for profit statistics.
+ * @param profit_last_year_min_age Change of the sum of profits for vehicles considered for profit statistics.
+ */
+static void AddGroupHierarchyStatistics(GroupID id_g, int num_vehicle, int num_vehicle_min_age, Money profit_last_year_min_age)
+{
+	for (Group *g = Group::GetIfValid(id_g); g != nullptr; g = Group::GetIfValid(g->parent)) {
+		g->hierarchy_statistics.num_vehicle += num_vehicle;
+		g->hierarchy_statistics.num_vehicle_min_age += num_vehicle_min_age;
+		g->hierarchy_statistics.profit_last_year_min_age += profit_last_year_min_age;
+	}
+}
+
+/**
+ * Change the parent of a group, and move its hierarchy statistics from the old ancestors to the new ones.
+ * @param g Group to change.
+ * @param parent New parent group, or INVALID_GROUP.
+ */
+static void SetGroupParent(Group *g, GroupID parent)
+{
+	const GroupHierarchyStatistics &stats = g->hierarchy_statistics;
+	AddGroupHierarchyStatistics(g->parent, -(int)stats.num_vehicle, -(int)stats.num_vehicle_min_age, -stats.profit_last_year_min_age);
+	g->parent = parent;
+	InvalidateEngineReplacementCache();
+	AddGroupHierarchyStatistics(g->parent, stats.num_vehicle, stats.num_vehicle_min_age, stats.profit_last_year_min_age);
+}
+
 /**
  * Returns the GroupStatistics for a specific group.
  * @param company Owner of the group.
@@ -118,6 +148,7 @@ void GroupStatistics::Clear()
 	/* Recalculate */
 	for (Group *g : Group::Iterate()) {
 		g->statistics.Clear();
+		g->hierarchy_statistics.Clear();
 	}
 
 	for (const Vehicle *v : Vehicle::Iterate()) {
@@ -157,6 +188,9 @@ void GroupStatistics::Clear()
 		stats_all.profit_last_year_min_age += v->GetDisplayProfitLastYear() * delta;
 		stats.num_vehicle_min_age += delta;
 		stats.profit_last_year_min_age += v->GetDisplayProfitLastYear() * delta;
+		AddGroupHierarchyStatistics(v->group_id, delta, delta, v->GetDisplayProfitLastYear() * delta);
+	} else {
+		AddGroupHierarchyStatistics(v->group_id, delta, 0, 0);
 	}
 }
 
@@ -199,6 +233,7 @@ void GroupStatistics::Clear()
 	stats_all.profit_last_year_min_age += v->GetDisplayProfitLastYear();
 	stats.num_vehicle_min_age++;
 	stats.profit_last_year_min_age += v->GetDisplayProfitLastYear();
+	AddGroupHierarchyStatistics(v->group_id, 0, 1, v->GetDisplayProfitLastYear());
 }
 
 /**
@@ -217,6 +252,7 @@ void GroupStatistics::Clear()
 	/* Recalculate */
 	for (Group *g : Group::Iterate()) {
 		g->statistics.ClearProfits();
+		g->hierarchy_statistics.ClearProfits();
 	}
 
 	for (const Vehicle *v : Vehicle::Iterate()) {
@@ -345,6 +381,8 @@ Group::Group(Owner owner)
 {
 	this->owner = owner;
 	this->folded = false;
+	/* Groups are created without deleting the old ones when loading, forget the replacements found for those. */
+	InvalidateEngineReplacementCache();
 }
 
 
@@ -449,6 +487,7 @@ CommandCost CmdDeleteGroup(TileIndex tile, DoCommandFlag flags, uint32 p1, uint3
 		/* Delete the Replace Vehicle Windows */
 		CloseWindowById(WC_REPLACE_VEHICLE, g->vehicle_type);
 		delete g;
+		InvalidateEngineReplacementCache();
 
 		InvalidateWindowData(GetWindowClassForVehicleType(vt), VehicleListIdentifier(VL_GROUP_LIST, vt, _current_company).Pack());
 		InvalidateWindowData(WC_COMPANY_COLOUR, _current_company, vt);
@@ -505,7 +544,7 @@ CommandCost CmdAlterGroup(TileIndex tile, DoCommandFlag flags, uint32 p1, uint32
 		}
 
 		if (flags & DC_EXEC) {
-			g->parent = (pg == nullptr) ? INVALID_GROUP : pg->index;
+			SetGroupParent(g, (pg == nullptr) ? INVALID_GROUP : pg->index);
 			GroupStatistics::UpdateAutoreplace(g->owner);
 			if (g->vehicle_type == VEH_TRAIN) ReindexTemplateReplacementsRecursive();
 
@@ -871,6 +910,7 @@ static void SetGroupFlag(Group *g, GroupFlags flag, bool set, bool children)
 	} else {
 		ClrBit(g->flags, flag);
 	}
+	if (flag == GroupFlags::GF_REPLACE_PROTECTION) InvalidateEngineReplacementCache();
 
 	if (!children) return;
 
@@ -994,11 +1034,9 @@ uint GetGroupNumEngines(CompanyID company, GroupID id_g, EngineID id_e)
  */
 uint GetGroupNumVehicle(CompanyID company, GroupID id_g, VehicleType type)
 {
-	uint count = 0;
-	IterateDescendantsOfGroup(id_g, [&](Group *g) {
-		count += GroupStatistics::Get(company, g->index, type).num_vehicle;
-	});
-	return count + GroupStatistics::Get(company, id_g, type).num_vehicle;
+	const Group *g = Group::GetIfValid(id_g);
+	if (g != nullptr) return g->hierarchy_statistics.num_vehicle;
+	return GroupStatistics::Get(company, id_g, type).num_vehicle;
 }
 
 /**
@@ -1011,11 +1049,9 @@ uint GetGroupNumVehicle(CompanyID company, GroupID id_g, VehicleType type)
  */
 uint GetGroupNumVehicleMinAge(CompanyID company, GroupID id_g, VehicleType type)
 {
-	uint count = 0;
-	IterateDescendantsOfGroup(id_g, [&](Group *g) {
-		count += GroupStatistics::Get(company, g->index, type).num_vehicle_min_age;
-	});
-	return count + GroupStatistics::Get(company, id_g, type).num_vehicle_min_age;
+	const Group *g = Group::GetIfValid(id_g);
+	if (g != nullptr) return g->hierarchy_statistics.num_vehicle_min_age;
+	return GroupStatistics::Get(company, id_g, type).num_vehicle_min_age;
 }
 
 /**
@@ -1028,11 +1064,9 @@ uint GetGroupNumVehicleMinAge(CompanyID company, GroupID id_g, VehicleType type)
  */
 Money GetGroupProfitLastYearMinAge(CompanyID company, GroupID id_g, VehicleType type)
 {
-	Money sum = 0;
-	IterateDescendantsOfGroup(id_g, [&](Group *g) {
-		sum += GroupStatistics::Get(company, g->index, type).profit_last_year_min_age;
-	});
-	return sum + GroupStatistics::Get(company, id_g, type).profit_last_year_min_age;
+	const Group *g = Group::GetIfValid(id_g);
+	if (g != nullptr) return g->hierarchy_statistics.profit_last_year_min_age;
+	return GroupStatistics::Get(company, id_g, type).profit_last_year_min_age;
 }
 
 void RemoveAllGroupsForCompany(const CompanyID company)
@@ -17,6 +17,7 @@
 #include "gfx_func.h"
 #include "fios.h"
 #include "fileio_func.h"
+#include "worker_thread.h"
 
 #include "table/strings.h"
 
@@ -74,12 +75,16 @@ static inline byte RGBToGrayscale(byte red, byte green, byte blue)
 
 /**
  * The PNG Heightmap loader.
+ * Images are decoded one row at a time into \a rows, unless they are interlaced, in which case all rows are decoded at once.
+ * @param map          The grayscale map to fill.
+ * @param png_ptr      The PNG to read, with the transformations already applied to its info.
+ * @param info_ptr     The info of the PNG.
+ * @param rows         Buffer for the decoded rows.
+ * @param row_pointers Buffer for pointers to the rows of an interlaced image.
  */
-static void ReadHeightmapPNGImageData(byte *map, png_structp png_ptr, png_infop info_ptr)
+static void ReadHeightmapPNGImageData(byte *map, png_structp png_ptr, png_infop info_ptr, std::vector<png_byte> &rows, std::vector<png_bytep> &row_pointers)
 {
-	uint x, y;
 	byte gray_palette[256];
-	png_bytep *row_pointers = nullptr;
 	bool has_palette = png_get_color_type(png_ptr, info_ptr) == PNG_COLOR_TYPE_PALETTE;
 	uint channels = png_get_channels(png_ptr, info_ptr);
 
@@ -109,24 +114,40 @@ static void ReadHeightmapPNGImageData(byte *map, png_structp png_ptr, png_infop
 		}
 	}
 
-	row_pointers = png_get_rows(png_ptr, info_ptr);
+	const uint width = png_get_image_width(png_ptr, info_ptr);
+	const uint height = png_get_image_height(png_ptr, info_ptr);
+	const size_t row_bytes = png_get_rowbytes(png_ptr, info_ptr);
+	const bool interlaced = png_get_interlace_type(png_ptr, info_ptr) != PNG_INTERLACE_NONE;
+
+	if (interlaced) {
+		rows.resize(row_bytes * height);
+		row_pointers.resize(height);
+		for (uint y = 0; y < height; y++) row_pointers[y] = rows.data() + y * row_bytes;
+		png_read_image(png_ptr, row_pointers.data());
+	} else {
+		rows.resize(row_bytes);
+	}
 
 	/* Read the raw image data and convert in 8-bit grayscale */
-	for (x = 0; x < png_get_image_width(png_ptr, info_ptr); x++) {
-		for (y = 0; y < png_get_image_height(png_ptr, info_ptr); y++) {
-			byte *pixel = &map[y * png_get_image_width(png_ptr, info_ptr) + x];
+	for (uint y = 0; y < height; y++) {
+		png_bytep row = interlaced ? row_pointers[y] : rows.data();
+		if (!interlaced) png_read_row(png_ptr, row, nullptr);
+
+		byte *pixel = &map[static_cast<size_t>(y) * width];
+		for (uint x = 0; x < width; x++, pixel++) {
 			uint x_offset = x * channels;
 
 			if (has_palette) {
-				*pixel = gray_palette[row_pointers[y][x_offset]];
+				*pixel = gray_palette[row[x_offset]];
 			} else if (channels == 3) {
-				*pixel = RGBToGrayscale(row_pointers[y][x_offset + 0],
-						row_pointers[y][x_offset + 1], row_pointers[y][x_offset + 2]);
+				*pixel = RGBToGrayscale(row[x_offset + 0], row[x_offset + 1], row[x_offset + 2]);
 			} else {
-				*pixel = row_pointers[y][x_offset];
+				*pixel = row[x_offset];
 			}
 		}
 	}
+
+	png_read_end(png_ptr, nullptr);
 }
 
 /**
@@ -139,6 +160,9 @@ static bool ReadHeightmapPNG(const char *filename, uint *x, uint *y, byte **map)
 	FILE *fp;
 	png_structp png_ptr = nullptr;
 	png_infop info_ptr  = nullptr;
+	/* Declared before the setjmp, so they are freed when libpng bails out. */
+	std::vector<png_byte> rows;
+	std::vector<png_bytep> row_pointers;
 
 	fp = FioFOpenFile(filename, "rb", HEIGHTMAP_DIR);
 	if (fp == nullptr) {
@@ -163,10 +187,15 @@ static bool ReadHeightmapPNG(const char *filename, uint *x, uint *y, byte **map)
 
 	png_init_io(png_ptr, fp);
 
-	/* Allocate memory and read image, without alpha or 16-bit samples
-	 * (result is either 8-bit indexed/grayscale or 24-bit RGB) */
+	/* Read the header and set up reading the image without alpha or 16-bit samples
+	 * (result is either 8-bit indexed/grayscale or 24-bit RGB). The image data
+	 * itself is only decoded when the map is wanted. */
+	png_read_info(png_ptr, info_ptr);
 	png_set_packing(png_ptr);
-	png_read_png(png_ptr, info_ptr, PNG_TRANSFORM_PACKING | PNG_TRANSFORM_STRIP_ALPHA | PNG_TRANSFORM_STRIP_16, nullptr);
+	png_set_strip_alpha(png_ptr);
+	png_set_strip_16(png_ptr);
+	if (png_get_interlace_type(png_ptr, info_ptr) != PNG_INTERLACE_NONE) png_set_interlace_handling(png_ptr);
+	png_read_update_info(png_ptr, info_ptr);
 
 	/* Maps of wrong colour-depth are not used.
 	 * (this should have been taken care of by stripping alpha and 16-bit samples on load) */
@@ -189,7 +218,7 @@ static bool ReadHeightmapPNG(const char *filename, uint *x, uint *y, byte **map)
 
 	if (map != nullptr) {
 		*map = MallocT<byte>(static_cast<size_t>(width) * height);
-		ReadHeightmapPNGImageData(*map, png_ptr, info_ptr);
+		ReadHeightmapPNGImageData(*map, png_ptr, info_ptr, rows, row_pointers);
 	}
 
 	*x = width;
@@ -331,11 +360,8 @@ static void GrayscaleToMapHeights(uint img_width, uint img_height, byte *map)
 	static_assert(num_div <= std::numeric_limits<uint>::max() / MAX_HEIGHTMAP_SIDE_LENGTH_IN_PIXELS);
 
 	uint width, height;
-	uint row, col;
 	uint row_pad = 0, col_pad = 0;
 	uint img_scale;
-	uint img_row, img_col;
-	TileIndex tile;
 
 	/* Get map size and calculate scale and padding values */
 	switch (_settings_game.game_creation.heightmap_rotation) {
@@ -365,54 +391,58 @@ static void GrayscaleToMapHeights(uint img_width, uint img_height, byte *map)
 		for (uint y = 0; y < MapSizeY(); y++) MakeVoid(TileXY(0, y));
 	}
 
-	/* Form the landscape */
-	for (row = 0; row < height; row++) {
-		for (col = 0; col < width; col++) {
-			switch (_settings_game.game_creation.heightmap_rotation) {
-				default: NOT_REACHED();
-				case HM_COUNTER_CLOCKWISE: tile = TileXY(col, row); break;
-				case HM_CLOCKWISE:         tile = TileXY(row, col); break;
-			}
-
-			/* Check if current tile is within the 1-pixel map edge or padding regions */
-			if ((!_settings_game.construction.freeform_edges && DistanceFromEdge(tile) <= 1) ||
-					(row < row_pad) || (row >= (height - row_pad - (_settings_game.construction.freeform_edges ? 0 : 1))) ||
-					(col < col_pad) || (col >= (width  - col_pad - (_settings_game.construction.freeform_edges ? 0 : 1)))) {
-				SetTileHeight(tile, 0);
-			} else {
-				/* Use nearest neighbour resizing to scale map data.
-				 *  We rotate the map 45 degrees (counter)clockwise */
-				img_row = (((row - row_pad) * num_div) / img_scale);
+	/* Form the landscape; every map row only touches its own tiles, so the rows are spread over the worker pool. */
+	_general_worker_pool.ParallelFor(height, 64, [&](int row_first, int row_last) {
+		for (uint row = row_first; row < (uint)row_last; row++) {
+			for (uint col = 0; col < width; col++) {
+				TileIndex tile;
 				switch (_settings_game.game_creation.heightmap_rotation) {
 					default: NOT_REACHED();
-					case HM_COUNTER_CLOCKWISE:
-						img_col = (((width - 1 - col - col_pad) * num_div) / img_scale);
-						break;
-					case HM_CLOCKWISE:
-						img_col = (((col - col_pad) * num_div) / img_scale);
-						break;
+					case HM_COUNTER_CLOCKWISE: tile = TileXY(col, row); break;
+					case HM_CLOCKWISE:         tile = TileXY(row, col); break;
 				}
 
-				assert(img_row < img_height);
-				assert(img_col < img_width);
-
-				uint heightmap_height = map[img_row * img_width + img_col];
-
-				if (heightmap_height > 0) {
-					/* 0 is sea level.
-					 * Other grey scales are scaled evenly to the available height levels > 0.
-					 * (The coastline is independent from the number of height levels) */
-					heightmap_height = 1 + (heightmap_height - 1) * _settings_game.game_creation.heightmap_height / 255;
+				/* Check if current tile is within the 1-pixel map edge or padding regions */
+				if ((!_settings_game.construction.freeform_edges && DistanceFromEdge(tile) <= 1) ||
+						(row < row_pad) || (row >= (height - row_pad - (_settings_game.construction.freeform_edges ? 0 : 1))) ||
+						(col < col_pad) || (col >= (width  - col_pad - (_settings_game.construction.freeform_edges ? 0 : 1)))) {
+					SetTileHeight(tile, 0);
+				} else {
+					/* Use nearest neighbour resizing to scale map data.
+					 *  We rotate the map 45 degrees (counter)clockwise */
+					const uint img_row = (((row - row_pad) * num_div) / img_scale);
+					uint img_col;
+					switch (_settings_game.game_creation.heightmap_rotation) {
+						default: NOT_REACHED();
+						case HM_COUNTER_CLOCKWISE:
+							img_col = (((width - 1 - col - col_pad) * num_div) / img_scale);
+							break;
+						case HM_CLOCKWISE:
+							img_col = (((col - col_pad) * num_div) / img_scale);
+							break;
+					}
+
+					assert(img_row < img_height);
+					assert(img_col < img_width);
+
+					uint heightmap_height = map[img_row * img_width + img_col];
+
+					if (heightmap_height > 0) {
+						/* 0 is sea level.
+						 * Other grey scales are scaled evenly to the available height levels > 0.
+						 * (The coastline is independent from the number of height levels) */
+						heightmap_height = 1 + (heightmap_height - 1) * _settings_game.game_creation.heightmap_height / 255;
+					}
+
+					SetTileHeight(tile, heightmap_height);
+				}
+				/* Only clear the tiles within the map area. */
+				if (IsInnerTile(tile)) {
+					MakeClear(tile, CLEAR_GRASS, 3);
 				}
-
-				SetTileHeight(tile, heightmap_height);
-			}
-			/* Only clear the tiles within the map area. */
-			if (IsInnerTile(tile)) {
-				MakeClear(tile, CLEAR_GRASS, 3);
 			}
 		}
-	}
+	});
 }
 
 /**
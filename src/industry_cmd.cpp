@@ -10,6 +10,7 @@
 #include "stdafx.h"
 #include "clear_map.h"
 #include "industry.h"
+#include "industry_kdtree.h"
 #include "station_base.h"
 #include "landscape.h"
 #include "viewport_func.h"
@@ -54,6 +55,17 @@
 IndustryPool _industry_pool("Industry");
 INSTANTIATE_POOL_METHODS(Industry)
 
+IndustryKdtree _industry_kdtree(&Kdtree_IndustryXYFunc);
+
+void RebuildIndustryKdtree()
+{
+	std::vector<IndustryID> industryids;
+	for (const Industry *industry : Industry::Iterate()) {
+		industryids.push_back(industry->index);
+	}
+	_industry_kdtree.Build(industryids.begin(), industryids.end());
+}
+
 void ShowIndustryViewWindow(int industry);
 void BuildOilRig(TileIndex tile);
 
@@ -146,6 +158,8 @@ Industry::~Industry()
 	 * Also we must not decrement industry counts in that case. */
 	if (this->location.w == 0) return;
 
+	_industry_kdtree.Remove(this->index);
+
 	const bool has_neutral_station = this->neutral_station != nullptr;
 
 	for (TileIndex tile_cur : this->location) {
@@ -1739,38 +1753,17 @@ static CommandCost CheckIfFarEnoughFromConflictingIndustry(TileIndex tile, int t
 {
 	const IndustrySpec *indspec = GetIndustrySpec(type);
 
-	/* On a large map with many industries, it may be faster to check an area. */
-	static const int dmax = 14;
-	if (Industry::GetNumItems() > (size_t) (dmax * dmax * 2)) {
-		const Industry* i = nullptr;
-		TileArea tile_area = TileArea(tile, 1, 1).Expand(dmax);
-		for (TileIndex atile : tile_area) {
-			if (GetTileType(atile) == MP_INDUSTRY) {
-				const Industry *i2 = Industry::GetByTile(atile);
-				if (i == i2) continue;
-				i = i2;
-				if (DistanceMax(tile, i->location.tile) > (uint)dmax) continue;
-				if (i->type == indspec->conflicting[0] ||
-						i->type == indspec->conflicting[1] ||
-						i->type == indspec->conflicting[2]) {
-					return_cmd_error(STR_ERROR_INDUSTRY_TOO_CLOSE);
-				}
-			}
-		}
-		return CommandCost();
-	}
-
-	for (const Industry *i : Industry::Iterate()) {
-		/* Within 14 tiles from another industry is considered close */
-		if (DistanceMax(tile, i->location.tile) > 14) continue;
-
+	/* Within 14 tiles from another industry is considered close */
+	bool conflict = false;
+	ForAllIndustriesRadius(tile, 14, [&](const Industry *i) {
 		/* check if there are any conflicting industry types around */
 		if (i->type == indspec->conflicting[0] ||
 				i->type == indspec->conflicting[1] ||
 				i->type == indspec->conflicting[2]) {
-			return_cmd_error(STR_ERROR_INDUSTRY_TOO_CLOSE);
+			conflict = true;
 		}
-	}
+	});
+	if (conflict) return_cmd_error(STR_ERROR_INDUSTRY_TOO_CLOSE);
 	return CommandCost();
 }
 
@@ -1805,6 +1798,7 @@ static void PopulateStationsNearby(Industry *ind)
 		ind->stations_near.insert(ind->neutral_station);
 		ind->neutral_station->industries_near.clear();
 		ind->neutral_station->industries_near.insert(IndustryListEntry{0, ind});
+		ind->neutral_station->InvalidateIndustryAcceptors();
 		return;
 	}
 
@@ -2014,6 +2008,8 @@ static void DoCreateNewIndustry(Industry *i, TileIndex tile, IndustryType type,
 	if (GetIndustrySpec(i->type)->behaviour & INDUSTRYBEH_PLANT_ON_BUILT) {
 		for (uint j = 0; j != 50; j++) PlantRandomFarmField(i);
 	}
+	_industry_kdtree.Insert(i->index);
+
 	InvalidateWindowData(WC_INDUSTRY_DIRECTORY, 0, IDIWD_FORCE_REBUILD);
 	SetWindowDirty(WC_BUILD_INDUSTRY, 0);
 
@@ -244,7 +244,8 @@ static void FixAllReservations()
  */
 bool CheckSharingChangePossible(VehicleType type, bool new_value)
 {
-	if (type != VEH_AIRCRAFT) YapfNotifyTrackLayoutChange(INVALID_TILE, INVALID_TRACK);
+	if (type == VEH_TRAIN) YapfNotifyTrackLayoutChange(INVALID_TILE, INVALID_TRACK);
+	if (type == VEH_ROAD) YapfNotifyRoadLayoutChange();
 	/* Only do something when sharing is being disabled */
 	if (!_settings_game.economy.infrastructure_sharing[type] || new_value) return true;
 
@@ -326,6 +327,7 @@ bool CheckSharingChangePossible(VehicleType type, bool new_value)
 void HandleSharingCompanyDeletion(Owner owner)
 {
 	YapfNotifyTrackLayoutChange(INVALID_TILE, INVALID_TRACK);
+	YapfNotifyRoadLayoutChange();
 
 	Vehicle *si_v = nullptr;
 	SCOPE_INFO_FMT([&si_v], "HandleSharingCompanyDeletion: veh: %s", scope_dumper().VehicleInfo(si_v));
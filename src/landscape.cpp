@@ -22,6 +22,8 @@
 #include "fios.h"
 #include "date_func.h"
 #include "water.h"
+#include "water_map.h"
+#include "newgrf.h"
 #include "effectvehicle_func.h"
 #include "landscape_type.h"
 #include "animated_tile_func.h"
@@ -30,6 +32,8 @@
 #include "company_func.h"
 #include "tunnelbridge_map.h"
 #include "pathfinder/npf/aystar.h"
+#include "pathfinder/water_regions.h"
+#include "pathfinder/yapf/yapf_cache.h"
 #include "sl/saveload.h"
 #include "framerate_type.h"
 #include "town.h"
@@ -37,6 +41,7 @@
 #include "scope_info.h"
 #include "core/ring_buffer.hpp"
 #include "network/network_sync.h"
+#include "worker_thread.h"
 #include <array>
 #include <list>
 #include <set>
@@ -483,11 +488,15 @@ void DrawFoundation(TileInfo *ti, Foundation f)
 
 void DoClearSquare(TileIndex tile)
 {
+	if (MayHaveRoad(tile)) YapfNotifyRoadLayoutChange();
+
 	/* If the tile can have animation and we clear it, delete it from the animated tile list. */
 	if (_tile_type_procs[GetTileType(tile)]->animate_tile_proc != nullptr) DeleteAnimatedTile(tile);
 
 	MakeClear(tile, CLEAR_GRASS, _generating_world ? 3 : 0);
 	MarkTileDirtyByTile(tile);
+
+	InvalidateWaterRegion(tile);
 }
 
 /**
@@ -761,6 +770,7 @@ void RunTileLoop(bool apply_day_length)
 	}
 
 	PerformanceAccumulator framerate(PFE_GL_LANDSCAPE);
+	PerformanceAccumulator framerate_tileloop(PFE_GL_LS_TILELOOP);
 
 	const uint32 feedback = GetTileLoopFeedback();
 
@@ -776,6 +786,12 @@ void RunTileLoop(bool apply_day_length)
 		count--;
 	}
 
+	/* The tile loop of water tiles which cannot flood only plays ambient sounds, which also uses the random generator.
+	 * When no NewGRF plays ambient sounds, such tiles can be skipped without calling the tile loop proc.
+	 * At day lengths > 4, flooding is handled by the auxiliary tile loop, so this holds for all water tiles. */
+	const bool skip_inert_water = !HasGrfMiscBit(GMB_AMBIENT_SOUND_CALLBACK);
+	const bool flooding_in_aux_loop = _settings_game.economy.day_length_factor > 4 && _game_mode != GM_EDITOR;
+
 	while (count--) {
 		/* Get the next tile in sequence using a Galois LFSR. */
 		TileIndex next = (tile >> 1) ^ (-(int32)(tile & 1) & feedback);
@@ -783,7 +799,10 @@ void RunTileLoop(bool apply_day_length)
 			PREFETCH_NTA(&_m[next]);
 		}
 
-		_tile_type_procs[GetTileType(tile)]->tile_loop_proc(tile);
+		const TileType type = GetTileType(tile);
+		if (!(skip_inert_water && type == MP_WATER && (flooding_in_aux_loop || IsNonFloodingWaterTile(tile)))) {
+			_tile_type_procs[type]->tile_loop_proc(tile);
+		}
 
 		tile = next;
 	}
@@ -798,6 +817,7 @@ void RunAuxiliaryTileLoop()
 	if (_settings_game.economy.day_length_factor <= 4 || (_scaled_tick_counter % 4) != 0) return;
 
 	PerformanceAccumulator framerate(PFE_GL_LANDSCAPE);
+	PerformanceAccumulator framerate_tileloop(PFE_GL_LS_TILELOOP);
 
 	const uint32 feedback = GetTileLoopFeedback();
 	uint count = 1 << (MapLogX() + MapLogY() - 8);
@@ -1032,6 +1052,72 @@ static void CreateDesertOrRainForest(uint desert_tropic_line)
 	}
 }
 
+static const int RIVER_HILL_TOP_RADIUS = 16; ///< Distance within which no tile may be much higher than a spring, when rivers start near the top of hills.
+static std::vector<uint8> _river_hill_max_height; ///< During river generation, the highest #GetTileMaxZ within #RIVER_HILL_TOP_RADIUS of each tile.
+
+/**
+ * Replace each of the values of a line by the maximum of the values within \a radius of it.
+ * Values beyond the ends of the line count as 0. This uses the van Herk/Gil-Werman algorithm,
+ * so the cost per value does not depend on the radius.
+ * @param line First value of the line.
+ * @param count Number of values in the line.
+ * @param stride Distance between two values of the line.
+ * @param radius Radius of the window.
+ * @param buffer Scratch space, reused between calls.
+ */
+static void LineSlidingMaximum(uint8 *line, int count, int stride, int radius, std::vector<uint8> &buffer)
+{
+	const int width = 2 * radius + 1;
+	const int padded = count + 2 * radius;
+	buffer.assign(3 * padded, 0);
+	uint8 *values = buffer.data();
+	uint8 *prefix = values + padded;
+	uint8 *suffix = prefix + padded;
+
+	for (int i = 0; i < count; i++) values[radius + i] = line[i * stride];
+
+	/* Maximum from the start of the block of width values to each value, and from each value to the end of its block. */
+	for (int j = 0; j < padded; j++) {
+		prefix[j] = (j % width == 0) ? values[j] : std::max(prefix[j - 1], values[j]);
+	}
+	for (int j = padded - 1; j >= 0; j--) {
+		suffix[j] = (j % width == width - 1 || j == padded - 1) ? values[j] : std::max(suffix[j + 1], values[j]);
+	}
+
+	/* A window spans at most two blocks. */
+	for (int i = 0; i < count; i++) line[i * stride] = std::max(suffix[i], prefix[i + width - 1]);
+}
+
+/**
+ * Fill #_river_hill_max_height from the current heights of the map.
+ * Tiles which the hill top check of #FindSpring would skip count as 0, so a tile is
+ * near the top of a hill iff its value is not more than 2 above its height.
+ */
+static void ComputeRiverHillMaxHeights()
+{
+	const int size_x = MapSizeX();
+	const int size_y = MapSizeY();
+	_river_hill_max_height.resize(MapSize());
+
+	/* Rows and columns are independent of each other, so each pass can be spread over the worker pool. */
+	_general_worker_pool.ParallelFor(size_y, 64, [&](int y_first, int y_last) {
+		std::vector<uint8> buffer;
+		for (int y = y_first; y < y_last; y++) {
+			for (int x = 0; x < size_x; x++) {
+				const TileIndex t = TileXY(x, y);
+				_river_hill_max_height[t] = (TileAddWrap(t, 0, 0) != INVALID_TILE) ? GetTileMaxZ(t) : 0;
+			}
+			LineSlidingMaximum(&_river_hill_max_height[TileXY(0, y)], size_x, 1, RIVER_HILL_TOP_RADIUS, buffer);
+		}
+	});
+	_general_worker_pool.ParallelFor(size_x, 64, [&](int x_first, int x_last) {
+		std::vector<uint8> buffer;
+		for (int x = x_first; x < x_last; x++) {
+			LineSlidingMaximum(&_river_hill_max_height[TileXY(x, 0)], size_y, size_x, RIVER_HILL_TOP_RADIUS, buffer);
+		}
+	});
+}
+
 /**
  * Find the spring of a river.
  * @param tile The tile to consider for being the spring.
@@ -1058,12 +1144,7 @@ static bool FindSpring(TileIndex tile, void *)
 
 	if (_settings_game.game_creation.rivers_top_of_hill) {
 		/* Are we near the top of a hill? */
-		for (int dx = -16; dx <= 16; dx++) {
-			for (int dy = -16; dy <= 16; dy++) {
-				TileIndex t = TileAddWrap(tile, dx, dy);
-				if (t != INVALID_TILE && GetTileMaxZ(t) > referenceHeight + 2) return false;
-			}
-		}
+		if (_river_hill_max_height[tile] > referenceHeight + 2) return false;
 	}
 
 	return true;
@@ -1371,6 +1452,9 @@ static void CreateRivers()
 	const uint num_short_rivers = wells - std::max(1u, wells / 10);
 	SetGeneratingWorldProgress(GWP_RIVER, wells + 256 / 64); // Include the tile loop calls below.
 
+	/* Building rivers and lakes does not change any heights, so the hill tops only have to be found once. */
+	if (_settings_game.game_creation.rivers_top_of_hill) ComputeRiverHillMaxHeights();
+
 	for (; wells > num_short_rivers; wells--) {
 		IncreaseGeneratingWorldProgress(GWP_RIVER);
 		for (int tries = 0; tries < 128; tries++) {
@@ -1393,6 +1477,9 @@ static void CreateRivers()
 		}
 	}
 
+	_river_hill_max_height.clear();
+	_river_hill_max_height.shrink_to_fit();
+
 	/* Widening rivers may have left some tiles requiring to be watered. */
 	ConvertGroundTilesIntoWaterTiles();
 
@@ -1632,13 +1719,25 @@ void CallLandscapeTick()
 	{
 		PerformanceAccumulator framerate(PFE_GL_LANDSCAPE);
 
-		OnTick_Town();
+		{
+			PerformanceAccumulator framerate_sub(PFE_GL_LS_TOWNS);
+			OnTick_Town();
+		}
 		RecordSyncEvent(NSRE_TOWN);
-		OnTick_Trees();
+		{
+			PerformanceAccumulator framerate_sub(PFE_GL_LS_TREES);
+			OnTick_Trees();
+		}
 		RecordSyncEvent(NSRE_TREE);
-		OnTick_Station();
+		{
+			PerformanceAccumulator framerate_sub(PFE_GL_LS_STATIONS);
+			OnTick_Station();
+		}
 		RecordSyncEvent(NSRE_STATION);
-		OnTick_Industry();
+		{
+			PerformanceAccumulator framerate_sub(PFE_GL_LS_INDUSTRIES);
+			OnTick_Industry();
+		}
 		RecordSyncEvent(NSRE_INDUSTRY);
 	}
 
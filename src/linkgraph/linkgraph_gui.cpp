@@ -115,6 +115,7 @@ void LinkGraphOverlay::RebuildCache(bool incremental)
 		this->dirty = false;
 		this->cached_links.clear();
 		this->cached_stations.clear();
+		this->virtual_station_middles.clear();
 		this->last_update_number = GetWindowUpdateNumber();
 	}
 	if (this->company_mask == 0) return;
@@ -612,7 +613,14 @@ bool LinkGraphOverlay::ShowTooltip(Point pt, TooltipCloseCondition close_cond)
 Point LinkGraphOverlay::GetStationMiddle(const Station *st) const
 {
 	if (this->window->viewport != nullptr) {
-		return GetViewportStationMiddle(this->window->viewport, st);
+		/* Determining the height of the station is relatively expensive, and the draw cache is refreshed every frame,
+		 * so only convert the cached virtual coordinates to the current scroll position and zoom level. */
+		VirtualStationMiddle &middle = this->virtual_station_middles[st->index];
+		if (middle.xy != st->xy) {
+			middle.xy = st->xy;
+			middle.pt = GetViewportStationVirtualMiddle(st);
+		}
+		return ViewportVirtualToScreen(this->window->viewport, middle.pt);
 	} else {
 		/* assume this is a smallmap */
 		return static_cast<const SmallMapWindow *>(this->window)->GetStationMiddle(st);
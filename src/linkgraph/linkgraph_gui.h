@@ -15,6 +15,7 @@
 #include "../widget_type.h"
 #include "../window_gui.h"
 #include "linkgraph_base.h"
+#include "../3rdparty/cpp-btree/btree_map.h"
 #include <map>
 #include <vector>
 
@@ -104,6 +105,13 @@ protected:
 	bool dirty;                        ///< Set if overlay should be rebuilt.
 	uint64 last_update_number = 0;     ///< Last window update number
 
+	/** Middle of a station in virtual viewport coordinates, which do not change on scrolling or zooming. */
+	struct VirtualStationMiddle {
+		TileIndex xy = INVALID_TILE; ///< Location of the station the middle was determined for.
+		Point pt;                    ///< Middle of the station in virtual viewport coordinates.
+	};
+	mutable btree::btree_map<StationID, VirtualStationMiddle> virtual_station_middles; ///< Cache of the station middles, for viewports only.
+
 	Point GetStationMiddle(const Station *st) const;
 
 	void RefreshDrawCache();
@@ -100,6 +100,9 @@ void LinkGraphJob::FinaliseJob()
 	/* Link graph has been merged into another one. */
 	if (!LinkGraph::IsValidID(this->link_graph.index)) return;
 
+	/* Cargo to reroute at the current station, as (next hop to avoid, source station) */
+	std::vector<std::pair<StationID, StationID>> reroutes;
+	std::vector<StationID> reroute_sources;
 	uint16 size = this->Size();
 	for (NodeID node_id = 0; node_id < size; ++node_id) {
 		Node from = (*this)[node_id];
@@ -146,7 +149,10 @@ void LinkGraphJob::FinaliseJob()
 		/* Swap shares and invalidate ones that are completely deleted. Don't
 		 * really delete them as we could then end up with unroutable cargo
 		 * somewhere. Do delete them and also reroute relevant cargo if
-		 * automatic distribution has been turned off for that cargo. */
+		 * automatic distribution has been turned off for that cargo.
+		 * Cargo from deleted flows is rerouted once all flows have been handled,
+		 * so that the cargo waiting for each next hop is only walked once. */
+		reroutes.clear();
 		for (FlowStatMap::iterator it(geflows.begin()); it != geflows.end();) {
 			FlowStatMap::iterator new_it = flows.find(it->GetOrigin());
 			if (new_it == flows.end()) {
@@ -158,7 +164,7 @@ void LinkGraphJob::FinaliseJob()
 						it = geflows.erase(it);
 						for (FlowStat::const_iterator shares_it(shares.begin());
 								shares_it != shares.end(); ++shares_it) {
-							RerouteCargoFromSource(st, this->Cargo(), origin, shares_it->second, st->index);
+							reroutes.emplace_back(shares_it->second, origin);
 						}
 					} else {
 						++it;
@@ -178,6 +184,18 @@ void LinkGraphJob::FinaliseJob()
 				++it;
 			}
 		}
+		if (!reroutes.empty()) {
+			/* Group by next hop to avoid, then reroute all cargo from the sources of each group at once. */
+			std::sort(reroutes.begin(), reroutes.end());
+			reroutes.erase(std::unique(reroutes.begin(), reroutes.end()), reroutes.end());
+			for (auto group = reroutes.begin(); group != reroutes.end();) {
+				auto group_end = std::find_if(group, reroutes.end(), [&](const auto &r) { return r.first != group->first; });
+				reroute_sources.clear();
+				for (auto r = group; r != group_end; ++r) reroute_sources.push_back(r->second);
+				RerouteCargoFromSources(st, this->Cargo(), reroute_sources, group->first, st->index);
+				group = group_end;
+			}
+		}
 		for (FlowStatMap::iterator it(flows.begin()); it != flows.end(); ++it) {
 			geflows.insert(std::move(*it));
 		}
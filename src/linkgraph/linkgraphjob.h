@@ -13,6 +13,7 @@
 #include "../thread.h"
 #include "../core/dyn_arena_alloc.hpp"
 #include "linkgraph.h"
+#include <algorithm>
 #include <vector>
 #include <memory>
 #include <atomic>
@@ -145,6 +146,8 @@ protected:
 	EdgeAnnotationVector edges;       ///< Edge data necessary for link graph calculation.
 	std::atomic<bool> job_completed;  ///< Is the job still running. This is accessed by multiple threads and reads may be stale.
 	std::atomic<bool> job_aborted;    ///< Has the job been aborted. This is accessed by multiple threads and reads may be stale.
+	uint64 estimated_runtime_us = 0;  ///< Wall time of the calculation estimated by the schedule's runtime model when the job was started, in microseconds.
+	uint64 runtime_us = 0;            ///< Measured wall time of the calculation, in microseconds. Only valid once the job is completed.
 
 	void EraseFlows(NodeID from);
 	void JoinThread();
@@ -241,11 +244,16 @@ public:
 			this->node_anno.demands = demands;
 		}
 
+		/**
+		 * Get the edge to a node, the edges of a node are sorted by their target node.
+		 * @param to Target node.
+		 * @return The edge, or an empty edge if there is no edge to \a to.
+		 */
 		Edge &GetEdgeTo(NodeID to)
 		{
-			for (Edge &edge : this->node_anno.edges) {
-				if (edge.To() == to) return edge;
-			}
+			span<Edge> edges = this->node_anno.edges;
+			auto it = std::lower_bound(edges.begin(), edges.end(), to, [](const Edge &edge, NodeID to) { return edge.To() < to; });
+			if (it != edges.end() && it->To() == to) return *it;
 
 			static Edge empty_edge = {};
 			return empty_edge;
@@ -277,6 +285,19 @@ public:
 	 */
 	inline bool IsJobCompleted() const { return this->job_completed.load(std::memory_order_acquire); }
 
+	/**
+	 * Get the wall time of the calculation, as estimated when the job was started.
+	 * @return Estimated runtime in microseconds.
+	 */
+	inline uint64 EstimatedRuntime() const { return this->estimated_runtime_us; }
+
+	/**
+	 * Get the measured wall time of the calculation.
+	 * This is only valid if IsJobCompleted() returns true.
+	 * @return Runtime in microseconds.
+	 */
+	inline uint64 Runtime() const { return this->runtime_us; }
+
 	/**
 	 * Check if job has been aborted.
 	 * This is allowed to spuriously return false incorrectly, but is not allowed to incorrectly return true.
@@ -16,7 +16,10 @@
 #include "../framerate_type.h"
 #include "../command_func.h"
 #include "../network/network.h"
+#include "../console_func.h"
 #include <algorithm>
+#include <chrono>
+#include <thread>
 
 #include "../safeguards.h"
 
@@ -125,6 +128,29 @@ bool LinkGraphSchedule::IsJoinWithUnfinishedJobDue() const
 	return false;
 }
 
+/**
+ * Postpone the join of all running jobs which are due to be joined by a given date.
+ * @param join_date Jobs with a join date up to and including this date are postponed.
+ * @param delay Number of ticks to postpone the join by.
+ */
+void LinkGraphSchedule::PostponeJoins(DateTicks join_date, DateTicks delay)
+{
+	bool changed = false;
+	for (auto &job : this->running) {
+		if (job->join_date_ticks > join_date) break;
+		DEBUG(linkgraph, 2, "LinkGraphSchedule::PostponeJoins(): Postponing join of job: id: %u, by %d ticks", job->index, delay);
+		job->join_date_ticks += delay;
+		changed = true;
+	}
+
+	/* Keep the running jobs ordered by join date, the sort is stable so the order of jobs with the same join date is kept */
+	if (changed) {
+		this->running.sort([](const std::unique_ptr<LinkGraphJob> &a, const std::unique_ptr<LinkGraphJob> &b) {
+			return a->JoinDateTicks() < b->JoinDateTicks();
+		});
+	}
+}
+
 /**
  * Join the next finished job, if available.
  */
@@ -137,6 +163,9 @@ void LinkGraphSchedule::JoinNext()
 		LinkGraphID id = next->LinkGraphIndex();
 		next->FinaliseJob(); // joins the thread and finalises the job
 		assert(!next->IsJobAborted());
+		RecordLinkGraphJobRuntime(next->Cargo(), next->Graph().CalculateCostEstimate(), next->Runtime());
+		DEBUG(linkgraph, 3, "LinkGraphSchedule::JoinNext(): Joined job: id: %u, nodes: %u, estimated runtime: " OTTD_PRINTF64U " us, actual runtime: " OTTD_PRINTF64U " us",
+				id, next->Graph().Size(), next->EstimatedRuntime(), next->Runtime());
 		next.reset();
 		if (LinkGraph::IsValidID(id)) {
 			LinkGraph *lg = LinkGraph::Get(id);
@@ -152,11 +181,16 @@ void LinkGraphSchedule::JoinNext()
  */
 /* static */ void LinkGraphSchedule::Run(LinkGraphJob *job)
 {
+	PerformanceTraceScope trace("Link graph job");
+	const auto start = std::chrono::steady_clock::now();
+
 	for (uint i = 0; i < lengthof(instance.handlers); ++i) {
 		if (job->IsJobAborted()) return;
 		instance.handlers[i]->Run(*job);
 	}
 
+	job->runtime_us = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+
 	/*
 	 * Readers of this variable in another thread may see an out of date value.
 	 * However this is OK as this will only happen just as a job is completing,
@@ -259,6 +293,19 @@ void LinkGraphJobGroup::JoinThread()
 	}
 }
 
+/** Minimum estimated work for a group of link graph jobs to get a thread of its own, in microseconds. */
+static const uint64 LINK_GRAPH_MIN_THREAD_WORK_US = 2000;
+
+/**
+ * Get the number of threads link graph jobs can be spread over.
+ * @return Number of hardware threads, leaving one for the main thread if possible.
+ */
+static uint GetLinkGraphThreadCount()
+{
+	uint threads = std::thread::hardware_concurrency();
+	return std::max<uint>(1, threads > 1 ? threads - 1 : threads);
+}
+
 /**
  * Run all jobs for the given LinkGraphJobGroup. This method is tailored to
  * ThreadObject::New.
@@ -273,36 +320,117 @@ void LinkGraphJobGroup::JoinThread()
 }
 
 /* static */ void LinkGraphJobGroup::ExecuteJobSet(std::vector<JobInfo> jobs) {
-	const uint thread_budget = 200000;
-
 	std::sort(jobs.begin(), jobs.end(), [](const JobInfo &a, const JobInfo &b) {
 		return std::make_pair(a.job->JoinDateTicks(), a.cost_estimate) < std::make_pair(b.job->JoinDateTicks(), b.cost_estimate);
 	});
 
+	/* Jobs with the same join date are grouped onto threads until a group has at least the minimum amount of work for a thread,
+	 * or until the work of the jobs with that date is evenly split over the available threads, if that is more. */
+	std::vector<uint64> join_date_runtimes;
+	for (size_t i = 0; i < jobs.size(); i++) {
+		if (i == 0 || jobs[i].job->JoinDateTicks() != jobs[i - 1].job->JoinDateTicks()) join_date_runtimes.push_back(0);
+		join_date_runtimes.back() += jobs[i].runtime_estimate;
+	}
+	const uint threads = GetLinkGraphThreadCount();
+
 	std::vector<LinkGraphJob *> bucket;
 	uint bucket_cost = 0;
+	uint64 bucket_runtime = 0;
+	uint64 thread_budget = 0;
+	size_t join_date_index = 0;
 	DateTicks bucket_join_date = 0;
 	auto flush_bucket = [&]() {
-		if (!bucket_cost) return;
-		DEBUG(linkgraph, 2, "LinkGraphJobGroup::ExecuteJobSet: Creating Job Group: jobs: " PRINTF_SIZE ", cost: %u, join after: %d",
-				bucket.size(), bucket_cost, bucket_join_date - ((_date * DAY_TICKS) + _date_fract));
+		if (bucket.empty()) return;
+		DEBUG(linkgraph, 2, "LinkGraphJobGroup::ExecuteJobSet: Creating Job Group: jobs: " PRINTF_SIZE ", cost: %u, estimated runtime: " OTTD_PRINTF64U " us, join after: %d",
+				bucket.size(), bucket_cost, bucket_runtime, bucket_join_date - ((_date * DAY_TICKS) + _date_fract));
 		auto group = std::make_shared<LinkGraphJobGroup>(constructor_token(), std::move(bucket));
 		group->SpawnThread();
 		bucket_cost = 0;
+		bucket_runtime = 0;
 		bucket.clear();
 	};
 
-	for (JobInfo &it : jobs) {
-		if (bucket_cost && (bucket_join_date != it.job->JoinDateTicks() || (bucket_cost + it.cost_estimate > thread_budget))) flush_bucket();
+	for (size_t i = 0; i < jobs.size(); i++) {
+		const JobInfo &it = jobs[i];
+		if (i == 0 || bucket_join_date != it.job->JoinDateTicks()) {
+			flush_bucket();
+			if (i != 0) join_date_index++;
+			thread_budget = std::max<uint64>(LINK_GRAPH_MIN_THREAD_WORK_US, CeilDivT<uint64>(join_date_runtimes[join_date_index], threads));
+		} else if (bucket_runtime + it.runtime_estimate > thread_budget) {
+			flush_bucket();
+		}
 		bucket_join_date = it.job->JoinDateTicks();
 		bucket.push_back(it.job);
 		bucket_cost += it.cost_estimate;
+		bucket_runtime += it.runtime_estimate;
 	}
 	flush_bucket();
 }
 
 LinkGraphJobGroup::JobInfo::JobInfo(LinkGraphJob *job) :
-		job(job), cost_estimate(job->Graph().CalculateCostEstimate()) { }
+		JobInfo(job, job->Graph().CalculateCostEstimate()) { }
+
+LinkGraphJobGroup::JobInfo::JobInfo(LinkGraphJob *job, uint cost_estimate) :
+		job(job), cost_estimate(cost_estimate), runtime_estimate(EstimateLinkGraphJobRuntime(job->Cargo(), cost_estimate))
+{
+	job->estimated_runtime_us = this->runtime_estimate;
+}
+
+/**
+ * Runtime model of link graph jobs.
+ * For each cargo this tracks the measured wall time per unit of LinkGraph::CalculateCostEstimate(), as a moving average over recent jobs.
+ * This only affects how jobs are grouped onto threads, never the results of the jobs.
+ */
+static struct LinkGraphRuntimeModel {
+	static constexpr double DEFAULT_US_PER_COST = 0.01; ///< Used until a job of the cargo has been measured
+	static const uint MAX_AVERAGE_SAMPLES = 16;         ///< Number of samples over which the moving average is taken
+
+	double us_per_cost[NUM_CARGO] = {}; ///< Measured wall time per unit cost, in microseconds
+	uint samples[NUM_CARGO] = {};       ///< Number of jobs measured
+} _link_graph_runtime_model;
+
+/**
+ * Estimate the wall time of a link graph job.
+ * @param cargo Cargo of the link graph.
+ * @param cost Cost estimate of the link graph.
+ * @return Estimated runtime in microseconds.
+ */
+uint64 EstimateLinkGraphJobRuntime(CargoID cargo, uint64 cost)
+{
+	const LinkGraphRuntimeModel &model = _link_graph_runtime_model;
+	double us_per_cost = model.samples[cargo] > 0 ? model.us_per_cost[cargo] : LinkGraphRuntimeModel::DEFAULT_US_PER_COST;
+	return (uint64)(cost * us_per_cost);
+}
+
+/**
+ * Record the measured wall time of a completed link graph job in the runtime model.
+ * @param cargo Cargo of the link graph.
+ * @param cost Cost estimate of the link graph.
+ * @param runtime_us Measured runtime in microseconds.
+ */
+void RecordLinkGraphJobRuntime(CargoID cargo, uint64 cost, uint64 runtime_us)
+{
+	if (cost == 0) return;
+
+	LinkGraphRuntimeModel &model = _link_graph_runtime_model;
+	double us_per_cost = (double)runtime_us / cost;
+	uint samples = std::min<uint>(model.samples[cargo] + 1, LinkGraphRuntimeModel::MAX_AVERAGE_SAMPLES);
+	model.us_per_cost[cargo] += (us_per_cost - model.us_per_cost[cargo]) / samples;
+	model.samples[cargo]++;
+}
+
+/**
+ * Print the runtime model to the console.
+ */
+void PrintLinkGraphRuntimeModel()
+{
+	const LinkGraphRuntimeModel &model = _link_graph_runtime_model;
+	IConsolePrintF(CC_DEFAULT, "Link graph runtime model, threads: %u, minimum thread work: " OTTD_PRINTF64U " us", GetLinkGraphThreadCount(), LINK_GRAPH_MIN_THREAD_WORK_US);
+	for (CargoID c = 0; c < NUM_CARGO; c++) {
+		if (model.samples[c] == 0) continue;
+		IConsolePrintF(CC_DEFAULT, "  Cargo: %2u, jobs measured: %u, ns per 1000 cost units: %u", c, model.samples[c], (uint)(model.us_per_cost[c] * 1000000));
+	}
+}
 
 /**
  * Pause the game if in 2 _date_fract ticks, we would do a join with the next
@@ -313,6 +441,22 @@ LinkGraphJobGroup::JobInfo::JobInfo(LinkGraphJob *job) :
  */
 void StateGameLoop_LinkGraphPauseControl()
 {
+	if (_settings_game.linkgraph.recalc_late_delay != 0 && !(_pause_mode & PM_PAUSED_LINK_GRAPH)) {
+		/* Postpone the join of late jobs instead of pausing.
+		 * Joins can be at any tick once postponed, so this is checked every tick. */
+		static DateTicks last_postponed_until = INVALID_DATE;
+		if (_pause_mode != PM_UNPAUSED) return;
+
+		const DateTicks now = (_date * DAY_TICKS) + _date_fract;
+		/* Don't request again while the previous request may still be pending */
+		if (last_postponed_until != INVALID_DATE && now <= last_postponed_until && now >= last_postponed_until - 2) return;
+		if (LinkGraphSchedule::instance.IsJoinWithUnfinishedJobDue()) {
+			last_postponed_until = now + 2;
+			DoCommandP(0, (uint32)last_postponed_until, 0, CMD_POSTPONE_LINK_GRAPH_JOIN);
+		}
+		return;
+	}
+
 	if (_pause_mode & PM_PAUSED_LINK_GRAPH) {
 		/* We are paused waiting on a job, check the job every tick */
 		if (!LinkGraphSchedule::instance.IsJoinWithUnfinishedJobDue()) {
@@ -335,6 +479,28 @@ void StateGameLoop_LinkGraphPauseControl()
 	}
 }
 
+/**
+ * Postpone the join of late link graph jobs by the link graph late join delay setting.
+ * This is issued by the server, so that all clients postpone the same jobs at the same tick.
+ * @param tile unused
+ * @param flags operation to perform
+ * @param p1 jobs with a join date (in date ticks) up to and including this are postponed
+ * @param p2 unused
+ * @param text unused
+ * @return the cost of this operation or an error
+ */
+CommandCost CmdPostponeLinkGraphJoin(TileIndex tile, DoCommandFlag flags, uint32 p1, uint32 p2, const char *text)
+{
+	if (_settings_game.linkgraph.recalc_late_delay == 0) return CMD_ERROR;
+
+	if (flags & DC_EXEC) {
+		DateTicks delay = (_settings_game.linkgraph.recalc_late_delay * DAY_TICKS) / (SECONDS_PER_DAY * _settings_game.economy.day_length_factor);
+		LinkGraphSchedule::instance.PostponeJoins((DateTicks)p1, std::max<DateTicks>(delay, 1));
+	}
+
+	return CommandCost();
+}
+
 /**
  * Pause the game on load if we would do a join with the next link graph job,
  * but it is still running, and it would not be caught by a call to
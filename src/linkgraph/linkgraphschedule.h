@@ -64,6 +64,7 @@ public:
 
 	void SpawnNext();
 	bool IsJoinWithUnfinishedJobDue() const;
+	void PostponeJoins(DateTicks join_date, DateTicks delay);
 	void JoinNext();
 	void SpawnAll();
 	void ShiftDates(int interval);
@@ -104,15 +105,19 @@ public:
 	struct JobInfo {
 		LinkGraphJob * job;
 		uint cost_estimate;
+		uint64 runtime_estimate; ///< Estimated runtime in microseconds, from the runtime model
 
 		JobInfo(LinkGraphJob *job);
-		JobInfo(LinkGraphJob *job, uint cost_estimate) :
-				job(job), cost_estimate(cost_estimate) { }
+		JobInfo(LinkGraphJob *job, uint cost_estimate);
 	};
 
 	static void ExecuteJobSet(std::vector<JobInfo> jobs);
 };
 
+uint64 EstimateLinkGraphJobRuntime(CargoID cargo, uint64 cost);
+void RecordLinkGraphJobRuntime(CargoID cargo, uint64 cost, uint64 runtime_us);
+void PrintLinkGraphRuntimeModel();
+
 void StateGameLoop_LinkGraphPauseControl();
 void AfterLoad_LinkGraphPauseControl();
 
@@ -123,7 +123,7 @@ public:
 	 * Construct a GraphEdgeIterator.
 	 * @param job Job to iterate on.
 	 */
-	GraphEdgeIterator(LinkGraphJob &job) : job(job),
+	GraphEdgeIterator(LinkGraphJob &job, std::vector<NodeID> &) : job(job),
 		i(nullptr), end(nullptr), node(INVALID_NODE), saved(nullptr)
 	{}
 
@@ -165,7 +165,7 @@ private:
 	LinkGraphJob &job; ///< Link graph job we're working with.
 
 	/** Lookup table for getting NodeIDs from StationIDs. */
-	std::vector<NodeID> station_to_node;
+	const std::vector<NodeID> &station_to_node;
 
 	/** Current iterator in the shares map. */
 	FlowStat::const_iterator it;
@@ -177,15 +177,18 @@ public:
 	/**
 	 * Constructor.
 	 * @param job Link graph job to work with.
+	 * @param station_to_node Lookup table for getting NodeIDs from StationIDs, filled in if empty.
+	 *                        This is shared between all iterators of a pass, as building it for each search is costly on large graphs.
 	 */
-	FlowEdgeIterator(LinkGraphJob &job) : job(job)
+	FlowEdgeIterator(LinkGraphJob &job, std::vector<NodeID> &station_to_node) : job(job), station_to_node(station_to_node)
 	{
+		if (!station_to_node.empty()) return;
 		for (NodeID i = 0; i < job.Size(); ++i) {
 			StationID st = job[i].Station();
-			if (st >= this->station_to_node.size()) {
-				this->station_to_node.resize(st + 1);
+			if (st >= station_to_node.size()) {
+				station_to_node.resize(st + 1);
 			}
-			this->station_to_node[st] = i;
+			station_to_node[st] = i;
 		}
 	}
 
@@ -293,7 +296,7 @@ void MultiCommodityFlow::Dijkstra(NodeID source_node, PathVector &paths)
 {
 	typedef btree::btree_set<AnnoSetItem<Tannotation>, typename Tannotation::Comparator> AnnoSet;
 	AnnoSet annos = AnnoSet(typename Tannotation::Comparator());
-	Tedge_iterator iter(this->job);
+	Tedge_iterator iter(this->job, this->station_to_node);
 	uint size = this->job.Size();
 	paths.resize(size, nullptr);
 
@@ -363,6 +366,25 @@ void MultiCommodityFlow::CleanupPaths(NodeID source_id, PathVector &paths)
 	paths.clear();
 }
 
+/**
+ * Mark the sources which have no unsatisfied demand as finished, so that no paths are searched for them.
+ * Searches for such sources can't push any flow, so skipping them doesn't change the result.
+ * @param finished_sources Finished flag for each node.
+ */
+void MultiCommodityFlow::MarkSatisfiedSourcesFinished(std::vector<bool> &finished_sources)
+{
+	for (NodeID source = 0; source < this->job.Size(); ++source) {
+		bool demand_left = false;
+		for (const DemandAnnotation &anno : this->job[source].GetDemandAnnotations()) {
+			if (anno.unsatisfied_demand > 0) {
+				demand_left = true;
+				break;
+			}
+		}
+		if (!demand_left) finished_sources[source] = true;
+	}
+}
+
 /**
  * Push flow along a path and update the unsatisfied_demand of the associated
  * edge.
@@ -558,6 +580,7 @@ MCF1stPass::MCF1stPass(LinkGraphJob &job) : MultiCommodityFlow(job)
 		min_step_size = std::max<uint>(min_step_size, (total_demand * (1 + FindLastBit(size / adjust_threshold))) / (size * accuracy));
 		accuracy = Clamp(IntSqrt((4 * accuracy * accuracy * size) / demand_count), CeilDiv(accuracy, 4), accuracy);
 	}
+	this->MarkSatisfiedSourcesFinished(finished_sources);
 
 	do {
 		more_loops = false;
@@ -607,6 +630,7 @@ MCF2ndPass::MCF2ndPass(LinkGraphJob &job) : MultiCommodityFlow(job)
 	uint accuracy = job.Settings().accuracy;
 	bool demand_left = true;
 	std::vector<bool> finished_sources(size);
+	this->MarkSatisfiedSourcesFinished(finished_sources);
 	while (demand_left && !job.IsJobAborted()) {
 		demand_left = false;
 		for (NodeID source = 0; source < size; ++source) {
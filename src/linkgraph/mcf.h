@@ -28,8 +28,11 @@ protected:
 
 	void CleanupPaths(NodeID source, PathVector &paths);
 
+	void MarkSatisfiedSourcesFinished(std::vector<bool> &finished_sources);
+
 	LinkGraphJob &job;   ///< Job we're working with.
 	uint max_saturation; ///< Maximum saturation for edges.
+	std::vector<NodeID> station_to_node; ///< Lookup table for getting NodeIDs from StationIDs, built on first use by the flow edge iterator.
 };
 
 /**
@@ -83,6 +83,7 @@ struct LoadCheckData {
 	}
 
 	void Clear();
+	void Swap(LoadCheckData &other);
 };
 
 extern LoadCheckData _load_check_data;
@@ -16,6 +16,7 @@
 #include "tunnelbridge_map.h"
 #include "3rdparty/cpp-btree/btree_map.h"
 #include "core/ring_buffer.hpp"
+#include "pathfinder/water_regions.h"
 #include <array>
 #include <memory>
 
@@ -37,8 +38,19 @@ uint _map_size_y;    ///< Size of the map along the Y
 uint _map_size;      ///< The number of tiles on the map
 uint _map_tile_mask; ///< _map_size - 1 (to mask the mapsize)
 
+#if defined(WITH_INTERLEAVED_MAP)
+TileInterleaved *_mi = nullptr;                         ///< Tiles of the map, base and extended data interleaved
+InterleavedTileArray<Tile, &TileInterleaved::m> _m;            ///< Tiles of the map
+InterleavedTileArray<TileExtended, &TileInterleaved::me> _me;  ///< Extended Tiles of the map
+#elif defined(WITH_BLOCKED_MAP)
+Tile *_m_storage = nullptr;                          ///< Storage of the tiles of the map, in blocks of tiles
+TileExtended *_me_storage = nullptr;                 ///< Storage of the extended tiles of the map, in blocks of tiles
+BlockedTileArray<Tile, _m_storage> _m;               ///< Tiles of the map
+BlockedTileArray<TileExtended, _me_storage> _me;     ///< Extended Tiles of the map
+#else
 Tile *_m = nullptr;          ///< Tiles of the map
 TileExtended *_me = nullptr; ///< Extended Tiles of the map
+#endif
 
 #if defined(__linux__) && defined(MADV_HUGEPAGE)
 static size_t _munmap_size = 0;
@@ -85,15 +97,28 @@ void AllocateMap(uint size_x, uint size_y)
 	_map_size = size_x * size_y;
 	_map_tile_mask = _map_size - 1;
 
+#if defined(WITH_INTERLEAVED_MAP)
+	void *old_buf = _mi;
+	_mi = nullptr;
+#elif defined(WITH_BLOCKED_MAP)
+	void *old_buf = _m_storage;
+	_m_storage = nullptr;
+	_me_storage = nullptr;
+#else
+	void *old_buf = _m;
+	_m = nullptr;
+	_me = nullptr;
+#endif
+
 #if defined(__linux__) && defined(MADV_HUGEPAGE)
 	if (_munmap_size != 0) {
-		munmap(_m, _munmap_size);
+		munmap(old_buf, _munmap_size);
 		_munmap_size = 0;
-		_m = nullptr;
+		old_buf = nullptr;
 	}
 #endif
 
-	free(_m);
+	free(old_buf);
 
 	const size_t total_size = (sizeof(Tile) + sizeof(TileExtended)) * _map_size;
 
@@ -131,8 +156,17 @@ void AllocateMap(uint size_x, uint size_y)
 
 	if (buf == nullptr) buf = CallocT<byte>(total_size);
 
+#if defined(WITH_INTERLEAVED_MAP)
+	_mi = reinterpret_cast<TileInterleaved *>(buf);
+#elif defined(WITH_BLOCKED_MAP)
+	_m_storage = reinterpret_cast<Tile *>(buf);
+	_me_storage = reinterpret_cast<TileExtended *>(buf + (_map_size * sizeof(Tile)));
+#else
 	_m = reinterpret_cast<Tile *>(buf);
 	_me = reinterpret_cast<TileExtended *>(buf + (_map_size * sizeof(Tile)));
+#endif
+
+	AllocateWaterRegions();
 }
 
 
@@ -25,6 +25,95 @@ extern uint _map_tile_mask;
 
 #define TILE_MASK(x) ((x) & _map_tile_mask)
 
+#ifdef WITH_BLOCKED_MAP
+extern uint _map_log_x;
+
+/** Log2 of the size along each side of the blocks of tiles in the map storage. */
+static const uint MAP_STORAGE_BLOCK_LOG = 3;
+static_assert(MIN_MAP_SIZE_BITS >= MAP_STORAGE_BLOCK_LOG);
+
+/**
+ * Get the position of a tile in the map storage.
+ * The storage is ordered by blocks of 8x8 tiles, such that tiles which are
+ * near to each other along the Y axis are usually near to each other in memory.
+ * @param tile The tile.
+ * @return The position of the tile in the map storage.
+ */
+static inline size_t MapStorageIndex(TileIndex tile)
+{
+	const uint block_mask = (1 << MAP_STORAGE_BLOCK_LOG) - 1;
+	const uint x = tile & ((1 << _map_log_x) - 1);
+	const uint y = tile >> _map_log_x;
+	return ((size_t)(y >> MAP_STORAGE_BLOCK_LOG) << (_map_log_x + MAP_STORAGE_BLOCK_LOG)) |
+			((size_t)(x >> MAP_STORAGE_BLOCK_LOG) << (2 * MAP_STORAGE_BLOCK_LOG)) |
+			((y & block_mask) << MAP_STORAGE_BLOCK_LOG) | (x & block_mask);
+}
+#else
+/**
+ * Get the position of a tile in the map storage.
+ * @param tile The tile.
+ * @return The position of the tile in the map storage.
+ */
+static inline size_t MapStorageIndex(TileIndex tile)
+{
+	return tile;
+}
+#endif /* WITH_BLOCKED_MAP */
+
+#if defined(WITH_INTERLEAVED_MAP)
+/**
+ * Pointer to the interleaved tile-array.
+ *
+ * This variable points to the tile-array which contains both the base
+ * and the extended data of the tiles of the map.
+ */
+extern TileInterleaved *_mi;
+
+/**
+ * Array-like view on one part of the interleaved tile-array, such that
+ * _m[tile] and _me[tile] work the same as with the split layout.
+ * @tparam T Type of the part.
+ * @tparam member The part of #TileInterleaved.
+ */
+template <typename T, T TileInterleaved::*member>
+struct InterleavedTileArray {
+	inline T &operator[](size_t index) const
+	{
+		return _mi[MapStorageIndex((TileIndex)index)].*member;
+	}
+
+	inline bool operator==(std::nullptr_t) const { return _mi == nullptr; }
+	inline bool operator!=(std::nullptr_t) const { return _mi != nullptr; }
+	inline bool operator!() const { return _mi == nullptr; }
+};
+
+extern InterleavedTileArray<Tile, &TileInterleaved::m> _m;
+extern InterleavedTileArray<TileExtended, &TileInterleaved::me> _me;
+#elif defined(WITH_BLOCKED_MAP)
+extern Tile *_m_storage;
+extern TileExtended *_me_storage;
+
+/**
+ * Array-like view on a tile-array which is ordered by blocks of tiles,
+ * such that _m[tile] and _me[tile] work the same as with the row ordered storage.
+ * @tparam T Type of the tiles.
+ * @tparam storage The tile-array.
+ */
+template <typename T, T *&storage>
+struct BlockedTileArray {
+	inline T &operator[](size_t index) const
+	{
+		return storage[MapStorageIndex((TileIndex)index)];
+	}
+
+	inline bool operator==(std::nullptr_t) const { return storage == nullptr; }
+	inline bool operator!=(std::nullptr_t) const { return storage != nullptr; }
+	inline bool operator!() const { return storage == nullptr; }
+};
+
+extern BlockedTileArray<Tile, _m_storage> _m;
+extern BlockedTileArray<TileExtended, _me_storage> _me;
+#else
 /**
  * Pointer to the tile-array.
  *
@@ -40,6 +129,7 @@ extern Tile *_m;
  * of the map.
  */
 extern TileExtended *_me;
+#endif
 
 bool ValidateMapSize(uint size_x, uint size_y);
 void AllocateMap(uint size_x, uint size_y);
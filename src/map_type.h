@@ -36,6 +36,20 @@ struct TileExtended {
 	uint16 m8; ///< General purpose
 };
 
+#ifdef WITH_INTERLEAVED_MAP
+/**
+ * All data of a single tile, when the map is stored as a single array instead of one array
+ * for #Tile and one for #TileExtended. Accessors which read fields from both then only touch
+ * one cache line per tile.
+ */
+struct TileInterleaved {
+	Tile m;          ///< The base data of the tile
+	TileExtended me; ///< The extended data of the tile
+};
+
+static_assert(sizeof(TileInterleaved) == 12);
+#endif /* WITH_INTERLEAVED_MAP */
+
 /**
  * An offset value between two tiles.
  *
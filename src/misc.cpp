@@ -28,15 +28,18 @@
 #include "linkgraph/linkgraphschedule.h"
 #include "station_kdtree.h"
 #include "town_kdtree.h"
+#include "industry_kdtree.h"
 #include "viewport_kdtree.h"
 #include "newgrf_profiling.h"
 #include "tracerestrict.h"
 #include "programmable_signals.h"
 #include "viewport_func.h"
+#include "pathfinder/yapf/yapf_cache.h"
 #include "bridge_signal_map.h"
 #include "command_func.h"
 #include "command_log.h"
 #include "zoning.h"
+#include "signal_func.h"
 #include "cargopacket.h"
 #include "tbtr_template_vehicle_func.h"
 #include "event_logs.h"
@@ -114,6 +117,7 @@ void InitializeGame(uint size_x, uint size_y, bool reset_date, bool reset_settin
 	AllocateMap(size_x, size_y);
 
 	ViewportMapClearTunnelCache();
+	ClearTileSpriteCache();
 	ClearCommandLog();
 	ClearCommandQueue();
 	ClearSpecialEventsLog();
@@ -130,6 +134,8 @@ void InitializeGame(uint size_x, uint size_y, bool reset_date, bool reset_settin
 	_aux_tileloop_tile = 1;
 	_thd.redsq = INVALID_TILE;
 	_road_layout_change_counter = 0;
+	YapfNotifyRoadLayoutChange();
+	InvalidateSignalSegmentCache();
 	_loaded_local_company = COMPANY_SPECTATOR;
 	_game_events_since_load = (GameEventFlags) 0;
 	_game_events_overall = (GameEventFlags) 0;
@@ -167,6 +173,7 @@ void InitializeGame(uint size_x, uint size_y, bool reset_date, bool reset_settin
 
 	RebuildStationKdtree();
 	RebuildTownKdtree();
+	RebuildIndustryKdtree();
 	RebuildViewportKdtree();
 
 	FreeSignalPrograms();
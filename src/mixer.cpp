@@ -24,8 +24,8 @@
 #endif
 
 struct MixerChannel {
-	/* pointer to allocated buffer memory */
-	int8 *memory;
+	/* signed 16 bit samples, shared with the sound entry they were converted for */
+	std::shared_ptr<std::vector<int16>> memory;
 
 	/* current position in memory */
 	uint32 pos;
@@ -36,8 +36,6 @@ struct MixerChannel {
 	/* Mixing volume */
 	int volume_left;
 	int volume_right;
-
-	bool is16bit;
 };
 
 static std::atomic<uint8> _active_channels;
@@ -75,7 +73,7 @@ static void mix_int16(MixerChannel *sc, int16 *buffer, uint samples, uint8 effec
 	sc->samples_left -= samples;
 	assert(samples > 0);
 
-	const int16 *b = (const int16 *)sc->memory + sc->pos;
+	const int16 *b = sc->memory->data() + sc->pos;
 	uint32 frac_pos = sc->frac_pos;
 	uint32 frac_speed = sc->frac_speed;
 	int volume_left = sc->volume_left * effect_vol / 255;
@@ -102,43 +100,7 @@ static void mix_int16(MixerChannel *sc, int16 *buffer, uint samples, uint8 effec
 	}
 
 	sc->frac_pos = frac_pos;
-	sc->pos = b - (const int16 *)sc->memory;
-}
-
-static void mix_int8_to_int16(MixerChannel *sc, int16 *buffer, uint samples, uint8 effect_vol)
-{
-	if (samples > sc->samples_left) samples = sc->samples_left;
-	sc->samples_left -= samples;
-	assert(samples > 0);
-
-	const int8 *b = sc->memory + sc->pos;
-	uint32 frac_pos = sc->frac_pos;
-	uint32 frac_speed = sc->frac_speed;
-	int volume_left = sc->volume_left * effect_vol / 255;
-	int volume_right = sc->volume_right * effect_vol / 255;
-
-	if (frac_speed == 0x10000) {
-		/* Special case when frac_speed is 0x10000 */
-		do {
-			buffer[0] = Clamp(buffer[0] + (*b * volume_left  >> 8), -MAX_VOLUME, MAX_VOLUME);
-			buffer[1] = Clamp(buffer[1] + (*b * volume_right >> 8), -MAX_VOLUME, MAX_VOLUME);
-			b++;
-			buffer += 2;
-		} while (--samples > 0);
-	} else {
-		do {
-			int data = RateConversion(b, frac_pos);
-			buffer[0] = Clamp(buffer[0] + (data * volume_left  >> 8), -MAX_VOLUME, MAX_VOLUME);
-			buffer[1] = Clamp(buffer[1] + (data * volume_right >> 8), -MAX_VOLUME, MAX_VOLUME);
-			buffer += 2;
-			frac_pos += frac_speed;
-			b += frac_pos >> 16;
-			frac_pos &= 0xffff;
-		} while (--samples > 0);
-	}
-
-	sc->frac_pos = frac_pos;
-	sc->pos = b - sc->memory;
+	sc->pos = b - sc->memory->data();
 }
 
 static void MxCloseChannel(uint8 channel_index)
@@ -177,11 +139,7 @@ void MxMixSamples(void *buffer, uint samples)
 	uint8 active = _active_channels.load(std::memory_order_acquire);
 	for (uint8 idx : SetBitIterator(active)) {
 		MixerChannel *mc = &_channels[idx];
-		if (mc->is16bit) {
-			mix_int16(mc, (int16*)buffer, samples, effect_vol);
-		} else {
-			mix_int8_to_int16(mc, (int16*)buffer, samples, effect_vol);
-		}
+		mix_int16(mc, (int16*)buffer, samples, effect_vol);
 		if (mc->samples_left == 0) MxCloseChannel(idx);
 	}
 }
@@ -195,21 +153,26 @@ MixerChannel *MxAllocateChannel()
 	uint8 channel_index = FindFirstBit(available);
 
 	MixerChannel *mc = &_channels[channel_index];
-	free(mc->memory);
-	mc->memory = nullptr;
+	mc->memory.reset();
 	return mc;
 }
 
-void MxSetChannelRawSrc(MixerChannel *mc, int8 *mem, size_t size, uint rate, bool is16bit)
+/**
+ * Set the samples to play on a channel.
+ * @param mc Channel to set.
+ * @param mem Signed 16 bit samples, followed by at least one more sample which is read by the rate conversion.
+ * @param size Number of samples to play.
+ * @param rate Sample rate of \a mem, sounds are usually converted to #MxGetRate beforehand.
+ */
+void MxSetChannelRawSrc(MixerChannel *mc, const std::shared_ptr<std::vector<int16>> &mem, size_t size, uint rate)
 {
+	assert(mem->size() > size);
 	mc->memory = mem;
 	mc->frac_pos = 0;
 	mc->pos = 0;
 
 	mc->frac_speed = (rate << 16) / _play_rate;
 
-	if (is16bit) size /= 2;
-
 	/* adjust the magnitude to prevent overflow */
 	while (size >= _max_size) {
 		size >>= 1;
@@ -217,7 +180,6 @@ void MxSetChannelRawSrc(MixerChannel *mc, int8 *mem, size_t size, uint rate, boo
 	}
 
 	mc->samples_left = (uint)size * _play_rate / rate;
-	mc->is16bit = is16bit;
 }
 
 /**
@@ -263,6 +225,15 @@ bool MxInitialize(uint rate)
 	return true;
 }
 
+/**
+ * Get the sample rate of the mixer.
+ * @return Output sample rate.
+ */
+uint32 MxGetRate()
+{
+	return _play_rate;
+}
+
 void SetEffectVolume(uint8 volume)
 {
 	_effect_vol.store(volume, std::memory_order_relaxed);
@@ -10,6 +10,9 @@
 #ifndef MIXER_H
 #define MIXER_H
 
+#include <memory>
+#include <vector>
+
 struct MixerChannel;
 
 /**
@@ -21,10 +24,11 @@ struct MixerChannel;
 typedef void(*MxStreamCallback)(int16 *buffer, size_t samples);
 
 bool MxInitialize(uint rate);
+uint32 MxGetRate();
 void MxMixSamples(void *buffer, uint samples);
 
 MixerChannel *MxAllocateChannel();
-void MxSetChannelRawSrc(MixerChannel *mc, int8 *mem, size_t size, uint rate, bool is16bit);
+void MxSetChannelRawSrc(MixerChannel *mc, const std::shared_ptr<std::vector<int16>> &mem, size_t size, uint rate);
 void MxSetChannelVolume(MixerChannel *mc, uint volume, float pan);
 void MxActivateChannel(MixerChannel*);
 
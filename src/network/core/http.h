@@ -54,8 +54,10 @@ public:
 	 * @param uri      the URI to connect to (https://.../..).
 	 * @param callback the callback to send data back on.
 	 * @param data     the data we want to send. When non-empty, this will be a POST request, otherwise a GET request.
+	 * @param resume_from the byte offset to resume a GET request from, or 0 for the whole resource.
+	 *                 When the server does not honour the range the request fails.
 	 */
-	static void Connect(const std::string &uri, HTTPCallback *callback, const std::string data = "");
+	static void Connect(const std::string &uri, HTTPCallback *callback, const std::string data = "", size_t resume_from = 0);
 
 	/**
 	 * Do the receiving for all HTTP connections.
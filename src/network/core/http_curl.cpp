@@ -54,17 +54,20 @@ public:
 	 * @param uri      the URI to connect to (https://.../..).
 	 * @param callback the callback to send data back on.
 	 * @param data     the data we want to send. When non-empty, this will be a POST request, otherwise a GET request.
+	 * @param resume_from the byte offset to resume a GET request from, or 0 for the whole resource.
 	 */
-	NetworkHTTPRequest(const std::string &uri, HTTPCallback *callback, const std::string &data) :
+	NetworkHTTPRequest(const std::string &uri, HTTPCallback *callback, const std::string &data, size_t resume_from) :
 		uri(uri),
 		callback(callback),
-		data(data)
+		data(data),
+		resume_from(resume_from)
 	{
 	}
 
 	const std::string uri;        ///< URI to connect to.
 	HTTPCallback *callback;       ///< Callback to send data back on.
 	const std::string data;       ///< Data to send, if any.
+	const size_t resume_from;     ///< Byte offset to resume the transfer from, if any.
 };
 
 static std::thread _http_thread;
@@ -77,7 +80,7 @@ static std::string _http_ca_file = "";
 static std::string _http_ca_path = "";
 #endif /* UNIX */
 
-/* static */ void NetworkHTTPSocketHandler::Connect(const std::string &uri, HTTPCallback *callback, const std::string data)
+/* static */ void NetworkHTTPSocketHandler::Connect(const std::string &uri, HTTPCallback *callback, const std::string data, size_t resume_from)
 {
 #if defined(UNIX)
 	if (_http_ca_file.empty() && _http_ca_path.empty()) {
@@ -87,7 +90,7 @@ static std::string _http_ca_path = "";
 #endif /* UNIX */
 
 	std::lock_guard<std::mutex> lock(_http_mutex);
-	_http_requests.push(std::make_unique<NetworkHTTPRequest>(uri, callback, data));
+	_http_requests.push(std::make_unique<NetworkHTTPRequest>(uri, callback, data, resume_from));
 	_http_cv.notify_one();
 }
 
@@ -161,6 +164,11 @@ void HttpThread()
 		}
 		curl_easy_setopt(curl, CURLOPT_URL, request->uri.c_str());
 
+		/* Continue an interrupted transfer; curl fails the request when the server ignores the range. */
+		if (request->resume_from != 0) {
+			curl_easy_setopt(curl, CURLOPT_RESUME_FROM_LARGE, static_cast<curl_off_t>(request->resume_from));
+		}
+
 		/* Setup our (C-style) callback function which we pipe back into the callback. */
 		curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, +[](char *ptr, size_t size, size_t nmemb, void *userdata) -> size_t {
 			Debug(net, 4, "HTTP callback: {} bytes", size * nmemb);
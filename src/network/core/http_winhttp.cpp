@@ -28,6 +28,7 @@ private:
 	const std::wstring uri;       ///< URI to connect to.
 	HTTPCallback *callback;       ///< Callback to send data back on.
 	const std::string data;       ///< Data to send, if any.
+	const size_t resume_from;     ///< Byte offset to resume the transfer from, if any.
 
 	HINTERNET connection = nullptr;      ///< Current connection object.
 	HINTERNET request = nullptr;         ///< Current request object.
@@ -35,7 +36,7 @@ private:
 	int depth = 0;                       ///< Current redirect depth we are in.
 
 public:
-	NetworkHTTPRequest(const std::wstring &uri, HTTPCallback *callback, const std::string &data);
+	NetworkHTTPRequest(const std::wstring &uri, HTTPCallback *callback, const std::string &data, size_t resume_from);
 
 	~NetworkHTTPRequest();
 
@@ -53,11 +54,13 @@ static std::vector<NetworkHTTPRequest *> _new_http_requests;
  * @param uri      the URI to connect to (https://.../..).
  * @param callback the callback to send data back on.
  * @param data     the data we want to send. When non-empty, this will be a POST request, otherwise a GET request.
+ * @param resume_from the byte offset to resume a GET request from, or 0 for the whole resource.
  */
-NetworkHTTPRequest::NetworkHTTPRequest(const std::wstring &uri, HTTPCallback *callback, const std::string &data) :
+NetworkHTTPRequest::NetworkHTTPRequest(const std::wstring &uri, HTTPCallback *callback, const std::string &data, size_t resume_from) :
 	uri(uri),
 	callback(callback),
-	data(data)
+	data(data),
+	resume_from(resume_from)
 {
 }
 
@@ -138,6 +141,14 @@ void NetworkHTTPRequest::WinHttpCallback(DWORD code, void *info, DWORD length)
 				return;
 			}
 
+			/* A resumed transfer must continue where we left off, not send the whole resource again. */
+			if (this->resume_from != 0 && status_code != 206) {
+				Debug(net, 0, "HTTP request failed: server does not support resuming, status-code {}", status_code);
+				this->finished = true;
+				this->callback->OnFailure();
+				return;
+			}
+
 			/* Next step: query for any data. */
 			WinHttpQueryDataAvailable(this->request, nullptr);
 		} break;
@@ -241,7 +252,12 @@ void NetworkHTTPRequest::Connect()
 
 	/* Send the request (possibly with a payload). */
 	if (data.empty()) {
-		WinHttpSendRequest(this->request, WINHTTP_NO_ADDITIONAL_HEADERS, 0, WINHTTP_NO_REQUEST_DATA, 0, 0, reinterpret_cast<DWORD_PTR>(this));
+		if (this->resume_from != 0) {
+			std::wstring range = L"Range: bytes=" + std::to_wstring(this->resume_from) + L"-\r\n";
+			WinHttpSendRequest(this->request, range.c_str(), -1, WINHTTP_NO_REQUEST_DATA, 0, 0, reinterpret_cast<DWORD_PTR>(this));
+		} else {
+			WinHttpSendRequest(this->request, WINHTTP_NO_ADDITIONAL_HEADERS, 0, WINHTTP_NO_REQUEST_DATA, 0, 0, reinterpret_cast<DWORD_PTR>(this));
+		}
 	} else {
 		/* When the payload starts with a '{', it is a JSON payload. */
 		LPCWSTR content_type = StrStartsWith(data, "{") ? L"Content-Type: application/json\r\n" : L"Content-Type: application/x-www-form-urlencoded\r\n";
@@ -279,9 +295,9 @@ NetworkHTTPRequest::~NetworkHTTPRequest()
 	}
 }
 
-/* static */ void NetworkHTTPSocketHandler::Connect(const std::string &uri, HTTPCallback *callback, const std::string data)
+/* static */ void NetworkHTTPSocketHandler::Connect(const std::string &uri, HTTPCallback *callback, const std::string data, size_t resume_from)
 {
-	auto request = new NetworkHTTPRequest(std::wstring(uri.begin(), uri.end()), callback, data);
+	auto request = new NetworkHTTPRequest(std::wstring(uri.begin(), uri.end()), callback, data, resume_from);
 	request->Connect();
 	_new_http_requests.push_back(request);
 }
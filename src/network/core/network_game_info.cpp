@@ -36,6 +36,7 @@ extern const uint8 _out_of_band_grf_md5[16];
 static const uint GITHASH_SUFFIX_LEN = 12;
 
 NetworkServerGameInfo _network_game_info; ///< Information about our game.
+uint32 _network_game_info_static_generation = 0; ///< Incremented whenever the static content of #_network_game_info is refilled.
 
 /**
  * Get the network version string used by this build.
@@ -142,6 +143,8 @@ void FillStaticNetworkServerGameInfo()
 
 	_network_game_info.server_name = _settings_client.network.server_name;
 	_network_game_info.server_revision = GetNetworkRevisionString();
+
+	_network_game_info_static_generation++;
 }
 
 /**
@@ -131,6 +131,7 @@ struct NamedGRFIdentifier {
 typedef std::unordered_map<uint32, NamedGRFIdentifier> GameInfoNewGRFLookupTable;
 
 extern NetworkServerGameInfo _network_game_info;
+extern uint32 _network_game_info_static_generation;
 
 const char *GetNetworkRevisionString();
 bool IsNetworkCompatibleVersion(const char *other, bool extended = false);
@@ -220,6 +220,85 @@ bool ShutdownSocket(SOCKET d, bool read, bool write, uint linger_timeout)
 	return shutdown(d, how) == 0;
 }
 
+/** Remove all sockets from the set. */
+void SocketPollSet::Clear()
+{
+#if defined(WITH_SOCKET_POLL)
+	this->fds.clear();
+#else
+	this->sockets.clear();
+	FD_ZERO(&this->read_fd);
+	FD_ZERO(&this->write_fd);
+#endif
+}
+
+/**
+ * Add a socket to the set; it is always checked for readability.
+ * @param s     The socket to add.
+ * @param write Whether to also check whether the socket can be written to.
+ * @return The handle to query the state of the socket with after polling.
+ */
+uint SocketPollSet::Add(SOCKET s, bool write)
+{
+#if defined(WITH_SOCKET_POLL)
+	pollfd &fd = this->fds.emplace_back();
+	fd.fd = s;
+	fd.events = POLLIN | (write ? POLLOUT : 0);
+	fd.revents = 0;
+	return (uint)this->fds.size() - 1;
+#else
+	FD_SET(s, &this->read_fd);
+	if (write) FD_SET(s, &this->write_fd);
+	this->sockets.push_back(s);
+	return (uint)this->sockets.size() - 1;
+#endif
+}
+
+/**
+ * Check, without blocking, which sockets of the set can be read from or written to.
+ * @return Whether polling succeeded.
+ */
+bool SocketPollSet::Poll()
+{
+#if defined(WITH_SOCKET_POLL)
+	if (this->fds.empty()) return true;
+	return poll(this->fds.data(), this->fds.size(), 0) >= 0;
+#else
+	if (this->sockets.empty()) return true;
+	struct timeval tv;
+	tv.tv_sec = tv.tv_usec = 0; // don't block at all.
+	return select(FD_SETSIZE, &this->read_fd, &this->write_fd, nullptr, &tv) >= 0;
+#endif
+}
+
+/**
+ * Whether a socket can be read from, or has been closed or has an error which reading will report.
+ * @param handle The handle returned by #Add.
+ * @return True if the socket should be read from.
+ */
+bool SocketPollSet::IsReadable(uint handle) const
+{
+#if defined(WITH_SOCKET_POLL)
+	return (this->fds[handle].revents & (POLLIN | POLLHUP | POLLERR)) != 0;
+#else
+	return FD_ISSET(this->sockets[handle], &this->read_fd) != 0;
+#endif
+}
+
+/**
+ * Whether a socket can be written to.
+ * @param handle The handle returned by #Add.
+ * @return True if the socket can be written to.
+ */
+bool SocketPollSet::IsWritable(uint handle) const
+{
+#if defined(WITH_SOCKET_POLL)
+	return (this->fds[handle].revents & POLLOUT) != 0;
+#else
+	return FD_ISSET(this->sockets[handle], &this->write_fd) != 0;
+#endif
+}
+
 /**
  * Get the error from a socket, if any.
  * @param d The socket to get the error from.
@@ -14,6 +14,8 @@
 #ifndef NETWORK_CORE_OS_ABSTRACTION_H
 #define NETWORK_CORE_OS_ABSTRACTION_H
 
+#include <vector>
+
 /**
  * Abstraction of a network error where all implementation details of the
  * error codes are encapsulated in this class and the abstraction layer.
@@ -106,6 +108,10 @@ typedef unsigned long in_addr_t;
 #	include <errno.h>
 #	include <sys/time.h>
 #	include <netdb.h>
+#	if !defined(__EMSCRIPTEN__)
+#		include <poll.h>
+#		define WITH_SOCKET_POLL
+#	endif
 
 #   if defined(__EMSCRIPTEN__)
 /* Emscripten doesn't support AI_ADDRCONFIG and errors out on it. */
@@ -147,6 +153,29 @@ static inline socklen_t FixAddrLenForEmscripten(struct sockaddr_storage &address
 }
 #endif
 
+/**
+ * A set of sockets which are checked, without blocking, for whether they can be read from or written to.
+ * It uses poll() where available, so it is not limited by FD_SETSIZE and its cost only depends on the sockets in the set.
+ */
+class SocketPollSet {
+#if defined(WITH_SOCKET_POLL)
+	std::vector<pollfd> fds;  ///< The sockets and the events to check them for.
+#else
+	std::vector<SOCKET> sockets; ///< The sockets in the set.
+	fd_set read_fd;           ///< The sockets to check for readability, and after polling the readable sockets.
+	fd_set write_fd;          ///< The sockets to check for writability, and after polling the writable sockets.
+#endif
+
+public:
+	SocketPollSet() { this->Clear(); }
+
+	void Clear();
+	uint Add(SOCKET s, bool write);
+	bool Poll();
+	bool IsReadable(uint handle) const;
+	bool IsWritable(uint handle) const;
+};
+
 bool SetNonBlocking(SOCKET d);
 bool SetBlocking(SOCKET d);
 bool SetNoDelay(SOCKET d);
@@ -16,8 +16,58 @@
 
 #include "packet.h"
 
+#include <mutex>
+
 #include "../../safeguards.h"
 
+static const size_t PACKET_BUFFER_POOL_SIZE = 64; ///< Maximum number of buffers kept for reuse.
+
+/** Buffers of freed packets, for reuse by new packets. */
+struct PacketBufferPool {
+	std::mutex mutex;                       ///< Packets are also created and freed by other threads.
+	std::vector<std::vector<byte>> buffers; ///< The buffers available for reuse.
+};
+
+/**
+ * Get the pool of packet buffers.
+ * It is never freed, as packets may be freed during the destruction of static objects.
+ * @return The pool.
+ */
+static PacketBufferPool &GetPacketBufferPool()
+{
+	static PacketBufferPool *pool = new PacketBufferPool();
+	return *pool;
+}
+
+/**
+ * Get a buffer for a new packet, reusing the buffer of a freed packet when available.
+ * @param buffer The (empty) buffer to replace.
+ */
+static void AcquirePacketBuffer(std::vector<byte> &buffer)
+{
+	PacketBufferPool &pool = GetPacketBufferPool();
+	std::lock_guard<std::mutex> lock(pool.mutex);
+	if (pool.buffers.empty()) return;
+
+	buffer.swap(pool.buffers.back());
+	pool.buffers.pop_back();
+	buffer.clear();
+}
+
+/**
+ * Keep the buffer of a packet which is being freed for reuse, when it isn't unusually large.
+ * @param buffer The buffer to keep.
+ */
+static void ReleasePacketBuffer(std::vector<byte> &buffer)
+{
+	if (buffer.capacity() == 0 || buffer.capacity() > TCP_MTU) return;
+
+	PacketBufferPool &pool = GetPacketBufferPool();
+	std::lock_guard<std::mutex> lock(pool.mutex);
+	if (pool.buffers.size() >= PACKET_BUFFER_POOL_SIZE) return;
+	pool.buffers.emplace_back(std::move(buffer));
+}
+
 /**
  * Create a packet that is used to read from a network socket.
  * @param cs                The socket handler associated with the socket we are reading from.
@@ -35,6 +85,7 @@ Packet::Packet(NetworkSocketHandler *cs, size_t limit, size_t initial_read_size)
 	assert(cs != nullptr);
 
 	this->cs = cs;
+	AcquirePacketBuffer(this->buffer);
 	this->buffer.resize(initial_read_size);
 }
 
@@ -48,9 +99,15 @@ Packet::Packet(NetworkSocketHandler *cs, size_t limit, size_t initial_read_size)
  */
 Packet::Packet(PacketType type, size_t limit) : pos(0), limit(limit), cs(nullptr)
 {
+	AcquirePacketBuffer(this->buffer);
 	this->ResetState(type);
 }
 
+Packet::~Packet()
+{
+	ReleasePacketBuffer(this->buffer);
+}
+
 void Packet::ResetState(PacketType type)
 {
 	this->cs = nullptr;
@@ -59,6 +59,12 @@ private:
 public:
 	Packet(NetworkSocketHandler *cs, size_t limit, size_t initial_read_size = sizeof(PacketSize));
 	Packet(PacketType type, size_t limit = COMPAT_MTU);
+	Packet(const Packet &other) = default;
+	Packet(Packet &&other) = default;
+	~Packet();
+
+	Packet &operator=(const Packet &other) = default;
+	Packet &operator=(Packet &&other) = default;
 
 	void ResetState(PacketType type);
 
@@ -93,6 +99,16 @@ public:
 	PacketSize GetRawPos() const { return this->pos; }
 	void ReserveBuffer(size_t size) { this->buffer.reserve(size); }
 
+	/**
+	 * Mark bytes of this packet as transferred, after they have been transferred by other means than #TransferOut.
+	 * @param amount The number of bytes which have been transferred.
+	 */
+	void SkipTransferred(size_t amount)
+	{
+		assert(amount <= this->RemainingBytesToTransfer());
+		this->pos += (PacketSize)amount;
+	}
+
 	/**
 	 * Transfer data from the packet to the given function. It starts reading at the
 	 * position the last transfer stopped.
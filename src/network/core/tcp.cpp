@@ -14,8 +14,82 @@
 
 #include "tcp.h"
 
+#if defined(UNIX) && !defined(__EMSCRIPTEN__)
+#	include <sys/uio.h>
+#endif
+
 #include "../../safeguards.h"
 
+#if defined(_WIN32)
+using SendBuffer = WSABUF;
+
+static inline void SetSendBuffer(WSABUF &buffer, const byte *data, size_t len)
+{
+	buffer.buf = reinterpret_cast<CHAR *>(const_cast<byte *>(data));
+	buffer.len = (ULONG)len;
+}
+
+/**
+ * Send a number of buffers with a single call.
+ * @param s       The socket to send to.
+ * @param buffers The buffers to send.
+ * @param count   The number of buffers.
+ * @return The number of bytes which have been sent, or -1 upon errors.
+ */
+static ssize_t SendBuffers(SOCKET s, WSABUF *buffers, uint count)
+{
+	DWORD sent = 0;
+	if (WSASend(s, buffers, count, &sent, 0, nullptr, nullptr) == SOCKET_ERROR) return -1;
+	return sent;
+}
+#elif defined(UNIX) && !defined(__EMSCRIPTEN__)
+using SendBuffer = iovec;
+
+static inline void SetSendBuffer(iovec &buffer, const byte *data, size_t len)
+{
+	buffer.iov_base = const_cast<byte *>(data);
+	buffer.iov_len = len;
+}
+
+/**
+ * Send a number of buffers with a single call.
+ * @param s       The socket to send to.
+ * @param buffers The buffers to send.
+ * @param count   The number of buffers.
+ * @return The number of bytes which have been sent, or -1 upon errors.
+ */
+static ssize_t SendBuffers(SOCKET s, iovec *buffers, uint count)
+{
+	msghdr msg{};
+	msg.msg_iov = buffers;
+	msg.msg_iovlen = count;
+	return sendmsg(s, &msg, 0);
+}
+#else
+struct SendBuffer {
+	const byte *data;
+	size_t len;
+};
+
+static inline void SetSendBuffer(SendBuffer &buffer, const byte *data, size_t len)
+{
+	buffer.data = data;
+	buffer.len = len;
+}
+
+/**
+ * Send the first of a number of buffers, as there is no gathering send on this platform.
+ * @param s       The socket to send to.
+ * @param buffers The buffers to send.
+ * @param count   The number of buffers.
+ * @return The number of bytes which have been sent, or -1 upon errors.
+ */
+static ssize_t SendBuffers(SOCKET s, SendBuffer *buffers, uint)
+{
+	return send(s, reinterpret_cast<const char *>(buffers[0].data), (int)buffers[0].len, 0);
+}
+#endif
+
 /**
  * Construct a socket handler for a TCP connection.
  * @param s The just opened TCP connection.
@@ -134,15 +208,24 @@ void NetworkTCPSocketHandler::ShrinkToFitSendQueue()
  */
 SendPacketsState NetworkTCPSocketHandler::SendPackets(bool closing_down)
 {
-	ssize_t res;
-
 	/* We can not write to this socket!! */
 	if (!this->writable) return SPS_NONE_SENT;
 	if (!this->IsConnected()) return SPS_CLOSED;
 
 	while (!this->packet_queue.empty()) {
-		Packet *p = this->packet_queue.front().get();
-		res = p->TransferOut<int>(send, this->sock, 0);
+		/* Gather the queued packets, such as the small per-frame and command packets, into a single send. */
+		SendBuffer buffers[MAX_SEND_BATCH_PACKETS];
+		uint buffer_count = 0;
+		size_t batch_bytes = 0;
+		for (const auto &queued : this->packet_queue) {
+			size_t remaining = queued->RemainingBytesToTransfer();
+			if (buffer_count > 0 && batch_bytes + remaining > MAX_SEND_BATCH_BYTES) break;
+			SetSendBuffer(buffers[buffer_count], queued->GetBufferData() + queued->GetRawPos(), remaining);
+			batch_bytes += remaining;
+			if (++buffer_count == MAX_SEND_BATCH_PACKETS) break;
+		}
+
+		ssize_t res = SendBuffers(this->sock, buffers, buffer_count);
 		if (res == -1) {
 			NetworkError err = NetworkError::GetLast();
 			if (!err.WouldBlock()) {
@@ -161,14 +244,19 @@ SendPacketsState NetworkTCPSocketHandler::SendPackets(bool closing_down)
 			return SPS_CLOSED;
 		}
 
-		/* Is this packet sent? */
-		if (p->RemainingBytesToTransfer() == 0) {
-			/* Go to the next packet */
+		/* Mark the sent bytes as transferred, and go to the next packet for each packet which has been sent completely. */
+		size_t sent = (size_t)res;
+		while (sent > 0) {
+			Packet *p = this->packet_queue.front().get();
+			size_t amount = std::min(sent, p->RemainingBytesToTransfer());
+			p->SkipTransferred(amount);
+			sent -= amount;
+			if (p->RemainingBytesToTransfer() != 0) return SPS_PARTLY_SENT;
+
 			if (_debug_net_level >= 5) this->LogSentPacket(*p);
 			this->packet_queue.pop_front();
-		} else {
-			return SPS_PARTLY_SENT;
 		}
+		if ((size_t)res < batch_bytes) return SPS_PARTLY_SENT;
 	}
 
 	return SPS_ALL_SENT;
@@ -259,18 +347,10 @@ bool NetworkTCPSocketHandler::CanSendReceive()
 {
 	assert(this->sock != INVALID_SOCKET);
 
-	fd_set read_fd, write_fd;
-	struct timeval tv;
-
-	FD_ZERO(&read_fd);
-	FD_ZERO(&write_fd);
-
-	FD_SET(this->sock, &read_fd);
-	FD_SET(this->sock, &write_fd);
-
-	tv.tv_sec = tv.tv_usec = 0; // don't block at all.
-	if (select(FD_SETSIZE, &read_fd, &write_fd, nullptr, &tv) < 0) return false;
+	SocketPollSet poll_set;
+	uint handle = poll_set.Add(this->sock, true);
+	if (!poll_set.Poll()) return false;
 
-	this->writable = !!FD_ISSET(this->sock, &write_fd);
-	return FD_ISSET(this->sock, &read_fd) != 0;
+	this->writable = poll_set.IsWritable(handle);
+	return poll_set.IsReadable(handle);
 }
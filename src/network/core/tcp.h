@@ -37,6 +37,9 @@ enum SendPacketsState {
 /** Base socket handler for all TCP sockets */
 class NetworkTCPSocketHandler : public NetworkSocketHandler {
 private:
+	static const uint MAX_SEND_BATCH_PACKETS = 64;         ///< Maximum number of queued packets which are gathered into a single send
+	static const size_t MAX_SEND_BATCH_BYTES = 64 * 1024; ///< Maximum number of bytes of queued packets which are gathered into a single send, unless the first packet is larger
+
 	ring_buffer<std::unique_ptr<Packet>> packet_queue; ///< Packets that are awaiting delivery
 	std::unique_ptr<Packet> packet_recv;              ///< Partially received packet
 
@@ -100,35 +100,38 @@ public:
 	 */
 	static bool Receive()
 	{
-		fd_set read_fd, write_fd;
-		struct timeval tv;
-
-		FD_ZERO(&read_fd);
-		FD_ZERO(&write_fd);
+		/* Kept between calls, so the sets don't have to be reallocated every tick. */
+		static SocketPollSet poll_set;
+		static std::vector<std::pair<size_t, SOCKET>> clients;
 
+		poll_set.Clear();
+		clients.clear();
 
 		for (Tsocket *cs : Tsocket::Iterate()) {
-			FD_SET(cs->sock, &read_fd);
-			FD_SET(cs->sock, &write_fd);
+			poll_set.Add(cs->sock, true);
+			clients.emplace_back(cs->index, cs->sock);
 		}
 
 		/* take care of listener port */
 		for (auto &s : sockets) {
-			FD_SET(s.first, &read_fd);
+			poll_set.Add(s.first, false);
 		}
 
-		tv.tv_sec = tv.tv_usec = 0; // don't block at all.
-		if (select(FD_SETSIZE, &read_fd, &write_fd, nullptr, &tv) < 0) return false;
+		if (!poll_set.Poll()) return false;
 
 		/* accept clients.. */
+		uint handle = (uint)clients.size();
 		for (auto &s : sockets) {
-			if (FD_ISSET(s.first, &read_fd)) AcceptClient(s.first);
+			if (poll_set.IsReadable(handle++)) AcceptClient(s.first);
 		}
 
-		/* read stuff from clients */
-		for (Tsocket *cs : Tsocket::Iterate()) {
-			cs->writable = !!FD_ISSET(cs->sock, &write_fd);
-			if (FD_ISSET(cs->sock, &read_fd)) {
+		/* read stuff from clients; they are looked up again, as handling packets can close other connections */
+		for (uint i = 0; i < clients.size(); i++) {
+			Tsocket *cs = Tsocket::GetIfValid(clients[i].first);
+			if (cs == nullptr || cs->sock != clients[i].second) continue;
+
+			cs->writable = poll_set.IsWritable(i);
+			if (poll_set.IsReadable(i)) {
 				cs->ReceivePackets();
 			}
 		}
@@ -66,6 +66,7 @@ bool _network_available;  ///< is network mode available?
 bool _network_dedicated;  ///< are we a dedicated server?
 bool _is_network_server;  ///< Does this client wants to be a network-server?
 bool _network_settings_access; ///< Can this client change server settings?
+bool _network_catching_up;     ///< Is this client running a large backlog of frames, e.g. after joining?
 NetworkCompanyState *_network_company_states = nullptr; ///< Statistics about some companies.
 std::string _network_company_server_id; ///< Server ID string used for company passwords
 uint8 _network_company_password_storage_token[16]; ///< Non-secret token for storage of company passwords in savegames
@@ -101,6 +102,7 @@ static_assert((int)NETWORK_COMPANY_NAME_LENGTH == MAX_LENGTH_COMPANY_NAME_CHARS
 byte _network_clients_connected = 0;
 
 extern std::string GenerateUid(std::string_view subject);
+extern void CallWindowGameTickEvent();
 
 /**
  * Return whether there is any client connected or trying to connect at all.
@@ -1319,9 +1321,23 @@ void NetworkGameLoop()
 
 		/* Make sure we are at the frame were the server is (quick-frames) */
 		if (_frame_counter_server > _frame_counter) {
+			/* When far behind, e.g. after downloading the map, nothing is drawn until all frames are done.
+			 * So do not update the windows each frame either, but only once after the last frame. */
+			const uint32 behind = _frame_counter_server - _frame_counter;
+			_network_catching_up = behind > DAY_TICKS;
+			if (_network_catching_up) DEBUG(net, 3, "Catching up %u frames", behind);
+
 			/* Run a number of frames; when things go bad, get out. */
 			while (_frame_counter_server > _frame_counter) {
-				if (!ClientNetworkGameSocketHandler::GameLoop()) return;
+				if (!ClientNetworkGameSocketHandler::GameLoop()) {
+					_network_catching_up = false;
+					return;
+				}
+			}
+
+			if (_network_catching_up) {
+				_network_catching_up = false;
+				CallWindowGameTickEvent();
 			}
 		} else {
 			/* Else, keep on going till _frame_counter_max */
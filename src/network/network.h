@@ -21,5 +21,6 @@ extern bool _network_available;  ///< is network mode available?
 extern bool _network_dedicated;  ///< are we a dedicated server?
 extern bool _is_network_server;  ///< Does this client wants to be a network-server?
 extern bool _network_settings_access;  ///< Can this client change server settings?
+extern bool _network_catching_up; ///< Is this client running a large backlog of frames, e.g. after joining?
 
 #endif /* NETWORK_H */
@@ -19,6 +19,7 @@
 #include "../console_func.h"
 #include "../core/pool_func.hpp"
 #include "../map_func.h"
+#include "../station_base.h"
 #include "../rev.h"
 #include "../game/game.hpp"
 
@@ -55,6 +56,7 @@ static const AdminUpdateFrequency _admin_update_type_frequencies[] = {
 	ADMIN_FREQUENCY_POLL,                                                                                                                                  ///< ADMIN_UPDATE_CMD_NAMES
 	                       ADMIN_FREQUENCY_AUTOMATIC,                                                                                                      ///< ADMIN_UPDATE_CMD_LOGGING
 	                       ADMIN_FREQUENCY_AUTOMATIC,                                                                                                      ///< ADMIN_UPDATE_GAMESCRIPT
+	ADMIN_FREQUENCY_POLL | ADMIN_FREQUENCY_DAILY | ADMIN_FREQUENCY_WEEKLY | ADMIN_FREQUENCY_MONTHLY | ADMIN_FREQUENCY_QUARTERLY | ADMIN_FREQUENCY_ANUALLY, ///< ADMIN_UPDATE_STATION_CARGO
 };
 /** Sanity check. */
 static_assert(lengthof(_admin_update_type_frequencies) == ADMIN_UPDATE_END);
@@ -191,6 +193,9 @@ NetworkRecvStatus ServerNetworkAdminSocketHandler::SendWelcome()
 /** Tell the admin we started a new game. */
 NetworkRecvStatus ServerNetworkAdminSocketHandler::SendNewGame()
 {
+	/* The stations of the previous game are gone, without the admin being told. */
+	this->station_cargo_sent.clear();
+
 	Packet *p = new Packet(ADMIN_PACKET_SERVER_NEWGAME);
 	this->SendPacket(p);
 	return NETWORK_RECV_STATUS_OKAY;
@@ -438,6 +443,68 @@ NetworkRecvStatus ServerNetworkAdminSocketHandler::SendCompanyStats()
 	return NETWORK_RECV_STATUS_OKAY;
 }
 
+/**
+ * Send the changes of the cargo waiting at stations since the previous call.
+ * The amounts that were sent are remembered per admin, so each admin only gets the changes at its own update frequency.
+ */
+NetworkRecvStatus ServerNetworkAdminSocketHandler::SendStationCargo()
+{
+	Packet *p = new Packet(ADMIN_PACKET_SERVER_STATION_CARGO);
+
+	auto send_entry = [&](uint32 key, uint32 amount) {
+		/* Should COMPAT_MTU be exceeded, start a new packet
+		 * (magic 9: 1 bool "more data", one uint16 station id, one
+		 * uint8 cargo id, one uint32 amount and 1 bool "no more data") */
+		if (!p->CanWriteToPacket(9)) {
+			p->Send_bool(false);
+			this->SendPacket(p);
+
+			p = new Packet(ADMIN_PACKET_SERVER_STATION_CARGO);
+		}
+
+		p->Send_bool(true);
+		p->Send_uint16(GB(key, 8, 16));
+		p->Send_uint8(GB(key, 0, 8));
+		p->Send_uint32(amount);
+	};
+
+	for (const Station *st : Station::Iterate()) {
+		for (CargoID c = 0; c < NUM_CARGO; c++) {
+			const uint32 key = (st->index << 8) | c;
+			const uint amount = st->goods[c].CargoTotalCount();
+			auto it = this->station_cargo_sent.find(key);
+			if (it == this->station_cargo_sent.end()) {
+				if (amount == 0) continue;
+				this->station_cargo_sent[key] = amount;
+			} else {
+				if (it->second == amount) continue;
+				if (amount == 0) {
+					this->station_cargo_sent.erase(it);
+				} else {
+					it->second = amount;
+				}
+			}
+			send_entry(key, amount);
+		}
+	}
+
+	/* Tell about the cargo at stations which have been removed. */
+	for (auto it = this->station_cargo_sent.begin(); it != this->station_cargo_sent.end();) {
+		if (Station::IsValidID(GB(it->first, 8, 16))) {
+			++it;
+		} else {
+			send_entry(it->first, 0);
+			it = this->station_cargo_sent.erase(it);
+		}
+	}
+
+	/* Marker to notify the end of the packet has been reached. */
+	p->Send_bool(false);
+	this->SendPacket(p);
+
+	return NETWORK_RECV_STATUS_OKAY;
+}
+
 /**
  * Send a chat message.
  * @param action The action associated with the message.
@@ -686,6 +753,8 @@ NetworkRecvStatus ServerNetworkAdminSocketHandler::Receive_ADMIN_UPDATE_FREQUENC
 	this->update_frequency[type] = freq;
 
 	if (type == ADMIN_UPDATE_CONSOLE) DebugReconsiderSendRemoteMessages();
+	/* Start over with a full update. */
+	if (type == ADMIN_UPDATE_STATION_CARGO) this->station_cargo_sent.clear();
 
 	return NETWORK_RECV_STATUS_OKAY;
 }
@@ -747,6 +816,12 @@ NetworkRecvStatus ServerNetworkAdminSocketHandler::Receive_ADMIN_POLL(Packet *p)
 			this->SendCmdNames();
 			break;
 
+		case ADMIN_UPDATE_STATION_CARGO:
+			/* The admin is requesting all cargo waiting at stations. */
+			this->station_cargo_sent.clear();
+			this->SendStationCargo();
+			break;
+
 		default:
 			/* An unsupported "poll" update type. */
 			DEBUG(net, 1, "[admin] Not supported poll %d (%d) from '%s' (%s).", type, d1, this->admin_name.c_str(), this->admin_version.c_str());
@@ -1014,6 +1089,10 @@ void NetworkAdminUpdate(AdminUpdateFrequency freq)
 						as->SendCompanyStats();
 						break;
 
+					case ADMIN_UPDATE_STATION_CARGO:
+						as->SendStationCargo();
+						break;
+
 					default: NOT_REACHED();
 				}
 			}
@@ -14,6 +14,8 @@
 #include "core/tcp_listen.h"
 #include "core/tcp_admin.h"
 
+#include <map>
+
 extern AdminIndex _redirect_console_to_admin;
 
 class ServerNetworkAdminSocketHandler;
@@ -40,6 +42,7 @@ public:
 	AdminUpdateFrequency update_frequency[ADMIN_UPDATE_END]; ///< Admin requested update intervals.
 	std::chrono::steady_clock::time_point connect_time;      ///< Time of connection.
 	NetworkAddress address;                                  ///< Address of the admin.
+	std::map<uint32, uint32> station_cargo_sent;             ///< Cargo waiting per station and cargo, as last sent to the admin. Keyed by station ID << 8 | cargo ID.
 
 	ServerNetworkAdminSocketHandler(SOCKET s);
 	~ServerNetworkAdminSocketHandler();
@@ -61,6 +64,7 @@ public:
 	NetworkRecvStatus SendCompanyRemove(CompanyID company_id, AdminCompanyRemoveReason bcrr);
 	NetworkRecvStatus SendCompanyEconomy();
 	NetworkRecvStatus SendCompanyStats();
+	NetworkRecvStatus SendStationCargo();
 
 	NetworkRecvStatus SendChat(NetworkAction action, DestType desttype, ClientID client_id, const std::string &msg, NetworkTextMessageData data);
 	NetworkRecvStatus SendRcon(uint16 colour, const std::string_view command);
@@ -38,6 +38,11 @@
 
 #include "table/strings.h"
 
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+
 #include "../safeguards.h"
 
 /* This file handles all the client-commands */
@@ -101,6 +106,29 @@ struct PacketReader : LoadFilter {
 		p->TransferOutWithLimit(TransferOutMemCopy, this->bufe - this->buf, this);
 	}
 
+	/**
+	 * Add raw bytes to this buffer.
+	 * @param data The bytes to add.
+	 * @param len  The number of bytes to add.
+	 */
+	void AddBytes(const byte *data, size_t len)
+	{
+		assert(this->read_bytes == 0);
+		while (len > 0) {
+			if (this->buf == this->bufe) {
+				this->blocks.push_back(this->buf = CallocT<byte>(CHUNK));
+				this->bufe = this->buf + CHUNK;
+			}
+
+			size_t to_copy = std::min<size_t>(this->bufe - this->buf, len);
+			memcpy(this->buf, data, to_copy);
+			this->buf += to_copy;
+			this->written_bytes += to_copy;
+			data += to_copy;
+			len -= to_copy;
+		}
+	}
+
 	size_t Read(byte *rbuf, size_t size) override
 	{
 		/* Limit the amount to read to whatever we still have. */
@@ -133,6 +161,146 @@ struct PacketReader : LoadFilter {
 	}
 };
 
+/**
+ * Decompresses the savegame on a separate thread while it is being downloaded.
+ * The decompressed savegame is stored in memory, so only the chunk loading remains to be done once the download is complete.
+ */
+struct MapDecompressor {
+	/** Filter which hands the data received so far to the decompressor, and waits for more when needed. */
+	struct DownloadReader : LoadFilter {
+		MapDecompressor *owner; ///< The decompressor we read the received data of.
+
+		DownloadReader(MapDecompressor *owner) : LoadFilter(nullptr), owner(owner) {}
+
+		size_t Read(byte *buf, size_t size) override
+		{
+			MapDecompressor *self = this->owner;
+			size_t read = 0;
+			std::unique_lock<std::mutex> lk(self->mutex);
+			while (read < size && !self->abort) {
+				if (self->received.empty()) {
+					if (self->received_all) break;
+					self->received_cv.wait(lk);
+					continue;
+				}
+
+				std::vector<byte> &front = self->received.front();
+				size_t to_read = std::min(size - read, front.size() - self->received_offset);
+				memcpy(buf + read, front.data() + self->received_offset, to_read);
+				read += to_read;
+				self->received_offset += to_read;
+				if (self->received_offset == front.size()) {
+					self->received.pop_front();
+					self->received_offset = 0;
+				}
+			}
+			return read;
+		}
+	};
+
+	std::mutex mutex;
+	std::condition_variable received_cv;   ///< Signalled when data has been received, or the download is done or aborted.
+	std::deque<std::vector<byte>> received; ///< Received data which has not been decompressed yet.
+	size_t received_offset = 0;           ///< Number of bytes of the front of #received which have already been decompressed.
+	bool received_all = false;            ///< Whether the download is complete.
+	bool abort = false;                   ///< Whether the decompression should stop as soon as possible.
+	bool finished = false;                ///< Whether the decompression thread no longer reads received data.
+
+	PacketReader *output;                 ///< The uncompressed savegame, only accessed by the thread until it is joined.
+	bool success = false;                 ///< Whether the whole savegame was decompressed, only valid once the thread is joined.
+	std::thread thread;
+
+	MapDecompressor() : output(new PacketReader())
+	{
+		if (!StartNewThread(&this->thread, "ottd:mapdecomp", &MapDecompressor::RunThread, this)) {
+			DEBUG(net, 1, "Failed to start map decompression thread, decompressing after the download");
+		}
+	}
+
+	~MapDecompressor()
+	{
+		this->Stop(true);
+		delete this->output;
+	}
+
+	/**
+	 * Pass data which has been received to the decompressor.
+	 * @param data The received data.
+	 * @param len  The number of received bytes.
+	 */
+	void AddData(const byte *data, size_t len)
+	{
+		if (!this->thread.joinable() || len == 0) return;
+
+		std::lock_guard<std::mutex> lk(this->mutex);
+		if (this->finished) return;
+		this->received.emplace_back(data, data + len);
+		this->received_cv.notify_one();
+	}
+
+	/**
+	 * Wait for the decompression thread to finish.
+	 * @param abort Whether to stop the decompression, instead of letting it finish decompressing the remaining received data.
+	 */
+	void Stop(bool abort)
+	{
+		{
+			std::lock_guard<std::mutex> lk(this->mutex);
+			this->received_all = true;
+			if (abort) this->abort = true;
+			this->received_cv.notify_one();
+		}
+		if (this->thread.joinable()) this->thread.join();
+	}
+
+	/**
+	 * Wait for the decompression to finish, and take the uncompressed savegame.
+	 * @return The uncompressed savegame, ready for reading, or nullptr if the savegame could not be decompressed ahead.
+	 */
+	LoadFilter *Finish()
+	{
+		this->Stop(false);
+		if (!this->success) return nullptr;
+
+		PacketReader *lf = this->output;
+		this->output = nullptr;
+		lf->Reset();
+		return lf;
+	}
+
+	static void RunThread(MapDecompressor *self)
+	{
+		LoadFilter *lf = new DownloadReader(self);
+		try {
+			uint32 hdr[2];
+			if (lf->Read((byte *)hdr, sizeof(hdr)) == sizeof(hdr)) {
+				LoadFilter *decompressor = CreateSavegameDecompressionFilter(hdr, lf);
+				if (decompressor != nullptr) {
+					lf = decompressor;
+					self->output->AddBytes((const byte *)hdr, sizeof(hdr));
+
+					std::unique_ptr<byte[]> buf(new byte[PacketReader::CHUNK]);
+					size_t read;
+					while ((read = lf->Read(buf.get(), PacketReader::CHUNK)) != 0) {
+						self->output->AddBytes(buf.get(), read);
+					}
+
+					std::lock_guard<std::mutex> lk(self->mutex);
+					self->success = !self->abort && self->received_all && self->received.empty();
+				}
+			}
+		} catch (...) {
+			/* Leave it to the normal load to report the error. */
+		}
+		{
+			std::lock_guard<std::mutex> lk(self->mutex);
+			self->finished = true;
+			self->received.clear();
+		}
+		if (!self->success) DEBUG(net, 3, "Could not decompress map during download, decompressing after the download");
+		delete lf;
+	}
+};
 
 /**
  * Create an emergency savegame when the network connection is lost.
@@ -154,7 +322,7 @@ void ClientNetworkEmergencySave()
  */
 ClientNetworkGameSocketHandler::ClientNetworkGameSocketHandler (SOCKET s, std::string connection_string)
 	: NetworkGameSocketHandler(s),
-	  connection_string(std::move(connection_string)), savegame(nullptr), token(0), status(STATUS_INACTIVE)
+	  connection_string(std::move(connection_string)), savegame(nullptr), map_decompressor(nullptr), token(0), status(STATUS_INACTIVE)
 {
 	assert(ClientNetworkGameSocketHandler::my_client == nullptr);
 	ClientNetworkGameSocketHandler::my_client = this;
@@ -167,6 +335,7 @@ ClientNetworkGameSocketHandler::~ClientNetworkGameSocketHandler()
 	ClientNetworkGameSocketHandler::my_client = nullptr;
 	_network_settings_access = false;
 
+	delete this->map_decompressor;
 	delete this->savegame;
 	delete this->GetInfo();
 
@@ -656,9 +825,25 @@ NetworkRecvStatus ClientNetworkGameSocketHandler::SendDesyncSyncData()
 	}
 
 	Packet *p = new Packet(PACKET_CLIENT_DESYNC_SYNC_DATA, SHRT_MAX);
-	p->Send_uint32((uint32)_network_sync_record_counts.size());
-	uint32 offset = 0;
+
+	/* The records since the last good sync frame can exceed a single packet.
+	 * The first divergent record is the interesting one, so send as many of the earliest frames as fit. */
+	uint32 frame_count = 0;
+	size_t bytes = sizeof(uint32);
 	for (uint32 count : _network_sync_record_counts) {
+		size_t frame_bytes = sizeof(uint32) + count * (sizeof(uint32) + sizeof(uint32) + sizeof(uint64));
+		if (!p->CanWriteToPacket(bytes + frame_bytes)) break;
+		bytes += frame_bytes;
+		frame_count++;
+	}
+	if (frame_count < _network_sync_record_counts.size()) {
+		DEBUG(net, 1, "Network sync records truncated to %u of %u frames", frame_count, (uint)_network_sync_record_counts.size());
+	}
+
+	p->Send_uint32(frame_count);
+	uint32 offset = 0;
+	for (uint32 f = 0; f < frame_count; f++) {
+		const uint32 count = _network_sync_record_counts[f];
 		p->Send_uint32(count);
 		for (uint i = 0; i < count; i++) {
 			const NetworkSyncRecord &record = _network_sync_records[offset + i];
@@ -981,8 +1166,10 @@ NetworkRecvStatus ClientNetworkGameSocketHandler::Receive_SERVER_MAP_BEGIN(Packe
 	if (this->savegame != nullptr) return NETWORK_RECV_STATUS_MALFORMED_PACKET;
 
 	this->savegame = new PacketReader();
+	this->map_decompressor = new MapDecompressor();
 
 	_frame_counter = _frame_counter_server = _frame_counter_max = p->Recv_uint32();
+	this->map_begin_time = std::chrono::steady_clock::now();
 
 	_network_join_bytes = 0;
 	_network_join_bytes_total = 0;
@@ -1010,6 +1197,7 @@ NetworkRecvStatus ClientNetworkGameSocketHandler::Receive_SERVER_MAP_DATA(Packet
 	if (this->savegame == nullptr) return NETWORK_RECV_STATUS_MALFORMED_PACKET;
 
 	/* We are still receiving data, put it to the file */
+	if (this->map_decompressor != nullptr) this->map_decompressor->AddData((const byte *)p->GetBufferData() + p->GetRawPos(), p->RemainingBytesToTransfer());
 	this->savegame->AddPacket(p);
 
 	_network_join_bytes = (uint32)this->savegame->written_bytes;
@@ -1026,6 +1214,10 @@ NetworkRecvStatus ClientNetworkGameSocketHandler::Receive_SERVER_MAP_DONE(Packet
 	_network_join_status = NETWORK_JOIN_STATUS_PROCESSING;
 	SetWindowDirty(WC_NETWORK_STATUS_WINDOW, WN_NETWORK_STATUS_WINDOW_JOIN);
 
+	const std::chrono::steady_clock::time_point map_done_time = std::chrono::steady_clock::now();
+	DEBUG(net, 1, "Downloaded the map (" PRINTF_SIZE " bytes) in %u ms", this->savegame->written_bytes,
+			(uint)std::chrono::duration_cast<std::chrono::milliseconds>(map_done_time - this->map_begin_time).count());
+
 	/*
 	 * Make sure everything is set for reading.
 	 *
@@ -1033,9 +1225,20 @@ NetworkRecvStatus ClientNetworkGameSocketHandler::Receive_SERVER_MAP_DONE(Packet
 	 * loading fails the network gets reset upon loading the intro
 	 * game, which would cause us to free this->savegame twice.
 	 */
-	LoadFilter *lf = this->savegame;
+	LoadFilter *lf = nullptr;
+	if (this->map_decompressor != nullptr) {
+		lf = this->map_decompressor->Finish();
+		delete this->map_decompressor;
+		this->map_decompressor = nullptr;
+	}
+	if (lf != nullptr) {
+		/* The savegame has already been decompressed while downloading. */
+		delete this->savegame;
+	} else {
+		lf = this->savegame;
+		lf->Reset();
+	}
 	this->savegame = nullptr;
-	lf->Reset();
 
 	/* The map is done downloading, load it */
 	ClearErrorMessages();
@@ -1044,6 +1247,7 @@ NetworkRecvStatus ClientNetworkGameSocketHandler::Receive_SERVER_MAP_DONE(Packet
 
 	/* Long savegame loads shouldn't affect the lag calculation! */
 	this->last_packet = std::chrono::steady_clock::now();
+	DEBUG(net, 1, "Loaded the map in %u ms", (uint)std::chrono::duration_cast<std::chrono::milliseconds>(this->last_packet - map_done_time).count());
 
 	if (!load_success) {
 		StringID detail = INVALID_STRING_ID;
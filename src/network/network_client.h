@@ -17,6 +17,8 @@ class ClientNetworkGameSocketHandler : public NetworkGameSocketHandler {
 private:
 	std::string connection_string; ///< Address we are connected to.
 	struct PacketReader *savegame; ///< Packet reader for reading the savegame.
+	struct MapDecompressor *map_decompressor; ///< Decompressor of the savegame while it is being downloaded.
+	std::chrono::steady_clock::time_point map_begin_time; ///< When the download of the map started.
 	byte token;                    ///< The token we need to send back to the server to prove we're the right client.
 	NetworkSharedSecrets last_rcon_shared_secrets; ///< Keys for last rcon (and incoming replies)
 
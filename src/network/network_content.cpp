@@ -586,9 +586,22 @@ bool ClientNetworkContentSocketHandler::IsCancelled() const
 	return this->isCancelled;
 }
 
+/** How often an interrupted HTTP download of a single file is resumed before falling back. */
+static const uint MAX_HTTP_FILE_RESUMES = 3;
+
 /* Also called to just clean up the mess. */
 void ClientNetworkContentSocketHandler::OnFailure()
 {
+	/* A transfer that broke off halfway continues where it stopped, instead of starting all remaining content over via the 'old' system. */
+	if (this->curFile != nullptr && !this->isCancelled && !this->http_file_uri.empty() && this->http_file_received > 0 &&
+			this->http_file_received < (size_t)this->curInfo->filesize && this->http_file_resumes < MAX_HTTP_FILE_RESUMES) {
+		this->http_file_resumes++;
+		DEBUG(net, 1, "Resuming HTTP download of %s at " PRINTF_SIZE " bytes", this->curInfo->filename.c_str(), this->http_file_received);
+		NetworkHTTPSocketHandler::Connect(this->http_file_uri, this, "", this->http_file_received);
+		return;
+	}
+
+	this->http_file_uri.clear();
 	this->http_response.clear();
 	this->http_response.shrink_to_fit();
 	this->http_response_index = -2;
@@ -633,9 +646,11 @@ void ClientNetworkContentSocketHandler::OnReceiveData(const char *data, size_t l
 		/* We have data, so write it to the file. */
 		if (fwrite(data, 1, length, this->curFile) != length) {
 			/* Writing failed somehow, let try via the old method. */
+			this->http_file_uri.clear();
 			this->OnFailure();
 		} else {
 			/* Just received the data. */
+			this->http_file_received += length;
 			this->OnDownloadProgress(this->curInfo, (int)length);
 		}
 		/* Nothing more to do now. */
@@ -644,6 +659,7 @@ void ClientNetworkContentSocketHandler::OnReceiveData(const char *data, size_t l
 
 	if (this->curFile != nullptr) {
 		/* We've finished downloading a file. */
+		this->http_file_uri.clear();
 		this->AfterDownload();
 	}
 
@@ -725,7 +741,10 @@ void ClientNetworkContentSocketHandler::OnReceiveData(const char *data, size_t l
 			return;
 		}
 
-		NetworkHTTPSocketHandler::Connect(str, this);
+		this->http_file_uri = str;
+		this->http_file_received = 0;
+		this->http_file_resumes = 0;
+		NetworkHTTPSocketHandler::Connect(this->http_file_uri, this);
 		return;
 	}
 
@@ -739,6 +758,8 @@ void ClientNetworkContentSocketHandler::OnReceiveData(const char *data, size_t l
 ClientNetworkContentSocketHandler::ClientNetworkContentSocketHandler() :
 	NetworkContentSocketHandler(),
 	http_response_index(-2),
+	http_file_received(0),
+	http_file_resumes(0),
 	curFile(nullptr),
 	curInfo(nullptr),
 	isConnecting(false),
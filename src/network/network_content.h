@@ -74,6 +74,9 @@ protected:
 	btree::btree_multimap<ContentID, ContentID> reverse_dependency_map; ///< Content reverse dependency map
 	std::vector<char> http_response;              ///< The HTTP response to the requests we've been doing
 	int http_response_index;                      ///< Where we are, in the response, with handling it
+	std::string http_file_uri;                    ///< URI of the file currently downloaded over HTTP, empty when it can't be resumed
+	size_t http_file_received;                    ///< Bytes of the current HTTP file written so far
+	uint http_file_resumes;                       ///< Number of times the current HTTP file has been resumed
 
 	FILE *curFile;        ///< Currently downloaded file
 	ContentInfo *curInfo; ///< Information about the currently downloaded file
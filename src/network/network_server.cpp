@@ -60,21 +60,24 @@ INSTANTIATE_POOL_METHODS(NetworkClientSocket)
 /** Instantiate the listen sockets. */
 template SocketList TCPListenHandler<ServerNetworkGameSocketHandler, PACKET_SERVER_FULL, PACKET_SERVER_BANNED>::sockets;
 
-/** Writing a savegame directly to a number of packets. */
+/**
+ * Writing a savegame directly to a number of packets.
+ * All clients which start receiving the map in the same frame share the savegame, and receive copies of its packets.
+ */
 struct PacketWriter : SaveFilter {
-	ServerNetworkGameSocketHandler *cs; ///< Socket we are associated with.
+	std::vector<ServerNetworkGameSocketHandler *> clients; ///< Sockets still receiving the savegame.
 	std::unique_ptr<Packet> current;    ///< The packet we're currently writing to.
 	size_t total_size;                  ///< Total size of the compressed savegame.
-	std::vector<std::unique_ptr<Packet>> packets; ///< Packet queue of the savegame; send these "slowly" to the client.
-	std::unique_ptr<Packet> map_size_packet; ///< Map size packet, fast tracked to the client
+	std::chrono::steady_clock::time_point finish_time; ///< When making the savegame finished.
+	std::vector<std::unique_ptr<Packet>> packets; ///< Packet queue of the savegame; send these "slowly" to the clients. Packets sent to all clients are released.
+	std::unique_ptr<Packet> map_size_packet; ///< Map size packet, fast tracked to the clients
 	std::mutex mutex;                   ///< Mutex for making threaded saving safe.
 	std::condition_variable exit_sig;   ///< Signal for threaded destruction of this packet writer.
 
 	/**
 	 * Create the packet writer.
-	 * @param cs The socket handler we're making the packets for.
 	 */
-	PacketWriter(ServerNetworkGameSocketHandler *cs) : SaveFilter(nullptr), cs(cs), total_size(0)
+	PacketWriter() : SaveFilter(nullptr), total_size(0)
 	{
 	}
 
@@ -83,7 +86,7 @@ struct PacketWriter : SaveFilter {
 	{
 		std::unique_lock<std::mutex> lock(this->mutex);
 
-		if (this->cs != nullptr) this->exit_sig.wait(lock);
+		this->exit_sig.wait(lock, [&]() { return this->clients.empty(); });
 
 		/* This must all wait until the Destroy function is called. */
 
@@ -93,20 +96,38 @@ struct PacketWriter : SaveFilter {
 	}
 
 	/**
-	 * Begin the destruction of this packet writer. It can happen in two ways:
+	 * Add a client which receives this savegame.
+	 * @param cs The socket handler to send the packets to.
+	 */
+	void AddClient(ServerNetworkGameSocketHandler *cs)
+	{
+		std::lock_guard<std::mutex> lock(this->mutex);
+
+		this->clients.push_back(cs);
+		cs->savegame_packets_sent = 0;
+		cs->savegame_size_sent = false;
+	}
+
+	/**
+	 * Stop sending this savegame to a client. When there are no more clients,
+	 * the destruction of this packet writer begins. It can happen in two ways:
 	 * in the first case the client disconnected while saving the map. In this
-	 * case the saving has not finished and killed this PacketWriter. In that
-	 * case we simply set cs to nullptr, triggering the appending to fail due to
-	 * the connection problem and eventually triggering the destructor. In the
-	 * second case the destructor is already called, and it is waiting for our
-	 * signal which we will send. Only then the packets will be removed by the
-	 * destructor.
+	 * case the saving has not finished, and the list of clients being empty
+	 * triggers the appending to fail due to the connection problem, and
+	 * eventually triggers the destructor. In the second case the destructor is
+	 * already called, and it is waiting for our signal which we will send.
+	 * Only then the packets will be removed by the destructor.
+	 * @param cs The socket handler which no longer receives this savegame.
 	 */
-	void Destroy()
+	void Destroy(ServerNetworkGameSocketHandler *cs)
 	{
 		std::unique_lock<std::mutex> lock(this->mutex);
 
-		this->cs = nullptr;
+		this->clients.erase(std::find(this->clients.begin(), this->clients.end(), cs));
+		if (!this->clients.empty()) {
+			this->ReleaseSentPackets();
+			return;
+		}
 
 		this->exit_sig.notify_all();
 		lock.unlock();
@@ -117,6 +138,14 @@ struct PacketWriter : SaveFilter {
 		WaitTillSaved();
 	}
 
+	/** Release the packets which have been transferred to all clients, while holding the lock on our mutex. */
+	void ReleaseSentPackets()
+	{
+		size_t sent = SIZE_MAX;
+		for (const ServerNetworkGameSocketHandler *cs : this->clients) sent = std::min(sent, cs->savegame_packets_sent);
+		for (size_t i = 0; i < sent && i < this->packets.size(); i++) this->packets[i].reset();
+	}
+
 	/**
 	 * Transfer all packets from here to the network's queue while holding
 	 * the lock on our mutex.
@@ -127,17 +156,26 @@ struct PacketWriter : SaveFilter {
 	{
 		std::lock_guard<std::mutex> lock(this->mutex);
 
-		if (this->map_size_packet) {
+		/* When this is the only client, the packets can be handed over rather than copied. */
+		const bool shared = this->clients.size() > 1;
+
+		if (this->map_size_packet && !socket->savegame_size_sent) {
 			/* Don't queue the PACKET_SERVER_MAP_SIZE before the corresponding PACKET_SERVER_MAP_BEGIN */
-			socket->SendPrependPacket(std::move(this->map_size_packet), PACKET_SERVER_MAP_BEGIN);
+			socket->SendPrependPacket(shared ? std::make_unique<Packet>(*this->map_size_packet) : std::move(this->map_size_packet), PACKET_SERVER_MAP_BEGIN);
+			socket->savegame_size_sent = true;
 		}
 		bool last_packet = false;
-		for (auto &p : this->packets) {
+		for (; socket->savegame_packets_sent < this->packets.size(); socket->savegame_packets_sent++) {
+			std::unique_ptr<Packet> &p = this->packets[socket->savegame_packets_sent];
 			if (p->GetPacketType() == PACKET_SERVER_MAP_DONE) last_packet = true;
-			socket->SendPacket(std::move(p));
+			socket->SendPacket(shared ? std::make_unique<Packet>(*p) : std::move(p));
+		}
+		if (shared) this->ReleaseSentPackets();
 
+		if (last_packet) {
+			socket->join_phase_times[ServerNetworkGameSocketHandler::JOIN_PHASE_MAP_SAVED] = this->finish_time;
+			socket->MarkJoinPhase(ServerNetworkGameSocketHandler::JOIN_PHASE_MAP_QUEUED);
 		}
-		this->packets.clear();
 
 		return last_packet;
 	}
@@ -152,13 +190,13 @@ struct PacketWriter : SaveFilter {
 
 	void Write(byte *buf, size_t size) override
 	{
-		/* We want to abort the saving when the socket is closed. */
-		if (this->cs == nullptr) SlError(STR_NETWORK_ERROR_LOSTCONNECTION);
-
 		if (this->current == nullptr) this->current.reset(new Packet(PACKET_SERVER_MAP_DATA, SHRT_MAX));
 
 		std::lock_guard<std::mutex> lock(this->mutex);
 
+		/* We want to abort the saving when the sockets are closed. */
+		if (this->clients.empty()) SlError(STR_NETWORK_ERROR_LOSTCONNECTION);
+
 		byte *bufe = buf + size;
 		while (buf != bufe) {
 			size_t written = this->current->Send_binary_until_full(buf, bufe);
@@ -175,11 +213,11 @@ struct PacketWriter : SaveFilter {
 
 	void Finish() override
 	{
-		/* We want to abort the saving when the socket is closed. */
-		if (this->cs == nullptr) SlError(STR_NETWORK_ERROR_LOSTCONNECTION);
-
 		std::lock_guard<std::mutex> lock(this->mutex);
 
+		/* We want to abort the saving when the sockets are closed. */
+		if (this->clients.empty()) SlError(STR_NETWORK_ERROR_LOSTCONNECTION);
+
 		/* Make sure the last packet is flushed. */
 		this->AppendQueue();
 
@@ -190,6 +228,8 @@ struct PacketWriter : SaveFilter {
 		/* Fast-track the size to the client. */
 		this->map_size_packet.reset(new Packet(PACKET_SERVER_MAP_SIZE, SHRT_MAX));
 		this->map_size_packet->Send_uint32((uint32)this->total_size);
+
+		this->finish_time = std::chrono::steady_clock::now();
 	}
 };
 
@@ -202,6 +242,7 @@ ServerNetworkGameSocketHandler::ServerNetworkGameSocketHandler(SOCKET s) : Netwo
 {
 	this->status = STATUS_INACTIVE;
 	this->client_id = _network_client_id++;
+	this->MarkJoinPhase(JOIN_PHASE_CONNECTED);
 	this->receive_limit = _settings_client.network.bytes_per_frame_burst;
 
 	/* The Socket and Info pools need to be the same in size. After all,
@@ -224,7 +265,7 @@ ServerNetworkGameSocketHandler::~ServerNetworkGameSocketHandler()
 	RemoveVirtualTrainsOfUser(this->client_id);
 
 	if (this->savegame != nullptr) {
-		this->savegame->Destroy();
+		this->savegame->Destroy(this);
 		this->savegame = nullptr;
 	}
 }
@@ -328,8 +369,8 @@ NetworkRecvStatus ServerNetworkGameSocketHandler::CloseConnection(NetworkRecvSta
 	/* If we were transfering a map to this client, stop the savegame creation
 	 * process and queue the next client to receive the map. */
 	if (this->status == STATUS_MAP) {
-		/* Ensure the saving of the game is stopped too. */
-		this->savegame->Destroy();
+		/* Ensure the saving of the game is stopped too, unless other clients share it. */
+		this->savegame->Destroy(this);
 		this->savegame = nullptr;
 
 		this->CheckNextClientToSendMap(this);
@@ -412,23 +453,72 @@ NetworkRecvStatus ServerNetworkGameSocketHandler::SendClientInfo(NetworkClientIn
 	return NETWORK_RECV_STATUS_OKAY;
 }
 
+/**
+ * Serialised game info reply, kept so that repeated queries, e.g. from server listings
+ * and scanners, do not serialise the whole game info including the NewGRF list each time.
+ * It is valid as long as the static game info has not been refilled and the dynamic parts
+ * of the game info are unchanged.
+ */
+struct GameInfoReplyCache {
+	std::unique_ptr<Packet> packet;  ///< The serialised reply, nullptr when there is none.
+	uint32 static_generation;        ///< #_network_game_info_static_generation of the reply.
+	Date game_date;                  ///< #NetworkServerGameInfo::game_date of the reply.
+	byte clients_on;                 ///< #NetworkServerGameInfo::clients_on of the reply.
+	byte companies_on;               ///< #NetworkServerGameInfo::companies_on of the reply.
+	byte spectators_on;              ///< #NetworkServerGameInfo::spectators_on of the reply.
+	PacketGameType reply_type;       ///< Packet type of the reply.
+	uint16 flags;                    ///< Requested flags of an extended reply.
+	uint16 version;                  ///< Requested version of an extended reply.
+
+	/**
+	 * Get a copy of the cached reply, regenerating it when it is out of date.
+	 * @param reply_type The packet type of the reply.
+	 * @param flags The requested flags of an extended reply.
+	 * @param version The requested version of an extended reply.
+	 * @param serialise Function to serialise a new reply into the given packet.
+	 * @return The reply packet to send.
+	 */
+	template <typename F>
+	Packet *GetReply(PacketGameType reply_type, uint16 flags, uint16 version, F serialise)
+	{
+		const NetworkServerGameInfo *info = GetCurrentNetworkServerGameInfo();
+		if (this->packet == nullptr || this->static_generation != _network_game_info_static_generation || this->game_date != info->game_date ||
+				this->clients_on != info->clients_on || this->companies_on != info->companies_on || this->spectators_on != info->spectators_on ||
+				this->reply_type != reply_type || this->flags != flags || this->version != version) {
+			this->packet.reset(new Packet(reply_type, reply_type == PACKET_SERVER_GAME_INFO ? TCP_MTU : SHRT_MAX));
+			serialise(this->packet.get(), info);
+
+			this->static_generation = _network_game_info_static_generation;
+			this->game_date = info->game_date;
+			this->clients_on = info->clients_on;
+			this->companies_on = info->companies_on;
+			this->spectators_on = info->spectators_on;
+			this->reply_type = reply_type;
+			this->flags = flags;
+			this->version = version;
+		}
+		return new Packet(*this->packet);
+	}
+};
+
+static GameInfoReplyCache _game_info_reply_cache;          ///< Cache of the game info reply.
+static GameInfoReplyCache _game_info_extended_reply_cache; ///< Cache of the extended game info reply.
+
 /** Send the client information about the server. */
 NetworkRecvStatus ServerNetworkGameSocketHandler::SendGameInfo()
 {
-	Packet *p = new Packet(PACKET_SERVER_GAME_INFO, TCP_MTU);
-	SerializeNetworkGameInfo(p, GetCurrentNetworkServerGameInfo());
-
-	this->SendPacket(p);
+	this->SendPacket(_game_info_reply_cache.GetReply(PACKET_SERVER_GAME_INFO, 0, 0, [](Packet *p, const NetworkServerGameInfo *info) {
+		SerializeNetworkGameInfo(p, info);
+	}));
 
 	return NETWORK_RECV_STATUS_OKAY;
 }
 
 NetworkRecvStatus ServerNetworkGameSocketHandler::SendGameInfoExtended(PacketGameType reply_type, uint16 flags, uint16 version)
 {
-	Packet *p = new Packet(reply_type, SHRT_MAX);
-	SerializeNetworkGameInfoExtended(p, GetCurrentNetworkServerGameInfo(), flags, version);
-
-	this->SendPacket(p);
+	this->SendPacket(_game_info_extended_reply_cache.GetReply(reply_type, flags, version, [&](Packet *p, const NetworkServerGameInfo *info) {
+		SerializeNetworkGameInfoExtended(p, info, flags, version);
+	}));
 
 	return NETWORK_RECV_STATUS_OKAY;
 }
@@ -562,6 +652,7 @@ NetworkRecvStatus ServerNetworkGameSocketHandler::SendWelcome()
 	if (this->status >= STATUS_AUTHORIZED) return this->CloseConnection(NETWORK_RECV_STATUS_MALFORMED_PACKET);
 
 	this->status = STATUS_AUTHORIZED;
+	this->MarkJoinPhase(JOIN_PHASE_AUTHORIZED);
 	/* Reset 'lag' counters */
 	this->last_frame = this->last_frame_server = _frame_counter;
 
@@ -613,6 +704,9 @@ void ServerNetworkGameSocketHandler::CheckNextClientToSendMap(NetworkClientSocke
 	for (NetworkClientSocket *new_cs : NetworkClientSocket::Iterate()) {
 		if (ignore_cs == new_cs) continue;
 
+		/* Wait until all clients sharing the current savegame have received it. */
+		if (new_cs->status == STATUS_MAP) return;
+
 		if (new_cs->status == STATUS_MAP_WAIT) {
 			if (best == nullptr || best->GetInfo()->join_date > new_cs->GetInfo()->join_date || (best->GetInfo()->join_date == new_cs->GetInfo()->join_date && best->client_id > new_cs->client_id)) {
 				best = new_cs;
@@ -633,6 +727,28 @@ void ServerNetworkGameSocketHandler::CheckNextClientToSendMap(NetworkClientSocke
 	}
 }
 
+/**
+ * Start sending a savegame, which is made in this frame, to this client.
+ * @param writer The writer of the savegame.
+ */
+void ServerNetworkGameSocketHandler::StartMapTransfer(PacketWriter *writer)
+{
+	this->savegame = writer;
+	writer->AddClient(this);
+	this->MarkJoinPhase(JOIN_PHASE_MAP_BEGIN);
+
+	/* Now send the _frame_counter and how many packets are coming */
+	Packet *p = new Packet(PACKET_SERVER_MAP_BEGIN, SHRT_MAX);
+	p->Send_uint32(_frame_counter);
+	this->SendPacket(p);
+
+	NetworkSyncCommandQueue(this);
+	this->status = STATUS_MAP;
+	/* Mark the start of download */
+	this->last_frame = _frame_counter;
+	this->last_frame_server = _frame_counter;
+}
+
 /** This sends the map to the client */
 NetworkRecvStatus ServerNetworkGameSocketHandler::SendMap()
 {
@@ -643,30 +759,30 @@ NetworkRecvStatus ServerNetworkGameSocketHandler::SendMap()
 
 	if (this->status == STATUS_AUTHORIZED) {
 		WaitTillSaved();
-		this->savegame = new PacketWriter(this);
-
-		/* Now send the _frame_counter and how many packets are coming */
-		Packet *p = new Packet(PACKET_SERVER_MAP_BEGIN, SHRT_MAX);
-		p->Send_uint32(_frame_counter);
-		this->SendPacket(p);
+		PacketWriter *writer = new PacketWriter();
+		this->StartMapTransfer(writer);
 
-		NetworkSyncCommandQueue(this);
-		this->status = STATUS_MAP;
-		/* Mark the start of download */
-		this->last_frame = _frame_counter;
-		this->last_frame_server = _frame_counter;
+		/* All other waiting clients which can load the same savegame format start receiving the same dump. */
+		uint shared = 0;
+		for (NetworkClientSocket *new_cs : NetworkClientSocket::Iterate()) {
+			if (new_cs != this && new_cs->status == STATUS_MAP_WAIT && new_cs->supports_zstd == this->supports_zstd) {
+				new_cs->StartMapTransfer(writer);
+				shared++;
+			}
+		}
+		if (shared > 0) DEBUG(net, 3, "[%s] Sending the map to client #%u and %u other waiting clients", ServerNetworkGameSocketHandler::GetName(), this->client_id, shared);
 
 		/* Make a dump of the current game */
 		SaveModeFlags flags = SMF_NET_SERVER;
 		if (this->supports_zstd) flags |= SMF_ZSTD_OK;
-		if (SaveWithFilter(this->savegame, true, flags) != SL_OK) usererror("network savedump failed");
+		if (SaveWithFilter(writer, true, flags) != SL_OK) usererror("network savedump failed");
 	}
 
 	if (this->status == STATUS_MAP) {
 		bool last_packet = this->savegame->TransferToNetworkQueue(this);
 		if (last_packet) {
 			/* Done reading, make sure saving is done as well */
-			this->savegame->Destroy();
+			this->savegame->Destroy(this);
 			this->savegame = nullptr;
 
 			/* Set the status to DONE_MAP, no we will wait for the client
@@ -947,6 +1063,8 @@ NetworkRecvStatus ServerNetworkGameSocketHandler::Receive_CLIENT_NEWGRFS_CHECKED
 		return this->SendError(NETWORK_ERROR_NOT_EXPECTED);
 	}
 
+	this->MarkJoinPhase(JOIN_PHASE_NEWGRFS_CHECKED);
+
 	NetworkClientInfo *ci = this->GetInfo();
 
 	/* We now want a password from the client else we do not allow them in! */
@@ -1122,6 +1240,7 @@ NetworkRecvStatus ServerNetworkGameSocketHandler::Receive_CLIENT_GETMAP(Packet *
 	}
 
 	this->supports_zstd = p->Recv_bool();
+	this->MarkJoinPhase(JOIN_PHASE_MAP_REQUESTED);
 
 	/* Check if someone else is receiving the map */
 	for (NetworkClientSocket *new_cs : NetworkClientSocket::Iterate()) {
@@ -1152,6 +1271,7 @@ NetworkRecvStatus ServerNetworkGameSocketHandler::Receive_CLIENT_MAP_OK(Packet *
 		/* Mark the client as pre-active, and wait for an ACK
 		 *  so we know it is done loading and in sync with us */
 		this->status = STATUS_PRE_ACTIVE;
+		this->MarkJoinPhase(JOIN_PHASE_MAP_LOADED);
 		NetworkHandleCommandQueue(this);
 		this->SendFrame();
 		this->SendSync();
@@ -1353,13 +1473,11 @@ NetworkRecvStatus ServerNetworkGameSocketHandler::Receive_CLIENT_DESYNC_SYNC_DAT
 		for (uint j = 0; j < item_count; j++) {
 			if (j == 0) {
 				frame = p->Recv_uint32();
-				while (_network_sync_records[record_offset].frame != frame) {
-					if (record_count_offset == _network_sync_record_counts.size()) {
-						return NETWORK_RECV_STATUS_OKAY;
-					}
+				while (record_count_offset < _network_sync_record_counts.size() && _network_sync_records[record_offset].frame != frame) {
 					record_offset += _network_sync_record_counts[record_count_offset];
 					record_count_offset++;
 				}
+				if (record_count_offset == _network_sync_record_counts.size()) return NETWORK_RECV_STATUS_OKAY;
 				local_item_count = _network_sync_record_counts[record_count_offset];
 			} else {
 				event = (NetworkSyncRecordEvents)p->Recv_uint32();
@@ -1436,6 +1554,8 @@ NetworkRecvStatus ServerNetworkGameSocketHandler::Receive_CLIENT_ACK(Packet *p)
 		/* Now it is! Unpause the game */
 		this->status = STATUS_ACTIVE;
 		this->last_token_frame = _frame_counter;
+		this->MarkJoinPhase(JOIN_PHASE_ACTIVE);
+		DEBUG(net, 1, "[%s] Client #%u finished joining, %s", ServerNetworkGameSocketHandler::GetName(), this->client_id, this->GetJoinTimings().c_str());
 
 		/* Execute script for, e.g. MOTD */
 		IConsoleCmdExec("exec scripts/on_server_connect.scr 0");
@@ -1770,6 +1890,46 @@ std::string ServerNetworkGameSocketHandler::GetDebugInfo() const
 	return stdstr_fmt("status: %d (%s)", this->status, GetClientStatusName(this->status));
 }
 
+/**
+ * Get the durations of the phases of joining of this client, as far as they have been reached.
+ * The transfer phase also includes loading the map by the client, as the server can not tell them apart.
+ * @return The formatted durations in milliseconds.
+ */
+std::string ServerNetworkGameSocketHandler::GetJoinTimings() const
+{
+	static const struct {
+		const char *name;
+		JoinPhase from;
+		JoinPhase to;
+	} timed_phases[] = {
+		{ "newgrf check", JOIN_PHASE_CONNECTED,       JOIN_PHASE_NEWGRFS_CHECKED },
+		{ "auth",         JOIN_PHASE_NEWGRFS_CHECKED, JOIN_PHASE_AUTHORIZED },
+		{ "map request",  JOIN_PHASE_AUTHORIZED,      JOIN_PHASE_MAP_REQUESTED },
+		{ "map wait",     JOIN_PHASE_MAP_REQUESTED,   JOIN_PHASE_MAP_BEGIN },
+		{ "map save",     JOIN_PHASE_MAP_BEGIN,       JOIN_PHASE_MAP_SAVED },
+		{ "map queue",    JOIN_PHASE_MAP_SAVED,       JOIN_PHASE_MAP_QUEUED },
+		{ "transfer+load",JOIN_PHASE_MAP_QUEUED,      JOIN_PHASE_MAP_LOADED },
+		{ "catch-up",     JOIN_PHASE_MAP_LOADED,      JOIN_PHASE_ACTIVE },
+		{ "total",        JOIN_PHASE_CONNECTED,       JOIN_PHASE_ACTIVE },
+	};
+
+	const std::chrono::steady_clock::time_point unset = {};
+	std::string result;
+	for (const auto &phase : timed_phases) {
+		if (!result.empty()) result += ", ";
+		result += phase.name;
+		result += ": ";
+		const std::chrono::steady_clock::time_point from = this->join_phase_times[phase.from];
+		const std::chrono::steady_clock::time_point to = this->join_phase_times[phase.to];
+		if (from == unset || to == unset) {
+			result += "-";
+		} else {
+			result += stdstr_fmt("%u ms", (uint)std::chrono::duration_cast<std::chrono::milliseconds>(to - from).count());
+		}
+	}
+	return result;
+}
+
 /**
  * Populate the company stats.
  * @param stats the stats to update
@@ -2405,7 +2565,7 @@ void ServerNetworkGameSocketHandler::GetClientName(char *client_name, const char
 /**
  * Print all the clients to the console
  */
-void NetworkPrintClients()
+void NetworkPrintClients(bool join_timings)
 {
 	for (NetworkClientInfo *ci : NetworkClientInfo::Iterate()) {
 		if (_network_server) {
@@ -2414,6 +2574,9 @@ void NetworkPrintClients()
 					ci->client_name.c_str(),
 					ci->client_playas + (Company::IsValidID(ci->client_playas) ? 1 : 0),
 					ci->client_id == CLIENT_ID_SERVER ? "server" : NetworkClientSocket::GetByClientID(ci->client_id)->GetClientIP());
+			if (join_timings && ci->client_id != CLIENT_ID_SERVER) {
+				IConsolePrintF(CC_INFO, "  join: %s", NetworkClientSocket::GetByClientID(ci->client_id)->GetJoinTimings().c_str());
+			}
 		} else {
 			IConsolePrintF(CC_INFO, "Client #%1d  name: '%s'  company: %1d",
 					ci->client_id,
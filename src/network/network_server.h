@@ -76,6 +76,20 @@ public:
 
 	static const char *GetClientStatusName(ClientStatus status);
 
+	/** Moments during joining of a client, used to time the phases of the join. */
+	enum JoinPhase {
+		JOIN_PHASE_CONNECTED,      ///< The connection was accepted.
+		JOIN_PHASE_NEWGRFS_CHECKED,///< The client has checked the NewGRFs.
+		JOIN_PHASE_AUTHORIZED,     ///< The client has been authorized.
+		JOIN_PHASE_MAP_REQUESTED,  ///< The client requested the map.
+		JOIN_PHASE_MAP_BEGIN,      ///< The savegame for the client is being made.
+		JOIN_PHASE_MAP_SAVED,      ///< The savegame for the client has been made.
+		JOIN_PHASE_MAP_QUEUED,     ///< The last packet of the map has been queued for the client.
+		JOIN_PHASE_MAP_LOADED,     ///< The client has downloaded and loaded the map.
+		JOIN_PHASE_ACTIVE,         ///< The client has caught up with the server.
+		JOIN_PHASE_END,            ///< Must ALWAYS be on the end of this list!! (period).
+	};
+
 	byte lag_test;               ///< Byte used for lag-testing the client
 	byte last_token;             ///< The last random token we did send to verify the client is listening
 	uint32 last_token_frame;     ///< The last frame we received the right token
@@ -86,6 +100,9 @@ public:
 	bool supports_zstd = false;  ///< Client supports zstd compression
 
 	struct PacketWriter *savegame; ///< Writer used to write the savegame.
+	size_t savegame_packets_sent = 0; ///< Number of packets of #savegame queued for this client.
+	bool savegame_size_sent = false;  ///< Whether the map size packet of #savegame has been queued for this client.
+	std::chrono::steady_clock::time_point join_phase_times[JOIN_PHASE_END] = {}; ///< When each of the join phases was reached, default when not (yet) reached.
 	NetworkAddress client_address; ///< IP-address of the client (so they can be banned)
 
 	std::string desync_log;
@@ -101,7 +118,18 @@ public:
 	NetworkRecvStatus CloseConnection(NetworkRecvStatus status) override;
 	void GetClientName(char *client_name, const char *last) const;
 
+	/**
+	 * Mark that a join phase has been reached now.
+	 * @param phase The reached phase.
+	 */
+	inline void MarkJoinPhase(JoinPhase phase)
+	{
+		this->join_phase_times[phase] = std::chrono::steady_clock::now();
+	}
+	std::string GetJoinTimings() const;
+
 	void CheckNextClientToSendMap(NetworkClientSocket *ignore_cs = nullptr);
+	void StartMapTransfer(struct PacketWriter *writer);
 
 	NetworkRecvStatus SendWait();
 	NetworkRecvStatus SendMap();
@@ -6047,6 +6047,7 @@ static void NewSpriteGroup(ByteReader *buf)
 			ProcessDeterministicSpriteGroupRanges(ranges, group->ranges, group->default_group);
 
 			OptimiseVarAction2DeterministicSpriteGroup(va2_opt_state, info, group, current_adjusts);
+			group->BuildRangeTable();
 			current_adjusts.clear();
 			break;
 		}
@@ -10984,6 +10985,8 @@ static void FinaliseHouseArray()
 		EnsureEarlyHouse(HZ_ZON4 | HZ_SUBARTC_ABOVE);
 		EnsureEarlyHouse(HZ_ZON5 | HZ_SUBARTC_ABOVE);
 	}
+
+	InvalidateTownHouseCandidates();
 }
 
 /**
@@ -11064,6 +11067,18 @@ static void FinaliseObjectsArray()
 	ObjectSpec::BindToClasses();
 }
 
+/**
+ * Set up the station specs once all GRF files are loaded, as their sprite groups can be set at any time in the GRF file.
+ */
+static void FinaliseStations()
+{
+	for (GRFFile * const file : _grf_files) {
+		for (auto &statspec : file->stations) {
+			if (statspec != nullptr) SetupStationSpecConstantRelocation(statspec.get());
+		}
+	}
+}
+
 /**
  * Add all new airports to the airport array. Airport properties can be set at any
  * time in the GRF file, so we can only add a airport spec to the airport array
@@ -11505,6 +11520,9 @@ static void AfterLoadGRFs()
 	/* Add all new objects to the object array. */
 	FinaliseObjectsArray();
 
+	/* Set up the sprites of built station tiles. */
+	FinaliseStations();
+
 	InitializeSortedCargoSpecs();
 
 	/* Sort the list of industry types. */
@@ -11672,7 +11690,8 @@ void LoadNewGRF(uint load_index, uint num_baseset)
 			if (stage > GLS_INIT && HasBit(c->flags, GCF_INIT_ONLY)) continue;
 
 			Subdirectory subdir = num_grfs < num_baseset ? BASESET_DIR : NEWGRF_DIR;
-			if (!FioCheckFileExists(c->filename, subdir)) {
+			/* Files opened by an earlier stage stay open, so there is no need to search the paths for them again. */
+			if (!IsSpriteFileCached(c->filename) && !FioCheckFileExists(c->filename, subdir)) {
 				DEBUG(grf, 0, "NewGRF file is missing '%s'; disabling", c->filename.c_str());
 				c->status = GCS_NOT_FOUND;
 				continue;
@@ -75,7 +75,7 @@ void DeterministicSpriteGroup::AnalyseCallbacks(AnalyseCallbackOperation &op) co
 	if (check_1A_range()) return;
 
 	if ((op.mode == ACOM_CB_VAR || op.mode == ACOM_CB_REFIT_CAPACITY) && this->var_scope != VSG_SCOPE_SELF) {
-		op.result_flags |= ACORF_CB_REFIT_CAP_NON_WHITELIST_FOUND;
+		op.result_flags |= ACORF_CB_REFIT_CAP_NON_WHITELIST_FOUND | ACORF_CB36_NON_CONST_FOUND;
 	}
 
 	auto find_cb_result = [&](const SpriteGroup *group, AnalyseCallbackOperation::FindCBResultData data) -> bool {
@@ -91,6 +91,7 @@ void DeterministicSpriteGroup::AnalyseCallbacks(AnalyseCallbackOperation &op) co
 		if (op.mode == ACOM_CB_VAR && adjust.variable == 0xC) {
 			if (adjust.shift_num == 0 && (adjust.and_mask & 0xFF) == 0xFF && adjust.type == DSGA_TYPE_NONE) {
 				bool found_refit_cap = false;
+				bool found_cb36 = false;
 				for (const auto &range : this->ranges) {
 					if (range.low == range.high) {
 						switch (range.low) {
@@ -107,11 +108,19 @@ void DeterministicSpriteGroup::AnalyseCallbacks(AnalyseCallbackOperation &op) co
 								break;
 
 							case CBID_VEHICLE_MODIFY_PROPERTY:
+								found_cb36 = true;
 								if (range.group != nullptr) {
 									AnalyseCallbackOperation cb36_op(ACOM_CB36_PROP);
 									range.group->AnalyseCallbacks(cb36_op);
 									op.properties_used |= cb36_op.properties_used;
 									op.callbacks_used |= cb36_op.callbacks_used;
+
+									/* The same variable whitelist as for the refit capacity callback, without var 47, makes the results constant. */
+									AnalyseCallbackOperation cb36_const_op(ACOM_CB_REFIT_CAPACITY);
+									range.group->AnalyseCallbacks(cb36_const_op);
+									if (cb36_const_op.result_flags & (ACORF_CB_REFIT_CAP_NON_WHITELIST_FOUND | ACORF_CB_REFIT_CAP_SEEN_VAR_47)) {
+										op.result_flags |= ACORF_CB36_NON_CONST_FOUND;
+									}
 								}
 								break;
 
@@ -136,6 +145,10 @@ void DeterministicSpriteGroup::AnalyseCallbacks(AnalyseCallbackOperation &op) co
 						op.result_flags &= ~save_mask;
 						op.result_flags |= (prev_result & save_mask);
 					}
+					if (found_cb36) {
+						op.result_flags &= ~ACORF_CB36_NON_CONST_FOUND;
+						op.result_flags |= (prev_result & ACORF_CB36_NON_CONST_FOUND);
+					}
 				}
 				return;
 			}
@@ -272,6 +285,7 @@ void DeterministicSpriteGroup::AnalyseCallbacks(AnalyseCallbackOperation &op) co
 	for (const auto &adjust : this->adjusts) {
 		if (op.mode == ACOM_CB_VAR && adjust.variable == 0xC) {
 			op.callbacks_used |= SGCU_ALL;
+			op.result_flags |= ACORF_CB36_NON_CONST_FOUND;
 		}
 		if (op.mode == ACOM_CB36_PROP && adjust.variable == 0x10) {
 			if (find_cb_result(this, { CBID_VEHICLE_MODIFY_PROPERTY, false, 0 })) {
@@ -280,10 +294,10 @@ void DeterministicSpriteGroup::AnalyseCallbacks(AnalyseCallbackOperation &op) co
 			}
 		}
 		if ((op.mode == ACOM_CB_VAR || op.mode == ACOM_CB_REFIT_CAPACITY) && !(adjust.variable == 0xC || adjust.variable == 0x1A || adjust.variable == 0x47 || adjust.variable == 0x7D || adjust.variable == 0x7E)) {
-			op.result_flags |= ACORF_CB_REFIT_CAP_NON_WHITELIST_FOUND;
+			op.result_flags |= ACORF_CB_REFIT_CAP_NON_WHITELIST_FOUND | ACORF_CB36_NON_CONST_FOUND;
 		}
 		if ((op.mode == ACOM_CB_VAR || op.mode == ACOM_CB_REFIT_CAPACITY) && adjust.variable == 0x47) {
-			op.result_flags |= ACORF_CB_REFIT_CAP_SEEN_VAR_47;
+			op.result_flags |= ACORF_CB_REFIT_CAP_SEEN_VAR_47 | ACORF_CB36_NON_CONST_FOUND;
 		}
 		if (op.mode != ACOM_CB36_PROP && adjust.variable == 0x7E && adjust.subroutine != nullptr) {
 			adjust.subroutine->AnalyseCallbacks(op);
@@ -311,7 +325,7 @@ void CallbackResultSpriteGroup::AnalyseCallbacks(AnalyseCallbackOperation &op) c
 
 void RandomizedSpriteGroup::AnalyseCallbacks(AnalyseCallbackOperation &op) const
 {
-	op.result_flags |= ACORF_CB_REFIT_CAP_NON_WHITELIST_FOUND;
+	op.result_flags |= ACORF_CB_REFIT_CAP_NON_WHITELIST_FOUND | ACORF_CB36_NON_CONST_FOUND;
 
 	if ((op.mode == ACOM_CB_VAR || op.mode == ACOM_FIND_RANDOM_TRIGGER) && (this->triggers != 0 || this->cmp_mode == RSG_CMP_ALL)) {
 		op.callbacks_used |= SGCU_RANDOM_TRIGGER;
@@ -33,6 +33,7 @@ enum AnalyseCallbackOperationResultFlags : uint8 {
 	ACORF_CB_RESULT_FOUND                   = 1 << 0,
 	ACORF_CB_REFIT_CAP_NON_WHITELIST_FOUND  = 1 << 1,
 	ACORF_CB_REFIT_CAP_SEEN_VAR_47          = 1 << 2,
+	ACORF_CB36_NON_CONST_FOUND              = 1 << 3, ///< The vehicle property callback result may depend on the state of the vehicle.
 };
 DECLARE_ENUM_AS_BIT_SET(AnalyseCallbackOperationResultFlags)
 
@@ -9,6 +9,7 @@
 
 /* No inclusion guards as this file must only be included from .cpp files. */
 
+#include "animated_tile.h"
 #include "animated_tile_func.h"
 #include "core/random_func.hpp"
 #include "date_func.h"
@@ -162,4 +163,17 @@ struct AnimationBase {
 		if (HasBit(spec->callback_mask, Tbase::cbm_animation_speed)) return 0;
 		return spec->animation.speed;
 	}
+
+	/**
+	 * Get whether the animation of a tile only depends on the animation properties, and not on any callbacks.
+	 * Such animations can be advanced directly by AnimateAnimatedTiles.
+	 * @param spec Specification related to the tile.
+	 * @param[out] info Animated tile info to fill with the simple animation, if any.
+	 */
+	static void GetSimpleAnimation(const Tspec *spec, AnimatedTileInfo &info)
+	{
+		if (HasBit(spec->callback_mask, Tbase::cbm_animation_speed) || HasBit(spec->callback_mask, Tbase::cbm_animation_next_frame)) return;
+		info.simple = (spec->animation.status == ANIM_STATUS_LOOPING) ? ATSA_LOOPING : ATSA_ONCE;
+		info.simple_frames = spec->animation.frames;
+	}
 };
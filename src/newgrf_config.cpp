@@ -26,9 +26,13 @@
 
 #include "fileio_func.h"
 #include "fios.h"
+#include "rev.h"
+#include "core/serialisation.hpp"
+#include "3rdparty/cpp-btree/btree_map.h"
 
 #include "thread.h"
 #include <mutex>
+#include <sys/stat.h>
 #include <condition_variable>
 #if defined(__MINGW32__)
 #include "3rdparty/mingw-std-threads/mingw.mutex.h"
@@ -618,12 +622,295 @@ compatible_grf:
 /** Set this flag to prevent any NewGRF scanning from being done. */
 int _skip_all_newgrf_scanning = 0;
 
+std::string _newgrf_scan_cache_file; ///< File to store the details of the scanned NewGRFs in, so unchanged files need not be scanned again.
+
+static const char NEWGRF_SCAN_CACHE_MAGIC[4] = { 'O', 'T', 'G', 'S' };
+static const uint16 NEWGRF_SCAN_CACHE_VERSION = 1;
+
+/** Cached scan result of a single file. */
+struct NewGRFScanCacheEntry {
+	uint64 size;               ///< Size of the file when it was scanned.
+	int64 mtime;               ///< Modification time of the file when it was scanned.
+	std::vector<byte> details; ///< Serialised details of the NewGRF, empty if the file is not a NewGRF which can be listed.
+};
+
+/** Scan results, by file name; for files in a tar the name of the tar and the name in the tar. */
+typedef btree::btree_map<std::string, NewGRFScanCacheEntry> NewGRFScanCache;
+
+/** Reader for the NewGRF scan cache. */
+struct NewGRFScanCacheReader : public BufferDeserialisationHelper<NewGRFScanCacheReader> {
+	const byte *buffer;
+	size_t size;
+	size_t pos = 0;
+	bool error = false;
+
+	NewGRFScanCacheReader(const byte *buffer, size_t size) : buffer(buffer), size(size) {}
+
+	const byte *GetDeserialisationBuffer() const { return this->buffer; }
+	size_t GetDeserialisationBufferSize() const { return this->size; }
+	size_t &GetDeserialisationPosition() { return this->pos; }
+
+	bool CanDeserialiseBytes(size_t bytes_to_read, bool raise_error)
+	{
+		if (this->error) return false;
+		if (this->pos + bytes_to_read > this->size) {
+			if (raise_error) this->error = true;
+			return false;
+		}
+		return true;
+	}
+
+	/** Read a string with a 32 bit length prefix, as written by #SendCacheString, without any validation. */
+	std::string RecvCacheString()
+	{
+		span<const uint8> view = this->Recv_binary_view(this->Recv_uint32());
+		return std::string(reinterpret_cast<const char *>(view.data()), view.size());
+	}
+};
+
+/** Write a string with a 32 bit length prefix; GRF texts contain control codes, which the normal string functions would strip. */
+static void SendCacheString(BufferSerialiser &buffer, const std::string &str)
+{
+	buffer.Send_uint32((uint32)str.size());
+	buffer.Send_binary(reinterpret_cast<const byte *>(str.data()), str.size());
+}
+
+static void SendCacheTextList(BufferSerialiser &buffer, const GRFTextList &list)
+{
+	buffer.Send_uint32((uint32)list.size());
+	for (const GRFText &text : list) {
+		buffer.Send_uint8(text.langid);
+		SendCacheString(buffer, text.text);
+	}
+}
+
+static void RecvCacheTextList(NewGRFScanCacheReader &buffer, GRFTextList &list)
+{
+	const uint32 count = buffer.Recv_uint32();
+	for (uint32 i = 0; i < count && !buffer.error; i++) {
+		GRFText &text = list.emplace_back();
+		text.langid = buffer.Recv_uint8();
+		text.text = buffer.RecvCacheString();
+	}
+}
+
+static void SendCacheTextWrapper(BufferSerialiser &buffer, const GRFTextWrapper &wrapper)
+{
+	buffer.Send_bool(wrapper != nullptr);
+	if (wrapper != nullptr) SendCacheTextList(buffer, *wrapper);
+}
+
+static void RecvCacheTextWrapper(NewGRFScanCacheReader &buffer, GRFTextWrapper &wrapper)
+{
+	if (!buffer.Recv_bool()) return;
+	wrapper = std::make_shared<GRFTextList>();
+	RecvCacheTextList(buffer, *wrapper);
+}
+
+/**
+ * Serialise everything #FillGRFDetails determines about a NewGRF.
+ * @param config The scanned NewGRF.
+ * @return The serialised details.
+ */
+static std::vector<byte> SerialiseGRFScanDetails(const GRFConfig *config)
+{
+	std::vector<byte> data;
+	BufferSerialiser buffer(data);
+	buffer.Send_uint32(config->ident.grfid);
+	buffer.Send_binary(config->ident.md5sum.data(), config->ident.md5sum.size());
+	SendCacheTextWrapper(buffer, config->name);
+	SendCacheTextWrapper(buffer, config->info);
+	SendCacheTextWrapper(buffer, config->url);
+	buffer.Send_uint32(config->version);
+	buffer.Send_uint32(config->min_loadable_version);
+	buffer.Send_uint8(config->flags);
+	buffer.Send_uint8(config->status);
+	buffer.Send_uint8(config->num_params);
+	for (uint i = 0; i < config->num_params; i++) buffer.Send_uint32(config->param[i]);
+	buffer.Send_uint8(config->num_valid_params);
+	buffer.Send_uint8(config->palette);
+	buffer.Send_bool(config->has_param_defaults);
+
+	buffer.Send_uint32((uint32)config->param_info.size());
+	for (const auto &info : config->param_info) {
+		buffer.Send_bool(info.has_value());
+		if (!info.has_value()) continue;
+		SendCacheTextList(buffer, info->name);
+		SendCacheTextList(buffer, info->desc);
+		buffer.Send_uint8(info->type);
+		buffer.Send_uint32(info->min_value);
+		buffer.Send_uint32(info->max_value);
+		buffer.Send_uint32(info->def_value);
+		buffer.Send_uint8(info->param_nr);
+		buffer.Send_uint8(info->first_bit);
+		buffer.Send_uint8(info->num_bit);
+		buffer.Send_bool(info->complete_labels);
+		buffer.Send_uint32((uint32)info->value_names.size());
+		for (const auto &it : info->value_names) {
+			buffer.Send_uint32(it.first);
+			SendCacheTextList(buffer, it.second);
+		}
+	}
+	return data;
+}
+
+/**
+ * Fill a NewGRF config from details serialised by #SerialiseGRFScanDetails.
+ * @param config The config to fill, as freshly constructed.
+ * @param data The serialised details.
+ * @return Whether the details could be read.
+ */
+static bool DeserialiseGRFScanDetails(GRFConfig *config, const std::vector<byte> &data)
+{
+	NewGRFScanCacheReader buffer(data.data(), data.size());
+	config->ident.grfid = buffer.Recv_uint32();
+	buffer.Recv_binary(config->ident.md5sum.data(), config->ident.md5sum.size());
+	RecvCacheTextWrapper(buffer, config->name);
+	RecvCacheTextWrapper(buffer, config->info);
+	RecvCacheTextWrapper(buffer, config->url);
+	config->version = buffer.Recv_uint32();
+	config->min_loadable_version = buffer.Recv_uint32();
+	config->flags = buffer.Recv_uint8();
+	config->status = (GRFStatus)buffer.Recv_uint8();
+	config->num_params = std::min<uint8>(buffer.Recv_uint8(), (uint8)config->param.size());
+	for (uint i = 0; i < config->num_params; i++) config->param[i] = buffer.Recv_uint32();
+	config->num_valid_params = buffer.Recv_uint8();
+	config->palette = buffer.Recv_uint8();
+	config->has_param_defaults = buffer.Recv_bool();
+
+	const uint32 param_info_count = buffer.Recv_uint32();
+	if (buffer.error || param_info_count > config->param.size()) return false;
+	config->param_info.resize(param_info_count);
+	for (uint i = 0; i < param_info_count && !buffer.error; i++) {
+		if (!buffer.Recv_bool()) continue;
+		GRFParameterInfo &info = config->param_info[i].emplace(i);
+		RecvCacheTextList(buffer, info.name);
+		RecvCacheTextList(buffer, info.desc);
+		info.type = (GRFParameterType)buffer.Recv_uint8();
+		info.min_value = buffer.Recv_uint32();
+		info.max_value = buffer.Recv_uint32();
+		info.def_value = buffer.Recv_uint32();
+		info.param_nr = buffer.Recv_uint8();
+		info.first_bit = buffer.Recv_uint8();
+		info.num_bit = buffer.Recv_uint8();
+		info.complete_labels = buffer.Recv_bool();
+		const uint32 value_names = buffer.Recv_uint32();
+		for (uint32 j = 0; j < value_names && !buffer.error; j++) {
+			const uint32 value = buffer.Recv_uint32();
+			RecvCacheTextList(buffer, info.value_names[value]);
+		}
+	}
+	if (buffer.error || buffer.pos != data.size()) return false;
+
+	/* The palette to use depends on a setting, which may have changed since the scan. */
+	config->SetSuitablePalette();
+	return true;
+}
+
+/**
+ * Get the key of a file in the NewGRF scan cache, and the size and modification time it is stored with.
+ * @param filename Name of the file, or its name in the tar.
+ * @param tar_filename Name of the tar the file is in, or empty.
+ * @param[out] key The key of the file.
+ * @param[out] size Size of the file or tar.
+ * @param[out] mtime Modification time of the file or tar.
+ * @return Whether the file could be found.
+ */
+static bool GetNewGRFScanCacheKey(const std::string &filename, const std::string &tar_filename, std::string &key, uint64 &size, int64 &mtime)
+{
+	const std::string &path = tar_filename.empty() ? filename : tar_filename;
+#ifdef _WIN32
+	struct _stat64 sb;
+	if (_wstat64(OTTD2FS(path).c_str(), &sb) != 0) return false;
+#else
+	struct stat sb;
+	if (stat(OTTD2FS(path).c_str(), &sb) != 0) return false;
+#endif
+	size = sb.st_size;
+	mtime = sb.st_mtime;
+	key = tar_filename.empty() ? filename : tar_filename + '\n' + filename;
+	return true;
+}
+
+/**
+ * Load the NewGRF scan cache from disk.
+ * A cache written by another version of the game is ignored, as it may parse NewGRFs differently.
+ * @param[out] cache The loaded cache.
+ */
+static void LoadNewGRFScanCache(NewGRFScanCache &cache)
+{
+	if (_newgrf_scan_cache_file.empty()) return;
+
+	std::unique_ptr<FILE, FileDeleter> fp(fopen(_newgrf_scan_cache_file.c_str(), "rb"));
+	if (fp == nullptr) return;
+
+	std::vector<byte> data;
+	byte chunk[4096];
+	size_t len;
+	while ((len = fread(chunk, 1, sizeof(chunk), fp.get())) > 0) data.insert(data.end(), chunk, chunk + len);
+
+	NewGRFScanCacheReader buffer(data.data(), data.size());
+	char magic[4];
+	buffer.Recv_binary(reinterpret_cast<byte *>(magic), sizeof(magic));
+	if (buffer.error || memcmp(magic, NEWGRF_SCAN_CACHE_MAGIC, sizeof(magic)) != 0) return;
+	if (buffer.Recv_uint16() != NEWGRF_SCAN_CACHE_VERSION) return;
+	if (buffer.RecvCacheString() != _openttd_revision) return;
+
+	const uint32 count = buffer.Recv_uint32();
+	for (uint32 i = 0; i < count && !buffer.error; i++) {
+		std::string key = buffer.RecvCacheString();
+		NewGRFScanCacheEntry entry;
+		entry.size = buffer.Recv_uint64();
+		entry.mtime = (int64)buffer.Recv_uint64();
+		span<const uint8> details = buffer.Recv_binary_view(buffer.Recv_uint32());
+		entry.details.assign(details.begin(), details.end());
+		if (!buffer.error) cache[std::move(key)] = std::move(entry);
+	}
+	if (buffer.error) {
+		DEBUG(grf, 1, "NewGRF scan cache is corrupt, ignoring it");
+		cache.clear();
+	}
+}
+
+/**
+ * Write the NewGRF scan cache to disk.
+ * @param cache The cache to write.
+ */
+static void SaveNewGRFScanCache(const NewGRFScanCache &cache)
+{
+	if (_newgrf_scan_cache_file.empty()) return;
+
+	std::vector<byte> data;
+	BufferSerialiser buffer(data);
+	buffer.Send_binary(reinterpret_cast<const byte *>(NEWGRF_SCAN_CACHE_MAGIC), sizeof(NEWGRF_SCAN_CACHE_MAGIC));
+	buffer.Send_uint16(NEWGRF_SCAN_CACHE_VERSION);
+	SendCacheString(buffer, _openttd_revision);
+	buffer.Send_uint32((uint32)cache.size());
+	for (const auto &it : cache) {
+		SendCacheString(buffer, it.first);
+		buffer.Send_uint64(it.second.size);
+		buffer.Send_uint64((uint64)it.second.mtime);
+		buffer.Send_uint32((uint32)it.second.details.size());
+		buffer.Send_binary(it.second.details.data(), it.second.details.size());
+	}
+
+	std::unique_ptr<FILE, FileDeleter> fp(fopen(_newgrf_scan_cache_file.c_str(), "wb"));
+	if (fp == nullptr || fwrite(data.data(), 1, data.size(), fp.get()) != data.size()) {
+		DEBUG(grf, 0, "Could not write the NewGRF scan cache: %s", _newgrf_scan_cache_file.c_str());
+	}
+}
+
 /** Helper for scanning for files with GRF as extension */
 class GRFFileScanner : FileScanner {
 	std::chrono::steady_clock::time_point next_update; ///< The next moment we do update the screen.
 	uint num_scanned; ///< The number of GRFs we have scanned.
 	std::vector<GRFConfig *> grfs;
 
+	NewGRFScanCache old_cache;  ///< Scan results of the previous scan.
+	NewGRFScanCache new_cache;  ///< Scan results of this scan.
+	uint cache_hits = 0;        ///< Number of files of which the cached scan result was used.
+	std::vector<std::pair<std::string, const GRFConfig *>> new_cache_details; ///< Scanned NewGRFs, of which the details are added to #new_cache when their MD5 sum is known.
+
 public:
 	GRFFileScanner() : num_scanned(0)
 	{
@@ -643,9 +930,16 @@ public:
 		CalcGRFMD5ThreadingStart();
 		GRFFileScanner fs;
 		fs.grfs.clear();
+		LoadNewGRFScanCache(fs.old_cache);
 		int ret = fs.Scan(".grf", NEWGRF_DIR);
 		CalcGRFMD5ThreadingEnd();
 
+		for (const auto &it : fs.new_cache_details) {
+			fs.new_cache[it.first].details = SerialiseGRFScanDetails(it.second);
+		}
+		DEBUG(grf, 1, "Used cached scan results of %u of %u files", fs.cache_hits, fs.num_scanned);
+		if (!_exit_game && (fs.cache_hits != fs.old_cache.size() || fs.cache_hits != fs.new_cache.size())) SaveNewGRFScanCache(fs.new_cache);
+
 		for (GRFConfig *c : fs.grfs) {
 			bool added = true;
 			if (_all_grfs == nullptr) {
@@ -683,14 +977,38 @@ public:
 	}
 };
 
-bool GRFFileScanner::AddFile(const std::string &filename, size_t basepath_length, const std::string &)
+bool GRFFileScanner::AddFile(const std::string &filename, size_t basepath_length, const std::string &tar_filename)
 {
 	/* Abort if the user stopped the game during a scan. */
 	if (_exit_game) return false;
 
 	GRFConfig *c = new GRFConfig(filename.c_str() + basepath_length);
 
-	bool added = FillGRFDetails(c, false);
+	std::string key;
+	NewGRFScanCacheEntry stamp;
+	const bool have_key = GetNewGRFScanCacheKey(filename, tar_filename, key, stamp.size, stamp.mtime);
+
+	bool added;
+	auto cached = have_key ? this->old_cache.find(key) : this->old_cache.end();
+	if (cached != this->old_cache.end() && cached->second.size == stamp.size && cached->second.mtime == stamp.mtime &&
+			(cached->second.details.empty() || DeserialiseGRFScanDetails(c, cached->second.details))) {
+		/* Unchanged since the previous scan. */
+		added = !cached->second.details.empty();
+		this->new_cache[key] = cached->second;
+		this->cache_hits++;
+	} else {
+		if (cached != this->old_cache.end()) {
+			/* The cached details could not be read, start from scratch. */
+			delete c;
+			c = new GRFConfig(filename.c_str() + basepath_length);
+		}
+		added = FillGRFDetails(c, false);
+		/* Files with errors are not cached, so the error is shown again after the next scan. */
+		if (have_key && !c->error.has_value() && (added || c->ident.grfid == 0 || HasBit(c->flags, GCF_SYSTEM))) {
+			this->new_cache[key] = stamp;
+			if (added) this->new_cache_details.emplace_back(key, c);
+		}
+	}
 	if (added) {
 		this->grfs.push_back(c);
 	}
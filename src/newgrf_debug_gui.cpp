@@ -393,6 +393,19 @@ struct NewGRFInspectWindow : Window {
 		if (v == nullptr) this->chain_index = 0;
 	}
 
+	/** Pseudo extra info flag of the line toggling the resolver dependency trace. */
+	static const uint DEPENDENCY_TRACE_TOGGLE = 1U << 31;
+
+	/**
+	 * Check whether the resolver dependency tracer is recording the GRF and feature of this window.
+	 * @param grfid GRF ID of the inspected item.
+	 * @return true iff the dependencies of the inspected GRF and feature are being traced.
+	 */
+	bool IsTracingDependencies(uint32 grfid) const
+	{
+		return grfid != 0 && _resolver_dependency_tracer.grfid == grfid && _resolver_dependency_tracer.feature == GetFeatureNum(this->window_number);
+	}
+
 	NewGRFInspectWindow(WindowDesc *desc, WindowNumber wno) : Window(desc)
 	{
 		this->CreateNestedTree();
@@ -411,6 +424,12 @@ struct NewGRFInspectWindow : Window {
 		this->OnInvalidateData(0, true);
 	}
 
+	void Close([[maybe_unused]] int data = 0) override
+	{
+		if (this->IsTracingDependencies(GetFeatureHelper(this->window_number)->GetGRFID(this->GetFeatureIndex()))) _resolver_dependency_tracer.Stop();
+		this->Window::Close();
+	}
+
 	void SetStringParameters(int widget) const override
 	{
 		if (widget != WID_NGRFI_CAPTION) return;
@@ -646,6 +665,21 @@ struct NewGRFInspectWindow : Window {
 				this->DrawString(r, i++, "  Name: %s", grfconfig->GetName());
 				this->DrawString(r, i++, "  File: %s", grfconfig->filename.c_str());
 			}
+
+			const_cast<NewGRFInspectWindow *>(this)->extra_info_click_flag_toggles[i] = DEPENDENCY_TRACE_TOGGLE;
+			if (this->IsTracingDependencies(grfid)) {
+				this->DrawString(r, i++, "  [-] Variables read by resolves of this feature of the GRF:");
+				for (const auto &it : _resolver_dependency_tracer.callbacks) {
+					if (it.first == CBID_NO_CALLBACK) {
+						this->DrawString(r, i++, "    Graphics: " OTTD_PRINTF64U " resolves", it.second.resolves);
+					} else {
+						this->DrawString(r, i++, "    Callback 0x%X: " OTTD_PRINTF64U " resolves", it.first, it.second.resolves);
+					}
+					it.second.Dump("      ", line_handler);
+				}
+			} else {
+				this->DrawString(r, i++, "  [+] Trace variables read by resolves");
+			}
 		}
 
 		if (nih->ShowExtraInfoIncludingGRFIDOnly(index)) return;
@@ -899,7 +933,16 @@ struct NewGRFInspectWindow : Window {
 
 				auto iter = this->extra_info_click_flag_toggles.find(line);
 				if (iter != this->extra_info_click_flag_toggles.end()) {
-					this->extra_info_flags ^= iter->second;
+					if (iter->second == DEPENDENCY_TRACE_TOGGLE) {
+						uint32 grfid = GetFeatureHelper(this->window_number)->GetGRFID(this->GetFeatureIndex());
+						if (this->IsTracingDependencies(grfid)) {
+							_resolver_dependency_tracer.Stop();
+						} else {
+							_resolver_dependency_tracer.Start(grfid, GetFeatureNum(this->window_number));
+						}
+					} else {
+						this->extra_info_flags ^= iter->second;
+					}
 					this->SetDirty();
 					return;
 				}
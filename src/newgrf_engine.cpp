@@ -750,13 +750,16 @@ static uint32 VehicleGetVariable(Vehicle *v, const VehicleScopeResolver *object,
 		case 0x60: // Count consist's engine ID occurrence
 			if (v->type != VEH_TRAIN && v->type != VEH_SHIP) return v->GetEngine()->grf_prop.local_id == parameter ? 1 : 0;
 
-			{
+			if (!HasBit(v->grf_cache.cache_valid, NCVV_CONSIST_ENGINE_ID_COUNT) || v->grf_cache.consist_engine_id_count_param != parameter) {
 				uint count = 0;
-				for (; v != nullptr; v = v->Next()) {
-					if (v->GetEngine()->grf_prop.local_id == parameter) count++;
+				for (const Vehicle *u = v; u != nullptr; u = u->Next()) {
+					if (u->GetEngine()->grf_prop.local_id == parameter) count++;
 				}
-				return count;
+				v->grf_cache.consist_engine_id_count = count;
+				v->grf_cache.consist_engine_id_count_param = parameter;
+				SetBit(v->grf_cache.cache_valid, NCVV_CONSIST_ENGINE_ID_COUNT);
 			}
+			return v->grf_cache.consist_engine_id_count;
 
 		case 0x61: // Get variable of n-th vehicle in chain [signed number relative to vehicle]
 			if (!(v->IsGroundVehicle() || v->type == VEH_SHIP) || parameter == 0x61) {
@@ -1342,14 +1345,19 @@ int GetEngineProperty(EngineID engine, PropertyID property, int orig_value, cons
 	const Engine *e = Engine::Get(engine);
 	if (static_cast<uint>(property) < 64 && !HasBit(e->cb36_properties_used, property)) return orig_value;
 
-	VehicleResolverObject object(engine, v, VehicleResolverObject::WO_UNCACHED, false, CBID_VEHICLE_MODIFY_PROPERTY, property, 0);
-	if (static_cast<uint>(property) < 64 && !e->sprite_group_cb36_properties_used.empty()) {
-		auto iter = e->sprite_group_cb36_properties_used.find(object.root_spritegroup);
-		if (iter != e->sprite_group_cb36_properties_used.end()) {
-			if (!HasBit(iter->second, property)) return orig_value;
+	uint16 callback;
+	if (v != nullptr && static_cast<uint>(property) < 64 && HasBit(e->cb36_const_properties, property)) {
+		callback = e->cb36_const_results.find(property)->second;
+	} else {
+		VehicleResolverObject object(engine, v, VehicleResolverObject::WO_UNCACHED, false, CBID_VEHICLE_MODIFY_PROPERTY, property, 0);
+		if (static_cast<uint>(property) < 64 && !e->sprite_group_cb36_properties_used.empty()) {
+			auto iter = e->sprite_group_cb36_properties_used.find(object.root_spritegroup);
+			if (iter != e->sprite_group_cb36_properties_used.end()) {
+				if (!HasBit(iter->second, property)) return orig_value;
+			}
 		}
+		callback = object.ResolveCallback();
 	}
-	uint16 callback = object.ResolveCallback();
 	if (callback != CALLBACK_FAILED) {
 		if (is_signed) {
 			/* Sign extend 15 bit integer */
@@ -1561,9 +1569,16 @@ void FillNewGRFVehicleCache(const Vehicle *v)
 	};
 	static const int partial_cache_entries[] = {
 		NCVV_CONSIST_CARGO_INFORMATION_UD,
+		NCVV_CONSIST_ENGINE_ID_COUNT,
 	};
 	static_assert(NCVV_END == lengthof(cache_entries) + lengthof(partial_cache_entries));
 
+	/* The var 60 cache depends on the parameter of the last query, so reset it to a well defined state. */
+	NewGRFCache &grf_cache = const_cast<Vehicle *>(v)->grf_cache;
+	ClrBit(grf_cache.cache_valid, NCVV_CONSIST_ENGINE_ID_COUNT);
+	grf_cache.consist_engine_id_count = 0;
+	grf_cache.consist_engine_id_count_param = 0;
+
 	/* Resolve all the variables, so their caches are set. */
 	for (size_t i = 0; i < lengthof(cache_entries); i++) {
 		/* Only resolve when the cache isn't valid. */
@@ -1573,7 +1588,7 @@ void FillNewGRFVehicleCache(const Vehicle *v)
 	}
 
 	/* Make sure really all bits are set. */
-	assert(v->grf_cache.cache_valid == (1 << NCVV_END) - 1);
+	assert((v->grf_cache.cache_valid | (1 << NCVV_CONSIST_ENGINE_ID_COUNT)) == (1 << NCVV_END) - 1);
 }
 
 void AnalyseEngineCallbacks()
@@ -1584,11 +1599,14 @@ void AnalyseEngineCallbacks()
 		sg_cb36.clear();
 		e->sprite_group_cb36_properties_used.clear();
 		e->refit_capacity_values.reset();
+		e->cb36_const_properties = 0;
+		e->cb36_const_results.clear();
 
 		SpriteGroupCallbacksUsed callbacks_used = SGCU_NONE;
 		uint64 cb36_properties_used = 0;
 		bool refit_cap_whitelist_ok = true;
 		bool refit_cap_no_var_47 = true;
+		bool cb36_const = true;
 		uint non_purchase_groups = 0;
 		auto process_sg = [&](const SpriteGroup *sg, bool is_purchase) {
 			if (sg == nullptr) return;
@@ -1600,6 +1618,7 @@ void AnalyseEngineCallbacks()
 			sg_cb36[sg] = op.properties_used;
 			if ((op.result_flags & ACORF_CB_REFIT_CAP_NON_WHITELIST_FOUND) && !is_purchase) refit_cap_whitelist_ok = false;
 			if ((op.result_flags & ACORF_CB_REFIT_CAP_SEEN_VAR_47) && !is_purchase) refit_cap_no_var_47 = false;
+			if ((op.result_flags & ACORF_CB36_NON_CONST_FOUND) && !is_purchase) cb36_const = false;
 			if (!is_purchase) non_purchase_groups++;
 		};
 
@@ -1617,6 +1636,18 @@ void AnalyseEngineCallbacks()
 			}
 		}
 
+		if (cb36_const && non_purchase_groups <= 1 && e->grf_prop.spritegroup[CT_DEFAULT] != nullptr && cb36_properties_used != 0 && cb36_properties_used != UINT64_MAX) {
+			/* The property callback only depends on the property, so resolve each used property once now instead of for every query. */
+			const SpriteGroup *purchase_sg = e->grf_prop.spritegroup[CT_PURCHASE];
+			e->grf_prop.spritegroup[CT_PURCHASE] = nullptr; // Temporarily disable separate purchase sprite group
+			for (uint8 property : SetBitIterator<uint8, uint64>(cb36_properties_used)) {
+				VehicleResolverObject object(e->index, nullptr, VehicleResolverObject::WO_UNCACHED, false, CBID_VEHICLE_MODIFY_PROPERTY, property, 0);
+				e->cb36_const_results[property] = object.ResolveCallback();
+			}
+			e->grf_prop.spritegroup[CT_PURCHASE] = purchase_sg;
+			e->cb36_const_properties = cb36_properties_used;
+		}
+
 		if (refit_cap_whitelist_ok && non_purchase_groups <= 1 && HasBit(e->info.callback_mask, CBM_VEHICLE_REFIT_CAPACITY) && e->grf_prop.spritegroup[CT_DEFAULT] != nullptr) {
 			const SpriteGroup *purchase_sg = e->grf_prop.spritegroup[CT_PURCHASE];
 			e->grf_prop.spritegroup[CT_PURCHASE] = nullptr; // Temporarily disable separate purchase sprite group
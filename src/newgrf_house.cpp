@@ -675,6 +675,20 @@ uint8 GetNewHouseTileAnimationSpeed(TileIndex tile)
 	return HouseAnimationBase::GetAnimationSpeed(hs);
 }
 
+/**
+ * Get the simple animation of a house tile, if its animation does not depend on callbacks.
+ * @param tile The house tile.
+ * @param[out] info Animated tile info to fill.
+ */
+void GetAnimatedTileSimpleAnimation_Town(TileIndex tile, AnimatedTileInfo &info)
+{
+	const HouseID house = GetHouseType(tile);
+	if (house < NEW_HOUSE_OFFSET) return;
+
+	HouseAnimationBase::GetSimpleAnimation(HouseSpec::Get(house), info);
+	info.simple_id = house;
+}
+
 /**
  * Check if GRF allows a given house to be constructed (callback 17)
  * @param house_id house type
@@ -312,6 +312,21 @@ uint8 GetNewIndustryTileAnimationSpeed(TileIndex tile)
 	return IndustryAnimationBase::GetAnimationSpeed(itspec);
 }
 
+/**
+ * Get the simple animation of an industry tile, if its animation does not depend on callbacks.
+ * @param tile The industry tile.
+ * @param[out] info Animated tile info to fill.
+ */
+void GetAnimatedTileSimpleAnimation_Industry(TileIndex tile, AnimatedTileInfo &info)
+{
+	const IndustryGfx gfx = GetIndustryGfx(tile);
+	const IndustryTileSpec *itspec = GetIndustryTileSpec(gfx);
+	if (itspec->animation.status == ANIM_STATUS_NO_ANIMATION) return;
+
+	IndustryAnimationBase::GetSimpleAnimation(itspec, info);
+	info.simple_id = gfx;
+}
+
 /**
  * Trigger random triggers for an industry tile and reseed its random bits.
  * @param tile Industry tile to trigger.
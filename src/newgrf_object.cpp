@@ -610,6 +610,19 @@ uint8 GetNewObjectTileAnimationSpeed(TileIndex tile)
 	return ObjectAnimationBase::GetAnimationSpeed(spec);
 }
 
+/**
+ * Get the simple animation of an object tile, if its animation does not depend on callbacks.
+ * @param tile The object tile.
+ * @param[out] info Animated tile info to fill.
+ */
+void GetAnimatedTileSimpleAnimation_Object(TileIndex tile, AnimatedTileInfo &info)
+{
+	const ObjectSpec *spec = ObjectSpec::GetByTile(tile);
+	if (spec == nullptr || !(spec->flags & OBJECT_FLAG_ANIMATION)) return;
+
+	ObjectAnimationBase::GetSimpleAnimation(spec, info);
+}
+
 /**
  * Trigger the update of animation on a single tile.
  * @param o       The object that got triggered.
@@ -21,6 +21,7 @@
 
 
 std::vector<NewGRFProfiler> _newgrf_profilers;
+NewGRFSampleProfiler _newgrf_sample_profiler;
 
 
 /**
@@ -184,3 +185,123 @@ static TimeoutTimer<TimerGameTick> _profiling_finish_timeout(0, []()
 {
 	_profiling_finish_timeout.Abort();
 }
+
+/**
+ * Start sampling, discarding any previously collected samples.
+ * @param interval Sample every Nth top-level resolve.
+ */
+void NewGRFSampleProfiler::Start(uint interval)
+{
+	this->interval = std::max<uint>(interval, 1);
+	this->countdown = this->interval;
+	this->samples = 0;
+	this->start_tick = _tick_counter;
+	this->frames.clear();
+	this->self_ns.clear();
+}
+
+/**
+ * Stop sampling, the collected samples are kept.
+ */
+void NewGRFSampleProfiler::Stop()
+{
+	this->interval = 0;
+}
+
+/**
+ * Capture the start of a sprite group resolution within a sample.
+ * @param group The sprite group being resolved.
+ * @param resolver Data about sprite group being resolved.
+ */
+void NewGRFSampleProfiler::BeginFrame(const SpriteGroup *group, const ResolverObject &resolver)
+{
+	char buffer[64];
+	if (this->frames.empty()) {
+		seprintf(buffer, lastof(buffer), "[%08X];feature 0x%02X;", resolver.grffile != nullptr ? BSWAP32(resolver.grffile->grfid) : 0, resolver.GetFeature());
+		if (resolver.callback == CBID_NO_CALLBACK) {
+			strecat(buffer, "graphics", lastof(buffer));
+		} else {
+			seprintf(buffer + strlen(buffer), lastof(buffer), "callback 0x%X", resolver.callback);
+		}
+		this->frames.push_back({ buffer, {}, 0 });
+	} else {
+		this->frames.push_back({ this->frames.back().path, {}, 0 });
+	}
+	seprintf(buffer, lastof(buffer), ";line %u", group->nfo_line);
+	this->frames.back().path += buffer;
+	this->frames.back().start = std::chrono::steady_clock::now();
+}
+
+/**
+ * Capture the completion of a sprite group resolution within a sample.
+ */
+void NewGRFSampleProfiler::EndFrame()
+{
+	Frame &frame = this->frames.back();
+	const uint64 elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - frame.start).count();
+	this->self_ns[frame.path] += elapsed - std::min(elapsed, frame.child_ns);
+	this->frames.pop_back();
+	if (!this->frames.empty()) this->frames.back().child_ns += elapsed;
+}
+
+/**
+ * Print the GRF, feature and callback combinations with the highest sampled time to the console.
+ * @param count Maximum number of entries to print.
+ */
+void NewGRFSampleProfiler::PrintSummary(uint count) const
+{
+	/* Aggregate over the nesting paths, keeping only the GRF, feature and callback. */
+	std::unordered_map<std::string, uint64> totals;
+	uint64 total = 0;
+	for (const auto &it : this->self_ns) {
+		size_t end = it.first.find(";line ");
+		totals[it.first.substr(0, end)] += it.second;
+		total += it.second;
+	}
+
+	std::vector<std::pair<std::string, uint64>> entries(totals.begin(), totals.end());
+	count = std::min<uint>(count, (uint)entries.size());
+	std::partial_sort(entries.begin(), entries.begin() + count, entries.end(), [](const auto &a, const auto &b) {
+		if (a.second != b.second) return a.second > b.second;
+		return a.first < b.first;
+	});
+
+	IConsolePrintF(CC_DEBUG, OTTD_PRINTF64U " samples over " OTTD_PRINTF64U " ticks, sampled time: " OTTD_PRINTF64U " us",
+			this->samples, _tick_counter - this->start_tick, total / 1000);
+	for (uint i = 0; i < count; i++) {
+		IConsolePrintF(CC_DEBUG, "  %2u: %s: " OTTD_PRINTF64U " us (%u%%)", i + 1, entries[i].first.c_str(), entries[i].second / 1000,
+				total > 0 ? (uint)(entries[i].second * 100 / total) : 0);
+	}
+}
+
+/**
+ * Write the samples as folded stacks, with the self time in nanoseconds as the value of each stack.
+ * @param filename Name of the file to write.
+ * @return True iff the file was written.
+ */
+bool NewGRFSampleProfiler::WriteFoldedStacks(const std::string &filename) const
+{
+	FILE *f = FioFOpenFile(filename, "wt", Subdirectory::NO_DIRECTORY);
+	if (f == nullptr) return false;
+	FileCloser fcloser(f);
+
+	for (const auto &it : this->self_ns) {
+		fprintf(f, "%s " OTTD_PRINTF64U "\n", it.first.c_str(), it.second);
+	}
+	return true;
+}
+
+/**
+ * Get name of the file that will be written.
+ * @return File name of the folded stacks output file.
+ */
+std::string NewGRFSampleProfiler::GetOutputFilename() const
+{
+	char timestamp[16] = {};
+	LocalTime::Format(timestamp, lastof(timestamp), "%Y%m%d-%H%M");
+
+	char filepath[MAX_PATH] = {};
+	seprintf(filepath, lastof(filepath), "%sgrfprofile-%s-sampled.folded", FiosGetScreenshotDir(), timestamp);
+
+	return std::string(filepath);
+}
@@ -19,6 +19,8 @@
 #include <vector>
 #include <string>
 #include <memory>
+#include <chrono>
+#include <unordered_map>
 
 /**
  * Callback profiler for NewGRF development
@@ -61,4 +63,49 @@ struct NewGRFProfiler {
 
 extern std::vector<NewGRFProfiler> _newgrf_profilers;
 
+/**
+ * Sampling callback profiler across all NewGRFs.
+ * Every Nth top-level resolve is timed, including the nested sprite groups it resolves, and the self time of each
+ * group is aggregated by its nesting path. The result can be written as folded stacks for flame graph tools.
+ */
+struct NewGRFSampleProfiler {
+	/** Sprite group resolution in progress within a sample. */
+	struct Frame {
+		std::string path;                                ///< Folded stack of this group.
+		std::chrono::steady_clock::time_point start;     ///< Start of the resolution.
+		uint64 child_ns;                                 ///< Time spent in nested resolutions, in nanoseconds.
+	};
+
+	uint interval = 0;                                   ///< Sample every Nth top-level resolve, 0 when not sampling.
+	uint countdown = 0;                                  ///< Top-level resolves until the next sample.
+	uint64 samples = 0;                                  ///< Number of samples taken.
+	uint64 start_tick = 0;                               ///< Tick number sampling was started on.
+	std::vector<Frame> frames;                           ///< Stack of the resolutions in the current sample.
+	std::unordered_map<std::string, uint64> self_ns;     ///< Self time in nanoseconds per folded stack.
+
+	/**
+	 * Check whether the resolution of a sprite group should be recorded.
+	 * @param top_level Whether this is a top-level resolve.
+	 * @return True iff BeginFrame and EndFrame should be called around the resolution.
+	 */
+	inline bool ShouldRecord(bool top_level)
+	{
+		if (!this->frames.empty()) return true;
+		if (!top_level || --this->countdown != 0) return false;
+		this->countdown = this->interval;
+		this->samples++;
+		return true;
+	}
+
+	void Start(uint interval);
+	void Stop();
+	void BeginFrame(const SpriteGroup *group, const ResolverObject &resolver);
+	void EndFrame();
+	void PrintSummary(uint count) const;
+	bool WriteFoldedStacks(const std::string &filename) const;
+	std::string GetOutputFilename() const;
+};
+
+extern NewGRFSampleProfiler _newgrf_sample_profiler;
+
 #endif /* NEWGRF_PROFILING_H */
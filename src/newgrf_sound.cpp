@@ -156,7 +156,7 @@ bool LoadNewGRFSound(SoundEntry *sound)
 	DEBUG(grf, 1, "LoadNewGRFSound [%s]: RIFF does not contain any sound data", file.GetSimplifiedFilename().c_str());
 
 	/* Clear everything that was read */
-	MemSetT(sound, 0);
+	*sound = {};
 	return false;
 }
 
@@ -64,6 +64,46 @@ GrfSpecFeature GetGrfSpecFeatureForParentScope(GrfSpecFeature feature)
 {
 	if (group == nullptr) return nullptr;
 
+	if (unlikely(_resolver_dependency_tracer.grfid != 0) && top_level) {
+		/* Nested top-level resolves of other objects are not recorded in the dependencies of this one. */
+		ResolverDependencies *prev = _resolver_dependency_tracer.current;
+		_resolver_dependency_tracer.current = _resolver_dependency_tracer.GetDependencies(object);
+		const SpriteGroup *result = SpriteGroup::ResolveSampled(group, object, top_level);
+		_resolver_dependency_tracer.current = prev;
+		return result;
+	}
+
+	return SpriteGroup::ResolveSampled(group, object, top_level);
+}
+
+/**
+ * Resolve a sprite group, recording it in the sampling profiler if it is active.
+ * @param group the group to resolve for
+ * @param object information needed to resolve the group
+ * @param top_level true if this is a top-level SpriteGroup, false if used nested in another SpriteGroup.
+ * @return the resolved group
+ */
+/* static */ const SpriteGroup *SpriteGroup::ResolveSampled(const SpriteGroup *group, ResolverObject &object, bool top_level)
+{
+	if (unlikely(_newgrf_sample_profiler.interval != 0) && _newgrf_sample_profiler.ShouldRecord(top_level)) {
+		_newgrf_sample_profiler.BeginFrame(group, object);
+		const SpriteGroup *result = SpriteGroup::ResolveProfiled(group, object, top_level);
+		_newgrf_sample_profiler.EndFrame();
+		return result;
+	}
+
+	return SpriteGroup::ResolveProfiled(group, object, top_level);
+}
+
+/**
+ * Resolve a sprite group, recording it in the profiler of the NewGRF, if any.
+ * @param group the group to resolve for
+ * @param object information needed to resolve the group
+ * @param top_level true if this is a top-level SpriteGroup, false if used nested in another SpriteGroup.
+ * @return the resolved group
+ */
+/* static */ const SpriteGroup *SpriteGroup::ResolveProfiled(const SpriteGroup *group, ResolverObject &object, bool top_level)
+{
 	const GRFFile *grf = object.grffile;
 	auto profiler = std::find_if(_newgrf_profilers.begin(), _newgrf_profilers.end(), [&](const NewGRFProfiler &pr) { return pr.grffile == grf; });
 
@@ -301,8 +341,10 @@ const SpriteGroup *DeterministicSpriteGroup::Resolve(ResolverObject &object) con
 			/* Note: 'last_value' and 'reseed' are shared between the main chain and the procedure */
 		} else if (adjust.variable == 0x7B) {
 			_sprite_group_resolve_check_veh_check = false;
+			if (unlikely(_resolver_dependency_tracer.current != nullptr)) _resolver_dependency_tracer.current->RecordVariable(this->var_scope, adjust.parameter, last_value);
 			value = GetVariable(object, scope, adjust.parameter, last_value, &extra);
 		} else {
+			if (unlikely(_resolver_dependency_tracer.current != nullptr)) _resolver_dependency_tracer.current->RecordVariable(this->var_scope, adjust.variable, adjust.parameter);
 			value = GetVariable(object, scope, adjust.variable, adjust.parameter, &extra);
 		}
 
@@ -331,7 +373,12 @@ const SpriteGroup *DeterministicSpriteGroup::Resolve(ResolverObject &object) con
 		return &nvarzero;
 	}
 
-	if (this->ranges.size() > 4) {
+	if (!this->range_table.empty()) {
+		const uint32 offset = value - this->range_table_base;
+		if (offset < this->range_table.size() && this->range_table[offset] != RANGE_TABLE_DEFAULT) {
+			return SpriteGroup::Resolve(this->ranges[this->range_table[offset]].group, object, false);
+		}
+	} else if (this->ranges.size() > 4) {
 		const auto &lower = std::lower_bound(this->ranges.begin(), this->ranges.end(), value, RangeHighComparator);
 		if (lower != this->ranges.end() && lower->low <= value) {
 			assert(lower->low <= value && value <= lower->high);
@@ -348,6 +395,33 @@ const SpriteGroup *DeterministicSpriteGroup::Resolve(ResolverObject &object) con
 	return SpriteGroup::Resolve(this->default_group, object, false);
 }
 
+/**
+ * Build the direct lookup table of the ranges, if they cover a small enough span of values.
+ * This replaces the binary search through the ranges in Resolve with a single table lookup.
+ * This must be called again after the ranges have been changed.
+ * @pre The ranges are sorted and do not overlap.
+ */
+void DeterministicSpriteGroup::BuildRangeTable()
+{
+	this->range_table.clear();
+	this->range_table_base = 0;
+
+	if (this->calculated_result || this->ranges.size() <= 4 || this->ranges.size() >= RANGE_TABLE_DEFAULT) return;
+
+	const uint64 span = (uint64)this->ranges.back().high - this->ranges.front().low + 1;
+	if (span > MAX_RANGE_TABLE_SIZE) return;
+
+	this->range_table_base = this->ranges.front().low;
+	this->range_table.assign((size_t)span, RANGE_TABLE_DEFAULT);
+	for (uint i = 0; i < this->ranges.size(); i++) {
+		const DeterministicSpriteGroupRange &range = this->ranges[i];
+		for (uint64 value = range.low; value <= range.high; value++) {
+			this->range_table[value - this->range_table_base] = i;
+		}
+	}
+	this->range_table.shrink_to_fit();
+}
+
 bool DeterministicSpriteGroup::GroupMayBeBypassed() const
 {
 	if (this->calculated_result) return false;
@@ -372,15 +446,108 @@ const SpriteGroup *RandomizedSpriteGroup::Resolve(ResolverObject &object) const
 
 	uint32 mask = ((uint)this->groups.size() - 1) << this->lowest_randbit;
 	byte index = (scope->GetRandomBits() & mask) >> this->lowest_randbit;
+	if (unlikely(_resolver_dependency_tracer.current != nullptr)) SetBit(_resolver_dependency_tracer.current->random_bits_scopes, this->var_scope);
 
 	return SpriteGroup::Resolve(this->groups[index], object, false);
 }
 
 const SpriteGroup *RealSpriteGroup::Resolve(ResolverObject &object) const
 {
+	if (unlikely(_resolver_dependency_tracer.current != nullptr)) _resolver_dependency_tracer.current->real_group = true;
 	return object.ResolveReal(this);
 }
 
+ResolverDependencyTracer _resolver_dependency_tracer;
+
+/**
+ * Record that a variable was read.
+ * @param scope Scope the variable was read in.
+ * @param variable The variable.
+ * @param parameter The parameter of the variable, only relevant for variables 0x60 to 0x7F and extended variables.
+ */
+void ResolverDependencies::RecordVariable(VarSpriteGroupScope scope, uint16 variable, uint32 parameter)
+{
+	if (variable >= 0x100 || (variable >= 0x60 && variable < 0x80)) {
+		this->parameterised.insert((scope << 28) | (variable << 8) | GB(parameter, 0, 8));
+	} else {
+		this->variables[scope].set(variable);
+	}
+}
+
+/**
+ * Print the recorded dependencies.
+ * @param prefix Prefix of each line.
+ * @param print Function to print a line.
+ */
+void ResolverDependencies::Dump(const char *prefix, std::function<void(const char *)> print) const
+{
+	static const char * const scope_names[VSG_END] = { "self", "parent", "relative" };
+
+	char buffer[512];
+	for (VarSpriteGroupScope scope = VSG_BEGIN; scope < VSG_END; scope++) {
+		char *b = buffer;
+		b += seprintf(b, lastof(buffer), "%s%s:", prefix, scope_names[scope]);
+		bool any = false;
+		for (uint i = 0; i < 0x100; i++) {
+			if (!this->variables[scope].test(i)) continue;
+			b += seprintf(b, lastof(buffer), " %02X", i);
+			any = true;
+		}
+		for (uint32 key : this->parameterised) {
+			if ((VarSpriteGroupScope)GB(key, 28, 4) != scope) continue;
+			b += seprintf(b, lastof(buffer), " %02X[%02X]", GB(key, 8, 16), GB(key, 0, 8));
+			any = true;
+		}
+		if (HasBit(this->random_bits_scopes, scope)) {
+			b += seprintf(b, lastof(buffer), " random bits");
+			any = true;
+		}
+		if (any) print(buffer);
+	}
+	if (this->real_group) {
+		seprintf(buffer, lastof(buffer), "%sreal sprite group (set picked by object state)", prefix);
+		print(buffer);
+	}
+}
+
+/**
+ * Start tracing resolves, discarding previously recorded dependencies.
+ * @param grfid GRF ID to trace.
+ * @param feature Feature to trace.
+ */
+void ResolverDependencyTracer::Start(uint32 grfid, GrfSpecFeature feature)
+{
+	this->grfid = grfid;
+	this->feature = feature;
+	this->current = nullptr;
+	this->callbacks.clear();
+}
+
+/**
+ * Stop tracing resolves and discard the recorded dependencies.
+ */
+void ResolverDependencyTracer::Stop()
+{
+	this->grfid = 0;
+	this->feature = GSF_INVALID;
+	this->current = nullptr;
+	this->callbacks.clear();
+}
+
+/**
+ * Get the dependencies to record a top-level resolve into.
+ * @param object The object being resolved.
+ * @return The dependencies of the callback being resolved, or nullptr if the resolve is not traced.
+ */
+ResolverDependencies *ResolverDependencyTracer::GetDependencies(const ResolverObject &object)
+{
+	if (object.grffile == nullptr || object.grffile->grfid != this->grfid || object.GetFeature() != this->feature) return nullptr;
+
+	ResolverDependencies *deps = &this->callbacks[object.callback];
+	deps->resolves++;
+	return deps;
+}
+
 /**
  * Process registers and the construction stage into the sprite layout.
  * The passed construction stage might get reset to zero, if it gets incorporated into the layout
@@ -20,8 +20,11 @@
 #include "newgrf_storage.h"
 #include "newgrf_commons.h"
 
+#include "3rdparty/cpp-btree/btree_map.h"
 #include "3rdparty/cpp-btree/btree_set.h"
 
+#include <bitset>
+#include <functional>
 #include <map>
 #include <vector>
 
@@ -88,6 +91,10 @@ public:
 	virtual void AnalyseCallbacks(AnalyseCallbackOperation &op) const {};
 
 	static const SpriteGroup *Resolve(const SpriteGroup *group, ResolverObject &object, bool top_level = true);
+
+private:
+	static const SpriteGroup *ResolveSampled(const SpriteGroup *group, ResolverObject &object, bool top_level);
+	static const SpriteGroup *ResolveProfiled(const SpriteGroup *group, ResolverObject &object, bool top_level);
 };
 
 
@@ -498,6 +505,11 @@ struct DeterministicSpriteGroup : SpriteGroup {
 	DeterministicSpriteGroupFlags dsg_flags = DSGF_NONE;
 	std::vector<DeterministicSpriteGroupAdjust> adjusts;
 	std::vector<DeterministicSpriteGroupRange> ranges; // Dynamically allocated
+	std::vector<uint8> range_table;   ///< Index into ranges for each value from range_table_base, or RANGE_TABLE_DEFAULT. Empty when ranges are searched instead.
+	uint32 range_table_base = 0;      ///< Value of the first entry of range_table.
+
+	static constexpr uint8 RANGE_TABLE_DEFAULT = 0xFF;      ///< Entry of range_table for values which are not in any range.
+	static constexpr uint32 MAX_RANGE_TABLE_SIZE = 256;     ///< Maximum span of values covered by range_table.
 
 	/* Dynamically allocated, this is the sole owner */
 	const SpriteGroup *default_group;
@@ -506,6 +518,7 @@ struct DeterministicSpriteGroup : SpriteGroup {
 
 	void AnalyseCallbacks(AnalyseCallbackOperation &op) const override;
 	bool GroupMayBeBypassed() const;
+	void BuildRangeTable();
 
 protected:
 	const SpriteGroup *Resolve(ResolverObject &object) const override;
@@ -794,6 +807,35 @@ public:
 	}
 };
 
+/** Inputs read while resolving sprite groups, as recorded by #ResolverDependencyTracer. */
+struct ResolverDependencies {
+	std::bitset<0x100> variables[VSG_END];   ///< Variables without a parameter read, per scope.
+	btree::btree_set<uint32> parameterised;  ///< Variables read with a parameter (0x60 to 0x7F and extended variables), as (scope << 28) | (variable << 8) | parameter.
+	uint8 random_bits_scopes = 0;            ///< Bitmask of the scopes of which the random bits were read.
+	bool real_group = false;                 ///< Whether a real sprite group was resolved, which picks a set by the state of the object.
+	uint64 resolves = 0;                     ///< Number of top-level resolves recorded.
+
+	void RecordVariable(VarSpriteGroupScope scope, uint16 variable, uint32 parameter);
+	void Dump(const char *prefix, std::function<void(const char *)> print) const;
+};
+
+/**
+ * Records which inputs are read by resolves for one feature of one NewGRF, per callback.
+ * This is the basis for checking whether a result can be cached safely.
+ */
+struct ResolverDependencyTracer {
+	uint32 grfid = 0;                                          ///< GRF ID to trace, 0 if not tracing.
+	GrfSpecFeature feature = GSF_INVALID;                      ///< Feature to trace.
+	ResolverDependencies *current = nullptr;                   ///< Dependencies of the top-level resolve in progress, if it is traced.
+	btree::btree_map<uint16, ResolverDependencies> callbacks;  ///< Dependencies per callback ID.
+
+	void Start(uint32 grfid, GrfSpecFeature feature);
+	void Stop();
+	ResolverDependencies *GetDependencies(const ResolverObject &object);
+};
+
+extern ResolverDependencyTracer _resolver_dependency_tracer;
+
 void DumpSpriteGroup(const SpriteGroup *sg, DumpSpriteGroupPrinter print);
 uint32 EvaluateDeterministicSpriteGroupAdjust(DeterministicSpriteGroupSize size, const DeterministicSpriteGroupAdjust &adjust, ScopeResolver *scope, uint32 last_value, uint32 value);
 
@@ -627,12 +627,65 @@ StationResolverObject::~StationResolverObject()
  */
 SpriteID GetCustomStationRelocation(const StationSpec *statspec, BaseStation *st, TileIndex tile, RailType rt, uint32 var10)
 {
+	if (st != nullptr && HasBit(statspec->internal_flags, SSIF_CONSTANT_RELOCATION)) {
+		/* Registers are read by sprite layouts after resolving, make them as a resolve would have left them. */
+		extern TemporaryStorageArray<int32, 0x110> _temp_store;
+		_temp_store.ClearChanges();
+		return statspec->constant_relocation;
+	}
+
 	StationResolverObject object(statspec, st, tile, rt, CBID_NO_CALLBACK, var10);
 	const SpriteGroup *group = object.Resolve();
 	if (group == nullptr || group->type != SGT_RESULT) return 0;
 	return group->GetResult() - 0x42D;
 }
 
+/**
+ * Get the group a station sprite group resolves to independently of the station, tile and amount of cargo waiting.
+ * @param group Sprite group to check.
+ * @return The result sprite group, or nullptr if the resolved group may differ between station tiles.
+ */
+static const SpriteGroup *GetConstantStationSpriteGroup(const SpriteGroup *group)
+{
+	if (group == nullptr) return nullptr;
+	if (group->type == SGT_RESULT) return group;
+	if (group->type != SGT_REAL) return nullptr;
+
+	/* The loaded and loading sets are picked by the amount of cargo waiting, so they all must be the same. */
+	const RealSpriteGroup *real = static_cast<const RealSpriteGroup *>(group);
+	if (real->loading.empty()) return nullptr;
+	const SpriteGroup *result = real->loading[0];
+	for (const SpriteGroup *set : real->loading) {
+		if (set != result) return nullptr;
+	}
+	for (const SpriteGroup *set : real->loaded) {
+		if (set != result) return nullptr;
+	}
+	return (result != nullptr && result->type == SGT_RESULT) ? result : nullptr;
+}
+
+/**
+ * Check whether the sprites of built station tiles of a station spec do not depend on the station, tile or cargo waiting,
+ * and if so store the sprite relocation, to save resolving it each time a tile is drawn.
+ * @param statspec Station spec to set up, after all NewGRFs are loaded.
+ */
+void SetupStationSpecConstantRelocation(StationSpec *statspec)
+{
+	ClrBit(statspec->internal_flags, SSIF_CONSTANT_RELOCATION);
+	statspec->constant_relocation = 0;
+
+	/* Cargo specific groups are picked by the cargo waiting at the station. */
+	for (uint i = 0; i < lengthof(statspec->grf_prop.spritegroup); i++) {
+		if (i != CT_DEFAULT && i != CT_PURCHASE && statspec->grf_prop.spritegroup[i] != nullptr) return;
+	}
+
+	const SpriteGroup *result = GetConstantStationSpriteGroup(statspec->grf_prop.spritegroup[CT_DEFAULT]);
+	if (result == nullptr) return;
+
+	statspec->constant_relocation = result->GetResult() - 0x42D;
+	SetBit(statspec->internal_flags, SSIF_CONSTANT_RELOCATION);
+}
+
 /**
  * Resolve the sprites for custom station foundations.
  * @param statspec Station spec
@@ -1057,7 +1110,7 @@ void DumpStationSpriteGroup(const StationSpec *statspec, BaseStation *st, DumpSp
 	SpriteGroupDumper dumper(print);
 	dumper.DumpSpriteGroup(ro.root_spritegroup, 0);
 
-	for (uint i = 0; i < NUM_CARGO + 3; i++) {
+	for (uint i = 0; i < lengthof(statspec->grf_prop.spritegroup); i++) {
 		if (statspec->grf_prop.spritegroup[i] != ro.root_spritegroup && statspec->grf_prop.spritegroup[i] != nullptr) {
 			print(nullptr, DSGPO_PRINT, 0, "");
 			switch (i) {
@@ -122,6 +122,7 @@ enum StationRandomTrigger {
 enum StationSpecIntlFlags {
 	SSIF_BRIDGE_HEIGHTS_SET,            ///< byte bridge_height[8] is set.
 	SSIF_BRIDGE_DISALLOWED_PILLARS_SET, ///< byte bridge_disallowed_pillars[8] is set.
+	SSIF_CONSTANT_RELOCATION,           ///< The sprites resolve to #StationSpec::constant_relocation on all built station tiles.
 };
 
 /** Station specification. */
@@ -183,6 +184,7 @@ struct StationSpec {
 	AnimationInfo animation;
 
 	byte internal_flags; ///< Bitmask of internal spec flags (StationSpecIntlFlags)
+	SpriteID constant_relocation = 0; ///< Sprite relocation of built station tiles, valid if SSIF_CONSTANT_RELOCATION is set.
 
 	/**
 	 * Custom platform layouts.
@@ -204,6 +206,7 @@ const StationSpec *GetStationSpec(TileIndex t);
 uint32 GetPlatformInfo(Axis axis, byte tile, int platforms, int length, int x, int y, bool centred);
 
 SpriteID GetCustomStationRelocation(const StationSpec *statspec, BaseStation *st, TileIndex tile, RailType rt, uint32 var10 = 0);
+void SetupStationSpecConstantRelocation(StationSpec *statspec);
 SpriteID GetCustomStationFoundationRelocation(const StationSpec *statspec, BaseStation *st, TileIndex tile, uint layout, uint edge_info);
 uint16 GetStationCallback(CallbackID callback, uint32 param1, uint32 param2, const StationSpec *statspec, BaseStation *st, TileIndex tile, RailType rt);
 CommandCost PerformStationTileSlopeCheck(TileIndex north_tile, TileIndex cur_tile, RailType rt, const StationSpec *statspec, Axis axis, byte plat_len, byte numtracks);
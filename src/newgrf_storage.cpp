@@ -12,15 +12,29 @@
 #include "core/pool_func.hpp"
 #include "core/endian_func.hpp"
 #include "debug.h"
-#include "3rdparty/cpp-btree/btree_set.h"
+#include "string_func.h"
+
+#include <algorithm>
+#include <vector>
 
 #include "safeguards.h"
 
 PersistentStoragePool _persistent_storage_pool("PersistentStorage");
 INSTANTIATE_POOL_METHODS(PersistentStorage)
 
-/** The changed storage arrays */
-static btree::btree_set<BasePersistentStorageArray*> _changed_storage_arrays;
+/**
+ * The changed storage arrays.
+ * An array is only added when it makes its backup, so each array is in here at most once.
+ */
+static std::vector<BasePersistentStorageArray*> _changed_storage_arrays;
+
+/** Statistics of the storage arrays which had changes discarded, per mode switch. */
+struct PersistentStorageModeStats {
+	uint64 switches = 0;     ///< Number of switches.
+	uint64 discarded = 0;    ///< Number of arrays of which the changes were discarded.
+	uint max_discarded = 0;  ///< Maximum number of arrays of which the changes were discarded at a single switch.
+};
+static PersistentStorageModeStats _persistent_storage_stats[PSM_LEAVE_TESTMODE + 1];
 
 bool BasePersistentStorageArray::gameloop;
 bool BasePersistentStorageArray::command;
@@ -31,7 +45,8 @@ bool BasePersistentStorageArray::testmode;
  */
 BasePersistentStorageArray::~BasePersistentStorageArray()
 {
-	_changed_storage_arrays.erase(this);
+	auto iter = std::find(_changed_storage_arrays.begin(), _changed_storage_arrays.end(), this);
+	if (iter != _changed_storage_arrays.end()) _changed_storage_arrays.erase(iter);
 }
 
 /**
@@ -42,7 +57,7 @@ BasePersistentStorageArray::~BasePersistentStorageArray()
  */
 void AddChangedPersistentStorage(BasePersistentStorageArray *storage)
 {
-	_changed_storage_arrays.insert(storage);
+	_changed_storage_arrays.push_back(storage);
 }
 
 /**
@@ -90,6 +105,11 @@ void AddChangedPersistentStorage(BasePersistentStorageArray *storage)
 		default: NOT_REACHED();
 	}
 
+	PersistentStorageModeStats &stats = _persistent_storage_stats[mode];
+	stats.switches++;
+	stats.discarded += _changed_storage_arrays.size();
+	stats.max_discarded = std::max<uint>(stats.max_discarded, (uint)_changed_storage_arrays.size());
+
 	/* Discard all temporary changes */
 	for (auto &it : _changed_storage_arrays) {
 		DEBUG(desync, 1, "Discarding persistent storage changes: Feature %d, GrfID %08X, Tile %d", it->feature, BSWAP32(it->grfid), it->tile);
@@ -97,3 +117,34 @@ void AddChangedPersistentStorage(BasePersistentStorageArray *storage)
 	}
 	_changed_storage_arrays.clear();
 }
+
+/**
+ * Dump the statistics of the persistent storage arrays which had changes discarded.
+ * Only arrays which were written to outside of persistent mode are backed up and discarded.
+ * @param buffer Buffer to print to.
+ * @param last Last character of the buffer.
+ * @return Pointer to the end of the printed text.
+ */
+char *DumpPersistentStorageStats(char *buffer, const char *last)
+{
+	static const char * const mode_names[] = {
+		"Enter game loop", "Leave game loop", "Enter command", "Leave command", "Enter test mode", "Leave test mode",
+	};
+	static_assert(lengthof(mode_names) == lengthof(_persistent_storage_stats));
+
+	buffer += seprintf(buffer, last, "Persistent storage arrays discarded, per mode switch:\n");
+	for (uint i = 0; i < lengthof(_persistent_storage_stats); i++) {
+		const PersistentStorageModeStats &stats = _persistent_storage_stats[i];
+		buffer += seprintf(buffer, last, "  %s: " OTTD_PRINTF64U " switches, " OTTD_PRINTF64U " arrays discarded, max %u per switch\n",
+				mode_names[i], stats.switches, stats.discarded, stats.max_discarded);
+	}
+	return buffer;
+}
+
+/**
+ * Reset the statistics of the persistent storage arrays which had changes discarded.
+ */
+void ResetPersistentStorageStats()
+{
+	for (PersistentStorageModeStats &stats : _persistent_storage_stats) stats = {};
+}
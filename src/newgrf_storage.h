@@ -184,6 +184,8 @@ struct TemporaryStorageArray {
 };
 
 void AddChangedPersistentStorage(BasePersistentStorageArray *storage);
+char *DumpPersistentStorageStats(char *buffer, const char *last);
+void ResetPersistentStorageStats();
 
 typedef PersistentStorageArray<int32, 16> OldPersistentStorage;
 
@@ -24,6 +24,7 @@
 #include "company_func.h"
 #include "command_func.h"
 #include "command_log.h"
+#include "command_journal.h"
 #include "news_func.h"
 #include "fios.h"
 #include "load_check.h"
@@ -95,6 +96,8 @@
 #include "network/network_sync.h"
 
 #include "linkgraph/linkgraphschedule.h"
+#include "pathfinder/water_regions.h"
+#include "signal_func.h"
 #include "tracerestrict.h"
 
 #include "3rdparty/cpp-btree/btree_set.h"
@@ -107,6 +110,7 @@
 
 #include <stdarg.h>
 #include <system_error>
+#include <chrono>
 
 #include "safeguards.h"
 
@@ -460,6 +464,9 @@ static void ShutdownGame()
 
 	if (_network_available) NetworkShutDown(); // Shut down the network and close any open connections
 
+	StopCommandJournal();
+	StopCommandJournalReplay();
+
 	DriverFactoryBase::ShutdownDrivers();
 
 	UnInitWindowSystem();
@@ -919,6 +926,7 @@ int openttd_main(int argc, char *argv[])
 #endif
 
 	LoadFromConfig(true);
+	ApplyCPUAffinity();
 
 	if (resolution.width != 0) _cur_resolution = resolution;
 
@@ -1542,6 +1550,9 @@ static bool SignalInfraTotalMatches()
 	return old_signal_totals == new_signal_totals;
 }
 
+/** Time limit per tick for CheckCaches when only checking a rotating slice of vehicles and stations, @see DCBF_DESYNC_CHECK_SAMPLED */
+static const std::chrono::microseconds CHECK_CACHES_SAMPLE_BUDGET(250);
+
 /**
  * Check the validity of some of the caches.
  * Especially in the sense of desyncs between
@@ -1550,6 +1561,9 @@ static bool SignalInfraTotalMatches()
  */
 void CheckCaches(bool force_check, std::function<void(const char *)> log, CheckCachesFlags flags)
 {
+	/* Whether to only check a rotating slice of vehicles and stations, limited by CHECK_CACHES_SAMPLE_BUDGET */
+	bool sampled = false;
+
 	if (!force_check) {
 		int desync_level = _debug_desync_level;
 
@@ -1563,12 +1577,13 @@ void CheckCaches(bool force_check, std::function<void(const char *)> log, CheckC
 
 		/* Return here so it is easy to add checks that are run
 		 * always to aid testing of caches. */
-		if (desync_level < 1) return;
-
-		if (desync_level == 1 && _scaled_date_ticks % 500 != 0) return;
+		if (desync_level < 1 || (desync_level == 1 && _scaled_date_ticks % 500 != 0)) {
+			if (!HasChickenBit(DCBF_DESYNC_CHECK_SAMPLED)) return;
+			sampled = true;
+		}
 	}
 
-	SCOPE_INFO_FMT([flags], "CheckCaches: %X", flags);
+	SCOPE_INFO_FMT([&], "CheckCaches: %X%s", flags, sampled ? " (sampled)" : "");
 
 	std::vector<std::string> saved_messages;
 	std::function<void(const char *)> log_orig;
@@ -1618,7 +1633,7 @@ void CheckCaches(bool force_check, std::function<void(const char *)> log, CheckC
 	cclog_common(); \
 }
 
-	if (flags & CHECK_CACHE_GENERAL) {
+	if ((flags & CHECK_CACHE_GENERAL) && !sampled) {
 		/* Check the town caches. */
 		std::vector<TownCache> old_town_caches;
 		std::vector<StationList> old_town_stations_nears;
@@ -1630,10 +1645,12 @@ void CheckCaches(bool force_check, std::function<void(const char *)> log, CheckC
 		std::vector<IndustryList> old_station_industries_nears;
 		std::vector<BitmapTileArea> old_station_catchment_tiles;
 		std::vector<uint> old_station_tiles;
+		std::vector<std::vector<TileIndex>> old_station_acceptance_tiles;
 		for (Station *st : Station::Iterate()) {
 			old_station_industries_nears.push_back(st->industries_near);
 			old_station_catchment_tiles.push_back(st->catchment_tiles);
 			old_station_tiles.push_back(st->station_tiles);
+			old_station_acceptance_tiles.push_back(st->GetAcceptanceTiles());
 		}
 
 		std::vector<StationList> old_industry_stations_nears;
@@ -1679,6 +1696,9 @@ void CheckCaches(bool force_check, std::function<void(const char *)> log, CheckC
 			if (!(old_station_tiles[i] == st->station_tiles)) {
 				CCLOG("station station_tiles mismatch: st %i, (old: %u, new: %u)", (int)st->index, old_station_tiles[i], st->station_tiles);
 			}
+			if (old_station_acceptance_tiles[i] != st->GetAcceptanceTiles()) {
+				CCLOG("station acceptance_tiles mismatch: st %i, (old size: %u, new size: %u)", (int)st->index, (uint)old_station_acceptance_tiles[i].size(), (uint)st->GetAcceptanceTiles().size());
+			}
 			i++;
 		}
 		i = 0;
@@ -1706,7 +1726,7 @@ void CheckCaches(bool force_check, std::function<void(const char *)> log, CheckC
 		}
 	}
 
-	if (flags & CHECK_CACHE_INFRA_TOTALS) {
+	if ((flags & CHECK_CACHE_INFRA_TOTALS) && !sampled) {
 		/* Check company infrastructure cache. */
 		std::vector<CompanyInfrastructure> old_infrastructure;
 		for (const Company *c : Company::Iterate()) old_infrastructure.push_back(c->infrastructure);
@@ -1737,23 +1757,14 @@ void CheckCaches(bool force_check, std::function<void(const char *)> log, CheckC
 	}
 
 	if (flags & CHECK_CACHE_GENERAL) {
-		/* Strict checking of the road stop cache entries */
-		for (const RoadStop *rs : RoadStop::Iterate()) {
-			if (IsStandardRoadStopTile(rs->xy)) continue;
-
-			assert(rs->GetEntry(DIAGDIR_NE) != rs->GetEntry(DIAGDIR_NW));
-			rs->GetEntry(DIAGDIR_NE)->CheckIntegrity(rs);
-			rs->GetEntry(DIAGDIR_NW)->CheckIntegrity(rs);
-		}
-
-		for (Vehicle *v : Vehicle::Iterate()) {
+		auto check_vehicle_caches = [&](Vehicle *v) {
 			extern bool ValidateVehicleTileHash(const Vehicle *v);
 			if (!ValidateVehicleTileHash(v)) {
 				CCLOG("vehicle tile hash mismatch: type %i, vehicle %i, company %i, unit number %i", (int)v->type, v->index, (int)v->owner, v->unitnumber);
 			}
 
 			extern void FillNewGRFVehicleCache(const Vehicle *v);
-			if (v != v->First() || v->vehstatus & VS_CRASHED || !v->IsPrimaryVehicle()) continue;
+			if (v != v->First() || v->vehstatus & VS_CRASHED || !v->IsPrimaryVehicle()) return;
 
 			uint length = 0;
 			for (const Vehicle *u = v; u != nullptr; u = u->Next()) {
@@ -1923,10 +1934,9 @@ void CheckCaches(bool force_check, std::function<void(const char *)> log, CheckC
 			free(air_cache);
 			free(tra_cache);
 			free(veh_old);
-		}
+		};
 
-		/* Check whether the caches are still valid */
-		for (Vehicle *v : Vehicle::Iterate()) {
+		auto check_vehicle_cargo_cache = [&](Vehicle *v) {
 			Money old_feeder_share = v->cargo.GetFeederShare();
 			uint old_count = v->cargo.TotalCount();
 			uint64 old_cargo_periods_in_transit = v->cargo.CargoPeriodsInTransit();
@@ -1943,9 +1953,13 @@ void CheckCaches(bool force_check, std::function<void(const char *)> log, CheckC
 						HasBit(changed, 1) ? 't' : '-',
 						HasBit(changed, 2) ? 'p' : '-');
 			}
-		}
+		};
+
+		auto check_station_caches = [&](Station *st) {
+			if (st->loading_vehicles.empty() == (_stations_with_loading_vehicles.count(st->index) != 0)) {
+				CCLOG("stations with loading vehicles set mismatch: station %i, loading vehicles: %u", st->index, (uint)st->loading_vehicles.size());
+			}
 
-		for (Station *st : Station::Iterate()) {
 			for (CargoID c = 0; c < NUM_CARGO; c++) {
 				if (st->goods[c].data == nullptr) continue;
 
@@ -1982,50 +1996,109 @@ void CheckCaches(bool force_check, std::function<void(const char *)> log, CheckC
 					CCLOG("docking tile mismatch: tile %i", (int)tile);
 				}
 			}
-		}
+		};
 
-		for (OrderList *order_list : OrderList::Iterate()) {
-			order_list->DebugCheckSanity();
-		}
+		if (sampled) {
+			/* Check as many vehicles and stations as fit in the time budget, continuing from where the previous sampled check stopped */
+			static size_t vehicle_cursor = 0;
+			static size_t station_cursor = 0;
 
-		extern void ValidateVehicleTickCaches();
-		ValidateVehicleTickCaches();
+			const auto deadline = std::chrono::steady_clock::now() + CHECK_CACHES_SAMPLE_BUDGET;
 
-		for (Vehicle *v : Vehicle::Iterate()) {
-			if (v->Previous()) assert_msg(v->Previous()->Next() == v, "%u", v->index);
-			if (v->Next()) assert_msg(v->Next()->Previous() == v, "%u", v->index);
-		}
-		for (const TemplateVehicle *tv : TemplateVehicle::Iterate()) {
-			if (tv->Prev()) assert_msg(tv->Prev()->Next() == tv, "%u", tv->index);
-			if (tv->Next()) assert_msg(tv->Next()->Prev() == tv, "%u", tv->index);
-		}
+			for (size_t checked = 0; checked < Vehicle::GetPoolSize() && std::chrono::steady_clock::now() < deadline; checked++) {
+				if (vehicle_cursor >= Vehicle::GetPoolSize()) vehicle_cursor = 0;
+				Vehicle *v = Vehicle::GetIfValid(vehicle_cursor++);
+				if (v == nullptr) continue;
+				check_vehicle_caches(v);
+				check_vehicle_cargo_cache(v);
+			}
 
-		{
-			extern std::string ValidateTemplateReplacementCaches();
-			std::string template_validation_result = ValidateTemplateReplacementCaches();
-			if (!template_validation_result.empty()) {
-				CCLOG("Template replacement cache validation failed: %s", template_validation_result.c_str());
+			for (size_t checked = 0; checked < Station::GetPoolSize() && std::chrono::steady_clock::now() < deadline; checked++) {
+				if (station_cursor >= Station::GetPoolSize()) station_cursor = 0;
+				Station *st = Station::GetIfValid(station_cursor++);
+				if (st == nullptr) continue;
+				check_station_caches(st);
+			}
+		} else {
+			/* Strict checking of the road stop cache entries */
+			for (const RoadStop *rs : RoadStop::Iterate()) {
+				if (IsStandardRoadStopTile(rs->xy)) continue;
+
+				assert(rs->GetEntry(DIAGDIR_NE) != rs->GetEntry(DIAGDIR_NW));
+				rs->GetEntry(DIAGDIR_NE)->CheckIntegrity(rs);
+				rs->GetEntry(DIAGDIR_NW)->CheckIntegrity(rs);
+			}
+
+			for (Vehicle *v : Vehicle::Iterate()) {
+				check_vehicle_caches(v);
+			}
+
+			/* Check whether the caches are still valid */
+			for (Vehicle *v : Vehicle::Iterate()) {
+				check_vehicle_cargo_cache(v);
+			}
+
+			for (Station *st : Station::Iterate()) {
+				check_station_caches(st);
 			}
-		}
 
-		if (!TraceRestrictSlot::ValidateVehicleIndex()) CCLOG("Trace restrict slot vehicle index validation failed");
-		TraceRestrictSlot::ValidateSlotOccupants(log);
+			for (OrderList *order_list : OrderList::Iterate()) {
+				order_list->DebugCheckSanity();
+			}
+
+			extern void ValidateVehicleTickCaches();
+			ValidateVehicleTickCaches();
 
-		if (!CargoPacket::ValidateDeferredCargoPayments()) CCLOG("Cargo packets deferred payments validation failed");
+			for (Vehicle *v : Vehicle::Iterate()) {
+				if (v->Previous()) assert_msg(v->Previous()->Next() == v, "%u", v->index);
+				if (v->Next()) assert_msg(v->Next()->Previous() == v, "%u", v->index);
+			}
+			for (const TemplateVehicle *tv : TemplateVehicle::Iterate()) {
+				if (tv->Prev()) assert_msg(tv->Prev()->Next() == tv, "%u", tv->index);
+				if (tv->Next()) assert_msg(tv->Next()->Prev() == tv, "%u", tv->index);
+			}
 
-		if (_order_destination_refcount_map_valid) {
-			btree::btree_map<uint32, uint32> saved_order_destination_refcount_map = std::move(_order_destination_refcount_map);
-			for (auto iter = saved_order_destination_refcount_map.begin(); iter != saved_order_destination_refcount_map.end();) {
-				if (iter->second == 0) {
-					iter = saved_order_destination_refcount_map.erase(iter);
-				} else {
-					++iter;
+			{
+				extern std::string ValidateTemplateReplacementCaches();
+				std::string template_validation_result = ValidateTemplateReplacementCaches();
+				if (!template_validation_result.empty()) {
+					CCLOG("Template replacement cache validation failed: %s", template_validation_result.c_str());
 				}
 			}
-			IntialiseOrderDestinationRefcountMap();
-			if (saved_order_destination_refcount_map != _order_destination_refcount_map) CCLOG("Order destination refcount map mismatch");
-		} else {
-			CCLOG("Order destination refcount map not valid");
+
+			{
+				std::string water_region_validation_result = ValidateWaterRegions();
+				if (!water_region_validation_result.empty()) {
+					CCLOG("Water region cache validation failed: %s", water_region_validation_result.c_str());
+				}
+			}
+
+			{
+				std::string signal_segment_validation_result = ValidateSignalSegmentCache();
+				if (!signal_segment_validation_result.empty()) {
+					CCLOG("Signal segment cache validation failed: %s", signal_segment_validation_result.c_str());
+				}
+			}
+
+			if (!TraceRestrictSlot::ValidateVehicleIndex()) CCLOG("Trace restrict slot vehicle index validation failed");
+			TraceRestrictSlot::ValidateSlotOccupants(log);
+
+			if (!CargoPacket::ValidateDeferredCargoPayments()) CCLOG("Cargo packets deferred payments validation failed");
+
+			if (_order_destination_refcount_map_valid) {
+				btree::btree_map<uint32, uint32> saved_order_destination_refcount_map = std::move(_order_destination_refcount_map);
+				for (auto iter = saved_order_destination_refcount_map.begin(); iter != saved_order_destination_refcount_map.end();) {
+					if (iter->second == 0) {
+						iter = saved_order_destination_refcount_map.erase(iter);
+					} else {
+						++iter;
+					}
+				}
+				IntialiseOrderDestinationRefcountMap();
+				if (saved_order_destination_refcount_map != _order_destination_refcount_map) CCLOG("Order destination refcount map mismatch");
+			} else {
+				CCLOG("Order destination refcount map not valid");
+			}
 		}
 	}
 
@@ -2081,6 +2154,13 @@ void StateGameLoop()
 		PerformanceMeasurer::Paused(PFE_GL_SHIPS);
 		PerformanceMeasurer::Paused(PFE_GL_AIRCRAFT);
 		PerformanceMeasurer::Paused(PFE_GL_LANDSCAPE);
+		PerformanceMeasurer::Paused(PFE_GL_LS_TILELOOP);
+		PerformanceMeasurer::Paused(PFE_GL_LS_ANIMATION);
+		PerformanceMeasurer::Paused(PFE_GL_LS_TOWNS);
+		PerformanceMeasurer::Paused(PFE_GL_LS_TREES);
+		PerformanceMeasurer::Paused(PFE_GL_LS_STATIONS);
+		PerformanceMeasurer::Paused(PFE_GL_LS_INDUSTRIES);
+		PerformanceMeasurer::Paused(PFE_GL_LS_COMPANIES);
 
 		if (!HasModalProgress()) UpdateLandscapingLimits();
 #ifndef DEBUG_DUMP_COMMANDS
@@ -2091,6 +2171,13 @@ void StateGameLoop()
 
 	PerformanceMeasurer framerate(PFE_GAMELOOP);
 	PerformanceAccumulator::Reset(PFE_GL_LANDSCAPE);
+	PerformanceAccumulator::Reset(PFE_GL_LS_TILELOOP);
+	PerformanceAccumulator::Reset(PFE_GL_LS_ANIMATION);
+	PerformanceAccumulator::Reset(PFE_GL_LS_TOWNS);
+	PerformanceAccumulator::Reset(PFE_GL_LS_TREES);
+	PerformanceAccumulator::Reset(PFE_GL_LS_STATIONS);
+	PerformanceAccumulator::Reset(PFE_GL_LS_INDUSTRIES);
+	PerformanceAccumulator::Reset(PFE_GL_LS_COMPANIES);
 
 	Layouter::ReduceLineCache();
 
@@ -2160,7 +2247,7 @@ void StateGameLoop()
 #endif
 		UpdateLandscapingLimits();
 
-		CallWindowGameTickEvent();
+		if (!_network_catching_up) CallWindowGameTickEvent();
 		NewsLoop();
 
 		if (_networking) {
@@ -2169,14 +2256,18 @@ void StateGameLoop()
 				DEBUG_UPDATESTATECHECKSUM("Company: %u, Money: " OTTD_PRINTF64, c->index, (int64)c->money);
 				UpdateStateChecksum(c->money);
 
+				/* Most road and rail types are not in use, only include non-zero counts (with their type index).
+				 * A mismatch in whether a count is zero still results in a checksum mismatch. */
 				for (uint i = 0; i < ROADTYPE_END; i++) {
+					if (c->infrastructure.road[i] == 0) continue;
 					DEBUG_UPDATESTATECHECKSUM("Company: %u, road[%u]: %u", c->index, i, c->infrastructure.road[i]);
-					UpdateStateChecksum(c->infrastructure.road[i]);
+					UpdateStateChecksum((((uint64) i) << 32) | c->infrastructure.road[i]);
 				}
 
 				for (uint i = 0; i < RAILTYPE_END; i++) {
+					if (c->infrastructure.rail[i] == 0) continue;
 					DEBUG_UPDATESTATECHECKSUM("Company: %u, rail[%u]: %u", c->index, i, c->infrastructure.rail[i]);
-					UpdateStateChecksum(c->infrastructure.rail[i]);
+					UpdateStateChecksum((((uint64) i) << 32) | c->infrastructure.rail[i]);
 				}
 
 				DEBUG_UPDATESTATECHECKSUM("Company: %u, signal: %u, water: %u, station: %u, airport: %u",
@@ -2345,7 +2436,11 @@ void GameLoop()
 			NetworkClientConnectGame(_settings_client.network.last_joined, COMPANY_SPECTATOR);
 		}
 		/* Singleplayer */
-		StateGameLoop();
+		if (_command_journal_replay_active) {
+			CommandJournalReplayStateGameLoop();
+		} else {
+			StateGameLoop();
+		}
 	}
 	ExecuteCommandQueue();
 
@@ -22,6 +22,7 @@
 #include "gfx_type.h"
 #include "sl/saveload_common.h"
 
+#include <algorithm>
 #include <memory>
 #include <vector>
 #include "3rdparty/cpp-btree/btree_map.h"
@@ -818,6 +819,44 @@ public:
 	 */
 	inline int32 GetScheduledDispatchDelay() const { return this->scheduled_dispatch_max_delay; }
 
+	/**
+	 * Find the first dispatch slot at or after a given time, which is accepted by a predicate.
+	 * The slots are visited in order of time, starting with a binary search in the sorted slot list,
+	 * so this does not depend on the number of slots when the first visited slot is accepted.
+	 * @param earliest Earliest acceptable slot time, in absolute scaled ticks.
+	 * @param is_available Predicate taking the slot time, returning whether the slot can be used.
+	 * @return The slot time, in absolute scaled ticks, or -1 if there are no usable slots.
+	 */
+	template <typename F>
+	DateTicksScaled FindScheduledDispatchSlot(DateTicksScaled earliest, F is_available) const
+	{
+		const uint32 duration = this->scheduled_dispatch_duration;
+
+		/* Slots with an offset not less than the duration are never used. */
+		const auto first = this->scheduled_dispatch.begin();
+		const auto last = std::lower_bound(first, this->scheduled_dispatch.end(), duration);
+		if (first == last) return -1;
+
+		const DateTicksScaled begin_time = this->GetScheduledDispatchStartTick();
+		DateTicksScaled cycle_start = begin_time;
+		auto iter = first;
+		if (earliest > begin_time) {
+			const DateTicksScaled offset = earliest - begin_time;
+			cycle_start += offset - (offset % duration);
+			iter = std::lower_bound(first, last, (uint32)(offset % duration));
+		}
+
+		while (true) {
+			if (iter == last) {
+				iter = first;
+				cycle_start += duration;
+			}
+			const DateTicksScaled slot = cycle_start + *iter;
+			if (is_available(slot)) return slot;
+			++iter;
+		}
+	}
+
 	inline void BorrowSchedule(DispatchSchedule &other)
 	{
 		this->CopyBasicFields(other);
@@ -986,6 +1025,8 @@ public:
 	void DebugCheckSanity() const;
 	bool CheckOrderListIndexing() const;
 
+	static void CompactPoolIndices();
+
 	inline std::vector<DispatchSchedule> &GetScheduledDispatchScheduleSet() { return this->dispatch_schedules; }
 	inline const std::vector<DispatchSchedule> &GetScheduledDispatchScheduleSet() const { return this->dispatch_schedules; }
 
@@ -840,6 +840,22 @@ bool OrderList::IsCompleteTimetable() const
 	return true;
 }
 
+/**
+ * Renumber all order lists so that they use the lowest pool indexes, without any holes, and release the unused part of the pool.
+ * Vehicles refer to their order list by pointer, the index is only used for saving, so this can be done by one instance of a network game independently of the others.
+ */
+/* static */ void OrderList::CompactPoolIndices()
+{
+	const size_t old_size = OrderList::GetPoolSize();
+	size_t moved_count = 0;
+	_orderlist_pool.CompactIndices([&](OrderList *, size_t) {
+		moved_count++;
+	});
+	_orderlist_pool.ShrinkPool();
+	DEBUG(misc, 2, "Compacted order list pool: " PRINTF_SIZE " lists, " PRINTF_SIZE " moved, used index range " PRINTF_SIZE " -> " PRINTF_SIZE,
+			OrderList::GetNumItems(), moved_count, old_size, OrderList::GetPoolSize());
+}
+
 /**
  * Checks for internal consistency of order list. Triggers assertion if something is wrong.
  */
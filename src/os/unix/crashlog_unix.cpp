@@ -523,6 +523,11 @@ class CrashLogUnix : public CrashLog {
 #if defined(WITH_BFD)
 		bfd_init();
 #endif /* WITH_BFD */
+#if defined(WITH_DL2)
+		/* Spawning addr2line is by far the slowest part of the crash log, don't keep trying where it can't help. */
+		bool addr2line_available = true;
+		const char *addr2line_failed_file = nullptr;
+#endif /* WITH_DL2 */
 
 		for (int i = 0; i < trace_size; i++) {
 			auto guard = scope_guard([&]() {
@@ -542,7 +547,8 @@ class CrashLogUnix : public CrashLog {
 			unsigned int line_num = 0;
 			const int ptr_str_size = (2 + sizeof(void*) * 2);
 #if defined(WITH_DL2)
-			if (dladdr_result && info.dli_fname && dl_lm != nullptr) {
+			if (dladdr_result && info.dli_fname && dl_lm != nullptr && addr2line_available &&
+					(addr2line_failed_file == nullptr || strcmp(addr2line_failed_file, info.dli_fname) != 0)) {
 				char *saved_buffer = buffer;
 				char addr_ptr_buffer[64];
 				/* subtract one to get the line before the return address, i.e. the function call line */
@@ -566,6 +572,11 @@ class CrashLogUnix : public CrashLog {
 					*buffer = 0;
 					continue;
 				}
+				if (!result) {
+					addr2line_available = false;
+				} else {
+					addr2line_failed_file = info.dli_fname;
+				}
 				buffer = saved_buffer;
 				*buffer = 0;
 			}
@@ -44,14 +44,16 @@ PathNode *AyStar::ClosedListIsInList(const AyStarNode *node)
  * This adds a node to the closed list.
  * It makes a copy of the data.
  * @param node Node to add to the closed list.
+ * @return The copy of the node in the closed list.
  */
-void AyStar::ClosedListAdd(const PathNode *node)
+PathNode *AyStar::ClosedListAdd(const PathNode *node)
 {
 	/* Add a node to the ClosedList */
 	std::pair<uint32, PathNode *> new_node = this->closedlist_nodes.Allocate();
 	*(new_node.second) = *node;
 
 	this->closedlist_hash[this->HashKey(node->node.tile, node->node.direction)] = new_node.first;
+	return new_node.second;
 }
 
 /**
@@ -104,11 +106,13 @@ void AyStar::OpenListAdd(PathNode *parent, const AyStarNode *node, int f, int g)
 
 /**
  * Checks one tile and calculate its f-value
+ * @param current The neighbouring node to check.
+ * @param parent The node being expanded.
+ * @param closedlist_parent The copy of \a parent in the ClosedList.
  */
-void AyStar::CheckTile(AyStarNode *current, OpenListNode *parent)
+void AyStar::CheckTile(AyStarNode *current, OpenListNode *parent, PathNode *closedlist_parent)
 {
 	int new_f, new_g, new_h;
-	PathNode *closedlist_parent;
 
 	/* Check the new node against the ClosedList */
 	if (this->ClosedListIsInList(current) != nullptr) return;
@@ -132,9 +136,6 @@ void AyStar::CheckTile(AyStarNode *current, OpenListNode *parent)
 	/* The f-value if g + h */
 	new_f = new_g + new_h;
 
-	/* Get the pointer to the parent in the ClosedList (the current one is to a copy of the one in the OpenList) */
-	closedlist_parent = this->ClosedListIsInList(&parent->path.node);
-
 	/* Check if this item is already in the OpenList */
 	uint32 check_idx = this->OpenListIsInList(current);
 	if (check_idx != UINT32_MAX) {
@@ -188,8 +189,8 @@ int AyStar::Loop()
 		return AYSTAR_FOUND_END_NODE;
 	}
 
-	/* Add the node to the ClosedList */
-	this->ClosedListAdd(&current->path);
+	/* Add the node to the ClosedList, the neighbours get this copy as parent rather than the one in the OpenList */
+	PathNode *closedlist_current = this->ClosedListAdd(&current->path);
 
 	/* Load the neighbours */
 	this->GetNeighbours(this, current);
@@ -197,7 +198,7 @@ int AyStar::Loop()
 	/* Go through all neighbours */
 	for (i = 0; i < this->num_neighbours; i++) {
 		/* Check and add them to the OpenList if needed */
-		this->CheckTile(&this->neighbours[i], current);
+		this->CheckTile(&this->neighbours[i], current, closedlist_current);
 	}
 
 	/* Free the node */
@@ -272,6 +273,9 @@ int AyStar::Main()
 	}
 #endif
 	if (r != AYSTAR_STILL_BUSY) {
+		this->last_search_nodes = (uint)this->closedlist_hash.size();
+		this->last_search_aborted = (r == AYSTAR_LIMIT_REACHED);
+
 		/* We're done, clean up */
 		this->Clear();
 	}
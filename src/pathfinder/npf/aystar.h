@@ -151,6 +151,9 @@ struct AyStar {
 	uint max_path_cost;    ///< If the g-value goes over this number, it stops searching, 0 = infinite.
 	uint max_search_nodes; ///< The maximum number of nodes that will be expanded, 0 = infinite.
 
+	uint last_search_nodes = 0;        ///< Number of nodes expanded by the last finished search.
+	bool last_search_aborted = false;  ///< Whether the last finished search was aborted at #max_search_nodes.
+
 	/* These should be filled with the neighbours of a tile by
 	 * GetNeighbours */
 	AyStarNode neighbours[12];
@@ -165,7 +168,7 @@ struct AyStar {
 	int Loop();
 	void Free();
 	void Clear();
-	void CheckTile(AyStarNode *current, OpenListNode *parent);
+	void CheckTile(AyStarNode *current, OpenListNode *parent, PathNode *closedlist_parent);
 
 protected:
 
@@ -183,7 +186,7 @@ protected:
 	uint32 OpenListIsInList(const AyStarNode *node);
 	std::pair<uint32, OpenListNode *> OpenListPop();
 
-	void ClosedListAdd(const PathNode *node);
+	PathNode *ClosedListAdd(const PathNode *node);
 	PathNode *ClosedListIsInList(const AyStarNode *node);
 };
 
@@ -0,0 +1,170 @@
+/*
+ * This file is part of OpenTTD.
+ * OpenTTD is free software; you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 2.
+ * OpenTTD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with OpenTTD. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file pathfinder_stats.cpp Search statistics of the pathfinders. */
+
+#include "../stdafx.h"
+#include "pathfinder_stats.h"
+#include "../vehicle_base.h"
+#include "../date_func.h"
+#include "../console_func.h"
+#include "../console_type.h"
+#include "../strings_func.h"
+#include "../string_func.h"
+#include "../thread.h"
+#include "../debug.h"
+
+#include "table/strings.h"
+
+#include <algorithm>
+#include <unordered_map>
+#include <vector>
+
+#include "../safeguards.h"
+
+/** Names of the pathfinders, indexed by #PathfinderStatsType. */
+static const char * const _pathfinder_stats_names[PFST_END] = {
+	"YAPF rail",
+	"YAPF road",
+	"YAPF ship",
+	"YAPF water regions",
+	"NPF",
+};
+
+static PathfinderStats _pathfinder_stats[PFST_END];                      ///< Statistics per pathfinder, since the start of the window.
+static std::unordered_map<VehicleID, PathfinderStats> _pathfinder_vehicle_stats; ///< Statistics per vehicle, since the start of the window.
+static uint64 _pathfinder_stats_window_start = 0;                        ///< Tick counter at the start of the statistics window.
+static uint64 _pathfinder_slow_search_threshold_us = 0;                  ///< Searches taking at least this long are logged, 0 to disable.
+
+/** Add the result of a single search to \a stats. */
+static void AddSearch(PathfinderStats &stats, uint nodes, uint cache_hits, uint cost_calcs, bool aborted, uint64 time_us)
+{
+	stats.searches++;
+	stats.nodes += nodes;
+	stats.cache_hits += cache_hits;
+	stats.cost_calcs += cost_calcs;
+	if (aborted) stats.aborts++;
+	stats.time_us += time_us;
+}
+
+/**
+ * Record the result of a single pathfinder search.
+ * Only searches on the main thread are recorded.
+ * @param type Pathfinder which did the search.
+ * @param v Vehicle for which the search was done, may be nullptr.
+ * @param nodes Number of nodes expanded.
+ * @param cache_hits Number of node costs which were taken from the segment cost cache.
+ * @param cost_calcs Number of node costs which were calculated.
+ * @param aborted Whether the search was aborted at the maximum number of search nodes.
+ * @param time_us Wall time of the search, in microseconds.
+ */
+void RecordPathfinderSearch(PathfinderStatsType type, const Vehicle *v, uint nodes, uint cache_hits, uint cost_calcs, bool aborted, uint64 time_us)
+{
+	if (!IsMainThread()) return;
+
+	AddSearch(_pathfinder_stats[type], nodes, cache_hits, cost_calcs, aborted, time_us);
+	if (v == nullptr) return;
+
+	v = v->First();
+	AddSearch(_pathfinder_vehicle_stats[v->index], nodes, cache_hits, cost_calcs, aborted, time_us);
+
+	if (_pathfinder_slow_search_threshold_us != 0 && time_us >= _pathfinder_slow_search_threshold_us) {
+		char buffer[256];
+		SetDParam(0, v->index);
+		GetString(buffer, STR_VEHICLE_NAME, lastof(buffer));
+		DEBUG(misc, 0, "Slow %s search: vehicle %u (%s) at tile 0x%X: " OTTD_PRINTF64U " us, %u nodes%s",
+				_pathfinder_stats_names[type], v->index, buffer, v->tile, time_us, nodes, aborted ? ", aborted at node limit" : "");
+	}
+}
+
+/**
+ * Forget the statistics of a vehicle, because it is being deleted.
+ * @param veh Vehicle ID.
+ */
+void ClearPathfinderVehicleStats(VehicleID veh)
+{
+	if (!_pathfinder_vehicle_stats.empty()) _pathfinder_vehicle_stats.erase(veh);
+}
+
+/**
+ * Clear all statistics and start a new statistics window.
+ */
+void ResetPathfinderStats()
+{
+	for (PathfinderStats &stats : _pathfinder_stats) stats = {};
+	_pathfinder_vehicle_stats.clear();
+	_pathfinder_stats_window_start = _tick_counter;
+}
+
+/**
+ * Print the statistics of each pathfinder to the console.
+ */
+void PrintPathfinderStats()
+{
+	IConsolePrintF(CC_DEFAULT, "Pathfinder statistics over the last " OTTD_PRINTF64U " ticks:", _tick_counter - _pathfinder_stats_window_start);
+	for (uint i = 0; i < PFST_END; i++) {
+		const PathfinderStats &stats = _pathfinder_stats[i];
+		if (stats.searches == 0) continue;
+		const uint64 lookups = stats.cache_hits + stats.cost_calcs;
+		IConsolePrintF(CC_DEFAULT, "  %s: " OTTD_PRINTF64U " searches, " OTTD_PRINTF64U " nodes (" OTTD_PRINTF64U " avg), cache hits: %u%%, aborted: " OTTD_PRINTF64U ", time: " OTTD_PRINTF64U " ms (" OTTD_PRINTF64U " us avg)",
+				_pathfinder_stats_names[i], stats.searches, stats.nodes, stats.nodes / stats.searches,
+				lookups > 0 ? (uint)(stats.cache_hits * 100 / lookups) : 0, stats.aborts,
+				stats.time_us / 1000, stats.time_us / stats.searches);
+	}
+}
+
+/**
+ * Print the vehicles with the highest cumulative pathfinding cost in the current statistics window to the console.
+ * @param count Maximum number of vehicles to print.
+ * @param by_time Sort by wall time instead of by the number of expanded nodes.
+ */
+void PrintPathfinderTopVehicles(uint count, bool by_time)
+{
+	std::vector<std::pair<VehicleID, const PathfinderStats *>> entries;
+	entries.reserve(_pathfinder_vehicle_stats.size());
+	for (const auto &it : _pathfinder_vehicle_stats) entries.emplace_back(it.first, &it.second);
+
+	auto cost = [by_time](const PathfinderStats *stats) { return by_time ? stats->time_us : stats->nodes; };
+	count = std::min<uint>(count, (uint)entries.size());
+	std::partial_sort(entries.begin(), entries.begin() + count, entries.end(), [&](const auto &a, const auto &b) {
+		if (cost(a.second) != cost(b.second)) return cost(a.second) > cost(b.second);
+		return a.first < b.first;
+	});
+
+	IConsolePrintF(CC_DEFAULT, "Top %u vehicles by pathfinder %s, over the last " OTTD_PRINTF64U " ticks:", count, by_time ? "time" : "nodes", _tick_counter - _pathfinder_stats_window_start);
+	char buffer[256];
+	for (uint i = 0; i < count; i++) {
+		const Vehicle *v = Vehicle::GetIfValid(entries[i].first);
+		if (v != nullptr) {
+			SetDParam(0, v->index);
+			GetString(buffer, STR_VEHICLE_NAME, lastof(buffer));
+		} else {
+			strecpy(buffer, "(deleted)", lastof(buffer));
+		}
+		const PathfinderStats &stats = *entries[i].second;
+		IConsolePrintF(CC_DEFAULT, "  %2u: vehicle %u (%s): " OTTD_PRINTF64U " searches, " OTTD_PRINTF64U " nodes, aborted: " OTTD_PRINTF64U ", time: " OTTD_PRINTF64U " us",
+				i + 1, entries[i].first, buffer, stats.searches, stats.nodes, stats.aborts, stats.time_us);
+	}
+}
+
+/**
+ * Set the wall time above which searches are logged.
+ * @param threshold_us Threshold in microseconds, 0 to disable logging.
+ */
+void SetPathfinderSlowSearchThreshold(uint64 threshold_us)
+{
+	_pathfinder_slow_search_threshold_us = threshold_us;
+}
+
+/**
+ * Get the wall time above which searches are logged.
+ * @return Threshold in microseconds, 0 if logging is disabled.
+ */
+uint64 GetPathfinderSlowSearchThreshold()
+{
+	return _pathfinder_slow_search_threshold_us;
+}
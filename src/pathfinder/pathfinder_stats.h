@@ -0,0 +1,57 @@
+/*
+ * This file is part of OpenTTD.
+ * OpenTTD is free software; you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 2.
+ * OpenTTD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with OpenTTD. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file pathfinder_stats.h Search statistics of the pathfinders. */
+
+#ifndef PATHFINDER_STATS_H
+#define PATHFINDER_STATS_H
+
+#include "../vehicle_type.h"
+
+#include <chrono>
+
+/** Pathfinders for which search statistics are collected. */
+enum PathfinderStatsType : uint8 {
+	PFST_YAPF_RAIL,         ///< YAPF train pathfinder
+	PFST_YAPF_ROAD,         ///< YAPF road vehicle pathfinder
+	PFST_YAPF_SHIP,         ///< YAPF ship pathfinder
+	PFST_YAPF_SHIP_REGION,  ///< YAPF high level water region pathfinder
+	PFST_NPF,               ///< NPF (AyStar), all vehicle types
+	PFST_END,
+};
+
+/** Accumulated statistics of a number of pathfinder searches. */
+struct PathfinderStats {
+	uint64 searches = 0;   ///< Number of searches.
+	uint64 nodes = 0;      ///< Number of nodes expanded.
+	uint64 cache_hits = 0; ///< Number of node costs which were taken from the segment cost cache.
+	uint64 cost_calcs = 0; ///< Number of node costs which were calculated.
+	uint64 aborts = 0;     ///< Number of searches which were aborted at the maximum number of search nodes.
+	uint64 time_us = 0;    ///< Wall time spent in searches, in microseconds.
+};
+
+void RecordPathfinderSearch(PathfinderStatsType type, const Vehicle *v, uint nodes, uint cache_hits, uint cost_calcs, bool aborted, uint64 time_us);
+void ClearPathfinderVehicleStats(VehicleID veh);
+void ResetPathfinderStats();
+
+void PrintPathfinderStats();
+void PrintPathfinderTopVehicles(uint count, bool by_time);
+void SetPathfinderSlowSearchThreshold(uint64 threshold_us);
+uint64 GetPathfinderSlowSearchThreshold();
+
+/** Measures the wall time of a single pathfinder search. */
+struct PathfinderSearchTimer {
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+	/** @return Time elapsed since construction, in microseconds. */
+	uint64 Elapsed() const
+	{
+		return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - this->start).count();
+	}
+};
+
+#endif /* PATHFINDER_STATS_H */
@@ -0,0 +1,418 @@
+/*
+ * This file is part of OpenTTD.
+ * OpenTTD is free software; you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 2.
+ * OpenTTD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with OpenTTD. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file water_regions.cpp Handles dividing the water in the map into square regions to assist pathfinding. */
+
+#include "../stdafx.h"
+#include "../map_func.h"
+#include "water_regions.h"
+#include "../tilearea_type.h"
+#include "../track_func.h"
+#include "../transport_type.h"
+#include "../landscape.h"
+#include "../tunnelbridge_map.h"
+#include "../string_func.h"
+#include "../ship.h"
+#include "follow_track.hpp"
+
+#include <array>
+#include <memory>
+#include <vector>
+
+#include "../safeguards.h"
+
+using TWaterRegionTraversabilityBits = uint16;
+constexpr TWaterRegionPatchLabel FIRST_REGION_LABEL = 1;
+constexpr TWaterRegionPatchLabel INVALID_WATER_REGION_PATCH = 0;
+
+static_assert(sizeof(TWaterRegionTraversabilityBits) * 8 == WATER_REGION_EDGE_LENGTH);
+
+static inline TrackdirBits GetWaterTrackdirs(TileIndex tile) { return TrackStatusToTrackdirBits(GetTileTrackStatus(tile, TRANSPORT_WATER, 0)); }
+static inline bool IsAqueductTile(TileIndex tile) { return IsBridgeTile(tile) && GetTunnelBridgeTransportType(tile) == TRANSPORT_WATER; }
+
+static inline int GetWaterRegionX(TileIndex tile) { return TileX(tile) / WATER_REGION_EDGE_LENGTH; }
+static inline int GetWaterRegionY(TileIndex tile) { return TileY(tile) / WATER_REGION_EDGE_LENGTH; }
+
+static inline int GetWaterRegionMapSizeX() { return MapSizeX() / WATER_REGION_EDGE_LENGTH; }
+static inline int GetWaterRegionMapSizeY() { return MapSizeY() / WATER_REGION_EDGE_LENGTH; }
+
+static inline TWaterRegionIndex GetWaterRegionIndex(int region_x, int region_y) { return GetWaterRegionMapSizeX() * region_y + region_x; }
+static inline TWaterRegionIndex GetWaterRegionIndex(TileIndex tile) { return GetWaterRegionIndex(GetWaterRegionX(tile), GetWaterRegionY(tile)); }
+
+/**
+ * Represents a square section of the map of a fixed size. Within this square individual unconnected patches of water are
+ * identified using a Connected Component Labeling (CCL) algorithm. Note that all information stored in this class applies
+ * only to tiles within the square section, there is no knowledge about the rest of the map. This makes it easy to invalidate
+ * and update a water region if any changes are made to it, such as construction or terraforming.
+ *
+ * The region contents are derived entirely from the map, and are recalculated lazily on the next query after invalidation.
+ */
+class WaterRegion
+{
+private:
+	std::array<TWaterRegionTraversabilityBits, DIAGDIR_END> edge_traversability_bits{};
+	bool has_cross_region_aqueducts = false;
+	bool initialized = false;
+	uint16 number_of_patches = 0; ///< 0 = no water, 1 = one single patch of water, etc...
+	int region_x = 0;
+	int region_y = 0;
+
+	/** Patch label of each tile in the region, this is only allocated when there is more than one patch. */
+	std::unique_ptr<TWaterRegionPatchLabel[]> tile_patch_labels;
+
+	TileIndex GetTopTile() const { return TileXY(this->region_x * WATER_REGION_EDGE_LENGTH, this->region_y * WATER_REGION_EDGE_LENGTH); }
+
+	bool ContainsTile(TileIndex tile) const
+	{
+		return GetWaterRegionX(tile) == this->region_x && GetWaterRegionY(tile) == this->region_y;
+	}
+
+	static int GetLocalIndex(TileIndex tile)
+	{
+		return (TileX(tile) % WATER_REGION_EDGE_LENGTH) + (TileY(tile) % WATER_REGION_EDGE_LENGTH) * WATER_REGION_EDGE_LENGTH;
+	}
+
+public:
+	void Init(int region_x, int region_y)
+	{
+		this->region_x = region_x;
+		this->region_y = region_y;
+	}
+
+	OrthogonalTileArea GetTileArea() const { return OrthogonalTileArea(this->GetTopTile(), WATER_REGION_EDGE_LENGTH, WATER_REGION_EDGE_LENGTH); }
+
+	/**
+	 * Returns a set of bits indicating whether an edge tile on a particular side is traversable or not. These
+	 * values can be used to determine whether a ship can enter/leave the region through a particular edge tile.
+	 * @see GetLocalIndex() for a description of the coordinate system used.
+	 * @param side Which side of the region we want to know the edge traversability of.
+	 * @returns A value holding the edge traversability bits.
+	 */
+	TWaterRegionTraversabilityBits GetEdgeTraversabilityBits(DiagDirection side) const { return this->edge_traversability_bits[side]; }
+
+	/**
+	 * @returns The amount of individual water patches present within the water region. A value of
+	 * 0 means there is no water present in the water region at all.
+	 */
+	int NumberOfPatches() const { return this->number_of_patches; }
+
+	/**
+	 * @returns Whether the water region contains aqueducts that cross the region boundaries.
+	 */
+	bool HasCrossRegionAqueducts() const { return this->has_cross_region_aqueducts; }
+
+	bool IsInitialized() const { return this->initialized; }
+
+	void Invalidate() { this->initialized = false; }
+
+	/**
+	 * Returns the patch label that was assigned to the tile.
+	 * When the region has only a single patch, that label is returned for all tiles, including those without water.
+	 * @param tile The tile of which we want to retrieve the label.
+	 * @returns The label assigned to the tile.
+	 */
+	TWaterRegionPatchLabel GetLabel(TileIndex tile) const
+	{
+		dbg_assert(this->ContainsTile(tile));
+		if (this->number_of_patches == 0) return INVALID_WATER_REGION_PATCH;
+		if (this->tile_patch_labels == nullptr) return FIRST_REGION_LABEL;
+		return this->tile_patch_labels[GetLocalIndex(tile)];
+	}
+
+	/**
+	 * Performs the connected component labeling and other data gathering.
+	 * @see WaterRegion
+	 */
+	void ForceUpdate()
+	{
+		this->has_cross_region_aqueducts = false;
+		this->edge_traversability_bits.fill(0);
+
+		std::array<TWaterRegionPatchLabel, WATER_REGION_NUMBER_OF_TILES> labels;
+		labels.fill(INVALID_WATER_REGION_PATCH);
+
+		const OrthogonalTileArea tile_area = this->GetTileArea();
+		const TileIndex top_tile = tile_area.tile;
+
+		TWaterRegionPatchLabel current_label = FIRST_REGION_LABEL;
+		uint highest_assigned_label = 0;
+
+		/* Perform connected component labeling. This uses a flooding algorithm that expands until no
+		 * additional tiles can be added. Only tiles inside the water region are considered. */
+		static std::vector<TileIndex> tiles_to_check;
+		for (const TileIndex start_tile : tile_area) {
+			tiles_to_check.clear();
+			tiles_to_check.push_back(start_tile);
+			bool increase_label = false;
+			while (!tiles_to_check.empty()) {
+				const TileIndex tile = tiles_to_check.back();
+				tiles_to_check.pop_back();
+
+				if (labels[GetLocalIndex(tile)] != INVALID_WATER_REGION_PATCH) continue;
+
+				const TrackdirBits valid_dirs = GetWaterTrackdirs(tile);
+				if (valid_dirs == TRACKDIR_BIT_NONE) continue;
+
+				labels[GetLocalIndex(tile)] = current_label;
+				highest_assigned_label = current_label;
+				increase_label = true;
+
+				for (TrackdirBits dirs = valid_dirs; dirs != TRACKDIR_BIT_NONE; dirs = KillFirstBit(dirs)) {
+					const Trackdir dir = (Trackdir)FindFirstBit2x64(dirs);
+
+					/* By using a TrackFollower we "play by the same rules" as the actual ship pathfinder */
+					CFollowTrackWater ft;
+					if (!ft.Follow(tile, dir)) continue;
+
+					if (tile_area.Contains(ft.m_new_tile)) {
+						tiles_to_check.push_back(ft.m_new_tile);
+					} else if (!ft.m_is_bridge) {
+						dbg_assert(DistanceManhattan(ft.m_new_tile, tile) == 1);
+						const DiagDirection side = DiagdirBetweenTiles(tile, ft.m_new_tile);
+						const int local_x_or_y = DiagDirToAxis(side) == AXIS_X ? TileY(tile) - TileY(top_tile) : TileX(tile) - TileX(top_tile);
+						SetBit(this->edge_traversability_bits[side], local_x_or_y);
+					} else {
+						this->has_cross_region_aqueducts = true;
+					}
+				}
+			}
+
+			/* In the degenerate case of more isolated patches than there are labels, the remainder share the last label. */
+			if (increase_label && current_label < UINT8_MAX) current_label++;
+		}
+
+		this->number_of_patches = highest_assigned_label;
+		if (this->number_of_patches > 1) {
+			if (this->tile_patch_labels == nullptr) this->tile_patch_labels.reset(new TWaterRegionPatchLabel[WATER_REGION_NUMBER_OF_TILES]);
+			std::copy(labels.begin(), labels.end(), this->tile_patch_labels.get());
+		} else {
+			this->tile_patch_labels.reset();
+		}
+		this->initialized = true;
+	}
+
+	/**
+	 * Updates the patch labels and other data, but only if the region is not yet initialized.
+	 */
+	inline void UpdateIfNotInitialized()
+	{
+		if (!this->initialized) this->ForceUpdate();
+	}
+
+	/**
+	 * Check whether the contents of this region match another region of the same position.
+	 */
+	bool IsEquivalent(const WaterRegion &other) const
+	{
+		if (this->edge_traversability_bits != other.edge_traversability_bits) return false;
+		if (this->has_cross_region_aqueducts != other.has_cross_region_aqueducts) return false;
+		if (this->number_of_patches != other.number_of_patches) return false;
+		if ((this->tile_patch_labels == nullptr) != (other.tile_patch_labels == nullptr)) return false;
+		if (this->tile_patch_labels != nullptr && !std::equal(this->tile_patch_labels.get(), this->tile_patch_labels.get() + WATER_REGION_NUMBER_OF_TILES, other.tile_patch_labels.get())) return false;
+		return true;
+	}
+};
+
+static std::vector<WaterRegion> _water_regions;
+
+static TileIndex GetEdgeTileCoordinate(int region_x, int region_y, DiagDirection side, int x_or_y)
+{
+	dbg_assert(x_or_y >= 0 && x_or_y < WATER_REGION_EDGE_LENGTH);
+	const int top_x = region_x * WATER_REGION_EDGE_LENGTH;
+	const int top_y = region_y * WATER_REGION_EDGE_LENGTH;
+	switch (side) {
+		case DIAGDIR_NE: return TileXY(top_x, top_y + x_or_y);
+		case DIAGDIR_SW: return TileXY(top_x + WATER_REGION_EDGE_LENGTH - 1, top_y + x_or_y);
+		case DIAGDIR_NW: return TileXY(top_x + x_or_y, top_y);
+		case DIAGDIR_SE: return TileXY(top_x + x_or_y, top_y + WATER_REGION_EDGE_LENGTH - 1);
+		default: NOT_REACHED();
+	}
+}
+
+static WaterRegion &GetUpdatedWaterRegion(int region_x, int region_y)
+{
+	WaterRegion &result = _water_regions[GetWaterRegionIndex(region_x, region_y)];
+	result.UpdateIfNotInitialized();
+	return result;
+}
+
+static WaterRegion &GetUpdatedWaterRegion(TileIndex tile)
+{
+	return GetUpdatedWaterRegion(GetWaterRegionX(tile), GetWaterRegionY(tile));
+}
+
+/**
+ * Returns the index of the water region patch, this is unique over the whole map.
+ * @param water_region_patch The water region patch to hash.
+ * @returns The hash of the patch.
+ */
+int CalculateWaterRegionPatchHash(const WaterRegionPatchDesc &water_region_patch)
+{
+	return water_region_patch.label | GetWaterRegionIndex(water_region_patch.x, water_region_patch.y) << 8;
+}
+
+/**
+ * Returns the center tile of a particular water region.
+ * @param water_region The water region to find the center tile for.
+ * @returns The center tile of the water region.
+ */
+TileIndex GetWaterRegionCenterTile(const WaterRegionDesc &water_region)
+{
+	return TileXY(water_region.x * WATER_REGION_EDGE_LENGTH + (WATER_REGION_EDGE_LENGTH / 2), water_region.y * WATER_REGION_EDGE_LENGTH + (WATER_REGION_EDGE_LENGTH / 2));
+}
+
+/**
+ * Returns basic water region information for the provided tile.
+ * @param tile The tile for which the information will be calculated.
+ */
+WaterRegionDesc GetWaterRegionInfo(TileIndex tile)
+{
+	return WaterRegionDesc{ GetWaterRegionX(tile), GetWaterRegionY(tile) };
+}
+
+/**
+ * Returns basic water region patch information for the provided tile.
+ * @param tile The tile for which the information will be calculated.
+ */
+WaterRegionPatchDesc GetWaterRegionPatchInfo(TileIndex tile)
+{
+	WaterRegion &region = GetUpdatedWaterRegion(tile);
+	return WaterRegionPatchDesc{ GetWaterRegionX(tile), GetWaterRegionY(tile), region.GetLabel(tile)};
+}
+
+/**
+ * Marks the water region that tile is part of as invalid.
+ * This must be called whenever a change to the tile could change which water track directions it has.
+ * @param tile Tile within the water region that we wish to invalidate.
+ */
+void InvalidateWaterRegion(TileIndex tile)
+{
+	if (tile >= MapSize() || _water_regions.empty()) return;
+
+	_water_regions[GetWaterRegionIndex(tile)].Invalidate();
+
+	/* When updating the water region we look into the first tile of adjacent water regions to determine edge
+	 * traversability. This means that if we invalidate any region edge tiles we might also change the traversability
+	 * of the adjacent region. This code ensures the adjacent regions also get invalidated in such a case. */
+	for (DiagDirection side = DIAGDIR_BEGIN; side < DIAGDIR_END; side++) {
+		const TileIndex adjacent_tile = AddTileIndexDiffCWrap(tile, TileIndexDiffCByDiagDir(side));
+		if (adjacent_tile == INVALID_TILE) continue;
+		if (GetWaterRegionIndex(adjacent_tile) != GetWaterRegionIndex(tile)) _water_regions[GetWaterRegionIndex(adjacent_tile)].Invalidate();
+	}
+}
+
+/**
+ * Calls the provided callback function for all water region patches
+ * accessible from one particular side of the starting patch.
+ * @param water_region_patch Water patch within the water region to start searching from
+ * @param side Side of the water region to look for neigboring patches of water
+ * @param callback The function that will be called for each neighbor that is found
+ */
+static inline void VisitAdjacentWaterRegionPatchNeighbors(const WaterRegionPatchDesc &water_region_patch, DiagDirection side, TVisitWaterRegionPatchCallBack &func)
+{
+	const WaterRegion &current_region = GetUpdatedWaterRegion(water_region_patch.x, water_region_patch.y);
+
+	const TileIndexDiffC offset = TileIndexDiffCByDiagDir(side);
+	const int nx = water_region_patch.x + offset.x;
+	const int ny = water_region_patch.y + offset.y;
+
+	if (nx < 0 || ny < 0 || nx >= GetWaterRegionMapSizeX() || ny >= GetWaterRegionMapSizeY()) return;
+
+	const WaterRegion &neighboring_region = GetUpdatedWaterRegion(nx, ny);
+	const DiagDirection opposite_side = ReverseDiagDir(side);
+
+	/* Indicates via which local x or y coordinates (depending on the "side" parameter) we can cross over into the adjacent region. */
+	const TWaterRegionTraversabilityBits traversability_bits = current_region.GetEdgeTraversabilityBits(side)
+			& neighboring_region.GetEdgeTraversabilityBits(opposite_side);
+	if (traversability_bits == 0) return;
+
+	if (current_region.NumberOfPatches() == 1 && neighboring_region.NumberOfPatches() == 1) {
+		func(WaterRegionPatchDesc{ nx, ny, FIRST_REGION_LABEL }); // No further checks needed because we know there is just one patch for both adjacent regions
+		return;
+	}
+
+	/* Multiple water patches can be reached from the current patch. Check each edge tile individually. */
+	static std::vector<TWaterRegionPatchLabel> unique_labels; // static and vector-instead-of-map for performance reasons
+	unique_labels.clear();
+	for (int x_or_y = 0; x_or_y < WATER_REGION_EDGE_LENGTH; ++x_or_y) {
+		if (!HasBit(traversability_bits, x_or_y)) continue;
+
+		const TileIndex current_edge_tile = GetEdgeTileCoordinate(water_region_patch.x, water_region_patch.y, side, x_or_y);
+		const TWaterRegionPatchLabel current_label = current_region.GetLabel(current_edge_tile);
+		if (current_label != water_region_patch.label) continue;
+
+		const TileIndex neighbor_edge_tile = GetEdgeTileCoordinate(nx, ny, opposite_side, x_or_y);
+		const TWaterRegionPatchLabel neighbor_label = neighboring_region.GetLabel(neighbor_edge_tile);
+		if (std::find(unique_labels.begin(), unique_labels.end(), neighbor_label) == unique_labels.end()) unique_labels.push_back(neighbor_label);
+	}
+	for (TWaterRegionPatchLabel unique_label : unique_labels) func(WaterRegionPatchDesc{ nx, ny, unique_label });
+}
+
+/**
+ * Calls the provided callback function on all accessible water region patches in
+ * each cardinal direction, plus any others that are reachable via aqueducts.
+ * @param water_region_patch Water patch within the water region to start searching from
+ * @param callback The function that will be called for each accessible water patch that is found
+ */
+void VisitWaterRegionPatchNeighbors(const WaterRegionPatchDesc &water_region_patch, TVisitWaterRegionPatchCallBack &callback)
+{
+	const WaterRegion &current_region = GetUpdatedWaterRegion(water_region_patch.x, water_region_patch.y);
+
+	/* Visit adjacent water region patches in each cardinal direction */
+	for (DiagDirection side = DIAGDIR_BEGIN; side < DIAGDIR_END; side++) VisitAdjacentWaterRegionPatchNeighbors(water_region_patch, side, callback);
+
+	/* Visit neigboring water patches accessible via cross-region aqueducts */
+	if (current_region.HasCrossRegionAqueducts()) {
+		for (const TileIndex tile : current_region.GetTileArea()) {
+			if (GetWaterRegionPatchInfo(tile) == water_region_patch && IsAqueductTile(tile)) {
+				const TileIndex other_end_tile = GetOtherBridgeEnd(tile);
+				if (GetWaterRegionIndex(tile) != GetWaterRegionIndex(other_end_tile)) callback(GetWaterRegionPatchInfo(other_end_tile));
+			}
+		}
+	}
+}
+
+/**
+ * Allocate the water regions for the current map size, all regions are initially invalid.
+ * This must be called whenever the map is reallocated or loaded.
+ */
+void AllocateWaterRegions()
+{
+	_water_regions.clear();
+	_water_regions.resize(GetWaterRegionMapSizeX() * GetWaterRegionMapSizeY());
+
+	for (int region_y = 0; region_y < GetWaterRegionMapSizeY(); region_y++) {
+		for (int region_x = 0; region_x < GetWaterRegionMapSizeX(); region_x++) {
+			_water_regions[GetWaterRegionIndex(region_x, region_y)].Init(region_x, region_y);
+		}
+	}
+}
+
+/**
+ * Check that all initialised water regions match the current state of the map.
+ * A mismatch would mean that a map change is missing a call to #InvalidateWaterRegion.
+ * @return Empty string on success, otherwise a description of the first mismatching region.
+ */
+std::string ValidateWaterRegions()
+{
+	if (_water_regions.size() != (size_t)(GetWaterRegionMapSizeX() * GetWaterRegionMapSizeY())) return "Water region count mismatch";
+
+	for (int region_y = 0; region_y < GetWaterRegionMapSizeY(); region_y++) {
+		for (int region_x = 0; region_x < GetWaterRegionMapSizeX(); region_x++) {
+			const WaterRegion &region = _water_regions[GetWaterRegionIndex(region_x, region_y)];
+			if (!region.IsInitialized()) continue;
+
+			WaterRegion check;
+			check.Init(region_x, region_y);
+			check.ForceUpdate();
+			if (!region.IsEquivalent(check)) {
+				return stdstr_fmt("Water region mismatch at region %d x %d (top tile: 0x%X)", region_x, region_y, TileXY(region_x * WATER_REGION_EDGE_LENGTH, region_y * WATER_REGION_EDGE_LENGTH));
+			}
+		}
+	}
+	return {};
+}
@@ -10,42 +10,131 @@
 #ifndef NODELIST_HPP
 #define NODELIST_HPP
 
-#include "../../misc/array.hpp"
 #include "../../misc/hashtable.hpp"
 #include "../../misc/binaryheap.hpp"
+#include "../../core/arena_alloc.hpp"
+
+#include <memory>
+#include <vector>
+
+/** Statistics about the node list storage of the current thread. */
+struct YapfNodeListStats {
+	uint64 searches = 0;     ///< Number of node lists which have been released.
+	uint64 total_nodes = 0;  ///< Total number of nodes allocated, over all released node lists.
+	uint   peak_nodes = 0;   ///< Highest number of nodes allocated by a single node list.
+	uint   last_nodes = 0;   ///< Number of nodes allocated by the most recently released node list.
+	uint64 reuses = 0;       ///< Number of node lists which re-used pooled storage.
+	size_t pooled_bytes = 0; ///< Node memory currently retained by pooled storage.
+};
+
+extern thread_local YapfNodeListStats _yapf_node_list_stats;
 
 /**
  * Hash table based node list multi-container class.
  *  Implements open list, closed list and priority queue for A-star
  *  path finder.
+ *  The storage is taken from a per-thread pool and returned to it when the
+ *  node list is destroyed, such that the node arena, hash tables and priority
+ *  queue are reset and re-used by the next search instead of being re-allocated.
  */
 template <class Titem_, int Thash_bits_open_, int Thash_bits_closed_>
 class CNodeList_HashTableT {
 public:
 	typedef Titem_ Titem;                                        ///< Make #Titem_ visible from outside of class.
 	typedef typename Titem_::Key Key;                            ///< Make Titem_::Key a property of this class.
-	typedef SmallArray<Titem_, 65536, 256> CItemArray;           ///< Type that we will use as item container.
+	typedef UniformArenaAllocator<sizeof(Titem_), 4096> CArena;  ///< Type that we will use to allocate item data.
 	typedef CHashTableT<Titem_, Thash_bits_open_  > COpenList;   ///< How pointers to open nodes will be stored.
 	typedef CHashTableT<Titem_, Thash_bits_closed_> CClosedList; ///< How pointers to closed nodes will be stored.
 	typedef CBinaryHeapT<Titem_> CPriorityQueue;                 ///< How the priority queue will be managed.
 
 protected:
-	CItemArray      m_arr;        ///< Here we store full item data (Titem_).
-	COpenList       m_open;       ///< Hash table of pointers to open item data.
-	CClosedList     m_closed;     ///< Hash table of pointers to closed item data.
-	CPriorityQueue  m_open_queue; ///< Priority queue of pointers to open item data.
-	Titem          *m_new_node;   ///< New open node under construction.
+	/** Maximum number of unused storage instances kept per node list type and thread. */
+	static const size_t MAX_POOLED_STORAGE = 4;
+
+	/** Storage with more node memory than this is freed instead of being pooled. */
+	static const size_t MAX_POOLED_BYTES = 64 << 20;
+
+	/** Node list storage, which is pooled. */
+	struct Storage {
+		CArena                 arena;      ///< Item data.
+		std::vector<Titem_ *>  items;      ///< All items allocated from the arena, in allocation order.
+		COpenList              open;       ///< Hash table of pointers to open item data.
+		CClosedList            closed;     ///< Hash table of pointers to closed item data.
+		CPriorityQueue         open_queue; ///< Priority queue of pointers to open item data.
+
+		Storage() : open_queue(2048) {}
+
+		/** Destroy all items and empty all containers, while keeping their memory. */
+		void Reset()
+		{
+			for (Titem_ *item : this->items) item->~Titem_();
+			this->items.clear();
+			this->arena.ClearArena();
+			this->open.Clear();
+			this->closed.Clear();
+			this->open_queue.Clear();
+		}
+	};
+
+	static std::vector<std::unique_ptr<Storage>> &GetStoragePool()
+	{
+		static thread_local std::vector<std::unique_ptr<Storage>> pool;
+		return pool;
+	}
+
+	static std::unique_ptr<Storage> AcquireStorage()
+	{
+		std::vector<std::unique_ptr<Storage>> &pool = GetStoragePool();
+		if (pool.empty()) return std::make_unique<Storage>();
+
+		std::unique_ptr<Storage> storage = std::move(pool.back());
+		pool.pop_back();
+		_yapf_node_list_stats.reuses++;
+		_yapf_node_list_stats.pooled_bytes -= storage->arena.GetReservedBytes();
+		return storage;
+	}
+
+	static void ReleaseStorage(std::unique_ptr<Storage> storage)
+	{
+		YapfNodeListStats &stats = _yapf_node_list_stats;
+		const uint nodes = (uint)storage->items.size();
+		stats.searches++;
+		stats.total_nodes += nodes;
+		stats.last_nodes = nodes;
+		stats.peak_nodes = std::max(stats.peak_nodes, nodes);
+
+		storage->Reset();
+
+		std::vector<std::unique_ptr<Storage>> &pool = GetStoragePool();
+		if (pool.size() >= MAX_POOLED_STORAGE || storage->arena.GetReservedBytes() > MAX_POOLED_BYTES) return;
+
+		stats.pooled_bytes += storage->arena.GetReservedBytes();
+		pool.push_back(std::move(storage));
+	}
+
+	std::unique_ptr<Storage> m_storage;
+	CArena                &m_arena;      ///< Here we store full item data (Titem_).
+	std::vector<Titem_ *> &m_items;      ///< Pointers to all item data.
+	COpenList             &m_open;       ///< Hash table of pointers to open item data.
+	CClosedList           &m_closed;     ///< Hash table of pointers to closed item data.
+	CPriorityQueue        &m_open_queue; ///< Priority queue of pointers to open item data.
+	Titem                 *m_new_node;   ///< New open node under construction.
 
 public:
 	/** default constructor */
-	CNodeList_HashTableT() : m_open_queue(2048)
+	CNodeList_HashTableT() : m_storage(AcquireStorage()), m_arena(m_storage->arena), m_items(m_storage->items),
+			m_open(m_storage->open), m_closed(m_storage->closed), m_open_queue(m_storage->open_queue)
 	{
 		m_new_node = nullptr;
 	}
 
+	CNodeList_HashTableT(const CNodeList_HashTableT &) = delete;
+	CNodeList_HashTableT &operator=(const CNodeList_HashTableT &) = delete;
+
 	/** destructor */
 	~CNodeList_HashTableT()
 	{
+		ReleaseStorage(std::move(m_storage));
 	}
 
 	/** return number of open nodes */
@@ -60,10 +149,13 @@ public:
 		return m_closed.Count();
 	}
 
-	/** allocate new data item from m_arr */
+	/** allocate new data item from m_arena */
 	inline Titem_ *CreateNewNode()
 	{
-		if (m_new_node == nullptr) m_new_node = m_arr.AppendC();
+		if (m_new_node == nullptr) {
+			m_new_node = new (m_arena.Allocate()) Titem_();
+			m_items.push_back(m_new_node);
+		}
 		return m_new_node;
 	}
 
@@ -157,19 +249,25 @@ public:
 	/** The number of items. */
 	inline int TotalCount()
 	{
-		return m_arr.Length();
+		return (int)m_items.size();
 	}
 
 	/** Get a particular item. */
 	inline Titem_& ItemAt(int idx)
 	{
-		return m_arr[idx];
+		return *m_items[idx];
 	}
 
 	/** Helper for creating output of this array. */
 	template <class D> void Dump(D &dmp) const
 	{
-		dmp.WriteStructT("m_arr", &m_arr);
+		uint num_items = (uint)m_items.size();
+		dmp.WriteValue("num_items", num_items);
+		for (uint i = 0; i < num_items; i++) {
+			char name[32];
+			seprintf(name, lastof(name), "item[%d]", i);
+			dmp.WriteStructT(name, m_items[i]);
+		}
 	}
 };
 
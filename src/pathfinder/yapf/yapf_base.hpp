@@ -12,6 +12,7 @@
 
 #include "../../debug.h"
 #include "../../settings_type.h"
+#include "../pathfinder_stats.h"
 
 /**
  * CYapfBaseT - A-star type path finder base class.
@@ -97,6 +98,17 @@ public:
 		return _settings_game.pf.yapf;
 	}
 
+	/** Map the debug report character of a pathfinder to its search statistics type. */
+	static constexpr PathfinderStatsType GetPathfinderStatsType(char ttc)
+	{
+		switch (ttc) {
+			case 't': return PFST_YAPF_RAIL;
+			case 'r': return PFST_YAPF_ROAD;
+			case '^': return PFST_YAPF_SHIP_REGION;
+			default:  return PFST_YAPF_SHIP;
+		}
+	}
+
 	/**
 	 * Main pathfinder routine:
 	 *   - set startup node(s)
@@ -110,8 +122,10 @@ public:
 	{
 		m_veh = v;
 
+		PathfinderSearchTimer timer;
 		Yapf().PfSetStartupNodes();
 		bool bDestFound = true;
+		bool aborted = false;
 
 		for (;;) {
 			m_num_steps++;
@@ -133,12 +147,15 @@ public:
 			} else {
 				m_nodes.ReenqueueOpenNode(*n);
 				bDestFound = false;
+				aborted = true;
 				break;
 			}
 		}
 
 		bDestFound &= (m_pBestDestNode != nullptr);
 
+		RecordPathfinderSearch(GetPathfinderStatsType(Yapf().TransportTypeChar()), m_veh, m_nodes.ClosedCount(), m_stats_cache_hits, m_stats_cost_calcs, aborted, timer.Elapsed());
+
 		if (_debug_yapf_level >= 3) {
 			UnitID veh_idx = (m_veh != nullptr) ? m_veh->unitnumber : 0;
 			char ttc = Yapf().TransportTypeChar();
@@ -225,6 +242,16 @@ public:
 		if (intermediate_on_branch) Yapf().m_pBestIntermediateNode = n;
 	}
 
+	/**
+	 * Count a node cost which the cost provider took from a segment cost cache of its own
+	 * as a cache hit instead of as a cost calculation.
+	 */
+	inline void PfCountSegmentCacheHit()
+	{
+		m_stats_cost_calcs--;
+		m_stats_cache_hits++;
+	}
+
 	/**
 	 * AddNewNode() - called by Tderived::PfFollowNode() for each child node.
 	 *  Nodes are evaluated here and added into open list
@@ -19,4 +19,9 @@
  */
 void YapfNotifyTrackLayoutChange(TileIndex tile, Track track);
 
+/**
+ * Use this function to notify YAPF that the road layout (road pieces, road stops, one-way state, road types, etc.) has changed.
+ */
+void YapfNotifyRoadLayoutChange();
+
 #endif /* YAPF_CACHE_H */
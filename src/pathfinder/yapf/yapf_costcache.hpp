@@ -95,16 +95,23 @@ public:
  *  of track layout changes and static notification function called whenever
  *  the track layout changes. It is implemented as base class because it needs
  *  to be shared between all rail YAPF types (one shared counter, one notification
- *  function.
+ *  function. Road YAPF has its own counter, as road layout changes should
+ *  not flush the rail cache and vice versa.
  */
 struct CSegmentCostCacheBase
 {
 	static int   s_rail_change_counter;
+	static int   s_road_change_counter;
 
 	static void NotifyTrackLayoutChange(TileIndex, Track)
 	{
 		s_rail_change_counter++;
 	}
+
+	static void NotifyRoadLayoutChange()
+	{
+		s_road_change_counter++;
+	}
 };
 
 
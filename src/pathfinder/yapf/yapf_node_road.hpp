@@ -10,6 +10,120 @@
 #ifndef YAPF_NODE_ROAD_HPP
 #define YAPF_NODE_ROAD_HPP
 
+/**
+ * Key of a cached road segment.
+ * As the road track follower depends on the road type and owner of the vehicle, these are part of the key.
+ */
+struct CYapfRoadSegmentKey
+{
+	TileIndex m_tile;
+	uint32    m_value; ///< trackdir, road type and owner
+
+	inline CYapfRoadSegmentKey(TileIndex tile, Trackdir td, RoadType rt, Owner owner)
+	{
+		m_tile = tile;
+		m_value = td | (rt << 4) | (owner << 10);
+	}
+
+	inline int32 CalcHash() const
+	{
+		return (m_tile << 4) ^ m_value;
+	}
+
+	inline TileIndex GetTile() const
+	{
+		return m_tile;
+	}
+
+	inline Trackdir GetTrackdir() const
+	{
+		return (Trackdir)(m_value & 0x0F);
+	}
+
+	inline bool operator==(const CYapfRoadSegmentKey &other) const
+	{
+		return m_tile == other.m_tile && m_value == other.m_value;
+	}
+};
+
+/**
+ * Cached road segment.
+ * Only the parts of the segment cost which do not depend on the vehicle, pathfinder settings or
+ * dynamic state (road stop occupancy) are stored, the cost itself is assembled from these by the pathfinder.
+ */
+struct CYapfRoadSegment
+{
+	typedef CYapfRoadSegmentKey Key;
+
+	/** Run of consecutive tiles with the same speed limit */
+	struct SpeedLimitRun {
+		int    max_speed;     ///< speed limit of the tiles
+		uint16 tiles_skipped; ///< tunnel/bridge tiles skipped when leaving each tile
+		uint16 count;         ///< number of tiles in the run
+	};
+
+	enum State : uint8 {
+		RSS_INVALID,    ///< segment is not yet filled in
+		RSS_VALID,      ///< segment is cached
+		RSS_DEAD_END,   ///< segment is a loop without junctions, the node is not valid
+		RSS_UNCACHABLE, ///< segment contains tiles with dynamic costs (road stops), or starts in a depot
+	};
+
+	Key        m_key;
+	TileIndex  m_last_tile;
+	Trackdir   m_last_td;
+	State      m_state;
+	uint       m_diagonal_tiles;
+	uint       m_curve_tiles;
+	uint       m_crossings;
+	uint       m_slopes_up;
+	uint       m_tiles_skipped;
+	std::vector<SpeedLimitRun> m_speed_limits;
+	CYapfRoadSegment *m_hash_next;
+
+	inline CYapfRoadSegment(const CYapfRoadSegmentKey &key)
+		: m_key(key)
+		, m_last_tile(INVALID_TILE)
+		, m_last_td(INVALID_TRACKDIR)
+		, m_state(RSS_INVALID)
+		, m_diagonal_tiles(0)
+		, m_curve_tiles(0)
+		, m_crossings(0)
+		, m_slopes_up(0)
+		, m_tiles_skipped(0)
+		, m_hash_next(nullptr)
+	{}
+
+	inline const Key& GetKey() const
+	{
+		return m_key;
+	}
+
+	inline TileIndex GetTile() const
+	{
+		return m_key.GetTile();
+	}
+
+	inline CYapfRoadSegment *GetHashNext()
+	{
+		return m_hash_next;
+	}
+
+	inline void SetHashNext(CYapfRoadSegment *next)
+	{
+		m_hash_next = next;
+	}
+
+	void AddSpeedLimit(int max_speed, uint16 tiles_skipped)
+	{
+		if (!m_speed_limits.empty() && m_speed_limits.back().max_speed == max_speed && m_speed_limits.back().tiles_skipped == tiles_skipped && m_speed_limits.back().count < UINT16_MAX) {
+			m_speed_limits.back().count++;
+		} else {
+			m_speed_limits.push_back({ max_speed, tiles_skipped, 1 });
+		}
+	}
+};
+
 /** Yapf Node for road YAPF */
 template <class Tkey_>
 struct CYapfRoadNodeT : CYapfNodeT<Tkey_, CYapfRoadNodeT<Tkey_> > {
@@ -17,6 +17,7 @@
 #include "../../viewport_func.h"
 #include "../../newgrf_station.h"
 #include "../../tracerestrict.h"
+#include "../../signal_func.h"
 #include "../../debug.h"
 
 #include "../../safeguards.h"
@@ -784,9 +785,13 @@ bool YapfTrainFindNearestSafeTile(const Train *v, TileIndex tile, Trackdir td, b
 /** if any track changes, this counter is incremented - that will invalidate segment cost cache */
 int CSegmentCostCacheBase::s_rail_change_counter = 0;
 
+/** Statistics of the YAPF node list storage of each thread. */
+thread_local YapfNodeListStats _yapf_node_list_stats;
+
 void YapfNotifyTrackLayoutChange(TileIndex tile, Track track)
 {
 	CSegmentCostCacheBase::NotifyTrackLayoutChange(tile, track);
+	InvalidateSignalSegmentCache();
 }
 
 void YapfCheckRailSignalPenalties()
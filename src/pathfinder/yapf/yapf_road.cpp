@@ -12,6 +12,12 @@
 #include "yapf_node_road.hpp"
 #include "../../roadstop_base.h"
 #include "../../vehicle_func.h"
+#include "../../date_func.h"
+
+#include <map>
+#include <memory>
+#include <queue>
+#include <unordered_map>
 
 #include "../../safeguards.h"
 
@@ -26,6 +32,31 @@ const uint MAX_RV_PF_TILES = 1 << 11;
 
 const int MAX_RV_LEADER_TARGETS = 4;
 
+int CSegmentCostCacheBase::s_road_change_counter = 0;
+
+void YapfNotifyRoadLayoutChange()
+{
+	CSegmentCostCacheBase::NotifyRoadLayoutChange();
+}
+
+typedef CSegmentCostCacheT<CYapfRoadSegment> CRoadSegmentCostCache;
+
+/**
+ * Get the global road segment cost cache, this is shared between all road YAPF types.
+ * The cache is flushed whenever the road layout has changed.
+ */
+static CRoadSegmentCostCache &GetGlobalRoadSegmentCostCache()
+{
+	static int last_road_change_counter = 0;
+	static CRoadSegmentCostCache cache;
+
+	if (last_road_change_counter != CSegmentCostCacheBase::s_road_change_counter) {
+		last_road_change_counter = CSegmentCostCacheBase::s_road_change_counter;
+		cache.Flush();
+	}
+	return cache;
+}
+
 template <class Types>
 class CYapfCostRoadT
 {
@@ -37,8 +68,9 @@ public:
 
 protected:
 	int m_max_cost;
+	bool m_disable_cache;
 
-	CYapfCostRoadT() : m_max_cost(0) {};
+	CYapfCostRoadT() : m_max_cost(0), m_disable_cache(false) {};
 
 	/** to access inherited path finder */
 	Tpf& Yapf()
@@ -134,12 +166,87 @@ protected:
 		return cost;
 	}
 
+	/**
+	 * Walk the segment starting at the segment key and fill in the vehicle-independent parts of its cost.
+	 * This must follow the same steps as the uncached walk in PfCalcCost.
+	 */
+	void FillSegment(CYapfRoadSegment &segment)
+	{
+		TileIndex tile = segment.m_key.GetTile();
+		Trackdir trackdir = segment.m_key.GetTrackdir();
+
+		if (IsRoadDepotTile(tile)) {
+			segment.m_state = CYapfRoadSegment::RSS_UNCACHABLE;
+			return;
+		}
+
+		uint tiles = 0;
+		for (;;) {
+			if (IsDiagonalTrackdir(trackdir)) {
+				if (IsTileType(tile, MP_STATION)) {
+					/* Road stop costs depend on occupancy, and road stops may be the destination */
+					segment.m_state = CYapfRoadSegment::RSS_UNCACHABLE;
+					return;
+				}
+				segment.m_diagonal_tiles++;
+				if (IsLevelCrossingTile(tile)) segment.m_crossings++;
+			} else {
+				segment.m_curve_tiles++;
+			}
+
+			/* stop if we have just entered the depot */
+			if (IsRoadDepotTile(tile) && trackdir == DiagDirToDiagTrackdir(ReverseDiagDir(GetRoadDepotDirection(tile)))) break;
+
+			TrackFollower F(Yapf().GetVehicle());
+			if (!F.Follow(tile, trackdir)) break;
+
+			segment.m_tiles_skipped += F.m_tiles_skipped;
+			tiles += F.m_tiles_skipped + 1;
+
+			if (KillFirstBit(F.m_new_td_bits) != TRACKDIR_BIT_NONE) break;
+
+			Trackdir new_td = (Trackdir)FindFirstBit2x64(F.m_new_td_bits);
+
+			if (F.m_new_tile == segment.m_key.GetTile() && new_td == segment.m_key.GetTrackdir()) {
+				segment.m_state = CYapfRoadSegment::RSS_DEAD_END;
+				return;
+			}
+
+			if (Yapf().SlopeCost(tile, F.m_new_tile, trackdir) != 0) segment.m_slopes_up++;
+
+			int max_speed = F.GetSpeedLimit();
+			if (max_speed != INT_MAX) segment.AddSpeedLimit(max_speed, F.m_tiles_skipped);
+
+			tile = F.m_new_tile;
+			trackdir = new_td;
+			if (tiles > MAX_RV_PF_TILES) break;
+		}
+
+		segment.m_last_tile = tile;
+		segment.m_last_td = trackdir;
+		segment.m_state = CYapfRoadSegment::RSS_VALID;
+	}
+
+	/**
+	 * Whether the global segment cost cache can be used for the given node.
+	 * Leader targets and the maximum cost both need to be checked on each tile, so the walk can't be skipped.
+	 */
+	inline bool CanUseGlobalCache(const Node &)
+	{
+		return !m_disable_cache && m_max_cost == 0 && Yapf().leader_targets[0] == INVALID_TILE && Yapf().CanUseGlobalSegmentCache();
+	}
+
 public:
 	inline void SetMaxCost(int max_cost)
 	{
 		m_max_cost = max_cost;
 	}
 
+	void DisableCache(bool disable)
+	{
+		m_disable_cache = disable;
+	}
+
 	/**
 	 * Called by YAPF to calculate the cost from the origin to the given node.
 	 *  Calculates only the cost of given node, adds it to the parent node cost
@@ -157,6 +264,34 @@ public:
 		Trackdir trackdir = n.m_key.m_td;
 		int parent_cost = (n.m_parent != nullptr) ? n.m_parent->m_cost : 0;
 
+		if (CanUseGlobalCache(n)) {
+			const RoadVehicle *v = Yapf().GetVehicle();
+			CYapfRoadSegmentKey key(tile, trackdir, v->roadtype, v->owner);
+			bool found;
+			CYapfRoadSegment &segment = GetGlobalRoadSegmentCostCache().Get(key, &found);
+			if (!found) FillSegment(segment);
+
+			if (segment.m_state == CYapfRoadSegment::RSS_DEAD_END) return false;
+			if (segment.m_state == CYapfRoadSegment::RSS_VALID) {
+				if (found) Yapf().PfCountSegmentCacheHit();
+				const YAPFSettings &settings = Yapf().PfGetSettings();
+				segment_cost += (segment.m_diagonal_tiles + segment.m_tiles_skipped) * YAPF_TILE_LENGTH;
+				segment_cost += segment.m_curve_tiles * (YAPF_TILE_CORNER_LENGTH + settings.road_curve_penalty);
+				segment_cost += segment.m_crossings * settings.road_crossing_penalty;
+				segment_cost += segment.m_slopes_up * settings.road_slope_penalty;
+
+				int max_veh_speed = std::min<int>(v->GetDisplayMaxSpeed(), v->current_order.GetMaxSpeed() * 2);
+				for (const CYapfRoadSegment::SpeedLimitRun &run : segment.m_speed_limits) {
+					if (run.max_speed < max_veh_speed) segment_cost += run.count * (YAPF_TILE_LENGTH * (max_veh_speed - run.max_speed) * (4 + run.tiles_skipped) / max_veh_speed);
+				}
+
+				n.m_segment_last_tile = segment.m_last_tile;
+				n.m_segment_last_td = segment.m_last_td;
+				n.m_cost = parent_cost + segment_cost;
+				return true;
+			}
+		}
+
 		for (;;) {
 			/* base tile cost depending on distance between edges */
 			segment_cost += Yapf().OneTileCost(tile, trackdir, tf);
@@ -247,6 +382,12 @@ public:
 		return IsRoadDepotTile(tile);
 	}
 
+	/** Depots can only be at the end of cached segments, so the destination can't be skipped */
+	inline bool CanUseGlobalSegmentCache() const
+	{
+		return true;
+	}
+
 	/**
 	 * Called by YAPF to calculate cost estimate. Calculates distance to the destination
 	 *  adds it to the actual cost from origin and stores the sum to the Node::m_estimate
@@ -306,6 +447,15 @@ public:
 		return m_dest_station != INVALID_STATION ? Station::GetIfValid(m_dest_station) : nullptr;
 	}
 
+	/**
+	 * Cached segments don't contain station tiles and depots can only be at the end of cached segments,
+	 * other destination tiles could be in the middle of a cached segment.
+	 */
+	inline bool CanUseGlobalSegmentCache() const
+	{
+		return m_dest_station != INVALID_STATION || IsRoadDepotTile(m_destTile);
+	}
+
 protected:
 	/** to access inherited path finder */
 	Tpf& Yapf()
@@ -364,6 +514,202 @@ public:
 	}
 };
 
+/**
+ * Distance field over the road network towards the road stops of one station, for one type of road vehicle.
+ * This is built by a reverse Dijkstra search from all destination road stop tiles, so that road vehicles which are sufficiently far
+ * away from the station can choose their next trackdir by looking up the distances of the reachable trackdirs, instead of performing a search.
+ *
+ * Only costs which depend on the map layout and pathfinder settings are included: road stop occupancy, leader vehicles and speed limits are not.
+ * That way the field is a pure function of the road layout, and does not need to be saved: it is discarded whenever the road layout changes.
+ */
+struct RoadDestinationDistanceField {
+	std::unordered_map<uint64, int> distances; ///< cost from (tile, trackdir) to the destination, only for settled nodes
+	int road_change_counter;                   ///< CSegmentCostCacheBase::s_road_change_counter at the time of building
+	uint32 penalties[4];                       ///< pathfinder penalties used when building
+	uint64 last_used;                          ///< tick counter at last use
+
+	static uint64 NodeKey(TileIndex tile, Trackdir td)
+	{
+		return (((uint64)tile) << 4) | td;
+	}
+
+	bool Lookup(TileIndex tile, Trackdir td, int &dist) const
+	{
+		auto iter = this->distances.find(NodeKey(tile, td));
+		if (iter == this->distances.end()) return false;
+		dist = iter->second;
+		return true;
+	}
+};
+
+/** Maximum number of road distance fields kept at once */
+static const uint MAX_ROAD_DESTINATION_DISTANCE_FIELDS = 64;
+
+/** Number of ticks after which an unused road distance field is discarded */
+static const uint64 ROAD_DESTINATION_DISTANCE_FIELD_LIFETIME = DAY_TICKS * 30;
+
+static std::map<uint64, std::unique_ptr<RoadDestinationDistanceField>> _road_destination_distance_fields;
+
+/** Static part of the cost of leaving the given tile with the given trackdir, this matches CYapfCostRoadT::OneTileCost. */
+static int RoadDistanceFieldTileCost(TileIndex tile, Trackdir td, const YAPFSettings &settings)
+{
+	if (!IsDiagonalTrackdir(td)) return YAPF_TILE_CORNER_LENGTH + settings.road_curve_penalty;
+
+	int cost = YAPF_TILE_LENGTH;
+	if (IsLevelCrossingTile(tile)) cost += settings.road_crossing_penalty;
+	if (IsTileType(tile, MP_STATION) && IsDriveThroughStopTile(tile) && !IsRoadWaypoint(tile)) cost += settings.road_stop_penalty;
+	return cost;
+}
+
+/** Cost of an uphill step between two tiles, this matches CYapfCostRoadT::SlopeCost. */
+static int RoadDistanceFieldSlopeCost(TileIndex tile, TileIndex next_tile, const YAPFSettings &settings)
+{
+	int z1 = GetSlopePixelZ(TileX(tile) * TILE_SIZE + TILE_SIZE / 2, TileY(tile) * TILE_SIZE + TILE_SIZE / 2, true);
+	int z2 = GetSlopePixelZ(TileX(next_tile) * TILE_SIZE + TILE_SIZE / 2, TileY(next_tile) * TILE_SIZE + TILE_SIZE / 2, true);
+	return (z2 - z1 > 1) ? settings.road_slope_penalty : 0;
+}
+
+/**
+ * Build the distance field for a road vehicle heading to a station.
+ * @param field Field to fill.
+ * @param v Vehicle, this determines the road type, owner and the destination road stops.
+ * @param st Destination station.
+ */
+static void BuildRoadDestinationDistanceField(RoadDestinationDistanceField &field, const RoadVehicle *v, const Station *st)
+{
+	const YAPFSettings &settings = _settings_game.pf.yapf;
+	const RoadTramType rtt = GetRoadTramType(v->roadtype);
+	const StationType station_type = v->IsBus() ? STATION_BUS : STATION_TRUCK;
+	const bool non_artic = !v->HasArticulatedPart();
+	const DiagDirection travel_dir = v->current_order.GetRoadVehTravelDirection();
+
+	typedef std::pair<int, uint64> QueueItem;
+	std::priority_queue<QueueItem, std::vector<QueueItem>, std::greater<QueueItem>> queue;
+	std::unordered_map<uint64, int> tentative;
+
+	auto push = [&](TileIndex tile, Trackdir td, int dist) {
+		uint64 key = RoadDestinationDistanceField::NodeKey(tile, td);
+		if (field.distances.count(key) != 0) return;
+		auto res = tentative.insert({ key, dist });
+		if (!res.second) {
+			if (res.first->second <= dist) return;
+			res.first->second = dist;
+		}
+		queue.push({ dist, key });
+	};
+
+	/* Destination nodes, these match CYapfDestinationTileRoadT::PfDetectDestinationTile */
+	for (const RoadStop *rs = st->GetPrimaryRoadStop(v->IsBus() ? ROADSTOP_BUS : ROADSTOP_TRUCK); rs != nullptr; rs = rs->next) {
+		TileIndex tile = rs->xy;
+		if (GetStationType(tile) != station_type) continue;
+		if (!non_artic && !IsDriveThroughStopTile(tile)) continue;
+		TrackdirBits tds = GetTrackdirBitsForRoad(tile, rtt);
+		if (travel_dir != INVALID_DIAGDIR) {
+			Trackdir travel_td = DiagDirToDiagTrackdir(travel_dir);
+			if (IsDriveThroughStopTile(tile)) {
+				tds &= TrackdirToTrackdirBits(travel_td);
+			} else if (DiagDirToDiagTrackdir(ReverseDiagDir(GetRoadStopDir(tile))) != travel_td) {
+				tds = TRACKDIR_BIT_NONE;
+			}
+		}
+		for (Trackdir td : SetBitIterator<Trackdir>(tds)) {
+			push(tile, td, RoadDistanceFieldTileCost(tile, td, settings));
+		}
+	}
+
+	uint settled = 0;
+	while (!queue.empty() && settled < settings.max_search_nodes) {
+		QueueItem item = queue.top();
+		queue.pop();
+		if (field.distances.count(item.second) != 0) continue;
+		field.distances[item.second] = item.first;
+		settled++;
+
+		const TileIndex tile = (TileIndex)(item.second >> 4);
+		const Trackdir td = (Trackdir)(item.second & 0xF);
+
+		/* Candidate predecessor tiles: the tile itself (reversing), the adjacent tile the trackdir was entered from and the other end of a tunnel or bridge */
+		const DiagDirection back_dir = TrackdirToExitdir(ReverseTrackdir(td));
+		TileIndex candidates[3] = { tile, TileAddByDiagDir(tile, back_dir), INVALID_TILE };
+		if (IsTileType(tile, MP_TUNNELBRIDGE) && GetTunnelBridgeDirection(tile) == back_dir) candidates[2] = GetOtherTunnelBridgeEnd(tile);
+
+		for (TileIndex pred_tile : candidates) {
+			if (pred_tile == INVALID_TILE || !MayHaveRoad(pred_tile)) continue;
+			for (Trackdir pred_td : SetBitIterator<Trackdir>(GetTrackdirBitsForRoad(pred_tile, rtt))) {
+				CFollowTrackRoad F(v);
+				if (!F.Follow(pred_tile, pred_td)) continue;
+				if (F.m_new_tile != tile || !HasTrackdir(F.m_new_td_bits, td)) continue;
+
+				int cost = RoadDistanceFieldTileCost(pred_tile, pred_td, settings) + F.m_tiles_skipped * YAPF_TILE_LENGTH;
+				if (pred_tile != tile) cost += RoadDistanceFieldSlopeCost(pred_tile, tile, settings);
+				push(pred_tile, pred_td, item.first + cost);
+			}
+		}
+	}
+}
+
+/**
+ * Try to choose the next trackdir of a road vehicle heading to a station using a shared distance field.
+ * @param v Vehicle.
+ * @param tile Tile the vehicle is about to enter.
+ * @param src_trackdirs Reachable trackdirs on that tile.
+ * @param st Destination station.
+ * @return The trackdir with the lowest distance to the destination, or INVALID_TRACKDIR if the field can not be used.
+ */
+static Trackdir ChooseRoadTrackFromDistanceField(const RoadVehicle *v, TileIndex tile, TrackdirBits src_trackdirs, const Station *st)
+{
+	const YAPFSettings &settings = _settings_game.pf.yapf;
+	const uint32 penalties[4] = { settings.road_slope_penalty, settings.road_curve_penalty, settings.road_crossing_penalty, settings.road_stop_penalty };
+
+	const DiagDirection travel_dir = v->current_order.GetRoadVehTravelDirection();
+	const uint64 key = (((uint64)st->index) << 32) | (((uint64)v->roadtype) << 24) | (((uint64)v->owner) << 16) |
+			(v->IsBus() ? 0x100 : 0) | (v->HasArticulatedPart() ? 0x200 : 0) | (travel_dir == INVALID_DIAGDIR ? 0xF : (uint)travel_dir);
+
+	std::unique_ptr<RoadDestinationDistanceField> &field = _road_destination_distance_fields[key];
+	if (field != nullptr && (field->road_change_counter != CSegmentCostCacheBase::s_road_change_counter || memcmp(field->penalties, penalties, sizeof(penalties)) != 0)) {
+		field.reset();
+	}
+	RoadDestinationDistanceField *field_ptr = field.get();
+	if (field_ptr == nullptr) {
+		/* Discard fields which have not been used recently, or the least recently used one if there are too many */
+		for (auto iter = _road_destination_distance_fields.begin(); iter != _road_destination_distance_fields.end();) {
+			if (iter->second != nullptr && (iter->second->road_change_counter != CSegmentCostCacheBase::s_road_change_counter ||
+					iter->second->last_used + ROAD_DESTINATION_DISTANCE_FIELD_LIFETIME < _tick_counter)) {
+				iter = _road_destination_distance_fields.erase(iter);
+			} else {
+				++iter;
+			}
+		}
+		if (_road_destination_distance_fields.size() > MAX_ROAD_DESTINATION_DISTANCE_FIELDS) {
+			auto lru = _road_destination_distance_fields.end();
+			for (auto iter = _road_destination_distance_fields.begin(); iter != _road_destination_distance_fields.end(); ++iter) {
+				if (iter->second == nullptr) continue;
+				if (lru == _road_destination_distance_fields.end() || iter->second->last_used < lru->second->last_used) lru = iter;
+			}
+			if (lru != _road_destination_distance_fields.end()) _road_destination_distance_fields.erase(lru);
+		}
+
+		std::unique_ptr<RoadDestinationDistanceField> &new_field = _road_destination_distance_fields[key];
+		new_field.reset(new RoadDestinationDistanceField());
+		new_field->road_change_counter = CSegmentCostCacheBase::s_road_change_counter;
+		memcpy(new_field->penalties, penalties, sizeof(penalties));
+		BuildRoadDestinationDistanceField(*new_field, v, st);
+		field_ptr = new_field.get();
+	}
+	field_ptr->last_used = _tick_counter;
+
+	Trackdir best_td = INVALID_TRACKDIR;
+	int best_dist = INT_MAX;
+	for (Trackdir td : SetBitIterator<Trackdir>(src_trackdirs)) {
+		int dist;
+		if (field_ptr->Lookup(tile, td, dist) && dist < best_dist) {
+			best_td = td;
+			best_dist = dist;
+		}
+	}
+	return best_td;
+}
+
 struct FindVehiclesOnTileProcData {
 	const Vehicle *origin_vehicle;
 	TileIndex (*targets)[MAX_RV_LEADER_TARGETS];
@@ -438,8 +784,21 @@ public:
 
 	static Trackdir stChooseRoadTrack(const RoadVehicle *v, TileIndex tile, DiagDirection enterdir, bool &path_found, RoadVehPathCache &path_cache)
 	{
-		Tpf pf;
-		return pf.ChooseRoadTrack(v, tile, enterdir, path_found, path_cache);
+		Tpf pf1;
+		Trackdir result1 = pf1.ChooseRoadTrack(v, tile, enterdir, path_found, path_cache);
+
+		if (_debug_yapfdesync_level > 0 || _debug_desync_level >= 2) {
+			Tpf pf2;
+			pf2.DisableCache(true);
+			bool path_found2;
+			RoadVehPathCache path_cache2;
+			Trackdir result2 = pf2.ChooseRoadTrack(v, tile, enterdir, path_found2, path_cache2);
+			if (result1 != result2 || path_found != path_found2) {
+				DEBUG(desync, 0, "CACHE ERROR: ChooseRoadTrack() = [%d, %d], [%s, %s]", result1, result2, path_found ? "T" : "F", path_found2 ? "T" : "F");
+			}
+		}
+
+		return result1;
 	}
 
 	inline Trackdir ChooseRoadTrack(const RoadVehicle *v, TileIndex tile, DiagDirection enterdir, bool &path_found, RoadVehPathCache &path_cache)
@@ -475,6 +834,19 @@ public:
 			}
 		}
 
+		if (_settings_game.pf.rv_shared_destination_search && st != nullptr && v->current_order.IsType(OT_GOTO_STATION)) {
+			/* Far from the destination, the shared distance field is good enough */
+			TileArea near_area = v->IsBus() ? st->bus_station : st->truck_station;
+			near_area.Expand(YAPF_ROADVEH_PATH_CACHE_DESTINATION_LIMIT);
+			if (!near_area.Contains(tile)) {
+				Trackdir td = ChooseRoadTrackFromDistanceField(v, tile, src_trackdirs, st);
+				if (td != INVALID_TRACKDIR) {
+					path_found = true;
+					return td;
+				}
+			}
+		}
+
 		Yapf().leader_targets[0] = INVALID_TILE;
 		if (multiple_targets && non_cached_area.Contains(tile)) {
 			/* Destination station has at least 2 usable road stops, or first is a drive-through stop,
@@ -617,6 +989,11 @@ struct CYapfRoad_TypesT
 template <class Types>
 struct CYapfRoadCommon : CYapfT<Types> {
 	TileIndex leader_targets[MAX_RV_LEADER_TARGETS]; ///< the tiles targeted by vehicles in front of the current vehicle
+
+	CYapfRoadCommon()
+	{
+		this->leader_targets[0] = INVALID_TILE;
+	}
 };
 
 struct CYapfRoad1         : CYapfRoadCommon<CYapfRoad_TypesT<CYapfRoad1        , CRoadNodeListTrackDir, CYapfDestinationTileRoadT    > > {};
@@ -14,9 +14,14 @@
 
 #include "yapf.hpp"
 #include "yapf_node_ship.hpp"
+#include "yapf_ship_regions.h"
+#include "../water_regions.h"
 
 #include "../../safeguards.h"
 
+/** Number of water regions beyond the current one that the low level ship pathfinder searches towards. */
+constexpr int NUMBER_OR_WATER_REGIONS_LOOKAHEAD = 4;
+
 template <class Types>
 class CYapfDestinationTileWaterT
 {
@@ -31,6 +36,10 @@ protected:
 	TrackdirBits m_destTrackdirs;
 	StationID    m_destStation;
 
+	bool                 m_has_intermediate_dest = false;
+	TileIndex            m_intermediate_dest_tile;
+	WaterRegionPatchDesc m_intermediate_dest_region_patch;
+
 public:
 	void SetDestination(const Ship *v)
 	{
@@ -45,6 +54,17 @@ public:
 		}
 	}
 
+	/**
+	 * Search towards any tile of the given water region patch instead of the actual destination.
+	 * This is used when the destination is beyond the water region lookahead of the high level path.
+	 */
+	void SetIntermediateDestination(const WaterRegionPatchDesc &water_region_patch)
+	{
+		m_has_intermediate_dest = true;
+		m_intermediate_dest_tile = GetWaterRegionCenterTile(water_region_patch);
+		m_intermediate_dest_region_patch = water_region_patch;
+	}
+
 protected:
 	/** to access inherited path finder */
 	inline Tpf& Yapf()
@@ -61,6 +81,12 @@ public:
 
 	inline bool PfDetectDestinationTile(TileIndex tile, Trackdir trackdir)
 	{
+		if (m_has_intermediate_dest) {
+			/* GetWaterRegionInfo is much faster than GetWaterRegionPatchInfo so we try that first. */
+			if (GetWaterRegionInfo(tile) != m_intermediate_dest_region_patch) return false;
+			return GetWaterRegionPatchInfo(tile) == m_intermediate_dest_region_patch;
+		}
+
 		if (m_destStation != INVALID_STATION) {
 			return IsDockingTile(tile) && IsShipDestinationTile(tile, m_destStation);
 		}
@@ -85,8 +111,9 @@ public:
 		DiagDirection exitdir = TrackdirToExitdir(n.m_segment_last_td);
 		int x1 = 2 * TileX(tile) + dg_dir_to_x_offs[(int)exitdir];
 		int y1 = 2 * TileY(tile) + dg_dir_to_y_offs[(int)exitdir];
-		int x2 = 2 * TileX(m_destTile);
-		int y2 = 2 * TileY(m_destTile);
+		const TileIndex destination_tile = m_has_intermediate_dest ? m_intermediate_dest_tile : m_destTile;
+		int x2 = 2 * TileX(destination_tile);
+		int y2 = 2 * TileY(destination_tile);
 		int dx = abs(x1 - x2);
 		int dy = abs(y1 - y2);
 		int dmin = std::min(dx, dy);
@@ -116,6 +143,8 @@ protected:
 		return *static_cast<Tpf *>(this);
 	}
 
+	std::vector<WaterRegionDesc> m_water_region_corridor;
+
 public:
 	/**
 	 * Called by YAPF to move from the given node to the next tile. For each
@@ -126,10 +155,21 @@ public:
 	{
 		TrackFollower F(Yapf().GetVehicle());
 		if (F.Follow(old_node.m_key.m_tile, old_node.m_key.m_td)) {
+			if (!m_water_region_corridor.empty() &&
+					std::find(m_water_region_corridor.begin(), m_water_region_corridor.end(), GetWaterRegionInfo(F.m_new_tile)) == m_water_region_corridor.end()) {
+				return;
+			}
 			Yapf().AddMultipleNodes(&old_node, F);
 		}
 	}
 
+	/** Restrict the search to the water regions of the given high level path. */
+	void RestrictSearch(const std::vector<WaterRegionPatchDesc> &path)
+	{
+		m_water_region_corridor.clear();
+		for (const WaterRegionPatchDesc &path_entry : path) m_water_region_corridor.push_back(path_entry);
+	}
+
 	/** return debug report character to identify the transportation type */
 	inline char TransportTypeChar() const
 	{
@@ -158,14 +198,49 @@ public:
 		/* convert origin trackdir to TrackdirBits */
 		TrackdirBits trackdirs = TrackdirToTrackdirBits(trackdir);
 
-		/* create pathfinder instance */
-		Tpf pf;
-		/* set origin and destination nodes */
-		pf.SetOrigin(src_tile, trackdirs);
-		pf.SetDestination(v);
-		/* find best path */
-		path_found = pf.FindPath(v);
+		/* Find the high level path through the water regions. */
+		const std::vector<WaterRegionPatchDesc> high_level_path = YapfShipFindWaterRegionPath(v, src_tile, NUMBER_OR_WATER_REGIONS_LOOKAHEAD + 1);
+		if (high_level_path.empty()) {
+			/* The destination is not reachable at all, don't waste time on a full low level search. */
+			path_found = false;
+			TrackdirBits next_trackdirs = TrackBitsToTrackdirBits(tracks) & DiagdirReachesTrackdirs(enterdir);
+			if (next_trackdirs == TRACKDIR_BIT_NONE) return INVALID_TRACKDIR;
+			Trackdir veh_dir = v->GetVehicleTrackdir();
+			return (HasTrackdir(next_trackdirs, veh_dir)) ? veh_dir : (Trackdir)FindFirstBit2x64(next_trackdirs);
+		}
+		const bool is_intermediate_destination = (int)high_level_path.size() >= NUMBER_OR_WATER_REGIONS_LOOKAHEAD + 1;
+
+		/* Try one time without restricting the search area, which generally results in better and more natural looking paths.
+		 * However the pathfinder can hit the node limit in certain situations such as long aqueducts or maze-like terrain.
+		 * If that happens we run the pathfinder again, but restricted only to the regions of the high level path. */
+		for (int attempt = 0; attempt < 2; ++attempt) {
+			/* create pathfinder instance */
+			Tpf pf;
+			/* set origin and destination nodes */
+			pf.SetOrigin(src_tile, trackdirs);
+			pf.SetDestination(v);
+			if (is_intermediate_destination) pf.SetIntermediateDestination(high_level_path.back());
+			if (attempt > 0) pf.RestrictSearch(high_level_path);
+
+			/* find best path */
+			path_found = pf.FindPath(v);
+			if (!path_found && attempt == 0) continue;
+
+			return ExtractShipPath(pf, tile, path_found, path_cache);
+		}
+		NOT_REACHED();
+	}
 
+	/**
+	 * Fill the path cache from the pathfinder result and return the first trackdir of the path.
+	 * @param pf Pathfinder instance after the search.
+	 * @param tile Tile the ship is about to enter.
+	 * @param path_found Whether the destination was reached.
+	 * @param path_cache [out] Path cache to fill.
+	 * @return Trackdir to take on the next tile, or INVALID_TRACKDIR if none.
+	 */
+	static Trackdir ExtractShipPath(Tpf &pf, TileIndex tile, bool path_found, ShipPathCache &path_cache)
+	{
 		Trackdir next_trackdir = INVALID_TRACKDIR; // this would mean "path not found"
 
 		Node *pNode = pf.GetBestNode();
@@ -40,6 +40,7 @@
 #include "news_func.h"
 #include "scope.h"
 #include "newgrf_newsignals.h"
+#include "pathfinder/water_regions.h"
 
 #include "table/strings.h"
 #include "table/railtypes.h"
@@ -1048,6 +1049,7 @@ CommandCost CmdRemoveSingleRail(TileIndex tile, DoCommandFlag flags, uint32 p1,
 						bool docking = IsDockingTile(tile);
 						MakeShore(tile);
 						SetDockingTile(tile, docking);
+						InvalidateWaterRegion(tile);
 					} else {
 						DoClearSquare(tile);
 					}
@@ -1178,6 +1180,7 @@ bool FloodHalftile(TileIndex t)
 			if (rail_bits == 0) {
 				MakeShore(t);
 				MarkTileDirtyByTile(t);
+				InvalidateWaterRegion(t);
 				return flooded;
 			}
 		}
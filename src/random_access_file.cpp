@@ -14,6 +14,12 @@
 #include "fileio_func.h"
 #include "string_func.h"
 
+#if defined(UNIX) && !defined(__EMSCRIPTEN__)
+#	define WITH_RANDOM_ACCESS_FILE_MMAP
+#	include <sys/mman.h>
+#	include <sys/stat.h>
+#endif
+
 #include "safeguards.h"
 
 /**
@@ -36,6 +42,21 @@ RandomAccessFile::RandomAccessFile(const std::string &filename, Subdirectory sub
 	this->simplified_filename = name_without_path.substr(0, name_without_path.rfind('.'));
 	strtolower(this->simplified_filename);
 
+#ifdef WITH_RANDOM_ACCESS_FILE_MMAP
+	/* Map the whole underlying file, positions are relative to its start also when the file is in a tar-file. */
+	struct stat st;
+	const int fd = fileno(this->file_handle);
+	if (fd >= 0 && fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0 && (uint64)st.st_size <= SIZE_MAX) {
+		void *mapping = mmap(nullptr, (size_t)st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+		if (mapping != MAP_FAILED) {
+			this->mapping = static_cast<byte *>(mapping);
+			this->mapping_size = (size_t)st.st_size;
+		} else {
+			DEBUG(misc, 3, "Memory mapping %s failed, reading it through the buffer", this->filename.c_str());
+		}
+	}
+#endif
+
 	this->SeekTo((size_t)pos, SEEK_SET);
 }
 
@@ -44,6 +65,9 @@ RandomAccessFile::RandomAccessFile(const std::string &filename, Subdirectory sub
  */
 RandomAccessFile::~RandomAccessFile()
 {
+#ifdef WITH_RANDOM_ACCESS_FILE_MMAP
+	if (this->mapping != nullptr) munmap(this->mapping, this->mapping_size);
+#endif
 	fclose(this->file_handle);
 }
 
@@ -84,6 +108,14 @@ void RandomAccessFile::SeekTo(size_t pos, int mode)
 {
 	if (mode == SEEK_CUR) pos += this->GetPos();
 
+	if (this->mapping != nullptr) {
+		/* Reading beyond the end behaves like the end of a file: all reads return 0. */
+		this->buffer = this->mapping + std::min(pos, this->mapping_size);
+		this->buffer_end = this->mapping + this->mapping_size;
+		this->pos = this->mapping_size;
+		return;
+	}
+
 	this->pos = pos;
 	if (fseek(this->file_handle, this->pos, SEEK_SET) < 0) {
 		DEBUG(misc, 0, "Seeking in %s failed", this->filename.c_str());
@@ -100,6 +132,8 @@ void RandomAccessFile::SeekTo(size_t pos, int mode)
 byte RandomAccessFile::ReadByteIntl()
 {
 	if (this->buffer == this->buffer_end) {
+		if (this->mapping != nullptr) return 0;
+
 		this->buffer = this->buffer_start;
 		size_t size = fread(this->buffer, 1, RandomAccessFile::BUFFER_SIZE, this->file_handle);
 		this->pos += size;
@@ -137,6 +171,13 @@ uint32 RandomAccessFile::ReadDwordIntl()
  */
 void RandomAccessFile::ReadBlock(void *ptr, size_t size)
 {
+	if (this->mapping != nullptr) {
+		size = std::min<size_t>(size, this->buffer_end - this->buffer);
+		memcpy(ptr, this->buffer, size);
+		this->buffer += size;
+		return;
+	}
+
 	this->SeekTo(this->GetPos(), SEEK_SET);
 	this->pos += fread(ptr, 1, size, this->file_handle);
 }
@@ -20,6 +20,9 @@
  * This is mostly intended to be used for things that can be read from GRFs when needed, so
  * the graphics but also the sounds. This also ties into the spritecache as it uses these
  * files to load the sprites from when needed.
+ *
+ * Where supported the file is memory mapped, the read "buffer" then spans the whole mapping,
+ * so reads and seeks do not need any system calls.
  */
 class RandomAccessFile {
 	/** The number of bytes to allocate for the buffer. */
@@ -35,6 +38,9 @@ class RandomAccessFile {
 	byte *buffer_end;                ///< Last valid byte of buffer.
 	byte buffer_start[BUFFER_SIZE];  ///< Local buffer when read from file.
 
+	byte *mapping = nullptr;         ///< Read-only memory mapping of the whole file, used instead of the buffer when available.
+	size_t mapping_size = 0;         ///< Size of the memory mapping.
+
 	byte ReadByteIntl();
 	uint16 ReadWordIntl();
 	uint32 ReadDwordIntl();
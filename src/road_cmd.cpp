@@ -411,6 +411,8 @@ static void InterpolateRoadCachedOneWayStates()
 
 void RecalculateRoadCachedOneWayStates()
 {
+	YapfNotifyRoadLayoutChange();
+
 	for (TileIndex tile = 0; tile != MapSize(); tile++) {
 		if (MayHaveRoad(tile)) UpdateTileRoadCachedOneWayState(tile);
 	}
@@ -419,6 +421,8 @@ void RecalculateRoadCachedOneWayStates()
 
 void UpdateRoadCachedOneWayStatesAroundTile(TileIndex tile)
 {
+	YapfNotifyRoadLayoutChange();
+
 	if (_generating_world) return;
 
 	auto check_tile = [](TileIndex t) {
@@ -1752,6 +1756,7 @@ CommandCost CmdBuildRoadDepot(TileIndex tile, DoCommandFlag flags, uint32 p1, ui
 
 		MakeRoadDepot(tile, _current_company, dep->index, dir, rt);
 		MarkTileDirtyByTile(tile);
+		YapfNotifyRoadLayoutChange();
 		MakeDefaultName(dep);
 
 		NotifyRoadLayoutChanged(true);
@@ -2572,6 +2577,7 @@ static void TileLoop_Road(TileIndex tile)
 					IsNormalRoad(tile) && !HasAtMostOneBit(GetAllRoadBits(tile))) {
 				if (GetFoundationSlope(tile) == SLOPE_FLAT && EnsureNoVehicleOnGround(tile).Succeeded() && Chance16(1, 40)) {
 					StartRoadWorks(tile);
+					YapfNotifyRoadLayoutChange();
 
 					if (_settings_client.sound.ambient) SndPlayTileFx(SND_21_ROAD_WORKS, tile);
 					CreateEffectVehicleAbove(
@@ -2608,6 +2614,7 @@ static void TileLoop_Road(TileIndex tile)
 		}
 	} else if (IncreaseRoadWorksCounter(tile)) {
 		TerminateRoadWorks(tile);
+		YapfNotifyRoadLayoutChange();
 
 		if (_settings_game.economy.mod_road_rebuild) {
 			/* Generate a nicer town surface */
@@ -2630,6 +2637,7 @@ static void TileLoop_Road(TileIndex tile)
 			RoadType rt = GetTownRoadType();
 			if (rt != GetRoadTypeRoad(tile)) {
 				SetRoadType(tile, RTT_ROAD, rt);
+				YapfNotifyRoadLayoutChange();
 			}
 		}
 
@@ -3160,6 +3168,7 @@ CommandCost CmdConvertRoad(TileIndex tile, DoCommandFlag flags, uint32 p1, uint3
 				/* Perform the conversion */
 				SetRoadType(tile, rtt, to_type);
 				MarkTileDirtyByTile(tile);
+				YapfNotifyRoadLayoutChange();
 
 				/* update power of train on this tile */
 				FindVehicleOnPos(tile, VEH_ROAD, &affected_rvs, &UpdateRoadVehPowerProc);
@@ -3235,6 +3244,7 @@ CommandCost CmdConvertRoad(TileIndex tile, DoCommandFlag flags, uint32 p1, uint3
 				/* Perform the conversion */
 				SetRoadType(tile, rtt, to_type);
 				if (include_middle) SetRoadType(endtile, rtt, to_type);
+				YapfNotifyRoadLayoutChange();
 
 				FindVehicleOnPos(tile, VEH_ROAD, &affected_rvs, &UpdateRoadVehPowerProc);
 				FindVehicleOnPos(endtile, VEH_ROAD, &affected_rvs, &UpdateRoadVehPowerProc);
@@ -13,6 +13,7 @@
 #include "roadstop_base.h"
 #include "station_base.h"
 #include "vehicle_func.h"
+#include "3rdparty/cpp-btree/btree_map.h"
 
 #include "safeguards.h"
 
@@ -20,6 +21,20 @@
 RoadStopPool _roadstop_pool("RoadStop");
 INSTANTIATE_POOL_METHODS(RoadStop)
 
+/** Road stop on each tile, so road stops can be found without walking the road stop list of the station. */
+static btree::btree_map<TileIndex, RoadStop *> _roadstop_tile_index;
+
+/**
+ * Initializes a RoadStop.
+ * @param tile Tile of the road stop, INVALID_TILE when the tile is set later, such as when loading.
+ */
+RoadStop::RoadStop(TileIndex tile) :
+	xy(tile),
+	status((1 << RSSFB_BAY_COUNT) - 1)
+{
+	if (tile != INVALID_TILE) _roadstop_tile_index[tile] = this;
+}
+
 /**
  * De-Initializes RoadStops.
  */
@@ -32,6 +47,28 @@ RoadStop::~RoadStop()
 	}
 
 	if (CleaningPool()) return;
+
+	auto iter = _roadstop_tile_index.find(this->xy);
+	if (iter != _roadstop_tile_index.end() && iter->second == this) _roadstop_tile_index.erase(iter);
+}
+
+/**
+ * Rebuild the index of road stops by tile, after the tiles of the road stops have been loaded.
+ */
+/* static */ void RoadStop::RebuildTileIndex()
+{
+	_roadstop_tile_index.clear();
+	for (RoadStop *rs : RoadStop::Iterate()) {
+		_roadstop_tile_index[rs->xy] = rs;
+	}
+}
+
+/**
+ * The road stop pool is about to be cleaned, forget all road stops.
+ */
+/* static */ void RoadStop::PreCleanPool()
+{
+	_roadstop_tile_index.clear();
 }
 
 /**
@@ -362,6 +399,13 @@ bool RoadStop::Enter(RoadVehicle *rv)
  */
 /* static */ RoadStop *RoadStop::GetByTile(TileIndex tile, RoadStopType type)
 {
+	auto iter = _roadstop_tile_index.find(tile);
+	if (iter != _roadstop_tile_index.end()) {
+		dbg_assert(iter->second->xy == tile);
+		return iter->second;
+	}
+
+	/* Road stops which are being loaded are not in the index yet. */
 	const Station *st = Station::GetByTile(tile);
 
 	for (RoadStop *rs = st->GetPrimaryRoadStop(type);; rs = rs->next) {
@@ -70,12 +70,7 @@ struct RoadStop : RoadStopPool::PoolItem<&_roadstop_pool> {
 	byte            status; ///< Current status of the Stop, @see RoadStopSatusFlag. Access using *Bay and *Busy functions.
 	struct RoadStop *next;  ///< Next stop of the given type at this station
 
-	/** Initializes a RoadStop */
-	inline RoadStop(TileIndex tile = INVALID_TILE) :
-		xy(tile),
-		status((1 << RSSFB_BAY_COUNT) - 1)
-	{ }
-
+	RoadStop(TileIndex tile = INVALID_TILE);
 	~RoadStop();
 
 	/**
@@ -156,6 +151,8 @@ struct RoadStop : RoadStopPool::PoolItem<&_roadstop_pool> {
 	RoadStop *GetNextRoadStop(const struct RoadVehicle *v) const;
 
 	static RoadStop *GetByTile(TileIndex tile, RoadStopType type);
+	static void RebuildTileIndex();
+	static void PreCleanPool();
 
 	static bool IsDriveThroughRoadStopContinuation(TileIndex rs, TileIndex next);
 
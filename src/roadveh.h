@@ -85,6 +85,7 @@ static const uint8 RV_PATH_CACHE_SEGMENT_MASK = (RV_PATH_CACHE_SEGMENTS - 1);
 static_assert((RV_PATH_CACHE_SEGMENTS & RV_PATH_CACHE_SEGMENT_MASK) == 0, ""); // Must be a power of 2
 
 void RoadVehUpdateCache(RoadVehicle *v, bool same_length = false);
+void CheckIfRoadVehNeedsService(RoadVehicle *v, bool defer_search = false);
 void GetRoadVehSpriteSize(EngineID engine, uint &width, uint &height, int &xoffs, int &yoffs, EngineImageType image_type);
 
 struct RoadVehPathCache {
@@ -344,8 +344,6 @@ CommandCost CmdBuildRoadVehicle(TileIndex tile, DoCommandFlag flags, const Engin
 		v->UpdatePosition();
 
 		CheckConsistencyOfArticulatedVehicle(v);
-
-		InvalidateVehicleTickCaches();
 	}
 
 	return CommandCost();
@@ -693,28 +691,46 @@ struct RoadVehFindData {
 	uint best_diff;
 	Direction dir;
 	RoadTypeCollisionMode collision_mode;
+	short x_diff_min; ///< Minimum horizontal offset of a vehicle in front, in direction #dir.
+	short x_diff_max; ///< Maximum horizontal offset of a vehicle in front, in direction #dir.
+	short y_diff_min; ///< Minimum vertical offset of a vehicle in front, in direction #dir.
+	short y_diff_max; ///< Maximum vertical offset of a vehicle in front, in direction #dir.
+
+	/**
+	 * Set the area in which a vehicle counts as being in front, for the direction #dir.
+	 * Vehicles are in front when they are less than the distance for the direction away, or at the same position.
+	 */
+	void SetCloseArea()
+	{
+		static const int8 dist_x[] = { -4, -8, -4, -1, 4, 8, 4, 1 };
+		static const int8 dist_y[] = { -4, -1, 4, 8, 4, 1, -4, -8 };
+
+		auto set_range = [](int8 dist, short &min, short &max) {
+			min = dist < 0 ? dist + 1 : 0;
+			max = dist > 0 ? dist - 1 : 0;
+		};
+		set_range(dist_x[this->dir], this->x_diff_min, this->x_diff_max);
+		set_range(dist_y[this->dir], this->y_diff_min, this->y_diff_max);
+	}
 };
 
 static Vehicle *EnumCheckRoadVehClose(Vehicle *veh, void *data)
 {
-	static const int8 dist_x[] = { -4, -8, -4, -1, 4, 8, 4, 1 };
-	static const int8 dist_y[] = { -4, -1, 4, 8, 4, 1, -4, -8 };
-
 	RoadVehFindData *rvf = (RoadVehFindData*)data;
 	RoadVehicle *v = RoadVehicle::From(veh);
 
+	/* Most vehicles are rejected by the cheap direction and position checks, so do those first. */
+	if (v->direction != rvf->dir) return nullptr;
+
 	short x_diff = v->x_pos - rvf->x;
 	short y_diff = v->y_pos - rvf->y;
 
-	if (!v->IsInDepot() &&
+	if (x_diff >= rvf->x_diff_min && x_diff <= rvf->x_diff_max &&
+			y_diff >= rvf->y_diff_min && y_diff <= rvf->y_diff_max &&
+			!v->IsInDepot() &&
 			abs(v->z_pos - rvf->veh->z_pos) < 6 &&
-			v->direction == rvf->dir &&
 			rvf->veh->First() != v->First() &&
-			HasBit(_collision_mode_roadtypes[rvf->collision_mode], v->roadtype) &&
-			(dist_x[v->direction] >= 0 || (x_diff > dist_x[v->direction] && x_diff <= 0)) &&
-			(dist_x[v->direction] <= 0 || (x_diff < dist_x[v->direction] && x_diff >= 0)) &&
-			(dist_y[v->direction] >= 0 || (y_diff > dist_y[v->direction] && y_diff <= 0)) &&
-			(dist_y[v->direction] <= 0 || (y_diff < dist_y[v->direction] && y_diff >= 0))) {
+			HasBit(_collision_mode_roadtypes[rvf->collision_mode], v->roadtype)) {
 		uint diff = abs(x_diff) + abs(y_diff);
 
 		if (diff < rvf->best_diff || (diff == rvf->best_diff && v->index < rvf->best->index)) {
@@ -741,6 +757,7 @@ static RoadVehicle *RoadVehFindCloseTo(RoadVehicle *v, int x, int y, Direction d
 	rvf.veh = v;
 	rvf.best_diff = UINT_MAX;
 	rvf.collision_mode = collision_mode;
+	rvf.SetCloseArea();
 
 	if (front->state == RVSB_WORMHOLE) {
 		FindVehicleOnPos(v->tile, VEH_ROAD, &rvf, EnumCheckRoadVehClose);
@@ -2249,7 +2266,12 @@ void RoadVehicle::SetRoadVehicleOvertaking(byte overtaking)
 	if (IsInsideMM(this->state, RVSB_IN_DT_ROAD_STOP, RVSB_IN_DT_ROAD_STOP_END)) RoadStop::GetByTile(this->tile, GetRoadStopType(this->tile))->Enter(this);
 }
 
-static void CheckIfRoadVehNeedsService(RoadVehicle *v)
+/**
+ * Check whether a road vehicle needs servicing, and if so send it to a nearby depot.
+ * @param v Front vehicle of the road vehicle.
+ * @param defer_search Queue the depot search instead of doing it now, if enabled.
+ */
+void CheckIfRoadVehNeedsService(RoadVehicle *v, bool defer_search)
 {
 	/* If we already got a slot at a stop, use that FIRST, and go to a depot later */
 	if (Company::Get(v->owner)->settings.vehicle.servint_roadveh == 0 || !v->NeedsAutomaticServicing()) return;
@@ -2258,6 +2280,8 @@ static void CheckIfRoadVehNeedsService(RoadVehicle *v)
 		return;
 	}
 
+	if (defer_search && QueueDeferredDepotSearch(v)) return;
+
 	uint max_penalty;
 	switch (_settings_game.pf.pathfinder_for_roadvehs) {
 		case VPF_NPF:  max_penalty = _settings_game.pf.npf.maximum_go_to_depot_penalty;  break;
@@ -2307,7 +2331,7 @@ void RoadVehicle::OnPeriodic()
 
 	if (this->blocked_ctr == 0) CheckVehicleBreakdown(this);
 
-	CheckIfRoadVehNeedsService(this);
+	CheckIfRoadVehNeedsService(this, true);
 
 	CheckOrders(this);
 
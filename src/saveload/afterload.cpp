@@ -20,6 +20,7 @@
 #include "../viewport_func.h"
 #include "../viewport_kdtree.h"
 #include "../industry.h"
+#include "../industry_kdtree.h"
 #include "../clear_map.h"
 #include "../vehicle_func.h"
 #include "../string_func.h"
@@ -681,6 +682,7 @@ bool AfterLoadGame()
 
 	RebuildTownKdtree();
 	RebuildStationKdtree();
+	RebuildIndustryKdtree();
 	UpdateCachedSnowLine();
 	UpdateCachedSnowLineBounds();
 
@@ -1770,6 +1772,7 @@ bool AfterLoadGame()
 	}
 
 	YapfNotifyTrackLayoutChange(INVALID_TILE, INVALID_TRACK);
+	YapfNotifyRoadLayoutChange();
 
 	if (IsSavegameVersionBefore(SLV_34)) {
 		for (Company *c : Company::Iterate()) ResetCompanyLivery(c);
@@ -1982,6 +1985,8 @@ bool AfterLoadGame()
 		}
 	}
 
+	RebuildStationsWithLoadingVehicles();
+
 	if (IsSavegameVersionBefore(SLV_58)) {
 		/* Setting difficulty industry_density other than zero get bumped to +1
 		 * since a new option (very low at position 1) has been added */
@@ -4056,6 +4061,8 @@ bool AfterLoadGame()
 
 	if (SlXvIsFeatureMissing(XSLFI_ANIMATED_TILE_EXTRA)) {
 		UpdateAllAnimatedTileSpeeds();
+	} else {
+		UpdateAllAnimatedTileSimpleAnimations();
 	}
 
 	if (!SlXvIsFeaturePresent(XSLFI_REALISTIC_TRAIN_BRAKING, 2)) {
@@ -4421,6 +4428,7 @@ void ReloadNewGRFData()
 	UpdateExtraAspectsVariable();
 
 	InitRoadTypesCaches();
+	YapfNotifyRoadLayoutChange();
 
 	ReInitAllWindows(false);
 
@@ -32,6 +32,7 @@
 #include "smallmap_colours.h"
 #include "smallmap_gui.h"
 #include "screenshot_gui.h"
+#include "thread.h"
 
 #include "table/strings.h"
 
@@ -261,6 +262,27 @@ static void PNGAPI png_my_warning(png_structp png_ptr, png_const_charp message)
 	DEBUG(misc, 1, "[libpng] warning: %s - %s", message, (const char *)png_get_error_ptr(png_ptr));
 }
 
+/**
+ * Write a strip of rows to a PNG, possibly from a thread other than the one which set up the PNG.
+ * @param png_ptr The PNG to write to.
+ * @param buff    The rows to write.
+ * @param n       Number of rows in \a buff.
+ * @param stride  Number of bytes of a row in \a buff.
+ * @param failed  Set to true if libpng reported an error.
+ */
+static void PNGWriteRows(png_structp png_ptr, const uint8 *buff, uint n, size_t stride, bool *failed)
+{
+	/* libpng reports errors by a longjmp, which has to stay on this thread. */
+	if (setjmp(png_jmpbuf(png_ptr))) {
+		*failed = true;
+		return;
+	}
+
+	for (uint i = 0; i != n; i++) {
+		png_write_row(png_ptr, const_cast<png_bytep>(buff + i * stride));
+	}
+}
+
 /**
  * Generic .PNG file image writer.
  * @param name        Filename, including extension.
@@ -398,8 +420,13 @@ static bool MakePNGImage(const char *name, ScreenshotCallback *callb, void *user
 	/* use by default 64k temp memory */
 	maxlines = Clamp(65536 / w, 16, 128);
 
-	/* now generate the bitmap bits */
-	void *buff = CallocT<uint8>(static_cast<size_t>(w) * maxlines * bpp); // by default generate 128 lines at a time.
+	/* now generate the bitmap bits; by default generate 128 lines at a time.
+	 * The next strip is rendered into the other buffer while the previous one is compressed and written on a separate thread. */
+	const size_t stride = static_cast<size_t>(w) * bpp;
+	uint8 *buff[2] = { CallocT<uint8>(stride * maxlines), CallocT<uint8>(stride * maxlines) };
+	uint cur = 0;
+	std::thread writer;
+	bool failed = false;
 
 	y = 0;
 	do {
@@ -407,19 +434,39 @@ static bool MakePNGImage(const char *name, ScreenshotCallback *callb, void *user
 		n = std::min(h - y, maxlines);
 
 		/* render the pixels into the buffer */
-		callb(userdata, buff, y, w, n);
+		callb(userdata, buff[cur], y, w, n);
 		y += n;
 
-		/* write them to png */
-		for (i = 0; i != n; i++) {
-			png_write_row(png_ptr, (png_bytep)buff + i * w * bpp);
+		/* wait for the previous strip, then write this one to png */
+		if (writer.joinable()) writer.join();
+		if (failed) break;
+		const uint8 *strip = buff[cur];
+		if (!StartNewThread(&writer, "ottd:png", [=, &failed]() { PNGWriteRows(png_ptr, strip, n, stride, &failed); })) {
+			PNGWriteRows(png_ptr, strip, n, stride, &failed);
 		}
+		cur ^= 1;
 	} while (y != h);
 
+	if (writer.joinable()) writer.join();
+	free(buff[0]);
+	free(buff[1]);
+
+	if (failed) {
+		png_destroy_write_struct(&png_ptr, &info_ptr);
+		fclose(f);
+		return false;
+	}
+
+	/* the jump buffer was last set by the writer */
+	if (setjmp(png_jmpbuf(png_ptr))) {
+		png_destroy_write_struct(&png_ptr, &info_ptr);
+		fclose(f);
+		return false;
+	}
+
 	png_write_end(png_ptr, info_ptr);
 	png_destroy_write_struct(&png_ptr, &info_ptr);
 
-	free(buff);
 	fclose(f);
 	return true;
 }
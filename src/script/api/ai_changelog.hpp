@@ -20,6 +20,12 @@
  * API additions:
  * \li AITown::ROAD_LAYOUT_RANDOM
  * \li AIVehicle::IsPrimaryVehicle
+ * \li AITileList::ValuateDistanceManhattanToTile
+ * \li AITileList::ValuateDistanceSquareToTile
+ * \li AITileList::ValuateBuildable
+ * \li AITownList_InRadius
+ * \li AIStationList_InRadius
+ * \li AIEventController::GetNextEvents
  *
  * API removals:
  * \li AIError::ERR_PRECONDITION_TOO_MANY_PARAMETERS, that error is never returned anymore.
@@ -80,6 +80,12 @@
  * \li GSGoal::SetDestination
  * \li GSIndustry::GetProductionLevel
  * \li GSIndustry::SetProductionLevel
+ * \li GSTileList::ValuateDistanceManhattanToTile
+ * \li GSTileList::ValuateDistanceSquareToTile
+ * \li GSTileList::ValuateBuildable
+ * \li GSTownList_InRadius
+ * \li GSStationList_InRadius
+ * \li GSEventController::GetNextEvents
  *
  * API removals:
  * \li GSError::ERR_PRECONDITION_TOO_MANY_PARAMETERS, that error is never returned anymore.
@@ -10,6 +10,7 @@
 #include "../../stdafx.h"
 #include "script_event_types.hpp"
 
+#include "../squirrel_helper.hpp"
 #include "../../core/ring_buffer_queue.hpp"
 
 #include "../../safeguards.h"
@@ -61,6 +62,33 @@ struct ScriptEventData {
 	return e;
 }
 
+/* static */ SQInteger ScriptEventController::GetNextEvents(HSQUIRRELVM vm)
+{
+	if (sq_gettop(vm) - 1 != 1) return sq_throwerror(vm, "wrong number of parameters");
+
+	SQInteger max_events;
+	if (sq_gettype(vm, 2) != OT_INTEGER || SQ_FAILED(sq_getinteger(vm, 2, &max_events))) {
+		return sq_throwerror(vm, "ScriptEventController::GetNextEvents requires an integer as first parameter.");
+	}
+
+	if (ScriptObject::GetEventPointer() == nullptr) ScriptEventController::CreateEventPointer();
+	ScriptEventData *data = (ScriptEventData *)ScriptObject::GetEventPointer();
+
+	sq_newarray(vm, 0);
+	for (SQInteger i = 0; i < max_events && !data->stack.empty(); i++) {
+		ScriptEvent *e = data->stack.front();
+		data->stack.pop();
+
+		/* Like GetNextEvent, the reference held by the queue is handed over to the script. */
+		if (!Squirrel::CreateClassInstanceVM(vm, "Event", e, nullptr, SQConvert::DefSQDestructorCallback<ScriptEvent>, true)) {
+			e->Release();
+			return sq_throwerror(vm, "ScriptEventController::GetNextEvents failed to create an event instance.");
+		}
+		sq_arrayappend(vm, -2);
+	}
+	return 1;
+}
+
 /* static */ void ScriptEventController::InsertEvent(ScriptEvent *event)
 {
 	if (ScriptObject::GetEventPointer() == nullptr) ScriptEventController::CreateEventPointer();
@@ -100,6 +100,22 @@ public:
 	 */
 	static ScriptEvent *GetNextEvent();
 
+#ifndef DOXYGEN_API
+	/**
+	 * Internal representation of the GetNextEvents function.
+	 */
+	static SQInteger GetNextEvents(HSQUIRRELVM vm);
+#else
+	/**
+	 * Get multiple events at once.
+	 * This gives the same events as calling GetNextEvent until no event is waiting,
+	 *  but costs a single call, which helps scripts that receive many events.
+	 * @param max_events The maximum number of events to get.
+	 * @return An array of at most max_events events, which is empty when no event is waiting.
+	 */
+	static Array GetNextEvents(SQInteger max_events);
+#endif /* DOXYGEN_API */
+
 	/**
 	 * Insert an event to the queue for the company.
 	 * @param event The event to insert.
@@ -1002,6 +1002,24 @@ SQInteger ScriptList::_nexti(HSQUIRRELVM vm)
 	return 1;
 }
 
+/**
+ * Give all items a value computed by a native function.
+ * This is the counterpart of #Valuate for the built-in valuators, which do not have to call into the VM for every item.
+ * @param valuator The function giving the value of an item.
+ * @param param The parameter to pass to the valuator, after the item.
+ */
+void ScriptList::ValuateNative(ValuatorFunction *valuator, SQInteger param)
+{
+	this->modifications++;
+
+	for (ScriptListMap::iterator iter = this->items.begin(); iter != this->items.end(); ++iter) {
+		this->SetIterValue(iter, valuator(iter->first, param));
+	}
+
+	/* Charge one opcode per item, so scripts still pay for very large lists. */
+	ScriptController::DecreaseOps((int)std::min<size_t>(this->items.size(), INT_MAX));
+}
+
 SQInteger ScriptList::Valuate(HSQUIRRELVM vm)
 {
 	this->modifications++;
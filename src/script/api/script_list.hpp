@@ -55,6 +55,12 @@ private:
 	ScriptListMap::iterator RemoveIter(ScriptListMap::iterator item_iter);
 	ScriptListValueSet::iterator RemoveValueIter(ScriptListValueSet::iterator value_iter);
 
+protected:
+	/** Function giving the value of an item for #ValuateNative. */
+	typedef SQInteger ValuatorFunction(SQInteger item, SQInteger param);
+
+	void ValuateNative(ValuatorFunction *valuator, SQInteger param = 0);
+
 public:
 	ScriptListMap items;       ///< The items in the list
 	ScriptListValueSet values; ///< The items in the list, sorted by value
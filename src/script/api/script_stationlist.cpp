@@ -12,6 +12,7 @@
 #include "script_vehicle.hpp"
 #include "script_cargo.hpp"
 #include "../../station_base.h"
+#include "../../station_kdtree.h"
 #include "../../vehicle_base.h"
 
 #include "../../safeguards.h"
@@ -24,6 +25,20 @@ ScriptStationList::ScriptStationList(ScriptStation::StationType station_type)
 	}
 }
 
+ScriptStationList_InRadius::ScriptStationList_InRadius(ScriptStation::StationType station_type, TileIndex tile, SQInteger radius)
+{
+	EnforceDeityOrCompanyModeValid_Void();
+	if (!::IsValidTile(tile) || radius < 0) return;
+
+	const uint r = (uint)std::min<SQInteger>(radius, MapSizeX() + MapSizeY());
+	ForAllStationsRadius(tile, r, [&](const Station *st) {
+		if ((st->owner == ScriptObject::GetCompany() || ScriptCompanyMode::IsDeity()) && (st->facilities & station_type) != 0) {
+			const uint distance = DistanceManhattan(tile, st->xy);
+			if (distance <= r) this->AddItem(st->index, distance);
+		}
+	});
+}
+
 ScriptStationList_Vehicle::ScriptStationList_Vehicle(VehicleID vehicle_id)
 {
 	if (!ScriptVehicle::IsPrimaryVehicle(vehicle_id)) return;
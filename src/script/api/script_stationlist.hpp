@@ -26,6 +26,25 @@ public:
 	ScriptStationList(ScriptStation::StationType station_type);
 };
 
+/**
+ * Creates a list of stations of which you are the owner, whose sign is within a Manhattan distance of a tile.
+ * The value of each station is the Manhattan distance of its sign to the tile.
+ * This is much faster than valuating a ScriptStationList by distance, as the stations are looked up by their location.
+ * @api ai game
+ * @ingroup ScriptList
+ */
+class ScriptStationList_InRadius : public ScriptList {
+public:
+	/**
+	 * @param station_type The type of station to make a list of stations for.
+	 * @param tile The tile to search around.
+	 * @param radius The maximum Manhattan distance between the tile and the sign of a station.
+	 * @pre ScriptMap::IsValidTile(tile).
+	 * @pre radius >= 0.
+	 */
+	ScriptStationList_InRadius(ScriptStation::StationType station_type, TileIndex tile, SQInteger radius);
+};
+
 /**
  * Creates a list of stations associated with cargo at a station. This is very generic. Use the
  * subclasses for all practical purposes.
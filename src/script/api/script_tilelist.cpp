@@ -10,6 +10,7 @@
 #include "../../stdafx.h"
 #include "script_tilelist.hpp"
 #include "script_industry.hpp"
+#include "script_tile.hpp"
 #include "../../industry.h"
 #include "../../station_base.h"
 
@@ -47,6 +48,21 @@ void ScriptTileList::RemoveTile(TileIndex tile)
 	this->RemoveItem(tile);
 }
 
+void ScriptTileList::ValuateDistanceManhattanToTile(TileIndex tile)
+{
+	this->ValuateNative([](SQInteger item, SQInteger param) { return ScriptTile::GetDistanceManhattanToTile((TileIndex)item, (TileIndex)param); }, tile);
+}
+
+void ScriptTileList::ValuateDistanceSquareToTile(TileIndex tile)
+{
+	this->ValuateNative([](SQInteger item, SQInteger param) { return ScriptTile::GetDistanceSquareToTile((TileIndex)item, (TileIndex)param); }, tile);
+}
+
+void ScriptTileList::ValuateBuildable()
+{
+	this->ValuateNative([](SQInteger item, SQInteger) -> SQInteger { return ScriptTile::IsBuildable((TileIndex)item) ? 1 : 0; });
+}
+
 /**
  * Helper to get list of tiles that will cover an industry's production or acceptance.
  * @param i Industry in question
@@ -51,6 +51,29 @@ public:
 	 * @pre ScriptMap::IsValidTile(tile).
 	 */
 	void RemoveTile(TileIndex tile);
+
+	/**
+	 * Give all tiles their Manhattan distance to the given tile as value.
+	 * This gives the same values as Valuate(ScriptTile.GetDistanceManhattanToTile, tile),
+	 *  but does not call into the script for every tile.
+	 * @param tile The tile to get the distance to.
+	 */
+	void ValuateDistanceManhattanToTile(TileIndex tile);
+
+	/**
+	 * Give all tiles their square distance to the given tile as value.
+	 * This gives the same values as Valuate(ScriptTile.GetDistanceSquareToTile, tile),
+	 *  but does not call into the script for every tile.
+	 * @param tile The tile to get the distance to.
+	 */
+	void ValuateDistanceSquareToTile(TileIndex tile);
+
+	/**
+	 * Give all tiles the value 1 when they are buildable, and 0 otherwise.
+	 * This gives the same values as Valuate(ScriptTile.IsBuildable),
+	 *  but does not call into the script for every tile.
+	 */
+	void ValuateBuildable();
 };
 
 /**
@@ -10,6 +10,7 @@
 #include "../../stdafx.h"
 #include "script_townlist.hpp"
 #include "../../town.h"
+#include "../../town_kdtree.h"
 
 #include "../../safeguards.h"
 
@@ -20,6 +21,22 @@ ScriptTownList::ScriptTownList()
 	}
 }
 
+ScriptTownList_InRadius::ScriptTownList_InRadius(TileIndex tile, SQInteger radius)
+{
+	if (!::IsValidTile(tile) || radius < 0) return;
+
+	const uint r = (uint)std::min<SQInteger>(radius, MapSizeX() + MapSizeY());
+	const uint x1 = (uint)std::max<int>(0, (int)TileX(tile) - (int)r);
+	const uint y1 = (uint)std::max<int>(0, (int)TileY(tile) - (int)r);
+	const uint x2 = std::min<uint>(TileX(tile) + r + 1, MapSizeX());
+	const uint y2 = std::min<uint>(TileY(tile) + r + 1, MapSizeY());
+
+	_town_kdtree.FindContained(x1, y1, x2, y2, [&](TownID id) {
+		const uint distance = DistanceManhattan(tile, Town::Get(id)->xy);
+		if (distance <= r) this->AddItem(id, distance);
+	});
+}
+
 ScriptTownEffectList::ScriptTownEffectList()
 {
 	for (int i = TE_BEGIN; i < TE_END; i++) {
@@ -22,6 +22,24 @@ public:
 	ScriptTownList();
 };
 
+/**
+ * Creates a list of towns whose centre is within a Manhattan distance of a tile.
+ * The value of each town is its Manhattan distance to the tile.
+ * This is much faster than valuating a ScriptTownList by distance, as the towns are looked up by their location.
+ * @api ai game
+ * @ingroup ScriptList
+ */
+class ScriptTownList_InRadius : public ScriptList {
+public:
+	/**
+	 * @param tile The tile to search around.
+	 * @param radius The maximum Manhattan distance between the tile and the centre of a town.
+	 * @pre ScriptMap::IsValidTile(tile).
+	 * @pre radius >= 0.
+	 */
+	ScriptTownList_InRadius(TileIndex tile, SQInteger radius);
+};
+
 /**
  * Creates a list of all TownEffects known in the game.
  * @api ai game
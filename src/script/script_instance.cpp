@@ -18,6 +18,7 @@
 #include "script_storage.hpp"
 #include "script_info.hpp"
 #include "script_instance.hpp"
+#include "script_profiling.hpp"
 
 #include "api/script_controller.hpp"
 #include "api/script_error.hpp"
@@ -31,6 +32,9 @@
 
 #include "../core/format.hpp"
 
+#include <chrono>
+#include <unordered_map>
+
 #include "../safeguards.h"
 
 ScriptStorage::~ScriptStorage()
@@ -289,13 +293,23 @@ void ScriptInstance::GameLoop()
 		this->engine->ResumeError();
 		this->Died();
 	}
+
+	if (_script_sample_profiler.active && !this->is_dead && this->engine->IsSuspended()) _script_sample_profiler.Record(this->engine);
 }
 
 void ScriptInstance::CollectGarbage()
 {
 	if (this->is_started && !this->IsDead()) {
 		ScriptObject::ActiveInstance active(this);
+
+		const size_t heap_before = this->engine->GetAllocatedMemory();
+		const auto start = std::chrono::steady_clock::now();
 		this->engine->CollectGarbage();
+		const auto duration = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+
+		/* Collection of large heaps can take long enough to be felt, so make it visible for script authors. */
+		DEBUG(script, duration.count() >= 1000 ? 1 : 3, "Garbage collection of script of company %d took " OTTD_PRINTF64 " us, heap " PRINTF_SIZE " -> " PRINTF_SIZE " bytes",
+				(int)_current_company, (int64)duration.count(), heap_before, this->engine->GetAllocatedMemory());
 	}
 }
 
@@ -376,8 +390,22 @@ ScriptLogTypes::LogData &ScriptInstance::GetLogData()
  *             SQSL_ARRAY_TABLE_END.
  *  - bool:    A single byte with value 1 representing true and 0 false.
  *  - null:    No data.
+ *  - integer array: An array of which all elements are integers, stored as the
+ *             number of elements (uint32) followed by the elements (int64).
+ *             It is loaded as an array.
+ *  - string reference: A string which is equal to an earlier saved string of
+ *             at least SCRIPT_STRING_REF_MIN_LENGTH bytes, stored as the index
+ *             (uint32) of that string, counting the saved strings of at least
+ *             that length in the order they were saved.
+ * The integer array and the string reference are only used since XSLFI_SCRIPT_COMPACT_DATA.
  */
 
+/** Smallest string length, including the terminating '\0', which is saved as a reference when it is repeated. */
+static const size_t SCRIPT_STRING_REF_MIN_LENGTH = 4;
+
+static std::unordered_map<std::string, uint32> _script_save_strings; ///< Strings which can be referred to in the script data being saved.
+static std::vector<std::string> _script_load_strings;                ///< Strings which can be referred to in the script data being loaded.
+
 /* static */ bool ScriptInstance::SaveObject(HSQUIRRELVM vm, SQInteger index, int max_depth)
 {
 	if (max_depth == 0) {
@@ -396,7 +424,6 @@ ScriptLogTypes::LogData &ScriptInstance::GetLogData()
 		}
 
 		case OT_STRING: {
-			SlWriteByte(SQSL_STRING);
 			const SQChar *buf;
 			sq_getstring(vm, index, &buf);
 			size_t len = strlen(buf) + 1;
@@ -404,12 +431,44 @@ ScriptLogTypes::LogData &ScriptInstance::GetLogData()
 				ScriptLog::Error("Maximum string length is 254 chars. No data saved.");
 				return false;
 			}
+			if (len >= SCRIPT_STRING_REF_MIN_LENGTH) {
+				auto res = _script_save_strings.try_emplace(buf, (uint32)_script_save_strings.size());
+				if (!res.second) {
+					SlWriteByte(SQSL_STRING_REF);
+					SlWriteUint32(res.first->second);
+					return true;
+				}
+			}
+			SlWriteByte(SQSL_STRING);
 			SlWriteByte((byte)len);
 			SlArray(const_cast<char *>(buf), len, SLE_CHAR);
 			return true;
 		}
 
 		case OT_ARRAY: {
+			/* Arrays of only integers, such as lists of tiles or IDs, are stored without a type per element. */
+			std::vector<int64> values;
+			bool only_integers = true;
+			sq_pushnull(vm);
+			while (SQ_SUCCEEDED(sq_next(vm, index - 1))) {
+				if (sq_gettype(vm, -1) != OT_INTEGER) {
+					only_integers = false;
+					sq_pop(vm, 2);
+					break;
+				}
+				SQInteger value;
+				sq_getinteger(vm, -1, &value);
+				values.push_back((int64)value);
+				sq_pop(vm, 2);
+			}
+			sq_pop(vm, 1);
+			if (only_integers && !values.empty()) {
+				SlWriteByte(SQSL_INT_ARRAY);
+				SlWriteUint32((uint32)values.size());
+				SlArray(values.data(), values.size(), SLE_INT64);
+				return true;
+			}
+
 			SlWriteByte(SQSL_ARRAY);
 			sq_pushnull(vm);
 			while (SQ_SUCCEEDED(sq_next(vm, index - 1))) {
@@ -478,6 +537,7 @@ void ScriptInstance::Save()
 	}
 
 	HSQUIRRELVM vm = this->engine->GetVM();
+	_script_save_strings.clear();
 	if (this->is_save_data_on_stack) {
 		SlWriteByte(1);
 		/* Save the data that was just loaded. */
@@ -570,7 +630,30 @@ bool ScriptInstance::IsPaused()
 			byte len = SlReadByte();
 			static char buf[std::numeric_limits<decltype(len)>::max()];
 			SlArray(buf, len, SLE_CHAR);
-			if (data != nullptr) data->push_back(StrMakeValid(std::string_view(buf, len)));
+			std::string str = StrMakeValid(std::string_view(buf, len));
+			if (len >= SCRIPT_STRING_REF_MIN_LENGTH && SlXvIsFeaturePresent(XSLFI_SCRIPT_COMPACT_DATA)) _script_load_strings.push_back(str);
+			if (data != nullptr) data->push_back(std::move(str));
+			return true;
+		}
+
+		case SQSL_STRING_REF: {
+			if (SlXvIsFeatureMissing(XSLFI_SCRIPT_COMPACT_DATA)) SlErrorCorrupt("Invalid script data type");
+			uint32 ref = SlReadUint32();
+			if (ref >= _script_load_strings.size()) SlErrorCorrupt("Invalid script string reference");
+			if (data != nullptr) data->push_back(_script_load_strings[ref]);
+			return true;
+		}
+
+		case SQSL_INT_ARRAY: {
+			if (SlXvIsFeatureMissing(XSLFI_SCRIPT_COMPACT_DATA)) SlErrorCorrupt("Invalid script data type");
+			std::vector<int64> values(SlReadUint32());
+			SlArray(values.data(), values.size(), SLE_INT64);
+			if (data != nullptr) {
+				/* Load it as a plain array, so the data does not need to be handled differently when it is put on the stack. */
+				data->push_back(SQSL_ARRAY);
+				for (int64 value : values) data->push_back((SQInteger)value);
+				data->push_back(SQSL_ARRAY_TABLE_END);
+			}
 			return true;
 		}
 
@@ -660,7 +743,9 @@ bool ScriptInstance::IsPaused()
 	/* Check if there was anything saved at all. */
 	if (sl_byte == 0) return;
 
+	_script_load_strings.clear();
 	LoadObjects(nullptr);
+	_script_load_strings.clear();
 }
 
 /* static */ ScriptInstance::ScriptData *ScriptInstance::Load(int version)
@@ -676,7 +761,9 @@ bool ScriptInstance::IsPaused()
 
 	ScriptData *data = new ScriptData();
 	data->push_back((SQInteger)version);
+	_script_load_strings.clear();
 	LoadObjects(data);
+	_script_load_strings.clear();
 	return data;
 }
 
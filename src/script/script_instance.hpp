@@ -34,6 +34,8 @@ private:
 		SQSL_TABLE           = 0x03, ///< The following data is an table.
 		SQSL_BOOL            = 0x04, ///< The following data is a boolean.
 		SQSL_NULL            = 0x05, ///< A null variable.
+		SQSL_INT_ARRAY       = 0x06, ///< The following data is an array of only integers.
+		SQSL_STRING_REF      = 0x07, ///< The following data is a reference to a string which was saved before.
 		SQSL_ARRAY_TABLE_END = 0xFF, ///< Marks the end of an array or table, no data follows.
 	};
 
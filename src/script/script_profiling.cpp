@@ -0,0 +1,125 @@
+/*
+ * This file is part of OpenTTD.
+ * OpenTTD is free software; you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 2.
+ * OpenTTD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with OpenTTD. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file script_profiling.cpp Sampling profiler of the scripts. */
+
+#include "../stdafx.h"
+#include "script_profiling.hpp"
+#include "squirrel.hpp"
+#include "../company_base.h"
+#include "../company_func.h"
+#include "../date_func.h"
+#include "../fileio_func.h"
+#include "../string_func.h"
+#include "../console_func.h"
+#include "../walltime_func.h"
+#include "../ai/ai_info.hpp"
+
+#include <algorithm>
+#include <vector>
+
+#include "../safeguards.h"
+
+ScriptSampleProfiler _script_sample_profiler;
+
+/**
+ * Start sampling all scripts, discarding the previous samples.
+ */
+void ScriptSampleProfiler::Start()
+{
+	this->active = true;
+	this->samples = 0;
+	this->start_tick = _tick_counter;
+	this->stacks.clear();
+}
+
+/**
+ * Stop sampling, the collected samples are kept.
+ */
+void ScriptSampleProfiler::Stop()
+{
+	this->active = false;
+}
+
+/**
+ * Record the call stack of a script which just suspended.
+ * The script is identified by the current company: an AI, or the game script for #OWNER_DEITY.
+ * @param engine The VM of the script.
+ */
+void ScriptSampleProfiler::Record(Squirrel *engine)
+{
+	char buffer[64];
+	const Company *c = Company::GetIfValid(_current_company);
+	if (c != nullptr && c->ai_info != nullptr) {
+		seprintf(buffer, lastof(buffer), "AI %u (%s);", (uint)c->index, c->ai_info->GetName().c_str());
+	} else {
+		strecpy(buffer, "GS;", lastof(buffer));
+	}
+
+	this->stacks[buffer + engine->GetFoldedCallStack()]++;
+	this->samples++;
+}
+
+/**
+ * Print the functions in which the scripts were suspended most often to the console.
+ * @param count Maximum number of entries to print.
+ */
+void ScriptSampleProfiler::PrintSummary(uint count) const
+{
+	/* Aggregate over the call stacks, keeping only the script and the innermost call. */
+	std::unordered_map<std::string, uint64> totals;
+	for (const auto &it : this->stacks) {
+		const size_t script_end = it.first.find(';');
+		const size_t leaf_start = it.first.rfind(';');
+		totals[it.first.substr(0, script_end) + ": " + it.first.substr(leaf_start + 1)] += it.second;
+	}
+
+	std::vector<std::pair<std::string, uint64>> entries(totals.begin(), totals.end());
+	count = std::min<uint>(count, (uint)entries.size());
+	std::partial_sort(entries.begin(), entries.begin() + count, entries.end(), [](const auto &a, const auto &b) {
+		if (a.second != b.second) return a.second > b.second;
+		return a.first < b.first;
+	});
+
+	IConsolePrintF(CC_DEBUG, OTTD_PRINTF64U " samples over " OTTD_PRINTF64U " ticks", this->samples, _tick_counter - this->start_tick);
+	for (uint i = 0; i < count; i++) {
+		IConsolePrintF(CC_DEBUG, "  %2u: %s: " OTTD_PRINTF64U " samples (%u%%)", i + 1, entries[i].first.c_str(), entries[i].second,
+				this->samples > 0 ? (uint)(entries[i].second * 100 / this->samples) : 0);
+	}
+}
+
+/**
+ * Write the samples as folded stacks, with the number of samples as the value of each stack.
+ * @param filename Name of the file to write.
+ * @return True iff the file was written.
+ */
+bool ScriptSampleProfiler::WriteFoldedStacks(const std::string &filename) const
+{
+	FILE *f = FioFOpenFile(filename, "wt", Subdirectory::NO_DIRECTORY);
+	if (f == nullptr) return false;
+	FileCloser fcloser(f);
+
+	for (const auto &it : this->stacks) {
+		fprintf(f, "%s " OTTD_PRINTF64U "\n", it.first.c_str(), it.second);
+	}
+	return true;
+}
+
+/**
+ * Get name of the file that will be written.
+ * @return File name of the folded stacks output file.
+ */
+std::string ScriptSampleProfiler::GetOutputFilename() const
+{
+	char timestamp[16] = {};
+	LocalTime::Format(timestamp, lastof(timestamp), "%Y%m%d-%H%M");
+
+	char filepath[MAX_PATH] = {};
+	seprintf(filepath, lastof(filepath), "%sscriptprofile-%s-sampled.folded", FiosGetScreenshotDir(), timestamp);
+
+	return std::string(filepath);
+}
@@ -0,0 +1,42 @@
+/*
+ * This file is part of OpenTTD.
+ * OpenTTD is free software; you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 2.
+ * OpenTTD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with OpenTTD. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file script_profiling.hpp Sampling profiler of the scripts. */
+
+#ifndef SCRIPT_PROFILING_HPP
+#define SCRIPT_PROFILING_HPP
+
+#include "../stdafx.h"
+
+#include <string>
+#include <unordered_map>
+
+class Squirrel;
+
+/**
+ * Sampling profiler across all running scripts.
+ * The Squirrel call stack of a script is recorded every time it suspends, which is at least once per game loop in
+ * which it ran. Scripts mostly suspend because their opcode budget ran out, so the samples show where the opcodes go.
+ * The result can be written as folded stacks for flame graph tools.
+ */
+struct ScriptSampleProfiler {
+	bool active = false;                             ///< Whether samples are being recorded.
+	uint64 samples = 0;                              ///< Number of samples taken.
+	uint64 start_tick = 0;                           ///< Tick number sampling was started on.
+	std::unordered_map<std::string, uint64> stacks;  ///< Number of samples per folded stack.
+
+	void Start();
+	void Stop();
+	void Record(Squirrel *engine);
+	void PrintSummary(uint count) const;
+	bool WriteFoldedStacks(const std::string &filename) const;
+	std::string GetOutputFilename() const;
+};
+
+extern ScriptSampleProfiler _script_sample_profiler;
+
+#endif /* SCRIPT_PROFILING_HPP */
@@ -49,10 +49,91 @@ struct ScriptAllocator {
 
 	static const size_t SAFE_LIMIT = 0x8000000; ///< 128 MiB, a safe choice for almost any situation
 
+	/*
+	 * Scripts allocate and free huge numbers of small tables, arrays and strings. Freed small blocks are
+	 * kept in free lists per size class, so they can be handed out again without going to the system
+	 * allocator. The free blocks do not count towards the allocation limit, as they are not in use.
+	 */
+	static const size_t POOL_GRANULARITY = 16;   ///< Difference in size between consecutive size classes.
+	static const size_t POOL_MAX_SIZE = 256;     ///< Largest allocation which is served from the free lists.
+	static const uint POOL_MAX_FREE_BLOCKS = 1024; ///< Maximum number of free blocks kept per size class.
+	static const size_t POOL_SIZE_CLASSES = POOL_MAX_SIZE / POOL_GRANULARITY;
+
+	/** A free block in one of the free lists. */
+	struct FreeBlock {
+		FreeBlock *next; ///< Next free block of the same size class.
+	};
+
+	FreeBlock *free_blocks[POOL_SIZE_CLASSES] = {}; ///< Free lists, per size class.
+	uint free_block_count[POOL_SIZE_CLASSES] = {};  ///< Number of blocks in each free list.
+
 #ifdef SCRIPT_DEBUG_ALLOCATIONS
 	std::map<void *, size_t> allocations;
 #endif
 
+	/** Whether allocations of \a size bytes are served from the free lists. */
+	static inline bool IsPooledSize(size_t size)
+	{
+		return size != 0 && size <= POOL_MAX_SIZE;
+	}
+
+	/** Get the size class of a pooled allocation of \a size bytes. */
+	static inline size_t GetSizeClass(size_t size)
+	{
+		return (size - 1) / POOL_GRANULARITY;
+	}
+
+	/**
+	 * Get a block of memory, from the free lists when possible.
+	 * @param size The requested size.
+	 * @return The block, or nullptr if the system allocator failed.
+	 */
+	void *AllocateBlock(size_t size)
+	{
+		if (!IsPooledSize(size)) return malloc(size);
+
+		size_t size_class = GetSizeClass(size);
+		FreeBlock *block = this->free_blocks[size_class];
+		if (block == nullptr) return malloc((size_class + 1) * POOL_GRANULARITY);
+
+		this->free_blocks[size_class] = block->next;
+		this->free_block_count[size_class]--;
+		return block;
+	}
+
+	/**
+	 * Give a block of memory back, to the free lists when possible.
+	 * @param p The block.
+	 * @param size The size it was allocated with.
+	 */
+	void ReleaseBlock(void *p, size_t size)
+	{
+		if (IsPooledSize(size)) {
+			size_t size_class = GetSizeClass(size);
+			if (this->free_block_count[size_class] < POOL_MAX_FREE_BLOCKS) {
+				FreeBlock *block = static_cast<FreeBlock *>(p);
+				block->next = this->free_blocks[size_class];
+				this->free_blocks[size_class] = block;
+				this->free_block_count[size_class]++;
+				return;
+			}
+		}
+		free(p);
+	}
+
+	/** Return all blocks in the free lists to the system allocator. */
+	void ClearFreeBlocks()
+	{
+		for (size_t i = 0; i < POOL_SIZE_CLASSES; i++) {
+			while (this->free_blocks[i] != nullptr) {
+				FreeBlock *next = this->free_blocks[i]->next;
+				free(this->free_blocks[i]);
+				this->free_blocks[i] = next;
+			}
+			this->free_block_count[i] = 0;
+		}
+	}
+
 	void CheckLimit() const
 	{
 		if (this->allocated_size > this->allocation_limit) throw Script_FatalError("Maximum memory allocation exceeded");
@@ -101,7 +182,7 @@ struct ScriptAllocator {
 
 	void *Malloc(SQUnsignedInteger size)
 	{
-		void *p = malloc(size);
+		void *p = this->AllocateBlock(size);
 
 		this->CheckAllocation(size, p);
 
@@ -130,17 +211,28 @@ struct ScriptAllocator {
 		assert(this->allocations[p] == oldsize);
 		this->allocations.erase(p);
 #endif
+		/* A pooled block is already large enough for any size in its size class. */
+		if (IsPooledSize(oldsize) && IsPooledSize(size) && GetSizeClass(oldsize) == GetSizeClass(size) &&
+				(size <= oldsize || this->allocated_size + (size - oldsize) <= this->allocation_limit)) {
+			this->allocated_size -= oldsize;
+			this->allocated_size += size;
+#ifdef SCRIPT_DEBUG_ALLOCATIONS
+			this->allocations[p] = size;
+#endif
+			return p;
+		}
+
 		/* Can't use realloc directly because memory limit check.
 		 * If memory exception is thrown, the old pointer is expected
 		 * to be valid for engine cleanup.
 		 */
-		void *new_p = malloc(size);
+		void *new_p = this->AllocateBlock(size);
 
 		this->CheckAllocation(size - oldsize, new_p);
 
 		/* Memory limit test passed, we can copy data and free old pointer. */
 		memcpy(new_p, p, std::min(oldsize, size));
-		free(p);
+		this->ReleaseBlock(p, oldsize);
 
 		this->allocated_size -= oldsize;
 		this->allocated_size += size;
@@ -157,7 +249,7 @@ struct ScriptAllocator {
 	void Free(void *p, SQUnsignedInteger size)
 	{
 		if (p == nullptr) return;
-		free(p);
+		this->ReleaseBlock(p, size);
 		this->allocated_size -= size;
 
 #ifdef SCRIPT_DEBUG_ALLOCATIONS
@@ -179,6 +271,7 @@ struct ScriptAllocator {
 #ifdef SCRIPT_DEBUG_ALLOCATIONS
 		assert(this->allocations.empty());
 #endif
+		this->ClearFreeBlocks();
 	}
 };
 
@@ -784,6 +877,9 @@ void Squirrel::Uninitialize()
 
 	assert(this->allocator->allocated_size == 0);
 
+	/* Nothing is in use anymore, so do not hold on to the free blocks. */
+	this->allocator->ClearFreeBlocks();
+
 	/* Reset memory allocation errors. */
 	this->allocator->error_thrown = false;
 }
@@ -846,3 +942,26 @@ SQInteger Squirrel::GetOpsTillSuspend()
 {
 	return this->vm->_ops_till_suspend;
 }
+
+std::string Squirrel::GetFoldedCallStack()
+{
+	SQStackInfos si;
+	SQInteger levels = 0;
+	while (SQ_SUCCEEDED(sq_stackinfos(this->vm, levels, &si))) levels++;
+
+	/* Level 0 is the innermost call, but folded stacks start at the outermost one. */
+	std::string result;
+	char buffer[32];
+	for (SQInteger level = levels - 1; level >= 0; level--) {
+		sq_stackinfos(this->vm, level, &si);
+		if (!result.empty()) result += ';';
+		result += si.funcname != nullptr ? si.funcname : "unknown";
+		if (si.line >= 0) {
+			result += '@';
+			result += si.source != nullptr ? si.source : "unknown";
+			seprintf(buffer, lastof(buffer), ":" OTTD_PRINTF64, (int64)si.line);
+			result += buffer;
+		}
+	}
+	return result;
+}
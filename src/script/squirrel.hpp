@@ -11,6 +11,7 @@
 #define SQUIRREL_HPP
 
 #include <squirrel.h>
+#include <string>
 
 /** The type of script we're working with, i.e. for who is it? */
 enum class ScriptType {
@@ -271,6 +272,11 @@ public:
 	 */
 	SQInteger GetOpsTillSuspend();
 
+	/**
+	 * Get the current call stack of the script, as a folded stack from the outermost to the innermost call.
+	 */
+	std::string GetFoldedCallStack();
+
 	/**
 	 * Completely reset the engine; start from scratch.
 	 */
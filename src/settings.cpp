@@ -89,12 +89,16 @@
 #endif
 
 #include "sl/saveload.h"
+#include "pathfinder/water_regions.h"
+#include "worker_thread.h"
+#include "3rdparty/cpp-btree/btree_map.h"
 
 #include "table/strings.h"
 #include "table/settings.h"
 #include "table/settings_compat.h"
 
 #include <algorithm>
+#include <unordered_map>
 #include <vector>
 
 #include "safeguards.h"
@@ -683,10 +687,42 @@ static const char *GetSettingConfigName(const SettingDesc &sd)
  * @param object pointer to the object been loaded
  * @param only_startup load only the startup settings set
  */
+/**
+ * Lookup of the groups and items of an ini file by name, for loading a whole settings table from it.
+ * The first group or item of a name is found, as with IniLoadFile::GetGroup and IniGroup::GetItem.
+ * The ini file must not be modified while this exists.
+ */
+struct IniSettingsLookup {
+	btree::btree_map<std::string_view, const IniGroup *> groups;                                 ///< Groups by name.
+	std::unordered_map<const IniGroup *, btree::btree_map<std::string_view, const IniItem *>> items; ///< Items by name, per group, filled on first use.
+
+	IniSettingsLookup(const IniFile &ini)
+	{
+		for (const IniGroup &group : ini.groups) this->groups.insert({ group.name, &group });
+	}
+
+	const IniGroup *GetGroup(std::string_view name) const
+	{
+		auto it = this->groups.find(name);
+		return it != this->groups.end() ? it->second : nullptr;
+	}
+
+	const IniItem *GetItem(const IniGroup *group, std::string_view name)
+	{
+		auto res = this->items.try_emplace(group);
+		if (res.second) {
+			for (const IniItem &item : group->items) res.first->second.insert({ item.name, &item });
+		}
+		auto it = res.first->second.find(name);
+		return it != res.first->second.end() ? it->second : nullptr;
+	}
+};
+
 static void IniLoadSettings(IniFile &ini, const SettingTable &settings_table, const char *grpname, void *object, bool only_startup)
 {
+	IniSettingsLookup lookup(ini);
 	const IniGroup *group;
-	const IniGroup *group_def = ini.GetGroup(grpname);
+	const IniGroup *group_def = lookup.GetGroup(grpname);
 
 	for (auto &sd : settings_table) {
 		if (!SlIsObjectCurrentlyValid(sd->save.version_from, sd->save.version_to, sd->save.ext_feature_test)) continue;
@@ -697,31 +733,31 @@ static void IniLoadSettings(IniFile &ini, const SettingTable &settings_table, co
 			std::string s{ GetSettingConfigName(*sd) };
 			auto sc = s.find('.');
 			if (sc != std::string::npos) {
-				group = ini.GetGroup(s.substr(0, sc));
+				group = lookup.GetGroup(std::string_view(s).substr(0, sc));
 				s = s.substr(sc + 1);
 			} else {
 				group = group_def;
 			}
 
-			if (group != nullptr) item = group->GetItem(s);
+			if (group != nullptr) item = lookup.GetItem(group, s);
 			if (item == nullptr && group != group_def && group_def != nullptr) {
 				/* For settings.xx.yy load the settings from [settings] yy = ? in case the previous
 				 * did not exist (e.g. loading old config files with a [settings] section */
-				item = group_def->GetItem(s);
+				item = lookup.GetItem(group_def, s);
 			}
 			if (item == nullptr) {
 				/* For settings.xx.zz.yy load the settings from [zz] yy = ? in case the previous
 				 * did not exist (e.g. loading old config files with a [yapf] section */
 				sc = s.find('.');
 				if (sc != std::string::npos) {
-					if (group = ini.GetGroup(s.substr(0, sc)); group != nullptr) item = group->GetItem(s.substr(sc + 1));
+					if (group = lookup.GetGroup(std::string_view(s).substr(0, sc)); group != nullptr) item = lookup.GetItem(group, std::string_view(s).substr(sc + 1));
 				}
 			}
 			if (group != nullptr && item == nullptr && sd->guiproc != nullptr) {
 				SettingOnGuiCtrlData data;
 				data.type = SOGCT_CFG_FALLBACK_NAME;
 				if (sd->guiproc(data)) {
-					item = group->GetItem(data.str);
+					item = lookup.GetItem(group, data.str);
 				}
 			}
 		}
@@ -1002,6 +1038,7 @@ static void RedrawSmallmap(int32 new_value)
 {
 	BuildLandLegend();
 	BuildOwnerLegend();
+	InvalidateSmallMapTileColours();
 	SetWindowClassesDirty(WC_SMALLMAP);
 
 	extern void MarkAllViewportMapLandscapesDirty();
@@ -1655,10 +1692,12 @@ static void UpdateFreeformEdges(int32 new_value)
 		for (uint i = 0; i < MapMaxX(); i++) {
 			SetTileHeight(TileXY(i, 0), 0);
 			MakeSea(TileXY(i, 0));
+			InvalidateWaterRegion(TileXY(i, 0));
 		}
 		for (uint i = 0; i < MapMaxY(); i++) {
 			SetTileHeight(TileXY(0, i), 0);
 			MakeSea(TileXY(0, i));
+			InvalidateWaterRegion(TileXY(0, i));
 		}
 	}
 	MarkWholeScreenDirty();
@@ -2777,22 +2816,30 @@ void IntSettingDesc::ChangeValue(const void *object, int32 newval, SaveToConfigF
  */
 static const SettingDesc *GetSettingFromName(const char *name, const SettingTable &settings)
 {
-	/* First check all full names */
-	for (auto &sd : settings) {
-		if (!SlIsObjectCurrentlyValid(sd->save.version_from, sd->save.version_to, sd->save.ext_feature_test)) continue;
-		if (strcmp(sd->name, name) == 0) return sd.get();
-	}
+	/** Currently valid settings of a table by full name and by the shortcut variant of the name, the first one wins. */
+	struct SettingNameIndex {
+		btree::btree_map<std::string_view, const SettingDesc *> full_names;
+		btree::btree_map<std::string_view, const SettingDesc *> short_names;
+	};
+	static std::unordered_map<const void *, SettingNameIndex> indices;
 
-	/* Then check the shortcut variant of the name. */
-	for (auto &sd : settings) {
-		if (!SlIsObjectCurrentlyValid(sd->save.version_from, sd->save.version_to, sd->save.ext_feature_test)) continue;
-		const char *short_name = strchr(sd->name, '.');
-		if (short_name != nullptr) {
-			short_name++;
-			if (strcmp(short_name, name) == 0) return sd.get();
+	auto res = indices.try_emplace(settings.begin());
+	SettingNameIndex &index = res.first->second;
+	if (res.second) {
+		for (auto &sd : settings) {
+			if (!SlIsObjectCurrentlyValid(sd->save.version_from, sd->save.version_to, sd->save.ext_feature_test)) continue;
+			index.full_names.insert({ sd->name, sd.get() });
+			const char *short_name = strchr(sd->name, '.');
+			if (short_name != nullptr) index.short_names.insert({ short_name + 1, sd.get() });
 		}
 	}
 
+	/* First check all full names, then the shortcut variant of the name. */
+	auto it = index.full_names.find(name);
+	if (it != index.full_names.end()) return it->second;
+	it = index.short_names.find(name);
+	if (it != index.short_names.end()) return it->second;
+
 	return nullptr;
 }
 
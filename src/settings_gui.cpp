@@ -2237,6 +2237,7 @@ static SettingsContainer &GetSettingsTree()
 			accounting->Add(new SettingEntry("difficulty.vehicle_costs_when_stopped"));
 			accounting->Add(new SettingEntry("difficulty.construction_cost"));
 			accounting->Add(new SettingEntry("economy.payment_algorithm"));
+			accounting->Add(new SettingEntry("economy.station_cargo_merge_periods"));
 		}
 
 		SettingsPage *vehicles = main->Add(new SettingsPage(STR_CONFIG_SETTING_VEHICLES));
@@ -2271,6 +2272,8 @@ static SettingsContainer &GetSettingsTree()
 				routing->Add(new SettingEntry("pf.pathfinder_for_roadvehs"));
 				routing->Add(new SettingEntry("pf.pathfinder_for_ships"));
 				routing->Add(new SettingEntry("pf.reroute_rv_on_layout_change"));
+				routing->Add(new SettingEntry("pf.rv_shared_destination_search"));
+				routing->Add(new SettingEntry("pf.deferred_depot_search_ticks"));
 				routing->Add(new SettingEntry("vehicle.drive_through_train_depot"));
 			}
 
@@ -2441,6 +2444,7 @@ static SettingsContainer &GetSettingsTree()
 			{
 				cdist->Add(new SettingEntry("linkgraph.recalc_time"));
 				cdist->Add(new SettingEntry("linkgraph.recalc_interval"));
+				cdist->Add(new SettingEntry("linkgraph.recalc_late_delay"));
 				cdist->Add(new SettingEntry("linkgraph.distribution_pax"));
 				cdist->Add(new SettingEntry("linkgraph.distribution_mail"));
 				cdist->Add(new SettingEntry("linkgraph.distribution_armoured"));
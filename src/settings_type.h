@@ -185,6 +185,7 @@ struct GUISettings : public TimeSettings {
 	uint32 autosave_interval;                ///< how often should we do autosaves?
 	bool   autosave_realtime;                ///< autosaves based on real elapsed time (with pause handling)
 	bool   threaded_saves;                   ///< should we do threaded saves?
+	bool   fork_saves;                       ///< should dedicated servers save from a forked child process? (POSIX only)
 	bool   keep_all_autosave;                ///< name the autosave in a different way
 	bool   autosave_on_exit;                 ///< save an autosave when you quit the game, but do not ask "Do you really want to quit?"
 	bool   autosave_on_network_disconnect;   ///< save an autosave when you get disconnected from a network game with an error?
@@ -625,6 +626,8 @@ struct PathfinderSettings {
 	bool   forbid_90_deg;                    ///< forbid trains to make 90 deg turns
 	bool   back_of_one_way_pbs_waiting_point;///< whether the back of one-way PBS signals is a safe waiting point
 	uint8  reroute_rv_on_layout_change;      ///< whether to re-route road vehicles when the layout changes
+	bool   rv_shared_destination_search;     ///< whether road vehicles far from their destination station use a shared distance field instead of a search
+	uint8  deferred_depot_search_ticks;      ///< maximum number of ticks by which periodic servicing depot searches of trains and road vehicles are deferred, 0 = not deferred
 
 	bool   reverse_at_signals;               ///< whether to reverse at signals at all
 	byte   wait_oneway_signal;               ///< waitingtime in days before a oneway signal
@@ -752,11 +755,13 @@ struct EconomySettings {
 	bool disable_inflation_newgrf_flag;      ///< Disable NewGRF inflation flag
 	CargoPaymentAlgorithm payment_algorithm; ///< Cargo payment algorithm
 	TickRateMode tick_rate;                  ///< Tick rate mode
+	uint8 station_cargo_merge_periods;       ///< Maximum difference in cargo aging periods of cargo packets at stations to be merged
 };
 
 struct LinkGraphSettings {
 	uint16 recalc_time;                         ///< time (in days) for recalculating each link graph component.
 	uint16 recalc_interval;                     ///< time (in days) between subsequent checks for link graphs to be calculated.
+	uint16 recalc_late_delay;                   ///< time (in seconds) by which the join of a late link graph job is postponed, 0 to pause the game until the job is finished.
 	DistributionType distribution_pax;          ///< distribution type for passengers
 	DistributionType distribution_mail;         ///< distribution type for mail
 	DistributionType distribution_armoured;     ///< distribution type for armoured cargo class
@@ -1181,7 +1181,6 @@ CommandCost CmdBuildShip(TileIndex tile, DoCommandFlag flags, const Engine *e, V
 		v->InvalidateNewGRFCacheOfChain();
 
 		v->UpdatePosition();
-		InvalidateVehicleTickCaches();
 	}
 
 	return CommandCost();
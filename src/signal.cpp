@@ -26,6 +26,8 @@
 #include "core/checksum_func.hpp"
 #include "core/hash_func.hpp"
 #include "pathfinder/follow_track.hpp"
+#include "string_func.h"
+#include "3rdparty/robin_hood/robin_hood.h"
 
 #include "safeguards.h"
 
@@ -234,50 +236,32 @@ static Vehicle *TrainInWormholeTileEnum(Vehicle *v, void *data)
 }
 
 /**
- * Perform some operations before adding data into Todo set
- * The new and reverse direction is removed from _globset, because we are sure
- * it doesn't need to be checked again
- * Also, remove reverse direction from _tbdset
- * This is the 'core' part so the graph searching won't enter any tile twice
- *
- * @param t1 tile we are entering
- * @param d1 direction (tile side) we are entering
- * @param t2 tile we are leaving
- * @param d2 direction (tile side) we are leaving
- * @return false iff reverse direction was in Todo set
+ * Results of the wormhole train checks during the current update of the signal buffer, keyed by head tile and checked tile.
+ * All trains in a wormhole are in the vehicle hash of a tunnel/bridge head, so each check walks every wagon in the wormhole.
+ * Trains do not move while the signals are updated, so each check only has to be done once per update.
  */
-static inline bool CheckAddToTodoSet(TileIndex t1, DiagDirection d1, TileIndex t2, DiagDirection d2)
-{
-	_globset.Remove(t1, d1); // it can be in Global but not in Todo
-	_globset.Remove(t2, d2); // remove in all cases
-
-	assert(!_tbdset.IsIn(t1, d1)); // it really shouldn't be there already
-
-	return !_tbdset.Remove(t2, d2);
-}
-
+static std::vector<std::pair<uint64, bool>> _wormhole_train_results;
+static bool _wormhole_train_results_active = false; ///< Whether #_wormhole_train_results may be used.
 
 /**
- * Perform some operations before adding data into Todo set
- * The new and reverse direction is removed from Global set, because we are sure
- * it doesn't need to be checked again
- * Also, remove reverse direction from Todo set
- * This is the 'core' part so the graph searching won't enter any tile twice
- *
- * @param t1 tile we are entering
- * @param d1 direction (tile side) we are entering
- * @param t2 tile we are leaving
- * @param d2 direction (tile side) we are leaving
- * @return false iff the Todo buffer would be overrun
+ * Check whether the front or end of a train is on a tile of a tunnel/bridge.
+ * @param head Tunnel/bridge head whose vehicle hash holds the train.
+ * @param tile Tile to check.
+ * @return whether there is a train.
  */
-static inline bool MaybeAddToTodoSet(TileIndex t1, DiagDirection d1, TileIndex t2, DiagDirection d2)
+static bool IsTrainInWormholeTile(TileIndex head, TileIndex tile)
 {
-	if (!CheckAddToTodoSet(t1, d1, t2, d2)) return true;
+	if (!_wormhole_train_results_active) return HasVehicleOnPos(head, VEH_TRAIN, reinterpret_cast<void *>((uintptr_t)tile), &TrainInWormholeTileEnum);
 
-	return _tbdset.Add(t1, d1);
+	const uint64 key = (((uint64)head) << 32) | tile;
+	for (const auto &it : _wormhole_train_results) {
+		if (it.first == key) return it.second;
+	}
+	bool result = HasVehicleOnPos(head, VEH_TRAIN, reinterpret_cast<void *>((uintptr_t)tile), &TrainInWormholeTileEnum);
+	_wormhole_train_results.emplace_back(key, result);
+	return result;
 }
 
-
 /** Current signal block state flags */
 enum SigFlags {
 	SF_NONE    = 0,
@@ -305,16 +289,190 @@ struct SigInfo {
 	Trackdir out_signal_trackdir;
 };
 
+/**
+ * Steps of a signal block search which depend on more than the track layout.
+ * A search records these in order, so that a later search of the same block from the same start
+ * can be replayed without walking the track again, @see SignalSegmentTrace.
+ */
+enum SignalSegmentOpType : uint8 {
+	SSOT_TRAIN_ON_TILE,          ///< Check for a train on the tile, not in a depot
+	SSOT_TRAIN_ON_TRACK_BITS,    ///< Check for a train on the track bits in param
+	SSOT_TRAIN_IN_WORMHOLE,      ///< Check for a train on the tile, only on the ramp of tunnel/bridge data
+	SSOT_FLAGS,                  ///< Set the SigFlags in param
+	SSOT_PBS_IF_REALISTIC,       ///< Set SF_PBS when using realistic braking
+	SSOT_PBS_IF_SAFER_CROSSINGS, ///< Set SF_PBS when using safer level crossings
+	SSOT_UPDATE_SIGNAL,          ///< Add the signal at trackdir param to the set of signals to update
+	SSOT_UPDATE_PBS_SIGNAL,      ///< Add the green PBS signal at trackdir param to the set of PBS signals to update the aspect of
+	SSOT_UPDATE_PBS_TB_EXIT,     ///< Add the green PBS tunnel/bridge exit at trackdir param to the set of PBS signals to update the aspect of
+	SSOT_OUT_SIGNAL,             ///< The signal at trackdir param leaves the block
+	SSOT_OUT_TB_ENTRANCE,        ///< The tunnel/bridge entrance at trackdir param leaves the block
+	SSOT_EXIT_SIGNAL,            ///< Count the pre-signal exit at trackdir param
+	SSOT_TODO_REMOVE,            ///< Remove the sides in tile/param low nibble and data/param high nibble from the global set
+	SSOT_TODO_FULL,              ///< The set of open nodes was full
+};
+
+/** A single step of a signal block search, @see SignalSegmentOpType */
+struct SignalSegmentOp {
+	TileIndex tile;
+	uint32 data;
+	SignalSegmentOpType type;
+	uint8 param;
+};
+
+/** Steps of a signal block search, starting from a given entry of the global set */
+using SignalSegmentTrace = std::vector<SignalSegmentOp>;
+
+/** Signal block search traces by start, @see SignalSegmentCacheKey */
+static robin_hood::unordered_node_map<uint64, SignalSegmentTrace> _signal_segment_cache;
+static size_t _signal_segment_cache_ops = 0; ///< Total number of steps in _signal_segment_cache
+static const size_t SIGNAL_SEGMENT_CACHE_MAX_OPS = 1 << 21; ///< Clear _signal_segment_cache when it would hold more steps than this
+
+static inline uint8 PackTodoDirections(DiagDirection d1, DiagDirection d2)
+{
+	return (d1 & 0xF) | ((d2 & 0xF) << 4);
+}
+
+static inline DiagDirection UnpackTodoDirection(uint8 packed)
+{
+	return packed == 0xF ? INVALID_DIAGDIR : (DiagDirection)packed;
+}
+
+/**
+ * Apply one step of a signal block search.
+ * @param info signal block state to update
+ * @param op step to apply
+ * @return false iff the search has to be stopped
+ */
+static bool ApplySignalSegmentOp(SigInfo &info, const SignalSegmentOp &op)
+{
+	switch (op.type) {
+		case SSOT_TRAIN_ON_TILE:
+			if (!(info.flags & SF_TRAIN) && HasVehicleOnPos(op.tile, VEH_TRAIN, nullptr, &TrainOnTileEnum)) info.flags |= SF_TRAIN;
+			break;
+
+		case SSOT_TRAIN_ON_TRACK_BITS:
+			if (!(info.flags & SF_TRAIN) && EnsureNoTrainOnTrackBits(op.tile, (TrackBits)op.param).Failed()) info.flags |= SF_TRAIN;
+			break;
+
+		case SSOT_TRAIN_IN_WORMHOLE:
+			if (!(info.flags & SF_TRAIN) && IsTrainInWormholeTile(op.tile, op.data)) info.flags |= SF_TRAIN;
+			break;
+
+		case SSOT_FLAGS:
+			info.flags |= (SigFlags)op.param;
+			break;
+
+		case SSOT_PBS_IF_REALISTIC:
+			if (_settings_game.vehicle.train_braking_model == TBM_REALISTIC) info.flags |= SF_PBS;
+			break;
+
+		case SSOT_PBS_IF_SAFER_CROSSINGS:
+			if (_settings_game.vehicle.safer_crossings) info.flags |= SF_PBS;
+			break;
+
+		case SSOT_UPDATE_SIGNAL:
+			if (!_tbuset.Add(op.tile, (Trackdir)op.param)) {
+				info.flags |= SF_FULL;
+				return false;
+			}
+			break;
+
+		case SSOT_UPDATE_PBS_SIGNAL:
+			if (_extra_aspects > 0 && GetSignalStateByTrackdir(op.tile, (Trackdir)op.param) == SIGNAL_STATE_GREEN && !IsRailSpecialSignalAspect(op.tile, TrackdirToTrack((Trackdir)op.param))) {
+				_tbpset.Add(op.tile, (Trackdir)op.param);
+			}
+			break;
+
+		case SSOT_UPDATE_PBS_TB_EXIT:
+			if (_extra_aspects > 0 && GetTunnelBridgeExitSignalState(op.tile) == SIGNAL_STATE_GREEN) {
+				_tbpset.Add(op.tile, (Trackdir)op.param);
+			}
+			break;
+
+		case SSOT_OUT_SIGNAL:
+			if (_extra_aspects > 0) {
+				info.out_signal_tile = op.tile;
+				info.out_signal_trackdir = (Trackdir)op.param;
+				if (_settings_game.vehicle.train_braking_model == TBM_REALISTIC && GetSignalAlwaysReserveThrough(op.tile, TrackdirToTrack((Trackdir)op.param)) &&
+						GetSignalStateByTrackdir(op.tile, (Trackdir)op.param) == SIGNAL_STATE_RED) {
+					info.flags |= SF_PBS;
+				}
+			}
+			break;
+
+		case SSOT_OUT_TB_ENTRANCE:
+			if (_extra_aspects > 0) {
+				info.out_signal_tile = op.tile;
+				info.out_signal_trackdir = (Trackdir)op.param;
+			}
+			break;
+
+		case SSOT_EXIT_SIGNAL:
+			info.num_exits++;
+			if (GetSignalStateByTrackdir(op.tile, (Trackdir)op.param) == SIGNAL_STATE_GREEN) { // found green presignal exit
+				info.num_green++;
+			}
+			break;
+
+		case SSOT_TODO_REMOVE:
+			/* The new and reverse direction is removed from _globset, because we are sure it doesn't need to be checked again */
+			if (!_globset.IsEmpty()) {
+				_globset.Remove(op.tile, UnpackTodoDirection(op.param & 0xF)); // it can be in Global but not in Todo
+				_globset.Remove(op.data, UnpackTodoDirection(op.param >> 4)); // remove in all cases
+			}
+			break;
+
+		case SSOT_TODO_FULL:
+			DEBUG(misc, 0, "SignalSegment too complex. Set _tbdset is full (maximum %d)", SIG_TBD_SIZE);
+			info.flags |= SF_FULL;
+			break;
+	}
+
+	return true;
+}
+
 /**
  * Search signal block
  *
  * @param owner owner whose signals we are updating
+ * @param trace if not nullptr, the steps of the search are recorded here
  * @return SigFlags
  */
-static SigInfo ExploreSegment(Owner owner)
+static SigInfo ExploreSegment(Owner owner, SignalSegmentTrace *trace)
 {
 	SigInfo info;
 
+	auto op = [&](SignalSegmentOpType type, TileIndex tile, uint8 param, uint32 data = 0) -> bool {
+		SignalSegmentOp item{ tile, data, type, param };
+		if (trace != nullptr) trace->push_back(item);
+		return ApplySignalSegmentOp(info, item);
+	};
+
+	/*
+	 * Perform some operations before adding data into Todo set
+	 * The new and reverse direction is removed from Global set, because we are sure
+	 * it doesn't need to be checked again
+	 * Also, remove reverse direction from Todo set
+	 * This is the 'core' part so the graph searching won't enter any tile twice
+	 *
+	 * t1/d1: tile/direction (tile side) we are entering
+	 * t2/d2: tile/direction (tile side) we are leaving
+	 * Returns false iff the Todo buffer would be overrun
+	 */
+	auto maybe_add_to_todo_set = [&](TileIndex t1, DiagDirection d1, TileIndex t2, DiagDirection d2) -> bool {
+		op(SSOT_TODO_REMOVE, t1, PackTodoDirections(d1, d2), t2);
+
+		assert(!_tbdset.IsIn(t1, d1)); // it really shouldn't be there already
+
+		if (_tbdset.Remove(t2, d2)) return true;
+		if (_tbdset.IsFull()) {
+			op(SSOT_TODO_FULL, t1, 0);
+			return false;
+		}
+		_tbdset.Add(t1, d1);
+		return true;
+	};
+
 	TileIndex tile = INVALID_TILE; // Stop GCC from complaining about a possibly uninitialized variable (issue #8280).
 	DiagDirection enterdir = INVALID_DIAGDIR;
 
@@ -328,15 +486,15 @@ static SigInfo ExploreSegment(Owner owner)
 
 				if (IsRailDepot(tile)) {
 					if (enterdir == INVALID_DIAGDIR) { // from 'inside' - train just entered or left the depot
-						if (_settings_game.vehicle.train_braking_model == TBM_REALISTIC) info.flags |= SF_PBS;
-						if (!(info.flags & SF_TRAIN) && HasVehicleOnPos(tile, VEH_TRAIN, nullptr, &TrainOnTileEnum)) info.flags |= SF_TRAIN;
+						op(SSOT_PBS_IF_REALISTIC, tile, 0);
+						op(SSOT_TRAIN_ON_TILE, tile, 0);
 						exitdir = GetRailDepotDirection(tile);
 						tile += TileOffsByDiagDir(exitdir);
 						enterdir = ReverseDiagDir(exitdir);
 						break;
 					} else if (enterdir == GetRailDepotDirection(tile)) { // entered a depot
-						if (_settings_game.vehicle.train_braking_model == TBM_REALISTIC) info.flags |= SF_PBS;
-						if (!(info.flags & SF_TRAIN) && HasVehicleOnPos(tile, VEH_TRAIN, nullptr, &TrainOnTileEnum)) info.flags |= SF_TRAIN;
+						op(SSOT_PBS_IF_REALISTIC, tile, 0);
+						op(SSOT_TRAIN_ON_TILE, tile, 0);
 						continue;
 					} else {
 						continue;
@@ -350,10 +508,10 @@ static SigInfo ExploreSegment(Owner owner)
 				if (tracks == TRACK_BIT_HORZ || tracks == TRACK_BIT_VERT) { // there is exactly one incidating track, no need to check
 					tracks = tracks_masked;
 					/* If no train detected yet, and there is not no train -> there is a train -> set the flag */
-					if (!(info.flags & SF_TRAIN) && EnsureNoTrainOnTrackBits(tile, tracks).Failed()) info.flags |= SF_TRAIN;
+					op(SSOT_TRAIN_ON_TRACK_BITS, tile, tracks);
 				} else {
 					if (tracks_masked == TRACK_BIT_NONE) continue; // no incidating track
-					if (!(info.flags & SF_TRAIN) && HasVehicleOnPos(tile, VEH_TRAIN, nullptr, &TrainOnTileEnum)) info.flags |= SF_TRAIN;
+					op(SSOT_TRAIN_ON_TILE, tile, 0);
 				}
 
 				if (HasSignals(tile)) { // there is exactly one track - not zero, because there is exit from this tile
@@ -367,50 +525,32 @@ static SigInfo ExploreSegment(Owner owner)
 						 * (if it is a presignal EXIT and it changes, it will be added to 'to-be-done' set later) */
 						if (HasSignalOnTrackdir(tile, reversedir)) {
 							if (IsPbsSignalNonExtended(sig)) {
-								info.flags |= SF_PBS;
-								if (_extra_aspects > 0 && GetSignalStateByTrackdir(tile, reversedir) == SIGNAL_STATE_GREEN && !IsRailSpecialSignalAspect(tile, track)) {
-									_tbpset.Add(tile, reversedir);
-								}
-							} else if (!_tbuset.Add(tile, reversedir)) {
-								info.flags |= SF_FULL;
+								op(SSOT_FLAGS, tile, SF_PBS);
+								op(SSOT_UPDATE_PBS_SIGNAL, tile, reversedir);
+							} else if (!op(SSOT_UPDATE_SIGNAL, tile, reversedir)) {
 								return info;
 							}
 						}
 
 						if (HasSignalOnTrackdir(tile, trackdir)) {
-							if (!IsOnewaySignal(sig)) info.flags |= SF_PBS;
-							if (_extra_aspects > 0) {
-								info.out_signal_tile = tile;
-								info.out_signal_trackdir = trackdir;
-								if (_settings_game.vehicle.train_braking_model == TBM_REALISTIC && GetSignalAlwaysReserveThrough(tile, track) &&
-										GetSignalStateByTrackdir(tile, trackdir) == SIGNAL_STATE_RED) {
-									info.flags |= SF_PBS;
-								}
-							}
+							if (!IsOnewaySignal(sig)) op(SSOT_FLAGS, tile, SF_PBS);
+							op(SSOT_OUT_SIGNAL, tile, trackdir);
 
 							/* if it is a presignal EXIT in OUR direction, count it */
-							if (IsExitSignal(sig)) { // found presignal exit
-								info.num_exits++;
-								if (GetSignalStateByTrackdir(tile, trackdir) == SIGNAL_STATE_GREEN) { // found green presignal exit
-									info.num_green++;
-								}
-							}
+							if (IsExitSignal(sig)) op(SSOT_EXIT_SIGNAL, tile, trackdir);
 						}
 
 						continue;
 					}
 				} else if (!HasAtMostOneBit(tracks)) {
-					info.flags |= SF_JUNCTION;
+					op(SSOT_FLAGS, tile, SF_JUNCTION);
 				}
 
 				for (DiagDirection dir = DIAGDIR_BEGIN; dir < DIAGDIR_END; dir++) { // test all possible exit directions
 					if (dir != enterdir && (tracks & _enterdir_to_trackbits[dir])) { // any track incidating?
 						TileIndex newtile = tile + TileOffsByDiagDir(dir);  // new tile to check
 						DiagDirection newdir = ReverseDiagDir(dir); // direction we are entering from
-						if (!MaybeAddToTodoSet(newtile, newdir, tile, dir)) {
-							info.flags |= SF_FULL;
-							return info;
-						}
+						if (!maybe_add_to_todo_set(newtile, newdir, tile, dir)) return info;
 					}
 				}
 
@@ -423,7 +563,7 @@ static SigInfo ExploreSegment(Owner owner)
 				if (DiagDirToAxis(enterdir) != GetRailStationAxis(tile)) continue; // different axis
 				if (IsStationTileBlocked(tile)) continue; // 'eye-candy' station tile
 
-				if (!(info.flags & SF_TRAIN) && HasVehicleOnPos(tile, VEH_TRAIN, nullptr, &TrainOnTileEnum)) info.flags |= SF_TRAIN;
+				op(SSOT_TRAIN_ON_TILE, tile, 0);
 				tile += TileOffsByDiagDir(exitdir);
 				break;
 
@@ -432,8 +572,8 @@ static SigInfo ExploreSegment(Owner owner)
 				if (!IsOneSignalBlock(owner, GetTileOwner(tile))) continue;
 				if (DiagDirToAxis(enterdir) == GetCrossingRoadAxis(tile)) continue; // different axis
 
-				if (!(info.flags & SF_TRAIN) && HasVehicleOnPos(tile, VEH_TRAIN, nullptr, &TrainOnTileEnum)) info.flags |= SF_TRAIN;
-				if (_settings_game.vehicle.safer_crossings) info.flags |= SF_PBS;
+				op(SSOT_TRAIN_ON_TILE, tile, 0);
+				op(SSOT_PBS_IF_SAFER_CROSSINGS, tile, 0);
 				tile += TileOffsByDiagDir(exitdir);
 				break;
 
@@ -447,15 +587,15 @@ static SigInfo ExploreSegment(Owner owner)
 				TrackBits tracks = GetTunnelBridgeTrackBits(tile);
 				TrackBits across_tracks = GetAcrossTunnelBridgeTrackBits(tile);
 
-				auto check_train_present = [tile, tracks, across_tracks](DiagDirection enterdir) -> bool {
+				auto check_train_present = [&](DiagDirection enterdir) {
 					if (tracks == TRACK_BIT_HORZ || tracks == TRACK_BIT_VERT) {
 						if (_enterdir_to_trackbits[enterdir] & across_tracks) {
-							return EnsureNoTrainOnTrackBits(tile, TRACK_BIT_WORMHOLE | across_tracks).Failed();
+							op(SSOT_TRAIN_ON_TRACK_BITS, tile, TRACK_BIT_WORMHOLE | across_tracks);
 						} else {
-							return EnsureNoTrainOnTrackBits(tile, tracks & (~across_tracks)).Failed();
+							op(SSOT_TRAIN_ON_TRACK_BITS, tile, tracks & (~across_tracks));
 						}
 					} else {
-						return HasVehicleOnPos(tile, VEH_TRAIN, nullptr, &TrainOnTileEnum);
+						op(SSOT_TRAIN_ON_TILE, tile, 0);
 					}
 				};
 
@@ -465,17 +605,15 @@ static SigInfo ExploreSegment(Owner owner)
 				if (IsTunnelBridgeWithSignalSimulation(tile)) {
 					if (enterdir == INVALID_DIAGDIR) {
 						// incoming from the wormhole, onto signal
-						if (!(info.flags & SF_TRAIN) && IsTunnelBridgeSignalSimulationExit(tile)) { // tunnel entrance is ignored
-							if (HasVehicleOnPos(GetOtherTunnelBridgeEnd(tile), VEH_TRAIN, reinterpret_cast<void *>((uintptr_t)tile), &TrainInWormholeTileEnum)) info.flags |= SF_TRAIN;
-							if (!(info.flags & SF_TRAIN) && HasVehicleOnPos(tile, VEH_TRAIN, reinterpret_cast<void *>((uintptr_t)tile), &TrainInWormholeTileEnum)) info.flags |= SF_TRAIN;
+						if (IsTunnelBridgeSignalSimulationExit(tile)) { // tunnel entrance is ignored
+							op(SSOT_TRAIN_IN_WORMHOLE, GetOtherTunnelBridgeEnd(tile), 0, tile);
+							op(SSOT_TRAIN_IN_WORMHOLE, tile, 0, tile);
 						}
-						if (IsTunnelBridgeSignalSimulationExit(tile) && !_tbuset.Add(tile, INVALID_TRACKDIR)) {
-							info.flags |= SF_FULL;
+						if (IsTunnelBridgeSignalSimulationExit(tile) && !op(SSOT_UPDATE_SIGNAL, tile, INVALID_TRACKDIR)) {
 							return info;
 						}
-						if (_extra_aspects > 0 && IsTunnelBridgeSignalSimulationEntrance(tile)) {
-							info.out_signal_tile = tile;
-							info.out_signal_trackdir = GetTunnelBridgeEntranceTrackdir(tile, tunnel_bridge_dir);
+						if (IsTunnelBridgeSignalSimulationEntrance(tile)) {
+							op(SSOT_OUT_TB_ENTRANCE, tile, GetTunnelBridgeEntranceTrackdir(tile, tunnel_bridge_dir));
 						}
 						Trackdir exit_track = GetTunnelBridgeExitTrackdir(tile, tunnel_bridge_dir);
 						exitdir = TrackdirToExitdir(exit_track);
@@ -486,52 +624,39 @@ static SigInfo ExploreSegment(Owner owner)
 						// NOT incoming from the wormhole!
 						if (IsTunnelBridgeSignalSimulationExit(tile)) {
 							if (IsTunnelBridgePBS(tile)) {
-								info.flags |= SF_PBS;
-								if (_extra_aspects > 0 && GetTunnelBridgeExitSignalState(tile) == SIGNAL_STATE_GREEN) {
-									Trackdir exit_td = GetTunnelBridgeExitTrackdir(tile, tunnel_bridge_dir);
-									_tbpset.Add(tile, exit_td);
-								}
-							} else if (!_tbuset.Add(tile, INVALID_TRACKDIR)) {
-								info.flags |= SF_FULL;
+								op(SSOT_FLAGS, tile, SF_PBS);
+								op(SSOT_UPDATE_PBS_TB_EXIT, tile, GetTunnelBridgeExitTrackdir(tile, tunnel_bridge_dir));
+							} else if (!op(SSOT_UPDATE_SIGNAL, tile, INVALID_TRACKDIR)) {
 								return info;
 							}
 						}
-						if (_extra_aspects > 0 && IsTunnelBridgeSignalSimulationEntrance(tile)) {
-							info.out_signal_tile = tile;
-							info.out_signal_trackdir = GetTunnelBridgeEntranceTrackdir(tile, tunnel_bridge_dir);
+						if (IsTunnelBridgeSignalSimulationEntrance(tile)) {
+							op(SSOT_OUT_TB_ENTRANCE, tile, GetTunnelBridgeEntranceTrackdir(tile, tunnel_bridge_dir));
 						}
-						if (!(info.flags & SF_TRAIN)) {
-							if (HasVehicleOnPos(tile, VEH_TRAIN, reinterpret_cast<void *>((uintptr_t)tile), &TrainInWormholeTileEnum)) info.flags |= SF_TRAIN;
-							if (!(info.flags & SF_TRAIN) && IsTunnelBridgeSignalSimulationExit(tile)) {
-								if (HasVehicleOnPos(GetOtherTunnelBridgeEnd(tile), VEH_TRAIN, reinterpret_cast<void *>((uintptr_t)tile), &TrainInWormholeTileEnum)) info.flags |= SF_TRAIN;
-							}
+						op(SSOT_TRAIN_IN_WORMHOLE, tile, 0, tile);
+						if (IsTunnelBridgeSignalSimulationExit(tile)) {
+							op(SSOT_TRAIN_IN_WORMHOLE, GetOtherTunnelBridgeEnd(tile), 0, tile);
 						}
 						continue;
 					}
 				} else if (!HasAtMostOneBit(tracks)) {
-					info.flags |= SF_JUNCTION;
+					op(SSOT_FLAGS, tile, SF_JUNCTION);
 				}
 				if (enterdir == INVALID_DIAGDIR) { // incoming from the wormhole
-					if (!(info.flags & SF_TRAIN) && check_train_present(tunnel_bridge_dir)) info.flags |= SF_TRAIN;
+					check_train_present(tunnel_bridge_dir);
 					enterdir = tunnel_bridge_dir;
 				} else if (enterdir != tunnel_bridge_dir) { // NOT incoming from the wormhole!
 					if (tracks_masked == TRACK_BIT_NONE) continue; // no incidating track
-					if (!(info.flags & SF_TRAIN) && check_train_present(enterdir)) info.flags |= SF_TRAIN;
+					check_train_present(enterdir);
 				}
 				for (DiagDirection dir = DIAGDIR_BEGIN; dir < DIAGDIR_END; dir++) { // test all possible exit directions
 					if (dir != enterdir && (tracks & _enterdir_to_trackbits[dir])) { // any track incidating?
 						if (dir == tunnel_bridge_dir) {
-							if (!MaybeAddToTodoSet(GetOtherTunnelBridgeEnd(tile), INVALID_DIAGDIR, tile, INVALID_DIAGDIR)) {
-								info.flags |= SF_FULL;
-								return info;
-							}
+							if (!maybe_add_to_todo_set(GetOtherTunnelBridgeEnd(tile), INVALID_DIAGDIR, tile, INVALID_DIAGDIR)) return info;
 						} else {
 							TileIndex newtile = tile + TileOffsByDiagDir(dir);  // new tile to check
 							DiagDirection newdir = ReverseDiagDir(dir); // direction we are entering from
-							if (!MaybeAddToTodoSet(newtile, newdir, tile, dir)) {
-								info.flags |= SF_FULL;
-								return info;
-							}
+							if (!maybe_add_to_todo_set(newtile, newdir, tile, dir)) return info;
 						}
 					}
 				}
@@ -542,14 +667,65 @@ static SigInfo ExploreSegment(Owner owner)
 				continue; // continue the while() loop
 		}
 
-		if (!MaybeAddToTodoSet(tile, enterdir, oldtile, exitdir)) {
-			info.flags |= SF_FULL;
+		maybe_add_to_todo_set(tile, enterdir, oldtile, exitdir);
+	}
+
+	return info;
+}
+
+/**
+ * Key of a signal block search in _signal_segment_cache.
+ * @param owner owner whose signals we are updating
+ * @param tile tile of the _globset entry which the search started from
+ * @param dir side of the _globset entry which the search started from
+ */
+static inline uint64 SignalSegmentCacheKey(Owner owner, TileIndex tile, DiagDirection dir)
+{
+	return ((uint64)tile << 16) | ((uint64)(dir & 0xFF) << 8) | owner;
+}
+
+/**
+ * Search signal block, replaying the steps of an earlier search from the same start if the track layout is unchanged.
+ * The result and all side effects are identical to ExploreSegment.
+ *
+ * @param owner owner whose signals we are updating
+ * @param tile tile of the _globset entry which the search starts from
+ * @param dir side of the _globset entry which the search starts from
+ * @return SigFlags
+ * @pre The start nodes of the search for this _globset entry have been added to _tbdset
+ */
+static SigInfo ExploreSegmentCached(Owner owner, TileIndex tile, DiagDirection dir)
+{
+	const uint64 key = SignalSegmentCacheKey(owner, tile, dir);
+	auto iter = _signal_segment_cache.find(key);
+	if (iter != _signal_segment_cache.end()) {
+		_tbdset.Reset();
+		SigInfo info;
+		for (const SignalSegmentOp &op : iter->second) {
+			if (!ApplySignalSegmentOp(info, op)) break;
 		}
+		return info;
 	}
 
+	SignalSegmentTrace trace;
+	SigInfo info = ExploreSegment(owner, &trace);
+	if (_signal_segment_cache_ops + trace.size() > SIGNAL_SEGMENT_CACHE_MAX_OPS) InvalidateSignalSegmentCache();
+	_signal_segment_cache_ops += trace.size();
+	trace.shrink_to_fit();
+	_signal_segment_cache[key] = std::move(trace);
 	return info;
 }
 
+/**
+ * Clear the cached signal block searches.
+ * This must be called whenever the track layout, signals, or track ownership or sharing changes.
+ */
+void InvalidateSignalSegmentCache()
+{
+	_signal_segment_cache.clear();
+	_signal_segment_cache_ops = 0;
+}
+
 static uint8 GetSignalledTunnelBridgeEntranceForwardAspect(TileIndex tile, TileIndex tile_exit)
 {
 	if (!IsTunnelBridgeSignalSimulationEntrance(tile)) return 0;
@@ -579,7 +755,14 @@ static uint8 GetSignalledTunnelBridgeEntranceForwardAspect(TileIndex tile, TileI
 	}
 }
 
-uint8 GetForwardAspectFollowingTrack(TileIndex tile, Trackdir trackdir)
+/**
+ * Get the aspect of the next signal in front of a signal, following the track and any reservation on junctions.
+ * @param tile Tile of the signal.
+ * @param trackdir Trackdir of the signal.
+ * @param next_signal If not nullptr, set to the tile and trackdir of the signal whose aspect was returned, if any.
+ * @return Aspect of the next signal, 0 if there is no (green) signal ahead.
+ */
+uint8 GetForwardAspectFollowingTrack(TileIndex tile, Trackdir trackdir, std::pair<TileIndex, Trackdir> *next_signal)
 {
 	Owner owner = GetTileOwner(tile);
 	DiagDirection exitdir = TrackdirToExitdir(trackdir);
@@ -623,6 +806,7 @@ uint8 GetForwardAspectFollowingTrack(TileIndex tile, Trackdir trackdir)
 					if (HasSignalOnTrack(tile, track)) { // now check whole track, not trackdir
 						if (HasSignalOnTrackdir(tile, trackdir)) {
 							if (GetSignalStateByTrackdir(tile, trackdir) == SIGNAL_STATE_RED) return 0;
+							if (next_signal != nullptr) *next_signal = { tile, trackdir };
 							uint8 aspect = GetSignalAspect(tile, track);
 							AdjustSignalAspectIfNonIncStyle(tile, track, aspect);
 							return aspect;
@@ -677,6 +861,7 @@ uint8 GetForwardAspectFollowingTrack(TileIndex tile, Trackdir trackdir)
 				trackdir = TrackEnterdirToTrackdir(track, ReverseDiagDir(enterdir));
 
 				if (IsTunnelBridgeWithSignalSimulation(tile) && HasTrack(GetAcrossTunnelBridgeTrackBits(tile), track)) {
+					if (next_signal != nullptr) *next_signal = { tile, trackdir };
 					return GetSignalAspectGeneric(tile, trackdir, false);
 				}
 
@@ -912,6 +1097,101 @@ static inline void ResetSets()
 }
 
 
+/**
+ * Add the start nodes of the search of a signal block to _tbdset.
+ * @param tile tile of the _globset entry
+ * @param dir side of the _globset entry
+ * @return false iff there is no interesting track at this _globset entry
+ */
+static bool AddSignalSegmentStartNodes(TileIndex tile, DiagDirection dir)
+{
+	/* After updating signal, data stored are always MP_RAILWAY with signals.
+	 * Other situations happen when data are from outside functions -
+	 * modification of railbits (including both rail building and removal),
+	 * train entering/leaving block, train leaving depot...
+	 */
+	switch (GetTileType(tile)) {
+		case MP_TUNNELBRIDGE: {
+			/* 'optimization assert' - do not try to update signals when it is not needed */
+			assert_tile(GetTunnelBridgeTransportType(tile) == TRANSPORT_RAIL, tile);
+			if (IsTunnel(tile)) assert(dir == INVALID_DIAGDIR || dir == ReverseDiagDir(GetTunnelBridgeDirection(tile)));
+			TrackBits across = GetAcrossTunnelBridgeTrackBits(tile);
+			if (dir == INVALID_DIAGDIR || _enterdir_to_trackbits[dir] & across) {
+				if (IsTunnelBridgeWithSignalSimulation(tile)) {
+					/* Don't worry about other side of tunnel. */
+					_tbdset.Add(tile, dir);
+				} else {
+					_tbdset.Add(tile, INVALID_DIAGDIR);  // we can safely start from wormhole centre
+					_tbdset.Add(GetOtherTunnelBridgeEnd(tile), INVALID_DIAGDIR);
+				}
+				return true;
+			}
+		}
+			FALLTHROUGH;
+
+		case MP_RAILWAY:
+			if (IsRailDepotTile(tile)) {
+				/* 'optimization assert' do not try to update signals in other cases */
+				assert(dir == INVALID_DIAGDIR || dir == GetRailDepotDirection(tile));
+				_tbdset.Add(tile, INVALID_DIAGDIR); // start from depot inside
+				return true;
+			}
+			FALLTHROUGH;
+
+		case MP_STATION:
+		case MP_ROAD:
+			if ((TrackdirBitsToTrackBits(GetTileTrackdirBits(tile, TRANSPORT_RAIL, 0)) & _enterdir_to_trackbits[dir]) != TRACK_BIT_NONE) {
+				/* only add to set when there is some 'interesting' track */
+				_tbdset.Add(tile, dir);
+				_tbdset.Add(tile + TileOffsByDiagDir(dir), ReverseDiagDir(dir));
+				return true;
+			}
+			FALLTHROUGH;
+
+		default:
+			/* jump to next tile */
+			tile = tile + TileOffsByDiagDir(dir);
+			dir = ReverseDiagDir(dir);
+			if ((TrackdirBitsToTrackBits(GetTileTrackdirBits(tile, TRANSPORT_RAIL, 0)) & _enterdir_to_trackbits[dir]) != TRACK_BIT_NONE) {
+				_tbdset.Add(tile, dir);
+				return true;
+			}
+			/* happens when removing a rail that wasn't connected at one or both sides */
+			return false;
+	}
+}
+
+/**
+ * Check that the cached signal block searches match a fresh search of the current track layout.
+ * @return description of the first mismatch, or an empty string if the cache is valid
+ */
+std::string ValidateSignalSegmentCache()
+{
+	if (!_globset.IsEmpty()) return {};
+
+	for (const auto &it : _signal_segment_cache) {
+		const TileIndex tile = (TileIndex)(it.first >> 16);
+		const DiagDirection dir = (DiagDirection)GB(it.first, 8, 8);
+		const Owner owner = (Owner)GB(it.first, 0, 8);
+
+		SignalSegmentTrace trace;
+		if (AddSignalSegmentStartNodes(tile, dir)) ExploreSegment(owner, &trace);
+		ResetSets();
+
+		bool match = trace.size() == it.second.size();
+		for (size_t i = 0; match && i < trace.size(); i++) {
+			const SignalSegmentOp &a = trace[i];
+			const SignalSegmentOp &b = it.second[i];
+			match = (a.tile == b.tile && a.data == b.data && a.type == b.type && a.param == b.param);
+		}
+		if (!match) {
+			return stdstr_fmt("tile: 0x%X, dir: %u, owner: %u, cached steps: %u, current steps: %u", tile, dir, owner, (uint)it.second.size(), (uint)trace.size());
+		}
+	}
+
+	return {};
+}
+
 /**
  * Updates blocks in _globset buffer
  *
@@ -930,69 +1210,19 @@ static SigSegState UpdateSignalsInBuffer(Owner owner)
 	TileIndex tile = INVALID_TILE; // Stop GCC from complaining about a possibly uninitialized variable (issue #8280).
 	DiagDirection dir = INVALID_DIAGDIR;
 
+	_wormhole_train_results_active = true;
+
 	while (_globset.Get(&tile, &dir)) {
 		assert(_tbuset.IsEmpty());
 		assert(_tbdset.IsEmpty());
 
-		/* After updating signal, data stored are always MP_RAILWAY with signals.
-		 * Other situations happen when data are from outside functions -
-		 * modification of railbits (including both rail building and removal),
-		 * train entering/leaving block, train leaving depot...
-		 */
-		switch (GetTileType(tile)) {
-			case MP_TUNNELBRIDGE: {
-				/* 'optimization assert' - do not try to update signals when it is not needed */
-				assert_tile(GetTunnelBridgeTransportType(tile) == TRANSPORT_RAIL, tile);
-				if (IsTunnel(tile)) assert(dir == INVALID_DIAGDIR || dir == ReverseDiagDir(GetTunnelBridgeDirection(tile)));
-				TrackBits across = GetAcrossTunnelBridgeTrackBits(tile);
-				if (dir == INVALID_DIAGDIR || _enterdir_to_trackbits[dir] & across) {
-					if (IsTunnelBridgeWithSignalSimulation(tile)) {
-						/* Don't worry about other side of tunnel. */
-						_tbdset.Add(tile, dir);
-					} else {
-						_tbdset.Add(tile, INVALID_DIAGDIR);  // we can safely start from wormhole centre
-						_tbdset.Add(GetOtherTunnelBridgeEnd(tile), INVALID_DIAGDIR);
-					}
-					break;
-				}
-			}
-				FALLTHROUGH;
-
-			case MP_RAILWAY:
-				if (IsRailDepotTile(tile)) {
-					/* 'optimization assert' do not try to update signals in other cases */
-					assert(dir == INVALID_DIAGDIR || dir == GetRailDepotDirection(tile));
-					_tbdset.Add(tile, INVALID_DIAGDIR); // start from depot inside
-					break;
-				}
-				FALLTHROUGH;
 
-			case MP_STATION:
-			case MP_ROAD:
-				if ((TrackdirBitsToTrackBits(GetTileTrackdirBits(tile, TRANSPORT_RAIL, 0)) & _enterdir_to_trackbits[dir]) != TRACK_BIT_NONE) {
-					/* only add to set when there is some 'interesting' track */
-					_tbdset.Add(tile, dir);
-					_tbdset.Add(tile + TileOffsByDiagDir(dir), ReverseDiagDir(dir));
-					break;
-				}
-				FALLTHROUGH;
-
-			default:
-				/* jump to next tile */
-				tile = tile + TileOffsByDiagDir(dir);
-				dir = ReverseDiagDir(dir);
-				if ((TrackdirBitsToTrackBits(GetTileTrackdirBits(tile, TRANSPORT_RAIL, 0)) & _enterdir_to_trackbits[dir]) != TRACK_BIT_NONE) {
-					_tbdset.Add(tile, dir);
-					break;
-				}
-				/* happens when removing a rail that wasn't connected at one or both sides */
-				continue; // continue the while() loop
-		}
+		if (!AddSignalSegmentStartNodes(tile, dir)) continue; // happens when removing a rail that wasn't connected at one or both sides
 
 		assert(!_tbdset.Overflowed()); // it really shouldn't overflow by these one or two items
 		assert(!_tbdset.IsEmpty()); // it wouldn't hurt anyone, but shouldn't happen too
 
-		SigInfo info = ExploreSegment(owner);
+		SigInfo info = ExploreSegmentCached(owner, tile, dir);
 
 		if (first) {
 			first = false;
@@ -1017,6 +1247,9 @@ static SigSegState UpdateSignalsInBuffer(Owner owner)
 		UpdateSignalsAroundSegment(info);
 	}
 
+	_wormhole_train_results_active = false;
+	_wormhole_train_results.clear();
+
 	if (_settings_game.vehicle.train_braking_model == TBM_REALISTIC) state = SIGSEG_PBS;
 
 	return state;
@@ -1491,38 +1724,120 @@ void UpdateLookaheadCombinedNormalShuntSignalDeferred(TileIndex tile, Trackdir t
 	_deferred_lookahead_combined_normal_shunt_mode.push_back({ tile, trackdir, lookahead_position });
 }
 
+/**
+ * Check whether a deferred aspect update still has to be applied: the signal exists, is green and its aspect has not yet been calculated.
+ * @param tile Tile of the signal.
+ * @param trackdir Trackdir of the signal.
+ * @return True if the aspect of the signal still has to be calculated.
+ */
+static bool IsDeferredAspectUpdatePending(TileIndex tile, Trackdir trackdir)
+{
+	switch (GetTileType(tile)) {
+		case MP_RAILWAY:
+			return HasSignalOnTrackdir(tile, trackdir) && GetSignalStateByTrackdir(tile, trackdir) == SIGNAL_STATE_GREEN && GetSignalAspect(tile, TrackdirToTrack(trackdir)) == 0;
+
+		case MP_TUNNELBRIDGE:
+			if (IsTunnelBridgeSignalSimulationEntrance(tile) && TrackdirEntersTunnelBridge(tile, trackdir) &&
+					GetTunnelBridgeEntranceSignalState(tile) == SIGNAL_STATE_GREEN && GetTunnelBridgeEntranceSignalAspect(tile) == 0) {
+				return true;
+			}
+			if (IsTunnelBridgeSignalSimulationExit(tile) && TrackdirExitsTunnelBridge(tile, trackdir) &&
+					GetTunnelBridgeExitSignalState(tile) == SIGNAL_STATE_GREEN && GetTunnelBridgeExitSignalAspect(tile) == 0) {
+				return true;
+			}
+			return false;
+
+		default:
+			return false;
+	}
+}
+
+/**
+ * Calculate the aspect of a signal for which IsDeferredAspectUpdatePending is true.
+ * @param tile Tile of the signal.
+ * @param trackdir Trackdir of the signal.
+ * @param next_signal Set to the signal whose aspect the result depends on, if any.
+ * @return The new aspect.
+ */
+static uint8 GetDeferredAspect(TileIndex tile, Trackdir trackdir, std::pair<TileIndex, Trackdir> *next_signal)
+{
+	bool combined_normal_mode = IsTileType(tile, MP_RAILWAY) && IsRailCombinedNormalShuntSignalStyle(tile, TrackdirToTrack(trackdir));
+	return IncrementAspectForSignal(GetForwardAspectFollowingTrack(tile, trackdir, next_signal), combined_normal_mode);
+}
+
+/**
+ * Set the aspect of a signal for which IsDeferredAspectUpdatePending is true, and propagate it to the signals behind.
+ * @param tile Tile of the signal.
+ * @param trackdir Trackdir of the signal.
+ * @param aspect The new aspect.
+ */
+static void ApplyDeferredAspectUpdate(TileIndex tile, Trackdir trackdir, uint8 aspect)
+{
+	if (IsTileType(tile, MP_RAILWAY)) {
+		SetSignalAspect(tile, TrackdirToTrack(trackdir), aspect);
+	} else if (TrackdirEntersTunnelBridge(tile, trackdir)) {
+		SetTunnelBridgeEntranceSignalAspect(tile, aspect);
+	} else {
+		SetTunnelBridgeExitSignalAspect(tile, aspect);
+	}
+	PropagateAspectChange(tile, trackdir, aspect);
+}
+
+/**
+ * Apply all deferred aspect updates.
+ *
+ * Each queued signal is handled at most once, however many times it was queued.
+ * A signal's aspect depends on that of the next signal ahead: when that signal is itself still waiting in the queue,
+ * it is updated first, so that the aspect change propagating back from it sets the aspect of the signals behind it in one pass,
+ * instead of those being set first and then walked over again.
+ */
 void FlushDeferredAspectUpdates()
 {
+	if (_deferred_aspect_updates.empty()) return;
+
+	static std::vector<uint64> queued;
+	static std::vector<bool> visited;
+	static std::vector<std::pair<TileIndex, Trackdir>> stack;
+
+	auto key = [](const std::pair<TileIndex, Trackdir> &item) -> uint64 {
+		return (((uint64)item.first) << 8) | item.second;
+	};
+	queued.clear();
+	for (const auto &item : _deferred_aspect_updates) queued.push_back(key(item));
+	std::sort(queued.begin(), queued.end());
+	queued.erase(std::unique(queued.begin(), queued.end()), queued.end());
+	visited.assign(queued.size(), false);
+
+	/* Visit a queued signal, returns false if it is not queued or has already been visited */
+	auto visit = [&](const std::pair<TileIndex, Trackdir> &item) -> bool {
+		auto it = std::lower_bound(queued.begin(), queued.end(), key(item));
+		if (it == queued.end() || *it != key(item)) return false;
+		std::vector<bool>::reference v = visited[it - queued.begin()];
+		if (v) return false;
+		v = true;
+		return true;
+	};
+
 	/* Iterate in reverse order to reduce backtracking when updating the aspects of a new reservation */
 	for (auto iter = _deferred_aspect_updates.rbegin(); iter != _deferred_aspect_updates.rend(); ++iter) {
-		TileIndex tile = iter->first;
-		Trackdir trackdir = iter->second;
-		switch (GetTileType(tile)) {
-			case MP_RAILWAY:
-				if (HasSignalOnTrackdir(tile, trackdir) && GetSignalStateByTrackdir(tile, trackdir) == SIGNAL_STATE_GREEN && GetSignalAspect(tile, TrackdirToTrack(trackdir)) == 0) {
-					uint8 aspect = GetForwardAspectFollowingTrackAndIncrement(tile, trackdir, IsRailCombinedNormalShuntSignalStyle(tile, TrackdirToTrack(trackdir)));
-					SetSignalAspect(tile, TrackdirToTrack(trackdir), aspect);
-					PropagateAspectChange(tile, trackdir, aspect);
-				}
-				break;
-
-			case MP_TUNNELBRIDGE:
-				if (IsTunnelBridgeSignalSimulationEntrance(tile) && TrackdirEntersTunnelBridge(tile, trackdir) &&
-						GetTunnelBridgeEntranceSignalState(tile) == SIGNAL_STATE_GREEN && GetTunnelBridgeEntranceSignalAspect(tile) == 0) {
-					uint8 aspect = GetForwardAspectFollowingTrackAndIncrement(tile, trackdir);
-					SetTunnelBridgeEntranceSignalAspect(tile, aspect);
-					PropagateAspectChange(tile, trackdir, aspect);
-				}
-				if (IsTunnelBridgeSignalSimulationExit(tile) && TrackdirExitsTunnelBridge(tile, trackdir) &&
-						GetTunnelBridgeExitSignalState(tile) == SIGNAL_STATE_GREEN && GetTunnelBridgeExitSignalAspect(tile) == 0) {
-					uint8 aspect = GetForwardAspectFollowingTrackAndIncrement(tile, trackdir);
-					SetTunnelBridgeExitSignalAspect(tile, aspect);
-					PropagateAspectChange(tile, trackdir, aspect);
-				}
-				break;
+		if (!visit(*iter)) continue;
 
-			default:
-				break;
+		stack.push_back(*iter);
+		while (!stack.empty()) {
+			const auto [tile, trackdir] = stack.back();
+			if (!IsDeferredAspectUpdatePending(tile, trackdir)) {
+				stack.pop_back();
+				continue;
+			}
+			std::pair<TileIndex, Trackdir> next_signal = { INVALID_TILE, INVALID_TRACKDIR };
+			uint8 aspect = GetDeferredAspect(tile, trackdir, &next_signal);
+			if (next_signal.first != INVALID_TILE && visit(next_signal) && IsDeferredAspectUpdatePending(next_signal.first, next_signal.second)) {
+				/* The next signal ahead is also waiting for its aspect, do that one first */
+				stack.push_back(next_signal);
+				continue;
+			}
+			ApplyDeferredAspectUpdate(tile, trackdir, aspect);
+			stack.pop_back();
 		}
 	}
 	_deferred_aspect_updates.clear();
@@ -19,6 +19,8 @@
 #include "settings_type.h"
 #include "vehicle_type.h"
 
+#include <string>
+
 extern uint8 _extra_aspects;
 extern uint64 _aspect_cfg_hash;
 
@@ -185,8 +187,10 @@ void SetSignalsOnBothDir(TileIndex tile, Track track, Owner owner);
 void AddTrackToSignalBuffer(TileIndex tile, Track track, Owner owner);
 void AddSideToSignalBuffer(TileIndex tile, DiagDirection side, Owner owner);
 void UpdateSignalsInBuffer();
+void InvalidateSignalSegmentCache();
+std::string ValidateSignalSegmentCache();
 void UpdateSignalsInBufferIfOwnerNotAddable(Owner owner);
-uint8 GetForwardAspectFollowingTrack(TileIndex tile, Trackdir trackdir);
+uint8 GetForwardAspectFollowingTrack(TileIndex tile, Trackdir trackdir, std::pair<TileIndex, Trackdir> *next_signal = nullptr);
 uint8 GetSignalAspectGeneric(TileIndex tile, Trackdir trackdir, bool check_non_inc_style);
 void PropagateAspectChange(TileIndex tile, Trackdir trackdir, uint8 aspect);
 void UpdateAspectDeferred(TileIndex tile, Trackdir trackdir);
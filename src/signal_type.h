@@ -45,6 +45,7 @@ template <> struct EnumPropsT<SignalType> : MakeEnumPropsT<SignalType, byte, SIG
  * A reference to a signal by its tile and track
  */
 struct SignalReference {
+	SignalReference() = default;
 	inline SignalReference(TileIndex t, Track tr) : tile(t), track(tr) {}
 	inline bool operator<(const SignalReference& o) const { return tile < o.tile || (tile == o.tile && track < o.track); }
 	inline bool operator==(const SignalReference& o) const { return tile == o.tile && track == o.track; }
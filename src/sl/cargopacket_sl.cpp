@@ -148,6 +148,9 @@ extern btree::btree_map<uint64, Money> _cargo_packet_deferred_payments;
 		}
 		_veh_cpp_packets.clear();
 	}
+
+	/* Packets which were deleted before saving leave holes in the pool, remove them. */
+	CargoPacket::CompactPoolIndices();
 }
 
 /**
@@ -15,6 +15,7 @@
 #include "../tunnelbridge_map.h"
 #include "../tunnelbridge.h"
 #include "../station_base.h"
+#include "../worker_thread.h"
 #include "../settings_func.h"
 #include "../strings_func.h"
 #include "../network/network.h"
@@ -28,6 +29,8 @@
 
 #include "table/strings.h"
 
+#include <mutex>
+
 #include "../safeguards.h"
 
 /**
@@ -98,66 +101,67 @@ CompanyManagerFace ConvertFromOldCompanyManagerFace(uint32 face)
 	return cmf;
 }
 
-/** Rebuilding of company statistics after loading a savegame. */
-void AfterLoadCompanyStats()
+/**
+ * Count the company infrastructure of a strip of rows of the map.
+ * This only reads the map, so it can be called for several strips at once.
+ * @param y_begin First row of the strip.
+ * @param y_end Row after the last row of the strip.
+ * @param counts Infrastructure counts to add to, indexed by company.
+ * @param tunnel_bridges Western ends of rail and road tunnels and bridges whose infrastructure still has to be added, these modify the companies directly.
+ */
+static void CountCompanyInfrastructureStrip(uint y_begin, uint y_end, CompanyInfrastructure *counts, std::vector<TileIndex> &tunnel_bridges)
 {
-	/* Reset infrastructure statistics to zero. */
-	for (Company *c : Company::Iterate()) MemSetT(&c->infrastructure, 0);
-
-	/* Collect airport count. */
-	for (const Station *st : Station::Iterate()) {
-		if ((st->facilities & FACIL_AIRPORT) && Company::IsValidID(st->owner)) {
-			Company::Get(st->owner)->infrastructure.airport++;
-		}
-	}
+	auto get_infra = [&](Owner owner) -> CompanyInfrastructure * {
+		return Company::IsValidID(owner) ? &counts[owner] : nullptr;
+	};
 
-	Company *c;
-	for (TileIndex tile = 0; tile < MapSize(); tile++) {
+	CompanyInfrastructure *c;
+	for (TileIndex tile = TileXY(0, y_begin); tile < TileXY(0, y_end); tile++) {
 		switch (GetTileType(tile)) {
 			case MP_RAILWAY:
-				c = Company::GetIfValid(GetTileOwner(tile));
+				c = get_infra(GetTileOwner(tile));
 				if (c != nullptr) {
 					uint pieces = 1;
 					if (IsPlainRail(tile)) {
 						TrackBits bits = GetTrackBits(tile);
 						if (bits == TRACK_BIT_HORZ || bits == TRACK_BIT_VERT) {
-							c->infrastructure.rail[GetSecondaryRailType(tile)]++;
+							c->rail[GetSecondaryRailType(tile)]++;
 						} else {
 							pieces = CountBits(bits);
 							if (TracksOverlap(bits)) pieces *= pieces;
 						}
 					}
-					c->infrastructure.rail[GetRailType(tile)] += pieces;
+					c->rail[GetRailType(tile)] += pieces;
 
-					if (HasSignals(tile)) c->infrastructure.signal += CountBits(GetPresentSignals(tile));
+					if (HasSignals(tile)) c->signal += CountBits(GetPresentSignals(tile));
 				}
 				break;
 
 			case MP_ROAD: {
 				if (IsLevelCrossing(tile)) {
-					c = Company::GetIfValid(GetTileOwner(tile));
-					if (c != nullptr) c->infrastructure.rail[GetRailType(tile)] += LEVELCROSSING_TRACKBIT_FACTOR;
+					c = get_infra(GetTileOwner(tile));
+					if (c != nullptr) c->rail[GetRailType(tile)] += LEVELCROSSING_TRACKBIT_FACTOR;
 				}
 
 				/* Iterate all present road types as each can have a different owner. */
 				for (RoadTramType rtt : _roadtramtypes) {
 					RoadType rt = GetRoadType(tile, rtt);
 					if (rt == INVALID_ROADTYPE) continue;
-					c = Company::GetIfValid(IsRoadDepot(tile) ? GetTileOwner(tile) : GetRoadOwner(tile, rtt));
+					c = get_infra(IsRoadDepot(tile) ? GetTileOwner(tile) : GetRoadOwner(tile, rtt));
 					/* A level crossings and depots have two road bits. */
-					if (c != nullptr) c->infrastructure.road[rt] += IsNormalRoad(tile) ? CountBits(GetRoadBits(tile, rtt)) : 2;
+					if (c != nullptr) c->road[rt] += IsNormalRoad(tile) ? CountBits(GetRoadBits(tile, rtt)) : 2;
 				}
 				break;
 			}
 
 			case MP_STATION:
-				c = Company::GetIfValid(GetTileOwner(tile));
-				if (c != nullptr && GetStationType(tile) != STATION_AIRPORT && !IsBuoy(tile)) c->infrastructure.station++;
+				c = get_infra(GetTileOwner(tile));
+				if (c != nullptr && GetStationType(tile) != STATION_AIRPORT && !IsBuoy(tile)) c->station++;
 
 				switch (GetStationType(tile)) {
 					case STATION_RAIL:
 					case STATION_WAYPOINT:
-						if (c != nullptr && !IsStationTileBlocked(tile)) c->infrastructure.rail[GetRailType(tile)]++;
+						if (c != nullptr && !IsStationTileBlocked(tile)) c->rail[GetRailType(tile)]++;
 						break;
 
 					case STATION_BUS:
@@ -167,8 +171,8 @@ void AfterLoadCompanyStats()
 						for (RoadTramType rtt : _roadtramtypes) {
 							RoadType rt = GetRoadType(tile, rtt);
 							if (rt == INVALID_ROADTYPE) continue;
-							c = Company::GetIfValid(GetRoadOwner(tile, rtt));
-							if (c != nullptr) c->infrastructure.road[rt] += 2; // A road stop has two road bits.
+							c = get_infra(GetRoadOwner(tile, rtt));
+							if (c != nullptr) c->road[rt] += 2; // A road stop has two road bits.
 						}
 						break;
 					}
@@ -176,7 +180,7 @@ void AfterLoadCompanyStats()
 					case STATION_DOCK:
 					case STATION_BUOY:
 						if (GetWaterClass(tile) == WATER_CLASS_CANAL) {
-							if (c != nullptr) c->infrastructure.water++;
+							if (c != nullptr) c->water++;
 						}
 						break;
 
@@ -187,12 +191,12 @@ void AfterLoadCompanyStats()
 
 			case MP_WATER:
 				if (IsShipDepot(tile) || IsLock(tile)) {
-					c = Company::GetIfValid(GetTileOwner(tile));
+					c = get_infra(GetTileOwner(tile));
 					if (c != nullptr) {
-						if (IsShipDepot(tile)) c->infrastructure.water += LOCK_DEPOT_TILE_FACTOR;
+						if (IsShipDepot(tile)) c->water += LOCK_DEPOT_TILE_FACTOR;
 						if (IsLock(tile) && GetLockPart(tile) == LOCK_PART_MIDDLE) {
 							/* The middle tile specifies the owner of the lock. */
-							c->infrastructure.water += 3 * LOCK_DEPOT_TILE_FACTOR; // the middle tile specifies the owner of the
+							c->water += 3 * LOCK_DEPOT_TILE_FACTOR; // the middle tile specifies the owner of the
 							break; // do not count the middle tile as canal
 						}
 					}
@@ -201,35 +205,29 @@ void AfterLoadCompanyStats()
 
 			case MP_OBJECT:
 				if (GetWaterClass(tile) == WATER_CLASS_CANAL) {
-					c = Company::GetIfValid(GetTileOwner(tile));
-					if (c != nullptr) c->infrastructure.water++;
+					c = get_infra(GetTileOwner(tile));
+					if (c != nullptr) c->water++;
 				}
 				break;
 
 			case MP_TUNNELBRIDGE: {
 				/* Only count the tunnel/bridge if we're on the western end tile. */
 				if (GetTunnelBridgeDirection(tile) < DIAGDIR_SW) {
-					TileIndex other_end = GetOtherTunnelBridgeEnd(tile);
-
-					/* Count each tunnel/bridge TUNNELBRIDGE_TRACKBIT_FACTOR times to simulate
-					 * the higher structural maintenance needs, and don't forget the end tiles. */
-					const uint middle_len = GetTunnelBridgeLength(tile, other_end) * TUNNELBRIDGE_TRACKBIT_FACTOR;
-
 					switch (GetTunnelBridgeTransportType(tile)) {
 						case TRANSPORT_RAIL:
-							AddRailTunnelBridgeInfrastructure(tile, other_end);
+						case TRANSPORT_ROAD:
+							tunnel_bridges.push_back(tile);
 							break;
 
-						case TRANSPORT_ROAD: {
-							AddRoadTunnelBridgeInfrastructure(tile, other_end);
+						case TRANSPORT_WATER: {
+							/* Count each tunnel/bridge TUNNELBRIDGE_TRACKBIT_FACTOR times to simulate
+							 * the higher structural maintenance needs, and don't forget the end tiles. */
+							const uint middle_len = GetTunnelBridgeLength(tile, GetOtherTunnelBridgeEnd(tile)) * TUNNELBRIDGE_TRACKBIT_FACTOR;
+							c = get_infra(GetTileOwner(tile));
+							if (c != nullptr) c->water += middle_len + (2 * TUNNELBRIDGE_TRACKBIT_FACTOR);
 							break;
 						}
 
-						case TRANSPORT_WATER:
-							c = Company::GetIfValid(GetTileOwner(tile));
-							if (c != nullptr) c->infrastructure.water += middle_len + (2 * TUNNELBRIDGE_TRACKBIT_FACTOR);
-							break;
-
 						default:
 							break;
 					}
@@ -243,6 +241,50 @@ void AfterLoadCompanyStats()
 	}
 }
 
+/**
+ * Rebuilding of company statistics after loading a savegame.
+ * This is also used to verify the incrementally maintained counts, so the map is counted in strips in parallel.
+ */
+void AfterLoadCompanyStats()
+{
+	/* Reset infrastructure statistics to zero. */
+	for (Company *c : Company::Iterate()) MemSetT(&c->infrastructure, 0);
+
+	/* Collect airport count. */
+	for (const Station *st : Station::Iterate()) {
+		if ((st->facilities & FACIL_AIRPORT) && Company::IsValidID(st->owner)) {
+			Company::Get(st->owner)->infrastructure.airport++;
+		}
+	}
+
+	std::mutex lock;
+	std::vector<TileIndex> tunnel_bridges;
+	_general_worker_pool.ParallelFor(MapSizeY(), 64, [&](int y_begin, int y_end) {
+		CompanyInfrastructure counts[MAX_COMPANIES] = {};
+		std::vector<TileIndex> strip_tunnel_bridges;
+		CountCompanyInfrastructureStrip(y_begin, y_end, counts, strip_tunnel_bridges);
+
+		std::lock_guard<std::mutex> guard(lock);
+		for (Company *c : Company::Iterate()) {
+			const CompanyInfrastructure &strip = counts[c->index];
+			for (RoadType rt = ROADTYPE_BEGIN; rt < ROADTYPE_END; rt++) c->infrastructure.road[rt] += strip.road[rt];
+			for (RailType rt = RAILTYPE_BEGIN; rt < RAILTYPE_END; rt++) c->infrastructure.rail[rt] += strip.rail[rt];
+			c->infrastructure.signal += strip.signal;
+			c->infrastructure.water += strip.water;
+			c->infrastructure.station += strip.station;
+		}
+		tunnel_bridges.insert(tunnel_bridges.end(), strip_tunnel_bridges.begin(), strip_tunnel_bridges.end());
+	});
+
+	for (TileIndex tile : tunnel_bridges) {
+		if (GetTunnelBridgeTransportType(tile) == TRANSPORT_RAIL) {
+			AddRailTunnelBridgeInfrastructure(tile, GetOtherTunnelBridgeEnd(tile));
+		} else {
+			AddRoadTunnelBridgeInfrastructure(tile, GetOtherTunnelBridgeEnd(tile));
+		}
+	}
+}
+
 
 
 /* Save/load of companies */
@@ -193,6 +193,9 @@ const SlxiSubChunkInfo _sl_xv_sub_chunk_infos[] = {
 	{ XSLFI_VARIABLE_TICK_RATE,               XSCF_IGNORABLE_ALL,       1,   1, "variable_tick_rate",               nullptr, nullptr, nullptr          },
 	{ XSLFI_ROAD_VEH_FLAGS,                   XSCF_NULL,                1,   1, "road_veh_flags",                   nullptr, nullptr, nullptr          },
 	{ XSLFI_STATION_TILE_CACHE_FLAGS,         XSCF_IGNORABLE_ALL,       1,   1, "station_tile_cache_flags",         saveSTC, loadSTC, nullptr          },
+	{ XSLFI_DEFERRED_DEPOT_SEARCH,            XSCF_IGNORABLE_ALL,       1,   1, "deferred_depot_search",            nullptr, nullptr, "VDDS"           },
+	{ XSLFI_LINKGRAPH_LATE_JOIN,              XSCF_NULL,                1,   1, "linkgraph_late_join",              nullptr, nullptr, nullptr          },
+	{ XSLFI_SCRIPT_COMPACT_DATA,              XSCF_NULL,                1,   1, "script_compact_data",              nullptr, nullptr, nullptr          },
 
 	{ XSLFI_SCRIPT_INT64,                     XSCF_NULL,                1,   1, "script_int64",                     nullptr, nullptr, nullptr          },
 	{ XSLFI_U64_TICK_COUNTER,                 XSCF_NULL,                1,   1, "u64_tick_counter",                 nullptr, nullptr, nullptr          },
@@ -142,6 +142,9 @@ enum SlXvFeatureIndex {
 	XSLFI_VARIABLE_TICK_RATE,                     ///< Variable tick rate
 	XSLFI_ROAD_VEH_FLAGS,                         ///< Road vehicle flags
 	XSLFI_STATION_TILE_CACHE_FLAGS,               ///< Station tile cache flags
+	XSLFI_DEFERRED_DEPOT_SEARCH,                  ///< Deferred servicing depot search queue
+	XSLFI_LINKGRAPH_LATE_JOIN,                    ///< Link graph late join delay setting
+	XSLFI_SCRIPT_COMPACT_DATA,                    ///< Script save data may contain integer arrays and string references
 
 	XSLFI_SCRIPT_INT64,                           ///< See: SLV_SCRIPT_INT64
 	XSLFI_U64_TICK_COUNTER,                       ///< See: SLV_U64_TICK_COUNTER
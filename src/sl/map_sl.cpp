@@ -56,14 +56,82 @@ static void Check_MAPS()
 
 static const uint MAP_SL_BUF_SIZE = 4096;
 
-static void Load_MAPT()
+struct MAPT {
+	typedef uint8 FieldT;
+	static FieldT &GetField(TileIndex t) { return _m[t].type; }
+};
+
+struct MAPH {
+	typedef uint8 FieldT;
+	static FieldT &GetField(TileIndex t) { return _m[t].height; }
+};
+
+struct MAP1 {
+	typedef uint8 FieldT;
+	static FieldT &GetField(TileIndex t) { return _m[t].m1; }
+};
+
+struct MAP2 {
+	typedef uint16 FieldT;
+	static FieldT &GetField(TileIndex t) { return _m[t].m2; }
+};
+
+struct MAP3 {
+	typedef uint8 FieldT;
+	static FieldT &GetField(TileIndex t) { return _m[t].m3; }
+};
+
+struct MAP4 {
+	typedef uint8 FieldT;
+	static FieldT &GetField(TileIndex t) { return _m[t].m4; }
+};
+
+struct MAP5 {
+	typedef uint8 FieldT;
+	static FieldT &GetField(TileIndex t) { return _m[t].m5; }
+};
+
+struct MAP6 {
+	typedef uint8 FieldT;
+	static FieldT &GetField(TileIndex t) { return _me[t].m6; }
+};
+
+struct MAP7 {
+	typedef uint8 FieldT;
+	static FieldT &GetField(TileIndex t) { return _me[t].m7; }
+};
+
+struct MAP8 {
+	typedef uint16 FieldT;
+	static FieldT &GetField(TileIndex t) { return _me[t].m8; }
+};
+
+/** Read a map field as stored in the per-field map chunks, the buffer must hold enough bytes. */
+template <typename T> static inline T RawReadMapField(ReadBuffer *reader);
+template <> inline uint8 RawReadMapField<uint8>(ReadBuffer *reader) { return reader->RawReadByte(); }
+template <> inline uint16 RawReadMapField<uint16>(ReadBuffer *reader) { return reader->RawReadUint16(); }
+
+/** Write a map field as stored in the per-field map chunks, the buffer must have enough space. */
+static inline void RawWriteMapField(MemoryDumper *dumper, uint8 v) { dumper->RawWriteByte(v); }
+static inline void RawWriteMapField(MemoryDumper *dumper, uint16 v) { dumper->RawWriteUint16(v); }
+
+/**
+ * Load a per-field map chunk directly from the read buffer into the map array.
+ * The fields are taken from the read buffer as far as it holds whole fields, without an intermediate buffer.
+ * @tparam T Map field accessor.
+ */
+template <typename T>
+static void Load_MAP()
 {
-	std::array<byte, MAP_SL_BUF_SIZE> buf;
-	TileIndex size = MapSize();
+	typedef typename T::FieldT FieldT;
+
+	ReadBuffer *reader = ReadBuffer::GetCurrent();
+	const TileIndex size = MapSize();
 
 	for (TileIndex i = 0; i != size;) {
-		SlArray(buf.data(), MAP_SL_BUF_SIZE, SLE_UINT8);
-		for (uint j = 0; j != MAP_SL_BUF_SIZE; j++) _m[i++].type = buf[j];
+		reader->CheckBytes(sizeof(FieldT));
+		const TileIndex end = i + std::min<TileIndex>(size - i, (TileIndex)((reader->bufe - reader->bufp) / sizeof(FieldT)));
+		for (; i != end; i++) T::GetField(i) = RawReadMapField<FieldT>(reader);
 	}
 }
 
@@ -99,73 +167,26 @@ static void Load_MAPH()
 		return;
 	}
 
-	std::array<byte, MAP_SL_BUF_SIZE> buf;
-	TileIndex size = MapSize();
-
-	for (TileIndex i = 0; i != size;) {
-		SlArray(buf.data(), MAP_SL_BUF_SIZE, SLE_UINT8);
-		for (uint j = 0; j != MAP_SL_BUF_SIZE; j++) _m[i++].height = buf[j];
-	}
+	Load_MAP<MAPH>();
 }
 
-static void Load_MAP1()
+static void Load_MAP2()
 {
-	std::array<byte, MAP_SL_BUF_SIZE> buf;
-	TileIndex size = MapSize();
-
-	for (TileIndex i = 0; i != size;) {
-		SlArray(buf.data(), MAP_SL_BUF_SIZE, SLE_UINT8);
-		for (uint j = 0; j != MAP_SL_BUF_SIZE; j++) _m[i++].m1 = buf[j];
+	if (!IsSavegameVersionBefore(SLV_5)) {
+		Load_MAP<MAP2>();
+		return;
 	}
-}
 
-static void Load_MAP2()
-{
 	std::array<uint16, MAP_SL_BUF_SIZE> buf;
 	TileIndex size = MapSize();
 
 	for (TileIndex i = 0; i != size;) {
-		SlArray(buf.data(), MAP_SL_BUF_SIZE,
-			/* In those versions the m2 was 8 bits */
-			IsSavegameVersionBefore(SLV_5) ? SLE_FILE_U8 | SLE_VAR_U16 : SLE_UINT16
-		);
+		/* In those versions the m2 was 8 bits */
+		SlArray(buf.data(), MAP_SL_BUF_SIZE, SLE_FILE_U8 | SLE_VAR_U16);
 		for (uint j = 0; j != MAP_SL_BUF_SIZE; j++) _m[i++].m2 = buf[j];
 	}
 }
 
-static void Load_MAP3()
-{
-	std::array<byte, MAP_SL_BUF_SIZE> buf;
-	TileIndex size = MapSize();
-
-	for (TileIndex i = 0; i != size;) {
-		SlArray(buf.data(), MAP_SL_BUF_SIZE, SLE_UINT8);
-		for (uint j = 0; j != MAP_SL_BUF_SIZE; j++) _m[i++].m3 = buf[j];
-	}
-}
-
-static void Load_MAP4()
-{
-	std::array<byte, MAP_SL_BUF_SIZE> buf;
-	TileIndex size = MapSize();
-
-	for (TileIndex i = 0; i != size;) {
-		SlArray(buf.data(), MAP_SL_BUF_SIZE, SLE_UINT8);
-		for (uint j = 0; j != MAP_SL_BUF_SIZE; j++) _m[i++].m4 = buf[j];
-	}
-}
-
-static void Load_MAP5()
-{
-	std::array<byte, MAP_SL_BUF_SIZE> buf;
-	TileIndex size = MapSize();
-
-	for (TileIndex i = 0; i != size;) {
-		SlArray(buf.data(), MAP_SL_BUF_SIZE, SLE_UINT8);
-		for (uint j = 0; j != MAP_SL_BUF_SIZE; j++) _m[i++].m5 = buf[j];
-	}
-}
-
 static void Load_MAP6()
 {
 	std::array<byte, MAP_SL_BUF_SIZE> buf;
@@ -183,32 +204,7 @@ static void Load_MAP6()
 			}
 		}
 	} else {
-		for (TileIndex i = 0; i != size;) {
-			SlArray(buf.data(), MAP_SL_BUF_SIZE, SLE_UINT8);
-			for (uint j = 0; j != MAP_SL_BUF_SIZE; j++) _me[i++].m6 = buf[j];
-		}
-	}
-}
-
-static void Load_MAP7()
-{
-	std::array<byte, MAP_SL_BUF_SIZE> buf;
-	TileIndex size = MapSize();
-
-	for (TileIndex i = 0; i != size;) {
-		SlArray(buf.data(), MAP_SL_BUF_SIZE, SLE_UINT8);
-		for (uint j = 0; j != MAP_SL_BUF_SIZE; j++) _me[i++].m7 = buf[j];
-	}
-}
-
-static void Load_MAP8()
-{
-	std::array<uint16, MAP_SL_BUF_SIZE> buf;
-	TileIndex size = MapSize();
-
-	for (TileIndex i = 0; i != size;) {
-		SlArray(buf.data(), MAP_SL_BUF_SIZE, SLE_UINT16);
-		for (uint j = 0; j != MAP_SL_BUF_SIZE; j++) _me[i++].m8 = buf[j];
+		Load_MAP<MAP6>();
 	}
 }
 
@@ -221,7 +217,7 @@ static void Load_WMAP()
 	ReadBuffer *reader = ReadBuffer::GetCurrent();
 	const TileIndex size = MapSize();
 
-#if TTD_ENDIAN == TTD_LITTLE_ENDIAN
+#if TTD_ENDIAN == TTD_LITTLE_ENDIAN && !defined(WITH_INTERLEAVED_MAP) && !defined(WITH_BLOCKED_MAP)
 	reader->CopyBytes((byte *) _m, size * 8);
 #else
 	for (TileIndex i = 0; i != size; i++) {
@@ -245,7 +241,7 @@ static void Load_WMAP()
 			_me[i].m7 = reader->RawReadByte();
 		}
 	} else if (_sl_xv_feature_versions[XSLFI_WHOLE_MAP_CHUNK] == 2) {
-#if TTD_ENDIAN == TTD_LITTLE_ENDIAN
+#if TTD_ENDIAN == TTD_LITTLE_ENDIAN && !defined(WITH_INTERLEAVED_MAP) && !defined(WITH_BLOCKED_MAP)
 		reader->CopyBytes((byte *) _me, size * 4);
 #else
 		for (TileIndex i = 0; i != size; i++) {
@@ -272,7 +268,7 @@ static void Save_WMAP()
 	const TileIndex size = MapSize();
 	SlSetLength(size * 12);
 
-#if TTD_ENDIAN == TTD_LITTLE_ENDIAN
+#if TTD_ENDIAN == TTD_LITTLE_ENDIAN && !defined(WITH_INTERLEAVED_MAP) && !defined(WITH_BLOCKED_MAP)
 	dumper->CopyBytes((byte *) _m, size * 8);
 	dumper->CopyBytes((byte *) _me, size * 4);
 #else
@@ -297,83 +293,21 @@ static void Save_WMAP()
 #endif
 }
 
-struct MAPT {
-	typedef uint8 FieldT;
-	static const FieldT &GetField(TileIndex t) { return _m[t].type; }
-};
-
-struct MAPH {
-	typedef uint8 FieldT;
-	static const FieldT &GetField(TileIndex t) { return _m[t].height; }
-};
-
-struct MAP1 {
-	typedef uint8 FieldT;
-	static const FieldT &GetField(TileIndex t) { return _m[t].m1; }
-};
-
-struct MAP2 {
-	typedef uint16 FieldT;
-	static const FieldT &GetField(TileIndex t) { return _m[t].m2; }
-};
-
-struct MAP3 {
-	typedef uint8 FieldT;
-	static const FieldT &GetField(TileIndex t) { return _m[t].m3; }
-};
-
-struct MAP4 {
-	typedef uint8 FieldT;
-	static const FieldT &GetField(TileIndex t) { return _m[t].m4; }
-};
-
-struct MAP5 {
-	typedef uint8 FieldT;
-	static const FieldT &GetField(TileIndex t) { return _m[t].m5; }
-};
-
-struct MAP6 {
-	typedef uint8 FieldT;
-	static const FieldT &GetField(TileIndex t) { return _me[t].m6; }
-};
-
-struct MAP7 {
-	typedef uint8 FieldT;
-	static const FieldT &GetField(TileIndex t) { return _me[t].m7; }
-};
-
-struct MAP8 {
-	typedef uint16 FieldT;
-	static const FieldT &GetField(TileIndex t) { return _me[t].m8; }
-};
-
-template <typename T>
-struct MAP_VarType {};
-
-template <>
-struct MAP_VarType<uint8>
-{
-	static const VarType var_type = SLE_UINT8;
-};
-
-template <>
-struct MAP_VarType<uint16>
-{
-	static const VarType var_type = SLE_UINT16;
-};
-
 template <typename T>
 static void Save_MAP()
 {
 	assert(_sl_xv_feature_versions[XSLFI_WHOLE_MAP_CHUNK] == 0);
 
-	std::array<typename T::FieldT, MAP_SL_BUF_SIZE> buf;
-	TileIndex size = MapSize();
+	typedef typename T::FieldT FieldT;
+
+	MemoryDumper *dumper = MemoryDumper::GetCurrent();
+	const TileIndex size = MapSize();
 
-	SlSetLength(size * sizeof(typename T::FieldT));
+	SlSetLength(size * sizeof(FieldT));
 	for (TileIndex i = 0; i != size;) {
-		for (uint j = 0; j != MAP_SL_BUF_SIZE; j++) buf[j] = T::GetField(i++);
-		SlArray(buf.data(), MAP_SL_BUF_SIZE, MAP_VarType<typename T::FieldT>::var_type);
+		dumper->CheckBytes(sizeof(FieldT));
+		const TileIndex end = i + std::min<TileIndex>(size - i, (TileIndex)((dumper->bufe - dumper->buf) / sizeof(FieldT)));
+		for (; i != end; i++) RawWriteMapField(dumper, T::GetField(i));
 	}
 }
 
@@ -405,16 +339,16 @@ static ChunkSaveLoadSpecialOpResult Special_MAP_Chunks(uint32 chunk_id, ChunkSav
 
 static const ChunkHandler map_chunk_handlers[] = {
 	{ 'MAPS', Save_MAPS,      Load_MAPS, nullptr, Check_MAPS, CH_RIFF },
-	{ 'MAPT', Save_MAP<MAPT>, Load_MAPT, nullptr, nullptr,    CH_RIFF, Special_MAP_Chunks },
+	{ 'MAPT', Save_MAP<MAPT>, Load_MAP<MAPT>, nullptr, nullptr,    CH_RIFF, Special_MAP_Chunks },
 	{ 'MAPH', Save_MAP<MAPH>, Load_MAPH, nullptr, Check_MAPH, CH_RIFF, Special_MAP_Chunks },
-	{ 'MAPO', Save_MAP<MAP1>, Load_MAP1, nullptr, nullptr,    CH_RIFF, Special_MAP_Chunks },
+	{ 'MAPO', Save_MAP<MAP1>, Load_MAP<MAP1>, nullptr, nullptr,    CH_RIFF, Special_MAP_Chunks },
 	{ 'MAP2', Save_MAP<MAP2>, Load_MAP2, nullptr, nullptr,    CH_RIFF, Special_MAP_Chunks },
-	{ 'M3LO', Save_MAP<MAP3>, Load_MAP3, nullptr, nullptr,    CH_RIFF, Special_MAP_Chunks },
-	{ 'M3HI', Save_MAP<MAP4>, Load_MAP4, nullptr, nullptr,    CH_RIFF, Special_MAP_Chunks },
-	{ 'MAP5', Save_MAP<MAP5>, Load_MAP5, nullptr, nullptr,    CH_RIFF, Special_MAP_Chunks },
+	{ 'M3LO', Save_MAP<MAP3>, Load_MAP<MAP3>, nullptr, nullptr,    CH_RIFF, Special_MAP_Chunks },
+	{ 'M3HI', Save_MAP<MAP4>, Load_MAP<MAP4>, nullptr, nullptr,    CH_RIFF, Special_MAP_Chunks },
+	{ 'MAP5', Save_MAP<MAP5>, Load_MAP<MAP5>, nullptr, nullptr,    CH_RIFF, Special_MAP_Chunks },
 	{ 'MAPE', Save_MAP<MAP6>, Load_MAP6, nullptr, nullptr,    CH_RIFF, Special_MAP_Chunks },
-	{ 'MAP7', Save_MAP<MAP7>, Load_MAP7, nullptr, nullptr,    CH_RIFF, Special_MAP_Chunks },
-	{ 'MAP8', Save_MAP<MAP8>, Load_MAP8, nullptr, nullptr,    CH_RIFF, Special_MAP_Chunks },
+	{ 'MAP7', Save_MAP<MAP7>, Load_MAP<MAP7>, nullptr, nullptr,    CH_RIFF, Special_MAP_Chunks },
+	{ 'MAP8', Save_MAP<MAP8>, Load_MAP<MAP8>, nullptr, nullptr,    CH_RIFF, Special_MAP_Chunks },
 	{ 'WMAP', Save_WMAP,      Load_WMAP, nullptr, nullptr,    CH_RIFF, Special_WMAP },
 };
 
@@ -46,6 +46,7 @@
 #include "../error.h"
 #include "../scope.h"
 #include "../core/ring_buffer.hpp"
+#include "../framerate_type.h"
 #include <atomic>
 #include <string>
 #ifdef __EMSCRIPTEN__
@@ -64,6 +65,9 @@
 #include <vector>
 
 #include "../thread.h"
+#include "../worker_thread.h"
+#include <deque>
+#include <memory>
 #include <mutex>
 #include <condition_variable>
 #if defined(__MINGW32__)
@@ -71,6 +75,12 @@
 #include "../3rdparty/mingw-std-threads/mingw.condition_variable.h"
 #endif
 
+#if defined(UNIX) && !defined(__EMSCRIPTEN__)
+#include <sys/wait.h>
+#include <unistd.h>
+#define WITH_FORK_SAVE
+#endif
+
 #include "../safeguards.h"
 
 extern const SaveLoadVersion SAVEGAME_VERSION = SLV_CUSTOM_SUBSIDY_DURATION; ///< Current savegame version of OpenTTD.
@@ -135,6 +145,32 @@ void ReadBuffer::SkipBytesSlowPath(size_t bytes)
 	}
 }
 
+/**
+ * Copy bytes which are not in the buffer yet.
+ * Whole buffer sizes are read from the filter directly into the destination, which saves a copy for large arrays such as the map.
+ * @param ptr Destination.
+ * @param length Number of bytes to copy, the buffer must be empty.
+ */
+void ReadBuffer::CopyBytesSlowPath(byte *ptr, size_t length)
+{
+	assert(this->bufp == this->bufe);
+	while (length >= MEMORY_CHUNK_SIZE) {
+		size_t len = this->reader->Read(ptr, length);
+		if (len == 0) SlErrorCorrupt("Unexpected end of chunk");
+		this->read += len;
+		ptr += len;
+		length -= len;
+	}
+	while (length > 0) {
+		this->AcquireBytes();
+		size_t to_copy = std::min<size_t>(this->bufe - this->bufp, length);
+		memcpy(ptr, this->bufp, to_copy);
+		this->bufp += to_copy;
+		ptr += to_copy;
+		length -= to_copy;
+	}
+}
+
 void ReadBuffer::AcquireBytes()
 {
 	size_t remainder = this->bufe - this->bufp;
@@ -482,6 +518,9 @@ void NORETURN CDECL SlErrorCorruptFmt(const char *format, ...)
 typedef void (*AsyncSaveFinishProc)();                      ///< Callback for when the savegame loading is finished.
 static std::atomic<AsyncSaveFinishProc> _async_save_finish; ///< Callback to call when the savegame loading is finished.
 static std::thread _save_thread;                            ///< The thread we're using to compress and write a savegame
+#if defined(WITH_FORK_SAVE)
+static pid_t _save_child_pid = -1;                          ///< The forked process writing a savegame, or -1
+#endif
 
 /**
  * Called by save thread to tell we finished saving.
@@ -495,11 +534,43 @@ static void SetAsyncSaveFinish(AsyncSaveFinishProc proc)
 	_async_save_finish.store(proc, std::memory_order_release);
 }
 
+#if defined(WITH_FORK_SAVE)
+static void SaveFileDone();
+
+/**
+ * Check whether the forked savegame process has finished, and if so finish the save.
+ * @param wait Whether to wait for the process to finish.
+ */
+static void CheckForkedSaveFinished(bool wait)
+{
+	if (_save_child_pid == -1) return;
+
+	int status = 0;
+	pid_t ret;
+	do {
+		ret = waitpid(_save_child_pid, &status, wait ? 0 : WNOHANG);
+	} while (ret == -1 && errno == EINTR);
+	if (ret == 0) return;
+
+	if (ret == -1 || !WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+		DEBUG(sl, 0, "Savegame process %d failed", (int)_save_child_pid);
+	} else {
+		DEBUG(sl, 2, "Savegame process %d finished", (int)_save_child_pid);
+	}
+	_save_child_pid = -1;
+	SaveFileDone();
+}
+#endif /* WITH_FORK_SAVE */
+
 /**
  * Handle async save finishes.
  */
 void ProcessAsyncSaveFinish()
 {
+#if defined(WITH_FORK_SAVE)
+	CheckForkedSaveFinished(false);
+#endif
+
 	AsyncSaveFinishProc proc = _async_save_finish.exchange(nullptr, std::memory_order_acq_rel);
 	if (proc == nullptr) return;
 
@@ -2422,6 +2493,16 @@ static void SlLoadCheckChunks()
 		return;
 	}
 
+	/* Only a few chunks fill the check data, so stop reading the savegame once all of them have been seen.
+	 * Chunks with a special handler may be checked by an upstream handler, so those are waited for as well.
+	 * When any of these chunks is absent, the whole savegame is read as before. */
+	std::vector<uint32> remaining;
+	for (auto &ch : ChunkHandlers()) {
+		if (ch.special_proc == nullptr && ch.load_check_proc == nullptr) continue;
+		if ((ch.id == 'DBGL' || ch.id == 'DBGC') && !_load_check_data.want_debug_data) continue;
+		remaining.push_back(ch.id);
+	}
+
 	uint32 id;
 	const ChunkHandler *ch;
 
@@ -2438,6 +2519,15 @@ static void SlLoadCheckChunks()
 		}
 		SlLoadCheckChunk(ch);
 		DEBUG(sl, 3, "Loaded chunk %c%c%c%c (" PRINTF_SIZE " bytes)", id >> 24, id >> 16, id >> 8, id, SlGetBytesRead() - read);
+
+		auto iter = std::find(remaining.begin(), remaining.end(), id);
+		if (iter != remaining.end()) {
+			remaining.erase(iter);
+			if (remaining.empty()) {
+				DEBUG(sl, 2, "All chunks for savegame checking loaded, skipping the rest");
+				break;
+			}
+		}
 	}
 }
 
@@ -3026,14 +3116,329 @@ struct ZSTDSaveFilter : SaveFilter {
 
 #endif /* WITH_LIBZSTD */
 
+/*********************************************
+ ******** START OF BLOCK-PARALLEL CODE *******
+ *********************************************/
+
+#if defined(WITH_ZLIB) || defined(WITH_ZSTD)
+
+/*
+ * The block-parallel formats split the savegame data into blocks of at most
+ * BLOCK_FILTER_BLOCK_SIZE bytes, which are compressed independently of each other
+ * on the general worker pool. Each block is preceded by its compressed and its
+ * uncompressed size, as big endian 32 bit values, so a reader can locate and
+ * schedule the next blocks without decompressing the current one. A compressed
+ * size of 0 ends the stream. As blocks do not depend on each other, a corrupt
+ * block does not affect the decoding of any other block.
+ */
+
+static const size_t BLOCK_FILTER_BLOCK_SIZE = 4 << 20;      ///< Uncompressed size of the blocks written.
+static const size_t BLOCK_FILTER_MAX_BLOCK_SIZE = 64 << 20; ///< Largest uncompressed block size accepted on load.
+
+/** Compression or decompression job of a single block. */
+struct BlockFilterJob {
+	std::vector<byte> input;      ///< Data to compress or decompress.
+	std::vector<byte> output;     ///< Compressed or decompressed data.
+	byte compression_level = 0;   ///< Compression level, only used for compression.
+	const char *error = nullptr;  ///< Error message if the job failed, nullptr otherwise.
+	bool done = false;            ///< Whether the job has finished, guarded by BlockFilterQueue::lock.
+};
+
+/** Queue of the block jobs of a filter, in stream order. */
+struct BlockFilterQueue {
+	std::mutex lock;                                   ///< Lock for BlockFilterJob::done.
+	std::condition_variable done_cv;                   ///< Notified when a job has finished.
+	std::deque<std::unique_ptr<BlockFilterJob>> jobs;  ///< Jobs in stream order, only accessed by the thread owning the filter.
+	uint max_in_flight;                                ///< Maximum number of queued jobs.
+
+	BlockFilterQueue() : max_in_flight(Clamp<uint>(std::thread::hardware_concurrency(), 1, 16) * 2) {}
+
+	/** Make sure no job still refers to this queue. */
+	~BlockFilterQueue()
+	{
+		std::unique_lock<std::mutex> lk(this->lock);
+		for (const auto &job : this->jobs) {
+			this->done_cv.wait(lk, [&]() { return job->done; });
+		}
+	}
+
+	/**
+	 * Run a job on the general worker pool.
+	 * @param job Job, which must have been added to #jobs.
+	 * @tparam F Function doing the actual work.
+	 */
+	template <void F(BlockFilterJob &)>
+	void Enqueue(BlockFilterJob *job)
+	{
+		_general_worker_pool.EnqueueJob([](void *data1, void *data2, void *data3) {
+			BlockFilterQueue *queue = static_cast<BlockFilterQueue *>(data1);
+			BlockFilterJob *job = static_cast<BlockFilterJob *>(data2);
+			F(*job);
+			std::lock_guard<std::mutex> lk(queue->lock);
+			job->done = true;
+			queue->done_cv.notify_all();
+		}, this, job);
+	}
+
+	/**
+	 * Wait for the first job and remove it from the queue.
+	 * @return The finished job.
+	 */
+	std::unique_ptr<BlockFilterJob> PopFront()
+	{
+		std::unique_ptr<BlockFilterJob> job = std::move(this->jobs.front());
+		{
+			std::unique_lock<std::mutex> lk(this->lock);
+			this->done_cv.wait(lk, [&]() { return job->done; });
+		}
+		this->jobs.pop_front();
+		return job;
+	}
+};
+
+/**
+ * Filter compressing the savegame in independent blocks, in parallel.
+ * @tparam Tcodec Block codec, providing Compress and Decompress functions operating on a #BlockFilterJob.
+ */
+template <typename Tcodec>
+struct BlockSaveFilter : SaveFilter {
+	BlockFilterQueue queue;                  ///< Blocks being compressed.
+	std::unique_ptr<BlockFilterJob> current; ///< Block being filled.
+	byte compression_level;                  ///< Compression level of the blocks.
+	uint blocks = 0;                         ///< Number of blocks written.
+
+	/**
+	 * Initialise this filter.
+	 * @param chain             The next filter in this chain.
+	 * @param compression_level The requested level of compression.
+	 */
+	BlockSaveFilter(SaveFilter *chain, byte compression_level) : SaveFilter(chain), compression_level(compression_level)
+	{
+	}
+
+	/** Write the first queued block to the next filter. */
+	void WriteFront()
+	{
+		std::unique_ptr<BlockFilterJob> job = this->queue.PopFront();
+		if (job->error != nullptr) SlError(STR_GAME_SAVELOAD_ERROR_BROKEN_INTERNAL_ERROR, job->error);
+
+		uint32 header[2] = { TO_BE32((uint32)job->output.size()), TO_BE32((uint32)job->input.size()) };
+		this->chain->Write(reinterpret_cast<byte *>(header), sizeof(header));
+		this->chain->Write(job->output.data(), job->output.size());
+		this->blocks++;
+	}
+
+	/** Start compressing the current block. */
+	void SubmitCurrent()
+	{
+		BlockFilterJob *job = this->current.get();
+		job->compression_level = this->compression_level;
+		this->queue.jobs.push_back(std::move(this->current));
+		this->queue.Enqueue<Tcodec::Compress>(job);
+
+		while (this->queue.jobs.size() >= this->queue.max_in_flight) this->WriteFront();
+	}
+
+	void Write(byte *buf, size_t size) override
+	{
+		while (size > 0) {
+			if (this->current == nullptr) {
+				this->current.reset(new BlockFilterJob());
+				this->current->input.reserve(BLOCK_FILTER_BLOCK_SIZE);
+			}
+			size_t n = std::min(size, BLOCK_FILTER_BLOCK_SIZE - this->current->input.size());
+			this->current->input.insert(this->current->input.end(), buf, buf + n);
+			buf += n;
+			size -= n;
+			if (this->current->input.size() == BLOCK_FILTER_BLOCK_SIZE) this->SubmitCurrent();
+		}
+	}
+
+	void Finish() override
+	{
+		if (this->current != nullptr) this->SubmitCurrent();
+		while (!this->queue.jobs.empty()) this->WriteFront();
+
+		uint32 end[2] = { 0, 0 };
+		this->chain->Write(reinterpret_cast<byte *>(end), sizeof(end));
+		DEBUG(sl, 3, "Wrote %u compressed blocks", this->blocks);
+		this->chain->Finish();
+	}
+};
+
+/**
+ * Filter decompressing a savegame written by #BlockSaveFilter.
+ * The next blocks are read ahead and decompressed in parallel.
+ * @tparam Tcodec Block codec, providing Compress and Decompress functions operating on a #BlockFilterJob.
+ */
+template <typename Tcodec>
+struct BlockLoadFilter : LoadFilter {
+	BlockFilterQueue queue;                  ///< Blocks being decompressed.
+	std::unique_ptr<BlockFilterJob> current; ///< Block being read from.
+	size_t current_pos = 0;                  ///< Read position in the output of #current.
+	uint blocks = 0;                         ///< Number of blocks read from the next filter.
+	bool end_of_stream = false;              ///< Whether the end marker has been read.
+
+	/**
+	 * Initialise this filter.
+	 * @param chain The next filter in this chain.
+	 */
+	BlockLoadFilter(LoadFilter *chain) : LoadFilter(chain)
+	{
+	}
+
+	/**
+	 * Read exactly \a size bytes from the next filter.
+	 * @param buf Buffer to read into.
+	 * @param size Number of bytes to read.
+	 */
+	void ReadFully(byte *buf, size_t size)
+	{
+		while (size > 0) {
+			size_t n = this->chain->Read(buf, size);
+			if (n == 0) SlErrorCorruptFmt("Unexpected end of savegame in compressed block %u", this->blocks);
+			buf += n;
+			size -= n;
+		}
+	}
+
+	/** Read blocks from the next filter and start decompressing them, until the queue is full. */
+	void FillQueue()
+	{
+		while (!this->end_of_stream && this->queue.jobs.size() < this->queue.max_in_flight) {
+			uint32 header[2];
+			this->ReadFully(reinterpret_cast<byte *>(header), sizeof(header));
+			const uint32 compressed_size = FROM_BE32(header[0]);
+			const uint32 uncompressed_size = FROM_BE32(header[1]);
+			if (compressed_size == 0) {
+				this->end_of_stream = true;
+				break;
+			}
+			if (uncompressed_size > BLOCK_FILTER_MAX_BLOCK_SIZE || compressed_size > Tcodec::CompressBound(BLOCK_FILTER_MAX_BLOCK_SIZE)) {
+				SlErrorCorruptFmt("Invalid size of compressed block %u", this->blocks);
+			}
+
+			std::unique_ptr<BlockFilterJob> job(new BlockFilterJob());
+			job->input.resize(compressed_size);
+			this->ReadFully(job->input.data(), compressed_size);
+			job->output.resize(uncompressed_size);
+			this->blocks++;
+
+			BlockFilterJob *ptr = job.get();
+			this->queue.jobs.push_back(std::move(job));
+			this->queue.Enqueue<Tcodec::Decompress>(ptr);
+		}
+	}
+
+	size_t Read(byte *buf, size_t size) override
+	{
+		size_t total = 0;
+		while (total < size) {
+			if (this->current == nullptr || this->current_pos == this->current->output.size()) {
+				this->current.reset();
+				this->FillQueue();
+				if (this->queue.jobs.empty()) break;
+
+				const uint block = this->blocks - (uint)this->queue.jobs.size();
+				this->current = this->queue.PopFront();
+				this->current_pos = 0;
+				if (this->current->error != nullptr) SlErrorCorruptFmt("Compressed block %u is corrupt: %s", block, this->current->error);
+
+				/* Keep the workers busy while this block is consumed. */
+				this->FillQueue();
+				continue;
+			}
+
+			size_t n = std::min(size - total, this->current->output.size() - this->current_pos);
+			memcpy(buf + total, this->current->output.data() + this->current_pos, n);
+			this->current_pos += n;
+			total += n;
+		}
+		return total;
+	}
+};
+
+#endif /* WITH_ZLIB || WITH_ZSTD */
+
+#if defined(WITH_ZLIB)
+
+/** Block codec using zlib for #BlockSaveFilter and #BlockLoadFilter. */
+struct ZlibBlockCodec {
+	static size_t CompressBound(size_t size)
+	{
+		return compressBound((uLong)size);
+	}
+
+	static void Compress(BlockFilterJob &job)
+	{
+		uLongf size = compressBound((uLong)job.input.size());
+		job.output.resize(size);
+		if (compress2(job.output.data(), &size, job.input.data(), (uLong)job.input.size(), job.compression_level) != Z_OK) {
+			job.error = "zlib returned error code";
+			return;
+		}
+		job.output.resize(size);
+	}
+
+	static void Decompress(BlockFilterJob &job)
+	{
+		uLongf size = (uLongf)job.output.size();
+		if (uncompress(job.output.data(), &size, job.input.data(), (uLong)job.input.size()) != Z_OK || size != job.output.size()) {
+			job.error = "inflate failed";
+		}
+		job.input = {};
+	}
+};
+
+#endif /* WITH_ZLIB */
+
+#if defined(WITH_ZSTD)
+
+/** Block codec using zstd for #BlockSaveFilter and #BlockLoadFilter; every block is a single frame with content checksum. */
+struct ZSTDBlockCodec {
+	static size_t CompressBound(size_t size)
+	{
+		return ZSTD_compressBound(size);
+	}
+
+	static void Compress(BlockFilterJob &job)
+	{
+		ZSTD_CCtx *zstd = ZSTD_createCCtx();
+		if (zstd == nullptr) {
+			job.error = "cannot initialize compressor";
+			return;
+		}
+		job.output.resize(ZSTD_compressBound(job.input.size()));
+		size_t size = 0;
+		if (ZSTD_isError(ZSTD_CCtx_setParameter(zstd, ZSTD_c_compressionLevel, (int)job.compression_level - 100))) {
+			job.error = "invalid compresison level";
+		} else if (ZSTD_isError(ZSTD_CCtx_setParameter(zstd, ZSTD_c_checksumFlag, 1)) ||
+				ZSTD_isError(size = ZSTD_compress2(zstd, job.output.data(), job.output.size(), job.input.data(), job.input.size()))) {
+			job.error = "libzstd returned error code";
+		}
+		ZSTD_freeCCtx(zstd);
+		job.output.resize(job.error == nullptr ? size : 0);
+	}
+
+	static void Decompress(BlockFilterJob &job)
+	{
+		size_t size = ZSTD_decompress(job.output.data(), job.output.size(), job.input.data(), job.input.size());
+		if (ZSTD_isError(size) || size != job.output.size()) job.error = "libzstd returned error code";
+		job.input = {};
+	}
+};
+
+#endif /* WITH_ZSTD */
+
 /*******************************************
  ************* END OF CODE *****************
  *******************************************/
 
 enum SaveLoadFormatFlags : byte {
 	SLF_NONE             = 0,
-	SLF_NO_THREADED_LOAD = 1 << 0, ///< Unsuitable for threaded loading
+	SLF_NO_THREADED_LOAD = 1 << 0, ///< Unsuitable for threaded loading, or reads ahead on its own
 	SLF_REQUIRES_ZSTD    = 1 << 1, ///< Automatic selection requires the zstd flag
+	SLF_NO_AUTO_SELECT   = 1 << 2, ///< Never selected automatically, only when explicitly configured
 };
 DECLARE_ENUM_AS_BIT_SET(SaveLoadFormatFlags);
 
@@ -3089,6 +3494,19 @@ static const SaveLoadFormat _saveload_formats[] = {
 	{"zstd",   TO_BE32X('OTTS'), CreateLoadFilter<ZSTDLoadFilter>,   CreateSaveFilter<ZSTDSaveFilter>,   0, 101, 122, SLF_REQUIRES_ZSTD},
 #else
 	{"zstd",   TO_BE32X('OTTS'), nullptr,                            nullptr,                            0, 0, 0, SLF_REQUIRES_ZSTD},
+#endif
+	/* The block-parallel formats compress independent blocks of 4 MB on the worker threads. They are slightly larger than
+	 * their single stream counterparts at the same level, but compression and decompression scale with the number of cores.
+	 * They are only used when explicitly configured, as older versions can not load them. */
+#if defined(WITH_ZLIB)
+	{"zlib_mt", TO_BE32X('OTTY'), CreateLoadFilter<BlockLoadFilter<ZlibBlockCodec>>, CreateSaveFilter<BlockSaveFilter<ZlibBlockCodec>>, 0, 6, 9, SLF_NO_AUTO_SELECT | SLF_NO_THREADED_LOAD},
+#else
+	{"zlib_mt", TO_BE32X('OTTY'), nullptr,                            nullptr,                            0, 0, 0, SLF_NO_AUTO_SELECT | SLF_NO_THREADED_LOAD},
+#endif
+#if defined(WITH_ZSTD)
+	{"zstd_mt", TO_BE32X('OTTT'), CreateLoadFilter<BlockLoadFilter<ZSTDBlockCodec>>, CreateSaveFilter<BlockSaveFilter<ZSTDBlockCodec>>, 0, 101, 122, SLF_NO_AUTO_SELECT | SLF_NO_THREADED_LOAD},
+#else
+	{"zstd_mt", TO_BE32X('OTTT'), nullptr,                            nullptr,                            0, 0, 0, SLF_NO_AUTO_SELECT | SLF_NO_THREADED_LOAD},
 #endif
 };
 
@@ -3104,7 +3522,7 @@ static const SaveLoadFormat *GetSavegameFormat(const std::string &full_name, byt
 	const SaveLoadFormat *def = lastof(_saveload_formats);
 
 	/* find default savegame format, the highest one with which files can be written */
-	while (!def->init_write || ((def->flags & SLF_REQUIRES_ZSTD) && !(flags & SMF_ZSTD_OK))) def--;
+	while (!def->init_write || (def->flags & SLF_NO_AUTO_SELECT) || ((def->flags & SLF_REQUIRES_ZSTD) && !(flags & SMF_ZSTD_OK))) def--;
 
 	if (!full_name.empty()) {
 		/* Get the ":..." of the compression level out of the way */
@@ -3230,6 +3648,8 @@ static void SaveFileError()
  */
 static SaveOrLoadResult SaveFileToDisk(bool threaded)
 {
+	PerformanceTraceScope trace("Savegame write to disk");
+
 	try {
 		byte compression;
 		const SaveLoadFormat *fmt = GetSavegameFormat(_savegame_format, &compression, _sl.save_flags);
@@ -3272,6 +3692,10 @@ static SaveOrLoadResult SaveFileToDisk(bool threaded)
 
 void WaitTillSaved()
 {
+#if defined(WITH_FORK_SAVE)
+	CheckForkedSaveFinished(true);
+#endif
+
 	if (!_save_thread.joinable()) return;
 
 	_save_thread.join();
@@ -3315,6 +3739,38 @@ static SaveOrLoadResult DoSave(SaveFilter *writer, bool threaded)
 	return SL_OK;
 }
 
+#if defined(WITH_FORK_SAVE)
+/**
+ * Save the game in a forked child process.
+ * The child serialises and compresses the game from its copy-on-write snapshot of the game state,
+ * while this process continues immediately. Completion is handled by #ProcessAsyncSaveFinish.
+ * @param file The file to write the savegame to, it is closed in this process.
+ * @return True if the child process was started, false if the game has to be saved in this process.
+ */
+static bool DoForkSave(FILE *file)
+{
+	pid_t pid = fork();
+	if (pid == -1) {
+		DEBUG(sl, 1, "Cannot fork savegame process, reverting to in-process saving...");
+		return false;
+	}
+
+	if (pid == 0) {
+		/* Only this thread exists in the child, so everything has to run on it. */
+		_general_worker_pool.DetachAfterFork();
+		SaveOrLoadResult result = DoSave(new FileWriter(file), false);
+		_exit(result == SL_OK ? 0 : 1);
+	}
+
+	DEBUG(sl, 2, "Saving in process %d", (int)pid);
+	fclose(file);
+	ClearSaveLoadState();
+	_save_child_pid = pid;
+	SaveFileStart();
+	return true;
+}
+#endif /* WITH_FORK_SAVE */
+
 /**
  * Save the game using a (writer) filter.
  * @param writer   The filter to write the savegame to.
@@ -3450,6 +3906,27 @@ struct ThreadedLoadFilter : LoadFilter {
 	}
 };
 
+/**
+ * Create a filter which decompresses a savegame, such that it can be decompressed ahead of actually loading it.
+ * @param hdr   The savegame header; on success its tag is changed to that of an uncompressed savegame.
+ * @param chain The filter to read the compressed data, which follows the header, from.
+ * @return The decompression filter, or nullptr when the format is unknown, not compressed or not supported for this.
+ * @note The filter may be used from a thread other than the main thread.
+ */
+LoadFilter *CreateSavegameDecompressionFilter(uint32 hdr[2], LoadFilter *chain)
+{
+	for (const SaveLoadFormat &fmt : _saveload_formats) {
+		if (fmt.tag != hdr[0]) continue;
+
+		/* LZO savegames may be of the buggy format, which is detected when loading. */
+		if (fmt.init_load == nullptr || fmt.tag == TO_BE32X('OTTN') || fmt.tag == TO_BE32X('OTTD')) return nullptr;
+
+		hdr[0] = TO_BE32X('OTTN');
+		return fmt.init_load(chain);
+	}
+	return nullptr;
+}
+
 /**
  * Actually perform the loading of a "non-old" savegame.
  * @param reader     The filter to read the savegame from.
@@ -3785,6 +4262,10 @@ SaveOrLoadResult SaveOrLoad(const std::string &filename, SaveLoadOperation fop,
 			DEBUG(desync, 1, "save: date{%08x; %02x; %02x}; %s", _date, _date_fract, _tick_skip_counter, filename.c_str());
 			if (!_settings_client.gui.threaded_saves) threaded = false;
 
+#if defined(WITH_FORK_SAVE)
+			if (threaded && _network_dedicated && _settings_client.gui.fork_saves && DoForkSave(fh)) return SL_OK;
+#endif
+
 			return DoSave(new FileWriter(fh), threaded);
 		}
 
@@ -72,6 +72,7 @@ void DoAutoOrNetsave(FiosNumberedSaveName &counter, bool threaded, FiosNumberedS
 
 SaveOrLoadResult SaveWithFilter(struct SaveFilter *writer, bool threaded, SaveModeFlags flags);
 SaveOrLoadResult LoadWithFilter(struct LoadFilter *reader);
+struct LoadFilter *CreateSavegameDecompressionFilter(uint32 hdr[2], struct LoadFilter *chain);
 bool IsNetworkServerSave();
 bool IsScenarioSave();
 
@@ -43,6 +43,7 @@ struct ReadBuffer {
 	static ReadBuffer *GetCurrent();
 
 	void SkipBytesSlowPath(size_t bytes);
+	void CopyBytesSlowPath(byte *ptr, size_t length);
 	void AcquireBytes();
 
 	inline void SkipBytes(size_t bytes)
@@ -113,16 +114,10 @@ struct ReadBuffer {
 
 	inline void CopyBytes(byte *ptr, size_t length)
 	{
-		while (length) {
-			if (unlikely(this->bufp == this->bufe)) {
-				this->AcquireBytes();
-			}
-			size_t to_copy = std::min<size_t>(this->bufe - this->bufp, length);
-			memcpy(ptr, this->bufp, to_copy);
-			this->bufp += to_copy;
-			ptr += to_copy;
-			length -= to_copy;
-		}
+		size_t to_copy = std::min<size_t>(this->bufe - this->bufp, length);
+		memcpy(ptr, this->bufp, to_copy);
+		this->bufp += to_copy;
+		if (unlikely(to_copy != length)) this->CopyBytesSlowPath(ptr + to_copy, length - to_copy);
 	}
 
 	/**
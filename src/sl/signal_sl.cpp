@@ -133,17 +133,19 @@ static void Save_SPRG()
 	// Check for, and dispose of, any signal information on a tile which doesn't have signals.
 	// This indicates that someone removed the signals from the tile but didn't clean them up.
 	// (This code is to detect bugs and limit their consquences, not to cover them up!)
-	for(ProgramList::iterator i = _signal_programs.begin(), e = _signal_programs.end();
-			i != e; ++i) {
-		SignalReference ref = i->first;
+	std::vector<SignalReference> leaked;
+	for (const auto &it : _signal_programs) {
+		SignalReference ref = it.first;
 		if(!HasProgrammableSignals(ref)) {
 			DEBUG(sl, 0, "Programmable pre-signal information for (%x, %d) has been leaked!",
 						ref.tile, ref.track);
-			++i;
-			FreeSignalProgram(ref);
-			if(i == e) break;
+			leaked.push_back(ref);
 		}
 	}
+	/* Freeing a program erases it from the program list, which invalidates its iterators */
+	for (SignalReference ref : leaked) {
+		FreeSignalProgram(ref);
+	}
 
 	// OK, we can now write out our programs
 	Buffer b;
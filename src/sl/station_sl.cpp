@@ -143,6 +143,8 @@ void AfterLoadStations()
  */
 void AfterLoadRoadStops()
 {
+	RoadStop::RebuildTileIndex();
+
 	/* First construct the drive through entries */
 	for (RoadStop *rs : RoadStop::Iterate()) {
 		if (IsDriveThroughStopTile(rs->xy)) rs->MakeDriveThrough();
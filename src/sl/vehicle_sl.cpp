@@ -529,6 +529,9 @@ void AfterLoadVehicles(bool part_of_load)
 		v->UpdateViewport(false);
 		v->cargo.AssertCountConsistency();
 	}
+
+	/* Order lists which were deleted before saving leave holes in the pool, remove them. */
+	if (part_of_load) OrderList::CompactPoolIndices();
 }
 
 void AfterLoadVehiclesRemoveAnyFoundInvalid()
@@ -1576,12 +1579,33 @@ void Load_VLKA()
 	}
 }
 
+static void Save_VDDS()
+{
+	SlSetLength(4 + (_deferred_depot_searches.size() * 12));
+	SlWriteUint32((uint32)_deferred_depot_searches.size());
+	for (const DeferredDepotSearch &search : _deferred_depot_searches) {
+		SlWriteUint32(search.veh);
+		SlWriteUint64(search.deadline);
+	}
+}
+
+static void Load_VDDS()
+{
+	uint32 count = SlReadUint32();
+	_deferred_depot_searches.resize(count);
+	for (DeferredDepotSearch &search : _deferred_depot_searches) {
+		search.veh = SlReadUint32();
+		search.deadline = SlReadUint64();
+	}
+}
+
 static const ChunkHandler veh_chunk_handlers[] = {
 	{ 'VEHS', Save_VEHS, Load_VEHS, Ptrs_VEHS, nullptr, CH_SPARSE_ARRAY },
 	{ 'VEOX', Save_VEOX, Load_VEOX, nullptr,   nullptr, CH_SPARSE_ARRAY },
 	{ 'VESR', Save_VESR, Load_VESR, nullptr,   nullptr, CH_SPARSE_ARRAY },
 	{ 'VENC', Save_VENC, Load_VENC, nullptr,   nullptr, CH_RIFF,         Special_VENC },
 	{ 'VLKA', Save_VLKA, Load_VLKA, nullptr,   nullptr, CH_SPARSE_ARRAY },
+	{ 'VDDS', Save_VDDS, Load_VDDS, nullptr,   nullptr, CH_RIFF },
 };
 
 extern const ChunkHandlerTable _veh_chunk_handlers(veh_chunk_handlers);
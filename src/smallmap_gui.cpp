@@ -166,6 +166,39 @@ static bool _smallmap_industry_highlight_state;
 /** For connecting company ID to position in owner list (small map legend) */
 uint _company_to_list_pos[MAX_COMPANIES];
 
+/** Value of an entry of #_smallmap_tile_colour_cache whose colours have to be looked up again. */
+static const uint32 SMALLMAP_TILE_COLOUR_INVALID = 0xD7D7D7D7;
+
+/**
+ * Colours of the groups of tiles drawn by the smallmap window, so redrawing does not have to look at every tile again.
+ * Indexed by the group's Y coordinate times #_smallmap_tile_colour_cache_stride plus its X coordinate.
+ * Empty when the cache is not in use.
+ */
+static std::vector<uint32> _smallmap_tile_colour_cache;
+static uint _smallmap_tile_colour_cache_stride; ///< Number of tile groups in a row of #_smallmap_tile_colour_cache.
+static uint _smallmap_tile_colour_cache_zoom;   ///< Number of tiles along each side of a tile group.
+static uint32 _smallmap_tile_colour_cache_key;  ///< Map type and colour settings for which #_smallmap_tile_colour_cache is valid.
+
+/**
+ * Tile changed, so its colours in the smallmap have to be looked up again.
+ * @param tile The tile that changed.
+ */
+void InvalidateSmallMapTileColour(TileIndex tile)
+{
+	if (_smallmap_tile_colour_cache.empty()) return;
+
+	const uint idx = (TileY(tile) / _smallmap_tile_colour_cache_zoom) * _smallmap_tile_colour_cache_stride + (TileX(tile) / _smallmap_tile_colour_cache_zoom);
+	if (idx < _smallmap_tile_colour_cache.size()) _smallmap_tile_colour_cache[idx] = SMALLMAP_TILE_COLOUR_INVALID;
+}
+
+/**
+ * Look up the colours of all tiles in the smallmap again, e.g. because the legend or the colour scheme changed.
+ */
+void InvalidateSmallMapTileColours()
+{
+	_smallmap_tile_colour_cache.clear();
+}
+
 static void NotifyAllViewports(ViewportMapType map_type)
 {
 	for (Window *w : Window::Iterate()) {
@@ -187,6 +220,7 @@ void UpdateSmallMapSelectedIndustries()
 	}
 
 	NotifyAllViewports(VPMT_INDUSTRY);
+	InvalidateSmallMapTileColours();
 
 	/* Only notify the smallmap window if it exists. In particular, do not
 	 * bring it to the front to prevent messing up any nice layout of the user. */
@@ -819,17 +853,28 @@ void SmallMapWindow::DrawSmallMapColumn(void *dst, uint xc, uint yc, int pitch,
 		if (dst < _screen.dst_ptr) continue;
 		if (dst >= dst_ptr_abs_end) continue;
 
-		/* Construct tilearea covered by (xc, yc, xc + this->zoom, yc + this->zoom) such that it is within min_xy limits. */
-		TileArea ta;
-		if (min_xy == 1 && (xc == 0 || yc == 0)) {
-			if (this->tile_zoom == 1) continue; // The tile area is empty, don't draw anything.
-			ta = TileArea(TileXY(std::max(min_xy, xc), std::max(min_xy, yc)), this->tile_zoom - (xc == 0), this->tile_zoom - (yc == 0));
-		} else {
-			ta = TileArea(TileXY(xc, yc), this->tile_zoom, this->tile_zoom);
+		uint32 *cache_entry = nullptr;
+		if (!_smallmap_tile_colour_cache.empty()) {
+			cache_entry = &_smallmap_tile_colour_cache[(yc / this->tile_zoom) * _smallmap_tile_colour_cache_stride + (xc / this->tile_zoom)];
 		}
-		ta.ClampToMap(); // Clamp to map boundaries (may contain MP_VOID tiles!).
 
-		uint32 val = this->GetTileColours(ta);
+		uint32 val;
+		if (cache_entry != nullptr && *cache_entry != SMALLMAP_TILE_COLOUR_INVALID) {
+			val = *cache_entry;
+		} else {
+			/* Construct tilearea covered by (xc, yc, xc + this->zoom, yc + this->zoom) such that it is within min_xy limits. */
+			TileArea ta;
+			if (min_xy == 1 && (xc == 0 || yc == 0)) {
+				if (this->tile_zoom == 1) continue; // The tile area is empty, don't draw anything.
+				ta = TileArea(TileXY(std::max(min_xy, xc), std::max(min_xy, yc)), this->tile_zoom - (xc == 0), this->tile_zoom - (yc == 0));
+			} else {
+				ta = TileArea(TileXY(xc, yc), this->tile_zoom, this->tile_zoom);
+			}
+			ta.ClampToMap(); // Clamp to map boundaries (may contain MP_VOID tiles!).
+
+			val = this->GetTileColours(ta);
+			if (cache_entry != nullptr) *cache_entry = val;
+		}
 		uint8 *val8 = (uint8 *)&val;
 		if (this->ui_zoom == 1) {
 			int idx = std::max(0, -start_pos);
@@ -865,6 +910,28 @@ void SmallMapWindow::DrawSmallMapColumn(void *dst, uint xc, uint yc, int pitch,
 	} while (xc += this->tile_zoom, yc += this->tile_zoom, dst = blitter->MoveTo(dst, pitch * this->ui_zoom * 2, 0), y += 2 * this->ui_zoom, --reps != 0);
 }
 
+/**
+ * Make sure the tile colour cache matches the map type, zoom level and colour settings used for drawing.
+ * The cache is not used while the colours of an industry type are blinking.
+ */
+void SmallMapWindow::PrepareTileColourCache() const
+{
+	if (this->map_type == SMT_INDUSTRY && _smallmap_industry_highlight != INVALID_INDUSTRYTYPE) {
+		InvalidateSmallMapTileColours();
+		return;
+	}
+
+	const uint32 key = this->map_type | (_settings_client.gui.smallmap_land_colour << 8) | (_smallmap_show_heightmap ? 1 << 16 : 0);
+	const uint stride = CeilDiv(MapSizeX(), this->tile_zoom);
+	const size_t size = (size_t)stride * CeilDiv(MapSizeY(), this->tile_zoom);
+	if (key != _smallmap_tile_colour_cache_key || (uint)this->tile_zoom != _smallmap_tile_colour_cache_zoom || _smallmap_tile_colour_cache.size() != size) {
+		_smallmap_tile_colour_cache_key = key;
+		_smallmap_tile_colour_cache_zoom = this->tile_zoom;
+		_smallmap_tile_colour_cache_stride = stride;
+		_smallmap_tile_colour_cache.assign(size, SMALLMAP_TILE_COLOUR_INVALID);
+	}
+}
+
 /**
  * Adds vehicles to the smallmap.
  * @param dpi the part of the smallmap to be drawn into
@@ -961,6 +1028,8 @@ void SmallMapWindow::DrawSmallMap(DrawPixelInfo *dpi, bool draw_indicators) cons
 	/* Clear it */
 	GfxFillRect(dpi->left, dpi->top, dpi->left + dpi->width - 1, dpi->top + dpi->height - 1, PC_BLACK);
 
+	this->PrepareTileColourCache();
+
 	/* Which tile is displayed at (dpi->left, dpi->top)? */
 	Point tile = this->PixelToTile(dpi->left, dpi->top);
 	int tile_x = tile.x / (int)TILE_SIZE + this->tile_zoom;
@@ -1086,6 +1155,8 @@ SmallMapWindow::SmallMapWindow(WindowDesc *desc, int window_number) : Window(des
 /* virtual */ void SmallMapWindow::Close([[maybe_unused]] int data)
 {
 	this->BreakIndustryChainLink();
+	InvalidateSmallMapTileColours();
+	_smallmap_tile_colour_cache.shrink_to_fit();
 	this->Window::Close();
 }
 
@@ -1109,6 +1180,7 @@ void SmallMapWindow::RebuildColourIndexIfNecessary()
 			_heightmap_schemes[n].height_colours[z] = _heightmap_schemes[n].height_colours_base[access_index];
 		}
 	}
+	InvalidateSmallMapTileColours();
 
 	SmallMapWindow::map_height_limit = _settings_game.construction.map_height_limit;
 	BuildLandLegend();
@@ -1480,6 +1552,7 @@ int SmallMapWindow::GetPositionOnLegend(Point pt)
 						NotifyAllViewports(VPMT_OWNER);
 					}
 				}
+				InvalidateSmallMapTileColours();
 				this->SetDirty();
 			}
 			break;
@@ -1507,6 +1580,7 @@ int SmallMapWindow::GetPositionOnLegend(Point pt)
 				tbl->show_on_map = (widget == WID_SM_ENABLE_ALL);
 			}
 			if (this->map_type == SMT_LINKSTATS) this->SetOverlayCargoMask();
+			InvalidateSmallMapTileColours();
 			this->SetDirty();
 			break;
 		}
@@ -1552,6 +1626,7 @@ int SmallMapWindow::GetPositionOnLegend(Point pt)
 
 		default: NOT_REACHED();
 	}
+	InvalidateSmallMapTileColours();
 	this->SetDirty();
 }
 
@@ -52,6 +52,8 @@ void BuildIndustriesLegend();
 void ShowSmallMap();
 void BuildLandLegend();
 void BuildOwnerLegend();
+void InvalidateSmallMapTileColour(TileIndex tile);
+void InvalidateSmallMapTileColours();
 
 /** Structure for holding relevant data for legends in small map */
 struct LegendAndColour {
@@ -193,6 +195,7 @@ protected:
 	void SetOverlayCargoMask();
 	void SetupWidgetData();
 	uint32 GetTileColours(const TileArea &ta) const;
+	void PrepareTileColourCache() const;
 
 	int GetPositionOnLegend(Point pt);
 
@@ -275,8 +275,12 @@ public:
 		if (!this->IsSortable()) return false;
 
 		const bool desc = (this->flags & VL_DESC) != 0;
+		auto comp = [&](const T &a, const T &b) { return desc ? compare(b, a) : compare(a, b); };
 
-		std::sort(std::vector<T>::begin(), std::vector<T>::end(), [&](const T &a, const T &b) { return desc ? compare(b, a) : compare(a, b); });
+		/* Periodic resorts mostly find the list still in order, checking that is linear. */
+		if (std::is_sorted(std::vector<T>::begin(), std::vector<T>::end(), comp)) return false;
+
+		std::sort(std::vector<T>::begin(), std::vector<T>::end(), comp);
 		return true;
 	}
 
@@ -31,7 +31,7 @@ static void OpenBankFile(const std::string &filename)
 	 */
 	static std::unique_ptr<RandomAccessFile> original_sound_file;
 
-	memset(_original_sounds, 0, sizeof(_original_sounds));
+	std::fill(std::begin(_original_sounds), std::end(_original_sounds), SoundEntry{});
 
 	/* If there is no sound file (nosound set), don't load anything */
 	if (filename.empty()) return;
@@ -112,58 +112,86 @@ static void OpenBankFile(const std::string &filename)
 	}
 }
 
-static bool SetBankSource(MixerChannel *mc, const SoundEntry *sound)
+/**
+ * Read the samples of a sound and convert them to signed 16 bit samples at the mixer rate.
+ * The result is kept in the sound entry, so it is only done once per sound.
+ * @param sound Sound to convert.
+ * @return Whether the sound could be converted.
+ */
+static bool ConvertSound(SoundEntry *sound)
 {
 	assert(sound != nullptr);
 
+	const uint32 play_rate = MxGetRate();
+	if (sound->data != nullptr && sound->data_rate == play_rate) return true;
+
 	/* Check for valid sound size. */
 	if (sound->file_size == 0 || sound->file_size > ((size_t)-1) - 2) return false;
 
 	if (!(sound->bits_per_sample == 8 || sound->bits_per_sample == 16)) {
-		DEBUG(sound, 0, "SetBankSource: Incorrect bits_per_sample: %u", sound->bits_per_sample);
+		DEBUG(sound, 0, "ConvertSound: Incorrect bits_per_sample: %u", sound->bits_per_sample);
 		return false;
 	}
 	if (sound->channels != 1) {
-		DEBUG(sound, 0, "SetBankSource: Incorrect number of channels: %u", sound->channels);
+		DEBUG(sound, 0, "ConvertSound: Incorrect number of channels: %u", sound->channels);
 		return false;
 	}
 	if (sound->rate == 0) {
-		DEBUG(sound, 0, "SetBankSource: Incorrect rate: %u", sound->rate);
+		DEBUG(sound, 0, "ConvertSound: Incorrect rate: %u", sound->rate);
 		return false;
 	}
 
-	int8 *mem = MallocT<int8>(sound->file_size + 2);
-	/* Add two extra bytes so rate conversion can read these
-	 * without reading out of its input buffer. */
-	mem[sound->file_size    ] = 0;
-	mem[sound->file_size + 1] = 0;
-
+	std::vector<byte> raw(sound->file_size);
 	RandomAccessFile *file = sound->file;
 	file->SeekTo(sound->file_offset, SEEK_SET);
-	file->ReadBlock(mem, sound->file_size);
+	file->ReadBlock(raw.data(), sound->file_size);
 
-	/* 16-bit PCM WAV files should be signed by default */
+	/* Decode to signed 16 bit, with one extra zero sample so rate conversion can read it
+	 * without reading out of its input buffer. 8 bit PCM WAV files are unsigned,
+	 * 16 bit ones are signed and little endian. */
+	std::vector<int16> samples;
 	if (sound->bits_per_sample == 8) {
-		for (uint i = 0; i != sound->file_size; i++) {
-			mem[i] += -128; // Convert unsigned sound data to signed
+		samples.resize(sound->file_size + 1);
+		for (size_t i = 0; i != sound->file_size; i++) {
+			samples[i] = (int16)((raw[i] - 128) * 256);
+		}
+	} else {
+		samples.resize(sound->file_size / 2 + 1);
+		for (size_t i = 0; i != sound->file_size / 2; i++) {
+			samples[i] = (int16)(raw[i * 2] | (raw[i * 2 + 1] << 8));
 		}
 	}
-
-#if TTD_ENDIAN == TTD_BIG_ENDIAN
-	if (sound->bits_per_sample == 16) {
-		uint num_samples = sound->file_size / 2;
-		int16 *samples = (int16 *)mem;
-		for (uint i = 0; i < num_samples; i++) {
-			samples[i] = BSWAP16(samples[i]);
+	samples.back() = 0;
+
+	auto data = std::make_shared<std::vector<int16>>();
+	if (sound->rate == play_rate) {
+		*data = std::move(samples);
+	} else {
+		/* Resample with the same linear interpolation the mixer would otherwise do while playing. */
+		const size_t in_samples = samples.size() - 1;
+		const size_t out_samples = (size_t)((uint64)in_samples * play_rate / sound->rate);
+		const uint64 step = ((uint64)sound->rate << 16) / play_rate;
+		data->resize(out_samples + 1);
+		uint64 pos = 0;
+		for (size_t i = 0; i != out_samples; i++) {
+			const size_t idx = std::min<size_t>(pos >> 16, in_samples - 1);
+			const int frac = pos & 0xFFFF;
+			(*data)[i] = (int16)((samples[idx] * ((1 << 16) - frac) + samples[idx + 1] * frac) >> 16);
+			pos += step;
 		}
+		data->back() = 0;
 	}
-#endif
 
-	assert(sound->bits_per_sample == 8 || sound->bits_per_sample == 16);
-	assert(sound->channels == 1);
-	assert(sound->file_size != 0 && sound->rate != 0);
+	sound->data = std::move(data);
+	sound->data_rate = play_rate;
+	return true;
+}
+
+static bool SetBankSource(MixerChannel *mc, SoundEntry *sound)
+{
+	if (!ConvertSound(sound) || sound->data->size() <= 1) return false;
 
-	MxSetChannelRawSrc(mc, mem, sound->file_size, sound->rate, sound->bits_per_sample == 16);
+	MxSetChannelRawSrc(mc, sound->data, sound->data->size() - 1, sound->data_rate);
 
 	return true;
 }
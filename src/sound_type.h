@@ -10,6 +10,9 @@
 #ifndef SOUND_TYPE_H
 #define SOUND_TYPE_H
 
+#include <memory>
+#include <vector>
+
 struct SoundEntry {
 	class RandomAccessFile *file;
 	size_t file_offset;
@@ -20,6 +23,10 @@ struct SoundEntry {
 	uint8 volume;
 	uint8 priority;
 	byte grf_container_ver; ///< NewGRF container version if the sound is from a NewGRF.
+
+	/** Signed 16 bit samples at #data_rate, followed by one zero sample for the rate conversion; nullptr if not converted yet. */
+	std::shared_ptr<std::vector<int16>> data;
+	uint32 data_rate;       ///< Sample rate of #data, the mixer rate at the time of the conversion.
 };
 
 /**
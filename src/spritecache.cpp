@@ -75,6 +75,16 @@ static SpriteFile *GetCachedSpriteFileByName(const std::string &filename) {
 	return nullptr;
 }
 
+/**
+ * Check whether a SpriteFile with the given name is open in the sprite cache.
+ * @param filename Name of the file at the disk.
+ * @return True iff OpenCachedSpriteFile would reuse an already open file.
+ */
+bool IsSpriteFileCached(const std::string &filename)
+{
+	return GetCachedSpriteFileByName(filename) != nullptr;
+}
+
 /**
  * Open/get the SpriteFile that is cached for use in the sprite cache.
  * @param filename      Name of the file at the disk.
@@ -578,14 +588,8 @@ static void *ReadSprite(const SpriteCache *sc, SpriteID id, SpriteType sprite_ty
 	return encoder->Encode(sprite, allocator);
 }
 
-struct GrfSpriteOffset {
-	size_t file_pos;
-	uint count;
-	uint16 control_flags;
-};
-
-/** Map from sprite numbers to position in the GRF file. */
-static btree::btree_map<uint32, GrfSpriteOffset> _grf_sprite_offsets;
+/** Map from sprite numbers to position in the GRF file currently being processed. */
+static const btree::btree_map<uint32, GrfSpriteOffset> *_grf_sprite_offsets = nullptr;
 
 /**
  * Get the file offset for a specific sprite in the sprite section of a GRF.
@@ -594,21 +598,25 @@ static btree::btree_map<uint32, GrfSpriteOffset> _grf_sprite_offsets;
  */
 size_t GetGRFSpriteOffset(uint32 id)
 {
-	auto iter = _grf_sprite_offsets.find(id);
-	return iter != _grf_sprite_offsets.end() ? iter->second.file_pos : SIZE_MAX;
+	if (_grf_sprite_offsets == nullptr) return SIZE_MAX;
+	auto iter = _grf_sprite_offsets->find(id);
+	return iter != _grf_sprite_offsets->end() ? iter->second.file_pos : SIZE_MAX;
 }
 
 /**
  * Parse the sprite section of GRFs.
- * @param container_version Container version of the GRF we're currently processing.
+ * The index is kept in the file, so the different loading stages of a NewGRF only scan the sprite section once.
+ * @param file The GRF we're currently processing.
  */
 void ReadGRFSpriteOffsets(SpriteFile &file)
 {
-	_grf_sprite_offsets.clear();
+	_grf_sprite_offsets = &file.sprite_offsets;
 
 	if (file.GetContainerVersion() >= 2) {
 		/* Seek to sprite section of the GRF. */
 		size_t data_offset = file.ReadDword();
+		if (file.sprite_offsets_read) return;
+
 		size_t old_pos = file.GetPos();
 		file.SeekTo(data_offset, SEEK_CUR);
 
@@ -619,7 +627,7 @@ void ReadGRFSpriteOffsets(SpriteFile &file)
 		uint32 id, prev_id = 0;
 		while ((id = file.ReadDword()) != 0) {
 			if (id != prev_id) {
-				_grf_sprite_offsets[prev_id] = offset;
+				file.sprite_offsets[prev_id] = offset;
 				offset.file_pos = file.GetPos() - 4;
 				offset.count = 0;
 				offset.control_flags = 0;
@@ -641,7 +649,8 @@ void ReadGRFSpriteOffsets(SpriteFile &file)
 			}
 			file.SkipBytes(length);
 		}
-		if (prev_id != 0) _grf_sprite_offsets[prev_id] = offset;
+		if (prev_id != 0) file.sprite_offsets[prev_id] = offset;
+		file.sprite_offsets_read = true;
 
 		/* Continue processing the data section. */
 		file.SeekTo(old_pos, SEEK_SET);
@@ -688,8 +697,8 @@ bool LoadNextSprite(int load_index, SpriteFile &file, uint file_sprite_id)
 			return false;
 		}
 		/* It is not an error if no sprite with the provided ID is found in the sprite section. */
-		auto iter = _grf_sprite_offsets.find(file.ReadDword());
-		if (iter != _grf_sprite_offsets.end()) {
+		auto iter = file.sprite_offsets.find(file.ReadDword());
+		if (iter != file.sprite_offsets.end()) {
 			file_pos = iter->second.file_pos;
 			count = iter->second.count;
 			control_flags = iter->second.control_flags;
@@ -753,7 +762,11 @@ void DupSprite(SpriteID old_spr, SpriteID new_spr)
 	scnew->SetWarned(false);
 }
 
-static size_t GetSpriteCacheUsage()
+/**
+ * Get the memory used by the sprite data in the sprite cache.
+ * @return The memory usage, in bytes.
+ */
+size_t GetSpriteCacheUsage()
 {
 	return _spritecache_bytes_used;
 }
@@ -852,7 +865,9 @@ void IncreaseSpriteLRU()
 {
 	uint target_size = GetTargetSpriteSize();
 	if (_spritecache_bytes_used > target_size) {
-		DeleteEntriesFromSpriteCache(_spritecache_bytes_used - target_size + 512 * 1024);
+		/* Pruning has to look at every cached sprite, so free some more than needed: otherwise
+		 * scrolling into an unseen area with a large sprite set makes every loop prune again. */
+		DeleteEntriesFromSpriteCache(_spritecache_bytes_used - target_size + std::max<size_t>(512 * 1024, target_size / 16));
 	}
 
 	/* Adjust all LRU values */
@@ -1099,6 +1114,7 @@ void GfxInitSpriteMem()
 	/* Reset the spritecache 'pool' */
 	_spritecache.clear();
 	_sprite_files.clear();
+	_grf_sprite_offsets = nullptr;
 	assert(_spritecache_bytes_used == 0);
 	_spritecache_prune_events = 0;
 	_spritecache_prune_entries = 0;
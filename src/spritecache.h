@@ -40,6 +40,8 @@ enum SpriteCacheCtrlFlags {
 
 extern uint _sprite_cache_size;
 
+size_t GetSpriteCacheUsage();
+
 typedef void *AllocatorProc(size_t size);
 
 void *SimpleSpriteAlloc(size_t size);
@@ -69,6 +71,7 @@ void GfxClearSpriteCache();
 void GfxClearFontSpriteCache();
 void IncreaseSpriteLRU();
 
+bool IsSpriteFileCached(const std::string &filename);
 SpriteFile &OpenCachedSpriteFile(const std::string &filename, Subdirectory subdir, bool palette_remap);
 
 void ReadGRFSpriteOffsets(SpriteFile &file);
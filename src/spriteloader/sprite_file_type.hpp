@@ -11,6 +11,7 @@
 #define SPRITE_FILE_TYPE_HPP
 
 #include "../random_access_file_type.h"
+#include "../3rdparty/cpp-btree/btree_map.h"
 
 enum SpriteFileFlags : uint8 {
 	SFF_NONE                  = 0,
@@ -20,6 +21,13 @@ enum SpriteFileFlags : uint8 {
 };
 DECLARE_ENUM_AS_BIT_SET(SpriteFileFlags)
 
+/** Position and properties of a sprite in the sprite section of a GRF. */
+struct GrfSpriteOffset {
+	size_t file_pos;      ///< Position of the first entry of the sprite in the sprite section.
+	uint count;           ///< Number of entries (zoom levels and colour depths) of the sprite.
+	uint16 control_flags; ///< Zoom levels and colour depths available for the sprite.
+};
+
 /**
  * RandomAccessFile with some extra information specific for sprite files.
  * It automatically detects and stores the container version upload opening the file.
@@ -32,6 +40,10 @@ class SpriteFile : public RandomAccessFile {
 public:
 	SpriteFileFlags flags = SFF_NONE;
 
+	/** Sprite section index of the file, filled by the first call to ReadGRFSpriteOffsets and reused by later ones. */
+	btree::btree_map<uint32, GrfSpriteOffset> sprite_offsets;
+	bool sprite_offsets_read = false; ///< Whether #sprite_offsets has been read from the file.
+
 	SpriteFile(const std::string &filename, Subdirectory subdir, bool palette_remap);
 	SpriteFile(const SpriteFile&) = delete;
 	void operator=(const SpriteFile&) = delete;
@@ -29,6 +29,7 @@
 #include "linkgraph/linkgraphschedule.h"
 #include "tracerestrict.h"
 #include "newgrf_debug.h"
+#include "worker_thread.h"
 
 #include "table/strings.h"
 
@@ -56,6 +57,17 @@ void RebuildStationKdtree()
 	_station_kdtree.Build(stids.begin(), stids.end());
 }
 
+/** Set of stations which have a non-empty loading_vehicles list, ordered by station ID. */
+btree::btree_set<StationID> _stations_with_loading_vehicles;
+
+void RebuildStationsWithLoadingVehicles()
+{
+	_stations_with_loading_vehicles.clear();
+	for (const Station *st : Station::Iterate()) {
+		if (!st->loading_vehicles.empty()) _stations_with_loading_vehicles.insert(st->index);
+	}
+}
+
 
 BaseStation::~BaseStation()
 {
@@ -97,12 +109,14 @@ Station::~Station()
 		for (GoodsEntry &ge : this->goods) {
 			if (ge.data != nullptr) ge.data->cargo.OnCleanPool();
 		}
+		_stations_with_loading_vehicles.clear();
 		return;
 	}
 
 	while (!this->loading_vehicles.empty()) {
 		this->loading_vehicles.front()->LeaveStation();
 	}
+	_stations_with_loading_vehicles.erase(this->index);
 
 	for (Aircraft *a : Aircraft::Iterate()) {
 		if (!a->IsNormalAircraft()) continue;
@@ -251,6 +265,26 @@ void Station::AddFacility(StationFacility new_facility_bit, TileIndex facil_xy)
 	this->build_date = _date;
 }
 
+/**
+ * Add a vehicle to the end of the list of vehicles loading at this station.
+ * @param v The front vehicle.
+ */
+void Station::AddLoadingVehicle(Vehicle *v)
+{
+	if (this->loading_vehicles.empty()) _stations_with_loading_vehicles.insert(this->index);
+	this->loading_vehicles.push_back(v);
+}
+
+/**
+ * Remove a vehicle from the list of vehicles loading at this station, if present.
+ * @param v The front vehicle.
+ */
+void Station::RemoveLoadingVehicle(const Vehicle *v)
+{
+	this->loading_vehicles.erase(std::remove(this->loading_vehicles.begin(), this->loading_vehicles.end(), v), this->loading_vehicles.end());
+	if (this->loading_vehicles.empty()) _stations_with_loading_vehicles.erase(this->index);
+}
+
 /**
  * Marks the tiles of the station as dirty.
  *
@@ -427,6 +461,7 @@ void Station::AddIndustryToDeliver(Industry *ind, TileIndex tile)
 		if (pos->distance > distance) {
 			this->industries_near.erase(pos);
 			this->industries_near.insert(IndustryListEntry{distance, ind});
+			this->InvalidateIndustryAcceptors();
 		}
 		return;
 	}
@@ -435,6 +470,7 @@ void Station::AddIndustryToDeliver(Industry *ind, TileIndex tile)
 	if (!ind->IsCargoAccepted()) return;
 
 	this->industries_near.insert(IndustryListEntry{distance, ind});
+	this->InvalidateIndustryAcceptors();
 }
 
 /**
@@ -445,9 +481,29 @@ void Station::RemoveIndustryToDeliver(Industry *ind) {
 	auto pos = std::find_if(this->industries_near.begin(), this->industries_near.end(), [&](const IndustryListEntry &e) { return e.industry->index == ind->index; });
 	if (pos != this->industries_near.end()) {
 		this->industries_near.erase(pos);
+		this->InvalidateIndustryAcceptors();
 	}
 }
 
+/**
+ * Get the industries near the station which accept a cargo.
+ * The list is built on first use from #industries_near, so it is nearest first as well.
+ * @param cargo Cargo type.
+ * @return Industries accepting the cargo, with the index of the cargo in their accepted cargoes.
+ */
+const std::vector<IndustryAcceptorEntry> &Station::GetIndustryAcceptors(CargoID cargo) const
+{
+	auto result = this->industry_acceptors.insert({ cargo, {} });
+	std::vector<IndustryAcceptorEntry> &acceptors = result.first->second;
+	if (result.second) {
+		for (const IndustryListEntry &entry : this->industries_near) {
+			int cargo_index = entry.industry->GetCargoAcceptedIndex(cargo);
+			if (cargo_index >= 0) acceptors.push_back({ entry.industry, (uint8)cargo_index });
+		}
+	}
+	return acceptors;
+}
+
 
 /**
  * Remove this station from the nearby stations lists of all towns and industries.
@@ -481,12 +537,28 @@ bool Station::CatchmentCoversTown(TownID t) const
  */
 void Station::RecomputeCatchment(bool no_clear_nearby_lists)
 {
+	if (!this->BeginRecomputeCatchment(no_clear_nearby_lists)) return;
+
+	this->BuildCatchmentTiles();
+	this->FinishRecomputeCatchment();
+}
+
+/**
+ * First step of recomputing the catchment: reset the catchment, and handle the stations without a regular catchment.
+ * @param no_clear_nearby_lists Whether the nearby lists of towns and industries have already been cleared.
+ * @return Whether the catchment tiles still have to be built with BuildCatchmentTiles() and FinishRecomputeCatchment().
+ */
+bool Station::BeginRecomputeCatchment(bool no_clear_nearby_lists)
+{
+	this->acceptance_tiles_valid = false;
 	this->industries_near.clear();
+	this->InvalidateIndustryAcceptors();
+	this->catchment_xy = INVALID_TILE;
 	if (!no_clear_nearby_lists) this->RemoveFromAllNearbyLists();
 
 	if (this->rect.IsEmpty()) {
 		this->catchment_tiles.Reset();
-		return;
+		return false;
 	}
 
 	if (!_settings_game.station.serve_neutral_industries && this->industry != nullptr) {
@@ -512,9 +584,18 @@ void Station::RecomputeCatchment(bool no_clear_nearby_lists)
 			if (!IsTileType(tile, MP_STATION) || GetStationIndex(tile) != this->index) continue;
 			this->station_tiles++;
 		}
-		return;
+		return false;
 	}
 
+	return true;
+}
+
+/**
+ * Build the catchment tiles and count the station tiles.
+ * This only reads the map and writes to this station, so it can be done for several stations at once.
+ */
+void Station::BuildCatchmentTiles()
+{
 	this->catchment_tiles.Initialize(GetCatchmentRect());
 
 	/* Loop finding all station tiles */
@@ -532,26 +613,124 @@ void Station::RecomputeCatchment(bool no_clear_nearby_lists)
 		TileArea ta2 = TileArea(tile, 1, 1).Expand(r);
 		for (TileIndex tile2 : ta2) this->catchment_tiles.SetTile(tile2);
 	}
+}
 
+/**
+ * Last step of recomputing the catchment: add this station to the towns and industries in its catchment tiles.
+ */
+void Station::FinishRecomputeCatchment()
+{
 	/* Search catchment tiles for towns and industries */
 	BitmapTileIterator it(this->catchment_tiles);
 	for (TileIndex tile = it; tile != INVALID_TILE; tile = ++it) {
-		if (IsTileType(tile, MP_HOUSE)) {
-			Town *t = Town::GetByTile(tile);
-			t->stations_near.insert(this);
-		}
-		if (IsTileType(tile, MP_INDUSTRY)) {
-			Industry *i = Industry::GetByTile(tile);
+		this->AddCatchmentTileToNearbyLists(tile);
+	}
+	this->catchment_xy = this->xy;
+}
 
-			/* Ignore industry if it has a neutral station. It already can't be this station. */
-			if (!_settings_game.station.serve_neutral_industries && i->neutral_station != nullptr) continue;
+/**
+ * Add the town or industry of a tile which just became part of our catchment area to the nearby lists.
+ * @param tile Catchment tile.
+ */
+void Station::AddCatchmentTileToNearbyLists(TileIndex tile)
+{
+	if (IsTileType(tile, MP_HOUSE)) {
+		Town *t = Town::GetByTile(tile);
+		t->stations_near.insert(this);
+	}
+	if (IsTileType(tile, MP_INDUSTRY)) {
+		Industry *i = Industry::GetByTile(tile);
+
+		/* Ignore industry if it has a neutral station. It already can't be this station. */
+		if (!_settings_game.station.serve_neutral_industries && i->neutral_station != nullptr) return;
+
+		i->stations_near.insert(this);
+
+		/* Add if we can deliver to this industry as well */
+		this->AddIndustryToDeliver(i, tile);
+	}
+}
+
+/**
+ * Extend our catchment area after station tiles have been added, without rescanning the tiles already covered.
+ * The result is the same as that of RecomputeCatchment, which is used instead when the
+ * catchment can not be extended, e.g. when the station sign moved or the station is neutral.
+ * @param added Area containing the added station tiles.
+ */
+void Station::AddToCatchment(const TileArea &added)
+{
+	const Rect rect = this->GetCatchmentRect();
+	const TileArea new_area(TileXY(rect.left, rect.top), TileXY(rect.right, rect.bottom));
+	const BitmapTileArea &old_catchment = this->catchment_tiles;
+
+	if (added.tile == INVALID_TILE || this->catchment_xy != this->xy || this->rect.IsEmpty() || old_catchment.tile == INVALID_TILE ||
+			(!_settings_game.station.serve_neutral_industries && this->industry != nullptr) ||
+			!new_area.Contains(old_catchment.tile) || !new_area.Contains(TileXY(TileX(old_catchment.tile) + old_catchment.w - 1, TileY(old_catchment.tile) + old_catchment.h - 1))) {
+		this->RecomputeCatchment();
+		return;
+	}
+
+	this->acceptance_tiles_valid = false;
+
+	BitmapTileArea catchment;
+	if (static_cast<const TileArea &>(old_catchment) == new_area) {
+		catchment = std::move(this->catchment_tiles);
+	} else {
+		catchment.Initialize(new_area);
+		BitmapTileIterator old_it(old_catchment);
+		for (TileIndex tile = old_it; tile != INVALID_TILE; tile = ++old_it) catchment.SetTile(tile);
+	}
+
+	/* Loop finding all station tiles */
+	TileArea ta(TileXY(this->rect.left, this->rect.top), TileXY(this->rect.right, this->rect.bottom));
+	this->station_tiles = 0;
+	for (TileIndex tile : ta) {
+		if (IsTileType(tile, MP_STATION) && GetStationIndex(tile) == this->index) this->station_tiles++;
+	}
+
+	/* Only the catchment of the added tiles can add tiles to the set. */
+	for (TileIndex tile : added) {
+		if (!IsTileType(tile, MP_STATION) || GetStationIndex(tile) != this->index) continue;
 
-			i->stations_near.insert(this);
+		uint r = GetTileCatchmentRadius(tile, this);
+		if (r == CA_NONE) continue;
 
-			/* Add if we can deliver to this industry as well */
-			this->AddIndustryToDeliver(i, tile);
+		TileArea ta2 = TileArea(tile, 1, 1).Expand(r);
+		for (TileIndex tile2 : ta2) {
+			if (catchment.HasTile(tile2)) continue;
+			catchment.SetTile(tile2);
+			this->AddCatchmentTileToNearbyLists(tile2);
 		}
 	}
+
+	this->catchment_tiles = std::move(catchment);
+}
+
+/**
+ * Recompute the list of catchment tiles which may accept cargo.
+ * This skips the tiles without an add_accepted_cargo_proc, such as track, road and the station itself.
+ */
+void Station::RecomputeAcceptanceTiles()
+{
+	this->acceptance_tiles.clear();
+	BitmapTileIterator it(this->catchment_tiles);
+	for (TileIndex tile = it; tile != INVALID_TILE; tile = ++it) {
+		if (TileTypeMayAcceptCargo(GetTileType(tile))) this->acceptance_tiles.push_back(tile);
+	}
+	this->acceptance_tiles_valid = true;
+}
+
+/**
+ * Invalidate the acceptance tile lists of the stations whose catchment covers a tile,
+ * because the tile is about to change to or from a type which may accept cargo.
+ * @param tile The tile which changes type.
+ */
+void InvalidateStationAcceptanceTilesAroundTile(TileIndex tile)
+{
+	ForAllStationsAroundTiles(TileArea(tile, 1, 1), [](Station *st, TileIndex) {
+		st->acceptance_tiles_valid = false;
+		return true;
+	});
 }
 
 /**
@@ -562,7 +741,17 @@ void Station::RecomputeCatchment(bool no_clear_nearby_lists)
 {
 	for (Town *t : Town::Iterate()) { t->stations_near.clear(); }
 	for (Industry *i : Industry::Iterate()) { i->stations_near.clear(); }
-	for (Station *st : Station::Iterate()) { st->RecomputeCatchment(true); }
+
+	/* Building the catchment tiles is the expensive part, do that in parallel.
+	 * The nearby lists are then filled in station order, as when doing one station at a time. */
+	std::vector<Station *> stations;
+	for (Station *st : Station::Iterate()) {
+		if (st->BeginRecomputeCatchment(true)) stations.push_back(st);
+	}
+	_general_worker_pool.ParallelFor((int)stations.size(), 16, [&](int first, int last) {
+		for (int i = first; i < last; i++) stations[i]->BuildCatchmentTiles();
+	});
+	for (Station *st : stations) st->FinishRecomputeCatchment();
 }
 
 /************************************************************************/
@@ -866,6 +866,12 @@ struct IndustryCompare {
 
 typedef btree::btree_set<IndustryListEntry, IndustryCompare> IndustryList;
 
+/** Industry near a station which accepts a particular cargo, @see Station::GetIndustryAcceptors() */
+struct IndustryAcceptorEntry {
+	Industry *industry;  ///< Accepting industry
+	uint8 cargo_index;   ///< Index of the cargo in Industry::accepts_cargo
+};
+
 /** Station data structure */
 struct Station FINAL : SpecializedStation<Station, false> {
 public:
@@ -891,17 +897,21 @@ public:
 
 	BitmapTileArea catchment_tiles; ///< NOSAVE: Set of individual tiles covered by catchment area
 	uint station_tiles;             ///< NOSAVE: Count of station tiles owned by this station
+	TileIndex catchment_xy = INVALID_TILE; ///< NOSAVE: Station sign location used for the industry distances of the catchment, INVALID_TILE if the catchment can not be extended incrementally
+	std::vector<TileIndex> acceptance_tiles; ///< NOSAVE: Catchment tiles which may accept cargo, only valid if #acceptance_tiles_valid, @see GetAcceptanceTiles()
+	bool acceptance_tiles_valid = false;     ///< NOSAVE: Whether #acceptance_tiles is up to date
 
 	StationHadVehicleOfType had_vehicle_of_type;
 
 	byte time_since_load;
 	byte time_since_unload;
 
-	std::vector<Vehicle *> loading_vehicles;
+	std::vector<Vehicle *> loading_vehicles; ///< Vehicles loading/unloading at this station in the order they arrived, do not modify directly, @see AddLoadingVehicle
 	GoodsEntry goods[NUM_CARGO];  ///< Goods at this station
 	CargoTypes always_accepted;       ///< Bitmask of always accepted cargo types (by houses, HQs, industry tiles when industry doesn't accept cargo)
 
 	IndustryList industries_near; ///< Cached list of industries near the station that can accept cargo, @see DeliverGoodsToIndustry()
+	mutable btree::btree_map<CargoID, std::vector<IndustryAcceptorEntry>> industry_acceptors; ///< NOSAVE: Per cargo the industries of #industries_near accepting it, in the same order, @see GetIndustryAcceptors()
 	Industry *industry;           ///< NOSAVE: Associated industry for neutral stations. (Rebuilt on load from Industry->st)
 
 	CargoTypes station_cargo_history_cargoes;                                              ///< Bitmask of cargoes in station_cargo_history
@@ -919,15 +929,34 @@ public:
 
 	void UpdateCargoHistory();
 
+	void AddLoadingVehicle(Vehicle *v);
+	void RemoveLoadingVehicle(const Vehicle *v);
+
 	void MoveSign(TileIndex new_xy) override;
 
-	void AfterStationTileSetChange(bool adding, StationType type);
+	void AfterStationTileSetChange(bool adding, StationType type, const TileArea &added = TileArea());
 
 	uint GetPlatformLength(TileIndex tile, DiagDirection dir) const override;
 	uint GetPlatformLength(TileIndex tile) const override;
 	void RecomputeCatchment(bool no_clear_nearby_lists = false);
+	bool BeginRecomputeCatchment(bool no_clear_nearby_lists);
+	void BuildCatchmentTiles();
+	void FinishRecomputeCatchment();
+	void AddToCatchment(const TileArea &added);
 	static void RecomputeCatchmentForAll();
 
+	/**
+	 * Get the tiles in the catchment area which may accept cargo.
+	 * @return The catchment tiles of a type which may accept cargo, in catchment bitmap order.
+	 */
+	inline const std::vector<TileIndex> &GetAcceptanceTiles()
+	{
+		if (!this->acceptance_tiles_valid) this->RecomputeAcceptanceTiles();
+		return this->acceptance_tiles;
+	}
+
+	void RecomputeAcceptanceTiles();
+
 	uint GetCatchmentRadius() const;
 	Rect GetCatchmentRectUsingRadius(uint radius) const;
 	inline Rect GetCatchmentRect() const
@@ -938,7 +967,15 @@ public:
 	bool CatchmentCoversTown(TownID t) const;
 	void AddIndustryToDeliver(Industry *ind, TileIndex tile);
 	void RemoveIndustryToDeliver(Industry *ind);
+	const std::vector<IndustryAcceptorEntry> &GetIndustryAcceptors(CargoID cargo) const;
+
+	/** Forget the per cargo industry acceptors, this must be called whenever #industries_near changes. */
+	inline void InvalidateIndustryAcceptors()
+	{
+		this->industry_acceptors.clear();
+	}
 	void RemoveFromAllNearbyLists();
+	void AddCatchmentTileToNearbyLists(TileIndex tile);
 
 	inline bool TileIsInCatchment(TileIndex tile) const
 	{
@@ -999,6 +1036,9 @@ public:
 
 void RebuildStationKdtree();
 
+extern btree::btree_set<StationID> _stations_with_loading_vehicles;
+void RebuildStationsWithLoadingVehicles();
+
 /**
  * Call a function on all stations that have any part of the requested area within their catchment.
  * @tparam Func The type of funcion to call
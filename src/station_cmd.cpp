@@ -61,6 +61,8 @@
 #include "cheat_type.h"
 #include "newgrf_roadstop.h"
 #include "core/math_func.hpp"
+#include "pathfinder/water_regions.h"
+#include "worker_thread.h"
 
 #include "table/strings.h"
 
@@ -677,13 +679,12 @@ CargoArray GetAcceptanceAroundTiles(TileIndex center_tile, int w, int h, int rad
  * @param st Station to get acceptance of.
  * @param always_accepted bitmask of cargo accepted by houses and headquarters; can be nullptr
  */
-static CargoArray GetAcceptanceAroundStation(const Station *st, CargoTypes *always_accepted)
+static CargoArray GetAcceptanceAroundStation(Station *st, CargoTypes *always_accepted)
 {
 	CargoArray acceptance{};
 	if (always_accepted != nullptr) *always_accepted = 0;
 
-	BitmapTileIterator it(st->catchment_tiles);
-	for (TileIndex tile = it; tile != INVALID_TILE; tile = ++it) {
+	for (TileIndex tile : st->GetAcceptanceTiles()) {
 		AddAcceptedCargo(tile, acceptance, always_accepted);
 	}
 
@@ -828,8 +829,9 @@ static void DeleteStationIfEmpty(BaseStation *st)
  * After adding/removing tiles to station, update some station-related stuff.
  * @param adding True if adding tiles, false if removing them.
  * @param type StationType being modified.
+ * @param added Area containing the added tiles, if only tiles were added. Otherwise the catchment is recomputed from scratch.
  */
-void Station::AfterStationTileSetChange(bool adding, StationType type)
+void Station::AfterStationTileSetChange(bool adding, StationType type, const TileArea &added)
 {
 	this->UpdateVirtCoord();
 	DirtyCompanyInfrastructureWindows(this->owner);
@@ -852,7 +854,7 @@ void Station::AfterStationTileSetChange(bool adding, StationType type)
 	}
 
 	if (adding) {
-		this->RecomputeCatchment();
+		this->AddToCatchment(added);
 		UpdateStationAcceptance(this, false);
 		InvalidateWindowData(WC_SELECT_STATION, 0, 0);
 	} else {
@@ -1720,7 +1722,7 @@ CommandCost CmdBuildRailStation(TileIndex tile_org, DoCommandFlag flags, uint32
 		}
 
 		st->MarkTilesDirty(false);
-		st->AfterStationTileSetChange(true, STATION_RAIL);
+		st->AfterStationTileSetChange(true, STATION_RAIL, new_location);
 		ZoningMarkDirtyStationCoverageArea(st);
 	}
 
@@ -2283,7 +2285,7 @@ CommandCost CmdBuildRoadStop(TileIndex tile, DoCommandFlag flags, uint32 p1, uin
 		NotifyRoadLayoutChanged(true);
 
 		if (st != nullptr) {
-			st->AfterStationTileSetChange(true, type ? STATION_TRUCK: STATION_BUS);
+			st->AfterStationTileSetChange(true, type ? STATION_TRUCK: STATION_BUS, roadstop_area);
 		}
 	}
 	return cost;
@@ -3098,9 +3100,11 @@ CommandCost CmdBuildDock(TileIndex tile, DoCommandFlag flags, uint32 p1, uint32
 		Company::Get(st->owner)->infrastructure.station += 2;
 
 		MakeDock(tile, st->owner, st->index, direction, wc);
+		InvalidateWaterRegion(tile);
+		InvalidateWaterRegion(flat_tile);
 		UpdateStationDockingTiles(st);
 
-		st->AfterStationTileSetChange(true, STATION_DOCK);
+		st->AfterStationTileSetChange(true, STATION_DOCK, dock_area);
 		ZoningMarkDirtyStationCoverageArea(st);
 	}
 
@@ -4160,12 +4164,10 @@ int GetSpeedRating(const GoodsEntry *ge)
 	return (b >= 0) ? (b >> 2) : 0;
 }
 
-int GetWaitTimeRating(const CargoSpec *cs, const GoodsEntry *ge)
+static int GetWaitTimeRating(const CargoSpec *cs, const GoodsEntry *ge, uint wait_time)
 {
 	int rating = 0;
 
-	uint wait_time = ge->time_since_pickup;
-
 	if (_settings_game.station.cargo_class_rating_wait_time) {
 		if (cs->classes & CC_PASSENGERS) {
 			wait_time *= 3;
@@ -4187,6 +4189,11 @@ int GetWaitTimeRating(const CargoSpec *cs, const GoodsEntry *ge)
 	return rating;
 }
 
+int GetWaitTimeRating(const CargoSpec *cs, const GoodsEntry *ge)
+{
+	return GetWaitTimeRating(cs, ge, ge->time_since_pickup);
+}
+
 int GetWaitingCargoRating(const Station *st, const GoodsEntry *ge)
 {
 	int rating = -90;
@@ -4225,37 +4232,135 @@ int GetVehicleAgeRating(const GoodsEntry *ge)
 	return rating;
 }
 
-int GetTargetRating(const Station *st, const CargoSpec *cs, const GoodsEntry *ge)
+/**
+ * Compute the target rating of a cargo at a station without the NewGRF station rating callback.
+ * This only reads game state, so it may be called from a worker thread while the game loop is waiting.
+ * @param st Station.
+ * @param cs Cargo.
+ * @param ge Goods entry of \a cs at \a st.
+ * @param wait_time Days since last pickup to use, in units of #STATION_RATING_TICKS.
+ * @return Target rating.
+ */
+static int GetDefaultTargetRating(const Station *st, const CargoSpec *cs, const GoodsEntry *ge, uint wait_time)
 {
-	bool skip = false;
 	int rating = 0;
 
 	if (_cheats.station_rating.value) {
 		rating = 255;
-		skip = true;
-	} else if (HasBit(cs->callback_mask, CBM_CARGO_STATION_RATING_CALC)) {
+	} else {
+		rating += GetSpeedRating(ge);
+		rating += GetWaitTimeRating(cs, ge, wait_time);
+		rating += GetWaitingCargoRating(st, ge);
+	}
+
+	rating += GetStatueRating(st);
+	rating += GetVehicleAgeRating(ge);
+
+	return ClampTo<uint8>(rating);
+}
+
+/**
+ * Whether the target rating of a cargo can be computed by #GetDefaultTargetRating.
+ * @param cs Cargo.
+ * @return True if no NewGRF station rating callback has to be run.
+ */
+static bool HasDefaultTargetRating(const CargoSpec *cs)
+{
+	return _cheats.station_rating.value || !HasBit(cs->callback_mask, CBM_CARGO_STATION_RATING_CALC);
+}
 
+int GetTargetRating(const Station *st, const CargoSpec *cs, const GoodsEntry *ge)
+{
+	if (!HasDefaultTargetRating(cs)) {
 		int new_grf_rating;
 
 		if (GetNewGrfRating(st, cs, ge, &new_grf_rating)) {
-			skip = true;
-			rating += new_grf_rating;
+			return ClampTo<uint8>(new_grf_rating + GetStatueRating(st) + GetVehicleAgeRating(ge));
 		}
 	}
 
-	if (!skip) {
-		rating += GetSpeedRating(ge);
-		rating += GetWaitTimeRating(cs, ge);
-		rating += GetWaitingCargoRating(st, ge);
+	return GetDefaultTargetRating(st, cs, ge, ge->time_since_pickup);
+}
+
+/** Target ratings of a station, computed ahead of its rating update. */
+struct StationRatingTargets {
+	StationID station;        ///< Station.
+	CargoTypes computed;      ///< Cargoes for which #target is valid.
+	uint8 target[NUM_CARGO];  ///< Target rating per cargo.
+};
+
+static std::vector<StationRatingTargets> _station_rating_targets; ///< Precomputed targets of the stations due for a rating update, in pool order.
+static size_t _station_rating_targets_next = 0;                   ///< Index of the first entry of #_station_rating_targets not yet used.
+
+static const size_t STATION_RATING_PARALLEL_MIN_STATIONS = 128; ///< Minimum number of stations due at once to compute their targets on worker threads.
+static const size_t STATION_RATING_PARALLEL_BATCH = 64;         ///< Number of stations per worker job.
+
+/**
+ * Compute the target ratings which do not need a NewGRF callback, for the rating update of a station.
+ * This only reads game state, so it may run on a worker thread.
+ * @param targets Targets to fill, targets.station must be set.
+ */
+static void ComputeStationRatingTargets(StationRatingTargets &targets)
+{
+	const Station *st = Station::Get(targets.station);
+	targets.computed = 0;
+
+	for (const CargoSpec *cs : CargoSpec::Iterate()) {
+		const GoodsEntry *ge = &st->goods[cs->Index()];
+		if (!ge->HasRating() || !HasDefaultTargetRating(cs)) continue;
+
+		/* UpdateStationRating increments time_since_pickup before computing the target. */
+		const uint wait_time = std::min<uint>(ge->time_since_pickup + 1, 255);
+		targets.target[cs->Index()] = GetDefaultTargetRating(st, cs, ge, wait_time);
+		SetBit(targets.computed, cs->Index());
 	}
+}
 
-	rating += GetStatueRating(st);
-	rating += GetVehicleAgeRating(ge);
+/**
+ * Compute the targets of all entries of #_station_rating_targets.
+ * When many stations are due at once, this is spread over the general worker pool.
+ * The game state is not modified until all jobs have finished, and the results do not
+ * depend on the thread which computed them, so the rating update stays deterministic.
+ */
+static void ComputeAllStationRatingTargets()
+{
+	_station_rating_targets_next = 0;
 
-	return ClampTo<uint8>(rating);
+	const size_t count = _station_rating_targets.size();
+	if (count < STATION_RATING_PARALLEL_MIN_STATIONS) {
+		for (StationRatingTargets &targets : _station_rating_targets) ComputeStationRatingTargets(targets);
+		return;
+	}
+
+	_general_worker_pool.ParallelFor((int)count, (int)STATION_RATING_PARALLEL_BATCH, [](int first, int last) {
+		for (int i = first; i < last; i++) ComputeStationRatingTargets(_station_rating_targets[i]);
+	});
 }
 
-static void UpdateStationRating(Station *st)
+/**
+ * Get the precomputed targets of a station, if any.
+ * Stations have to be queried in increasing index order, as they were added to #_station_rating_targets.
+ * @param st Station.
+ * @return Targets of \a st, or nullptr if these were not computed.
+ */
+static const StationRatingTargets *GetPrecomputedStationRatingTargets(const Station *st)
+{
+	while (_station_rating_targets_next < _station_rating_targets.size() && _station_rating_targets[_station_rating_targets_next].station < st->index) {
+		_station_rating_targets_next++;
+	}
+	if (_station_rating_targets_next >= _station_rating_targets.size()) return nullptr;
+	const StationRatingTargets &targets = _station_rating_targets[_station_rating_targets_next];
+	if (targets.station != st->index) return nullptr;
+	_station_rating_targets_next++;
+	return &targets;
+}
+
+/**
+ * Update the ratings of all cargoes at a station.
+ * @param st Station.
+ * @param targets Targets computed ahead by #ComputeStationRatingTargets, or nullptr to compute all targets here.
+ */
+static void UpdateStationRating(Station *st, const StationRatingTargets *targets = nullptr)
 {
 	bool waiting_changed = false;
 
@@ -4285,7 +4390,7 @@ static void UpdateStationRating(Station *st)
 			}
 
 			{
-				int rating = GetTargetRating(st, cs, ge);
+				int rating = (targets != nullptr && HasBit(targets->computed, cs->Index())) ? targets->target[cs->Index()] : GetTargetRating(st, cs, ge);
 
 				uint waiting = ge->CargoAvailableCount();
 
@@ -4421,6 +4526,34 @@ void RerouteCargoFromSource(Station *st, CargoID c, StationID source, StationID
 	}
 }
 
+/**
+ * Reroute cargo of type c from any of a set of sources at station st or in any vehicles unloading there.
+ * This is equivalent to calling RerouteCargoFromSource for each source, but the cargo in the station is only walked once.
+ * Make sure the cargo's new next hop is neither "avoid" nor "avoid2".
+ * @param st Station to be rerouted at.
+ * @param c Type of cargo.
+ * @param sources Source stations, sorted.
+ * @param avoid Original next hop of cargo, avoid this.
+ * @param avoid2 Another station to be avoided when rerouting.
+ */
+void RerouteCargoFromSources(Station *st, CargoID c, const std::vector<StationID> &sources, StationID avoid, StationID avoid2)
+{
+	GoodsEntry &ge = st->goods[c];
+
+	/* Reroute cargo in station. */
+	if (ge.data != nullptr) ge.data->cargo.RerouteFromSources(&ge.data->cargo, sources, avoid, avoid2, &ge);
+
+	/* Reroute cargo staged to be transferred. */
+	for (Vehicle *v : st->loading_vehicles) {
+		for (; v != nullptr; v = v->Next()) {
+			if (v->cargo_type != c) continue;
+			for (StationID source : sources) {
+				v->cargo.RerouteFromSource(UINT_MAX, &v->cargo, source, avoid, avoid2, &ge);
+			}
+		}
+	}
+}
+
 btree::btree_set<VehicleID> _delete_stale_links_vehicle_cache;
 
 void ClearDeleteStaleLinksVehicleCache()
@@ -4601,15 +4734,40 @@ static void StationHandleSmallTick(BaseStation *st)
 	if (b >= STATION_RATING_TICKS) b = 0;
 	st->delete_ctr = b;
 
-	if (b == 0) UpdateStationRating(Station::From(st));
+	if (b == 0) {
+		Station *station = Station::From(st);
+		UpdateStationRating(station, GetPrecomputedStationRatingTargets(station));
+	}
+}
+
+/**
+ * Compute the targets of the stations whose rating is updated by #StationHandleSmallTick in this tick.
+ * Stations which share the same phase of the rating cycle are all due on the same tick.
+ */
+static void PrepareStationRatingTargets()
+{
+	_station_rating_targets.clear();
+	for (BaseStation *st : BaseStation::Iterate()) {
+		if ((st->facilities & FACIL_WAYPOINT) != 0 || !st->IsInUse()) continue;
+		if (st->delete_ctr + 1 < STATION_RATING_TICKS) continue;
+		_station_rating_targets.push_back({ st->index, 0, {} });
+	}
+	ComputeAllStationRatingTargets();
 }
 
 void UpdateAllStationRatings()
 {
+	_station_rating_targets.clear();
+	for (Station *st : Station::Iterate()) {
+		if (st->IsInUse()) _station_rating_targets.push_back({ st->index, 0, {} });
+	}
+	ComputeAllStationRatingTargets();
+
 	for (Station *st : Station::Iterate()) {
 		if (!st->IsInUse()) continue;
-		UpdateStationRating(st);
+		UpdateStationRating(st, GetPrecomputedStationRatingTargets(st));
 	}
+	_station_rating_targets.clear();
 }
 
 void OnTick_Station()
@@ -4617,6 +4775,7 @@ void OnTick_Station()
 	if (_game_mode == GM_EDITOR) return;
 
 	ClearDeleteStaleLinksVehicleCache();
+	PrepareStationRatingTargets();
 
 	for (BaseStation *st : BaseStation::Iterate()) {
 		StationHandleSmallTick(st);
@@ -4626,6 +4785,13 @@ void OnTick_Station()
 			DeleteStaleLinks(Station::From(st));
 		};
 
+		/* Merge cargo packets which have become compatible, for example after rerouting, about every 10 days. */
+		if (Station::IsExpected(st) && (_tick_counter + st->index) % STATION_CARGO_COMPACT_TICKS == 0) {
+			for (GoodsEntry &ge : Station::From(st)->goods) {
+				if (ge.data != nullptr) ge.data->cargo.Compact(_settings_game.economy.station_cargo_merge_periods);
+			}
+		}
+
 		/* Run STATION_ACCEPTANCE_TICKS = 250 tick interval trigger for station animation.
 		 * Station index is included so that triggers are not all done
 		 * at the same time. */
@@ -5049,6 +5215,7 @@ void BuildOilRig(TileIndex tile)
 	st->industry->neutral_station = st;
 	DeleteAnimatedTile(tile);
 	MakeOilrig(tile, st->index, GetWaterClass(tile));
+	InvalidateWaterRegion(tile);
 
 	st->owner = OWNER_NONE;
 	st->airport.type = AT_OILRIG;
@@ -50,6 +50,7 @@ bool SplitGroundSpriteForOverlay(const TileInfo *ti, SpriteID *ground, RailTrack
 void IncreaseStats(Station *st, CargoID cargo, StationID next_station_id, uint capacity, uint usage, uint32 time, EdgeUpdateMode mode);
 void RerouteCargo(Station *st, CargoID c, StationID avoid, StationID avoid2);
 void RerouteCargoFromSource(Station *st, CargoID c, StationID source, StationID avoid, StationID avoid2);
+void RerouteCargoFromSources(Station *st, CargoID c, const std::vector<StationID> &sources, StationID avoid, StationID avoid2);
 
 void FreeTrainStationPlatformReservation(const Train *v);
 
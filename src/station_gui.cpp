@@ -1766,23 +1766,22 @@ struct StationViewWindow : public Window {
 	void BuildCargoList(CargoID i, const StationCargoList &packets, CargoDataEntry *cargo)
 	{
 		const CargoDataEntry *source_dest = this->cached_destinations.Retrieve(i);
-		for (StationCargoList::ConstIterator it = packets.Packets()->begin(); it != packets.Packets()->end(); it++) {
-			const CargoPacket *cp = *it;
-			StationID next = it.GetKey();
+		for (const StationCargoSummaryEntry &summary : packets.GetSummary()) {
+			StationID next = summary.next;
 
-			const CargoDataEntry *source_entry = source_dest->Retrieve(cp->GetFirstStation());
+			const CargoDataEntry *source_entry = source_dest->Retrieve(summary.first_station);
 			if (source_entry == nullptr) {
-				this->ShowCargo(cargo, i, cp->GetFirstStation(), next, INVALID_STATION, cp->Count());
+				this->ShowCargo(cargo, i, summary.first_station, next, INVALID_STATION, summary.count);
 				continue;
 			}
 
 			const CargoDataEntry *via_entry = source_entry->Retrieve(next);
 			if (via_entry == nullptr) {
-				this->ShowCargo(cargo, i, cp->GetFirstStation(), next, INVALID_STATION, cp->Count());
+				this->ShowCargo(cargo, i, summary.first_station, next, INVALID_STATION, summary.count);
 				continue;
 			}
 
-			uint remaining = cp->Count();
+			uint remaining = summary.count;
 			for (CargoDataSet::iterator dest_it = via_entry->Begin(); dest_it != via_entry->End();) {
 				CargoDataEntry *dest_entry = *dest_it;
 
@@ -1796,10 +1795,10 @@ struct StationViewWindow : public Window {
 					 * not matching GoodsEntry::TotalCount() */
 					val = remaining;
 				} else {
-					val = std::min<uint>(remaining, DivideApprox(cp->Count() * dest_entry->GetCount(), via_entry->GetCount()));
+					val = std::min<uint>(remaining, DivideApprox(summary.count * dest_entry->GetCount(), via_entry->GetCount()));
 					remaining -= val;
 				}
-				this->ShowCargo(cargo, i, cp->GetFirstStation(), next, dest_entry->GetStation(), val);
+				this->ShowCargo(cargo, i, summary.first_station, next, dest_entry->GetStation(), val);
 			}
 		}
 		this->ShowCargo(cargo, i, NEW_STATION, NEW_STATION, NEW_STATION, packets.ReservedCount());
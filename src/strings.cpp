@@ -206,6 +206,7 @@ struct LoadedLanguagePack {
 	std::unique_ptr<LanguagePack, LanguagePackDeleter> langpack;
 
 	std::vector<char *> offsets;
+	std::vector<uint16> plain_lengths; ///< Length of each string if it contains no control codes, or #PLAIN_STRING_NONE.
 
 	std::array<uint, TEXT_TAB_END> langtab_num;   ///< Offset into langpack offs
 	std::array<uint, TEXT_TAB_END> langtab_start; ///< Offset into langpack offs
@@ -213,6 +214,8 @@ struct LoadedLanguagePack {
 
 static LoadedLanguagePack _langpack;
 
+static const uint16 PLAIN_STRING_NONE = UINT16_MAX; ///< Value of LoadedLanguagePack::plain_lengths for strings which need formatting.
+
 static bool _scan_for_gender_data = false;  ///< Are we scanning for the gender of the current string? (instead of formatting it)
 
 
@@ -287,7 +290,17 @@ char *GetStringWithArgs(char *buffr, StringID string, StringParameters &args, co
 		error("String 0x%X is invalid. You are probably using an old version of the .lng file.\n", string);
 	}
 
-	return FormatString(buffr, GetStringPtr(string), args, last, case_index);
+	const uint offset = _langpack.langtab_start[tab] + index;
+	const uint16 plain_length = _langpack.plain_lengths[offset];
+	if (plain_length != PLAIN_STRING_NONE && buffr + plain_length < last) {
+		/* Nothing to format, which is the case for most labels */
+		memcpy(buffr, _langpack.offsets[offset], plain_length);
+		buffr += plain_length;
+		*buffr = '\0';
+		return buffr;
+	}
+
+	return FormatString(buffr, _langpack.offsets[offset], args, last, case_index);
 }
 
 char *GetString(char *buffr, StringID string, const char *last)
@@ -2236,7 +2249,25 @@ bool ReadLanguagePack(const LanguageMetadata *lang)
 	/* Allocate offsets */
 	std::vector<char *> offs(count);
 
-	/* Fill offsets */
+	/* Find the strings which are copied verbatim by FormatString, so they can skip it */
+	std::vector<uint16> plain_lengths(count, PLAIN_STRING_NONE);
+	auto get_plain_length = [](const char *str, size_t length) -> uint16 {
+		if (length >= PLAIN_STRING_NONE) return PLAIN_STRING_NONE;
+
+		/* Control codes are encoded as multi-byte sequences, so ASCII only strings are always plain. */
+		const char *p = str;
+		while (p < str + length && (byte)*p < 0x80) p++;
+
+		while (p < str + length) {
+			WChar c;
+			size_t char_len = Utf8Decode(&c, p);
+			if ((c >= SCC_CONTROL_START && c <= SCC_CONTROL_END) || char_len != (size_t)Utf8CharLen(c)) return PLAIN_STRING_NONE;
+			p += char_len;
+		}
+		return p == str + length ? (uint16)length : PLAIN_STRING_NONE;
+	};
+
+	/* Fill offsets, and classify the strings in the same pass */
 	char *s = lang_pack->data;
 	len = (byte)*s++;
 	for (uint i = 0; i < count; i++) {
@@ -2248,12 +2279,15 @@ bool ReadLanguagePack(const LanguageMetadata *lang)
 		}
 		offs[i] = s;
 		s += len;
+		const size_t str_len = len;
 		len = (byte)*s;
 		*s++ = '\0'; // zero terminate the string
+		plain_lengths[i] = get_plain_length(offs[i], strnlen(offs[i], str_len));
 	}
 
 	_langpack.langpack = std::move(lang_pack);
 	_langpack.offsets = std::move(offs);
+	_langpack.plain_lengths = std::move(plain_lengths);
 	_langpack.langtab_num = tab_num;
 	_langpack.langtab_start = tab_start;
 
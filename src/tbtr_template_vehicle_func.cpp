@@ -34,8 +34,10 @@
 #include "zoom_func.h"
 
 
+#include <algorithm>
 #include <map>
 #include <stdio.h>
+#include <vector>
 
 #include "safeguards.h"
 
@@ -374,13 +376,27 @@ CommandCost CmdSetTrainUnitDirectionFromTemplate(Train *t, TemplateVehicle *tv,
 /** using cmdtemplatereplacevehicle as test-function (i.e. with flag DC_NONE) is not a good idea as that function relies on
  *  actually moving vehicles around to work properly.
  *  We do this worst-cast test instead.
+ *  Test-building an engine does not change any state, so each distinct engine is only tested once.
  */
 CommandCost TestBuyAllTemplateVehiclesInChain(TemplateVehicle *tv, TileIndex tile)
 {
-	CommandCost cost(EXPENSES_NEW_VEHICLES);
-
+	/* Distinct engines of the template in order of first use, with their number of uses */
+	std::vector<std::pair<EngineID, uint>> engines;
 	for (; tv; tv = tv->GetNextUnit()) {
-		cost.AddCost(DoCommand(tile, tv->engine_type, 0, DC_NONE, CMD_BUILD_VEHICLE));
+		auto iter = std::find_if(engines.begin(), engines.end(), [&](const auto &it) { return it.first == tv->engine_type; });
+		if (iter != engines.end()) {
+			iter->second++;
+		} else {
+			engines.emplace_back(tv->engine_type, 1);
+		}
+	}
+
+	CommandCost cost(EXPENSES_NEW_VEHICLES);
+	for (const auto &it : engines) {
+		const CommandCost engine_cost = DoCommand(tile, it.first, 0, DC_NONE, CMD_BUILD_VEHICLE);
+		for (uint i = 0; i < it.second; i++) {
+			cost.AddCost(engine_cost);
+		}
 	}
 
 	return cost;
@@ -17,6 +17,8 @@
 #include "company_base.h"
 #include "company_func.h"
 #include "core/backup_type.hpp"
+#include "road_map.h"
+#include "pathfinder/yapf/yapf_cache.h"
 
 #include "table/strings.h"
 
@@ -34,8 +36,62 @@ typedef btree::btree_map<TileIndex, int> TileIndexToHeightMap;
 struct TerraformerState {
 	TileIndexSet dirty_tiles;                ///< The tiles that need to be redrawn.
 	TileIndexToHeightMap tile_to_new_height; ///< The tiles for which the height has changed.
+	std::vector<std::pair<TileIndex, int>> read_heights; ///< The actual heights of tiles which the model depends on.
 };
 
+/**
+ * Model of a terraforming computed by a test run, which the execution run of the same
+ * terraforming can use instead of computing it again. CmdLevelLand executes every step
+ * directly after testing it, and the model only depends on tile heights and settings.
+ */
+struct TerraformerPlan {
+	TileIndex tile = INVALID_TILE; ///< Tile of the terraforming, INVALID_TILE if there is no plan.
+	uint32 p1 = 0;                 ///< Corners of the terraforming.
+	uint32 p2 = 0;                 ///< Direction of the terraforming.
+	uint map_size_x = 0;           ///< Size along the X side of the map for which the model was computed.
+	uint map_size_y = 0;           ///< Size along the Y side of the map for which the model was computed.
+	uint8 map_height_limit = 0;    ///< Height limit for which the model was computed.
+	bool freeform_edges = false;   ///< Freeform edges setting for which the model was computed.
+	TerraformerState ts;           ///< The model.
+	CommandCost cost;              ///< Cost of the model.
+
+	/**
+	 * Check whether this plan is for the given terraforming, and nothing it depends on has changed since.
+	 * @param tile Tile of the terraforming.
+	 * @param p1 Corners of the terraforming.
+	 * @param p2 Direction of the terraforming.
+	 * @return Whether the plan can be used.
+	 */
+	bool IsValidFor(TileIndex tile, uint32 p1, uint32 p2) const
+	{
+		if (this->tile != tile || this->p1 != p1 || this->p2 != p2 || this->map_size_x != MapSizeX() || this->map_size_y != MapSizeY() ||
+				this->map_height_limit != _settings_game.construction.map_height_limit ||
+				this->freeform_edges != _settings_game.construction.freeform_edges) {
+			return false;
+		}
+		for (const auto &it : this->ts.read_heights) {
+			if ((int)TileHeight(it.first) != it.second) return false;
+		}
+		return true;
+	}
+};
+
+static TerraformerPlan _terraformer_plan; ///< Model of the last tested terraforming.
+
+/**
+ * Gets the actual TileHeight of a tile, and records it as something the terraforming model depends on.
+ *
+ * @param ts TerraformerState.
+ * @param tile Tile.
+ * @return TileHeight.
+ */
+static int TerraformReadHeightOfTile(TerraformerState *ts, TileIndex tile)
+{
+	int height = TileHeight(tile);
+	ts->read_heights.emplace_back(tile, height);
+	return height;
+}
+
 /**
  * Gets the TileHeight (height of north corner) of a tile as of current terraforming progress.
  *
@@ -43,10 +99,10 @@ struct TerraformerState {
  * @param tile Tile.
  * @return TileHeight.
  */
-static int TerraformGetHeightOfTile(const TerraformerState *ts, TileIndex tile)
+static int TerraformGetHeightOfTile(TerraformerState *ts, TileIndex tile)
 {
 	TileIndexToHeightMap::const_iterator it = ts->tile_to_new_height.find(tile);
-	return it != ts->tile_to_new_height.end() ? it->second : TileHeight(tile);
+	return it != ts->tile_to_new_height.end() ? it->second : TerraformReadHeightOfTile(ts, tile);
 }
 
 /**
@@ -190,34 +246,44 @@ CommandCost CmdTerraformLand(TileIndex tile, DoCommandFlag flags, uint32 p1, uin
 	int direction = (p2 != 0 ? 1 : -1);
 	TerraformerState ts;
 
-	/* Compute the costs and the terraforming result in a model of the landscape */
-	if ((p1 & SLOPE_W) != 0 && tile + TileDiffXY(1, 0) < MapSize()) {
-		TileIndex t = tile + TileDiffXY(1, 0);
-		CommandCost cost = TerraformTileHeight(&ts, t, TileHeight(t) + direction);
-		if (cost.Failed()) return cost;
-		total_cost.AddCost(cost);
-	}
+	if ((flags & DC_EXEC) && _terraformer_plan.IsValidFor(tile, p1, p2)) {
+		/* Use the model of the test run */
+		ts = std::move(_terraformer_plan.ts);
+		total_cost = _terraformer_plan.cost;
+		_terraformer_plan.tile = INVALID_TILE;
+	} else {
+		_terraformer_plan.tile = INVALID_TILE;
+
+		/* Compute the costs and the terraforming result in a model of the landscape */
+		if ((p1 & SLOPE_W) != 0 && tile + TileDiffXY(1, 0) < MapSize()) {
+			TileIndex t = tile + TileDiffXY(1, 0);
+			CommandCost cost = TerraformTileHeight(&ts, t, TerraformReadHeightOfTile(&ts, t) + direction);
+			if (cost.Failed()) return cost;
+			total_cost.AddCost(cost);
+		}
 
-	if ((p1 & SLOPE_S) != 0 && tile + TileDiffXY(1, 1) < MapSize()) {
-		TileIndex t = tile + TileDiffXY(1, 1);
-		CommandCost cost = TerraformTileHeight(&ts, t, TileHeight(t) + direction);
-		if (cost.Failed()) return cost;
-		total_cost.AddCost(cost);
-	}
+		if ((p1 & SLOPE_S) != 0 && tile + TileDiffXY(1, 1) < MapSize()) {
+			TileIndex t = tile + TileDiffXY(1, 1);
+			CommandCost cost = TerraformTileHeight(&ts, t, TerraformReadHeightOfTile(&ts, t) + direction);
+			if (cost.Failed()) return cost;
+			total_cost.AddCost(cost);
+		}
 
-	if ((p1 & SLOPE_E) != 0 && tile + TileDiffXY(0, 1) < MapSize()) {
-		TileIndex t = tile + TileDiffXY(0, 1);
-		CommandCost cost = TerraformTileHeight(&ts, t, TileHeight(t) + direction);
-		if (cost.Failed()) return cost;
-		total_cost.AddCost(cost);
-	}
+		if ((p1 & SLOPE_E) != 0 && tile + TileDiffXY(0, 1) < MapSize()) {
+			TileIndex t = tile + TileDiffXY(0, 1);
+			CommandCost cost = TerraformTileHeight(&ts, t, TerraformReadHeightOfTile(&ts, t) + direction);
+			if (cost.Failed()) return cost;
+			total_cost.AddCost(cost);
+		}
 
-	if ((p1 & SLOPE_N) != 0) {
-		TileIndex t = tile + TileDiffXY(0, 0);
-		CommandCost cost = TerraformTileHeight(&ts, t, TileHeight(t) + direction);
-		if (cost.Failed()) return cost;
-		total_cost.AddCost(cost);
+		if ((p1 & SLOPE_N) != 0) {
+			TileIndex t = tile + TileDiffXY(0, 0);
+			CommandCost cost = TerraformTileHeight(&ts, t, TerraformReadHeightOfTile(&ts, t) + direction);
+			if (cost.Failed()) return cost;
+			total_cost.AddCost(cost);
+		}
 	}
+	const CommandCost model_cost = total_cost;
 
 	/* Check if the terraforming is valid wrt. tunnels, bridges and objects on the surface
 	 * Pass == 0: Collect tileareas which are caused to be auto-cleared.
@@ -322,7 +388,26 @@ CommandCost CmdTerraformLand(TileIndex tile, DoCommandFlag flags, uint32 p1, uin
 			SetTileHeight(t, (uint)height);
 		}
 
+		/* Road slope costs are cached by the pathfinder */
+		for (const auto &t : ts.dirty_tiles) {
+			if (MayHaveRoad(t)) {
+				YapfNotifyRoadLayoutChange();
+				break;
+			}
+		}
+
 		if (c != nullptr) c->terraform_limit -= (uint32)ts.tile_to_new_height.size() << 16;
+	} else {
+		/* Keep the model for the execution run */
+		_terraformer_plan.p1 = p1;
+		_terraformer_plan.p2 = p2;
+		_terraformer_plan.map_size_x = MapSizeX();
+		_terraformer_plan.map_size_y = MapSizeY();
+		_terraformer_plan.map_height_limit = _settings_game.construction.map_height_limit;
+		_terraformer_plan.freeform_edges = _settings_game.construction.freeform_edges;
+		_terraformer_plan.ts = std::move(ts);
+		_terraformer_plan.cost = model_cost;
+		_terraformer_plan.tile = tile;
 	}
 	return total_cost;
 }
@@ -0,0 +1,90 @@
+/*
+ * This file is part of OpenTTD.
+ * OpenTTD is free software; you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 2.
+ * OpenTTD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with OpenTTD. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file kdtree.cpp Test functionality from core/kdtree.hpp */
+
+#include "../stdafx.h"
+
+#include "../3rdparty/catch2/catch.hpp"
+
+#include "../core/kdtree.hpp"
+
+#include <algorithm>
+
+/** Elements are encoded as x * 1000 + y. */
+static uint32 TestXYFunc(uint32 element, int dim) { return (dim == 0) ? element / 1000 : element % 1000; }
+typedef Kdtree<uint32, decltype(&TestXYFunc), uint32, int> TestKdtree;
+
+static std::vector<uint32> FindContainedSorted(const TestKdtree &tree, uint32 x1, uint32 y1, uint32 x2, uint32 y2)
+{
+	std::vector<uint32> result;
+	tree.FindContained(x1, y1, x2, y2, [&](uint32 element) { result.push_back(element); });
+	std::sort(result.begin(), result.end());
+	return result;
+}
+
+static std::vector<uint32> FindContainedBruteForce(const std::vector<uint32> &elements, uint32 x1, uint32 y1, uint32 x2, uint32 y2)
+{
+	std::vector<uint32> result;
+	for (uint32 element : elements) {
+		uint32 x = TestXYFunc(element, 0);
+		uint32 y = TestXYFunc(element, 1);
+		if (x >= x1 && x < x2 && y >= y1 && y < y2) result.push_back(element);
+	}
+	std::sort(result.begin(), result.end());
+	return result;
+}
+
+TEST_CASE("Kdtree - Sorted insertions")
+{
+	TestKdtree tree(&TestXYFunc);
+	std::vector<uint32> elements;
+
+	/* Inserting along a diagonal and a line is the worst case for an unbalanced tree. */
+	for (uint32 i = 0; i < 500; i++) {
+		elements.push_back(i * 1000 + i);
+		tree.Insert(elements.back());
+		elements.push_back(i * 1000 + 999);
+		tree.Insert(elements.back());
+	}
+	CHECK(tree.Count() == elements.size());
+
+	CHECK(FindContainedSorted(tree, 0, 0, 1000, 1000) == FindContainedBruteForce(elements, 0, 0, 1000, 1000));
+	CHECK(FindContainedSorted(tree, 100, 50, 300, 250) == FindContainedBruteForce(elements, 100, 50, 300, 250));
+	CHECK(FindContainedSorted(tree, 0, 999, 1000, 1000) == FindContainedBruteForce(elements, 0, 999, 1000, 1000));
+	CHECK(tree.FindNearest(250, 251) == 250250);
+}
+
+TEST_CASE("Kdtree - Insertions and removals")
+{
+	TestKdtree tree(&TestXYFunc);
+	std::vector<uint32> elements;
+
+	uint32 seed = 12345;
+	auto next = [&]() {
+		seed = seed * 1103515245 + 12345;
+		return (seed >> 8) % 1000;
+	};
+
+	for (int i = 0; i < 2000; i++) {
+		uint32 element = next() * 1000 + next();
+		if (std::find(elements.begin(), elements.end(), element) != elements.end()) continue;
+		elements.push_back(element);
+		tree.Insert(element);
+
+		if (i % 3 == 0) {
+			size_t index = next() % elements.size();
+			tree.Remove(elements[index]);
+			elements.erase(elements.begin() + index);
+		}
+	}
+	CHECK(tree.Count() == elements.size());
+
+	CHECK(FindContainedSorted(tree, 0, 0, 1000, 1000) == FindContainedBruteForce(elements, 0, 0, 1000, 1000));
+	CHECK(FindContainedSorted(tree, 200, 300, 600, 700) == FindContainedBruteForce(elements, 200, 300, 600, 700));
+	CHECK(FindContainedSorted(tree, 900, 0, 1000, 100) == FindContainedBruteForce(elements, 900, 0, 1000, 100));
+}
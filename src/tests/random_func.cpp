@@ -0,0 +1,58 @@
+/*
+ * This file is part of OpenTTD.
+ * OpenTTD is free software; you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 2.
+ * OpenTTD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with OpenTTD. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file random_func.cpp Test functionality from core/random_func.hpp */
+
+#include "../stdafx.h"
+
+#include "../3rdparty/catch2/catch.hpp"
+
+#include "../core/random_func.hpp"
+
+TEST_CASE("KeyedRandomizer - Same key gives same numbers")
+{
+	KeyedRandomizer a(1234, 56, KRS_VEHICLE, 7);
+	KeyedRandomizer b(1234, 56, KRS_VEHICLE, 7);
+	for (int i = 0; i < 16; i++) {
+		CHECK(a.Next() == b.Next());
+	}
+}
+
+TEST_CASE("KeyedRandomizer - Independent of draw order")
+{
+	KeyedRandomizer first(1234, 56, KRS_VEHICLE, 1);
+	const uint32 expected = first.Next();
+
+	/* Drawing from other streams in between does not change the numbers of a stream. */
+	KeyedRandomizer other(1234, 56, KRS_VEHICLE, 2);
+	other.Next();
+	other.Next();
+	KeyedRandomizer again(1234, 56, KRS_VEHICLE, 1);
+	CHECK(again.Next() == expected);
+}
+
+TEST_CASE("KeyedRandomizer - Different keys give different numbers")
+{
+	const uint32 base = KeyedRandomizer(1234, 56, KRS_VEHICLE, 7).Next();
+	CHECK(KeyedRandomizer(1235, 56, KRS_VEHICLE, 7).Next() != base);
+	CHECK(KeyedRandomizer(1234, 57, KRS_VEHICLE, 7).Next() != base);
+	CHECK(KeyedRandomizer(1234, 56, KRS_TOWN, 7).Next() != base);
+	CHECK(KeyedRandomizer(1234, 56, KRS_VEHICLE, 8).Next() != base);
+
+	KeyedRandomizer stream(1234, 56, KRS_VEHICLE, 7);
+	stream.Next();
+	CHECK(stream.Next() != base);
+}
+
+TEST_CASE("KeyedRandomizer - Limit")
+{
+	KeyedRandomizer stream(1234, 56, KRS_INDUSTRY, 3);
+	for (int i = 0; i < 1000; i++) {
+		CHECK(stream.Next(10) < 10);
+	}
+	CHECK(stream.Next(1) == 0);
+}
@@ -122,6 +122,18 @@ static inline bool IsInnerTile(TileIndex tile)
 	return x < MapMaxX() && y < MapMaxY() && ((x > 0 && y > 0) || !_settings_game.construction.freeform_edges);
 }
 
+/**
+ * Check whether tiles of a type may accept cargo, i.e. have an add_accepted_cargo_proc.
+ * @param type The tile type to check.
+ * @return Whether tiles of this type may accept cargo.
+ */
+static inline bool TileTypeMayAcceptCargo(TileType type)
+{
+	return type == MP_HOUSE || type == MP_INDUSTRY || type == MP_OBJECT;
+}
+
+void InvalidateStationAcceptanceTilesAroundTile(TileIndex tile);
+
 /**
  * Set the type of a tile
  *
@@ -141,6 +153,7 @@ static inline void SetTileType(TileIndex tile, TileType type)
 	 * edges of the map. If _settings_game.construction.freeform_edges is true,
 	 * the upper edges of the map are also VOID tiles. */
 	dbg_assert_msg(IsInnerTile(tile) == (type != MP_VOID), "tile: 0x%X (%d), type: %d", tile, IsInnerTile(tile), type);
+	if (TileTypeMayAcceptCargo(type) != TileTypeMayAcceptCargo(GetTileType(tile))) InvalidateStationAcceptanceTilesAroundTile(tile);
 	SB(_m[tile].type, 4, 4, type);
 }
 
@@ -258,6 +258,7 @@ TileIndexDiff GetHouseNorthPart(HouseID &house);
 Town *CalcClosestTownFromTile(TileIndex tile, uint threshold = UINT_MAX);
 
 void ResetHouses();
+void InvalidateTownHouseCandidates();
 
 void ClearTownHouse(Town *t, TileIndex tile);
 void UpdateTownMaxPass(Town *t);
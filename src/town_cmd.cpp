@@ -2818,6 +2818,46 @@ static inline CommandCost IsHouseTypeAllowed(HouseID house, bool above_snowline,
 }
 
 
+/** Houses which town growth may build, per position relative to the snow line and house zone, in house ID order. */
+struct TownHouseCandidates {
+	std::vector<HouseID> houses[2][HZB_END]; ///< Houses passing #IsHouseTypeAllowed, indexed by above snow line and zone.
+	byte landscape = 0xFF;                   ///< Landscape the candidates were determined for, 0xFF if invalid.
+};
+static TownHouseCandidates _town_house_candidates;
+
+/**
+ * Invalidate the houses which town growth may build, after the house specs have changed.
+ */
+void InvalidateTownHouseCandidates()
+{
+	_town_house_candidates.landscape = 0xFF;
+}
+
+/**
+ * Get the houses which town growth may build at a location, not taking into account the town itself.
+ * This only depends on the house specs and the climate, so it is determined once.
+ * @param above_snowline Whether the location is above the snow line.
+ * @param zone The house zone of the location.
+ * @return The houses passing #IsHouseTypeAllowed, in house ID order.
+ */
+static const std::vector<HouseID> &GetTownHouseCandidates(bool above_snowline, HouseZonesBits zone)
+{
+	TownHouseCandidates &cache = _town_house_candidates;
+	if (cache.landscape != _settings_game.game_creation.landscape) {
+		for (uint snow = 0; snow < 2; snow++) {
+			for (HouseZonesBits z = HZB_BEGIN; z < HZB_END; z++) {
+				std::vector<HouseID> &houses = cache.houses[snow][z];
+				houses.clear();
+				for (uint i = 0; i < NUM_HOUSES; i++) {
+					if (IsHouseTypeAllowed((HouseID)i, snow != 0, z, false).Succeeded()) houses.push_back((HouseID)i);
+				}
+			}
+		}
+		cache.landscape = _settings_game.game_creation.landscape;
+	}
+	return cache.houses[above_snowline ? 1 : 0][zone];
+}
+
 /**
  * Check whether a town can hold more house types.
  * @param t the town we wan't to check
@@ -3067,14 +3107,13 @@ static bool BuildTownHouse(Town *t, TileIndex tile)
 	uint probability_max = 0;
 
 	/* Generate a list of all possible houses that can be built. */
-	for (uint i = 0; i < NUM_HOUSES; i++) {
-		if (IsHouseTypeAllowed((HouseID)i, above_snowline, zone, false).Failed()) continue;
-		if (IsAnotherHouseTypeAllowedInTown(t, (HouseID)i).Failed()) continue;
+	for (HouseID i : GetTownHouseCandidates(above_snowline, zone)) {
+		if (IsAnotherHouseTypeAllowedInTown(t, i).Failed()) continue;
 
 		uint cur_prob = HouseSpec::Get(i)->probability;
 		probability_max += cur_prob;
 		probs[num] = cur_prob;
-		houses[num++] = (HouseID)i;
+		houses[num++] = i;
 	}
 
 	TileIndex baseTile = tile;
@@ -4476,4 +4515,6 @@ void ResetHouses()
 
 	/* Reset any overrides that have been set. */
 	_house_mngr.ResetOverride();
+
+	InvalidateTownHouseCandidates();
 }
@@ -889,8 +889,27 @@ private:
 
 	GUITownList towns;
 
+	static std::vector<uint32> name_ranks; ///< Position of each town, indexed by TownID, in the list sorted by name.
+	bool name_ranks_valid = false;         ///< Whether #name_ranks matches the current list and town names.
+
 	Scrollbar *vscroll;
 
+	/**
+	 * Sort the towns by name once and remember the position of each town, so the sorters
+	 * do not have to compare the names again on every resort due to a population change.
+	 */
+	void UpdateNameRanks()
+	{
+		std::vector<const Town *> sorted(this->towns.begin(), this->towns.end());
+		std::sort(sorted.begin(), sorted.end(), [](const Town *a, const Town *b) {
+			return StrNaturalCompare(a->GetCachedName(), b->GetCachedName()) < 0; // Sort by name (natural sorting).
+		});
+
+		name_ranks.assign(Town::GetPoolSize(), 0);
+		for (uint i = 0; i < sorted.size(); i++) name_ranks[sorted[i]->index] = i;
+		this->name_ranks_valid = true;
+	}
+
 	void BuildSortTownList()
 	{
 		if (this->towns.NeedRebuild()) {
@@ -909,7 +928,9 @@ private:
 			this->towns.shrink_to_fit();
 			this->towns.RebuildDone();
 			this->vscroll->SetCount(this->towns.size()); // Update scrollbar as well.
+			this->name_ranks_valid = false;
 		}
+		if (!this->name_ranks_valid) this->UpdateNameRanks();
 		/* Always sort the towns. */
 		this->towns.Sort();
 		this->SetWidgetDirty(WID_TD_LIST); // Force repaint of the displayed towns.
@@ -918,7 +939,7 @@ private:
 	/** Sort by town name */
 	static bool TownNameSorter(const Town * const &a, const Town * const &b)
 	{
-		return StrNaturalCompare(a->GetCachedName(), b->GetCachedName()) < 0; // Sort by name (natural sorting).
+		return name_ranks[a->index] < name_ranks[b->index];
 	}
 
 	/** Sort by population (default descending, as big towns are of the most interest). */
@@ -1156,6 +1177,13 @@ public:
 		this->SetDirty();
 	}
 
+	void OnInit() override
+	{
+		/* The language, and with it the default town names, may have changed. */
+		this->name_ranks_valid = false;
+		this->towns.ForceResort();
+	}
+
 	void OnResize() override
 	{
 		this->vscroll->SetCapacityFromWidget(this, WID_TD_LIST);
@@ -1187,12 +1215,15 @@ public:
 				break;
 
 			default:
+				/* A town may have been renamed. */
+				this->name_ranks_valid = false;
 				this->towns.ForceResort();
 		}
 	}
 };
 
 Listing TownDirectoryWindow::last_sorting = {false, 0};
+std::vector<uint32> TownDirectoryWindow::name_ranks;
 
 /** Names of the sorting functions. */
 const StringID TownDirectoryWindow::sorter_names[] = {
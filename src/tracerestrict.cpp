@@ -154,6 +154,21 @@ static void HandleCondition(std::vector<TraceRestrictCondStackFlags> &condstack,
 	}
 }
 
+/**
+ * Helper function to determine whether HandleCondition will use the value of a condition.
+ * Conditions whose result would be ignored do not need to be evaluated.
+ */
+static bool IsConditionValueNeeded(const std::vector<TraceRestrictCondStackFlags> &condstack, TraceRestrictCondFlags condflags)
+{
+	if (condflags & (TRCF_OR | TRCF_ELSE)) {
+		assert(!condstack.empty());
+		if ((condflags & TRCF_OR) && (condstack.back() & TRCSF_ACTIVE)) return false;
+		return !(condstack.back() & (TRCSF_DONE_IF | TRCSF_PARENT_INACTIVE));
+	} else {
+		return condstack.empty() || (condstack.back() & TRCSF_ACTIVE);
+	}
+}
+
 /**
  * Integer condition testing
  * Test value op condvalue
@@ -252,8 +267,10 @@ void TraceRestrictProgram::Execute(const Train* v, const TraceRestrictProgramInp
 	byte have_previous_signal = 0;
 	TileIndex previous_signal_tile[3];
 
+	const bool have_skip_offsets = (this->cond_skip_offsets.size() == this->items.size());
 	size_t size = this->items.size();
 	for (size_t i = 0; i < size; i++) {
+		const size_t instruction_offset = i;
 		TraceRestrictItem item = this->items[i];
 		TraceRestrictItemType type = GetTraceRestrictType(item);
 
@@ -271,7 +288,12 @@ void TraceRestrictProgram::Execute(const Train* v, const TraceRestrictProgramInp
 				} else {
 					// end if
 					condstack.pop_back();
+					continue;
 				}
+			} else if (!IsConditionValueNeeded(condstack, condflags)) {
+				// the result would be ignored, don't evaluate the condition
+				if (IsTraceRestrictDoubleItem(item)) i++;
+				HandleCondition(condstack, condflags, false);
 			} else {
 				uint16 condvalue = GetTraceRestrictValue(item);
 				bool result = false;
@@ -640,6 +662,11 @@ void TraceRestrictProgram::Execute(const Train* v, const TraceRestrictProgramInp
 				}
 				HandleCondition(condstack, condflags, result);
 			}
+
+			if (have_skip_offsets && !(condstack.back() & TRCSF_ACTIVE)) {
+				// nothing up to the next branch of this block can be executed, skip straight to it
+				i = this->cond_skip_offsets[instruction_offset] - 1;
+			}
 		} else {
 			if (condstack.empty() || condstack.back() & TRCSF_ACTIVE) {
 				switch(type) {
@@ -900,6 +927,39 @@ void TraceRestrictProgram::Execute(const Train* v, const TraceRestrictProgramInp
 	assert(condstack.empty());
 }
 
+/**
+ * Build the table of branch skip offsets used by Execute, this must be called whenever the instruction list is changed.
+ * For each if/elif/orif/else instruction this is the array offset of the next elif/orif/else/endif instruction of the same block,
+ * such that when a branch is inactive the instructions within it do not need to be stepped through one at a time.
+ */
+void TraceRestrictProgram::BuildConditionSkipOffsets()
+{
+	this->cond_skip_offsets.assign(this->items.size(), (uint32)this->items.size());
+
+	// array offset of the current branch instruction of each open block
+	std::vector<size_t> branch_stack;
+	for (size_t i = 0; i < this->items.size(); i++) {
+		const size_t offset = i;
+		TraceRestrictItem item = this->items[i];
+		if (IsTraceRestrictDoubleItem(item)) i++;
+		if (!IsTraceRestrictConditional(item)) continue;
+
+		TraceRestrictCondFlags condflags = GetTraceRestrictCondFlags(item);
+		bool is_endif = (GetTraceRestrictType(item) == TRIT_COND_ENDIF);
+		if (is_endif || (condflags & (TRCF_OR | TRCF_ELSE))) {
+			if (branch_stack.empty()) continue; // invalid program, rejected by Validate
+			this->cond_skip_offsets[branch_stack.back()] = (uint32)offset;
+			if (is_endif && !(condflags & TRCF_ELSE)) {
+				branch_stack.pop_back();
+			} else {
+				branch_stack.back() = offset;
+			}
+		} else {
+			branch_stack.push_back(offset);
+		}
+	}
+}
+
 void TraceRestrictProgram::ClearRefIds()
 {
 	if (this->refcount > 4) free(this->ref_ids.ptr_ref_ids.buffer);
@@ -2199,6 +2259,7 @@ CommandCost CmdProgramSignalTraceRestrict(TileIndex tile, DoCommandFlag flags, u
 		// move in modified program
 		prog->items.swap(items);
 		prog->actions_used_flags = actions_used_flags;
+		prog->BuildConditionSkipOffsets();
 
 		if (prog->items.size() == 0 && prog->refcount == 1) {
 			// program is empty, and this tile is the only reference to it
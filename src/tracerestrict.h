@@ -522,6 +522,7 @@ struct TraceRestrictProgram : TraceRestrictProgramPool::PoolItem<&_tracerestrict
 	std::vector<TraceRestrictItem> items;
 	uint32 refcount;
 	TraceRestrictProgramActionsUsedFlags actions_used_flags;
+	std::vector<uint32> cond_skip_offsets;   ///< Array offset of the next branch of the same block, for each conditional instruction, see BuildConditionSkipOffsets
 
 private:
 
@@ -555,6 +556,8 @@ public:
 
 	void Execute(const Train *v, const TraceRestrictProgramInput &input, TraceRestrictProgramResult &out) const;
 
+	void BuildConditionSkipOffsets();
+
 	inline const TraceRestrictRefId *GetRefIdsPtr() const { return const_cast<TraceRestrictProgram *>(this)->GetRefIdsPtr(); }
 
 	void IncrementRefCount(TraceRestrictRefId ref_id);
@@ -606,6 +609,7 @@ public:
 	/** Call validation function on current program instruction list and set actions_used_flags */
 	CommandCost Validate()
 	{
+		this->BuildConditionSkipOffsets();
 		return TraceRestrictProgram::Validate(items, actions_used_flags);
 	}
 };
@@ -62,8 +62,10 @@ enum TrainForceProceeding : byte {
 enum ConsistChangeFlags {
 	CCF_LENGTH     = 0x01,     ///< Allow vehicles to change length.
 	CCF_CAPACITY   = 0x02,     ///< Allow vehicles to change capacity.
+	CCF_NO_VERIFY  = 0x04,     ///< Do not check that capacities and lengths which may not change did not change.
 
 	CCF_TRACK      = 0,                          ///< Valid changes while vehicle is driving, and possibly changing tracks.
+	CCF_RAILTYPE   = CCF_NO_VERIFY,              ///< Valid changes while vehicle is driving onto a different rail type. This happens once per vehicle of the consist, so skip the checks.
 	CCF_LOADUNLOAD = 0,                          ///< Valid changes while vehicle is loading/unloading.
 	CCF_AUTOREFIT  = CCF_CAPACITY,               ///< Valid changes for autorefitting in stations.
 	CCF_REFIT      = CCF_LENGTH | CCF_CAPACITY,  ///< Valid changes for refitting in a depot.
@@ -87,6 +89,7 @@ bool TryPathReserve(Train *v, bool mark_as_stuck = false, bool first_tile_okay =
 void DeleteVisibleTrain(Train *v);
 
 void CheckBreakdownFlags(Train *v);
+void CheckIfTrainNeedsService(Train *v, bool defer_search = false);
 void GetTrainSpriteSize(EngineID engine, uint &width, uint &height, int &xoffs, int &yoffs, EngineImageType image_type);
 
 bool TrainOnCrossing(TileIndex tile);
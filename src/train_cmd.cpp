@@ -47,6 +47,7 @@
 #include "train_speed_adaptation.h"
 #include "event_logs.h"
 #include "3rdparty/cpp-btree/btree_map.h"
+#include INCLUDE_FOR_PREFETCH_NTA
 
 #include "table/strings.h"
 #include "table/train_cmd.h"
@@ -69,6 +70,8 @@ struct ChooseTrainTrackLookAheadState {
 	uint          order_items_start = 0;  ///< Order items start for VehicleOrderSaver
 	uint16        flags = 0;              ///< Flags
 	DestinationID reverse_dest = 0;       ///< Reverse station ID when CTTLASF_REVERSE_FOUND is set
+	TileIndex     reservation_end_tile = INVALID_TILE;           ///< Known end of the reservation, when reserving onwards from a long reserve signal
+	Trackdir      reservation_end_trackdir = INVALID_TRACKDIR;   ///< Trackdir of #reservation_end_tile
 };
 
 /** Flags for ChooseTrainTrack */
@@ -92,7 +95,6 @@ static inline bool CheckCompatibleRail(const Train *v, TileIndex tile, DiagDirec
 int ReversingDistanceTargetSpeed(const Train *v);
 bool TrainController(Train *v, Vehicle *nomove, bool reverse = true); // Also used in vehicle_sl.cpp.
 static TileIndex TrainApproachingCrossingTile(const Train *v);
-static void CheckIfTrainNeedsService(Train *v);
 static void CheckNextTrainTile(Train *v);
 extern TileIndex VehiclePosTraceRestrictPreviousSignalCallback(const Train *v, const void *, TraceRestrictPBSEntrySignalAuxField mode);
 static void TrainEnterStation(Train *v, StationID station);
@@ -345,40 +347,42 @@ void Train::ConsistChanged(ConsistChangeFlags allowed_changes)
 			}
 		}
 
-		uint16 new_cap = e_u->DetermineCapacity(u);
 		if (allowed_changes & CCF_CAPACITY) {
 			/* Update vehicle capacity. */
+			uint16 new_cap = e_u->DetermineCapacity(u);
 			if (u->cargo_cap > new_cap) u->cargo.Truncate(new_cap);
 			u->refit_cap = std::min(new_cap, u->refit_cap);
 			u->cargo_cap = new_cap;
-		} else {
+		} else if (!(allowed_changes & CCF_NO_VERIFY)) {
 			/* Verify capacity hasn't changed. */
-			if (new_cap != u->cargo_cap) ShowNewGrfVehicleError(u->engine_type, STR_NEWGRF_BROKEN, STR_NEWGRF_BROKEN_CAPACITY, GBUG_VEH_CAPACITY, true);
+			if (e_u->DetermineCapacity(u) != u->cargo_cap) ShowNewGrfVehicleError(u->engine_type, STR_NEWGRF_BROKEN, STR_NEWGRF_BROKEN_CAPACITY, GBUG_VEH_CAPACITY, true);
 		}
 		u->vcache.cached_cargo_age_period = GetVehicleProperty(u, PROP_TRAIN_CARGO_AGE_PERIOD, e_u->info.cargo_age_period);
 
-		/* check the vehicle length (callback) */
-		uint16 veh_len = CALLBACK_FAILED;
-		if (e_u->GetGRF() != nullptr && e_u->GetGRF()->grf_version >= 8) {
-			/* Use callback 36 */
-			veh_len = GetVehicleProperty(u, PROP_TRAIN_SHORTEN_FACTOR, CALLBACK_FAILED);
+		if ((allowed_changes & CCF_LENGTH) || !(allowed_changes & CCF_NO_VERIFY)) {
+			/* check the vehicle length (callback) */
+			uint16 veh_len = CALLBACK_FAILED;
+			if (e_u->GetGRF() != nullptr && e_u->GetGRF()->grf_version >= 8) {
+				/* Use callback 36 */
+				veh_len = GetVehicleProperty(u, PROP_TRAIN_SHORTEN_FACTOR, CALLBACK_FAILED);
 
-			if (veh_len != CALLBACK_FAILED && veh_len >= VEHICLE_LENGTH) {
-				ErrorUnknownCallbackResult(e_u->GetGRFID(), CBID_VEHICLE_LENGTH, veh_len);
+				if (veh_len != CALLBACK_FAILED && veh_len >= VEHICLE_LENGTH) {
+					ErrorUnknownCallbackResult(e_u->GetGRFID(), CBID_VEHICLE_LENGTH, veh_len);
+				}
+			} else if (HasBit(e_u->info.callback_mask, CBM_VEHICLE_LENGTH)) {
+				/* Use callback 11 */
+				veh_len = GetVehicleCallback(CBID_VEHICLE_LENGTH, 0, 0, u->engine_type, u);
 			}
-		} else if (HasBit(e_u->info.callback_mask, CBM_VEHICLE_LENGTH)) {
-			/* Use callback 11 */
-			veh_len = GetVehicleCallback(CBID_VEHICLE_LENGTH, 0, 0, u->engine_type, u);
-		}
-		if (veh_len == CALLBACK_FAILED) veh_len = rvi_u->shorten_factor;
-		veh_len = VEHICLE_LENGTH - Clamp(veh_len, 0, VEHICLE_LENGTH - 1);
+			if (veh_len == CALLBACK_FAILED) veh_len = rvi_u->shorten_factor;
+			veh_len = VEHICLE_LENGTH - Clamp(veh_len, 0, VEHICLE_LENGTH - 1);
 
-		if (allowed_changes & CCF_LENGTH) {
-			/* Update vehicle length. */
-			u->gcache.cached_veh_length = veh_len;
-		} else {
-			/* Verify length hasn't changed. */
-			if (veh_len != u->gcache.cached_veh_length) VehicleLengthChanged(u);
+			if (allowed_changes & CCF_LENGTH) {
+				/* Update vehicle length. */
+				u->gcache.cached_veh_length = veh_len;
+			} else {
+				/* Verify length hasn't changed. */
+				if (veh_len != u->gcache.cached_veh_length) VehicleLengthChanged(u);
+			}
 		}
 
 		this->gcache.cached_total_length += u->gcache.cached_veh_length;
@@ -1510,8 +1514,6 @@ static CommandCost CmdBuildRailWagon(TileIndex tile, DoCommandFlag flags, const
 					}
 			}
 		}
-
-		InvalidateVehicleTickCaches();
 	}
 
 	return CommandCost();
@@ -1652,8 +1654,6 @@ CommandCost CmdBuildRailVehicle(TileIndex tile, DoCommandFlag flags, const Engin
 		UpdateTrainGroupID(v);
 
 		CheckConsistencyOfArticulatedVehicle(v);
-
-		InvalidateVehicleTickCaches();
 	}
 
 	return CommandCost();
@@ -2273,7 +2273,6 @@ CommandCost CmdMoveRailVehicle(TileIndex tile, DoCommandFlag flags, uint32 p1, u
 		RestoreTrainBackup(original_dst);
 	}
 
-	InvalidateVehicleTickCaches();
 
 	return CommandCost();
 }
@@ -4294,10 +4293,34 @@ static void TryLongReserveChooseTrainTrack(Train *v, TileIndex tile, Trackdir td
 	CFollowTrackRail ft(v);
 	if (ft.Follow(tile, td) && HasLongReservePbsSignalOnTrackdir(v, ft.m_new_tile, FindFirstTrackdir(ft.m_new_td_bits), !long_enough, lookahead_state.flags)) {
 		// We reserved up to a LR signal, reserve past it as well. recursion
+		lookahead_state.reservation_end_tile = tile;
+		lookahead_state.reservation_end_trackdir = td;
 		ChooseTrainTrack(v, ft.m_new_tile, ft.m_exitdir, TrackdirBitsToTrackBits(ft.m_new_td_bits), CTTF_NO_LOOKAHEAD_VALIDATE | (force_res ? CTTF_FORCE_RES : CTTF_NONE), nullptr, lookahead_state);
 	}
 }
 
+/**
+ * Follow the reservation of a train to its end, for a train without a lookahead.
+ * When the end of the reservation is already known, because the caller has just reserved up to it,
+ * this avoids walking the whole reservation from the train's position again.
+ * The known end is only used if the reservation does not continue beyond it, in which case the result is the same as that of FollowTrainReservation.
+ * @param v The train.
+ * @param end_tile Tile which is known to be on the reservation of the train, or INVALID_TILE.
+ * @param end_trackdir Trackdir on \a end_tile.
+ * @return The end of the reservation, the okay field is not set.
+ */
+static PBSTileInfo FollowTrainReservationFromKnownEnd(const Train *v, TileIndex end_tile, Trackdir end_trackdir)
+{
+	if (end_tile != INVALID_TILE && v->lookahead == nullptr && !IsRailDepotTile(end_tile) &&
+			HasReservedTracks(v->tile, TrackToTrackBits(TrackdirToTrack(v->GetVehicleTrackdir())))) {
+		CFollowTrackRail ft(v->owner, GetRailTypeInfo(v->railtype)->all_compatible_railtypes);
+		if (!ft.Follow(end_tile, end_trackdir) || (ft.m_new_td_bits & TrackBitsToTrackdirBits(GetReservedTrackbits(ft.m_new_tile))) == TRACKDIR_BIT_NONE) {
+			return PBSTileInfo(end_tile, end_trackdir, false);
+		}
+	}
+	return FollowTrainReservation(v, nullptr, FTRF_OKAY_UNUSED);
+}
+
 static void TryLongReserveChooseTrainTrackFromReservationEnd(Train *v, bool no_reserve_vehicle_tile)
 {
 	ClearLookAheadIfInvalid(v);
@@ -4395,7 +4418,8 @@ static Track ChooseTrainTrack(Train *v, TileIndex tile, DiagDirection enterdir,
 		ClearLookAheadIfInvalid(v);
 	}
 
-	PBSTileInfo   origin = FollowTrainReservation(v, nullptr, FTRF_OKAY_UNUSED);
+	PBSTileInfo   origin = FollowTrainReservationFromKnownEnd(v, lookahead_state.reservation_end_tile, lookahead_state.reservation_end_trackdir);
+	lookahead_state.reservation_end_tile = INVALID_TILE;
 	PBSTileInfo   res_dest(tile, INVALID_TRACKDIR, false);
 	DiagDirection dest_enterdir = enterdir;
 	if (do_track_reservation) {
@@ -5486,6 +5510,9 @@ bool TrainController(Train *v, Vehicle *nomove, bool reverse)
 
 	/* For every vehicle after and including the given vehicle */
 	for (prev = v->Previous(); v != nomove; prev = v, v = v->Next()) {
+		/* Wagons of a consist are separate pool items, start fetching the next one whilst this one is moved */
+		if (v->Next() != nomove) PREFETCH_NTA(v->Next());
+
 		old_direction = v->direction;
 		old_trackbits = v->track;
 		old_gv_flags = v->gv_flags;
@@ -5753,7 +5780,7 @@ bool TrainController(Train *v, Vehicle *nomove, bool reverse)
 
 					if (GetTileRailTypeByTrackBit(gp.new_tile, chosen_track) != GetTileRailTypeByTrackBit(gp.old_tile, old_trackbits)) {
 						/* v->track and v->tile must both be valid and consistent before this is called */
-						v->First()->ConsistChanged(CCF_TRACK);
+						v->First()->ConsistChanged(CCF_RAILTYPE);
 					}
 				}
 
@@ -6775,7 +6802,12 @@ bool Train::Tick()
  * Check whether a train needs service, and if so, find a depot or service it.
  * @return v %Train to check.
  */
-static void CheckIfTrainNeedsService(Train *v)
+/**
+ * Check whether a train needs servicing, and if so send it to a nearby depot.
+ * @param v Front engine of the train.
+ * @param defer_search Queue the depot search instead of doing it now, if enabled.
+ */
+void CheckIfTrainNeedsService(Train *v, bool defer_search)
 {
 	if (Company::Get(v->owner)->settings.vehicle.servint_trains == 0 || !v->NeedsAutomaticServicing()) return;
 	if (v->IsChainInDepot()) {
@@ -6783,6 +6815,8 @@ static void CheckIfTrainNeedsService(Train *v)
 		return;
 	}
 
+	if (defer_search && QueueDeferredDepotSearch(v)) return;
+
 	uint max_penalty;
 	switch (_settings_game.pf.pathfinder_for_trains) {
 		case VPF_NPF:  max_penalty = _settings_game.pf.npf.maximum_go_to_depot_penalty;  break;
@@ -6832,7 +6866,7 @@ void Train::OnNewDay()
 void Train::OnPeriodic()
 {
 	if (this->IsFrontEngine()) {
-		CheckIfTrainNeedsService(this);
+		CheckIfTrainNeedsService(this, true);
 
 		CheckOrders(this);
 
@@ -7002,7 +7036,6 @@ Train* CmdBuildVirtualRailWagon(const Engine *e, uint32 user, bool no_consist_ch
 
 	CheckConsistencyOfArticulatedVehicle(v);
 
-	InvalidateVehicleTickCaches();
 
 	return v;
 }
@@ -7083,7 +7116,6 @@ Train* BuildVirtualRailVehicle(EngineID eid, StringID &error, uint32 user, bool
 
 	CheckConsistencyOfArticulatedVehicle(v);
 
-	InvalidateVehicleTickCaches();
 
 	return v;
 }
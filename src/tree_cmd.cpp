@@ -23,6 +23,7 @@
 #include "core/random_func.hpp"
 #include "newgrf_generic.h"
 #include "date_func.h"
+#include "pathfinder/water_regions.h"
 
 #include "table/strings.h"
 #include "table/tree_land.h"
@@ -124,6 +125,7 @@ static void PlantTreesOnTile(TileIndex tile, TreeType treetype, uint count, uint
 	}
 
 	MakeTree(tile, treetype, count, growth, ground, density);
+	if (ground == TREE_GROUND_SHORE) InvalidateWaterRegion(tile);
 }
 
 /**
@@ -921,6 +923,8 @@ static void TileLoop_Trees(TileIndex tile)
 		}
 	}
 
+	/* Growth and spreading only happen at every 16th processing, and never when both are switched off.
+	 * Everything above has to run for every tree tile, as it keeps the ground in sync with the climate. */
 	if ((cycle & 15) < 15) return;
 
 	if (_settings_game.construction.extra_tree_placement == ETP_NO_GROWTH_NO_SPREAD) return;
@@ -929,7 +933,7 @@ static void TileLoop_Trees(TileIndex tile)
 		if (_settings_game.construction.tree_growth_rate == 4) return;
 
 		/* slow, very slow, extremely slow */
-		uint16 grow_slowing_values[4] = { 0x10000 / 5, 0x10000 / 20, 0x10000 / 120, 0 };
+		static const uint16 grow_slowing_values[4] = { 0x10000 / 5, 0x10000 / 20, 0x10000 / 120, 0 };
 
 		if (GB(Random(), 0, 16) >= grow_slowing_values[_settings_game.construction.tree_growth_rate - 1]) {
 			return;
@@ -1015,7 +1019,7 @@ static void TileLoop_Trees(TileIndex tile)
 			} else {
 				/* just one tree, change type into MP_CLEAR */
 				switch (GetTreeGround(tile)) {
-					case TREE_GROUND_SHORE: MakeShore(tile); break;
+					case TREE_GROUND_SHORE: MakeShore(tile); InvalidateWaterRegion(tile); break;
 					case TREE_GROUND_GRASS: MakeClear(tile, CLEAR_GRASS, GetTreeDensity(tile)); break;
 					case TREE_GROUND_ROUGH: MakeClear(tile, CLEAR_ROUGH, 3); break;
 					case TREE_GROUND_ROUGH_SNOW: {
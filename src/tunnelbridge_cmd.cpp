@@ -52,6 +52,7 @@
 #include "newgrf_roadstop.h"
 #include "newgrf_newsignals.h"
 #include "spritecache.h"
+#include "pathfinder/water_regions.h"
 
 #include "table/strings.h"
 #include "table/bridge_land.h"
@@ -785,6 +786,8 @@ CommandCost CmdBuildBridge(TileIndex end_tile, DoCommandFlag flags, uint32 p1, u
 				if (is_new_owner && c != nullptr) c->infrastructure.water += bridge_len * TUNNELBRIDGE_TRACKBIT_FACTOR;
 				MakeAqueductBridgeRamp(tile_start, owner, dir);
 				MakeAqueductBridgeRamp(tile_end,   owner, ReverseDiagDir(dir));
+				InvalidateWaterRegion(tile_start);
+				InvalidateWaterRegion(tile_end);
 				CheckForDockingTile(tile_start);
 				CheckForDockingTile(tile_end);
 				break;
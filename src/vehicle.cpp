@@ -61,9 +61,11 @@
 #include "scope_info.h"
 #include "debug_settings.h"
 #include "network/network_sync.h"
+#include "pathfinder/pathfinder_stats.h"
 #include "3rdparty/cpp-btree/btree_set.h"
 #include "3rdparty/cpp-btree/btree_map.h"
 #include "3rdparty/robin_hood/robin_hood.h"
+#include INCLUDE_FOR_PREFETCH_NTA
 
 #include "table/strings.h"
 
@@ -478,6 +480,7 @@ Vehicle::Vehicle(VehicleType type)
 	this->last_loading_tick = 0;
 	this->cur_image_valid_dir  = INVALID_DIR;
 	this->vcache.cached_veh_flags = 0;
+	MarkVehicleTickCacheDirty(this);
 }
 
 using VehicleTypeTileHash = robin_hood::unordered_map<TileIndex, VehicleID>;
@@ -487,6 +490,9 @@ static Vehicle *VehicleFromTileHash(int xl, int yl, int xu, int yu, VehicleType
 {
 	VehicleTypeTileHash &vhash = _vehicle_tile_hashes[type];
 
+	/* Avoid hashing each tile of the area when there are no vehicles of this type on the map at all */
+	if (vhash.empty()) return nullptr;
+
 	for (int y = yl; ; y++) {
 		for (int x = xl; ; x++) {
 			auto iter = vhash.find(TileXY(x, y));
@@ -1020,7 +1026,9 @@ static btree::btree_set<VehicleID> _vehicles_to_templatereplace;
 void InitializeVehicles()
 {
 	_vehicles_to_autoreplace.clear();
+	_deferred_depot_searches.clear();
 	ResetVehicleHash();
+	ResetPathfinderStats();
 }
 
 uint CountVehiclesInChain(const Vehicle *v)
@@ -1151,11 +1159,13 @@ void Vehicle::PreDestructor()
 {
 	if (CleaningPool()) return;
 
+	ClearPathfinderVehicleStats(this->index);
+
 	SCOPE_INFO_FMT([this], "Vehicle::PreDestructor: %s", scope_dumper().VehicleInfo(this));
 
 	if (Station::IsValidID(this->last_station_visited)) {
 		Station *st = Station::Get(this->last_station_visited);
-		st->loading_vehicles.erase(std::remove(st->loading_vehicles.begin(), st->loading_vehicles.end(), this), st->loading_vehicles.end());
+		st->RemoveLoadingVehicle(this);
 
 		HideFillingPercent(&this->fill_percent_te_id);
 		this->CancelReservation(INVALID_STATION, st);
@@ -1243,9 +1253,7 @@ Vehicle::~Vehicle()
 		return;
 	}
 
-	if (this->type != VEH_EFFECT) InvalidateVehicleTickCaches();
-
-	if (this->type == VEH_DISASTER) RemoveFromOtherVehicleTickCache(this);
+	RemoveFromVehicleTickCaches(this);
 
 	if (this->breakdowns_since_last_service) _vehicles_to_pay_repair.erase(this->index);
 
@@ -1263,6 +1271,8 @@ Vehicle::~Vehicle()
 
 	if (this->type < VEH_COMPANY_END) UpdateVehicleTileHash(this, true);
 	UpdateVehicleViewportHash(this, INVALID_COORD, 0);
+	/* Effect vehicles are never referenced by news or inspected, and are created and deleted very often. */
+	if (this->type == VEH_EFFECT) return;
 	DeleteVehicleNews(this->index, INVALID_STRING_ID);
 	DeleteNewGRFInspectWindow(GetGrfSpecFeature(this->type), this->index);
 }
@@ -1321,7 +1331,8 @@ static void RunVehicleDayProc()
 	SCOPE_INFO_FMT([&v], "RunVehicleDayProc: %s", scope_dumper().VehicleInfo(v));
 	for (size_t i = _date_fract; i < Vehicle::GetPoolSize(); i += DAY_TICKS) {
 		v = Vehicle::Get(i);
-		if (v == nullptr) continue;
+		/* Effect and disaster vehicles have neither day procs nor engines, and can be many. */
+		if (v == nullptr || v->type >= VEH_COMPANY_END) continue;
 
 		/* Call the 32-day callback if needed */
 		if ((v->day_counter & 0x1F) == 0 && v->HasEngineType() && (Engine::Get(v->engine_type)->callbacks_used & SGCU_VEHICLE_32DAY_CALLBACK) != 0) {
@@ -1386,9 +1397,70 @@ std::vector<Aircraft *> _tick_aircraft_front_cache;
 std::vector<Ship *> _tick_ship_cache;
 std::vector<Vehicle *> _tick_other_veh_cache;
 
-std::vector<VehicleID> _remove_from_tick_effect_veh_cache;
+btree::btree_set<VehicleID> _remove_from_tick_effect_veh_cache; ///< Effect vehicles deleted since the last effect tick, the pool reuses their IDs for new effects.
 btree::btree_set<VehicleID> _tick_effect_veh_cache;
 
+/** Vehicles which have been created or have changed front status since the tick caches were last updated */
+static std::vector<VehicleID> _tick_cache_pending_vehicles;
+/** Whether any entries in the tick cache vectors have been set to nullptr since the tick caches were last updated */
+static bool _tick_cache_has_removed_entries = false;
+
+/** Queued periodic servicing depot searches, in order of deadline */
+std::vector<DeferredDepotSearch> _deferred_depot_searches;
+
+/**
+ * Queue the periodic servicing depot search of a train or road vehicle,
+ * if deferring these searches is enabled.
+ * The search is redone from scratch by RunDeferredDepotSearches, at the latest at the deadline.
+ * As the deferral is shorter than the period between service checks, a vehicle is queued at most once.
+ * @param v Front vehicle.
+ * @return Whether the search was queued.
+ */
+bool QueueDeferredDepotSearch(const Vehicle *v)
+{
+	if (_settings_game.pf.deferred_depot_search_ticks == 0) return false;
+
+	_deferred_depot_searches.push_back({ v->index, _tick_counter + _settings_game.pf.deferred_depot_search_ticks });
+	return true;
+}
+
+/**
+ * Do the queued servicing depot searches which are at their deadline,
+ * and a share of the remaining queue such that the queue is spread out evenly over the deferral period.
+ * The number of searches done only depends on the queue and settings, so that this is deterministic.
+ */
+static void RunDeferredDepotSearches()
+{
+	if (_deferred_depot_searches.empty()) return;
+
+	const size_t ticks = std::max<uint>(_settings_game.pf.deferred_depot_search_ticks, 1);
+	const size_t budget = (_deferred_depot_searches.size() + ticks - 1) / ticks;
+
+	size_t done = 0;
+	while (done < _deferred_depot_searches.size() && (done < budget || _deferred_depot_searches[done].deadline <= _tick_counter || _settings_game.pf.deferred_depot_search_ticks == 0)) {
+		Vehicle *v = Vehicle::GetIfValid(_deferred_depot_searches[done].veh);
+		done++;
+		if (v == nullptr) continue;
+
+		if (v->type == VEH_TRAIN && Train::From(v)->IsFrontEngine()) {
+			CheckIfTrainNeedsService(Train::From(v));
+		} else if (v->type == VEH_ROAD && RoadVehicle::From(v)->IsFrontEngine()) {
+			CheckIfRoadVehNeedsService(RoadVehicle::From(v));
+		}
+	}
+	_deferred_depot_searches.erase(_deferred_depot_searches.begin(), _deferred_depot_searches.begin() + done);
+}
+
+/** Number of ticks between calls to Vehicle::OnPeriodic at day lengths >= 8 */
+static const uint PERIODIC_VEHICLE_BUCKET_COUNT = 0x200;
+/** Company vehicles (all parts) bucketed by vehicle index modulo PERIODIC_VEHICLE_BUCKET_COUNT, each sorted by vehicle index */
+static std::array<std::vector<VehicleID>, PERIODIC_VEHICLE_BUCKET_COUNT> _periodic_vehicle_buckets;
+
+static std::vector<VehicleID> &GetPeriodicVehicleBucket(VehicleID index)
+{
+	return _periodic_vehicle_buckets[index % PERIODIC_VEHICLE_BUCKET_COUNT];
+}
+
 void ClearVehicleTickCaches()
 {
 	_tick_train_too_heavy_cache.clear();
@@ -1399,12 +1471,125 @@ void ClearVehicleTickCaches()
 	_tick_effect_veh_cache.clear();
 	_remove_from_tick_effect_veh_cache.clear();
 	_tick_other_veh_cache.clear();
+	_tick_cache_pending_vehicles.clear();
+	_tick_cache_has_removed_entries = false;
+	for (std::vector<VehicleID> &bucket : _periodic_vehicle_buckets) {
+		bucket.clear();
+	}
+}
+
+/**
+ * Find a vehicle in a tick cache vector.
+ * The vector is sorted by vehicle index, and may contain nullptr entries for removed vehicles.
+ * All non-null entries are valid vehicles.
+ * @param cache Tick cache vector.
+ * @param index Vehicle index to look for.
+ * @return Iterator to the entry, or cache.end() if not found.
+ */
+template <typename T>
+static typename std::vector<T *>::iterator FindInVehicleTickCache(std::vector<T *> &cache, VehicleID index)
+{
+	size_t lo = 0;
+	size_t hi = cache.size();
+	while (lo < hi) {
+		const size_t mid = lo + ((hi - lo) / 2);
+		size_t probe = mid;
+		while (probe < hi && cache[probe] == nullptr) probe++;
+		if (probe == hi) {
+			hi = mid;
+		} else if (cache[probe]->index == index) {
+			return cache.begin() + probe;
+		} else if (cache[probe]->index < index) {
+			lo = probe + 1;
+		} else {
+			hi = mid;
+		}
+	}
+	return cache.end();
+}
+
+template <typename T>
+static void RemoveFromVehicleTickCache(std::vector<T *> &cache, const Vehicle *v)
+{
+	auto iter = FindInVehicleTickCache(cache, v->index);
+	if (iter != cache.end()) {
+		*iter = nullptr;
+		_tick_cache_has_removed_entries = true;
+	}
 }
 
-void RemoveFromOtherVehicleTickCache(const Vehicle *v)
+/**
+ * Insert or remove a (valid) vehicle from a tick cache vector, which must not contain nullptr entries.
+ * @param cache Tick cache vector.
+ * @param v Vehicle.
+ * @param present Whether the vehicle should be present in the cache.
+ */
+template <typename T>
+static void UpdateVehicleTickCacheMembership(std::vector<T *> &cache, T *v, bool present)
 {
-	for (auto &u : _tick_other_veh_cache) {
-		if (u == v) u = nullptr;
+	auto iter = std::lower_bound(cache.begin(), cache.end(), v->index, [](const T *a, VehicleID index) {
+		return a->index < index;
+	});
+	const bool found = (iter != cache.end() && *iter == v);
+	if (present && !found) {
+		cache.insert(iter, v);
+	} else if (!present && found) {
+		cache.erase(iter);
+	}
+}
+
+/**
+ * Mark a vehicle as needing its tick cache membership re-evaluated, this is applied at the next UpdateVehicleTickCaches.
+ * This is called when a vehicle is created or when its front status changes.
+ * @param v Vehicle.
+ */
+void MarkVehicleTickCacheDirty(const Vehicle *v)
+{
+	if (!_tick_caches_valid || v->type == VEH_EFFECT) return;
+	_tick_cache_pending_vehicles.push_back(v->index);
+}
+
+/**
+ * Remove a vehicle which is being deleted from the tick caches.
+ * The entry is replaced with nullptr, such that this is safe to call whilst iterating the tick caches.
+ * @param v Vehicle.
+ */
+void RemoveFromVehicleTickCaches(const Vehicle *v)
+{
+	if (!_tick_caches_valid) return;
+
+	if (v->type < VEH_COMPANY_END) {
+		std::vector<VehicleID> &bucket = GetPeriodicVehicleBucket(v->index);
+		auto iter = std::lower_bound(bucket.begin(), bucket.end(), v->index);
+		if (iter != bucket.end() && *iter == v->index) bucket.erase(iter);
+	}
+
+	switch (v->type) {
+		default:
+			RemoveFromVehicleTickCache(_tick_other_veh_cache, v);
+			break;
+
+		case VEH_TRAIN:
+			for (auto &u : _tick_train_too_heavy_cache) {
+				if (u == v) u = nullptr;
+			}
+			RemoveFromVehicleTickCache(_tick_train_front_cache, v);
+			break;
+
+		case VEH_ROAD:
+			RemoveFromVehicleTickCache(_tick_road_veh_front_cache, v);
+			break;
+
+		case VEH_AIRCRAFT:
+			RemoveFromVehicleTickCache(_tick_aircraft_front_cache, v);
+			break;
+
+		case VEH_SHIP:
+			RemoveFromVehicleTickCache(_tick_ship_cache, v);
+			break;
+
+		case VEH_EFFECT:
+			break;
 	}
 }
 
@@ -1417,6 +1602,7 @@ void RebuildVehicleTickCaches()
 
 	for (Vehicle *v : Vehicle::Iterate()) {
 		si_v = v;
+		if (v->type < VEH_COMPANY_END) GetPeriodicVehicleBucket(v->index).push_back(v->index);
 		switch (v->type) {
 			default:
 				_tick_other_veh_cache.push_back(v);
@@ -1447,15 +1633,93 @@ void RebuildVehicleTickCaches()
 	_tick_caches_valid = true;
 }
 
+/**
+ * Apply pending incremental changes to the tick caches: compact out removed entries and
+ * insert/remove vehicles which have been created or have changed front status.
+ */
+static void ApplyPendingVehicleTickCacheUpdates()
+{
+	if (_tick_cache_has_removed_entries) {
+		auto compact = [](auto &cache) {
+			cache.erase(std::remove(cache.begin(), cache.end(), nullptr), cache.end());
+		};
+		compact(_tick_train_too_heavy_cache);
+		compact(_tick_train_front_cache);
+		compact(_tick_road_veh_front_cache);
+		compact(_tick_aircraft_front_cache);
+		compact(_tick_ship_cache);
+		compact(_tick_other_veh_cache);
+		_tick_cache_has_removed_entries = false;
+	}
+
+	if (_tick_cache_pending_vehicles.empty()) return;
+
+	std::sort(_tick_cache_pending_vehicles.begin(), _tick_cache_pending_vehicles.end());
+	_tick_cache_pending_vehicles.erase(std::unique(_tick_cache_pending_vehicles.begin(), _tick_cache_pending_vehicles.end()), _tick_cache_pending_vehicles.end());
+
+	for (VehicleID id : _tick_cache_pending_vehicles) {
+		/* Deleted vehicles have already been removed */
+		Vehicle *v = Vehicle::GetIfValid(id);
+		if (v == nullptr) continue;
+
+		if (v->type < VEH_COMPANY_END) {
+			std::vector<VehicleID> &bucket = GetPeriodicVehicleBucket(id);
+			auto iter = std::lower_bound(bucket.begin(), bucket.end(), id);
+			if (iter == bucket.end() || *iter != id) bucket.insert(iter, id);
+		}
+
+		const bool is_front = (v->Previous() == nullptr);
+		switch (v->type) {
+			default:
+				UpdateVehicleTickCacheMembership(_tick_other_veh_cache, v, true);
+				break;
+
+			case VEH_TRAIN:
+				UpdateVehicleTickCacheMembership(_tick_train_front_cache, Train::From(v), is_front);
+				break;
+
+			case VEH_ROAD:
+				UpdateVehicleTickCacheMembership(_tick_road_veh_front_cache, RoadVehicle::From(v), is_front);
+				break;
+
+			case VEH_AIRCRAFT:
+				UpdateVehicleTickCacheMembership(_tick_aircraft_front_cache, Aircraft::From(v), is_front);
+				break;
+
+			case VEH_SHIP:
+				UpdateVehicleTickCacheMembership(_tick_ship_cache, Ship::From(v), is_front);
+				break;
+
+			case VEH_EFFECT:
+				break;
+		}
+	}
+	_tick_cache_pending_vehicles.clear();
+}
+
+/**
+ * Make the tick caches up to date, either by applying pending incremental changes, or by a full rebuild if the caches are invalid.
+ */
+static void UpdateVehicleTickCaches()
+{
+	if (!_tick_caches_valid || HasChickenBit(DCBF_VEH_TICK_CACHE)) {
+		RebuildVehicleTickCaches();
+	} else {
+		ApplyPendingVehicleTickCacheUpdates();
+	}
+}
+
 void ValidateVehicleTickCaches()
 {
 	if (!_tick_caches_valid) return;
 
+	ApplyPendingVehicleTickCacheUpdates();
+
 	std::vector<Train *> saved_tick_train_too_heavy_cache = std::move(_tick_train_too_heavy_cache);
 	std::sort(saved_tick_train_too_heavy_cache.begin(), saved_tick_train_too_heavy_cache.end(), [&](const Vehicle *a, const Vehicle *b) {
 		return a->index < b->index;
 	});
-    saved_tick_train_too_heavy_cache.erase(std::unique(saved_tick_train_too_heavy_cache.begin(), saved_tick_train_too_heavy_cache.end()), saved_tick_train_too_heavy_cache.end());
+	saved_tick_train_too_heavy_cache.erase(std::unique(saved_tick_train_too_heavy_cache.begin(), saved_tick_train_too_heavy_cache.end()), saved_tick_train_too_heavy_cache.end());
 	std::vector<Train *> saved_tick_train_front_cache = std::move(_tick_train_front_cache);
 	std::vector<RoadVehicle *> saved_tick_road_veh_front_cache = std::move(_tick_road_veh_front_cache);
 	std::vector<Aircraft *> saved_tick_aircraft_front_cache = std::move(_tick_aircraft_front_cache);
@@ -1465,17 +1729,18 @@ void ValidateVehicleTickCaches()
 		saved_tick_effect_veh_cache.erase(id);
 	}
 	std::vector<Vehicle *> saved_tick_other_veh_cache = std::move(_tick_other_veh_cache);
-	saved_tick_other_veh_cache.erase(std::remove(saved_tick_other_veh_cache.begin(), saved_tick_other_veh_cache.end(), nullptr), saved_tick_other_veh_cache.end());
+	std::array<std::vector<VehicleID>, PERIODIC_VEHICLE_BUCKET_COUNT> saved_periodic_vehicle_buckets = std::move(_periodic_vehicle_buckets);
 
 	RebuildVehicleTickCaches();
 
 	assert(saved_tick_train_too_heavy_cache == _tick_train_too_heavy_cache);
-	assert(saved_tick_train_front_cache == saved_tick_train_front_cache);
+	assert(saved_tick_train_front_cache == _tick_train_front_cache);
 	assert(saved_tick_road_veh_front_cache == _tick_road_veh_front_cache);
 	assert(saved_tick_aircraft_front_cache == _tick_aircraft_front_cache);
 	assert(saved_tick_ship_cache == _tick_ship_cache);
 	assert(saved_tick_effect_veh_cache == _tick_effect_veh_cache);
 	assert(saved_tick_other_veh_cache == _tick_other_veh_cache);
+	assert(saved_periodic_vehicle_buckets == _periodic_vehicle_buckets);
 }
 
 void VehicleTickCargoAging(Vehicle *v)
@@ -1526,11 +1791,14 @@ void CallVehicleTicks()
 		 * Use a fixed interval of 512 ticks (unscaled) instead
 		 */
 
+		UpdateVehicleTickCaches();
+
 		Vehicle *v = nullptr;
 		SCOPE_INFO_FMT([&v], "CallVehicleTicks -> OnPeriodic: %s", scope_dumper().VehicleInfo(v));
-		for (size_t i = (size_t)(_scaled_tick_counter & 0x1FF); i < Vehicle::GetPoolSize(); i += 0x200) {
-			v = Vehicle::Get(i);
-			if (v == nullptr) continue;
+		const std::vector<VehicleID> &bucket = _periodic_vehicle_buckets[_scaled_tick_counter % PERIODIC_VEHICLE_BUCKET_COUNT];
+		for (auto iter = bucket.begin(); iter != bucket.end();) {
+			const VehicleID id = *iter;
+			v = Vehicle::Get(id);
 
 			/* This is called once per day for each vehicle, but not in the first tick of the day */
 			switch (v->type) {
@@ -1549,24 +1817,33 @@ void CallVehicleTicks()
 				default:
 					break;
 			}
+
+			/* Look up the next entry by index, in case the bucket has been modified */
+			iter = std::upper_bound(bucket.begin(), bucket.end(), id);
 		}
 	}
 
+	if (_game_mode == GM_NORMAL) RunDeferredDepotSearches();
+
 	RecordSyncEvent(NSRE_VEH_PERIODIC);
 
 	{
 		PerformanceMeasurer framerate(PFE_GL_ECONOMY);
 		Station *si_st = nullptr;
 		SCOPE_INFO_FMT([&si_st], "CallVehicleTicks: LoadUnloadStation: %s", scope_dumper().StationInfo(si_st));
-		for (Station *st : Station::Iterate()) {
-			si_st = st;
-			LoadUnloadStation(st);
+		/* Only stations with loading vehicles need to be visited, in station ID order.
+		 * The set may be modified by LoadUnloadStation, so look up the next entry each time. */
+		for (auto iter = _stations_with_loading_vehicles.begin(); iter != _stations_with_loading_vehicles.end();) {
+			const StationID id = *iter;
+			si_st = Station::Get(id);
+			LoadUnloadStation(si_st);
+			iter = _stations_with_loading_vehicles.upper_bound(id);
 		}
 	}
 
 	RecordSyncEvent(NSRE_VEH_LOAD_UNLOAD);
 
-	if (!_tick_caches_valid || HasChickenBit(DCBF_VEH_TICK_CACHE)) RebuildVehicleTickCaches();
+	UpdateVehicleTickCaches();
 
 	Vehicle *v = nullptr;
 	SCOPE_INFO_FMT([&v], "CallVehicleTicks: %s", scope_dumper().VehicleInfo(v));
@@ -1596,6 +1873,7 @@ void CallVehicleTicks()
 		}
 		_tick_train_too_heavy_cache.clear();
 		for (Train *front : _tick_train_front_cache) {
+			if (front == nullptr) continue;
 			v = front;
 			if (!front->Train::Tick()) continue;
 			for (Train *u = front; u != nullptr; u = u->Next()) {
@@ -1608,7 +1886,13 @@ void CallVehicleTicks()
 	RecordSyncEvent(NSRE_VEH_TRAIN);
 	{
 		PerformanceMeasurer framerate(PFE_GL_ROADVEHS);
-		for (RoadVehicle *front : _tick_road_veh_front_cache) {
+		const size_t count = _tick_road_veh_front_cache.size();
+		for (size_t i = 0; i < count; i++) {
+			RoadVehicle *front = _tick_road_veh_front_cache[i];
+			/* Controllers of distinct vehicles are not independent (shared random state, tile hash, road stops),
+			 * so they cannot be ticked concurrently. Hide some of the pool access latency instead. */
+			if (i + 1 < count) PREFETCH_NTA(_tick_road_veh_front_cache[i + 1]);
+			if (front == nullptr) continue;
 			v = front;
 			if (!front->RoadVehicle::Tick()) continue;
 			for (RoadVehicle *u = front; u != nullptr; u = u->Next()) {
@@ -1622,6 +1906,7 @@ void CallVehicleTicks()
 	{
 		PerformanceMeasurer framerate(PFE_GL_AIRCRAFT);
 		for (Aircraft *front : _tick_aircraft_front_cache) {
+			if (front == nullptr) continue;
 			v = front;
 			if (!front->Aircraft::Tick()) continue;
 			for (Aircraft *u = front; u != nullptr; u = u->Next()) {
@@ -1633,7 +1918,11 @@ void CallVehicleTicks()
 	if (!_tick_aircraft_front_cache.empty()) RecordSyncEvent(NSRE_VEH_AIR);
 	{
 		PerformanceMeasurer framerate(PFE_GL_SHIPS);
-		for (Ship *s : _tick_ship_cache) {
+		const size_t count = _tick_ship_cache.size();
+		for (size_t i = 0; i < count; i++) {
+			Ship *s = _tick_ship_cache[i];
+			if (i + 1 < count) PREFETCH_NTA(_tick_ship_cache[i + 1]);
+			if (s == nullptr) continue;
 			v = s;
 			if (!s->Ship::Tick()) continue;
 			for (Ship *u = s; u != nullptr; u = u->Next()) {
@@ -1816,11 +2105,11 @@ void CallVehicleTicks()
 
 void RemoveVirtualTrainsOfUser(uint32 user)
 {
-	if (!_tick_caches_valid || HasChickenBit(DCBF_VEH_TICK_CACHE)) RebuildVehicleTickCaches();
+	UpdateVehicleTickCaches();
 
 	Backup<CompanyID> cur_company(_current_company, FILE_LINE);
 	for (const Train *front : _tick_train_front_cache) {
-		if (front->IsVirtual() && front->motion_counter == user) {
+		if (front != nullptr && front->IsVirtual() && front->motion_counter == user) {
 			cur_company.Change(front->owner);
 			DoCommandP(0, front->index, 0, CMD_DELETE_VIRTUAL_TRAIN);
 		}
@@ -3494,7 +3783,7 @@ void Vehicle::LeaveStation()
 	this->current_order.MakeLeaveStation();
 	Station *st = Station::Get(this->last_station_visited);
 	this->CancelReservation(INVALID_STATION, st);
-	st->loading_vehicles.erase(std::remove(st->loading_vehicles.begin(), st->loading_vehicles.end(), this), st->loading_vehicles.end());
+	st->RemoveLoadingVehicle(this);
 
 	HideFillingPercent(&this->fill_percent_te_id);
 	trip_occupancy = CalcPercentVehicleFilled(this, nullptr);
@@ -4149,6 +4438,7 @@ void Vehicle::SetNext(Vehicle *next)
 			v->first = this->next;
 		}
 		this->next->previous = nullptr;
+		MarkVehicleTickCacheDirty(this->next);
 	}
 
 	this->next = next;
@@ -4157,6 +4447,7 @@ void Vehicle::SetNext(Vehicle *next)
 		/* A new next vehicle. Update the first and previous pointers */
 		if (this->next->previous != nullptr) this->next->previous->next = nullptr;
 		this->next->previous = this;
+		MarkVehicleTickCacheDirty(this->next);
 		for (Vehicle *v = this->next; v != nullptr; v = v->Next()) {
 			v->first = this->first;
 		}
@@ -75,6 +75,7 @@ enum NewGRFCacheValidValues {
 	NCVV_COMPANY_INFORMATION       = 3, ///< This bit will be set if the NewGRF var 43 currently stored is valid.
 	NCVV_POSITION_IN_VEHICLE       = 4, ///< This bit will be set if the NewGRF var 4D currently stored is valid.
 	NCVV_CONSIST_CARGO_INFORMATION_UD = 5, ///< This bit will be set if the uppermost byte of NewGRF var 42 currently stored is valid.
+	NCVV_CONSIST_ENGINE_ID_COUNT   = 6, ///< This bit will be set if the NewGRF var 60 currently stored for #NewGRFCache::consist_engine_id_count_param is valid.
 	NCVV_END,                           ///< End of the bits.
 };
 
@@ -86,6 +87,8 @@ struct NewGRFCache {
 	uint32 consist_cargo_information; ///< Cache for NewGRF var 42. (Note: The cargotype is untranslated in the cache because the accessing GRF is yet unknown.)
 	uint32 company_information;       ///< Cache for NewGRF var 43.
 	uint32 position_in_vehicle;       ///< Cache for NewGRF var 4D.
+	uint16 consist_engine_id_count;   ///< Cache for NewGRF var 60.
+	uint16 consist_engine_id_count_param; ///< Parameter of the cached NewGRF var 60.
 	uint8  cache_valid;               ///< Bitset that indicates which cache values are valid.
 };
 
@@ -1533,7 +1536,8 @@ inline void InvalidateVehicleTickCaches()
 }
 
 void ClearVehicleTickCaches();
-void RemoveFromOtherVehicleTickCache(const Vehicle *v);
+void MarkVehicleTickCacheDirty(const Vehicle *v);
+void RemoveFromVehicleTickCaches(const Vehicle *v);
 void UpdateAllVehiclesIsDrawn();
 
 void ShiftVehicleDates(int interval);
@@ -1110,7 +1110,6 @@ void UpdateNewVirtualTrainFromSource(Train *v, const T *src)
 	}
 
 	v->First()->ConsistChanged(CCF_ARRANGE);
-	InvalidateVehicleTickCaches();
 }
 
 Train* VirtualTrainFromTemplateVehicle(const TemplateVehicle* tv, StringID &err, uint32 user)
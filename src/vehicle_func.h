@@ -118,6 +118,17 @@ inline bool HasVehicleOnPosXY(int x, int y, VehicleType type, void *data, Vehicl
 }
 
 void CallVehicleTicks();
+
+/** A queued periodic servicing depot search of a train or road vehicle. */
+struct DeferredDepotSearch {
+	VehicleID veh;    ///< Front vehicle which wants to search for a depot.
+	uint64 deadline;  ///< Tick counter by which the search must be done.
+};
+
+extern std::vector<DeferredDepotSearch> _deferred_depot_searches;
+
+bool QueueDeferredDepotSearch(const Vehicle *v);
+
 uint8 CalcPercentVehicleFilled(const Vehicle *v, StringID *colour);
 uint8 CalcPercentVehicleFilledOfCargo(const Vehicle *v, CargoID cargo);
 
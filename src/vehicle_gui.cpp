@@ -54,21 +54,21 @@ BaseVehicleListWindow::GroupBy _grouping[VLT_END][VEH_COMPANY_END];
 Sorting _sorting[BaseVehicleListWindow::GB_END];
 
 static BaseVehicleListWindow::VehicleIndividualSortFunction VehicleNumberSorter;
-static BaseVehicleListWindow::VehicleIndividualSortFunction VehicleNameSorter;
+static BaseVehicleListWindow::VehicleGroupSortFunction VehicleNameSorter;
 static BaseVehicleListWindow::VehicleIndividualSortFunction VehicleAgeSorter;
 static BaseVehicleListWindow::VehicleIndividualSortFunction VehicleProfitThisYearSorter;
 static BaseVehicleListWindow::VehicleIndividualSortFunction VehicleProfitLastYearSorter;
 static BaseVehicleListWindow::VehicleIndividualSortFunction VehicleProfitLifetimeSorter;
-static BaseVehicleListWindow::VehicleIndividualSortFunction VehicleCargoSorter;
+static BaseVehicleListWindow::VehicleGroupSortFunction VehicleCargoSorter;
 static BaseVehicleListWindow::VehicleIndividualSortFunction VehicleReliabilitySorter;
 static BaseVehicleListWindow::VehicleIndividualSortFunction VehicleMaxSpeedSorter;
 static BaseVehicleListWindow::VehicleIndividualSortFunction VehicleModelSorter;
-static BaseVehicleListWindow::VehicleIndividualSortFunction VehicleValueSorter;
+static BaseVehicleListWindow::VehicleGroupSortFunction VehicleValueSorter;
 static BaseVehicleListWindow::VehicleIndividualSortFunction VehicleLengthSorter;
 static BaseVehicleListWindow::VehicleIndividualSortFunction VehicleTimeToLiveSorter;
 static BaseVehicleListWindow::VehicleIndividualSortFunction VehicleTimetableDelaySorter;
 static BaseVehicleListWindow::VehicleIndividualSortFunction VehicleAverageOrderOccupancySorter;
-static BaseVehicleListWindow::VehicleIndividualSortFunction VehicleMaxSpeedLoadedSorter;
+static BaseVehicleListWindow::VehicleGroupSortFunction VehicleMaxSpeedLoadedSorter;
 static BaseVehicleListWindow::VehicleGroupSortFunction VehicleGroupLengthSorter;
 static BaseVehicleListWindow::VehicleGroupSortFunction VehicleGroupTotalProfitThisYearSorter;
 static BaseVehicleListWindow::VehicleGroupSortFunction VehicleGroupTotalProfitLastYearSorter;
@@ -104,21 +104,21 @@ enum VehicleSortType
 
 BaseVehicleListWindow::VehicleGroupSortFunction * const BaseVehicleListWindow::vehicle_group_none_sorter_funcs[] = {
 	&VehicleIndividualToGroupSorterWrapper<VehicleNumberSorter>,
-	&VehicleIndividualToGroupSorterWrapper<VehicleNameSorter>,
+	&VehicleNameSorter,
 	&VehicleIndividualToGroupSorterWrapper<VehicleAgeSorter>,
 	&VehicleIndividualToGroupSorterWrapper<VehicleProfitThisYearSorter>,
 	&VehicleIndividualToGroupSorterWrapper<VehicleProfitLastYearSorter>,
 	&VehicleIndividualToGroupSorterWrapper<VehicleProfitLifetimeSorter>,
-	&VehicleIndividualToGroupSorterWrapper<VehicleCargoSorter>,
+	&VehicleCargoSorter,
 	&VehicleIndividualToGroupSorterWrapper<VehicleReliabilitySorter>,
 	&VehicleIndividualToGroupSorterWrapper<VehicleMaxSpeedSorter>,
 	&VehicleIndividualToGroupSorterWrapper<VehicleModelSorter>,
-	&VehicleIndividualToGroupSorterWrapper<VehicleValueSorter>,
+	&VehicleValueSorter,
 	&VehicleIndividualToGroupSorterWrapper<VehicleLengthSorter>,
 	&VehicleIndividualToGroupSorterWrapper<VehicleTimeToLiveSorter>,
 	&VehicleIndividualToGroupSorterWrapper<VehicleTimetableDelaySorter>,
 	&VehicleIndividualToGroupSorterWrapper<VehicleAverageOrderOccupancySorter>,
-	&VehicleIndividualToGroupSorterWrapper<VehicleMaxSpeedLoadedSorter>,
+	&VehicleMaxSpeedLoadedSorter,
 };
 
 const StringID BaseVehicleListWindow::vehicle_group_none_sorter_names[] = {
@@ -445,18 +445,86 @@ DropDownList BaseVehicleListWindow::BuildActionDropdownList(bool show_autoreplac
 	return list;
 }
 
-/* cached values for VehicleNameSorter to spare many GetString() calls */
-static const Vehicle *_last_vehicle[2] = { nullptr, nullptr };
+/*
+ * Sort keys of the sorters which are expensive to evaluate, computed once per sort instead of for every comparison.
+ * They are indexed by the position of the vehicle in the vehicle list being sorted, see GetVehicleSortKeyIndex.
+ */
+static VehicleList::const_iterator _vehicle_sort_keys_begin;
+static std::vector<std::string> _vehicle_sort_name_keys;
+static std::vector<CargoArray> _vehicle_sort_cargo_keys;
+static std::vector<int64> _vehicle_sort_int_keys;
+
+/* cached total profits of vehicle groups for the group profit sorters, by first vehicle of the group */
+static btree::btree_map<const Vehicle *, Money> _vehicle_group_profit_this_year;
+static btree::btree_map<const Vehicle *, Money> _vehicle_group_profit_last_year;
+
+/**
+ * Compute the sort keys of the vehicles in an ungrouped vehicle list, for the sorters which use them.
+ * @param vehicles The vehicles of the list.
+ * @param vehgroups The groups of the list, one per vehicle.
+ * @param sort_type The sorter which is going to be used.
+ */
+static void PrepareVehicleSortKeys(const VehicleList &vehicles, const GUIVehicleGroupList &vehgroups, uint8 sort_type)
+{
+	_vehicle_sort_keys_begin = vehicles.begin();
+
+	switch (sort_type) {
+		case VST_NAME:
+			_vehicle_sort_name_keys.resize(vehicles.size());
+			for (const GUIVehicleGroup &vg : vehgroups) {
+				SetDParam(0, vg.GetSingleVehicle()->index);
+				_vehicle_sort_name_keys[vg.vehicles_begin - vehicles.begin()] = GetString(STR_VEHICLE_NAME);
+			}
+			break;
+
+		case VST_CARGO:
+			_vehicle_sort_cargo_keys.assign(vehicles.size(), CargoArray{});
+			for (const GUIVehicleGroup &vg : vehgroups) {
+				CargoArray &capacities = _vehicle_sort_cargo_keys[vg.vehicles_begin - vehicles.begin()];
+				for (const Vehicle *v = vg.GetSingleVehicle(); v != nullptr; v = v->Next()) capacities[v->cargo_type] += v->cargo_cap;
+			}
+			break;
+
+		case VST_VALUE:
+			_vehicle_sort_int_keys.resize(vehicles.size());
+			for (const GUIVehicleGroup &vg : vehgroups) {
+				Money value = 0;
+				for (const Vehicle *v = vg.GetSingleVehicle(); v != nullptr; v = v->Next()) value += v->value;
+				_vehicle_sort_int_keys[vg.vehicles_begin - vehicles.begin()] = value;
+			}
+			break;
+
+		case VST_MAX_SPEED_LOADED:
+			_vehicle_sort_int_keys.resize(vehicles.size());
+			for (const GUIVehicleGroup &vg : vehgroups) {
+				const Train *t = Train::From(vg.GetSingleVehicle());
+				int loaded_weight = 0;
+				for (const Train *u = t; u != nullptr; u = u->Next()) {
+					loaded_weight += u->GetWeightWithoutCargo() + u->GetCargoWeight(u->cargo_cap);
+				}
+				_vehicle_sort_int_keys[vg.vehicles_begin - vehicles.begin()] = GetTrainEstimatedMaxAchievableSpeed(t, loaded_weight, t->GetDisplayMaxSpeed());
+			}
+			break;
 
-static btree::btree_map<VehicleID, int> _vehicle_max_speed_loaded;
+		default:
+			break;
+	}
+}
 
 void BaseVehicleListWindow::SortVehicleList()
 {
-	if (this->vehgroups.Sort()) return;
+	/* profits change over time, so only keep them for the duration of a single sort */
+	_vehicle_group_profit_this_year.clear();
+	_vehicle_group_profit_last_year.clear();
+
+	if (this->grouping == GB_NONE && this->vehgroups.WouldSort()) PrepareVehicleSortKeys(this->vehicles, this->vehgroups, this->vehgroups.SortType());
+
+	this->vehgroups.Sort();
 
-	/* invalidate cached values for name sorter - vehicle names could change */
-	_last_vehicle[0] = _last_vehicle[1] = nullptr;
-	_vehicle_max_speed_loaded.clear();
+	/* names, capacities and values can change, so only keep the keys for the duration of a single sort */
+	_vehicle_sort_name_keys.clear();
+	_vehicle_sort_cargo_keys.clear();
+	_vehicle_sort_int_keys.clear();
 }
 
 void DepotSortList(VehicleList *list)
@@ -1478,28 +1546,52 @@ static bool VehicleGroupLengthSorter(const GUIVehicleGroup &a, const GUIVehicleG
 	return a.NumVehicles() < b.NumVehicles();
 }
 
+/**
+ * Get the total profit of a vehicle group, summing the profits of its vehicles only once per sort.
+ * @param cache The cache of the profit type, cleared before each sort.
+ * @param group The vehicle group.
+ * @param get_profit Function to get the profit of the group.
+ * @return The total profit of the group.
+ */
+static Money GetSorterVehicleGroupProfit(btree::btree_map<const Vehicle *, Money> &cache, const GUIVehicleGroup &group, Money (GUIVehicleGroup::*get_profit)() const)
+{
+	auto res = cache.insert({ group.vehicles_begin[0], 0 });
+	if (res.second) res.first->second = (group.*get_profit)();
+	return res.first->second;
+}
+
+static Money GetSorterVehicleGroupProfitThisYear(const GUIVehicleGroup &group)
+{
+	return GetSorterVehicleGroupProfit(_vehicle_group_profit_this_year, group, &GUIVehicleGroup::GetDisplayProfitThisYear);
+}
+
+static Money GetSorterVehicleGroupProfitLastYear(const GUIVehicleGroup &group)
+{
+	return GetSorterVehicleGroupProfit(_vehicle_group_profit_last_year, group, &GUIVehicleGroup::GetDisplayProfitLastYear);
+}
+
 /** Sort vehicle groups by the total profit this year */
 static bool VehicleGroupTotalProfitThisYearSorter(const GUIVehicleGroup &a, const GUIVehicleGroup &b)
 {
-	return a.GetDisplayProfitThisYear() < b.GetDisplayProfitThisYear();
+	return GetSorterVehicleGroupProfitThisYear(a) < GetSorterVehicleGroupProfitThisYear(b);
 }
 
 /** Sort vehicle groups by the total profit last year */
 static bool VehicleGroupTotalProfitLastYearSorter(const GUIVehicleGroup &a, const GUIVehicleGroup &b)
 {
-	return a.GetDisplayProfitLastYear() < b.GetDisplayProfitLastYear();
+	return GetSorterVehicleGroupProfitLastYear(a) < GetSorterVehicleGroupProfitLastYear(b);
 }
 
 /** Sort vehicle groups by the average profit this year */
 static bool VehicleGroupAverageProfitThisYearSorter(const GUIVehicleGroup &a, const GUIVehicleGroup &b)
 {
-	return a.GetDisplayProfitThisYear() * static_cast<uint>(b.NumVehicles()) < b.GetDisplayProfitThisYear() * static_cast<uint>(a.NumVehicles());
+	return GetSorterVehicleGroupProfitThisYear(a) * static_cast<uint>(b.NumVehicles()) < GetSorterVehicleGroupProfitThisYear(b) * static_cast<uint>(a.NumVehicles());
 }
 
 /** Sort vehicle groups by the average profit last year */
 static bool VehicleGroupAverageProfitLastYearSorter(const GUIVehicleGroup &a, const GUIVehicleGroup &b)
 {
-	return a.GetDisplayProfitLastYear() * static_cast<uint>(b.NumVehicles()) < b.GetDisplayProfitLastYear() * static_cast<uint>(a.NumVehicles());
+	return GetSorterVehicleGroupProfitLastYear(a) * static_cast<uint>(b.NumVehicles()) < GetSorterVehicleGroupProfitLastYear(b) * static_cast<uint>(a.NumVehicles());
 }
 
 /** Sort vehicles by their number */
@@ -1508,25 +1600,17 @@ static bool VehicleNumberSorter(const Vehicle * const &a, const Vehicle * const
 	return a->unitnumber < b->unitnumber;
 }
 
-/** Sort vehicles by their name */
-static bool VehicleNameSorter(const Vehicle * const &a, const Vehicle * const &b)
+/** @return Index of the sort keys of the vehicle of an ungrouped vehicle list entry. */
+static inline size_t GetVehicleSortKeyIndex(const GUIVehicleGroup &vg)
 {
-	static std::string last_name[2] = { {}, {} };
-
-	if (a != _last_vehicle[0]) {
-		_last_vehicle[0] = a;
-		SetDParam(0, a->index);
-		last_name[0] = GetString(STR_VEHICLE_NAME);
-	}
-
-	if (b != _last_vehicle[1]) {
-		_last_vehicle[1] = b;
-		SetDParam(0, b->index);
-		last_name[1] = GetString(STR_VEHICLE_NAME);
-	}
+	return vg.vehicles_begin - _vehicle_sort_keys_begin;
+}
 
-	int r = StrNaturalCompare(last_name[0], last_name[1]); // Sort by name (natural sorting).
-	return (r != 0) ? r < 0: VehicleNumberSorter(a, b);
+/** Sort vehicles by their name */
+static bool VehicleNameSorter(const GUIVehicleGroup &a, const GUIVehicleGroup &b)
+{
+	int r = StrNaturalCompare(_vehicle_sort_name_keys[GetVehicleSortKeyIndex(a)], _vehicle_sort_name_keys[GetVehicleSortKeyIndex(b)]); // Sort by name (natural sorting).
+	return (r != 0) ? r < 0 : VehicleNumberSorter(a.GetSingleVehicle(), b.GetSingleVehicle());
 }
 
 /** Sort vehicles by their age */
@@ -1558,22 +1642,16 @@ static bool VehicleProfitLifetimeSorter(const Vehicle * const &a, const Vehicle
 }
 
 /** Sort vehicles by their cargo */
-static bool VehicleCargoSorter(const Vehicle * const &a, const Vehicle * const &b)
+static bool VehicleCargoSorter(const GUIVehicleGroup &a, const GUIVehicleGroup &b)
 {
-	const Vehicle *v;
-	CargoArray diff{};
-
-	/* Append the cargo of the connected waggons */
-	for (v = a; v != nullptr; v = v->Next()) diff[v->cargo_type] += v->cargo_cap;
-	for (v = b; v != nullptr; v = v->Next()) diff[v->cargo_type] -= v->cargo_cap;
+	const CargoArray &cap_a = _vehicle_sort_cargo_keys[GetVehicleSortKeyIndex(a)];
+	const CargoArray &cap_b = _vehicle_sort_cargo_keys[GetVehicleSortKeyIndex(b)];
 
-	int r = 0;
 	for (CargoID i = 0; i < NUM_CARGO; i++) {
-		r = diff[i];
-		if (r != 0) break;
+		if (cap_a[i] != cap_b[i]) return cap_a[i] < cap_b[i];
 	}
 
-	return (r != 0) ? r < 0 : VehicleNumberSorter(a, b);
+	return VehicleNumberSorter(a.GetSingleVehicle(), b.GetSingleVehicle());
 }
 
 /** Sort vehicles by their reliability */
@@ -1598,16 +1676,11 @@ static bool VehicleModelSorter(const Vehicle * const &a, const Vehicle * const &
 }
 
 /** Sort vehicles by their value */
-static bool VehicleValueSorter(const Vehicle * const &a, const Vehicle * const &b)
+static bool VehicleValueSorter(const GUIVehicleGroup &a, const GUIVehicleGroup &b)
 {
-	const Vehicle *u;
-	Money diff = 0;
-
-	for (u = a; u != nullptr; u = u->Next()) diff += u->value;
-	for (u = b; u != nullptr; u = u->Next()) diff -= u->value;
-
-	int r = ClampTo<int32_t>(diff);
-	return (r != 0) ? r < 0 : VehicleNumberSorter(a, b);
+	int64 value_a = _vehicle_sort_int_keys[GetVehicleSortKeyIndex(a)];
+	int64 value_b = _vehicle_sort_int_keys[GetVehicleSortKeyIndex(b)];
+	return (value_a != value_b) ? value_a < value_b : VehicleNumberSorter(a.GetSingleVehicle(), b.GetSingleVehicle());
 }
 
 /** Sort vehicles by their length */
@@ -1639,26 +1712,11 @@ static bool VehicleAverageOrderOccupancySorter(const Vehicle * const &a, const V
 }
 
 /** Sort vehicles by the max speed (fully loaded) */
-static bool VehicleMaxSpeedLoadedSorter(const Vehicle * const &a, const Vehicle * const &b)
+static bool VehicleMaxSpeedLoadedSorter(const GUIVehicleGroup &a, const GUIVehicleGroup &b)
 {
-	auto get_max_speed_loaded = [](const Train * const v) -> int {
-		auto res = _vehicle_max_speed_loaded.insert({ v->index, 0 });
-		if (!res.second) {
-			/* This vehicle's speed was already in _vehicle_max_speed_loaded */
-			return res.first->second;
-		}
-		int loaded_weight = 0;
-		for (const Train *u = v; u != nullptr; u = u->Next()) {
-			loaded_weight += u->GetWeightWithoutCargo() + u->GetCargoWeight(u->cargo_cap);
-		}
-
-		int loaded_max_speed = GetTrainEstimatedMaxAchievableSpeed(v, loaded_weight, v->GetDisplayMaxSpeed());
-		res.first->second = loaded_max_speed;
-		return loaded_max_speed;
-	};
-
-	int r = get_max_speed_loaded(Train::From(a)) - get_max_speed_loaded(Train::From(b));
-	return (r != 0) ? r < 0 : VehicleNumberSorter(a, b);
+	int64 speed_a = _vehicle_sort_int_keys[GetVehicleSortKeyIndex(a)];
+	int64 speed_b = _vehicle_sort_int_keys[GetVehicleSortKeyIndex(b)];
+	return (speed_a != speed_b) ? speed_a < speed_b : VehicleNumberSorter(a.GetSingleVehicle(), b.GetSingleVehicle());
 }
 
 void InitializeGUI()
@@ -162,19 +162,29 @@ bool GenerateVehicleSortList(VehicleList *list, const VehicleListIdentifier &vli
 		}
 	};
 
-	switch (vli.type) {
-		case VL_STATION_LIST:
-			for (const Vehicle *v : Vehicle::Iterate()) {
-				if (v->type == vli.vtype && v->IsPrimaryVehicle()) {
-					for (const Order *order : v->Orders()) {
-						if ((order->IsType(OT_GOTO_STATION) || order->IsType(OT_GOTO_WAYPOINT) || order->IsType(OT_IMPLICIT))
-								&& order->GetDestination() == vli.index) {
-							add_veh(v);
-							break;
-						}
+	/* Add the vehicles of all order lists with an order matching the predicate.
+	 * Each shared order list is only scanned once, instead of once for each vehicle sharing it. */
+	auto fill_order_list_vehicles = [&](auto order_matches) {
+		for (const OrderList *orderlist : OrderList::Iterate()) {
+			const Vehicle *first = orderlist->GetFirstSharedVehicle();
+			if (first == nullptr || first->type != vli.vtype || !first->IsPrimaryVehicle()) continue;
+
+			for (VehicleOrderID i = 0; i < orderlist->GetNumOrders(); i++) {
+				if (order_matches(orderlist->GetOrderAt(i))) {
+					for (const Vehicle *v = first; v != nullptr; v = v->NextShared()) {
+						add_veh(v);
 					}
+					break;
 				}
 			}
+		}
+	};
+
+	switch (vli.type) {
+		case VL_STATION_LIST:
+			fill_order_list_vehicles([&](const Order *order) {
+				return (order->IsType(OT_GOTO_STATION) || order->IsType(OT_GOTO_WAYPOINT) || order->IsType(OT_IMPLICIT)) && order->GetDestination() == vli.index;
+			});
 			break;
 
 		case VL_SHARED_ORDERS: {
@@ -206,16 +216,9 @@ bool GenerateVehicleSortList(VehicleList *list, const VehicleListIdentifier &vli
 			break;
 
 		case VL_DEPOT_LIST:
-			for (const Vehicle *v : Vehicle::Iterate()) {
-				if (v->type == vli.vtype && v->IsPrimaryVehicle()) {
-					for (const Order *order : v->Orders()) {
-						if (order->IsType(OT_GOTO_DEPOT) && !(order->GetDepotActionType() & ODATFB_NEAREST_DEPOT) && order->GetDestination() == vli.index) {
-							add_veh(v);
-							break;
-						}
-					}
-				}
-			}
+			fill_order_list_vehicles([&](const Order *order) {
+				return order->IsType(OT_GOTO_DEPOT) && !(order->GetDepotActionType() & ODATFB_NEAREST_DEPOT) && order->GetDestination() == vli.index;
+			});
 			break;
 
 		case VL_SLOT_LIST: {
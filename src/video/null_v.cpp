@@ -13,6 +13,9 @@
 #include "../sl/saveload.h"
 #include "../window_func.h"
 #include "../thread.h"
+#include "../openttd.h"
+#include "../framerate_type.h"
+#include "../debug.h"
 #include "null_v.h"
 
 #include <atomic>
@@ -35,6 +38,8 @@ const char *VideoDriver_Null::Start(const StringList &parm)
 
 	this->ticks = GetDriverParamInt(parm, "ticks", 1000);
 	this->until_exit = GetDriverParamBool(parm, "until_exit");
+	const char *benchmark = GetDriverParam(parm, "benchmark");
+	if (benchmark != nullptr) this->benchmark_file = benchmark;
 	_screen.width  = _screen.pitch = _cur_resolution.width;
 	_screen.height = _cur_resolution.height;
 	_screen.dst_ptr = nullptr;
@@ -53,7 +58,17 @@ void VideoDriver_Null::MakeDirty(int, int, int, int) {}
 void VideoDriver_Null::MainLoop()
 {
 	SetSelfAsGameThread();
-	if (this->until_exit) {
+	if (!this->benchmark_file.empty()) {
+		/* Let the game loop switch to the game to run first, then measure only the state game loop. */
+		::GameLoop();
+		StartPerformanceBenchmark();
+		for (int i = 0; i < this->ticks; i++) {
+			::StateGameLoop();
+		}
+		if (!WritePerformanceBenchmark(this->benchmark_file.c_str(), this->ticks)) {
+			DEBUG(misc, 0, "Failed to write benchmark results to %s", this->benchmark_file.c_str());
+		}
+	} else if (this->until_exit) {
 		while (!_exit_game) {
 			::GameLoop();
 			::InputLoop();
@@ -17,6 +17,7 @@ class VideoDriver_Null : public VideoDriver {
 private:
 	int ticks; ///< Amount of ticks to run.
 	bool until_exit;
+	std::string benchmark_file; ///< File to write the performance statistics to, when measuring the state game loop only.
 
 public:
 	const char *Start(const StringList &param) override;
@@ -74,6 +74,7 @@
 #include "station_base.h"
 #include "waypoint_base.h"
 #include "town.h"
+#include "house.h"
 #include "signs_base.h"
 #include "signs_func.h"
 #include "plans_base.h"
@@ -117,6 +118,7 @@
 #include "core/backup_type.hpp"
 
 #include <map>
+#include <unordered_map>
 #include <vector>
 #include <math.h>
 #include <algorithm>
@@ -141,6 +143,7 @@ Point _tile_fract_coords;
 ViewportSignKdtree _viewport_sign_kdtree(&Kdtree_ViewportSignXYFunc);
 bool _viewport_sign_kdtree_valid = false;
 static int _viewport_sign_maxwidth = 0;
+uint32 _viewport_sign_text_generation = 0; ///< Generation of the formatted texts of viewport signs, see #ViewportSign::GetCachedText.
 
 
 //static const int MAX_TILE_EXTENT_LEFT   = ZOOM_LVL_BASE * TILE_PIXELS;                     ///< Maximum left   extent of tile relative to north corner.
@@ -155,6 +158,8 @@ struct StringSpriteToDraw {
 	int32 y;
 	uint64 params[2];
 	uint16 width;
+	ViewportSign::TextKind text_kind;
+	const ViewportSign *sign;
 };
 
 struct TileSpriteToDraw {
@@ -267,6 +272,81 @@ struct ViewportDrawer {
 };
 static ViewportDrawer _vd;
 
+/** Types of recorded calls of the sprite collection functions. */
+enum TileSpriteCacheOpType : uint8 {
+	TSCOT_GROUND,        ///< #DrawGroundSpriteAt
+	TSCOT_OFFSET_GROUND, ///< #OffsetGroundSprite
+	TSCOT_SORTABLE,      ///< #AddSortableSpriteToDraw
+	TSCOT_CHILD_SCREEN,  ///< #AddChildSpriteScreen
+	TSCOT_START_COMBINE, ///< #StartSpriteCombine
+	TSCOT_END_COMBINE,   ///< #EndSpriteCombine
+};
+
+/** A recorded call of one of the sprite collection functions by a DrawTile proc. */
+struct TileSpriteCacheOp {
+	TileSpriteCacheOpType type;
+	bool transparent;
+	bool scale;
+	ChildScreenSpritePositionMode position_mode;
+	SpriteID image;
+	PaletteID pal;
+	const SubSprite *sub;
+	int32 args[9];
+};
+
+/**
+ * The sprite collection calls recorded for a tile, which are replayed instead of calling the DrawTile proc again.
+ * Replaying goes through the same functions as the original calls, so the result is clipped for the viewport which is being drawn.
+ */
+struct TileSpriteCacheEntry {
+	Tile m;                                 ///< Map contents of the tile when it was recorded.
+	TileExtended me;                        ///< Extended map contents of the tile when it was recorded.
+	Date date;                              ///< Date when it was recorded, date dependent NewGRF graphics are redrawn daily.
+	int z;                                  ///< TileInfo::z before drawing.
+	Slope tileh;                            ///< TileInfo::tileh before drawing.
+	int z_after;                            ///< TileInfo::z after drawing, it is changed by foundations.
+	Slope tileh_after;                      ///< TileInfo::tileh after drawing, it is changed by foundations.
+	ZoomLevel zoom;                         ///< Zoom level it was recorded at.
+	TransparencyOptionBits transparency_opt; ///< Transparency options it was recorded with.
+	TransparencyOptionBits invisibility_opt; ///< Invisibility options it was recorded with.
+	byte display_opt;                       ///< Display options it was recorded with.
+	std::vector<TileSpriteCacheOp> ops;     ///< The recorded calls.
+};
+
+static const size_t TILE_SPRITE_CACHE_MAX_ENTRIES = 1 << 18; ///< Number of cached tiles at which the whole cache is dropped.
+
+static std::unordered_map<TileIndex, TileSpriteCacheEntry> _tile_sprite_cache;      ///< Recorded sprite collection calls, per tile.
+static std::vector<TileSpriteCacheOp> *_tile_sprite_cache_recording = nullptr;     ///< Where to record the sprite collection calls to, if recording.
+
+/**
+ * Record a call of a sprite collection function, if a DrawTile proc is being recorded.
+ * @param type Type of the call.
+ * @param image The image of the call.
+ * @param pal The palette of the call.
+ * @param sub The sub-sprite of the call.
+ * @return The recorded call to add further arguments to, or nullptr if not recording.
+ */
+static inline TileSpriteCacheOp *RecordTileSpriteCacheOp(TileSpriteCacheOpType type, SpriteID image = 0, PaletteID pal = 0, const SubSprite *sub = nullptr)
+{
+	if (likely(_tile_sprite_cache_recording == nullptr)) return nullptr;
+
+	TileSpriteCacheOp &op = _tile_sprite_cache_recording->emplace_back();
+	op.type = type;
+	op.transparent = false;
+	op.scale = false;
+	op.position_mode = ChildScreenSpritePositionMode::Relative;
+	op.image = image;
+	op.pal = pal;
+	op.sub = sub;
+	return &op;
+}
+
+/** Drop all recorded sprite collection calls, e.g. because the NewGRFs or the map have changed. */
+void ClearTileSpriteCache()
+{
+	_tile_sprite_cache.clear();
+}
+
 struct ViewportProcessParentSpritesData {
 	DrawPixelInfo dpi;
 	ParentSpriteToSortVector psts;
@@ -424,6 +504,7 @@ enum ViewportDebugFlags {
 	VDF_SHOW_NO_LANDSCAPE_MAP_DRAW,
 	VDF_DISABLE_LANDSCAPE_CACHE,
 	VDF_DISABLE_THREAD,
+	VDF_DISABLE_TILE_SPRITE_CACHE,
 };
 uint32 _viewport_debug_flags;
 
@@ -467,6 +548,50 @@ void ClearViewportLandPixelCache(Viewport *vp)
 	vp->land_pixel_cache.assign(vp->land_pixel_cache.size(), 0xD7);
 }
 
+/**
+ * Move the contents of the map mode landscape pixel cache along with a scrolling viewport,
+ * so only the newly exposed pixels have to be looked up again.
+ * @param vp Viewport which scrolled.
+ * @param xo Number of pixels the contents move to the right.
+ * @param yo Number of pixels the contents move down.
+ */
+static void ScrollViewportLandPixelCache(Viewport *vp, int xo, int yo)
+{
+	if (vp->land_pixel_cache.empty()) return;
+
+	const int width = vp->width;
+	const int height = vp->height;
+	if (abs(xo) >= width || abs(yo) >= height || HasBit(_viewport_debug_flags, VDF_DISABLE_LANDSCAPE_CACHE)) {
+		ClearViewportLandPixelCache(vp);
+		return;
+	}
+
+	const size_t bytes_per_pixel = vp->land_pixel_cache.size() / vp->ScreenArea();
+	const size_t line_size = width * bytes_per_pixel;
+	const size_t copy_size = (width - abs(xo)) * bytes_per_pixel;
+	const size_t fill_size = abs(xo) * bytes_per_pixel;
+	byte *data = vp->land_pixel_cache.data();
+
+	/* Walk the lines against the direction of the move, so no source line is overwritten before it is copied. */
+	for (int i = 0; i < height; i++) {
+		const int y = yo > 0 ? height - 1 - i : i;
+		byte *line = data + y * line_size;
+		const int src_y = y - yo;
+		if (src_y < 0 || src_y >= height) {
+			memset(line, 0xD7, line_size);
+			continue;
+		}
+		const byte *src_line = data + src_y * line_size;
+		if (xo >= 0) {
+			memmove(line + fill_size, src_line, copy_size);
+			memset(line, 0xD7, fill_size);
+		} else {
+			memmove(line, src_line + fill_size, copy_size);
+			memset(line + copy_size, 0xD7, fill_size);
+		}
+	}
+}
+
 void ClearViewportCache(Viewport *vp)
 {
 	if (vp->zoom >= ZOOM_LVL_DRAW_MAP) {
@@ -811,7 +936,7 @@ static void SetViewportPosition(Window *w, int x, int y, bool force_update_overl
 		if (i >= 0) height -= i;
 
 		if (height > 0 && (move_offset.x != 0 || move_offset.y != 0)) {
-			ClearViewportLandPixelCache(vp);
+			ScrollViewportLandPixelCache(vp, move_offset.x, move_offset.y);
 			SCOPE_INFO_FMT([&], "DoSetViewportPosition: %d, %d, %d, %d, %d, %d, %s", left, top, width, height, move_offset.x, move_offset.y, scope_dumper().WindowInfo(w));
 			w->viewport->update_vehicles = true;
 			DoSetViewportPosition((Window *) w->z_front, move_offset, left, top, width, height);
@@ -946,6 +1071,8 @@ static void AddTileSpriteToDraw(SpriteID image, PaletteID pal, int32 x, int32 y,
 	ts.y = pt.y + extra_offs_y;
 }
 
+static void AddChildSpriteScreenInternal(SpriteID image, PaletteID pal, int x, int y, bool transparent, const SubSprite *sub, bool scale, ChildScreenSpritePositionMode position_mode);
+
 /**
  * Adds a child sprite to the active foundation.
  *
@@ -968,7 +1095,7 @@ static void AddChildSpriteToFoundation(SpriteID image, PaletteID pal, const SubS
 	int *old_child = _vd.last_child;
 	_vd.last_child = _vd.last_foundation_child[foundation_part];
 
-	AddChildSpriteScreen(image, pal, offs.x + extra_offs_x, offs.y + extra_offs_y, false, sub, false, ChildScreenSpritePositionMode::NonRelative);
+	AddChildSpriteScreenInternal(image, pal, offs.x + extra_offs_x, offs.y + extra_offs_y, false, sub, false, ChildScreenSpritePositionMode::NonRelative);
 
 	/* Switch back to last ChildSprite list */
 	_vd.last_child = old_child;
@@ -989,6 +1116,15 @@ static void AddChildSpriteToFoundation(SpriteID image, PaletteID pal, const SubS
  */
 void DrawGroundSpriteAt(SpriteID image, PaletteID pal, int32 x, int32 y, int z, const SubSprite *sub, int extra_offs_x, int extra_offs_y)
 {
+	if (TileSpriteCacheOp *op = RecordTileSpriteCacheOp(TSCOT_GROUND, image, pal, sub)) {
+		op->args[0] = x;
+		op->args[1] = y;
+		op->args[2] = z;
+		op->args[3] = extra_offs_x;
+		op->args[4] = extra_offs_y;
+		op->args[5] = _cur_ti.z;
+	}
+
 	/* Switch to first foundation part, if no foundation was drawn */
 	if (_vd.foundation_part == FOUNDATION_PART_NONE) _vd.foundation_part = FOUNDATION_PART_NORMAL;
 
@@ -1024,6 +1160,11 @@ void DrawGroundSprite(SpriteID image, PaletteID pal, const SubSprite *sub, int e
  */
 void OffsetGroundSprite(int x, int y)
 {
+	if (TileSpriteCacheOp *op = RecordTileSpriteCacheOp(TSCOT_OFFSET_GROUND)) {
+		op->args[0] = x;
+		op->args[1] = y;
+	}
+
 	/* Switch to next foundation part */
 	switch (_vd.foundation_part) {
 		case FOUNDATION_PART_NONE:
@@ -1069,7 +1210,7 @@ static void AddCombinedSprite(SpriteID image, PaletteID pal, int x, int y, int z
 			bottom <= _vdd->dpi.top)
 		return;
 
-	AddChildSpriteScreen(image, pal, pt.x, pt.y, false, sub, false, ChildScreenSpritePositionMode::Absolute);
+	AddChildSpriteScreenInternal(image, pal, pt.x, pt.y, false, sub, false, ChildScreenSpritePositionMode::Absolute);
 	if (left < _vd.combine_left) _vd.combine_left = left;
 	if (right > _vd.combine_right) _vd.combine_right = right;
 	if (top < _vd.combine_top) _vd.combine_top = top;
@@ -1107,6 +1248,19 @@ void AddSortableSpriteToDraw(SpriteID image, PaletteID pal, int x, int y, int w,
 
 	dbg_assert((image & SPRITE_MASK) < MAX_SPRITES);
 
+	if (TileSpriteCacheOp *op = RecordTileSpriteCacheOp(TSCOT_SORTABLE, image, pal, sub)) {
+		op->transparent = transparent;
+		op->args[0] = x;
+		op->args[1] = y;
+		op->args[2] = w;
+		op->args[3] = h;
+		op->args[4] = dz;
+		op->args[5] = z;
+		op->args[6] = bb_offset_x;
+		op->args[7] = bb_offset_y;
+		op->args[8] = bb_offset_z;
+	}
+
 	/* make the sprites transparent with the right palette */
 	if (transparent) {
 		SetBit(image, PALETTE_MODIFIER_TRANSPARENT);
@@ -1216,6 +1370,7 @@ void AddSortableSpriteToDraw(SpriteID image, PaletteID pal, int x, int y, int w,
  */
 void StartSpriteCombine()
 {
+	RecordTileSpriteCacheOp(TSCOT_START_COMBINE);
 	dbg_assert(_vd.combine_sprites == SPRITE_COMBINE_NONE);
 	_vd.combine_sprites = SPRITE_COMBINE_PENDING;
 }
@@ -1226,6 +1381,7 @@ void StartSpriteCombine()
  */
 void EndSpriteCombine()
 {
+	RecordTileSpriteCacheOp(TSCOT_END_COMBINE);
 	dbg_assert(_vd.combine_sprites != SPRITE_COMBINE_NONE);
 	if (_vd.combine_sprites == SPRITE_COMBINE_ACTIVE) {
 		ParentSpriteToDraw &ps = _vdd->parent_sprites_to_draw[_vd.combine_psd_index];
@@ -1274,18 +1430,10 @@ static bool IsInsideSelectedRectangle(int x, int y)
 }
 
 /**
- * Add a child sprite to a parent sprite.
- *
- * @param image the image to draw.
- * @param pal the provided palette.
- * @param x sprite x-offset (screen coordinates), optionally relative to parent sprite.
- * @param y sprite y-offset (screen coordinates), optionally relative to parent sprite.
- * @param transparent if true, switch the palette between the provided palette and the transparent palette,
- * @param sub Only draw a part of the sprite.
- * @param scale if true, scale offsets to base zoom level.
- * @param position_mode position mode.
+ * Add a child sprite to a parent sprite, without recording it for the tile sprite cache.
+ * @see AddChildSpriteScreen
  */
-void AddChildSpriteScreen(SpriteID image, PaletteID pal, int x, int y, bool transparent, const SubSprite *sub, bool scale, ChildScreenSpritePositionMode position_mode)
+static void AddChildSpriteScreenInternal(SpriteID image, PaletteID pal, int x, int y, bool transparent, const SubSprite *sub, bool scale, ChildScreenSpritePositionMode position_mode)
 {
 	dbg_assert((image & SPRITE_MASK) < MAX_SPRITES);
 
@@ -1317,7 +1465,32 @@ void AddChildSpriteScreen(SpriteID image, PaletteID pal, int x, int y, bool tran
 	_vd.last_child = &cs.next;
 }
 
-static void AddStringToDraw(ViewportDrawerDynamic *vdd, int x, int y, StringID string, uint64 params_1, uint64 params_2, Colours colour, uint16 width)
+/**
+ * Add a child sprite to a parent sprite.
+ *
+ * @param image the image to draw.
+ * @param pal the provided palette.
+ * @param x sprite x-offset (screen coordinates), optionally relative to parent sprite.
+ * @param y sprite y-offset (screen coordinates), optionally relative to parent sprite.
+ * @param transparent if true, switch the palette between the provided palette and the transparent palette,
+ * @param sub Only draw a part of the sprite.
+ * @param scale if true, scale offsets to base zoom level.
+ * @param position_mode position mode.
+ */
+void AddChildSpriteScreen(SpriteID image, PaletteID pal, int x, int y, bool transparent, const SubSprite *sub, bool scale, ChildScreenSpritePositionMode position_mode)
+{
+	if (TileSpriteCacheOp *op = RecordTileSpriteCacheOp(TSCOT_CHILD_SCREEN, image, pal, sub)) {
+		op->transparent = transparent;
+		op->scale = scale;
+		op->position_mode = position_mode;
+		op->args[0] = x;
+		op->args[1] = y;
+	}
+
+	AddChildSpriteScreenInternal(image, pal, x, y, transparent, sub, scale, position_mode);
+}
+
+static void AddStringToDraw(ViewportDrawerDynamic *vdd, int x, int y, StringID string, uint64 params_1, uint64 params_2, Colours colour, uint16 width, const ViewportSign *sign, ViewportSign::TextKind text_kind)
 {
 	dbg_assert(width != 0);
 	StringSpriteToDraw &ss = vdd->string_sprites_to_draw.emplace_back();
@@ -1328,6 +1501,8 @@ static void AddStringToDraw(ViewportDrawerDynamic *vdd, int x, int y, StringID s
 	ss.params[1] = params_2;
 	ss.width = width;
 	ss.colour = colour;
+	ss.sign = sign;
+	ss.text_kind = text_kind;
 }
 
 
@@ -1658,6 +1833,85 @@ static int GetViewportY(Point tile)
 	return (tile.y * (int)(TILE_PIXELS / 2) + tile.x * (int)(TILE_PIXELS / 2) - TilePixelHeightOutsideMap(tile.x, tile.y)) << ZOOM_LVL_SHIFT;
 }
 
+/**
+ * Draw a tile with its DrawTile proc, or by replaying the sprite collection calls recorded when it was last drawn.
+ * Only NewGRF houses are cached; they are the most common tiles for which drawing involves NewGRF callbacks,
+ * and they change their graphics only when their map contents change or on a new day.
+ * @param tile_type The type of the current tile, #_cur_ti.
+ * @param params The parameters for the DrawTile proc.
+ */
+static void ViewportDrawTileCached(TileType tile_type, DrawTileProcParams params)
+{
+	const TileIndex tile = _cur_ti.tile;
+	bool cacheable = tile_type == MP_HOUSE && !params.no_ground_tiles && GetHouseType(tile) >= NEW_HOUSE_OFFSET &&
+			!HasBit(_viewport_debug_flags, VDF_DISABLE_TILE_SPRITE_CACHE);
+	if (!cacheable) {
+		_tile_type_procs[tile_type]->draw_tile_proc(&_cur_ti, params);
+		return;
+	}
+
+	auto it = _tile_sprite_cache.find(tile);
+	if (it != _tile_sprite_cache.end()) {
+		const TileSpriteCacheEntry &entry = it->second;
+		if (entry.date == _date && entry.z == _cur_ti.z && entry.tileh == _cur_ti.tileh && entry.zoom == _vdd->dpi.zoom &&
+				entry.transparency_opt == _vdd->transparency_opt && entry.invisibility_opt == _vdd->invisibility_opt &&
+				entry.display_opt == _display_opt && memcmp(&entry.m, &_m[tile], sizeof(Tile)) == 0 && memcmp(&entry.me, &_me[tile], sizeof(TileExtended)) == 0) {
+			for (const TileSpriteCacheOp &op : entry.ops) {
+				switch (op.type) {
+					case TSCOT_GROUND:
+						_cur_ti.z = op.args[5];
+						DrawGroundSpriteAt(op.image, op.pal, op.args[0], op.args[1], op.args[2], op.sub, op.args[3], op.args[4]);
+						break;
+
+					case TSCOT_OFFSET_GROUND:
+						OffsetGroundSprite(op.args[0], op.args[1]);
+						break;
+
+					case TSCOT_SORTABLE:
+						AddSortableSpriteToDraw(op.image, op.pal, op.args[0], op.args[1], op.args[2], op.args[3], op.args[4], op.args[5], op.transparent, op.args[6], op.args[7], op.args[8], op.sub);
+						break;
+
+					case TSCOT_CHILD_SCREEN:
+						AddChildSpriteScreen(op.image, op.pal, op.args[0], op.args[1], op.transparent, op.sub, op.scale, op.position_mode);
+						break;
+
+					case TSCOT_START_COMBINE:
+						StartSpriteCombine();
+						break;
+
+					case TSCOT_END_COMBINE:
+						EndSpriteCombine();
+						break;
+				}
+			}
+			_cur_ti.z = entry.z_after;
+			_cur_ti.tileh = entry.tileh_after;
+			return;
+		}
+	} else if (_tile_sprite_cache.size() >= TILE_SPRITE_CACHE_MAX_ENTRIES) {
+		_tile_sprite_cache.clear();
+	}
+
+	TileSpriteCacheEntry &entry = _tile_sprite_cache[tile];
+	entry.m = _m[tile];
+	entry.me = _me[tile];
+	entry.date = _date;
+	entry.z = _cur_ti.z;
+	entry.tileh = _cur_ti.tileh;
+	entry.zoom = _vdd->dpi.zoom;
+	entry.transparency_opt = _vdd->transparency_opt;
+	entry.invisibility_opt = _vdd->invisibility_opt;
+	entry.display_opt = _display_opt;
+	entry.ops.clear();
+
+	_tile_sprite_cache_recording = &entry.ops;
+	_tile_type_procs[tile_type]->draw_tile_proc(&_cur_ti, params);
+	_tile_sprite_cache_recording = nullptr;
+
+	entry.z_after = _cur_ti.z;
+	entry.tileh_after = _cur_ti.tileh;
+}
+
 /**
  * Add the landscape to the viewport, i.e. all ground tiles and buildings.
  */
@@ -1767,7 +2021,7 @@ static void ViewportAddLandscape()
 				_vd.last_foundation_child[1] = nullptr;
 
 				bool no_ground_tiles = min_visible_height > 0;
-				_tile_type_procs[tile_type]->draw_tile_proc(&_cur_ti, { min_visible_height, no_ground_tiles });
+				ViewportDrawTileCached(tile_type, { min_visible_height, no_ground_tiles });
 				if (_cur_ti.tile != INVALID_TILE && min_visible_height <= 0) {
 					DrawTileSelection(&_cur_ti);
 					DrawTileZoning(&_cur_ti);
@@ -1808,15 +2062,15 @@ void ViewportAddString(ViewportDrawerDynamic *vdd, const DrawPixelInfo *dpi, Zoo
 	}
 
 	if (!small) {
-		AddStringToDraw(vdd, sign->center - sign_half_width, sign->top, string_normal, params_1, params_2, colour, sign->width_normal);
+		AddStringToDraw(vdd, sign->center - sign_half_width, sign->top, string_normal, params_1, params_2, colour, sign->width_normal, sign, ViewportSign::VSTK_NORMAL);
 	} else {
 		int shadow_offset = 0;
 		if (string_small_shadow != STR_NULL) {
 			shadow_offset = 4;
-			AddStringToDraw(vdd, sign->center - sign_half_width + shadow_offset, sign->top, string_small_shadow, params_1, params_2, INVALID_COLOUR, sign->width_small | 0x8000);
+			AddStringToDraw(vdd, sign->center - sign_half_width + shadow_offset, sign->top, string_small_shadow, params_1, params_2, INVALID_COLOUR, sign->width_small | 0x8000, sign, ViewportSign::VSTK_SMALL_SHADOW);
 		}
 		AddStringToDraw(vdd, sign->center - sign_half_width, sign->top - shadow_offset, string_small, params_1, params_2,
-				colour, sign->width_small | 0x8000);
+				colour, sign->width_small | 0x8000, sign, ViewportSign::VSTK_SMALL);
 	}
 }
 
@@ -1948,6 +2202,9 @@ void ViewportSign::UpdatePosition(ZoomLevel maxzoom, int center, int top, String
 
 	this->top = top;
 
+	/* The name or the displayed value may have changed. */
+	for (CachedText &cached : this->cached_text) cached.string = STR_NULL;
+
 	char buffer[DRAW_STRING_BUFFER];
 
 	GetString(buffer, str, lastof(buffer));
@@ -1963,6 +2220,31 @@ void ViewportSign::UpdatePosition(ZoomLevel maxzoom, int center, int top, String
 	this->MarkDirty(maxzoom);
 }
 
+/**
+ * Get the formatted text of the sign, formatting it only when it is not cached yet.
+ * The cache is cleared when the position of the sign is updated, which happens when its name or
+ * displayed value changes, and when #_viewport_sign_text_generation changes due to a whole screen redraw.
+ * @param kind The kind of text.
+ * @param string The string to format.
+ * @param params_1 The first parameter of the string.
+ * @param params_2 The second parameter of the string.
+ * @return The formatted text.
+ */
+const std::string &ViewportSign::GetCachedText(TextKind kind, StringID string, uint64 params_1, uint64 params_2) const
+{
+	CachedText &cached = this->cached_text[kind];
+	if (cached.string != string || cached.params[0] != params_1 || cached.params[1] != params_2 || cached.generation != _viewport_sign_text_generation) {
+		SetDParam(0, params_1);
+		SetDParam(1, params_2);
+		cached.text = GetString(string);
+		cached.string = string;
+		cached.params[0] = params_1;
+		cached.params[1] = params_2;
+		cached.generation = _viewport_sign_text_generation;
+	}
+	return cached.text;
+}
+
 /**
  * Mark the sign dirty in all viewports.
  * @param maxzoom Maximum %ZoomLevel at which the text is visible.
@@ -2055,9 +2337,7 @@ static void ViewportSortParentSprites(ParentSpriteToSortVector *psdv)
 
 			/* Move ps2 in front of ps */
 			ParentSpriteToDraw *temp = ps2;
-			for (auto psd3 = psd2; psd3 > psd; psd3--) {
-				*psd3 = *(psd3 - 1);
-			}
+			std::move_backward(psd, psd2, psd2 + 1);
 			*psd = temp;
 		}
 	}
@@ -2272,9 +2552,6 @@ static void ViewportDrawStrings(ViewportDrawerDynamic *vdd, ZoomLevel zoom, cons
 		int y = UnScaleByZoom(ss.y, zoom);
 		int h = WidgetDimensions::scaled.fullbevel.Vertical() + (small ? FONT_HEIGHT_SMALL : FONT_HEIGHT_NORMAL);
 
-		SetDParam(0, ss.params[0]);
-		SetDParam(1, ss.params[1]);
-
 		if (ss.colour != INVALID_COLOUR) {
 			if (vdd->IsTransparencySet(TO_SIGNS) && ss.string != STR_WHITE_SIGN) {
 				/* Don't draw the rectangle.
@@ -2291,7 +2568,8 @@ static void ViewportDrawStrings(ViewportDrawerDynamic *vdd, ZoomLevel zoom, cons
 			}
 		}
 
-		DrawString(x + WidgetDimensions::scaled.fullbevel.left, x + w - 1 - WidgetDimensions::scaled.fullbevel.right, y + WidgetDimensions::scaled.fullbevel.top, ss.string, colour, SA_HOR_CENTER, false, small ? FS_SMALL : FS_NORMAL);
+		DrawString(x + WidgetDimensions::scaled.fullbevel.left, x + w - 1 - WidgetDimensions::scaled.fullbevel.right, y + WidgetDimensions::scaled.fullbevel.top,
+				ss.sign->GetCachedText(ss.text_kind, ss.string, ss.params[0], ss.params[1]), colour, SA_HOR_CENTER, false, small ? FS_SMALL : FS_NORMAL);
 	}
 }
 
@@ -2428,6 +2706,10 @@ void ViewportRouteOverlay::DrawVehicleRoutePath(const Viewport *vp, ViewportDraw
 
 	DrawPixelInfo dpi_for_text = vdd->MakeDPIForText();
 
+	/* Lines entirely above or below the viewport at sea level are not visible at any height either. */
+	const int top = ScaleByZoom(dpi_for_text.top - 1, vp->zoom);
+	const int bottom = ScaleByZoom(dpi_for_text.top + dpi_for_text.height + 1, vp->zoom) + (int)(ZOOM_LVL_BASE * TILE_HEIGHT * _settings_game.construction.map_height_limit);
+
 	for (const auto &iter : this->route_paths) {
 		const int from_tile_x = TileX(iter.from_tile) * TILE_SIZE + TILE_SIZE / 2;
 		const int from_tile_y = TileY(iter.from_tile) * TILE_SIZE + TILE_SIZE / 2;
@@ -2441,6 +2723,8 @@ void ViewportRouteOverlay::DrawVehicleRoutePath(const Viewport *vp, ViewportDraw
 
 		if (from_x < dpi_for_text.left - 1 && to_x < dpi_for_text.left - 1) continue;
 		if (from_x > dpi_for_text.left + dpi_for_text.width + 1 && to_x > dpi_for_text.left + dpi_for_text.width + 1) continue;
+		if (from_pt.y < top && to_pt.y < top) continue;
+		if (from_pt.y > bottom && to_pt.y > bottom) continue;
 
 		from_pt.y -= GetSlopePixelZ(from_tile_x, from_tile_y) * ZOOM_LVL_BASE;
 		to_pt.y -= GetSlopePixelZ(to_tile_x, to_tile_y) * ZOOM_LVL_BASE;
@@ -2643,6 +2927,67 @@ static void ViewportDrawVehicleRouteSteps(const Viewport * const vp)
 	}
 }
 
+/**
+ * Call a function for each segment of a plan line which may be visible in the viewport.
+ * Segments are culled using their sea level coordinates, so the height of a vertex is only looked up when one of its segments may be visible,
+ * and each vertex is only mapped to the viewport once.
+ * @param vp     The viewport.
+ * @param bounds The visible area in virtual coordinates, with the maximum height of the landscape added to the bottom.
+ * @param tiles  The vertices of the plan line.
+ * @param draw   Function to call with the viewport coordinates of the start and the end of each segment.
+ */
+template <typename F>
+static void ViewportForEachVisiblePlanLineSegment(const Viewport *vp, const Rect &bounds, const TileVector &tiles, F draw)
+{
+	enum : uint8 {
+		OUTSIDE_LEFT  = 1 << 0,
+		OUTSIDE_RIGHT = 1 << 1,
+		OUTSIDE_ABOVE = 1 << 2,
+		OUTSIDE_BELOW = 1 << 3,
+	};
+
+	struct Vertex {
+		int x;             ///< World x coordinate of the tile centre.
+		int y;             ///< World y coordinate of the tile centre.
+		Point pt;          ///< Virtual coordinate at sea level, later including the height of the tile.
+		uint8 outside;     ///< Sides of \a bounds the sea level coordinate is outside of.
+		bool has_height;   ///< Whether the height of the tile has been added to \a pt.
+	};
+
+	auto make_vertex = [&](TileIndex tile) -> Vertex {
+		Vertex v;
+		v.x = TileX(tile) * TILE_SIZE + TILE_SIZE / 2;
+		v.y = TileY(tile) * TILE_SIZE + TILE_SIZE / 2;
+		v.pt = RemapCoords(v.x, v.y, 0);
+		v.outside = 0;
+		if (v.pt.x < bounds.left) v.outside |= OUTSIDE_LEFT;
+		if (v.pt.x > bounds.right) v.outside |= OUTSIDE_RIGHT;
+		if (v.pt.y < bounds.top) v.outside |= OUTSIDE_ABOVE;
+		if (v.pt.y > bounds.bottom) v.outside |= OUTSIDE_BELOW;
+		v.has_height = false;
+		return v;
+	};
+
+	auto add_height = [](Vertex &v) {
+		if (v.has_height) return;
+		v.pt.y -= GetSlopePixelZ(v.x, v.y) * ZOOM_LVL_BASE;
+		v.has_height = true;
+	};
+
+	Vertex to = make_vertex(tiles[0]);
+	for (uint i = 1; i < tiles.size(); i++) {
+		Vertex from = to;
+		to = make_vertex(tiles[i]);
+
+		/* A height only moves a vertex up, so both vertices being above the bounds at sea level is enough. */
+		if ((from.outside & to.outside) != 0) continue;
+
+		add_height(from);
+		add_height(to);
+		draw(UnScaleByZoom(from.pt.x, vp->zoom), UnScaleByZoom(from.pt.y, vp->zoom), UnScaleByZoom(to.pt.x, vp->zoom), UnScaleByZoom(to.pt.y, vp->zoom));
+	}
+}
+
 void ViewportDrawPlans(const Viewport *vp)
 {
 	if (Plan::GetNumItems() == 0 && !(_current_plan && _current_plan->temp_line->tiles.size() > 1)) return;
@@ -2657,9 +3002,6 @@ void ViewportDrawPlans(const Viewport *vp)
 		ScaleByZoom(dpi_for_text.top + dpi_for_text.height + 2, vp->zoom) + (int)(ZOOM_LVL_BASE * TILE_HEIGHT * _settings_game.construction.map_height_limit)
 	};
 
-	const int min_coord_delta = bounds.left / (int)(2 * ZOOM_LVL_BASE * TILE_SIZE);
-	const int max_coord_delta = (bounds.right / (int)(2 * ZOOM_LVL_BASE * TILE_SIZE)) + 1;
-
 	for (Plan *p : Plan::Iterate()) {
 		if (!p->IsVisible()) continue;
 		for (PlanLineVector::iterator it = p->lines.begin(); it != p->lines.end(); it++) {
@@ -2675,58 +3017,19 @@ void ViewportDrawPlans(const Viewport *vp)
 				continue;
 			}
 
-			TileIndex to_tile = pl->tiles[0];
-			int to_coord_delta = (int)TileY(to_tile) - (int)TileX(to_tile);
-			for (uint i = 1; i < pl->tiles.size(); i++) {
-				const TileIndex from_tile = to_tile;
-				const int from_coord_delta = to_coord_delta;
-				to_tile = pl->tiles[i];
-				to_coord_delta = (int)TileY(to_tile) - (int)TileX(to_tile);
-
-				if (to_coord_delta < min_coord_delta && from_coord_delta < min_coord_delta) continue;
-				if (to_coord_delta > max_coord_delta && from_coord_delta > max_coord_delta) continue;
-
-				const Point from_pt = RemapCoords2(TileX(from_tile) * TILE_SIZE + TILE_SIZE / 2, TileY(from_tile) * TILE_SIZE + TILE_SIZE / 2);
-				const int from_x = UnScaleByZoom(from_pt.x, vp->zoom);
-				const int from_y = UnScaleByZoom(from_pt.y, vp->zoom);
-
-				const Point to_pt = RemapCoords2(TileX(to_tile) * TILE_SIZE + TILE_SIZE / 2, TileY(to_tile) * TILE_SIZE + TILE_SIZE / 2);
-				const int to_x = UnScaleByZoom(to_pt.x, vp->zoom);
-				const int to_y = UnScaleByZoom(to_pt.y, vp->zoom);
-
+			const uint8 colour = pl->focused ? PC_RED : _colour_value[p->colour];
+			ViewportForEachVisiblePlanLineSegment(vp, bounds, pl->tiles, [&](int from_x, int from_y, int to_x, int to_y) {
 				GfxDrawLine(from_x, from_y, to_x, to_y, PC_BLACK, 3);
-				if (pl->focused) {
-					GfxDrawLine(from_x, from_y, to_x, to_y, PC_RED, 1);
-				} else {
-					GfxDrawLine(from_x, from_y, to_x, to_y, _colour_value[p->colour], 1);
-				}
-			}
+				GfxDrawLine(from_x, from_y, to_x, to_y, colour, 1);
+			});
 		}
 	}
 
 	if (_current_plan && _current_plan->temp_line->tiles.size() > 1) {
-		PlanLine *pl = _current_plan->temp_line;
-		TileIndex to_tile = pl->tiles[0];
-		int to_coord_delta = (int)TileY(to_tile) - (int)TileX(to_tile);
-		for (uint i = 1; i < pl->tiles.size(); i++) {
-			const TileIndex from_tile = to_tile;
-			const int from_coord_delta = to_coord_delta;
-			to_tile = pl->tiles[i];
-			to_coord_delta = (int)TileY(to_tile) - (int)TileX(to_tile);
-
-			if (to_coord_delta < min_coord_delta && from_coord_delta < min_coord_delta) continue;
-			if (to_coord_delta > max_coord_delta && from_coord_delta > max_coord_delta) continue;
-
-			const Point from_pt = RemapCoords2(TileX(from_tile) * TILE_SIZE + TILE_SIZE / 2, TileY(from_tile) * TILE_SIZE + TILE_SIZE / 2);
-			const int from_x = UnScaleByZoom(from_pt.x, vp->zoom);
-			const int from_y = UnScaleByZoom(from_pt.y, vp->zoom);
-
-			const Point to_pt = RemapCoords2(TileX(to_tile) * TILE_SIZE + TILE_SIZE / 2, TileY(to_tile) * TILE_SIZE + TILE_SIZE / 2);
-			const int to_x = UnScaleByZoom(to_pt.x, vp->zoom);
-			const int to_y = UnScaleByZoom(to_pt.y, vp->zoom);
-
-			GfxDrawLine(from_x, from_y, to_x, to_y, _colour_value[_current_plan->colour], 3, 1);
-		}
+		const uint8 colour = _colour_value[_current_plan->colour];
+		ViewportForEachVisiblePlanLineSegment(vp, bounds, _current_plan->temp_line->tiles, [&](int from_x, int from_y, int to_x, int to_y) {
+			GfxDrawLine(from_x, from_y, to_x, to_y, colour, 3, 1);
+		});
 	}
 
 	_cur_dpi = nullptr;
@@ -3785,6 +4088,8 @@ void ViewportDoDraw(Viewport *vp, int left, int top, int right, int bottom, uint
 
 /* This is run in a worker thread */
 static void ViewportDoDrawRenderSubJob(Viewport *vp, ViewportDrawerDynamic *vdd, uint data_index) {
+	PerformanceTraceScope trace("Viewport render sub-job");
+
 	ViewportDrawParentSprites(vdd, &vdd->parent_sprite_sets[data_index].dpi, &vdd->parent_sprite_sets[data_index].psts, &vdd->child_screen_sprites_to_draw);
 
 	if (_draw_dirty_blocks && HasBit(_viewport_debug_flags, VDF_DIRTY_BLOCK_PER_SPLIT)) {
@@ -3809,6 +4114,8 @@ static void ViewportDoDrawRenderSubJob(Viewport *vp, ViewportDrawerDynamic *vdd,
 /* This is run in a worker thread */
 static void ViewportDoDrawRenderJob(Viewport *vp, ViewportDrawerDynamic *vdd)
 {
+	PerformanceTraceScope trace("Viewport render job");
+
 	ViewportAddKdtreeSigns(vdd, &vdd->dpi, false);
 
 	DrawTextEffects(vdd, &vdd->dpi, vdd->IsTransparencySet(TO_LOADING));
@@ -4335,6 +4642,9 @@ void ConstrainAllViewportsZoom()
  */
 void MarkTileDirtyByTile(TileIndex tile, ViewportMarkDirtyFlags flags, int bridge_level_offset, int tile_height_override)
 {
+	if (!_tile_sprite_cache.empty() && _tile_sprite_cache_recording == nullptr) _tile_sprite_cache.erase(tile);
+	InvalidateSmallMapTileColour(tile);
+
 	Point pt = RemapCoords(TileX(tile) * TILE_SIZE, TileY(tile) * TILE_SIZE, tile_height_override * TILE_HEIGHT);
 	MarkAllViewportsDirty(
 			pt.x - 31  * ZOOM_LVL_BASE,
@@ -4347,6 +4657,8 @@ void MarkTileDirtyByTile(TileIndex tile, ViewportMarkDirtyFlags flags, int bridg
 
 void MarkTileGroundDirtyByTile(TileIndex tile, ViewportMarkDirtyFlags flags)
 {
+	InvalidateSmallMapTileColour(tile);
+
 	int x = TileX(tile) * TILE_SIZE;
 	int y = TileY(tile) * TILE_SIZE;
 	Point top = RemapCoords(x, y, GetTileMaxPixelZ(tile));
@@ -6375,18 +6687,39 @@ void ChangeRenderMode(Viewport *vp, bool down) {
 	}
 }
 
-Point GetViewportStationMiddle(const Viewport *vp, const Station *st)
+/**
+ * Get the middle of a station in virtual viewport coordinates, independent of the position and zoom level of any viewport.
+ * @param st The station.
+ * @return The middle of the station.
+ */
+Point GetViewportStationVirtualMiddle(const Station *st)
 {
 	int x = TileX(st->xy) * TILE_SIZE;
 	int y = TileY(st->xy) * TILE_SIZE;
 	int z = GetSlopePixelZ(Clamp(x, 0, MapSizeX() * TILE_SIZE - 1), Clamp(y, 0, MapSizeY() * TILE_SIZE - 1));
 
-	Point p = RemapCoords(x, y, z);
-	p.x = UnScaleByZoom(p.x - vp->virtual_left, vp->zoom) + vp->left;
-	p.y = UnScaleByZoom(p.y - vp->virtual_top, vp->zoom) + vp->top;
+	return RemapCoords(x, y, z);
+}
+
+/**
+ * Convert virtual viewport coordinates to screen coordinates of a viewport.
+ * @param vp The viewport.
+ * @param pt The virtual coordinates.
+ * @return The screen coordinates.
+ */
+Point ViewportVirtualToScreen(const Viewport *vp, Point pt)
+{
+	Point p;
+	p.x = UnScaleByZoom(pt.x - vp->virtual_left, vp->zoom) + vp->left;
+	p.y = UnScaleByZoom(pt.y - vp->virtual_top, vp->zoom) + vp->top;
 	return p;
 }
 
+Point GetViewportStationMiddle(const Viewport *vp, const Station *st)
+{
+	return ViewportVirtualToScreen(vp, GetViewportStationVirtualMiddle(st));
+}
+
 /** Helper class for getting the best sprite sorter. */
 struct ViewportSSCSS {
 	VpSorterChecker fct_checker; ///< The check function.
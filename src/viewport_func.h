@@ -112,6 +112,7 @@ void UpdateAllVirtCoords();
 void ClearAllCachedNames();
 
 extern Point _tile_fract_coords;
+extern uint32 _viewport_sign_text_generation;
 
 void MarkTileDirtyByTile(const TileIndex tile, ViewportMarkDirtyFlags flags, int bridge_level_offset, int tile_height_override);
 
@@ -131,6 +132,8 @@ void MarkTileGroundDirtyByTile(TileIndex tile, ViewportMarkDirtyFlags flags);
 
 void ChangeRenderMode(Viewport *vp, bool down);
 
+Point GetViewportStationVirtualMiddle(const Station *st);
+Point ViewportVirtualToScreen(const Viewport *vp, Point pt);
 Point GetViewportStationMiddle(const Viewport *vp, const Station *st);
 
 void ShowTooltipForTile(Window *w, const TileIndex tile);
@@ -140,6 +143,8 @@ void ViewportMapClearTunnelCache();
 void ViewportMapInvalidateTunnelCacheByTile(const TileIndex tile, const Axis axis);
 void ViewportMapBuildTunnelCache();
 
+void ClearTileSpriteCache();
+
 void DrawTileSelectionRect(const TileInfo *ti, PaletteID pal);
 void DrawSelectionSprite(SpriteID image, PaletteID pal, const TileInfo *ti, int z_offset, FoundationPart foundation_part, int extra_offs_x = 0, int extra_offs_y = 0, const SubSprite *sub = nullptr);
 
@@ -14,6 +14,8 @@
 #include "smmintrin.h"
 #include "viewport_sprite_sorter.h"
 
+#include <algorithm>
+
 #include "safeguards.h"
 
 static_assert((sizeof(ParentSpriteToDraw) % 16) == 0);
@@ -84,9 +86,7 @@ void ViewportSortParentSpritesSSE41(ParentSpriteToSortVector *psdv)
 
 			/* Move ps2 in front of ps */
 			ParentSpriteToDraw * const temp = ps2;
-			for (auto psd3 = psd2; psd3 > psd; psd3--) {
-				*psd3 = *(psd3 - 1);
-			}
+			std::move_backward(psd, psd2, psd2 + 1);
 			*psd = temp;
 		}
 	}
@@ -14,6 +14,7 @@
 #include "strings_type.h"
 #include "table/strings.h"
 
+#include <string>
 #include <vector>
 
 class LinkGraphOverlay;
@@ -95,13 +96,31 @@ private:
 
 /** Location information about a sign as seen on the viewport */
 struct ViewportSign {
+	/** Formatted text of the sign, so it does not need to be formatted again each time the sign is drawn. */
+	struct CachedText {
+		std::string text;              ///< The formatted text
+		StringID string = STR_NULL;    ///< The string the text was formatted from
+		uint64 params[2] = {};         ///< The parameters the text was formatted with
+		uint32 generation = 0;         ///< #_viewport_sign_text_generation when the text was formatted
+	};
+
+	/** Kinds of text of a sign, the index into #cached_text. */
+	enum TextKind : uint8 {
+		VSTK_NORMAL,       ///< Text for the normal zoom levels
+		VSTK_SMALL,        ///< Text for zoomed out zoom levels
+		VSTK_SMALL_SHADOW, ///< Shadow text for zoomed out zoom levels
+		VSTK_END,
+	};
+
 	int32 center;        ///< The center position of the sign
 	int32 top;           ///< The top of the sign
 	uint16 width_normal; ///< The width when not zoomed out (normal font)
 	uint16 width_small;  ///< The width when zoomed out (small font)
+	mutable CachedText cached_text[VSTK_END]; ///< NOSAVE: Formatted texts of the sign, by #TextKind
 
 	void UpdatePosition(ZoomLevel maxzoom, int center, int top, StringID str, StringID str_small = STR_NULL);
 	void MarkDirty(ZoomLevel maxzoom) const;
+	const std::string &GetCachedText(TextKind kind, StringID string, uint64 params_1, uint64 params_2) const;
 };
 
 /** Specialised ViewportSign that tracks whether it is valid for entering into a Kdtree */
@@ -41,6 +41,7 @@
 #include "object_base.h"
 #include "object_map.h"
 #include "newgrf_object.h"
+#include "pathfinder/water_regions.h"
 
 #include "table/strings.h"
 
@@ -160,6 +161,8 @@ CommandCost CmdBuildShipDepot(TileIndex tile, DoCommandFlag flags, uint32 p1, ui
 
 		MakeShipDepot(tile,  _current_company, depot->index, DEPOT_PART_NORTH, axis, wc1);
 		MakeShipDepot(tile2, _current_company, depot->index, DEPOT_PART_SOUTH, axis, wc2);
+		InvalidateWaterRegion(tile);
+		InvalidateWaterRegion(tile2);
 		CheckForDockingTile(tile);
 		CheckForDockingTile(tile2);
 		MarkTileDirtyByTile(tile);
@@ -267,6 +270,8 @@ void MakeWaterKeepingClass(TileIndex tile, Owner o)
 		default: break;
 	}
 
+	InvalidateWaterRegion(tile);
+
 	if (wc != WATER_CLASS_INVALID) CheckForDockingTile(tile);
 	MarkTileDirtyByTile(tile);
 }
@@ -367,6 +372,9 @@ static CommandCost DoBuildLock(TileIndex tile, DiagDirection dir, DoCommandFlag
 		}
 
 		MakeLock(tile, _current_company, dir, wc_lower, wc_upper, wc_middle);
+		InvalidateWaterRegion(tile);
+		InvalidateWaterRegion(tile - delta);
+		InvalidateWaterRegion(tile + delta);
 		CheckForDockingTile(tile - delta);
 		CheckForDockingTile(tile + delta);
 		MarkTileDirtyByTile(tile);
@@ -411,6 +419,7 @@ static CommandCost RemoveLock(TileIndex tile, DoCommandFlag flags)
 
 		if (GetWaterClass(tile) == WATER_CLASS_RIVER) {
 			MakeRiver(tile, Random());
+			InvalidateWaterRegion(tile);
 		} else {
 			DoClearSquare(tile);
 			ClearNeighbourNonFloodingStates(tile);
@@ -455,6 +464,7 @@ bool RiverModifyDesertZone(TileIndex tile, void *)
  */
 void MakeRiverAndModifyDesertZoneAround(TileIndex tile) {
 	MakeRiver(tile, Random());
+	InvalidateWaterRegion(tile);
 	MarkTileDirtyByTile(tile);
 
 	/* Remove desert directly around the river tile. */
@@ -544,6 +554,7 @@ CommandCost CmdBuildCanal(TileIndex tile, DoCommandFlag flags, uint32 p1, uint32
 					}
 					break;
 			}
+			InvalidateWaterRegion(current_tile);
 			MarkTileDirtyByTile(current_tile);
 			MarkCanalsAndRiversAroundDirty(current_tile);
 			CheckForDockingTile(current_tile);
@@ -1251,6 +1262,8 @@ void DoFloodTile(TileIndex target)
 	}
 
 	if (flooded) {
+		InvalidateWaterRegion(target);
+
 		/* Mark surrounding canal tiles dirty too to avoid glitches */
 		MarkCanalsAndRiversAroundDirty(target);
 
@@ -1298,6 +1311,7 @@ static void DoDryUp(TileIndex tile)
 			if (DoCommand(tile, 0, 0, DC_EXEC, CMD_LANDSCAPE_CLEAR).Succeeded()) {
 				MakeClear(tile, CLEAR_GRASS, 3);
 				MarkTileDirtyByTile(tile);
+				InvalidateWaterRegion(tile);
 			}
 			break;
 
@@ -1348,6 +1362,10 @@ void TileLoopWaterFlooding(FloodingBehaviour flooding_behaviour, TileIndex tile)
 				if (IsTileType(dest, MP_TREES) && GetTreeGround(dest) == TREE_GROUND_SHORE) continue;
 				if (IsTileType(dest, MP_OBJECT) && (GetObjectEffectiveFoundationType(dest) != OEFT_NONE || GetObjectGroundType(dest) == OBJECT_GROUND_SHORE)) continue;
 
+				/* Foundations only raise a tile, so a tile whose lowest corner is above sea level can never be flooded.
+				 * This is much cheaper than asking the tile type for its foundation, and is the common case along the coast. */
+				if (GetTileZ(dest) > 0) continue;
+
 				int z_dest;
 				Slope slope_dest = GetFoundationSlope(dest, &z_dest) & ~SLOPE_HALFTILE_MASK & ~SLOPE_STEEP;
 				if (z_dest > 0) continue;
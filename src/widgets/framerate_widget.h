@@ -20,6 +20,7 @@ enum FramerateWindowWidgets {
 	WID_FRW_TIMES_NAMES,
 	WID_FRW_TIMES_CURRENT,
 	WID_FRW_TIMES_AVERAGE,
+	WID_FRW_TIMES_PEAK,
 	WID_FRW_ALLOCSIZE,
 	WID_FRW_SEL_MEMORY,
 	WID_FRW_SCROLLBAR,
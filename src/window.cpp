@@ -63,6 +63,8 @@ Window *_z_front_window = nullptr;
 Window *_z_back_window  = nullptr;
 /** List of windows in an arbitrary order, that is not instantaneously changed by bringing windows to the front. */
 Window *_first_window  = nullptr;
+/** Windows per window class, linked by Window::next_window_of_class. Closed windows are unlinked in Window::DeleteClosedWindows. */
+Window *_first_window_of_class[WC_END];
 
 /** If false, highlight is white, otherwise the by the widget defined colour. */
 bool _window_highlight_colour = false;
@@ -577,6 +579,34 @@ void Window::SetWidgetDirty(byte widget_index)
 	this->nested_array[widget_index]->SetDirty(this);
 }
 
+/**
+ * Invalidate part of a widget, i.e. mark it as being changed and in need of redraw.
+ * This is for widgets of which only a small part changes often, such as a single row of a list, so not the whole widget has to be repainted.
+ * @param widget_index the widget to redraw.
+ * @param r Area to redraw, in the same window relative coordinates as passed to #DrawWidget. It is clipped to the widget.
+ */
+void Window::SetWidgetAreaDirty(byte widget_index, const Rect &r)
+{
+	/* Sometimes this function is called before the window is even fully initialized */
+	if (this->nested_array == nullptr || this->IsShaded()) return;
+
+	const NWidgetBase *nwid = this->nested_array[widget_index];
+	if (nwid == nullptr || nwid->current_x == 0 || nwid->current_y == 0) return;
+
+	int left = std::max<int>(r.left, nwid->pos_x);
+	int top = std::max<int>(r.top, nwid->pos_y);
+	int right = std::min<int>(r.right + 1, nwid->pos_x + nwid->current_x);
+	int bottom = std::min<int>(r.bottom + 1, nwid->pos_y + nwid->current_y);
+	if (left >= right || top >= bottom) return;
+
+	extern bool _gfx_draw_active;
+	if (_gfx_draw_active) {
+		SetPendingDirtyBlocks(this->left + left, this->top + top, this->left + right, this->top + bottom);
+	} else {
+		SetDirtyBlocks(this->left + left, this->top + top, this->left + right, this->top + bottom);
+	}
+}
+
 /**
  * A hotkey has been pressed.
  * @param hotkey  Hotkey index, by default a widget index of a button or editbox.
@@ -1181,7 +1211,7 @@ void CloseAllWindowsById(WindowClass cls, WindowNumber number, bool force, int d
 	if (cls < WC_END && !_present_window_types[cls]) return;
 
 	/* Note: the container remains stable, even when deleting windows. */
-	for (Window *w : Window::Iterate()) {
+	for (Window *w : Window::IterateByClass(cls)) {
 		if (w->window_class == cls && w->window_number == number && (force || (w->flags & WF_STICKY) == 0)) {
 			w->Close(data);
 		}
@@ -1197,7 +1227,7 @@ void CloseWindowByClass(WindowClass cls, int data)
 	if (cls < WC_END && !_present_window_types[cls]) return;
 
 	/* Note: the container remains stable, even when deleting windows. */
-	for (Window *w : Window::Iterate()) {
+	for (Window *w : Window::IterateByClass(cls)) {
 		if (w->window_class == cls) {
 			w->Close(data);
 		}
@@ -1470,8 +1500,21 @@ static void BringWindowToFront(Window *w)
 
 void Window::ChangeWindowClass(WindowClass cls)
 {
+	if (this->window_class < WC_END) {
+		for (Window **w = &_first_window_of_class[this->window_class]; *w != nullptr; w = &(*w)->next_window_of_class) {
+			if (*w == this) {
+				*w = this->next_window_of_class;
+				break;
+			}
+		}
+	}
+
 	this->window_class = cls;
-	if (this->window_class < WC_END) _present_window_types.set(this->window_class);
+	if (this->window_class < WC_END) {
+		_present_window_types.set(this->window_class);
+		this->next_window_of_class = _first_window_of_class[this->window_class];
+		_first_window_of_class[this->window_class] = this;
+	}
 }
 
 /**
@@ -1920,6 +1963,7 @@ void InitWindowSystem()
 	_z_back_window = nullptr;
 	_z_front_window = nullptr;
 	_first_window = nullptr;
+	std::fill(std::begin(_first_window_of_class), std::end(_first_window_of_class), nullptr);
 	_focused_window = nullptr;
 	_mouseover_last_w = nullptr;
 	_last_scroll_window = nullptr;
@@ -1946,6 +1990,7 @@ void UnInitWindowSystem()
 	_z_front_window = nullptr;
 	_z_back_window = nullptr;
 	_first_window = nullptr;
+	std::fill(std::begin(_first_window_of_class), std::end(_first_window_of_class), nullptr);
 }
 
 /**
@@ -3200,6 +3245,13 @@ static void CheckSoftLimit()
 		for (Window *w = _z_front_window; w != nullptr; w = w->z_back) {
 			w->next_window = w->z_back;
 		}
+
+		std::fill(std::begin(_first_window_of_class), std::end(_first_window_of_class), nullptr);
+		for (Window *w = _z_back_window; w != nullptr; w = w->z_front) {
+			if (w->window_class >= WC_END) continue;
+			w->next_window_of_class = _first_window_of_class[w->window_class];
+			_first_window_of_class[w->window_class] = w;
+		}
 	}
 }
 
@@ -3334,7 +3386,7 @@ void SetWindowDirty(WindowClass cls, WindowNumber number)
 {
 	if (cls < WC_END && !_present_window_types[cls]) return;
 
-	for (Window *w : Window::Iterate()) {
+	for (Window *w : Window::IterateByClass(cls)) {
 		if (w->window_class == cls && w->window_number == number) w->SetDirty();
 	}
 }
@@ -3349,7 +3401,7 @@ void SetWindowWidgetDirty(WindowClass cls, WindowNumber number, byte widget_inde
 {
 	if (cls < WC_END && !_present_window_types[cls]) return;
 
-	for (Window *w : Window::Iterate()) {
+	for (Window *w : Window::IterateByClass(cls)) {
 		if (w->window_class == cls && w->window_number == number) {
 			w->SetWidgetDirty(widget_index);
 		}
@@ -3364,7 +3416,7 @@ void SetWindowClassesDirty(WindowClass cls)
 {
 	if (cls < WC_END && !_present_window_types[cls]) return;
 
-	for (Window *w : Window::Iterate()) {
+	for (Window *w : Window::IterateByClass(cls)) {
 		if (w->window_class == cls) w->SetDirty();
 	}
 }
@@ -3440,7 +3492,7 @@ void InvalidateWindowData(WindowClass cls, WindowNumber number, int data, bool g
 {
 	if (cls < WC_END && !_present_window_types[cls]) return;
 
-	for (Window *w : Window::Iterate()) {
+	for (Window *w : Window::IterateByClass(cls)) {
 		if (w->window_class == cls && w->window_number == number) {
 			w->InvalidateData(data, gui_scope);
 		}
@@ -3459,7 +3511,7 @@ void InvalidateWindowClassesData(WindowClass cls, int data, bool gui_scope)
 {
 	if (cls < WC_END && !_present_window_types[cls]) return;
 
-	for (Window *w : Window::Iterate()) {
+	for (Window *w : Window::IterateByClass(cls)) {
 		if (w->window_class == cls) {
 			w->InvalidateData(data, gui_scope);
 		}
@@ -82,6 +82,7 @@ void DrawCaption(const Rect &r, Colours colour, Owner owner, TextColour text_col
 extern Window *_z_front_window;
 extern Window *_z_back_window;
 extern Window *_first_window;
+extern Window *_first_window_of_class[WC_END];
 extern Window *_focused_window;
 
 inline uint64 GetWindowUpdateNumber()
@@ -249,6 +250,7 @@ struct Window : ZeroedMemoryAllocator {
 	Window *z_front;             ///< The window in front of us in z-order.
 	Window *z_back;              ///< The window behind us in z-order.
 	Window *next_window;         ///< The next window in arbitrary iteration order.
+	Window *next_window_of_class; ///< The next window of the same class in arbitrary iteration order.
 	WindowClass window_class;        ///< Window class
 
 private:
@@ -523,6 +525,7 @@ public:
 	}
 
 	void SetWidgetDirty(byte widget_index);
+	void SetWidgetAreaDirty(byte widget_index, const Rect &r);
 
 	void DrawWidgets() const;
 	void DrawViewport(uint8 display_flags) const;
@@ -857,6 +860,7 @@ public:
 		IM_FROM_FRONT,
 		IM_FROM_BACK,
 		IM_ARBITRARY,
+		IM_CLASS,
 	};
 
 	/**
@@ -899,6 +903,9 @@ public:
 					case IM_ARBITRARY:
 						this->w = this->w->next_window;
 						break;
+					case IM_CLASS:
+						this->w = this->w->next_window_of_class;
+						break;
 				}
 			}
 		}
@@ -945,6 +952,16 @@ public:
 	 */
 	template <class T = Window>
 	static IterateCommon<T, IM_ARBITRARY> Iterate(window_type<T> *from = _first_window) { return IterateCommon<T, IM_ARBITRARY>(from); }
+
+	/**
+	 * Returns an iterable ensemble of the valid Windows of a class in an arbitrary order which is safe to use when deleting.
+	 * The window class of the returned windows must still be checked, as a window may have changed its class during the iteration.
+	 * @tparam T Type of the class/struct that is going to be iterated
+	 * @param cls Window class
+	 * @return an iterable ensemble of the valid Windows of the class
+	 */
+	template <class T = Window>
+	static IterateCommon<T, IM_CLASS> IterateByClass(WindowClass cls) { return IterateCommon<T, IM_CLASS>(cls < WC_END ? _first_window_of_class[cls] : nullptr); }
 };
 
 /**
@@ -10,21 +10,101 @@
 #include "stdafx.h"
 #include "worker_thread.h"
 #include "thread.h"
+#include "debug.h"
+#include "string_func.h"
+
+#if defined(__linux__)
+#include <sched.h>
+#endif
 
 #include "safeguards.h"
 
 WorkerThreadPool _general_worker_pool;
 
+uint _worker_threads = 0; ///< Number of threads of the general worker pool, 0 to determine it from the number of CPUs.
+std::string _cpu_affinity; ///< CPUs to which the process is restricted, as a list of CPU numbers and ranges (e.g. "0-7,16"), empty for all.
+
+/**
+ * Get the number of CPUs which the threads of this process can run on.
+ * This takes the CPU affinity of the process into account, where supported.
+ * @return The number of CPUs, at least 1.
+ */
+uint GetAvailableCPUCount()
+{
+#if defined(__linux__)
+	cpu_set_t set;
+	CPU_ZERO(&set);
+	if (sched_getaffinity(0, sizeof(set), &set) == 0) {
+		int count = CPU_COUNT(&set);
+		if (count > 0) return count;
+	}
+#endif
+	return std::max<uint>(std::thread::hardware_concurrency(), 1);
+}
+
+/**
+ * Restrict the process to the CPUs in #_cpu_affinity, if set.
+ * This has to be called before any other threads are started, as only threads started afterwards inherit the affinity.
+ */
+void ApplyCPUAffinity()
+{
+	if (_cpu_affinity.empty()) return;
+
+#if defined(__linux__)
+	cpu_set_t set;
+	CPU_ZERO(&set);
+
+	const char *p = _cpu_affinity.c_str();
+	while (*p != '\0') {
+		char *end;
+		unsigned long first = std::strtoul(p, &end, 10);
+		unsigned long last = first;
+		if (end == p) break;
+		p = end;
+		if (*p == '-') {
+			last = std::strtoul(p + 1, &end, 10);
+			if (end == p + 1) break;
+			p = end;
+		}
+		for (unsigned long cpu = first; cpu <= last && cpu < CPU_SETSIZE; cpu++) CPU_SET(cpu, &set);
+		if (*p != ',') break;
+		p++;
+	}
+
+	if (*p != '\0' || CPU_COUNT(&set) == 0) {
+		DEBUG(misc, 0, "Invalid CPU affinity: '%s'", _cpu_affinity.c_str());
+		return;
+	}
+	if (sched_setaffinity(0, sizeof(set), &set) != 0) {
+		DEBUG(misc, 0, "Could not set CPU affinity to '%s'", _cpu_affinity.c_str());
+		return;
+	}
+	DEBUG(misc, 1, "CPU affinity set to '%s', %u CPUs", _cpu_affinity.c_str(), GetAvailableCPUCount());
+#else
+	DEBUG(misc, 0, "Setting the CPU affinity is not supported on this platform");
+#endif
+}
+
+/**
+ * Start the worker threads of the pool.
+ * @param thread_name Name of the threads.
+ * @param max_workers Maximum number of workers, when #_worker_threads is not set.
+ */
 void WorkerThreadPool::Start(const char *thread_name, uint max_workers)
 {
-	uint cpus = std::thread::hardware_concurrency();
-	if (cpus <= 1) return;
+	uint worker_target;
+	if (_worker_threads != 0) {
+		worker_target = _worker_threads;
+	} else {
+		uint cpus = GetAvailableCPUCount();
+		if (cpus <= 1) return;
+		worker_target = std::min<uint>(max_workers, cpus);
+	}
 
 	std::lock_guard<std::mutex> lk(this->lock);
 
 	this->exit = false;
 
-	uint worker_target = std::min<uint>(max_workers, cpus);
 	if (this->workers >= worker_target) return;
 
 	uint new_workers = worker_target - this->workers;
@@ -48,6 +128,11 @@ void WorkerThreadPool::Stop()
 
 void WorkerThreadPool::EnqueueJob(WorkerJobFunc *func, void *data1, void *data2, void *data3)
 {
+	if (this->detached) {
+		func(data1, data2, data3);
+		return;
+	}
+
 	std::unique_lock<std::mutex> lk(this->lock);
 	if (this->workers == 0) {
 		/* Just execute it here and now */
@@ -61,6 +146,15 @@ void WorkerThreadPool::EnqueueJob(WorkerJobFunc *func, void *data1, void *data2,
 	if (notify) this->worker_wait_cv.notify_one();
 }
 
+/**
+ * Execute all further jobs on the calling thread, without touching the lock or the queue.
+ * To be called in the child after fork(), where the worker threads do not exist and the lock may have been held by one of them.
+ */
+void WorkerThreadPool::DetachAfterFork()
+{
+	this->detached = true;
+}
+
 void WorkerThreadPool::Run(WorkerThreadPool *pool)
 {
 	std::unique_lock<std::mutex> lk(pool->lock);
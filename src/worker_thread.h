@@ -11,6 +11,9 @@
 #define WORKER_THREAD_H
 
 #include "core/ring_buffer_queue.hpp"
+#include "core/math_func.hpp"
+#include <algorithm>
+#include <string>
 #include <mutex>
 #include <condition_variable>
 #if defined(__MINGW32__)
@@ -20,6 +23,45 @@
 
 typedef void WorkerJobFunc(void *, void *, void *);
 
+/**
+ * Counter of the outstanding jobs of a group of jobs, such that a thread can wait until all of them are done.
+ */
+struct WorkerJobGroup {
+private:
+	std::mutex lock;
+	std::condition_variable done_cv;
+	uint pending = 0;
+
+public:
+	/**
+	 * Add jobs to the group, before they are enqueued.
+	 * @param count Number of jobs.
+	 */
+	void Add(uint count)
+	{
+		std::lock_guard<std::mutex> lk(this->lock);
+		this->pending += count;
+	}
+
+	/**
+	 * Mark a job of the group as done, to be called at the end of the job.
+	 */
+	void Done()
+	{
+		std::lock_guard<std::mutex> lk(this->lock);
+		if (--this->pending == 0) this->done_cv.notify_all();
+	}
+
+	/**
+	 * Wait until all jobs of the group are done.
+	 */
+	void Wait()
+	{
+		std::unique_lock<std::mutex> lk(this->lock);
+		this->done_cv.wait(lk, [this]() { return this->pending == 0; });
+	}
+};
+
 struct WorkerThreadPool {
 private:
 	struct WorkerJob {
@@ -32,6 +74,7 @@ private:
 	uint workers = 0;
 	uint workers_waiting = 0;
 	bool exit = false;
+	bool detached = false; ///< This is a forked child process, in which the workers do not exist.
 	std::mutex lock;
 	ring_buffer_queue<WorkerJob> jobs;
 	std::condition_variable worker_wait_cv;
@@ -44,6 +87,13 @@ public:
 	void Start(const char *thread_name, uint max_workers);
 	void Stop();
 	void EnqueueJob(WorkerJobFunc *func, void *data1 = nullptr, void *data2 = nullptr, void *data3 = nullptr);
+	void DetachAfterFork();
+
+	template <typename F>
+	void EnqueueJobs(uint count, F get_job);
+
+	template <typename F>
+	void ParallelFor(int count, int batch, F func);
 
 	~WorkerThreadPool()
 	{
@@ -53,4 +103,94 @@ public:
 
 extern WorkerThreadPool _general_worker_pool;
 
+extern uint _worker_threads;
+extern std::string _cpu_affinity;
+
+uint GetAvailableCPUCount();
+void ApplyCPUAffinity();
+
+/**
+ * Enqueue a number of jobs at once, taking the lock only once.
+ * @param count Number of jobs.
+ * @param get_job Function which stores the function and the data of the i-th job:
+ *                get_job(uint i, WorkerJobFunc *&func, void *&data1, void *&data2, void *&data3).
+ */
+template <typename F>
+void WorkerThreadPool::EnqueueJobs(uint count, F get_job)
+{
+	auto run_inline = [&]() {
+		for (uint i = 0; i < count; i++) {
+			WorkerJob job{};
+			get_job(i, job.func, job.data1, job.data2, job.data3);
+			job.func(job.data1, job.data2, job.data3);
+		}
+	};
+
+	if (this->detached) {
+		run_inline();
+		return;
+	}
+
+	std::unique_lock<std::mutex> lk(this->lock);
+	if (this->workers == 0) {
+		/* Just execute them here and now */
+		lk.unlock();
+		run_inline();
+		return;
+	}
+	const size_t queued = this->jobs.size();
+	const uint idle = queued < this->workers_waiting ? this->workers_waiting - (uint)queued : 0;
+	const uint notify = std::min(count, idle);
+	for (uint i = 0; i < count; i++) {
+		WorkerJob job{};
+		get_job(i, job.func, job.data1, job.data2, job.data3);
+		this->jobs.push(job);
+	}
+	lk.unlock();
+	for (uint i = 0; i < notify; i++) this->worker_wait_cv.notify_one();
+}
+
+/**
+ * Call a function on consecutive ranges of [0, count), spread over the pool, and wait until all ranges are done.
+ * The calling thread handles the first range itself.
+ * @param count End of the range, exclusive.
+ * @param batch Number of elements passed to a single call of \a func.
+ * @param func Function to call with the first and the last (exclusive) element of each batch.
+ */
+template <typename F>
+void WorkerThreadPool::ParallelFor(int count, int batch, F func)
+{
+	if (count <= batch) {
+		func(0, count);
+		return;
+	}
+
+	struct JobState {
+		F *func;
+		WorkerJobGroup group;
+	};
+	JobState state;
+	state.func = &func;
+
+	auto run_batch = [](void *data1, void *data2, void *data3) {
+		JobState *state = static_cast<JobState *>(data1);
+		(*state->func)(static_cast<int>(reinterpret_cast<intptr_t>(data2)), static_cast<int>(reinterpret_cast<intptr_t>(data3)));
+		state->group.Done();
+	};
+
+	const uint jobs = CeilDiv(count, batch) - 1;
+	state.group.Add(jobs + 1);
+	this->EnqueueJobs(jobs, [&](uint i, WorkerJobFunc *&job_func, void *&data1, void *&data2, void *&data3) {
+		const int first = (i + 1) * batch;
+		const int last = std::min(first + batch, count);
+		job_func = run_batch;
+		data1 = &state;
+		data2 = reinterpret_cast<void *>(static_cast<intptr_t>(first));
+		data3 = reinterpret_cast<void *>(static_cast<intptr_t>(last));
+	});
+	run_batch(&state, reinterpret_cast<void *>(static_cast<intptr_t>(0)), reinterpret_cast<void *>(static_cast<intptr_t>(batch)));
+
+	state.group.Wait();
+}
+
 #endif /* WORKER_THREAD_H */
@@ -28,13 +28,101 @@
 #include "road_map.h"
 #include "debug_settings.h"
 #include "animated_tile.h"
-#include "3rdparty/cpp-btree/btree_set.h"
+
+#include <memory>
+#include <vector>
 
 Zoning _zoning;
 static const SpriteID ZONING_INVALID_SPRITE_ID = UINT_MAX;
 
-static btree::btree_set<uint32> _zoning_cache_inner;
-static btree::btree_set<uint32> _zoning_cache_outer;
+/**
+ * Cache of the evaluation results of a zoning mode, with one byte per tile.
+ * The map is split into blocks of tiles, which are only allocated when a tile in them is first evaluated,
+ * so that only the parts of the map which have been drawn take memory.
+ */
+struct ZoningCache {
+	static const uint BLOCK_SHIFT = 6;                      ///< Log2 of the width and height of a block, in tiles.
+	static const uint BLOCK_SIZE = 1 << BLOCK_SHIFT;        ///< Width and height of a block, in tiles.
+	static const uint BLOCK_TILES = BLOCK_SIZE * BLOCK_SIZE; ///< Number of tiles in a block.
+	static const uint8 UNKNOWN = 0xFF;                      ///< Value of tiles which have not been evaluated.
+
+	std::vector<std::unique_ptr<uint8[]>> blocks;           ///< Blocks, indexed by block row and column like tiles are.
+
+	/** Get the index in #blocks of the block containing the tile at (x, y). */
+	static inline uint BlockIndex(uint x, uint y)
+	{
+		return (x >> BLOCK_SHIFT) + (y >> BLOCK_SHIFT) * (MapSizeX() >> BLOCK_SHIFT);
+	}
+
+	/** Get the index in a block of the tile at (x, y). */
+	static inline uint TileIndexInBlock(uint x, uint y)
+	{
+		return (x & (BLOCK_SIZE - 1)) | ((y & (BLOCK_SIZE - 1)) << BLOCK_SHIFT);
+	}
+
+	/**
+	 * Get the cached value of a tile.
+	 * @param tile The tile.
+	 * @return The value, or #UNKNOWN if it has not been evaluated.
+	 */
+	inline uint8 Get(TileIndex tile) const
+	{
+		const uint x = TileX(tile);
+		const uint y = TileY(tile);
+		const uint block = BlockIndex(x, y);
+		if (block >= this->blocks.size() || this->blocks[block] == nullptr) return UNKNOWN;
+		return this->blocks[block][TileIndexInBlock(x, y)];
+	}
+
+	/**
+	 * Set the cached value of a tile.
+	 * @param tile The tile.
+	 * @param value The value.
+	 */
+	void Set(TileIndex tile, uint8 value)
+	{
+		const uint x = TileX(tile);
+		const uint y = TileY(tile);
+		const uint block = BlockIndex(x, y);
+		if (this->blocks.size() != MapSize() / BLOCK_TILES) {
+			this->blocks.clear();
+			this->blocks.resize(MapSize() / BLOCK_TILES);
+		}
+		std::unique_ptr<uint8[]> &data = this->blocks[block];
+		if (data == nullptr) {
+			data.reset(new uint8[BLOCK_TILES]);
+			memset(data.get(), UNKNOWN, BLOCK_TILES);
+		}
+		data[TileIndexInBlock(x, y)] = value;
+	}
+
+	/**
+	 * Forget the values of the tiles in a rectangle.
+	 * @param rect The rectangle, in tile coordinates, inclusive.
+	 */
+	void InvalidateRect(const Rect &rect)
+	{
+		if (this->blocks.empty()) return;
+		for (int y = rect.top; y <= rect.bottom; y++) {
+			for (int x = rect.left; x <= rect.right;) {
+				/* Clear the part of the row which is within the block at once. */
+				const int row_end = std::min<int>(rect.right, x | (BLOCK_SIZE - 1));
+				std::unique_ptr<uint8[]> &data = this->blocks[BlockIndex(x, y)];
+				if (data != nullptr) memset(data.get() + TileIndexInBlock(x, y), UNKNOWN, row_end - x + 1);
+				x = row_end + 1;
+			}
+		}
+	}
+
+	/** Forget the values of all tiles. */
+	void Clear()
+	{
+		this->blocks.clear();
+	}
+};
+
+static ZoningCache _zoning_cache_inner;
+static ZoningCache _zoning_cache_outer;
 
 /**
  * Draw the zoning sprites.
@@ -377,10 +465,10 @@ inline SpriteID TileZoningSpriteEvaluationCached(TileIndex tile, Owner owner, Zo
 	if (ev_mode == ZEM_IND_UNSER && !IsTileType(tile, MP_INDUSTRY)) return ZONING_INVALID_SPRITE_ID;
 	if (ev_mode >= ZEM_STA_CATCH && ev_mode <= ZEM_IND_UNSER) {
 		// cacheable
-		btree::btree_set<uint32> &cache = is_inner ? _zoning_cache_inner : _zoning_cache_outer;
-		auto iter = cache.lower_bound(tile << 3);
-		if (iter != cache.end() && *iter >> 3 == tile) {
-			switch (*iter & 7) {
+		ZoningCache &cache = is_inner ? _zoning_cache_inner : _zoning_cache_outer;
+		const uint8 cached = cache.Get(tile);
+		if (cached != ZoningCache::UNKNOWN) {
+			switch (cached) {
 				case 0: return ZONING_INVALID_SPRITE_ID;
 				case 1: return SPR_ZONING_INNER_HIGHLIGHT_RED;
 				case 2: return SPR_ZONING_INNER_HIGHLIGHT_ORANGE;
@@ -390,16 +478,16 @@ inline SpriteID TileZoningSpriteEvaluationCached(TileIndex tile, Owner owner, Zo
 			}
 		} else {
 			SpriteID s = TileZoningSpriteEvaluation(tile, owner, ev_mode);
-			uint val = tile << 3;
+			uint8 val;
 			switch (s) {
-				case ZONING_INVALID_SPRITE_ID:              val |= 0; break;
-				case SPR_ZONING_INNER_HIGHLIGHT_RED:        val |= 1; break;
-				case SPR_ZONING_INNER_HIGHLIGHT_ORANGE:     val |= 2; break;
-				case SPR_ZONING_INNER_HIGHLIGHT_BLACK:      val |= 3; break;
-				case SPR_ZONING_INNER_HIGHLIGHT_LIGHT_BLUE: val |= 4; break;
+				case ZONING_INVALID_SPRITE_ID:              val = 0; break;
+				case SPR_ZONING_INNER_HIGHLIGHT_RED:        val = 1; break;
+				case SPR_ZONING_INNER_HIGHLIGHT_ORANGE:     val = 2; break;
+				case SPR_ZONING_INNER_HIGHLIGHT_BLACK:      val = 3; break;
+				case SPR_ZONING_INNER_HIGHLIGHT_LIGHT_BLUE: val = 4; break;
 				default: NOT_REACHED();
 			}
-			cache.insert(iter, val);
+			cache.Set(tile, val);
 			return s;
 		}
 	} else {
@@ -488,17 +576,8 @@ void ZoningMarkDirtyStationCoverageArea(const Station *st, ZoningModeMask mask)
 				MarkTileDirtyByTile(TileXY(x, y), VMDF_NOT_MAP_MODE);
 			}
 		}
-		auto invalidate_cache_rect = [&](btree::btree_set<uint32> &cache) {
-			for (int y = rect.top; y <= rect.bottom; y++) {
-				auto iter = cache.lower_bound(TileXY(rect.left, y) << 3);
-				auto end_iter = iter;
-				uint end = (TileXY(rect.right, y) + 1) << 3;
-				while (end_iter != cache.end() && *end_iter < end) ++end_iter;
-				cache.erase(iter, end_iter);
-			}
-		};
-		if (outer_radius) invalidate_cache_rect(_zoning_cache_outer);
-		if (inner_radius) invalidate_cache_rect(_zoning_cache_inner);
+		if (outer_radius) _zoning_cache_outer.InvalidateRect(rect);
+		if (inner_radius) _zoning_cache_inner.InvalidateRect(rect);
 	}
 }
 
@@ -522,19 +601,19 @@ void ZoningTownAuthorityRatingChange()
 
 void ClearZoningCaches()
 {
-	_zoning_cache_inner.clear();
-	_zoning_cache_outer.clear();
+	_zoning_cache_inner.Clear();
+	_zoning_cache_outer.Clear();
 }
 
 void SetZoningMode(bool inner, ZoningEvaluationMode mode)
 {
 	ZoningEvaluationMode &current_mode = inner ? _zoning.inner : _zoning.outer;
-	btree::btree_set<uint32> &cache = inner ? _zoning_cache_inner : _zoning_cache_outer;
+	ZoningCache &cache = inner ? _zoning_cache_inner : _zoning_cache_outer;
 
 	if (current_mode == mode) return;
 
 	current_mode = mode;
-	cache.clear();
+	cache.Clear();
 	MarkWholeNonMapViewportsDirty();
 	PostZoningModeChange();
 }